@@ -92,6 +92,36 @@ uint8_t opt300x_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uin
     return 0;
 }
 
+/**
+ * @brief      interface iic bus read command
+ * @param[in]  addr iic device write address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t opt300x_interface_iic_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface iic bus write command
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t opt300x_interface_iic_write_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    return 0;
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -112,6 +142,78 @@ void opt300x_interface_debug_print(const char *const fmt, ...)
     
 }
 
+/**
+ * @brief     interface log driver debug data
+ * @param[in] fmt format data
+ * @note      it is linked as the driver debug_print and follows OPT300X_INTERFACE_DEBUG_MODE
+ */
+void opt300x_interface_debug_log(const char *const fmt, ...)
+{
+    
+}
+
+/**
+ * @brief interface format and output all deferred messages
+ * @note  call it out of the sampling path when the deferred mode is used
+ */
+void opt300x_interface_debug_flush(void)
+{
+    
+}
+
+/**
+ * @brief      interface mutex init
+ * @param[out] **mutex pointer to a mutex context buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 mutex init failed
+ * @note       one context is created for every handle
+ */
+uint8_t opt300x_interface_mutex_init(void **mutex)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface mutex deinit
+ * @param[in] *mutex pointer to a mutex context
+ * @note      none
+ */
+void opt300x_interface_mutex_deinit(void *mutex)
+{
+    
+}
+
+/**
+ * @brief     interface mutex lock
+ * @param[in] *mutex pointer to a mutex context
+ * @note      none
+ */
+void opt300x_interface_mutex_lock(void *mutex)
+{
+    
+}
+
+/**
+ * @brief     interface mutex unlock
+ * @param[in] *mutex pointer to a mutex context
+ * @note      none
+ */
+void opt300x_interface_mutex_unlock(void *mutex)
+{
+    
+}
+
+/**
+ * @brief  interface timestamp us
+ * @return monotonic time in us
+ * @note   none
+ */
+uint64_t opt300x_interface_timestamp_us(void)
+{
+    return 0;
+}
+
 /**
  * @brief     interface receive callback
  * @param[in] type irq type
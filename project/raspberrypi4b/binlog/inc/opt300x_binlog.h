@@ -0,0 +1,302 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      opt300x_binlog.h
+ * @brief     opt300x binary log header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef OPT300X_BINLOG_H
+#define OPT300X_BINLOG_H
+
+#include "driver_opt300x.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup opt300x_binlog opt300x binary log function
+ * @brief    opt300x binary log modules
+ * @{
+ */
+
+/**
+ * @brief binary log format definition
+ * @note  all fields are little endian
+ *        file   := header block* [index trailer]
+ *        header := 64 bytes, magic "O3BL", version, record size, max records per block,
+ *                  sensor numbers, chip type and address pin of every sensor id
+ *        block  := 32 bytes block header (magic "BLK0", records, first record number,
+ *                  base timestamp, last timestamp) + records of 8 bytes
+ *        record := timestamp delta from the block base in us (32 bits), raw result word
+ *                  (16 bits, 4 bits exponent and 12 bits mantissa), sensor id, flags
+ *        index  := 24 bytes per block (file offset, first record number, base timestamp)
+ *        trailer:= 32 bytes, magic "O3IX", index offset, block numbers, record numbers
+ *        the writer appends the index and the trailer on close, a reader rebuilds the
+ *        index from the block headers when the trailer is missing after a crash
+ */
+#define OPT300X_BINLOG_VERSION              1             /**< format version */
+#define OPT300X_BINLOG_MAX_SENSOR           16            /**< max sensor ids */
+#define OPT300X_BINLOG_MAX_BLOCK_RECORD     4096          /**< max records per block */
+#define OPT300X_BINLOG_DEFAULT_BLOCK_RECORD 4096          /**< default records per block */
+
+/**
+ * @brief opt300x binary log record structure definition
+ */
+typedef struct opt300x_binlog_record_s
+{
+    uint32_t delta_us;        /**< timestamp delta from the block base */
+    uint16_t raw;             /**< raw result word */
+    uint8_t sensor;           /**< sensor id */
+    uint8_t flags;            /**< flags, reserved as 0 */
+} opt300x_binlog_record_t;
+
+/**
+ * @brief opt300x binary log block header structure definition
+ */
+typedef struct opt300x_binlog_block_s
+{
+    uint32_t magic;               /**< block magic */
+    uint32_t count;               /**< records in the block */
+    uint64_t first;               /**< first record number */
+    uint64_t base_us;             /**< base timestamp */
+    uint64_t last_us;             /**< last timestamp */
+} opt300x_binlog_block_t;
+
+/**
+ * @brief opt300x binary log index structure definition
+ */
+typedef struct opt300x_binlog_index_s
+{
+    uint64_t offset;              /**< block file offset */
+    uint64_t first;               /**< first record number */
+    uint64_t base_us;             /**< base timestamp */
+} opt300x_binlog_index_t;
+
+/**
+ * @brief opt300x binary log sensor structure definition
+ */
+typedef struct opt300x_binlog_sensor_s
+{
+    opt300x_t type;                      /**< chip type */
+    opt300x_address_t addr;              /**< address pin */
+} opt300x_binlog_sensor_t;
+
+/**
+ * @brief opt300x binary log sample structure definition
+ */
+typedef struct opt300x_binlog_sample_s
+{
+    uint64_t timestamp_us;        /**< timestamp */
+    float data;                   /**< lux or nW/cm2 */
+    uint16_t raw;                 /**< raw result word */
+    uint8_t sensor;               /**< sensor id */
+} opt300x_binlog_sample_t;
+
+/**
+ * @brief opt300x binary log writer structure definition
+ */
+typedef struct opt300x_binlog_writer_s
+{
+    int fd;                                                                 /**< file handle */
+    uint32_t block_record;                                                  /**< max records per block */
+    uint8_t sensor_num;                                                     /**< sensor numbers */
+    uint64_t record_num;                                                    /**< written records */
+    uint64_t block_num;                                                     /**< written blocks */
+    uint64_t offset;                                                        /**< file end */
+    uint64_t last_us;                                                       /**< last appended timestamp */
+    opt300x_binlog_block_t block;                                           /**< current block header */
+    opt300x_binlog_record_t record[OPT300X_BINLOG_MAX_BLOCK_RECORD];        /**< current block records */
+} opt300x_binlog_writer_t;
+
+/**
+ * @brief opt300x binary log reader structure definition
+ */
+typedef struct opt300x_binlog_reader_s
+{
+    const uint8_t *base;                                                    /**< mapped file */
+    size_t size;                                                            /**< mapped size */
+    int fd;                                                                 /**< file handle */
+    uint8_t sensor_num;                                                     /**< sensor numbers */
+    uint8_t type[OPT300X_BINLOG_MAX_SENSOR];                                /**< chip type of every sensor id */
+    float scale[OPT300X_BINLOG_MAX_SENSOR][16];                             /**< lsb weight of every sensor id and exponent */
+    const opt300x_binlog_index_t *index;                                    /**< block index */
+    opt300x_binlog_index_t *owned;                                          /**< rebuilt index, NULL when the trailer is used */
+    uint64_t block_num;                                                     /**< block numbers */
+    uint64_t record_num;                                                    /**< record numbers */
+} opt300x_binlog_reader_t;
+
+/**
+ * @brief     open a binary log for appending
+ * @param[in] *writer pointer to a writer structure
+ * @param[in] *path pointer to a file path
+ * @param[in] *sensor pointer to a sensor table, the index is the sensor id
+ * @param[in] num sensor numbers
+ * @param[in] block_record max records per block
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 2 handle is NULL
+ *            - 4 param is invalid
+ *            - 5 the existing file has another sensor table
+ * @note      an existing file is continued after its last complete block,
+ *            its index and trailer are replaced on close
+ */
+uint8_t opt300x_binlog_writer_open(opt300x_binlog_writer_t *writer, const char *path,
+                                   const opt300x_binlog_sensor_t *sensor, uint8_t num, uint32_t block_record);
+
+/**
+ * @brief     append one sample
+ * @param[in] *writer pointer to a writer structure
+ * @param[in] sensor sensor id
+ * @param[in] raw raw result word
+ * @param[in] timestamp_us timestamp
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 4 sensor is invalid
+ * @note      a new block starts when the block is full or the delta doesn't fit 32 bits,
+ *            a timestamp before the last appended one is clamped to it, so opt300x_binlog_reader_seek
+ *            still sees non-decreasing timestamps after the clock steps back
+ */
+uint8_t opt300x_binlog_append(opt300x_binlog_writer_t *writer, uint8_t sensor, uint16_t raw, uint64_t timestamp_us);
+
+/**
+ * @brief     read a sensor and append the sample
+ * @param[in] *writer pointer to a writer structure
+ * @param[in] sensor sensor id
+ * @param[in] *handle pointer to an opt300x handle structure in continuous mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 read or write failed
+ *            - 2 handle is NULL
+ *            - 4 sensor is invalid
+ * @note      the timestamp comes from the timestamp_us hook of the handle
+ */
+uint8_t opt300x_binlog_read_append(opt300x_binlog_writer_t *writer, uint8_t sensor, opt300x_handle_t *handle);
+
+/**
+ * @brief     write the current block to the file
+ * @param[in] *writer pointer to a writer structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ * @note      the block is closed even if it is not full, a crash loses at most the unflushed block
+ */
+uint8_t opt300x_binlog_flush(opt300x_binlog_writer_t *writer);
+
+/**
+ * @brief     close a binary log
+ * @param[in] *writer pointer to a writer structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ *            - 2 handle is NULL
+ * @note      flushes the block and appends the index and the trailer
+ */
+uint8_t opt300x_binlog_writer_close(opt300x_binlog_writer_t *writer);
+
+/**
+ * @brief     open a binary log for reading
+ * @param[in] *reader pointer to a reader structure
+ * @param[in] *path pointer to a file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 2 handle is NULL
+ *            - 4 file is invalid
+ * @note      the file is memory mapped, a missing trailer is rebuilt from the block headers
+ */
+uint8_t opt300x_binlog_reader_open(opt300x_binlog_reader_t *reader, const char *path);
+
+/**
+ * @brief     close a binary log reader
+ * @param[in] *reader pointer to a reader structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t opt300x_binlog_reader_close(opt300x_binlog_reader_t *reader);
+
+/**
+ * @brief      get one sample by record number
+ * @param[in]  *reader pointer to a reader structure
+ * @param[in]  n record number
+ * @param[out] *sample pointer to a sample buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 n is out of range
+ * @note       O(log blocks)
+ */
+uint8_t opt300x_binlog_reader_get(opt300x_binlog_reader_t *reader, uint64_t n, opt300x_binlog_sample_t *sample);
+
+/**
+ * @brief      find the first record at or after a timestamp
+ * @param[in]  *reader pointer to a reader structure
+ * @param[in]  timestamp_us timestamp
+ * @param[out] *n pointer to a record number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 no record is at or after the timestamp
+ * @note       the writer clamps the timestamps, so they never go backwards across blocks
+ */
+uint8_t opt300x_binlog_reader_seek(opt300x_binlog_reader_t *reader, uint64_t timestamp_us, uint64_t *n);
+
+/**
+ * @brief      convert a range of records
+ * @param[in]  *reader pointer to a reader structure
+ * @param[in]  first first record number
+ * @param[in]  len max records
+ * @param[out] *data pointer to a lux or nW/cm2 buffer
+ * @param[out] *timestamp_us pointer to a timestamp buffer, can be NULL
+ * @param[out] *sensor pointer to a sensor id buffer, can be NULL
+ * @return     converted records
+ * @note       walks the blocks in place, the conversion is one table lookup and one multiply
+ */
+uint64_t opt300x_binlog_reader_scan(opt300x_binlog_reader_t *reader, uint64_t first, uint64_t len,
+                                    float *data, uint64_t *timestamp_us, uint8_t *sensor);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
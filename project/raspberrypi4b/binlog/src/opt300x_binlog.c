@@ -0,0 +1,879 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      opt300x_binlog.c
+ * @brief     opt300x binary log source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "opt300x_binlog.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief binary log magic definition
+ */
+#define BINLOG_MAGIC_FILE         0x4C42334FU        /**< "O3BL" */
+#define BINLOG_MAGIC_BLOCK        0x304B4C42U        /**< "BLK0" */
+#define BINLOG_MAGIC_TRAILER      0x5849334FU        /**< "O3IX" */
+#define BINLOG_INDEX_CHUNK        256                /**< index entries written at once */
+
+/**
+ * @brief binary log file header structure definition
+ */
+typedef struct binlog_header_s
+{
+    uint32_t magic;                                  /**< file magic */
+    uint16_t version;                                /**< format version */
+    uint16_t record_size;                            /**< record size */
+    uint32_t block_record;                           /**< max records per block */
+    uint8_t sensor_num;                              /**< sensor numbers */
+    uint8_t reserved[3];                             /**< reserved */
+    uint8_t type[OPT300X_BINLOG_MAX_SENSOR];         /**< chip type of every sensor id */
+    uint8_t addr[OPT300X_BINLOG_MAX_SENSOR];         /**< address pin of every sensor id */
+    uint8_t reserved2[16];                           /**< pad to 64 bytes */
+} binlog_header_t;
+
+/**
+ * @brief binary log trailer structure definition
+ */
+typedef struct binlog_trailer_s
+{
+    uint32_t magic;                /**< trailer magic */
+    uint32_t reserved;             /**< reserved */
+    uint64_t index_offset;         /**< index file offset */
+    uint64_t block_num;            /**< block numbers */
+    uint64_t record_num;           /**< record numbers */
+} binlog_trailer_t;
+
+/**
+ * @brief     check a block header
+ * @param[in] *block pointer to a block header
+ * @param[in] offset block file offset
+ * @param[in] end file end
+ * @param[in] block_record max records per block
+ * @param[in] first expected first record number
+ * @return    status code
+ *            - 0 valid
+ *            - 1 invalid
+ * @note      none
+ */
+static uint8_t a_binlog_check_block(const opt300x_binlog_block_t *block, uint64_t offset, uint64_t end,
+                                    uint32_t block_record, uint64_t first)
+{
+    if ((block->magic != BINLOG_MAGIC_BLOCK) || (block->count == 0) ||
+        (block->count > block_record) || (block->first != first))                                /* check the header */
+    {
+        return 1;                                                                                /* return error */
+    }
+    if (offset + sizeof(opt300x_binlog_block_t) +
+        (uint64_t)block->count * sizeof(opt300x_binlog_record_t) > end)                          /* check the size */
+    {
+        return 1;                                                                                /* return error */
+    }
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     check a file header
+ * @param[in] *header pointer to a file header
+ * @return    status code
+ *            - 0 valid
+ *            - 1 invalid
+ * @note      none
+ */
+static uint8_t a_binlog_check_header(const binlog_header_t *header)
+{
+    if ((header->magic != BINLOG_MAGIC_FILE) || (header->version != OPT300X_BINLOG_VERSION) ||
+        (header->record_size != sizeof(opt300x_binlog_record_t)) ||
+        (header->block_record == 0) || (header->block_record > OPT300X_BINLOG_MAX_BLOCK_RECORD) ||
+        (header->sensor_num == 0) || (header->sensor_num > OPT300X_BINLOG_MAX_SENSOR))           /* check the header */
+    {
+        return 1;                                                                                /* return error */
+    }
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     write a buffer at an offset
+ * @param[in] fd file handle
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len buffer length
+ * @param[in] offset file offset
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_binlog_pwrite(int fd, const void *buf, size_t len, uint64_t offset)
+{
+    const uint8_t *p = (const uint8_t *)buf;
+    
+    while (len > 0)                                                            /* write all */
+    {
+        ssize_t res;
+        
+        res = pwrite(fd, p, len, (off_t)offset);                               /* write */
+        if (res <= 0)                                                          /* check the result */
+        {
+            return 1;                                                          /* return error */
+        }
+        p += res;                                                              /* next */
+        len -= (size_t)res;                                                    /* left */
+        offset += (uint64_t)res;                                               /* next offset */
+    }
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     open a binary log for appending
+ * @param[in] *writer pointer to a writer structure
+ * @param[in] *path pointer to a file path
+ * @param[in] *sensor pointer to a sensor table, the index is the sensor id
+ * @param[in] num sensor numbers
+ * @param[in] block_record max records per block
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 2 handle is NULL
+ *            - 4 param is invalid
+ *            - 5 the existing file has another sensor table
+ * @note      an existing file is continued after its last complete block,
+ *            its index and trailer are replaced on close
+ */
+uint8_t opt300x_binlog_writer_open(opt300x_binlog_writer_t *writer, const char *path,
+                                   const opt300x_binlog_sensor_t *sensor, uint8_t num, uint32_t block_record)
+{
+    uint8_t i;
+    struct stat st;
+    binlog_header_t header;
+    
+    if (writer == NULL)                                                                          /* check writer */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if ((path == NULL) || (sensor == NULL) || (num == 0) || (num > OPT300X_BINLOG_MAX_SENSOR) ||
+        (block_record == 0) || (block_record > OPT300X_BINLOG_MAX_BLOCK_RECORD))                 /* check the param */
+    {
+        return 4;                                                                                /* return error */
+    }
+    
+    memset(&header, 0, sizeof(binlog_header_t));                                                 /* clear the header */
+    header.magic = BINLOG_MAGIC_FILE;                                                            /* set the magic */
+    header.version = OPT300X_BINLOG_VERSION;                                                     /* set the version */
+    header.record_size = sizeof(opt300x_binlog_record_t);                                        /* set the record size */
+    header.block_record = block_record;                                                          /* set the block size */
+    header.sensor_num = num;                                                                     /* set the sensor numbers */
+    for (i = 0; i < num; i++)                                                                    /* set the sensor table */
+    {
+        header.type[i] = (uint8_t)sensor[i].type;                                                /* set the type */
+        header.addr[i] = (uint8_t)sensor[i].addr;                                                /* set the address */
+    }
+    
+    writer->fd = open(path, O_RDWR | O_CREAT, 0644);                                             /* open the file */
+    if (writer->fd < 0)                                                                          /* check the result */
+    {
+        return 1;                                                                                /* return error */
+    }
+    if (fstat(writer->fd, &st) != 0)                                                             /* get the size */
+    {
+        (void)close(writer->fd);                                                                 /* close the file */
+        
+        return 1;                                                                                /* return error */
+    }
+    writer->record_num = 0;                                                                      /* no records */
+    writer->block_num = 0;                                                                       /* no blocks */
+    writer->offset = sizeof(binlog_header_t);                                                    /* after the header */
+    writer->last_us = 0;                                                                         /* no timestamp */
+    if (st.st_size == 0)                                                                         /* new file */
+    {
+        if (a_binlog_pwrite(writer->fd, &header, sizeof(binlog_header_t), 0) != 0)               /* write the header */
+        {
+            (void)close(writer->fd);                                                             /* close the file */
+            
+            return 1;                                                                            /* return error */
+        }
+    }
+    else                                                                                         /* existing file */
+    {
+        binlog_header_t prev;
+        opt300x_binlog_block_t block;
+        
+        if (pread(writer->fd, &prev, sizeof(binlog_header_t), 0) != (ssize_t)sizeof(binlog_header_t))
+        {
+            (void)close(writer->fd);                                                             /* close the file */
+            
+            return 1;                                                                            /* return error */
+        }
+        if (a_binlog_check_header(&prev) != 0)                                                   /* check the header */
+        {
+            (void)close(writer->fd);                                                             /* close the file */
+            
+            return 4;                                                                            /* return error */
+        }
+        if ((prev.sensor_num != num) ||
+            (memcmp(prev.type, header.type, sizeof(header.type)) != 0) ||
+            (memcmp(prev.addr, header.addr, sizeof(header.addr)) != 0))                          /* check the sensor table */
+        {
+            (void)close(writer->fd);                                                             /* close the file */
+            
+            return 5;                                                                            /* return error */
+        }
+        block_record = prev.block_record;                                                        /* keep the block size */
+        while (pread(writer->fd, &block, sizeof(opt300x_binlog_block_t), (off_t)writer->offset) ==
+               (ssize_t)sizeof(opt300x_binlog_block_t))                                          /* walk the blocks */
+        {
+            if (a_binlog_check_block(&block, writer->offset, (uint64_t)st.st_size,
+                                     block_record, writer->record_num) != 0)                     /* stop at the index or a torn block */
+            {
+                break;                                                                           /* break */
+            }
+            writer->offset += sizeof(opt300x_binlog_block_t) +
+                              (uint64_t)block.count * sizeof(opt300x_binlog_record_t);           /* next block */
+            writer->record_num += block.count;                                                   /* add the records */
+            writer->block_num++;                                                                 /* add the block */
+            if (block.last_us > writer->last_us)                                                 /* later timestamp */
+            {
+                writer->last_us = block.last_us;                                                 /* set the last timestamp */
+            }
+        }
+        if (ftruncate(writer->fd, (off_t)writer->offset) != 0)                                   /* drop the index and the trailer */
+        {
+            (void)close(writer->fd);                                                             /* close the file */
+            
+            return 1;                                                                            /* return error */
+        }
+    }
+    writer->block_record = block_record;                                                         /* set the block size */
+    writer->sensor_num = num;                                                                    /* set the sensor numbers */
+    memset(&writer->block, 0, sizeof(opt300x_binlog_block_t));                                   /* clear the block */
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     write the current block to the file
+ * @param[in] *writer pointer to a writer structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ * @note      the block is closed even if it is not full, a crash loses at most the unflushed block
+ */
+uint8_t opt300x_binlog_flush(opt300x_binlog_writer_t *writer)
+{
+    uint64_t len;
+    
+    if (writer == NULL)                                                                          /* check writer */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (writer->block.count == 0)                                                                /* nothing to write */
+    {
+        return 0;                                                                                /* success return 0 */
+    }
+    
+    len = (uint64_t)writer->block.count * sizeof(opt300x_binlog_record_t);                       /* records length */
+    if (a_binlog_pwrite(writer->fd, writer->record, (size_t)len,
+                        writer->offset + sizeof(opt300x_binlog_block_t)) != 0)                   /* write the records */
+    {
+        return 1;                                                                                /* return error */
+    }
+    if (a_binlog_pwrite(writer->fd, &writer->block, sizeof(opt300x_binlog_block_t),
+                        writer->offset) != 0)                                                    /* write the header last */
+    {
+        return 1;                                                                                /* return error */
+    }
+    writer->offset += sizeof(opt300x_binlog_block_t) + len;                                      /* next block */
+    writer->block_num++;                                                                         /* add the block */
+    writer->block.count = 0;                                                                     /* empty block */
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     append one sample
+ * @param[in] *writer pointer to a writer structure
+ * @param[in] sensor sensor id
+ * @param[in] raw raw result word
+ * @param[in] timestamp_us timestamp
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 4 sensor is invalid
+ * @note      a new block starts when the block is full or the delta doesn't fit 32 bits,
+ *            a timestamp before the last appended one is clamped to it, so opt300x_binlog_reader_seek
+ *            still sees non-decreasing timestamps after the clock steps back
+ */
+uint8_t opt300x_binlog_append(opt300x_binlog_writer_t *writer, uint8_t sensor, uint16_t raw, uint64_t timestamp_us)
+{
+    opt300x_binlog_record_t *record;
+    
+    if (writer == NULL)                                                                          /* check writer */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (sensor >= writer->sensor_num)                                                            /* check the sensor */
+    {
+        return 4;                                                                                /* return error */
+    }
+    
+    if (timestamp_us < writer->last_us)                                                          /* the clock stepped back */
+    {
+        timestamp_us = writer->last_us;                                                          /* clamp to the last timestamp */
+    }
+    if ((writer->block.count != 0) &&
+        ((writer->block.count >= writer->block_record) ||
+         (timestamp_us - writer->block.base_us > 0xFFFFFFFFULL)))                                /* block is full or delta overflows */
+    {
+        if (opt300x_binlog_flush(writer) != 0)                                                   /* close the block */
+        {
+            return 1;                                                                            /* return error */
+        }
+    }
+    if (writer->block.count == 0)                                                                /* new block */
+    {
+        writer->block.magic = BINLOG_MAGIC_BLOCK;                                                /* set the magic */
+        writer->block.first = writer->record_num;                                                /* set the first record */
+        writer->block.base_us = timestamp_us;                                                    /* set the base */
+    }
+    record = &writer->record[writer->block.count];                                               /* get the record */
+    record->delta_us = (uint32_t)(timestamp_us - writer->block.base_us);                         /* set the delta */
+    record->raw = raw;                                                                           /* set the raw word */
+    record->sensor = sensor;                                                                     /* set the sensor */
+    record->flags = 0;                                                                           /* no flags */
+    writer->block.last_us = timestamp_us;                                                        /* set the last timestamp */
+    writer->last_us = timestamp_us;                                                              /* save the last timestamp */
+    writer->block.count++;                                                                       /* add the record */
+    writer->record_num++;                                                                        /* add the record */
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     read a sensor and append the sample
+ * @param[in] *writer pointer to a writer structure
+ * @param[in] sensor sensor id
+ * @param[in] *handle pointer to an opt300x handle structure in continuous mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 read or write failed
+ *            - 2 handle is NULL
+ *            - 4 sensor is invalid
+ * @note      the timestamp comes from the timestamp_us hook of the handle
+ */
+uint8_t opt300x_binlog_read_append(opt300x_binlog_writer_t *writer, uint8_t sensor, opt300x_handle_t *handle)
+{
+    uint8_t res;
+    uint16_t raw;
+    float data;
+    
+    if ((writer == NULL) || (handle == NULL))                                                    /* check writer and handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (sensor >= writer->sensor_num)                                                            /* check the sensor */
+    {
+        return 4;                                                                                /* return error */
+    }
+    
+    if (handle->type == (uint8_t)OPT3002)                                                        /* opt3002 */
+    {
+        res = opt3002_continuous_read(handle, &raw, &data);                                      /* read nW/cm2 */
+    }
+    else                                                                                         /* the others */
+    {
+        res = opt300x_continuous_read(handle, &raw, &data);                                      /* read lux */
+    }
+    if (res != 0)                                                                                /* check the result */
+    {
+        return 1;                                                                                /* return error */
+    }
+    
+    return opt300x_binlog_append(writer, sensor, raw,
+                                 (handle->timestamp_us != NULL) ? handle->timestamp_us() : 0);   /* append the sample */
+}
+
+/**
+ * @brief     close a binary log
+ * @param[in] *writer pointer to a writer structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ *            - 2 handle is NULL
+ * @note      flushes the block and appends the index and the trailer
+ */
+uint8_t opt300x_binlog_writer_close(opt300x_binlog_writer_t *writer)
+{
+    uint8_t res;
+    uint32_t num;
+    uint64_t offset;
+    uint64_t index_offset;
+    opt300x_binlog_block_t block;
+    opt300x_binlog_index_t index[BINLOG_INDEX_CHUNK];
+    binlog_trailer_t trailer;
+    
+    if (writer == NULL)                                                                          /* check writer */
+    {
+        return 2;                                                                                /* return error */
+    }
+    
+    res = opt300x_binlog_flush(writer);                                                          /* flush the block */
+    offset = sizeof(binlog_header_t);                                                            /* first block */
+    index_offset = writer->offset;                                                               /* index after the blocks */
+    num = 0;                                                                                     /* no entries */
+    while ((res == 0) && (offset < index_offset))                                                /* walk the blocks */
+    {
+        if (pread(writer->fd, &block, sizeof(opt300x_binlog_block_t), (off_t)offset) !=
+            (ssize_t)sizeof(opt300x_binlog_block_t))                                             /* read the block header */
+        {
+            res = 1;                                                                             /* set error */
+            
+            break;                                                                               /* break */
+        }
+        index[num].offset = offset;                                                              /* set the offset */
+        index[num].first = block.first;                                                          /* set the first record */
+        index[num].base_us = block.base_us;                                                      /* set the base */
+        num++;                                                                                   /* add the entry */
+        offset += sizeof(opt300x_binlog_block_t) +
+                  (uint64_t)block.count * sizeof(opt300x_binlog_record_t);                       /* next block */
+        if ((num == BINLOG_INDEX_CHUNK) || (offset >= index_offset))                             /* write the entries */
+        {
+            if (a_binlog_pwrite(writer->fd, index, num * sizeof(opt300x_binlog_index_t),
+                                writer->offset) != 0)                                            /* write the index */
+            {
+                res = 1;                                                                         /* set error */
+                
+                break;                                                                           /* break */
+            }
+            writer->offset += num * sizeof(opt300x_binlog_index_t);                              /* next entries */
+            num = 0;                                                                             /* empty chunk */
+        }
+    }
+    if (res == 0)                                                                                /* write the trailer */
+    {
+        memset(&trailer, 0, sizeof(binlog_trailer_t));                                           /* clear the trailer */
+        trailer.magic = BINLOG_MAGIC_TRAILER;                                                    /* set the magic */
+        trailer.index_offset = index_offset;                                                     /* set the index offset */
+        trailer.block_num = writer->block_num;                                                   /* set the block numbers */
+        trailer.record_num = writer->record_num;                                                 /* set the record numbers */
+        res = a_binlog_pwrite(writer->fd, &trailer, sizeof(binlog_trailer_t), writer->offset);   /* write the trailer */
+    }
+    if (close(writer->fd) != 0)                                                                  /* close the file */
+    {
+        res = 1;                                                                                 /* set error */
+    }
+    writer->fd = -1;                                                                             /* closed */
+    
+    return res;                                                                                  /* return the result */
+}
+
+/**
+ * @brief     open a binary log for reading
+ * @param[in] *reader pointer to a reader structure
+ * @param[in] *path pointer to a file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 2 handle is NULL
+ *            - 4 file is invalid
+ * @note      the file is memory mapped, a missing trailer is rebuilt from the block headers
+ */
+uint8_t opt300x_binlog_reader_open(opt300x_binlog_reader_t *reader, const char *path)
+{
+    uint8_t i;
+    uint8_t e;
+    struct stat st;
+    void *base;
+    const binlog_header_t *header;
+    const binlog_trailer_t *trailer;
+    
+    if (reader == NULL)                                                                          /* check reader */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (path == NULL)                                                                            /* check path */
+    {
+        return 4;                                                                                /* return error */
+    }
+    
+    reader->fd = open(path, O_RDONLY);                                                           /* open the file */
+    if (reader->fd < 0)                                                                          /* check the result */
+    {
+        return 1;                                                                                /* return error */
+    }
+    if ((fstat(reader->fd, &st) != 0) || ((size_t)st.st_size < sizeof(binlog_header_t)))         /* check the size */
+    {
+        (void)close(reader->fd);                                                                 /* close the file */
+        
+        return 4;                                                                                /* return error */
+    }
+    base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, reader->fd, 0);                 /* map the file */
+    if (base == MAP_FAILED)                                                                      /* check the result */
+    {
+        (void)close(reader->fd);                                                                 /* close the file */
+        
+        return 1;                                                                                /* return error */
+    }
+    reader->base = (const uint8_t *)base;                                                        /* set the base */
+    reader->size = (size_t)st.st_size;                                                           /* set the size */
+    reader->owned = NULL;                                                                        /* no rebuilt index */
+    header = (const binlog_header_t *)reader->base;                                              /* get the header */
+    if (a_binlog_check_header(header) != 0)                                                      /* check the header */
+    {
+        (void)opt300x_binlog_reader_close(reader);                                               /* close the reader */
+        
+        return 4;                                                                                /* return error */
+    }
+    reader->sensor_num = header->sensor_num;                                                     /* set the sensor numbers */
+    for (i = 0; i < OPT300X_BINLOG_MAX_SENSOR; i++)                                              /* build the scale table */
+    {
+        float weight;
+        
+        reader->type[i] = header->type[i];                                                       /* set the type */
+        if (header->type[i] == (uint8_t)OPT3002)                                                 /* opt3002 */
+        {
+            weight = 1.2f;                                                                       /* nW/cm2 */
+        }
+        else if (header->type[i] == (uint8_t)OPT3005)                                            /* opt3005 */
+        {
+            weight = 0.02f;                                                                      /* lux */
+        }
+        else                                                                                     /* the others */
+        {
+            weight = 0.01f;                                                                      /* lux */
+        }
+        for (e = 0; e < 16; e++)                                                                 /* every exponent */
+        {
+            reader->scale[i][e] = weight * (float)(1UL << e);                                    /* lsb weight */
+        }
+    }
+    
+    trailer = (const binlog_trailer_t *)(reader->base + reader->size - sizeof(binlog_trailer_t));
+    if ((reader->size >= sizeof(binlog_header_t) + sizeof(binlog_trailer_t)) &&
+        (trailer->magic == BINLOG_MAGIC_TRAILER) &&
+        (trailer->index_offset >= sizeof(binlog_header_t)) &&
+        (trailer->block_num <= (reader->size - sizeof(binlog_trailer_t)) / sizeof(opt300x_binlog_index_t)) &&
+        (trailer->index_offset + trailer->block_num * sizeof(opt300x_binlog_index_t) +
+         sizeof(binlog_trailer_t) == reader->size))                                              /* use the trailer */
+    {
+        reader->index = (const opt300x_binlog_index_t *)(reader->base + trailer->index_offset);  /* index in the file */
+        reader->block_num = trailer->block_num;                                                  /* set the block numbers */
+        reader->record_num = trailer->record_num;                                                /* set the record numbers */
+    }
+    else                                                                                         /* rebuild the index */
+    {
+        uint64_t cap = 0;
+        uint64_t offset = sizeof(binlog_header_t);
+        
+        reader->block_num = 0;                                                                   /* no blocks */
+        reader->record_num = 0;                                                                  /* no records */
+        while (offset + sizeof(opt300x_binlog_block_t) <= reader->size)                          /* walk the blocks */
+        {
+            const opt300x_binlog_block_t *block = (const opt300x_binlog_block_t *)(reader->base + offset);
+            
+            if (a_binlog_check_block(block, offset, reader->size,
+                                     header->block_record, reader->record_num) != 0)             /* stop at a torn block */
+            {
+                break;                                                                           /* break */
+            }
+            if (reader->block_num == cap)                                                        /* grow the index */
+            {
+                opt300x_binlog_index_t *index;
+                
+                cap = (cap == 0) ? 64 : cap * 2;                                                 /* double */
+                index = (opt300x_binlog_index_t *)realloc(reader->owned, (size_t)cap * sizeof(opt300x_binlog_index_t));
+                if (index == NULL)                                                               /* check the result */
+                {
+                    (void)opt300x_binlog_reader_close(reader);                                   /* close the reader */
+                    
+                    return 1;                                                                    /* return error */
+                }
+                reader->owned = index;                                                           /* set the index */
+            }
+            reader->owned[reader->block_num].offset = offset;                                    /* set the offset */
+            reader->owned[reader->block_num].first = block->first;                               /* set the first record */
+            reader->owned[reader->block_num].base_us = block->base_us;                           /* set the base */
+            reader->block_num++;                                                                 /* add the block */
+            reader->record_num += block->count;                                                  /* add the records */
+            offset += sizeof(opt300x_binlog_block_t) +
+                      (uint64_t)block->count * sizeof(opt300x_binlog_record_t);                  /* next block */
+        }
+        reader->index = reader->owned;                                                           /* rebuilt index */
+    }
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     close a binary log reader
+ * @param[in] *reader pointer to a reader structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t opt300x_binlog_reader_close(opt300x_binlog_reader_t *reader)
+{
+    if (reader == NULL)                                                        /* check reader */
+    {
+        return 2;                                                              /* return error */
+    }
+    
+    if (reader->base != NULL)                                                  /* mapped */
+    {
+        (void)munmap((void *)reader->base, reader->size);                      /* unmap the file */
+        reader->base = NULL;                                                   /* clear the base */
+    }
+    if (reader->fd >= 0)                                                       /* opened */
+    {
+        (void)close(reader->fd);                                               /* close the file */
+        reader->fd = -1;                                                       /* closed */
+    }
+    free(reader->owned);                                                       /* free the rebuilt index */
+    reader->owned = NULL;                                                      /* clear the index */
+    reader->index = NULL;                                                      /* clear the index */
+    reader->block_num = 0;                                                     /* no blocks */
+    reader->record_num = 0;                                                    /* no records */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     find the block of a record
+ * @param[in] *reader pointer to a reader structure
+ * @param[in] n record number
+ * @return    block index
+ * @note      n must be less than the record numbers
+ */
+static uint64_t a_binlog_find_block(opt300x_binlog_reader_t *reader, uint64_t n)
+{
+    uint64_t lo = 0;
+    uint64_t hi = reader->block_num - 1;
+    
+    while (lo < hi)                                                            /* binary search */
+    {
+        uint64_t mid = lo + (hi - lo + 1) / 2;
+        
+        if (reader->index[mid].first <= n)                                     /* record is in mid or after */
+        {
+            lo = mid;                                                          /* move up */
+        }
+        else                                                                   /* record is before mid */
+        {
+            hi = mid - 1;                                                      /* move down */
+        }
+    }
+    
+    return lo;                                                                 /* return the block */
+}
+
+/**
+ * @brief      get one sample by record number
+ * @param[in]  *reader pointer to a reader structure
+ * @param[in]  n record number
+ * @param[out] *sample pointer to a sample buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 n is out of range
+ * @note       O(log blocks)
+ */
+uint8_t opt300x_binlog_reader_get(opt300x_binlog_reader_t *reader, uint64_t n, opt300x_binlog_sample_t *sample)
+{
+    uint64_t b;
+    const opt300x_binlog_block_t *block;
+    const opt300x_binlog_record_t *record;
+    
+    if ((reader == NULL) || (sample == NULL))                                                    /* check reader and sample */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (n >= reader->record_num)                                                                 /* check n */
+    {
+        return 4;                                                                                /* return error */
+    }
+    
+    b = a_binlog_find_block(reader, n);                                                          /* find the block */
+    block = (const opt300x_binlog_block_t *)(reader->base + reader->index[b].offset);            /* get the block */
+    record = (const opt300x_binlog_record_t *)(block + 1) + (n - block->first);                  /* get the record */
+    sample->timestamp_us = block->base_us + record->delta_us;                                    /* set the timestamp */
+    sample->raw = record->raw;                                                                   /* set the raw word */
+    sample->sensor = record->sensor;                                                             /* set the sensor */
+    sample->data = reader->scale[record->sensor & 0x0F][record->raw >> 12] *
+                   (float)(record->raw & 0x0FFF);                                                /* convert */
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      find the first record at or after a timestamp
+ * @param[in]  *reader pointer to a reader structure
+ * @param[in]  timestamp_us timestamp
+ * @param[out] *n pointer to a record number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 no record is at or after the timestamp
+ * @note       the writer clamps the timestamps, so they never go backwards across blocks
+ */
+uint8_t opt300x_binlog_reader_seek(opt300x_binlog_reader_t *reader, uint64_t timestamp_us, uint64_t *n)
+{
+    uint64_t lo;
+    uint64_t hi;
+    uint64_t b;
+    
+    if ((reader == NULL) || (n == NULL))                                                         /* check reader and n */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (reader->block_num == 0)                                                                  /* empty log */
+    {
+        return 4;                                                                                /* return error */
+    }
+    
+    lo = 0;                                                                                      /* first block */
+    hi = reader->block_num - 1;                                                                  /* last block */
+    while (lo < hi)                                                                              /* last block with base <= timestamp */
+    {
+        uint64_t mid = lo + (hi - lo + 1) / 2;
+        
+        if (reader->index[mid].base_us <= timestamp_us)                                          /* base is before */
+        {
+            lo = mid;                                                                            /* move up */
+        }
+        else                                                                                     /* base is after */
+        {
+            hi = mid - 1;                                                                        /* move down */
+        }
+    }
+    for (b = lo; b < reader->block_num; b++)                                                     /* search the block and the next */
+    {
+        uint32_t i;
+        const opt300x_binlog_block_t *block;
+        const opt300x_binlog_record_t *record;
+        
+        block = (const opt300x_binlog_block_t *)(reader->base + reader->index[b].offset);        /* get the block */
+        record = (const opt300x_binlog_record_t *)(block + 1);                                   /* get the records */
+        if (block->last_us < timestamp_us)                                                       /* all records are before */
+        {
+            continue;                                                                            /* next block */
+        }
+        for (i = 0; i < block->count; i++)                                                       /* search the records */
+        {
+            if (block->base_us + record[i].delta_us >= timestamp_us)                             /* found */
+            {
+                *n = block->first + i;                                                           /* set the record */
+                
+                return 0;                                                                        /* success return 0 */
+            }
+        }
+    }
+    
+    return 4;                                                                                    /* return error */
+}
+
+/**
+ * @brief      convert a range of records
+ * @param[in]  *reader pointer to a reader structure
+ * @param[in]  first first record number
+ * @param[in]  len max records
+ * @param[out] *data pointer to a lux or nW/cm2 buffer
+ * @param[out] *timestamp_us pointer to a timestamp buffer, can be NULL
+ * @param[out] *sensor pointer to a sensor id buffer, can be NULL
+ * @return     converted records
+ * @note       walks the blocks in place, the conversion is one table lookup and one multiply
+ */
+uint64_t opt300x_binlog_reader_scan(opt300x_binlog_reader_t *reader, uint64_t first, uint64_t len,
+                                    float *data, uint64_t *timestamp_us, uint8_t *sensor)
+{
+    uint64_t b;
+    uint64_t done;
+    
+    if ((reader == NULL) || (data == NULL) || (first >= reader->record_num))                     /* check the param */
+    {
+        return 0;                                                                                /* no records */
+    }
+    if (len > reader->record_num - first)                                                        /* clip the range */
+    {
+        len = reader->record_num - first;                                                        /* set the length */
+    }
+    
+    done = 0;                                                                                    /* no records */
+    for (b = a_binlog_find_block(reader, first); (b < reader->block_num) && (done < len); b++)   /* walk the blocks */
+    {
+        uint64_t i;
+        uint64_t start;
+        uint64_t num;
+        const opt300x_binlog_block_t *block;
+        const opt300x_binlog_record_t *record;
+        
+        block = (const opt300x_binlog_block_t *)(reader->base + reader->index[b].offset);        /* get the block */
+        start = first + done - block->first;                                                     /* first record in the block */
+        num = block->count - start;                                                              /* records in the block */
+        if (num > len - done)                                                                    /* clip to the range */
+        {
+            num = len - done;                                                                    /* set the numbers */
+        }
+        record = (const opt300x_binlog_record_t *)(block + 1) + start;                           /* get the records */
+        for (i = 0; i < num; i++)                                                                /* convert */
+        {
+            uint16_t raw = record[i].raw;
+            
+            data[done + i] = reader->scale[record[i].sensor & 0x0F][raw >> 12] * (float)(raw & 0x0FFF);
+        }
+        if (timestamp_us != NULL)                                                                /* timestamps are wanted */
+        {
+            for (i = 0; i < num; i++)                                                            /* add the base */
+            {
+                timestamp_us[done + i] = block->base_us + record[i].delta_us;                    /* set the timestamp */
+            }
+        }
+        if (sensor != NULL)                                                                      /* sensor ids are wanted */
+        {
+            for (i = 0; i < num; i++)                                                            /* copy the ids */
+            {
+                sensor[done + i] = record[i].sensor;                                             /* set the sensor */
+            }
+        }
+        done += num;                                                                             /* add the records */
+    }
+    
+    return done;                                                                                 /* return the records */
+}
@@ -0,0 +1,342 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      opt300x_binlog_bench.c
+ * @brief     opt300x binary log bench source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "opt300x_binlog.h"
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief bench definition
+ */
+#define BENCH_SENSOR        4              /**< sensor numbers */
+#define BENCH_CHUNK         65536          /**< scan buffer length */
+#define BENCH_RANDOM        1000000        /**< random reads */
+
+/**
+ * @brief  get the monotonic time
+ * @return time in ns
+ * @note   none
+ */
+static uint64_t a_bench_now_ns(void)
+{
+    struct timespec t;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &t);
+    
+    return (uint64_t)t.tv_sec * 1000000000ULL + (uint64_t)t.tv_nsec;
+}
+
+/**
+ * @brief     get the raw word of a record
+ * @param[in] n record number
+ * @return    raw word
+ * @note      walks all exponents and mantissas
+ */
+static uint16_t a_bench_raw(uint64_t n)
+{
+    return (uint16_t)((((n >> 10) % 12) << 12) | (n & 0x0FFF));
+}
+
+/**
+ * @brief     check one record
+ * @param[in] *reader pointer to a reader structure
+ * @param[in] n record number
+ * @return    1 if the record matches the written pattern
+ * @note      none
+ */
+static int a_bench_valid(opt300x_binlog_reader_t *reader, uint64_t n)
+{
+    opt300x_binlog_sample_t s;
+    
+    if (opt300x_binlog_reader_get(reader, n, &s) != 0)
+    {
+        return 0;
+    }
+    
+    return (s.timestamp_us == n * 100 + 1) && (s.raw == a_bench_raw(n)) && (s.sensor == n % BENCH_SENSOR);
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    uint32_t i;
+    uint32_t block = OPT300X_BINLOG_DEFAULT_BLOCK_RECORD;
+    uint32_t passes = 5;
+    uint64_t records = 16000000ULL;
+    uint64_t n;
+    uint64_t start;
+    uint64_t best;
+    uint64_t csv;
+    uint64_t lines;
+    uint64_t seed;
+    uint64_t errors;
+    double sum;
+    const char *path = "/tmp/opt300x_binlog_bench.bin";
+    FILE *f;
+    long size;
+    float *data;
+    opt300x_binlog_writer_t *writer;
+    opt300x_binlog_reader_t reader;
+    opt300x_binlog_sensor_t sensor[BENCH_SENSOR] =
+    {
+        {OPT3001, OPT300X_ADDRESS_GND},
+        {OPT3002, OPT300X_ADDRESS_VCC},
+        {OPT3004, OPT300X_ADDRESS_SDA},
+        {OPT3005, OPT300X_ADDRESS_SCL},
+    };
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"records", required_argument, NULL, 1},
+        {"block", required_argument, NULL, 2},
+        {"passes", required_argument, NULL, 3},
+        {"path", required_argument, NULL, 4},
+        {NULL, 0, NULL, 0},
+    };
+    
+    /* parse */
+    do
+    {
+        c = getopt_long(argc, argv, "h", long_options, &longindex);
+        switch (c)
+        {
+            case 1 :
+            {
+                records = strtoull(optarg, NULL, 10);
+                
+                break;
+            }
+            case 2 :
+            {
+                block = (uint32_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            case 3 :
+            {
+                passes = (uint32_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            case 4 :
+            {
+                path = optarg;
+                
+                break;
+            }
+            case -1 :
+            {
+                break;
+            }
+            default :
+            {
+                printf("Usage:\n");
+                printf("  opt300x_binlog_bench [--records=<num>] [--block=<num>] [--passes=<num>] [--path=<path>]\n");
+                
+                return (c == 'h') ? 0 : 1;
+            }
+        }
+    } while (c != -1);
+    if ((records == 0) || (passes == 0))
+    {
+        printf("opt300x_binlog_bench: records and passes must not be 0.\n");
+        
+        return 1;
+    }
+    
+    /* write */
+    writer = (opt300x_binlog_writer_t *)malloc(sizeof(opt300x_binlog_writer_t));
+    data = (float *)malloc(BENCH_CHUNK * sizeof(float));
+    if ((writer == NULL) || (data == NULL))
+    {
+        printf("opt300x_binlog_bench: malloc failed.\n");
+        free(writer);
+        free(data);
+        
+        return 1;
+    }
+    (void)unlink(path);
+    if (opt300x_binlog_writer_open(writer, path, sensor, BENCH_SENSOR, block) != 0)
+    {
+        printf("opt300x_binlog_bench: open %s failed.\n", path);
+        free(writer);
+        free(data);
+        
+        return 1;
+    }
+    start = a_bench_now_ns();
+    for (n = 0; n < records; n++)
+    {
+        if (opt300x_binlog_append(writer, (uint8_t)(n % BENCH_SENSOR), a_bench_raw(n), n * 100 + 1) != 0)
+        {
+            break;
+        }
+    }
+    if ((n != records) || (opt300x_binlog_writer_close(writer) != 0))
+    {
+        printf("opt300x_binlog_bench: write failed.\n");
+        free(writer);
+        free(data);
+        
+        return 1;
+    }
+    printf("opt300x_binlog_bench: write %.3f Msamples/s.\n", (double)records / ((double)(a_bench_now_ns() - start) / 1e3));
+    free(writer);
+    
+    /* size against csv */
+    f = fopen(path, "rb");
+    if (f == NULL)
+    {
+        printf("opt300x_binlog_bench: open %s failed.\n", path);
+        free(data);
+        
+        return 1;
+    }
+    (void)fseek(f, 0, SEEK_END);
+    size = ftell(f);
+    (void)fclose(f);
+    
+    /* open */
+    memset(&reader, 0, sizeof(reader));
+    if (opt300x_binlog_reader_open(&reader, path) != 0)
+    {
+        printf("opt300x_binlog_bench: map %s failed.\n", path);
+        free(data);
+        
+        return 1;
+    }
+    csv = 0;
+    lines = 0;
+    for (n = 0; n < reader.record_num; n += (reader.record_num + 9999) / 10000)
+    {
+        char line[64];
+        opt300x_binlog_sample_t s;
+        
+        (void)opt300x_binlog_reader_get(&reader, n, &s);
+        csv += (uint64_t)snprintf(line, sizeof(line), "%llu,%u,%.2f\n",
+                                  (unsigned long long)s.timestamp_us, (unsigned)s.sensor, s.data);
+        lines++;
+    }
+    printf("opt300x_binlog_bench: %llu records, %llu blocks, %.2f bytes/sample, csv about %.2f bytes/sample.\n",
+           (unsigned long long)reader.record_num, (unsigned long long)reader.block_num,
+           (double)size / (double)reader.record_num, (double)csv / (double)lines);
+    
+    /* sequential scan */
+    best = 0;
+    sum = 0.0;
+    for (i = 0; i < passes; i++)
+    {
+        uint64_t t;
+        
+        start = a_bench_now_ns();
+        for (n = 0; n < reader.record_num; n += BENCH_CHUNK)
+        {
+            uint64_t got;
+            
+            got = opt300x_binlog_reader_scan(&reader, n, BENCH_CHUNK, data, NULL, NULL);
+            sum += data[got - 1];
+        }
+        t = a_bench_now_ns() - start;
+        if ((best == 0) || (t < best))
+        {
+            best = t;
+        }
+    }
+    printf("opt300x_binlog_bench: scan %.1f Msamples/s, %.1f MB/s (check %.1f).\n",
+           (double)reader.record_num / ((double)best / 1e3),
+           (double)size / ((double)best / 1e3), sum);
+    
+    /* random access */
+    seed = 88172645463325252ULL;
+    errors = 0;
+    start = a_bench_now_ns();
+    for (i = 0; i < BENCH_RANDOM; i++)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        if (a_bench_valid(&reader, seed % reader.record_num) == 0)
+        {
+            errors++;
+        }
+    }
+    printf("opt300x_binlog_bench: random %.3f Mreads/s, %llu errors.\n",
+           (double)BENCH_RANDOM / ((double)(a_bench_now_ns() - start) / 1e3), (unsigned long long)errors);
+    (void)opt300x_binlog_reader_close(&reader);
+    
+    /* rebuild the index as after a crash */
+    if (truncate(path, size - 32) != 0)
+    {
+        printf("opt300x_binlog_bench: truncate %s failed.\n", path);
+        free(data);
+        
+        return 1;
+    }
+    start = a_bench_now_ns();
+    if (opt300x_binlog_reader_open(&reader, path) != 0)
+    {
+        printf("opt300x_binlog_bench: map %s failed.\n", path);
+        free(data);
+        
+        return 1;
+    }
+    printf("opt300x_binlog_bench: rebuild %llu blocks in %.3f ms, %llu records.\n",
+           (unsigned long long)reader.block_num, (double)(a_bench_now_ns() - start) / 1e6,
+           (unsigned long long)reader.record_num);
+    if ((reader.record_num != records) || (a_bench_valid(&reader, records - 1) == 0))
+    {
+        errors++;
+    }
+    (void)opt300x_binlog_reader_close(&reader);
+    (void)unlink(path);
+    free(data);
+    
+    return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,603 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      opt300x_binlog_test.c
+ * @brief     opt300x binary log test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "opt300x_binlog_test.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief test definition
+ */
+#define OPT300X_BINLOG_TEST_BLOCK      4                                       /**< records per block */
+#define OPT300X_BINLOG_TEST_FIRST      10                                      /**< records of the first session */
+#define OPT300X_BINLOG_TEST_SECOND     3                                       /**< records of the second session */
+#define OPT300X_BINLOG_TEST_PATH       "/tmp/opt300x_binlog_test.bin"          /**< test file path */
+
+/**
+ * @brief     get the raw word of a test record
+ * @param[in] i record number
+ * @return    raw result word
+ * @note      none
+ */
+static uint16_t a_opt300x_binlog_test_raw(uint32_t i)
+{
+    return (uint16_t)(((i % 3) << 12) | (100 + i));
+}
+
+/**
+ * @brief     get the timestamp of a test record
+ * @param[in] i record number
+ * @return    timestamp in us
+ * @note      the first record of the second session is clamped to the last one
+ */
+static uint64_t a_opt300x_binlog_test_timestamp(uint32_t i)
+{
+    if (i == OPT300X_BINLOG_TEST_FIRST)
+    {
+        i = OPT300X_BINLOG_TEST_FIRST - 1;
+    }
+    
+    return 1000 + 100 * (uint64_t)i;
+}
+
+/**
+ * @brief     get the clock time of a test record
+ * @param[in] i record number
+ * @return    clock time in us
+ * @note      the clock steps back at the first record of the second session
+ */
+static uint64_t a_opt300x_binlog_test_clock(uint32_t i)
+{
+    if (i == OPT300X_BINLOG_TEST_FIRST)
+    {
+        return 500;
+    }
+    
+    return a_opt300x_binlog_test_timestamp(i);
+}
+
+/**
+ * @brief     run the binary log test
+ * @param[in] *path pointer to a file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      none
+ */
+static uint8_t a_opt300x_binlog_test_run(const char *path)
+{
+    uint8_t res;
+    uint32_t i;
+    uint64_t n;
+    uint64_t num;
+    char bad[128];
+    FILE *fp;
+    opt300x_handle_t handle;
+    opt300x_binlog_reader_t reader;
+    opt300x_binlog_sample_t sample;
+    static opt300x_binlog_writer_t writer;
+    static float data[OPT300X_BINLOG_TEST_FIRST + OPT300X_BINLOG_TEST_SECOND];
+    static uint64_t timestamp[OPT300X_BINLOG_TEST_FIRST + OPT300X_BINLOG_TEST_SECOND];
+    static uint8_t sensor_id[OPT300X_BINLOG_TEST_FIRST + OPT300X_BINLOG_TEST_SECOND];
+    static uint8_t garbage[256];
+    opt300x_binlog_sensor_t sensor[2] = {{OPT3001, OPT300X_ADDRESS_GND}, {OPT3002, OPT300X_ADDRESS_VCC}};
+    opt300x_binlog_sensor_t other[2] = {{OPT3001, OPT300X_ADDRESS_GND}, {OPT3001, OPT300X_ADDRESS_VCC}};
+    
+    /* start binary log test */
+    opt300x_interface_debug_print("opt300x: start binary log test.\n");
+    (void)unlink(path);
+    
+    /* opt300x_binlog_writer_open test */
+    opt300x_interface_debug_print("opt300x: opt300x_binlog_writer_open test.\n");
+    res = opt300x_binlog_writer_open(NULL, path, sensor, 2, OPT300X_BINLOG_TEST_BLOCK);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_binlog_writer_open(&writer, NULL, sensor, 2, OPT300X_BINLOG_TEST_BLOCK);
+    opt300x_interface_debug_print("opt300x: check null path %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_binlog_writer_open(&writer, path, NULL, 2, OPT300X_BINLOG_TEST_BLOCK);
+    opt300x_interface_debug_print("opt300x: check null sensor table %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_binlog_writer_open(&writer, path, sensor, 0, OPT300X_BINLOG_TEST_BLOCK);
+    opt300x_interface_debug_print("opt300x: check no sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_binlog_writer_open(&writer, path, sensor, OPT300X_BINLOG_MAX_SENSOR + 1, OPT300X_BINLOG_TEST_BLOCK);
+    opt300x_interface_debug_print("opt300x: check too many sensors %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_binlog_writer_open(&writer, path, sensor, 2, 0);
+    opt300x_interface_debug_print("opt300x: check empty block %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_binlog_writer_open(&writer, path, sensor, 2, OPT300X_BINLOG_MAX_BLOCK_RECORD + 1);
+    opt300x_interface_debug_print("opt300x: check too large block %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_binlog_writer_open(&writer, "/nonexistent/opt300x_binlog_test.bin", sensor, 2, OPT300X_BINLOG_TEST_BLOCK);
+    opt300x_interface_debug_print("opt300x: check missing directory %s.\n", (res == 1) ? "ok" : "error");
+    if (res != 1)
+    {
+        return 1;
+    }
+    res = opt300x_binlog_writer_open(&writer, path, sensor, 2, OPT300X_BINLOG_TEST_BLOCK);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: open %s failed.\n", path);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check open %s.\n", "ok");
+    
+    /* opt300x_binlog_append test */
+    opt300x_interface_debug_print("opt300x: opt300x_binlog_append test.\n");
+    res = opt300x_binlog_append(NULL, 0, 0, 0);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_binlog_append(&writer, 2, 0, 0);
+    opt300x_interface_debug_print("opt300x: check invalid sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    for (i = 0; i < OPT300X_BINLOG_TEST_FIRST; i++)
+    {
+        res = opt300x_binlog_append(&writer, (uint8_t)(i % 2), a_opt300x_binlog_test_raw(i), a_opt300x_binlog_test_clock(i));
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: append failed.\n");
+            
+            return 1;
+        }
+    }
+    opt300x_interface_debug_print("opt300x: check append %s.\n", (writer.record_num == OPT300X_BINLOG_TEST_FIRST) ? "ok" : "error");
+    if (writer.record_num != OPT300X_BINLOG_TEST_FIRST)
+    {
+        return 1;
+    }
+    
+    /* opt300x_binlog_read_append test */
+    opt300x_interface_debug_print("opt300x: opt300x_binlog_read_append test.\n");
+    memset(&handle, 0, sizeof(opt300x_handle_t));
+    res = opt300x_binlog_read_append(NULL, 0, &handle);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_binlog_read_append(&writer, 0, NULL);
+    opt300x_interface_debug_print("opt300x: check null chip handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_binlog_read_append(&writer, 2, &handle);
+    opt300x_interface_debug_print("opt300x: check invalid sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_binlog_read_append(&writer, 0, &handle);
+    opt300x_interface_debug_print("opt300x: check not inited chip %s.\n", (res == 1) ? "ok" : "error");
+    if (res != 1)
+    {
+        return 1;
+    }
+    
+    /* opt300x_binlog_flush test */
+    opt300x_interface_debug_print("opt300x: opt300x_binlog_flush test.\n");
+    res = opt300x_binlog_flush(NULL);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_binlog_flush(&writer);
+    opt300x_interface_debug_print("opt300x: check flush %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    res = opt300x_binlog_flush(&writer);
+    opt300x_interface_debug_print("opt300x: check empty flush %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* opt300x_binlog_reader_open test */
+    opt300x_interface_debug_print("opt300x: opt300x_binlog_reader_open test.\n");
+    res = opt300x_binlog_reader_open(NULL, path);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_binlog_reader_open(&reader, NULL);
+    opt300x_interface_debug_print("opt300x: check null path %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_binlog_reader_open(&reader, "/nonexistent/opt300x_binlog_test.bin");
+    opt300x_interface_debug_print("opt300x: check missing file %s.\n", (res == 1) ? "ok" : "error");
+    if (res != 1)
+    {
+        return 1;
+    }
+    (void)snprintf(bad, sizeof(bad), "%s.bad", path);
+    fp = fopen(bad, "wb");
+    if (fp == NULL)
+    {
+        opt300x_interface_debug_print("opt300x: create %s failed.\n", bad);
+        
+        return 1;
+    }
+    memset(garbage, 0x5A, sizeof(garbage));
+    (void)fwrite(garbage, 1, 16, fp);
+    (void)fclose(fp);
+    res = opt300x_binlog_reader_open(&reader, bad);
+    opt300x_interface_debug_print("opt300x: check short file %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        (void)unlink(bad);
+        
+        return 1;
+    }
+    fp = fopen(bad, "wb");
+    if (fp == NULL)
+    {
+        opt300x_interface_debug_print("opt300x: create %s failed.\n", bad);
+        
+        return 1;
+    }
+    (void)fwrite(garbage, 1, sizeof(garbage), fp);
+    (void)fclose(fp);
+    res = opt300x_binlog_reader_open(&reader, bad);
+    opt300x_interface_debug_print("opt300x: check invalid header %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        (void)unlink(bad);
+        
+        return 1;
+    }
+    res = opt300x_binlog_reader_open(&reader, path);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: open %s failed.\n", path);
+        (void)unlink(bad);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check rebuilt index %s.\n",
+                                  ((reader.owned != NULL) && (reader.block_num == 3) && (reader.record_num == OPT300X_BINLOG_TEST_FIRST)) ? "ok" : "error");
+    if ((reader.owned == NULL) || (reader.block_num != 3) || (reader.record_num != OPT300X_BINLOG_TEST_FIRST))
+    {
+        (void)opt300x_binlog_reader_close(&reader);
+        (void)unlink(bad);
+        
+        return 1;
+    }
+    (void)opt300x_binlog_reader_close(&reader);
+    
+    /* opt300x_binlog_writer_close test */
+    opt300x_interface_debug_print("opt300x: opt300x_binlog_writer_close test.\n");
+    res = opt300x_binlog_writer_close(NULL);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        (void)unlink(bad);
+        
+        return 1;
+    }
+    res = opt300x_binlog_writer_close(&writer);
+    opt300x_interface_debug_print("opt300x: check close %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        (void)unlink(bad);
+        
+        return 1;
+    }
+    
+    /* continue test */
+    opt300x_interface_debug_print("opt300x: continue test.\n");
+    res = opt300x_binlog_writer_open(&writer, bad, sensor, 2, OPT300X_BINLOG_TEST_BLOCK);
+    (void)unlink(bad);
+    opt300x_interface_debug_print("opt300x: check invalid file %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_binlog_writer_open(&writer, path, other, 2, OPT300X_BINLOG_TEST_BLOCK);
+    opt300x_interface_debug_print("opt300x: check another sensor table %s.\n", (res == 5) ? "ok" : "error");
+    if (res != 5)
+    {
+        return 1;
+    }
+    res = opt300x_binlog_writer_open(&writer, path, sensor, 2, OPT300X_BINLOG_TEST_BLOCK);
+    opt300x_interface_debug_print("opt300x: check reopen %s.\n",
+                                  ((res == 0) && (writer.record_num == OPT300X_BINLOG_TEST_FIRST) && (writer.block_num == 3)) ? "ok" : "error");
+    if ((res != 0) || (writer.record_num != OPT300X_BINLOG_TEST_FIRST) || (writer.block_num != 3))
+    {
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check last timestamp %s.\n",
+                                  (writer.last_us == a_opt300x_binlog_test_timestamp(OPT300X_BINLOG_TEST_FIRST - 1)) ? "ok" : "error");
+    if (writer.last_us != a_opt300x_binlog_test_timestamp(OPT300X_BINLOG_TEST_FIRST - 1))
+    {
+        (void)opt300x_binlog_writer_close(&writer);
+        
+        return 1;
+    }
+    for (i = OPT300X_BINLOG_TEST_FIRST; i < OPT300X_BINLOG_TEST_FIRST + OPT300X_BINLOG_TEST_SECOND; i++)
+    {
+        res = opt300x_binlog_append(&writer, (uint8_t)(i % 2), a_opt300x_binlog_test_raw(i), a_opt300x_binlog_test_clock(i));
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: append failed.\n");
+            (void)opt300x_binlog_writer_close(&writer);
+            
+            return 1;
+        }
+    }
+    res = opt300x_binlog_writer_close(&writer);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: close failed.\n");
+        
+        return 1;
+    }
+    res = opt300x_binlog_reader_open(&reader, path);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: open %s failed.\n", path);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check trailer index %s.\n",
+                                  ((reader.owned == NULL) && (reader.block_num == 4) &&
+                                   (reader.record_num == OPT300X_BINLOG_TEST_FIRST + OPT300X_BINLOG_TEST_SECOND)) ? "ok" : "error");
+    if ((reader.owned != NULL) || (reader.block_num != 4) || (reader.record_num != OPT300X_BINLOG_TEST_FIRST + OPT300X_BINLOG_TEST_SECOND))
+    {
+        (void)opt300x_binlog_reader_close(&reader);
+        
+        return 1;
+    }
+    
+    /* opt300x_binlog_reader_get test */
+    opt300x_interface_debug_print("opt300x: opt300x_binlog_reader_get test.\n");
+    res = opt300x_binlog_reader_get(NULL, 0, &sample);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        (void)opt300x_binlog_reader_close(&reader);
+        
+        return 1;
+    }
+    res = opt300x_binlog_reader_get(&reader, 0, NULL);
+    opt300x_interface_debug_print("opt300x: check null sample %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        (void)opt300x_binlog_reader_close(&reader);
+        
+        return 1;
+    }
+    res = opt300x_binlog_reader_get(&reader, OPT300X_BINLOG_TEST_FIRST + OPT300X_BINLOG_TEST_SECOND, &sample);
+    opt300x_interface_debug_print("opt300x: check out of range %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        (void)opt300x_binlog_reader_close(&reader);
+        
+        return 1;
+    }
+    for (i = 0; i < OPT300X_BINLOG_TEST_FIRST + OPT300X_BINLOG_TEST_SECOND; i++)
+    {
+        uint16_t raw = a_opt300x_binlog_test_raw(i);
+        float weight = ((i % 2) != 0) ? 1.2f : 0.01f;
+        float expect = weight * (float)(1UL << (raw >> 12)) * (float)(raw & 0x0FFF);
+        
+        res = opt300x_binlog_reader_get(&reader, i, &sample);
+        if ((res != 0) || (sample.raw != raw) || (sample.sensor != (i % 2)) ||
+            (sample.timestamp_us != a_opt300x_binlog_test_timestamp(i)) || (fabsf(sample.data - expect) > expect * 1e-6f))
+        {
+            opt300x_interface_debug_print("opt300x: check record %u error.\n", (unsigned int)i);
+            (void)opt300x_binlog_reader_close(&reader);
+            
+            return 1;
+        }
+    }
+    opt300x_interface_debug_print("opt300x: check records %s.\n", "ok");
+    
+    /* opt300x_binlog_reader_seek test */
+    opt300x_interface_debug_print("opt300x: opt300x_binlog_reader_seek test.\n");
+    res = opt300x_binlog_reader_seek(NULL, 0, &n);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        (void)opt300x_binlog_reader_close(&reader);
+        
+        return 1;
+    }
+    res = opt300x_binlog_reader_seek(&reader, 0, NULL);
+    opt300x_interface_debug_print("opt300x: check null n %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        (void)opt300x_binlog_reader_close(&reader);
+        
+        return 1;
+    }
+    res = opt300x_binlog_reader_seek(&reader, 0, &n);
+    opt300x_interface_debug_print("opt300x: check before the first record %s.\n", ((res == 0) && (n == 0)) ? "ok" : "error");
+    if ((res != 0) || (n != 0))
+    {
+        (void)opt300x_binlog_reader_close(&reader);
+        
+        return 1;
+    }
+    res = opt300x_binlog_reader_seek(&reader, a_opt300x_binlog_test_timestamp(5), &n);
+    opt300x_interface_debug_print("opt300x: check exact timestamp %s.\n", ((res == 0) && (n == 5)) ? "ok" : "error");
+    if ((res != 0) || (n != 5))
+    {
+        (void)opt300x_binlog_reader_close(&reader);
+        
+        return 1;
+    }
+    res = opt300x_binlog_reader_seek(&reader, a_opt300x_binlog_test_timestamp(7) + 1, &n);
+    opt300x_interface_debug_print("opt300x: check across blocks %s.\n", ((res == 0) && (n == 8)) ? "ok" : "error");
+    if ((res != 0) || (n != 8))
+    {
+        (void)opt300x_binlog_reader_close(&reader);
+        
+        return 1;
+    }
+    res = opt300x_binlog_reader_seek(&reader, a_opt300x_binlog_test_timestamp(OPT300X_BINLOG_TEST_FIRST + OPT300X_BINLOG_TEST_SECOND), &n);
+    opt300x_interface_debug_print("opt300x: check after the last record %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        (void)opt300x_binlog_reader_close(&reader);
+        
+        return 1;
+    }
+    
+    /* opt300x_binlog_reader_scan test */
+    opt300x_interface_debug_print("opt300x: opt300x_binlog_reader_scan test.\n");
+    num = opt300x_binlog_reader_scan(NULL, 0, 1, data, NULL, NULL);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (num == 0) ? "ok" : "error");
+    if (num != 0)
+    {
+        (void)opt300x_binlog_reader_close(&reader);
+        
+        return 1;
+    }
+    num = opt300x_binlog_reader_scan(&reader, OPT300X_BINLOG_TEST_FIRST + OPT300X_BINLOG_TEST_SECOND, 1, data, NULL, NULL);
+    opt300x_interface_debug_print("opt300x: check out of range %s.\n", (num == 0) ? "ok" : "error");
+    if (num != 0)
+    {
+        (void)opt300x_binlog_reader_close(&reader);
+        
+        return 1;
+    }
+    num = opt300x_binlog_reader_scan(&reader, 2, 1000, data, timestamp, sensor_id);
+    opt300x_interface_debug_print("opt300x: check clipped range %s.\n", (num == OPT300X_BINLOG_TEST_FIRST + OPT300X_BINLOG_TEST_SECOND - 2) ? "ok" : "error");
+    if (num != OPT300X_BINLOG_TEST_FIRST + OPT300X_BINLOG_TEST_SECOND - 2)
+    {
+        (void)opt300x_binlog_reader_close(&reader);
+        
+        return 1;
+    }
+    for (i = 0; i < num; i++)
+    {
+        res = opt300x_binlog_reader_get(&reader, i + 2, &sample);
+        if ((res != 0) || (data[i] != sample.data) || (timestamp[i] != sample.timestamp_us) ||
+            (sensor_id[i] != sample.sensor))
+        {
+            opt300x_interface_debug_print("opt300x: check scan %u error.\n", (unsigned int)i);
+            (void)opt300x_binlog_reader_close(&reader);
+            
+            return 1;
+        }
+    }
+    opt300x_interface_debug_print("opt300x: check scan %s.\n", "ok");
+    num = opt300x_binlog_reader_scan(&reader, 3, 2, data, NULL, NULL);
+    opt300x_interface_debug_print("opt300x: check short range %s.\n", (num == 2) ? "ok" : "error");
+    if (num != 2)
+    {
+        (void)opt300x_binlog_reader_close(&reader);
+        
+        return 1;
+    }
+    
+    /* opt300x_binlog_reader_close test */
+    opt300x_interface_debug_print("opt300x: opt300x_binlog_reader_close test.\n");
+    res = opt300x_binlog_reader_close(NULL);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        (void)opt300x_binlog_reader_close(&reader);
+        
+        return 1;
+    }
+    res = opt300x_binlog_reader_close(&reader);
+    opt300x_interface_debug_print("opt300x: check close %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* finish binary log test */
+    opt300x_interface_debug_print("opt300x: finish binary log test.\n");
+    
+    return 0;
+}
+
+/**
+ * @brief  binary log test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   none
+ */
+uint8_t opt300x_binlog_test(void)
+{
+    uint8_t res;
+    
+    res = a_opt300x_binlog_test_run(OPT300X_BINLOG_TEST_PATH);
+    (void)unlink(OPT300X_BINLOG_TEST_PATH);
+    
+    return res;
+}
@@ -0,0 +1,375 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      opt300x_codec_bench.c
+ * @brief     opt300x codec bench source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_opt300x_codec.h"
+#include "opt300x_binlog.h"
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief bench definition
+ */
+#define BENCH_SENSOR        4        /**< synthetic sensor numbers */
+
+/**
+ * @brief bench stream structure definition
+ */
+typedef struct bench_stream_s
+{
+    uint16_t *raw;              /**< raw words */
+    uint32_t num;               /**< raw word numbers */
+} bench_stream_t;
+
+/**
+ * @brief  get the monotonic time
+ * @return time in ns
+ * @note   none
+ */
+static uint64_t a_bench_now_ns(void)
+{
+    struct timespec t;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &t);
+    
+    return (uint64_t)t.tv_sec * 1000000000ULL + (uint64_t)t.tv_nsec;
+}
+
+/**
+ * @brief     get a random number
+ * @param[in] *seed pointer to a seed
+ * @return    random number in [0, 1)
+ * @note      none
+ */
+static double a_bench_random(uint64_t *seed)
+{
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 7;
+    *seed ^= *seed << 17;
+    
+    return (double)(*seed >> 11) / 9007199254740992.0;
+}
+
+/**
+ * @brief     convert lux to a raw word with the auto full-scale range
+ * @param[in] lux lux
+ * @return    raw word
+ * @note      the lsb weight is 0.01 lux
+ */
+static uint16_t a_bench_raw(double lux)
+{
+    uint32_t e;
+    double m;
+    
+    for (e = 0; e < 11; e++)
+    {
+        if (lux / (0.01 * (double)(1UL << e)) < 4095.5)
+        {
+            break;
+        }
+    }
+    m = floor(lux / (0.01 * (double)(1UL << e)) + 0.5);
+    if (m > 4095.0)
+    {
+        m = 4095.0;
+    }
+    
+    return (uint16_t)((e << 12) | (uint32_t)m);
+}
+
+/**
+ * @brief     make a synthetic daylight trace
+ * @param[in] *stream pointer to a stream
+ * @param[in] seed random seed
+ * @note      1s samples, a clear sky curve with slow clouds, an indoor floor and 0.1% noise
+ */
+static void a_bench_synthetic(bench_stream_t *stream, uint64_t seed)
+{
+    uint32_t i;
+    double cloud = 1.0;
+    
+    for (i = 0; i < stream->num; i++)
+    {
+        double hour = (double)(i % 86400) / 3600.0;
+        double sun = sin(3.14159265358979 * (hour - 6.0) / 12.0);
+        double noise = (a_bench_random(&seed) + a_bench_random(&seed) + a_bench_random(&seed) - 1.5) * 0.002;
+        
+        cloud += (a_bench_random(&seed) - 0.5) * 0.01;
+        cloud = (cloud < 0.3) ? 0.3 : ((cloud > 1.0) ? 1.0 : cloud);
+        stream->raw[i] = a_bench_raw(((sun > 0.0) ? 60000.0 * sun * cloud : 0.0) * (1.0 + noise) + 2.0 + noise * 10.0);
+    }
+}
+
+/**
+ * @brief     load the streams of a binary log
+ * @param[in] *path pointer to a file path
+ * @param[in] *stream pointer to a stream array
+ * @param[in] *num pointer to a stream numbers buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 load failed
+ * @note      one stream per sensor id
+ */
+static uint8_t a_bench_load(const char *path, bench_stream_t *stream, uint32_t *num)
+{
+    uint64_t n;
+    opt300x_binlog_reader_t reader;
+    
+    memset(&reader, 0, sizeof(reader));
+    if (opt300x_binlog_reader_open(&reader, path) != 0)
+    {
+        return 1;
+    }
+    *num = reader.sensor_num;
+    for (n = 0; n < *num; n++)
+    {
+        stream[n].raw = (uint16_t *)malloc((size_t)reader.record_num * sizeof(uint16_t) + 2);
+        stream[n].num = 0;
+        if (stream[n].raw == NULL)
+        {
+            (void)opt300x_binlog_reader_close(&reader);
+            
+            return 1;
+        }
+    }
+    for (n = 0; n < reader.record_num; n++)
+    {
+        opt300x_binlog_sample_t s;
+        
+        (void)opt300x_binlog_reader_get(&reader, n, &s);
+        if (s.sensor < *num)
+        {
+            stream[s.sensor].raw[stream[s.sensor].num++] = s.raw;
+        }
+    }
+    (void)opt300x_binlog_reader_close(&reader);
+    
+    return 0;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    uint32_t i;
+    uint32_t k;
+    uint32_t streams = BENCH_SENSOR;
+    uint32_t samples = 2000000;
+    uint32_t block = OPT300X_CODEC_MAX_BLOCK;
+    uint32_t passes = 5;
+    uint32_t errors = 0;
+    opt300x_codec_mode_t mode = OPT300X_CODEC_MODE_AUTO;
+    const char *trace = NULL;
+    static bench_stream_t stream[OPT300X_BINLOG_MAX_SENSOR];
+    static opt300x_codec_encoder_t encoder;
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"trace", required_argument, NULL, 1},
+        {"samples", required_argument, NULL, 2},
+        {"block", required_argument, NULL, 3},
+        {"mode", required_argument, NULL, 4},
+        {"passes", required_argument, NULL, 5},
+        {NULL, 0, NULL, 0},
+    };
+    
+    /* parse */
+    do
+    {
+        c = getopt_long(argc, argv, "h", long_options, &longindex);
+        switch (c)
+        {
+            case 1 :
+            {
+                trace = optarg;
+                
+                break;
+            }
+            case 2 :
+            {
+                samples = (uint32_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            case 3 :
+            {
+                block = (uint32_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            case 4 :
+            {
+                mode = (strcmp(optarg, "varint") == 0) ? OPT300X_CODEC_MODE_VARINT : OPT300X_CODEC_MODE_AUTO;
+                
+                break;
+            }
+            case 5 :
+            {
+                passes = (uint32_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            case -1 :
+            {
+                break;
+            }
+            default :
+            {
+                printf("Usage:\n");
+                printf("  opt300x_codec_bench [--trace=<binlog path>] [--samples=<num>] [--block=<num>]");
+                printf(" [--mode=<auto | varint>] [--passes=<num>]\n");
+                
+                return (c == 'h') ? 0 : 1;
+            }
+        }
+    } while (c != -1);
+    if ((block == 0) || (block > OPT300X_CODEC_MAX_BLOCK) || (samples == 0) || (passes == 0))
+    {
+        printf("opt300x_codec_bench: block must be 1 - %d, samples and passes must not be 0.\n", OPT300X_CODEC_MAX_BLOCK);
+        
+        return 1;
+    }
+    
+    /* load the traces */
+    if (trace != NULL)
+    {
+        if (a_bench_load(trace, stream, &streams) != 0)
+        {
+            printf("opt300x_codec_bench: load %s failed.\n", trace);
+            
+            return 1;
+        }
+    }
+    else
+    {
+        for (i = 0; i < streams; i++)
+        {
+            stream[i].num = samples;
+            stream[i].raw = (uint16_t *)malloc((size_t)samples * sizeof(uint16_t));
+            if (stream[i].raw == NULL)
+            {
+                printf("opt300x_codec_bench: malloc failed.\n");
+                
+                return 1;
+            }
+            a_bench_synthetic(&stream[i], 0x9E3779B97F4A7C15ULL * (i + 1));
+        }
+    }
+    printf("opt300x_codec_bench: %s, %s mode, %u samples per block.\n", (trace != NULL) ? trace : "synthetic daylight",
+           (mode == OPT300X_CODEC_MODE_AUTO) ? "auto" : "varint", (unsigned)block);
+    
+    /* every stream */
+    for (i = 0; i < streams; i++)
+    {
+        uint8_t *enc;
+        uint16_t *dec;
+        uint32_t len = 0;
+        uint32_t num = 0;
+        uint64_t best_enc = 0;
+        uint64_t best_dec = 0;
+        
+        if (stream[i].num == 0)
+        {
+            continue;
+        }
+        enc = (uint8_t *)malloc((size_t)(stream[i].num / block + 1) * OPT300X_CODEC_BOUND(block));
+        dec = (uint16_t *)malloc((size_t)stream[i].num * sizeof(uint16_t));
+        if ((enc == NULL) || (dec == NULL))
+        {
+            printf("opt300x_codec_bench: malloc failed.\n");
+            free(enc);
+            free(dec);
+            
+            return 1;
+        }
+        for (k = 0; k < passes; k++)
+        {
+            uint32_t j;
+            uint32_t l;
+            uint64_t t;
+            
+            /* encode sample by sample as on the mcu */
+            (void)opt300x_codec_encoder_init(&encoder, mode, (uint16_t)block);
+            len = 0;
+            t = a_bench_now_ns();
+            for (j = 0; j < stream[i].num; j++)
+            {
+                (void)opt300x_codec_encode(&encoder, stream[i].raw[j], enc + len, OPT300X_CODEC_BOUND(block), &l);
+                len += l;
+            }
+            (void)opt300x_codec_encoder_flush(&encoder, enc + len, OPT300X_CODEC_BOUND(block), &l);
+            len += l;
+            t = a_bench_now_ns() - t;
+            best_enc = ((best_enc == 0) || (t < best_enc)) ? t : best_enc;
+            
+            /* decode the whole stream */
+            t = a_bench_now_ns();
+            if (opt300x_codec_decode(enc, len, dec, stream[i].num, &num) != 0)
+            {
+                num = 0;
+            }
+            t = a_bench_now_ns() - t;
+            best_dec = ((best_dec == 0) || (t < best_dec)) ? t : best_dec;
+        }
+        if ((num != stream[i].num) || (memcmp(dec, stream[i].raw, (size_t)num * sizeof(uint16_t)) != 0))
+        {
+            errors++;
+        }
+        printf("opt300x_codec_bench: sensor %u %u samples, %.3f bytes/sample, ratio %.2f, encode %.1f MB/s, decode %.1f MB/s, %s.\n",
+               (unsigned)i, (unsigned)stream[i].num, (double)len / (double)stream[i].num,
+               (double)stream[i].num * 2.0 / (double)len,
+               (double)stream[i].num * 2.0 / ((double)best_enc / 1e3),
+               (double)stream[i].num * 2.0 / ((double)best_dec / 1e3),
+               ((num == stream[i].num) && (memcmp(dec, stream[i].raw, (size_t)num * sizeof(uint16_t)) == 0)) ? "lossless" : "MISMATCH");
+        free(enc);
+        free(dec);
+        free(stream[i].raw);
+    }
+    
+    return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,231 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      opt300xd_protocol.h
+ * @brief     opt300xd protocol header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef OPT300XD_PROTOCOL_H
+#define OPT300XD_PROTOCOL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup opt300xd_protocol opt300xd protocol function
+ * @brief    opt300xd protocol modules
+ * @{
+ */
+
+/**
+ * @brief opt300xd protocol definition
+ * @note  every frame is a 4 bytes header (type, version, little endian payload length)
+ *        followed by the payload, all multi byte fields are little endian
+ */
+#define OPT300XD_PROTOCOL_VERSION           1                             /**< protocol version */
+#define OPT300XD_PROTOCOL_HEADER_SIZE       4                             /**< frame header size */
+#define OPT300XD_PROTOCOL_MAX_SENSOR        4                             /**< max sensors, one per address pin */
+#define OPT300XD_PROTOCOL_MAX_BATCH         64                            /**< max samples of one batch */
+#define OPT300XD_PROTOCOL_SUBSCRIBE_SIZE    8                             /**< subscribe payload size */
+#define OPT300XD_PROTOCOL_ACK_SIZE          4                             /**< ack payload size without sensors */
+#define OPT300XD_PROTOCOL_ACK_SENSOR_SIZE   12                            /**< ack size of one sensor */
+#define OPT300XD_PROTOCOL_BATCH_SIZE        16                            /**< batch payload size without samples */
+#define OPT300XD_PROTOCOL_SAMPLE_SIZE       8                             /**< batch size of one sample */
+#define OPT300XD_PROTOCOL_MAX_FRAME         532                           /**< max frame size, a full batch */
+#define OPT300XD_PROTOCOL_DEFAULT_SOCKET    "/run/opt300xd.sock"          /**< default socket path */
+
+/**
+ * @brief opt300xd message type enumeration definition
+ */
+typedef enum
+{
+    OPT300XD_MESSAGE_SUBSCRIBE   = 0x01,        /**< client subscribes sensors at an interval */
+    OPT300XD_MESSAGE_UNSUBSCRIBE = 0x02,        /**< client unsubscribes sensors */
+    OPT300XD_MESSAGE_ACK         = 0x81,        /**< daemon reports the granted subscription */
+    OPT300XD_MESSAGE_BATCH       = 0x82,        /**< daemon sends a batch of samples */
+} opt300xd_message_t;
+
+/**
+ * @brief opt300xd subscribe structure definition
+ */
+typedef struct opt300xd_subscribe_s
+{
+    uint8_t mask;                /**< sensor bit mask */
+    uint8_t batch;               /**< samples per batch, 1 - OPT300XD_PROTOCOL_MAX_BATCH */
+    uint32_t interval_ms;        /**< requested interval, 0 means the sampling interval */
+} opt300xd_subscribe_t;
+
+/**
+ * @brief opt300xd sensor structure definition
+ */
+typedef struct opt300xd_sensor_s
+{
+    uint8_t index;                    /**< sensor index, the bit in the mask */
+    uint8_t type;                     /**< chip type, opt300x_t */
+    uint8_t addr;                     /**< address pin, opt300x_address_t */
+    uint8_t subscribed;               /**< subscribed flag */
+    uint32_t sample_ms;               /**< sampling interval of the daemon */
+    uint32_t interval_ms;             /**< granted interval, a multiple of sample_ms */
+} opt300xd_sensor_t;
+
+/**
+ * @brief opt300xd ack structure definition
+ */
+typedef struct opt300xd_ack_s
+{
+    uint8_t status;                                               /**< 0 accepted, 1 some sensors are unknown */
+    uint8_t batch;                                                /**< granted batch */
+    uint8_t num;                                                  /**< sensor numbers */
+    opt300xd_sensor_t sensor[OPT300XD_PROTOCOL_MAX_SENSOR];       /**< sensors */
+} opt300xd_ack_t;
+
+/**
+ * @brief opt300xd sample structure definition
+ */
+typedef struct opt300xd_sample_s
+{
+    uint8_t sensor;             /**< sensor index */
+    uint8_t status;             /**< read status, the driver return code, 4 is an overflow at full scale */
+    uint16_t raw;               /**< raw data */
+    uint32_t offset_us;         /**< timestamp offset from the batch base */
+} opt300xd_sample_t;
+
+/**
+ * @brief opt300xd batch structure definition
+ */
+typedef struct opt300xd_batch_s
+{
+    uint64_t timestamp_us;                                        /**< base timestamp */
+    uint32_t dropped;                                             /**< samples dropped since the last batch */
+    uint8_t num;                                                  /**< sample numbers */
+    opt300xd_sample_t sample[OPT300XD_PROTOCOL_MAX_BATCH];        /**< samples */
+} opt300xd_batch_t;
+
+/**
+ * @brief      parse a frame header
+ * @param[in]  *buf pointer to a frame buffer
+ * @param[in]  len length of the buffer
+ * @param[out] *type pointer to a message type buffer
+ * @param[out] *payload pointer to a payload length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 header is incomplete
+ *             - 4 version is invalid
+ * @note       the whole frame is OPT300XD_PROTOCOL_HEADER_SIZE + payload bytes
+ */
+uint8_t opt300xd_protocol_parse_header(const uint8_t *buf, uint16_t len, uint8_t *type, uint16_t *payload);
+
+/**
+ * @brief     pack a subscribe or unsubscribe frame
+ * @param[in] type OPT300XD_MESSAGE_SUBSCRIBE or OPT300XD_MESSAGE_UNSUBSCRIBE
+ * @param[in] *subscribe pointer to a subscribe structure
+ * @param[in] *buf pointer to a frame buffer
+ * @return    frame length
+ * @note      unsubscribe uses the mask only
+ */
+uint16_t opt300xd_protocol_pack_subscribe(uint8_t type, const opt300xd_subscribe_t *subscribe, uint8_t *buf);
+
+/**
+ * @brief      unpack a subscribe payload
+ * @param[in]  *buf pointer to a payload buffer
+ * @param[in]  len payload length
+ * @param[out] *subscribe pointer to a subscribe structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 payload is invalid
+ * @note       none
+ */
+uint8_t opt300xd_protocol_unpack_subscribe(const uint8_t *buf, uint16_t len, opt300xd_subscribe_t *subscribe);
+
+/**
+ * @brief     pack an ack frame
+ * @param[in] *ack pointer to an ack structure
+ * @param[in] *buf pointer to a frame buffer
+ * @return    frame length
+ * @note      none
+ */
+uint16_t opt300xd_protocol_pack_ack(const opt300xd_ack_t *ack, uint8_t *buf);
+
+/**
+ * @brief      unpack an ack payload
+ * @param[in]  *buf pointer to a payload buffer
+ * @param[in]  len payload length
+ * @param[out] *ack pointer to an ack structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 payload is invalid
+ * @note       none
+ */
+uint8_t opt300xd_protocol_unpack_ack(const uint8_t *buf, uint16_t len, opt300xd_ack_t *ack);
+
+/**
+ * @brief     pack a batch frame
+ * @param[in] *batch pointer to a batch structure
+ * @param[in] *buf pointer to a frame buffer
+ * @return    frame length
+ * @note      buf must hold OPT300XD_PROTOCOL_MAX_FRAME bytes
+ */
+uint16_t opt300xd_protocol_pack_batch(const opt300xd_batch_t *batch, uint8_t *buf);
+
+/**
+ * @brief      unpack a batch payload
+ * @param[in]  *buf pointer to a payload buffer
+ * @param[in]  len payload length
+ * @param[out] *batch pointer to a batch structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 payload is invalid
+ * @note       none
+ */
+uint8_t opt300xd_protocol_unpack_batch(const uint8_t *buf, uint16_t len, opt300xd_batch_t *batch);
+
+/**
+ * @brief     convert a raw sample to lux or nW/cm2
+ * @param[in] type chip type, opt300x_t
+ * @param[in] raw raw data
+ * @return    converted data
+ * @note      OPT3002 is in nW/cm2 and the others are in lux
+ */
+float opt300xd_protocol_convert(uint8_t type, uint16_t raw);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,207 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      opt300xd_shm.h
+ * @brief     opt300xd shared memory header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef OPT300XD_SHM_H
+#define OPT300XD_SHM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup opt300xd_shm opt300xd shared memory function
+ * @brief    opt300xd shared memory modules
+ * @{
+ */
+
+/**
+ * @brief opt300xd shared memory definition
+ * @note  the file is a 64 bytes header, 4 sensor blocks of 64 bytes and then one ring of
+ *        depth slots per sensor, each slot is guarded by its own sequence counter
+ */
+#define OPT300XD_SHM_MAGIC              0x44333058U                 /**< "X03D" */
+#define OPT300XD_SHM_VERSION            1                           /**< layout version */
+#define OPT300XD_SHM_MAX_SENSOR         4                           /**< max sensors */
+#define OPT300XD_SHM_DEFAULT_DEPTH      256                         /**< default ring depth */
+#define OPT300XD_SHM_DEFAULT_PATH       "/dev/shm/opt300xd"         /**< default file path */
+
+/**
+ * @brief opt300xd shared memory handle structure definition
+ */
+typedef struct opt300xd_shm_s
+{
+    uint8_t *base;             /**< mapped address */
+    size_t size;               /**< mapped size */
+    int fd;                    /**< file handle */
+    uint8_t writer;            /**< writer flag */
+    uint32_t depth;            /**< ring depth */
+    uint8_t sensor_num;        /**< sensor numbers */
+    uint64_t retry;            /**< reader retries caused by concurrent writes */
+} opt300xd_shm_t;
+
+/**
+ * @brief opt300xd shared memory sample structure definition
+ */
+typedef struct opt300xd_shm_sample_s
+{
+    uint64_t index;               /**< sample index, counts from 0 per sensor */
+    uint64_t timestamp_us;        /**< sample timestamp */
+    float data;                   /**< converted data */
+    uint16_t raw;                 /**< raw data */
+    uint8_t status;               /**< read status, the driver return code, 4 is an overflow at full scale */
+} opt300xd_shm_sample_t;
+
+/**
+ * @brief opt300xd shared memory sensor info structure definition
+ */
+typedef struct opt300xd_shm_info_s
+{
+    uint8_t type;                 /**< chip type, opt300x_t */
+    uint8_t addr;                 /**< address pin, opt300x_address_t */
+    uint32_t sample_ms;           /**< sampling interval */
+} opt300xd_shm_info_t;
+
+/**
+ * @brief     create the shared memory as the writer
+ * @param[in] *shm pointer to a shared memory handle
+ * @param[in] *path pointer to a file path
+ * @param[in] *info pointer to a sensor info buffer
+ * @param[in] num sensor numbers
+ * @param[in] depth ring depth, a power of 2
+ * @return    status code
+ *            - 0 success
+ *            - 1 create failed
+ *            - 2 handle is NULL
+ *            - 4 param is invalid
+ * @note      the file is created or replaced, there must be only one writer
+ */
+uint8_t opt300xd_shm_create(opt300xd_shm_t *shm, const char *path, const opt300xd_shm_info_t *info, uint8_t num, uint32_t depth);
+
+/**
+ * @brief     publish one sample
+ * @param[in] *shm pointer to a shared memory handle
+ * @param[in] sensor sensor index
+ * @param[in] *sample pointer to a sample, the index is assigned by the writer
+ * @return    status code
+ *            - 0 success
+ *            - 1 publish failed
+ *            - 2 handle is NULL
+ *            - 4 sensor is invalid
+ * @note      wait free, never blocks on the readers
+ */
+uint8_t opt300xd_shm_publish(opt300xd_shm_t *shm, uint8_t sensor, const opt300xd_shm_sample_t *sample);
+
+/**
+ * @brief     open the shared memory as a reader
+ * @param[in] *shm pointer to a shared memory handle
+ * @param[in] *path pointer to a file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 2 handle is NULL
+ *            - 4 layout is invalid
+ * @note      the mapping is read only
+ */
+uint8_t opt300xd_shm_open(opt300xd_shm_t *shm, const char *path);
+
+/**
+ * @brief     close the shared memory
+ * @param[in] *shm pointer to a shared memory handle
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ *            - 2 handle is NULL
+ * @note      the writer leaves the file for the readers
+ */
+uint8_t opt300xd_shm_close(opt300xd_shm_t *shm);
+
+/**
+ * @brief      get the sensor info
+ * @param[in]  *shm pointer to a shared memory handle
+ * @param[in]  sensor sensor index
+ * @param[out] *info pointer to a sensor info buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 sensor is invalid
+ * @note       none
+ */
+uint8_t opt300xd_shm_get_info(opt300xd_shm_t *shm, uint8_t sensor, opt300xd_shm_info_t *info);
+
+/**
+ * @brief      read the latest sample
+ * @param[in]  *shm pointer to a shared memory handle
+ * @param[in]  sensor sensor index
+ * @param[out] *sample pointer to a sample buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 4 sensor is invalid
+ *             - 5 no sample is published
+ * @note       lock free, retries while the writer updates the slot
+ */
+uint8_t opt300xd_shm_read_latest(opt300xd_shm_t *shm, uint8_t sensor, opt300xd_shm_sample_t *sample);
+
+/**
+ * @brief         read the samples published after a cursor
+ * @param[in]     *shm pointer to a shared memory handle
+ * @param[in]     sensor sensor index
+ * @param[in,out] *cursor pointer to the next sample index, updated after reading
+ * @param[out]    *sample pointer to a sample buffer
+ * @param[in,out] *len pointer to a sample buffer length, returns the read samples
+ * @param[out]    *lost pointer to a lost samples buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ *                - 4 sensor is invalid
+ * @note          samples overwritten before they are read are counted in lost
+ */
+uint8_t opt300xd_shm_read_recent(opt300xd_shm_t *shm, uint8_t sensor, uint64_t *cursor,
+                                 opt300xd_shm_sample_t *sample, uint32_t *len, uint64_t *lost);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,372 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      opt300xc.c
+ * @brief     opt300xd client source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "opt300xd_protocol.h"
+#include "opt300xd_shm.h"
+#include <errno.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * @brief      read one whole frame
+ * @param[in]  fd socket
+ * @param[out] *buf pointer to a frame buffer
+ * @param[out] *type pointer to a message type buffer
+ * @param[out] *payload pointer to a payload length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       buf must hold OPT300XD_PROTOCOL_MAX_FRAME bytes
+ */
+static uint8_t a_client_read_frame(int fd, uint8_t *buf, uint8_t *type, uint16_t *payload)
+{
+    size_t len = 0;
+    size_t need = OPT300XD_PROTOCOL_HEADER_SIZE;
+    ssize_t n;
+    
+    while (len < need)
+    {
+        n = read(fd, &buf[len], need - len);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            
+            return 1;
+        }
+        if (n == 0)
+        {
+            return 1;
+        }
+        len += (size_t)n;
+        if (len == OPT300XD_PROTOCOL_HEADER_SIZE)
+        {
+            if (opt300xd_protocol_parse_header(buf, (uint16_t)len, type, payload) != 0)
+            {
+                return 1;
+            }
+            if (*payload > OPT300XD_PROTOCOL_MAX_FRAME - OPT300XD_PROTOCOL_HEADER_SIZE)
+            {
+                return 1;
+            }
+            need += *payload;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     write one whole frame
+ * @param[in] fd socket
+ * @param[in] *buf pointer to a frame buffer
+ * @param[in] len frame length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_client_write_frame(int fd, const uint8_t *buf, uint16_t len)
+{
+    ssize_t n;
+    uint16_t off = 0;
+    
+    while (off < len)
+    {
+        n = write(fd, &buf[off], len - off);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            
+            return 1;
+        }
+        off = (uint16_t)(off + n);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     read the samples from the shared memory
+ * @param[in] *path pointer to a file path
+ * @param[in] times batch times
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ * @note      polls every sensor for the samples published after the last poll
+ */
+static uint8_t a_client_shm(const char *path, uint32_t times)
+{
+    uint8_t i;
+    uint32_t j;
+    uint32_t len;
+    uint64_t lost;
+    uint64_t cursor[OPT300XD_SHM_MAX_SENSOR] = {0};
+    opt300xd_shm_t shm;
+    opt300xd_shm_info_t info;
+    opt300xd_shm_sample_t sample[16];
+    
+    if (opt300xd_shm_open(&shm, path) != 0)
+    {
+        printf("opt300xc: open %s failed.\n", path);
+        
+        return 1;
+    }
+    for (i = 0; i < shm.sensor_num; i++)
+    {
+        (void)opt300xd_shm_get_info(&shm, i, &info);
+        printf("opt300xc: sensor %d type 0x%02X addr 0x%02X sample %dms.\n", i, info.type, info.addr, (int)info.sample_ms);
+    }
+    while (times != 0)
+    {
+        for (i = 0; i < shm.sensor_num; i++)
+        {
+            len = 16;
+            (void)opt300xd_shm_read_recent(&shm, i, &cursor[i], sample, &len, &lost);
+            if (lost != 0)
+            {
+                printf("opt300xc: %d samples lost.\n", (int)lost);
+            }
+            for (j = 0; j < len; j++)
+            {
+                printf("opt300xc: sensor %d at %lluus status %d data %0.2f.\n", i,
+                       (unsigned long long)sample[j].timestamp_us, sample[j].status, sample[j].data);
+            }
+        }
+        (void)usleep(1000 * 1000);
+        times--;
+    }
+    (void)opt300xd_shm_close(&shm);
+    
+    return 0;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int fd;
+    int longindex = 0;
+    uint8_t i;
+    uint8_t type;
+    uint16_t len;
+    uint16_t payload;
+    uint32_t times = 3;
+    uint8_t sensor_type[OPT300XD_PROTOCOL_MAX_SENSOR] = {0};
+    static uint8_t buf[OPT300XD_PROTOCOL_MAX_FRAME];
+    static opt300xd_batch_t batch;
+    opt300xd_ack_t ack;
+    opt300xd_subscribe_t subscribe = {0x0F, 1, 0};
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"mask", required_argument, NULL, 1},
+        {"interval", required_argument, NULL, 2},
+        {"batch", required_argument, NULL, 3},
+        {"times", required_argument, NULL, 4},
+        {"socket", required_argument, NULL, 5},
+        {"shm", optional_argument, NULL, 6},
+        {NULL, 0, NULL, 0},
+    };
+    const char *path = OPT300XD_PROTOCOL_DEFAULT_SOCKET;
+    const char *shm_path = NULL;
+    struct sockaddr_un addr;
+    
+    /* parse */
+    do
+    {
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        switch (c)
+        {
+            case 1 :
+            {
+                subscribe.mask = (uint8_t)strtoul(optarg, NULL, 0);
+                
+                break;
+            }
+            case 2 :
+            {
+                subscribe.interval_ms = (uint32_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            case 3 :
+            {
+                subscribe.batch = (uint8_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            case 4 :
+            {
+                times = (uint32_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            case 5 :
+            {
+                path = optarg;
+                
+                break;
+            }
+            case 6 :
+            {
+                shm_path = (optarg != NULL) ? optarg : OPT300XD_SHM_DEFAULT_PATH;
+                
+                break;
+            }
+            case -1 :
+            {
+                break;
+            }
+            default :
+            {
+                printf("Usage:\n");
+                printf("  opt300xc [--socket=<path>] [--mask=<mask>] [--interval=<ms>] [--batch=<num>] [--times=<num>]\n");
+                printf("  opt300xc --shm[=<path>] [--times=<num>]\n");
+                
+                return (c == 'h') ? 0 : 1;
+            }
+        }
+    } while (c != -1);
+    
+    /* read the shared memory without the socket */
+    if (shm_path != NULL)
+    {
+        return a_client_shm(shm_path, times);
+    }
+    
+    /* connect */
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        printf("opt300xc: socket failed.\n");
+        
+        return 1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+    {
+        printf("opt300xc: connect %s failed.\n", path);
+        (void)close(fd);
+        
+        return 1;
+    }
+    
+    /* subscribe */
+    len = opt300xd_protocol_pack_subscribe(OPT300XD_MESSAGE_SUBSCRIBE, &subscribe, buf);
+    if (a_client_write_frame(fd, buf, len) != 0)
+    {
+        printf("opt300xc: subscribe failed.\n");
+        (void)close(fd);
+        
+        return 1;
+    }
+    
+    /* read the ack and the batches */
+    while (times != 0)
+    {
+        if (a_client_read_frame(fd, buf, &type, &payload) != 0)
+        {
+            printf("opt300xc: read failed.\n");
+            (void)close(fd);
+            
+            return 1;
+        }
+        if (type == OPT300XD_MESSAGE_ACK)
+        {
+            if (opt300xd_protocol_unpack_ack(&buf[OPT300XD_PROTOCOL_HEADER_SIZE], payload, &ack) != 0)
+            {
+                continue;
+            }
+            printf("opt300xc: ack status %d batch %d.\n", ack.status, ack.batch);
+            for (i = 0; i < ack.num; i++)
+            {
+                sensor_type[ack.sensor[i].index % OPT300XD_PROTOCOL_MAX_SENSOR] = ack.sensor[i].type;
+                printf("opt300xc: sensor %d type 0x%02X addr 0x%02X subscribed %d sample %dms interval %dms.\n",
+                       ack.sensor[i].index, ack.sensor[i].type, ack.sensor[i].addr, ack.sensor[i].subscribed,
+                       (int)ack.sensor[i].sample_ms, (int)ack.sensor[i].interval_ms);
+            }
+        }
+        else if (type == OPT300XD_MESSAGE_BATCH)
+        {
+            if (opt300xd_protocol_unpack_batch(&buf[OPT300XD_PROTOCOL_HEADER_SIZE], payload, &batch) != 0)
+            {
+                continue;
+            }
+            if (batch.dropped != 0)
+            {
+                printf("opt300xc: %d samples dropped.\n", (int)batch.dropped);
+            }
+            for (i = 0; i < batch.num; i++)
+            {
+                opt300xd_sample_t *s = &batch.sample[i];
+                
+                printf("opt300xc: sensor %d at %lluus status %d data %0.2f.\n", s->sensor,
+                       (unsigned long long)(batch.timestamp_us + s->offset_us), s->status,
+                       opt300xd_protocol_convert(sensor_type[s->sensor % OPT300XD_PROTOCOL_MAX_SENSOR], s->raw));
+            }
+            times--;
+        }
+        else
+        {
+            /* ignore the unknown messages */
+        }
+    }
+    (void)close(fd);
+    
+    return 0;
+}
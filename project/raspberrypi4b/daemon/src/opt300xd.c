@@ -0,0 +1,1489 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      opt300xd.c
+ * @brief     opt300xd source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_opt300x_interface.h"
+#include "driver_opt300x_dli.h"
+#include "opt300xd_protocol.h"
+#include "opt300xd_shm.h"
+#include "opt300x_binlog.h"
+#include "opt300x_rrd.h"
+#include "iic.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief daemon definition
+ */
+#define DAEMON_MAX_CLIENT          16                                      /**< max clients */
+#define DAEMON_QUEUE_SIZE          256                                     /**< sample queue size of one client, power of 2 */
+#define DAEMON_QUEUE_MASK          (DAEMON_QUEUE_SIZE - 1)                 /**< sample queue mask */
+#define DAEMON_RX_SIZE             64                                      /**< receive buffer size of one client */
+#define DAEMON_TX_SIZE             1024                                    /**< transmit buffer size of one client */
+#define DAEMON_ACK_MAX             56                                      /**< max ack frame size */
+#define DAEMON_MIN_INTERVAL_MS     100                                     /**< min sampling interval, the short conversion time */
+#define DAEMON_LONG_INTERVAL_MS    800                                     /**< sampling interval using the long conversion time */
+#define DAEMON_DLI_MAX_GAP_US      60000000ULL                             /**< longest interval integrated into the dli */
+#define DAEMON_DLI_SAVE_US         60000000ULL                             /**< dli checkpoint period */
+#define DAEMON_FULL_SCALE          0xBFFF                                  /**< overflow raw, exponent 11, mantissa 4095 */
+#define DAEMON_MAX_BUS             4                                       /**< max iic buses */
+#define DAEMON_BUS_NAME_SIZE       32                                      /**< max iic device name size */
+#define DAEMON_DEFAULT_BUS         "/dev/i2c-1"                            /**< default iic device name */
+
+/**
+ * @brief daemon sample structure definition
+ */
+typedef struct daemon_entry_s
+{
+    uint64_t timestamp_us;        /**< sample timestamp */
+    uint16_t raw;                 /**< raw data */
+    uint8_t sensor;               /**< sensor index */
+    uint8_t status;               /**< read status */
+} daemon_entry_t;
+
+/**
+ * @brief daemon sensor structure definition
+ */
+typedef struct daemon_sensor_s
+{
+    opt300x_handle_t handle;           /**< driver handle */
+    opt300x_t type;                    /**< chip type */
+    opt300x_address_t addr;            /**< address pin */
+    uint32_t sample_ms;                /**< sampling interval */
+    uint64_t next_us;                  /**< next sampling time */
+    uint8_t bus;                       /**< iic bus index */
+    uint8_t failed;                    /**< last read failed flag */
+} daemon_sensor_t;
+
+/**
+ * @brief daemon bus structure definition
+ */
+typedef struct daemon_bus_s
+{
+    char name[DAEMON_BUS_NAME_SIZE];        /**< iic device name */
+    int fd;                                 /**< iic handle */
+    uint32_t ref;                           /**< iic reference counter */
+} daemon_bus_t;
+
+/**
+ * @brief daemon bus hook structure definition
+ */
+typedef struct daemon_bus_hook_s
+{
+    uint8_t (*iic_init)(void);                                                      /**< iic init of the bus */
+    uint8_t (*iic_deinit)(void);                                                    /**< iic deinit of the bus */
+    uint8_t (*iic_read)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);     /**< iic read of the bus */
+    uint8_t (*iic_write)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);    /**< iic write of the bus */
+    uint8_t (*iic_read_cmd)(uint8_t addr, uint8_t *buf, uint16_t len);              /**< iic read command of the bus */
+    uint8_t (*iic_write_cmd)(uint8_t addr, uint8_t *buf, uint16_t len);             /**< iic write command of the bus */
+} daemon_bus_hook_t;
+
+/**
+ * @brief daemon client structure definition
+ */
+typedef struct daemon_client_s
+{
+    int fd;                                                      /**< socket, -1 means the slot is free */
+    uint8_t mask;                                                /**< subscribed sensors */
+    uint8_t batch;                                               /**< samples per batch */
+    uint32_t decimation[OPT300XD_PROTOCOL_MAX_SENSOR];           /**< decimation of each sensor */
+    uint32_t phase[OPT300XD_PROTOCOL_MAX_SENSOR];                /**< decimation phase of each sensor */
+    daemon_entry_t queue[DAEMON_QUEUE_SIZE];                     /**< sample queue */
+    uint32_t head;                                               /**< queue write position */
+    uint32_t tail;                                               /**< queue read position */
+    uint32_t dropped;                                            /**< samples dropped since the last batch */
+    uint16_t rx_len;                                             /**< received bytes */
+    uint16_t tx_len;                                             /**< bytes to transmit */
+    uint16_t tx_off;                                             /**< transmitted bytes */
+    uint8_t rx[DAEMON_RX_SIZE];                                  /**< receive buffer */
+    uint8_t tx[DAEMON_TX_SIZE];                                  /**< transmit buffer */
+} daemon_client_t;
+
+/**
+ * @brief daemon var definition
+ */
+static daemon_sensor_t gs_sensor[OPT300XD_PROTOCOL_MAX_SENSOR];        /**< sensors */
+static uint8_t gs_sensor_num;                                          /**< sensor numbers */
+static daemon_bus_t gs_bus[DAEMON_MAX_BUS];                            /**< iic buses */
+static uint8_t gs_bus_num;                                             /**< iic bus numbers */
+static daemon_client_t gs_client[DAEMON_MAX_CLIENT];                   /**< clients */
+static volatile sig_atomic_t gs_stop;                                  /**< stop flag */
+static opt300xd_shm_t gs_shm;                                          /**< shared memory */
+static uint8_t gs_shm_enable;                                          /**< shared memory enable */
+static opt300x_binlog_writer_t gs_binlog;                              /**< binary log */
+static uint8_t gs_binlog_enable;                                       /**< binary log enable */
+static opt300x_rrd_t gs_rrd;                                           /**< round robin database */
+static uint8_t gs_rrd_enable;                                          /**< round robin database enable */
+static opt300x_dli_t gs_dli;                                           /**< daily light integral */
+static uint8_t gs_dli_enable;                                          /**< daily light integral enable */
+static const char *gs_dli_path;                                        /**< daily light integral checkpoint path */
+static uint64_t gs_dli_saved_us;                                       /**< last checkpoint time */
+static uint64_t gs_wall_us;                                            /**< last wall clock time */
+
+/**
+ * @brief     signal handler
+ * @param[in] sig signal number
+ * @note      none
+ */
+static void a_daemon_signal(int sig)
+{
+    (void)sig;
+    gs_stop = 1;
+}
+
+/**
+ * @brief  get the wall clock time
+ * @return time in us since the epoch
+ * @note   the stored history must survive reboots, which reset the monotonic clock,
+ *         a step back of the wall clock is clamped to the last time, so the history stays ordered
+ */
+static uint64_t a_daemon_wall_us(void)
+{
+    uint64_t us;
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_REALTIME, &ts);
+    us = (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+    if (us < gs_wall_us)
+    {
+        us = gs_wall_us;
+    }
+    gs_wall_us = us;
+    
+    return us;
+}
+
+/**
+ * @brief     report a closed day
+ * @param[in] *dli pointer to a dli structure
+ * @param[in] sensor sensor index
+ * @note      none
+ */
+static void a_daemon_dli_close(opt300x_dli_t *dli, uint8_t sensor)
+{
+    const opt300x_dli_result_t *result = &dli->result[sensor];
+    
+    opt300x_interface_debug_print("opt300xd: sensor %d day %u dli %.3f mol/m2, %u samples over %.1f h, %.1f h at full scale.\n",
+                                  sensor, (unsigned int)result->day, result->dli, (unsigned int)result->samples,
+                                  (double)result->covered_us / 3.6e9, (double)result->overflow_us / 3.6e9);
+}
+
+/**
+ * @brief  write the dli checkpoint
+ * @return status code
+ *         - 0 success
+ *         - 1 write failed
+ * @note   written to a temporary file and renamed, so a crash keeps the last checkpoint
+ */
+static uint8_t a_daemon_dli_save(void)
+{
+    int fd;
+    uint32_t len;
+    ssize_t n;
+    uint8_t buf[OPT300X_DLI_CHECKPOINT_SIZE(OPT300X_DLI_MAX_SENSOR)];
+    char tmp[256];
+    
+    if (opt300x_dli_checkpoint(&gs_dli, buf, sizeof(buf), &len) != 0)
+    {
+        return 1;
+    }
+    if (snprintf(tmp, sizeof(tmp), "%s.tmp", gs_dli_path) >= (int)sizeof(tmp))
+    {
+        return 1;
+    }
+    fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        return 1;
+    }
+    n = write(fd, buf, len);
+    if ((n != (ssize_t)len) || (fsync(fd) != 0))
+    {
+        (void)close(fd);
+        
+        return 1;
+    }
+    (void)close(fd);
+    if (rename(tmp, gs_dli_path) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     open a bus once for all its sensors
+ * @param[in] bus bus index
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic init failed
+ * @note      none
+ */
+static uint8_t a_daemon_bus_init(uint8_t bus)
+{
+    if (gs_bus[bus].ref == 0)
+    {
+        if (iic_init(gs_bus[bus].name, &gs_bus[bus].fd) != 0)
+        {
+            return 1;
+        }
+    }
+    gs_bus[bus].ref++;
+    
+    return 0;
+}
+
+/**
+ * @brief     close a bus after its last sensor
+ * @param[in] bus bus index
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ * @note      none
+ */
+static uint8_t a_daemon_bus_deinit(uint8_t bus)
+{
+    if (gs_bus[bus].ref == 0)
+    {
+        return 1;
+    }
+    if (--gs_bus[bus].ref == 0)
+    {
+        return iic_deinit(gs_bus[bus].fd);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     define the iic hooks of one bus
+ * @param[in] N bus index
+ * @note      the driver hooks carry no context, so every bus gets its own set
+ */
+#define DAEMON_BUS_HOOK(N)                                                                          \
+static uint8_t a_daemon_bus##N##_init(void)                                                         \
+{                                                                                                   \
+    return a_daemon_bus_init(N);                                                                    \
+}                                                                                                   \
+static uint8_t a_daemon_bus##N##_deinit(void)                                                       \
+{                                                                                                   \
+    return a_daemon_bus_deinit(N);                                                                  \
+}                                                                                                   \
+static uint8_t a_daemon_bus##N##_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)        \
+{                                                                                                   \
+    return iic_read(gs_bus[N].fd, addr, reg, buf, len);                                             \
+}                                                                                                   \
+static uint8_t a_daemon_bus##N##_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)       \
+{                                                                                                   \
+    return iic_write(gs_bus[N].fd, addr, reg, buf, len);                                            \
+}                                                                                                   \
+static uint8_t a_daemon_bus##N##_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len)                 \
+{                                                                                                   \
+    return iic_read_cmd(gs_bus[N].fd, addr, buf, len);                                              \
+}                                                                                                   \
+static uint8_t a_daemon_bus##N##_write_cmd(uint8_t addr, uint8_t *buf, uint16_t len)                \
+{                                                                                                   \
+    return iic_write_cmd(gs_bus[N].fd, addr, buf, len);                                             \
+}
+
+DAEMON_BUS_HOOK(0)
+DAEMON_BUS_HOOK(1)
+DAEMON_BUS_HOOK(2)
+DAEMON_BUS_HOOK(3)
+
+/**
+ * @brief daemon bus hook table definition
+ */
+static const daemon_bus_hook_t gs_bus_hook[DAEMON_MAX_BUS] =
+{
+    {a_daemon_bus0_init, a_daemon_bus0_deinit, a_daemon_bus0_read, a_daemon_bus0_write, a_daemon_bus0_read_cmd, a_daemon_bus0_write_cmd},
+    {a_daemon_bus1_init, a_daemon_bus1_deinit, a_daemon_bus1_read, a_daemon_bus1_write, a_daemon_bus1_read_cmd, a_daemon_bus1_write_cmd},
+    {a_daemon_bus2_init, a_daemon_bus2_deinit, a_daemon_bus2_read, a_daemon_bus2_write, a_daemon_bus2_read_cmd, a_daemon_bus2_write_cmd},
+    {a_daemon_bus3_init, a_daemon_bus3_deinit, a_daemon_bus3_read, a_daemon_bus3_write, a_daemon_bus3_read_cmd, a_daemon_bus3_write_cmd},
+};
+
+/**
+ * @brief     init one sensor
+ * @param[in] *sensor pointer to a sensor structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+static uint8_t a_daemon_sensor_init(daemon_sensor_t *sensor)
+{
+    uint8_t res;
+    opt300x_handle_t *handle = &sensor->handle;
+    
+    /* link interface function */
+    DRIVER_OPT300X_LINK_INIT(handle, opt300x_handle_t);
+    DRIVER_OPT300X_LINK_IIC_INIT(handle, gs_bus_hook[sensor->bus].iic_init);
+    DRIVER_OPT300X_LINK_IIC_DEINIT(handle, gs_bus_hook[sensor->bus].iic_deinit);
+    DRIVER_OPT300X_LINK_IIC_READ(handle, gs_bus_hook[sensor->bus].iic_read);
+    DRIVER_OPT300X_LINK_IIC_WRITE(handle, gs_bus_hook[sensor->bus].iic_write);
+    DRIVER_OPT300X_LINK_IIC_READ_COMMAND(handle, gs_bus_hook[sensor->bus].iic_read_cmd);
+    DRIVER_OPT300X_LINK_IIC_WRITE_COMMAND(handle, gs_bus_hook[sensor->bus].iic_write_cmd);
+    DRIVER_OPT300X_LINK_DELAY_MS(handle, opt300x_interface_delay_ms);
+    DRIVER_OPT300X_LINK_DEBUG_PRINT(handle, opt300x_interface_debug_log);
+    DRIVER_OPT300X_LINK_MUTEX_INIT(handle, opt300x_interface_mutex_init);
+    DRIVER_OPT300X_LINK_MUTEX_DEINIT(handle, opt300x_interface_mutex_deinit);
+    DRIVER_OPT300X_LINK_MUTEX_LOCK(handle, opt300x_interface_mutex_lock);
+    DRIVER_OPT300X_LINK_MUTEX_UNLOCK(handle, opt300x_interface_mutex_unlock);
+    DRIVER_OPT300X_LINK_TIMESTAMP_US(handle, opt300x_interface_timestamp_us);
+    DRIVER_OPT300X_LINK_RECEIVE_CALLBACK(handle, opt300x_interface_receive_callback);
+    
+    /* set chip type */
+    res = opt300x_set_type(handle, sensor->type);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300xd: set type failed.\n");
+        
+        return 1;
+    }
+    
+    /* set iic address */
+    res = opt300x_set_addr_pin(handle, sensor->addr);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300xd: set addr pin failed.\n");
+        
+        return 1;
+    }
+    
+    /* opt300x init */
+    res = opt300x_init(handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300xd: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* set auto range */
+    if (sensor->type == OPT3002)
+    {
+        res = opt3002_set_range(handle, OPT3002_RANGE_AUTO);
+    }
+    else if (sensor->type == OPT3005)
+    {
+        res = opt3005_set_range(handle, OPT3005_RANGE_AUTO);
+    }
+    else
+    {
+        res = opt300x_set_range(handle, OPT300X_RANGE_AUTO);
+    }
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300xd: set range failed.\n");
+        (void)opt300x_deinit(handle);
+        
+        return 1;
+    }
+    
+    /* use the long conversion time when the interval allows it */
+    res = opt300x_set_conversion_time(handle, (sensor->sample_ms >= DAEMON_LONG_INTERVAL_MS) ? 
+                                      OPT300X_CONVERSION_TIME_800_MS : OPT300X_CONVERSION_TIME_100_MS);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300xd: set conversion time failed.\n");
+        (void)opt300x_deinit(handle);
+        
+        return 1;
+    }
+    
+    /* start continuous read */
+    res = opt300x_start_continuous_read(handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300xd: start continuous read failed.\n");
+        (void)opt300x_deinit(handle);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     push one sample into a client queue
+ * @param[in] *client pointer to a client structure
+ * @param[in] *entry pointer to a sample
+ * @note      the oldest sample is dropped and counted when the queue is full
+ */
+static void a_daemon_push(daemon_client_t *client, const daemon_entry_t *entry)
+{
+    if ((client->head - client->tail) == DAEMON_QUEUE_SIZE)                /* check the queue */
+    {
+        client->tail++;                                                    /* drop the oldest */
+        client->dropped++;                                                 /* count it */
+    }
+    client->queue[client->head & DAEMON_QUEUE_MASK] = *entry;              /* save the sample */
+    client->head++;                                                        /* step the head */
+}
+
+/**
+ * @brief     sample one sensor and fan the sample out
+ * @param[in] index sensor index
+ * @note      the bus is read once however many clients subscribe, an overflow is sent as full scale
+ *            with status 4, a failed read only reaches the shared memory and the clients with its status
+ */
+static void a_daemon_sample(uint8_t index)
+{
+    uint8_t i;
+    float data;
+    daemon_entry_t entry;
+    daemon_sensor_t *sensor = &gs_sensor[index];
+    
+    /* read the sensor */
+    memset(&entry, 0, sizeof(daemon_entry_t));
+    if (sensor->type == OPT3002)
+    {
+        entry.status = opt3002_continuous_read(&sensor->handle, &entry.raw, &data);
+    }
+    else
+    {
+        entry.status = opt300x_continuous_read(&sensor->handle, &entry.raw, &data);
+    }
+    entry.timestamp_us = opt300x_interface_timestamp_us();
+    entry.sensor = index;
+    if (entry.status == 4)
+    {
+        entry.raw = DAEMON_FULL_SCALE;
+    }
+    else if (entry.status != 0)
+    {
+        entry.raw = 0;
+    }
+    
+    /* report the failing and the recovered sensor once */
+    if ((entry.status != 0) && (entry.status != 4))
+    {
+        if (sensor->failed == 0)
+        {
+            opt300x_interface_debug_print("opt300xd: sensor %d read failed.\n", index);
+        }
+        sensor->failed = 1;
+    }
+    else if (sensor->failed != 0)
+    {
+        opt300x_interface_debug_print("opt300xd: sensor %d recovered.\n", index);
+        sensor->failed = 0;
+    }
+    
+    /* publish to the local readers */
+    if (gs_shm_enable != 0)
+    {
+        opt300xd_shm_sample_t sample;
+        
+        sample.timestamp_us = entry.timestamp_us;
+        sample.raw = entry.raw;
+        sample.status = entry.status;
+        sample.data = opt300xd_protocol_convert((uint8_t)sensor->type, entry.raw);
+        (void)opt300xd_shm_publish(&gs_shm, index, &sample);
+    }
+    
+    /* keep the history of the read samples only */
+    if (sensor->failed == 0)
+    {
+        /* append to the binary log */
+        if (gs_binlog_enable != 0)
+        {
+            (void)opt300x_binlog_append(&gs_binlog, index, entry.raw, a_daemon_wall_us());
+        }
+        
+        /* consolidate into the round robin database */
+        if (gs_rrd_enable != 0)
+        {
+            (void)opt300x_rrd_update(&gs_rrd, index, entry.raw, a_daemon_wall_us());
+        }
+        
+        /* integrate the daily light, checkpoint once a period */
+        if (gs_dli_enable != 0)
+        {
+            uint64_t wall = a_daemon_wall_us();
+            
+            (void)opt300x_dli_push(&gs_dli, index, entry.raw, wall);
+            if (wall - gs_dli_saved_us >= DAEMON_DLI_SAVE_US)
+            {
+                if (a_daemon_dli_save() != 0)
+                {
+                    opt300x_interface_debug_print("opt300xd: save %s failed.\n", gs_dli_path);
+                }
+                gs_dli_saved_us = wall;
+            }
+        }
+    }
+    
+    /* fan out with the decimation of each client */
+    for (i = 0; i < DAEMON_MAX_CLIENT; i++)
+    {
+        daemon_client_t *client = &gs_client[i];
+        
+        if ((client->fd < 0) || ((client->mask & (1U << index)) == 0))
+        {
+            continue;
+        }
+        if (++client->phase[index] >= client->decimation[index])
+        {
+            client->phase[index] = 0;
+            a_daemon_push(client, &entry);
+        }
+    }
+}
+
+/**
+ * @brief     queue an ack frame of the client subscription
+ * @param[in] *client pointer to a client structure
+ * @param[in] status ack status
+ * @note      the caller makes sure DAEMON_ACK_MAX bytes are free
+ */
+static void a_daemon_ack(daemon_client_t *client, uint8_t status)
+{
+    uint8_t i;
+    opt300xd_ack_t ack;
+    
+    ack.status = status;
+    ack.batch = client->batch;
+    ack.num = gs_sensor_num;
+    for (i = 0; i < gs_sensor_num; i++)
+    {
+        ack.sensor[i].index = i;
+        ack.sensor[i].type = (uint8_t)gs_sensor[i].type;
+        ack.sensor[i].addr = (uint8_t)gs_sensor[i].addr;
+        ack.sensor[i].subscribed = (uint8_t)((client->mask >> i) & 0x01);
+        ack.sensor[i].sample_ms = gs_sensor[i].sample_ms;
+        ack.sensor[i].interval_ms = (ack.sensor[i].subscribed != 0) ? 
+                                    (client->decimation[i] * gs_sensor[i].sample_ms) : 0;
+    }
+    client->tx_len = (uint16_t)(client->tx_len + opt300xd_protocol_pack_ack(&ack, &client->tx[client->tx_len]));
+}
+
+/**
+ * @brief     handle one client frame
+ * @param[in] *client pointer to a client structure
+ * @param[in] type message type
+ * @param[in] *payload pointer to a payload buffer
+ * @param[in] len payload length
+ * @return    status code
+ *            - 0 success
+ *            - 1 frame is invalid
+ * @note      the granted interval is the requested interval rounded up to a multiple of the sampling interval,
+ *            clamped so that it still fits in 32 bits
+ */
+static uint8_t a_daemon_handle(daemon_client_t *client, uint8_t type, const uint8_t *payload, uint16_t len)
+{
+    uint8_t i;
+    uint8_t status;
+    uint64_t decimation;
+    opt300xd_subscribe_t subscribe;
+    
+    if (opt300xd_protocol_unpack_subscribe(payload, len, &subscribe) != 0)
+    {
+        return 1;
+    }
+    status = ((subscribe.mask >> gs_sensor_num) != 0) ? 1 : 0;
+    subscribe.mask &= (uint8_t)((1U << gs_sensor_num) - 1);
+    if (type == OPT300XD_MESSAGE_SUBSCRIBE)
+    {
+        for (i = 0; i < gs_sensor_num; i++)
+        {
+            if ((subscribe.mask & (1U << i)) == 0)
+            {
+                continue;
+            }
+            decimation = ((uint64_t)subscribe.interval_ms + gs_sensor[i].sample_ms - 1) / gs_sensor[i].sample_ms;
+            if (decimation == 0)
+            {
+                decimation = 1;
+            }
+            if (decimation > (UINT32_MAX / gs_sensor[i].sample_ms))
+            {
+                decimation = UINT32_MAX / gs_sensor[i].sample_ms;
+            }
+            client->decimation[i] = (uint32_t)decimation;
+            client->phase[i] = 0;
+        }
+        client->mask |= subscribe.mask;
+        if (subscribe.batch == 0)
+        {
+            client->batch = 1;
+        }
+        else if (subscribe.batch > OPT300XD_PROTOCOL_MAX_BATCH)
+        {
+            client->batch = OPT300XD_PROTOCOL_MAX_BATCH;
+        }
+        else
+        {
+            client->batch = subscribe.batch;
+        }
+    }
+    else if (type == OPT300XD_MESSAGE_UNSUBSCRIBE)
+    {
+        client->mask &= (uint8_t)(~subscribe.mask);
+    }
+    else
+    {
+        return 1;
+    }
+    a_daemon_ack(client, status);
+    
+    return 0;
+}
+
+/**
+ * @brief     parse the received frames of a client
+ * @param[in] *client pointer to a client structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 protocol error
+ * @note      parsing pauses while the transmit buffer has no room for an ack
+ */
+static uint8_t a_daemon_parse(daemon_client_t *client)
+{
+    uint8_t res;
+    uint8_t type;
+    uint16_t payload;
+    uint16_t frame;
+    
+    while (client->tx_len + DAEMON_ACK_MAX <= DAEMON_TX_SIZE)
+    {
+        res = opt300xd_protocol_parse_header(client->rx, client->rx_len, &type, &payload);
+        if (res == 1)
+        {
+            break;
+        }
+        if ((res != 0) || (payload > DAEMON_RX_SIZE - OPT300XD_PROTOCOL_HEADER_SIZE))
+        {
+            return 1;
+        }
+        frame = (uint16_t)(OPT300XD_PROTOCOL_HEADER_SIZE + payload);
+        if (client->rx_len < frame)
+        {
+            break;
+        }
+        if (a_daemon_handle(client, type, &client->rx[OPT300XD_PROTOCOL_HEADER_SIZE], payload) != 0)
+        {
+            return 1;
+        }
+        memmove(client->rx, &client->rx[frame], client->rx_len - frame);
+        client->rx_len = (uint16_t)(client->rx_len - frame);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     send the pending bytes and the queued samples of a client
+ * @param[in] *client pointer to a client structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 socket error
+ * @note      never blocks, a slow client keeps its bytes pending and its queue fills up
+ */
+static uint8_t a_daemon_flush(daemon_client_t *client)
+{
+    uint8_t i;
+    ssize_t n;
+    uint32_t queued;
+    uint64_t offset;
+    opt300xd_batch_t batch;
+    
+    while (1)
+    {
+        /* send the pending bytes */
+        if (client->tx_off < client->tx_len)
+        {
+            n = send(client->fd, &client->tx[client->tx_off], client->tx_len - client->tx_off, MSG_DONTWAIT | MSG_NOSIGNAL);
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                
+                return ((errno == EAGAIN) || (errno == EWOULDBLOCK)) ? 0 : 1;
+            }
+            client->tx_off = (uint16_t)(client->tx_off + n);
+            
+            continue;
+        }
+        client->tx_off = 0;
+        client->tx_len = 0;
+        
+        /* pack the next batch */
+        queued = client->head - client->tail;
+        if ((queued == 0) || (queued < client->batch))
+        {
+            return 0;
+        }
+        batch.num = (uint8_t)((queued > OPT300XD_PROTOCOL_MAX_BATCH) ? OPT300XD_PROTOCOL_MAX_BATCH : queued);
+        batch.timestamp_us = client->queue[client->tail & DAEMON_QUEUE_MASK].timestamp_us;
+        batch.dropped = client->dropped;
+        client->dropped = 0;
+        for (i = 0; i < batch.num; i++)
+        {
+            daemon_entry_t *entry = &client->queue[client->tail & DAEMON_QUEUE_MASK];
+            
+            offset = entry->timestamp_us - batch.timestamp_us;
+            batch.sample[i].sensor = entry->sensor;
+            batch.sample[i].status = entry->status;
+            batch.sample[i].raw = entry->raw;
+            batch.sample[i].offset_us = (offset > 0xFFFFFFFFU) ? 0xFFFFFFFFU : (uint32_t)offset;
+            client->tail++;
+        }
+        client->tx_len = opt300xd_protocol_pack_batch(&batch, client->tx);
+    }
+}
+
+/**
+ * @brief     close a client
+ * @param[in] *client pointer to a client structure
+ * @note      none
+ */
+static void a_daemon_close(daemon_client_t *client)
+{
+    (void)close(client->fd);
+    client->fd = -1;
+}
+
+/**
+ * @brief     accept a new client
+ * @param[in] fd listening socket
+ * @note      the connection is closed at once when all slots are busy
+ */
+static void a_daemon_accept(int fd)
+{
+    uint8_t i;
+    int client_fd;
+    
+    client_fd = accept(fd, NULL, NULL);
+    if (client_fd < 0)
+    {
+        return;
+    }
+    for (i = 0; i < DAEMON_MAX_CLIENT; i++)
+    {
+        if (gs_client[i].fd < 0)
+        {
+            break;
+        }
+    }
+    if ((i == DAEMON_MAX_CLIENT) || (fcntl(client_fd, F_SETFL, O_NONBLOCK) != 0))
+    {
+        opt300x_interface_debug_print("opt300xd: reject a client.\n");
+        (void)close(client_fd);
+        
+        return;
+    }
+    memset(&gs_client[i], 0, sizeof(daemon_client_t));
+    gs_client[i].fd = client_fd;
+    gs_client[i].batch = 1;
+}
+
+/**
+ * @brief     receive the bytes of a client
+ * @param[in] *client pointer to a client structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 connection is closed
+ * @note      none
+ */
+static uint8_t a_daemon_receive(daemon_client_t *client)
+{
+    ssize_t n;
+    
+    n = recv(client->fd, &client->rx[client->rx_len], DAEMON_RX_SIZE - client->rx_len, MSG_DONTWAIT);
+    if (n == 0)
+    {
+        return 1;
+    }
+    if (n < 0)
+    {
+        return ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)) ? 0 : 1;
+    }
+    client->rx_len = (uint16_t)(client->rx_len + n);
+    
+    return 0;
+}
+
+/**
+ * @brief     serve the clients until a signal arrives
+ * @param[in] fd listening socket
+ * @note      one thread samples every sensor on its own schedule and serves all clients with poll
+ */
+static void a_daemon_run(int fd)
+{
+    uint8_t i;
+    int n;
+    int timeout;
+    uint64_t now;
+    uint64_t next;
+    struct pollfd pfd[DAEMON_MAX_CLIENT + 1];
+    
+    now = opt300x_interface_timestamp_us();
+    for (i = 0; i < gs_sensor_num; i++)
+    {
+        gs_sensor[i].next_us = now;
+    }
+    while (gs_stop == 0)
+    {
+        /* sample the due sensors */
+        now = opt300x_interface_timestamp_us();
+        next = UINT64_MAX;
+        for (i = 0; i < gs_sensor_num; i++)
+        {
+            daemon_sensor_t *sensor = &gs_sensor[i];
+            
+            if (now >= sensor->next_us)
+            {
+                a_daemon_sample(i);
+                sensor->next_us += (uint64_t)sensor->sample_ms * 1000;
+                if (sensor->next_us <= now)
+                {
+                    sensor->next_us = now + (uint64_t)sensor->sample_ms * 1000;
+                }
+            }
+            if (sensor->next_us < next)
+            {
+                next = sensor->next_us;
+            }
+        }
+        
+        /* parse the buffered frames and send the batches */
+        for (i = 0; i < DAEMON_MAX_CLIENT; i++)
+        {
+            daemon_client_t *client = &gs_client[i];
+            
+            if (client->fd < 0)
+            {
+                continue;
+            }
+            if ((a_daemon_parse(client) != 0) || (a_daemon_flush(client) != 0))
+            {
+                a_daemon_close(client);
+            }
+        }
+        opt300x_interface_debug_flush();
+        
+        /* wait for the next sample or a socket event */
+        pfd[0].fd = fd;
+        pfd[0].events = POLLIN;
+        for (i = 0; i < DAEMON_MAX_CLIENT; i++)
+        {
+            daemon_client_t *client = &gs_client[i];
+            
+            pfd[i + 1].fd = client->fd;
+            pfd[i + 1].events = 0;
+            pfd[i + 1].revents = 0;
+            if ((client->rx_len < DAEMON_RX_SIZE) && (client->tx_len + DAEMON_ACK_MAX <= DAEMON_TX_SIZE))
+            {
+                pfd[i + 1].events |= POLLIN;
+            }
+            if (client->tx_off < client->tx_len)
+            {
+                pfd[i + 1].events |= POLLOUT;
+            }
+        }
+        now = opt300x_interface_timestamp_us();
+        timeout = (next > now) ? (int)((next - now + 999) / 1000) : 0;
+        n = poll(pfd, DAEMON_MAX_CLIENT + 1, timeout);
+        if (n <= 0)
+        {
+            continue;
+        }
+        
+        /* handle the socket events */
+        if ((pfd[0].revents & POLLIN) != 0)
+        {
+            a_daemon_accept(fd);
+        }
+        for (i = 0; i < DAEMON_MAX_CLIENT; i++)
+        {
+            daemon_client_t *client = &gs_client[i];
+            
+            if ((client->fd < 0) || (pfd[i + 1].fd != client->fd))
+            {
+                continue;
+            }
+            if ((pfd[i + 1].revents & POLLIN) != 0)
+            {
+                if (a_daemon_receive(client) != 0)
+                {
+                    a_daemon_close(client);
+                }
+            }
+            else if ((pfd[i + 1].revents & (POLLERR | POLLHUP | POLLNVAL)) != 0)
+            {
+                a_daemon_close(client);
+            }
+            else
+            {
+                /* pending bytes are sent in the next loop */
+            }
+        }
+    }
+}
+
+/**
+ * @brief     parse a sensor option
+ * @param[in] *arg pointer to a "type,addr[,interval[,bus]]" string
+ * @param[in] *sensor pointer to a sensor structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 parse failed
+ * @note      up to DAEMON_MAX_BUS different iic devices are accepted
+ */
+static uint8_t a_daemon_parse_sensor(char *arg, daemon_sensor_t *sensor)
+{
+    char *type;
+    char *addr;
+    char *interval;
+    const char *bus;
+    char *save = NULL;
+    uint8_t i;
+    
+    type = strtok_r(arg, ",", &save);
+    addr = strtok_r(NULL, ",", &save);
+    interval = strtok_r(NULL, ",", &save);
+    bus = strtok_r(NULL, ",", &save);
+    if ((type == NULL) || (addr == NULL))
+    {
+        return 1;
+    }
+    
+    /* chip type */
+    if (strcmp("OPT3001", type) == 0)
+    {
+        sensor->type = OPT3001;
+    }
+    else if (strcmp("OPT3002", type) == 0)
+    {
+        sensor->type = OPT3002;
+    }
+    else if (strcmp("OPT3004", type) == 0)
+    {
+        sensor->type = OPT3004;
+    }
+    else if (strcmp("OPT3005", type) == 0)
+    {
+        sensor->type = OPT3005;
+    }
+    else if (strcmp("OPT3006", type) == 0)
+    {
+        sensor->type = OPT3006;
+    }
+    else if (strcmp("OPT3007", type) == 0)
+    {
+        sensor->type = OPT3007;
+    }
+    else
+    {
+        return 1;
+    }
+    
+    /* addr pin */
+    if (strcmp("GND", addr) == 0)
+    {
+        sensor->addr = OPT300X_ADDRESS_GND;
+    }
+    else if (strcmp("VCC", addr) == 0)
+    {
+        sensor->addr = OPT300X_ADDRESS_VCC;
+    }
+    else if (strcmp("SCL", addr) == 0)
+    {
+        sensor->addr = OPT300X_ADDRESS_SCL;
+    }
+    else if (strcmp("SDA", addr) == 0)
+    {
+        sensor->addr = OPT300X_ADDRESS_SDA;
+    }
+    else
+    {
+        return 1;
+    }
+    
+    /* sampling interval */
+    sensor->sample_ms = (interval != NULL) ? (uint32_t)strtoul(interval, NULL, 10) : DAEMON_LONG_INTERVAL_MS;
+    if (sensor->sample_ms < DAEMON_MIN_INTERVAL_MS)
+    {
+        sensor->sample_ms = DAEMON_MIN_INTERVAL_MS;
+    }
+    
+    /* iic bus, the sensors on the same device share it */
+    if (bus == NULL)
+    {
+        bus = DAEMON_DEFAULT_BUS;
+    }
+    if (strlen(bus) >= DAEMON_BUS_NAME_SIZE)
+    {
+        return 1;
+    }
+    for (i = 0; i < gs_bus_num; i++)
+    {
+        if (strcmp(gs_bus[i].name, bus) == 0)
+        {
+            break;
+        }
+    }
+    if (i == gs_bus_num)
+    {
+        if (gs_bus_num >= DAEMON_MAX_BUS)
+        {
+            return 1;
+        }
+        strcpy(gs_bus[i].name, bus);
+        gs_bus[i].ref = 0;
+        gs_bus_num++;
+    }
+    sensor->bus = i;
+    
+    return 0;
+}
+
+/**
+ * @brief     opt300xd full function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+static uint8_t opt300xd(int argc, char **argv)
+{
+    int c;
+    int fd;
+    int longindex = 0;
+    uint8_t i;
+    uint8_t res;
+    const char short_options[] = "hs:";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"sensor", required_argument, NULL, 's'},
+        {"socket", required_argument, NULL, 1},
+        {"shm", optional_argument, NULL, 2},
+        {"binlog", required_argument, NULL, 3},
+        {"rrd", required_argument, NULL, 4},
+        {"dli", required_argument, NULL, 5},
+        {NULL, 0, NULL, 0},
+    };
+    char path[sizeof(((struct sockaddr_un *)0)->sun_path)] = OPT300XD_PROTOCOL_DEFAULT_SOCKET;
+    const char *shm_path = OPT300XD_SHM_DEFAULT_PATH;
+    const char *binlog_path = NULL;
+    opt300x_binlog_sensor_t binlog_sensor[OPT300XD_PROTOCOL_MAX_SENSOR];
+    const char *rrd_path = NULL;
+    opt300x_rrd_sensor_t rrd_sensor[OPT300X_RRD_MAX_SENSOR];
+    opt300x_rrd_tier_t rrd_tier[] = OPT300X_RRD_DEFAULT_TIER;
+    opt300x_t dli_type[OPT300X_DLI_MAX_SENSOR];
+    opt300xd_shm_info_t info[OPT300XD_PROTOCOL_MAX_SENSOR];
+    struct sockaddr_un addr;
+    struct sigaction sa;
+    
+    /* parse */
+    optind = 0;
+    gs_sensor_num = 0;
+    do
+    {
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        switch (c)
+        {
+            /* help */
+            case 'h' :
+            {
+                goto help;
+            }
+            
+            /* sensor */
+            case 's' :
+            {
+                if (gs_sensor_num >= OPT300XD_PROTOCOL_MAX_SENSOR)
+                {
+                    return 5;
+                }
+                if (a_daemon_parse_sensor(optarg, &gs_sensor[gs_sensor_num]) != 0)
+                {
+                    return 5;
+                }
+                gs_sensor_num++;
+                
+                break;
+            }
+            
+            /* socket */
+            case 1 :
+            {
+                if (strlen(optarg) >= sizeof(path))
+                {
+                    return 5;
+                }
+                strcpy(path, optarg);
+                
+                break;
+            }
+            
+            /* shared memory */
+            case 2 :
+            {
+                gs_shm_enable = 1;
+                if (optarg != NULL)
+                {
+                    shm_path = optarg;
+                }
+                
+                break;
+            }
+            
+            /* binary log */
+            case 3 :
+            {
+                binlog_path = optarg;
+                
+                break;
+            }
+            
+            /* round robin database */
+            case 4 :
+            {
+                rrd_path = optarg;
+                
+                break;
+            }
+            
+            /* daily light integral */
+            case 5 :
+            {
+                gs_dli_path = optarg;
+                
+                break;
+            }
+            
+            /* the end */
+            case -1 :
+            {
+                break;
+            }
+            
+            /* others */
+            default :
+            {
+                return 5;
+            }
+        }
+    } while (c != -1);
+    
+    /* at least one sensor */
+    if (gs_sensor_num == 0)
+    {
+        goto help;
+    }
+    
+    /* init the sensors */
+    for (i = 0; i < gs_sensor_num; i++)
+    {
+        if (a_daemon_sensor_init(&gs_sensor[i]) != 0)
+        {
+            while (i != 0)
+            {
+                (void)opt300x_deinit(&gs_sensor[--i].handle);
+            }
+            
+            return 1;
+        }
+    }
+    
+    /* create the shared memory */
+    if (gs_shm_enable != 0)
+    {
+        for (i = 0; i < gs_sensor_num; i++)
+        {
+            info[i].type = (uint8_t)gs_sensor[i].type;
+            info[i].addr = (uint8_t)gs_sensor[i].addr;
+            info[i].sample_ms = gs_sensor[i].sample_ms;
+        }
+        if (opt300xd_shm_create(&gs_shm, shm_path, info, gs_sensor_num, OPT300XD_SHM_DEFAULT_DEPTH) != 0)
+        {
+            opt300x_interface_debug_print("opt300xd: create %s failed.\n", shm_path);
+            gs_shm_enable = 0;
+            res = 1;
+            
+            goto deinit;
+        }
+    }
+    
+    /* open the binary log */
+    if (binlog_path != NULL)
+    {
+        for (i = 0; i < gs_sensor_num; i++)
+        {
+            binlog_sensor[i].type = gs_sensor[i].type;
+            binlog_sensor[i].addr = gs_sensor[i].addr;
+        }
+        if (opt300x_binlog_writer_open(&gs_binlog, binlog_path, binlog_sensor, gs_sensor_num,
+                                       OPT300X_BINLOG_DEFAULT_BLOCK_RECORD) != 0)
+        {
+            opt300x_interface_debug_print("opt300xd: open %s failed.\n", binlog_path);
+            res = 1;
+            
+            goto deinit;
+        }
+        gs_binlog_enable = 1;
+    }
+    
+    /* open the round robin database */
+    if (rrd_path != NULL)
+    {
+        if (gs_sensor_num > OPT300X_RRD_MAX_SENSOR)
+        {
+            opt300x_interface_debug_print("opt300xd: rrd supports %d sensors at most.\n", OPT300X_RRD_MAX_SENSOR);
+            res = 1;
+            
+            goto deinit;
+        }
+        for (i = 0; i < gs_sensor_num; i++)
+        {
+            rrd_sensor[i].type = gs_sensor[i].type;
+            rrd_sensor[i].addr = gs_sensor[i].addr;
+        }
+        res = opt300x_rrd_create(&gs_rrd, rrd_path, rrd_sensor, gs_sensor_num,
+                                 rrd_tier, sizeof(rrd_tier) / sizeof(rrd_tier[0]));
+        if (res != 0)
+        {
+            if (res == 5)
+            {
+                opt300x_interface_debug_print("opt300xd: %s has other sensors or tiers.\n", rrd_path);
+            }
+            else
+            {
+                opt300x_interface_debug_print("opt300xd: open %s failed.\n", rrd_path);
+            }
+            res = 1;
+            
+            goto deinit;
+        }
+        gs_rrd_enable = 1;
+    }
+    
+    /* start the daily light integral, days start at the local midnight of now */
+    if (gs_dli_path != NULL)
+    {
+        time_t now;
+        struct tm local;
+        uint8_t buf[OPT300X_DLI_CHECKPOINT_SIZE(OPT300X_DLI_MAX_SENSOR) + 1];
+        
+        if (gs_sensor_num > OPT300X_DLI_MAX_SENSOR)
+        {
+            opt300x_interface_debug_print("opt300xd: dli supports %d sensors at most.\n", OPT300X_DLI_MAX_SENSOR);
+            res = 1;
+            
+            goto deinit;
+        }
+        for (i = 0; i < gs_sensor_num; i++)
+        {
+            dli_type[i] = gs_sensor[i].type;
+        }
+        now = time(NULL);
+        (void)localtime_r(&now, &local);
+        (void)opt300x_dli_init(&gs_dli, dli_type, gs_sensor_num, DAEMON_DLI_MAX_GAP_US,
+                               (int64_t)local.tm_gmtoff * 1000000, a_daemon_dli_close);
+        fd = open(gs_dli_path, O_RDONLY);
+        if (fd >= 0)
+        {
+            ssize_t n;
+            
+            n = read(fd, buf, sizeof(buf));
+            (void)close(fd);
+            if ((n <= 0) || (opt300x_dli_restore(&gs_dli, buf, (uint32_t)n) != 0))
+            {
+                opt300x_interface_debug_print("opt300xd: %s is not a checkpoint of these sensors, start again.\n", gs_dli_path);
+            }
+        }
+        gs_dli_saved_us = a_daemon_wall_us();
+        gs_dli_enable = 1;
+    }
+    
+    /* open the socket */
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        opt300x_interface_debug_print("opt300xd: socket failed.\n");
+        res = 1;
+        
+        goto deinit;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    (void)unlink(path);
+    if ((bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) || (listen(fd, DAEMON_MAX_CLIENT) != 0))
+    {
+        opt300x_interface_debug_print("opt300xd: bind %s failed.\n", path);
+        (void)close(fd);
+        res = 1;
+        
+        goto deinit;
+    }
+    
+    /* stop on SIGINT and SIGTERM, poll is interrupted */
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = a_daemon_signal;
+    (void)sigaction(SIGINT, &sa, NULL);
+    (void)sigaction(SIGTERM, &sa, NULL);
+    sa.sa_handler = SIG_IGN;
+    (void)sigaction(SIGPIPE, &sa, NULL);
+    
+    /* serve */
+    for (i = 0; i < DAEMON_MAX_CLIENT; i++)
+    {
+        gs_client[i].fd = -1;
+    }
+    opt300x_interface_debug_print("opt300xd: serve %d sensor(s) on %s.\n", gs_sensor_num, path);
+    a_daemon_run(fd);
+    
+    /* close all */
+    for (i = 0; i < DAEMON_MAX_CLIENT; i++)
+    {
+        if (gs_client[i].fd >= 0)
+        {
+            a_daemon_close(&gs_client[i]);
+        }
+    }
+    (void)close(fd);
+    (void)unlink(path);
+    res = 0;
+    
+    deinit:
+    if (gs_dli_enable != 0)
+    {
+        if (a_daemon_dli_save() != 0)
+        {
+            opt300x_interface_debug_print("opt300xd: save %s failed.\n", gs_dli_path);
+        }
+        gs_dli_enable = 0;
+    }
+    if (gs_rrd_enable != 0)
+    {
+        (void)opt300x_rrd_close(&gs_rrd);
+        gs_rrd_enable = 0;
+    }
+    if (gs_binlog_enable != 0)
+    {
+        (void)opt300x_binlog_writer_close(&gs_binlog);
+        gs_binlog_enable = 0;
+    }
+    if (gs_shm_enable != 0)
+    {
+        (void)opt300xd_shm_close(&gs_shm);
+        (void)unlink(shm_path);
+        gs_shm_enable = 0;
+    }
+    for (i = 0; i < gs_sensor_num; i++)
+    {
+        (void)opt300x_stop_continuous_read(&gs_sensor[i].handle);
+        (void)opt300x_deinit(&gs_sensor[i].handle);
+    }
+    
+    return res;
+    
+    help:
+    opt300x_interface_debug_print("Usage:\n");
+    opt300x_interface_debug_print("  opt300xd (-h | --help)\n");
+    opt300x_interface_debug_print("  opt300xd (-s <type,addr[,interval[,bus]]> | --sensor=<type,addr[,interval[,bus]]>)... [--socket=<path>] [--shm[=<path>]] [--binlog=<path>] [--rrd=<path>] [--dli=<path>]\n");
+    opt300x_interface_debug_print("\n");
+    opt300x_interface_debug_print("Options:\n");
+    opt300x_interface_debug_print("      --binlog=<path>                   Append the samples to a binary log, an existing log is continued.\n");
+    opt300x_interface_debug_print("      --dli=<path>                      Integrate the daily light and checkpoint it to the path every minute.\n");
+    opt300x_interface_debug_print("  -h, --help                            Show the help.\n");
+    opt300x_interface_debug_print("      --rrd=<path>                      Keep 10 Hz, 1 s and 1 min averages, minimums and maximums for an hour, a day and a year.\n");
+    opt300x_interface_debug_print("  -s <type,addr[,interval[,bus]]>, --sensor=<type,addr[,interval[,bus]]>\n");
+    opt300x_interface_debug_print("                                        Add a sensor, type is OPT3001 | OPT3002 | OPT3004 | OPT3005 | OPT3006 | OPT3007,\n");
+    opt300x_interface_debug_print("                                        addr is VCC | GND | SCL | SDA, interval is the sampling interval in ms\n");
+    opt300x_interface_debug_print("                                        and bus is the iic device, at most %d different devices.\n", DAEMON_MAX_BUS);
+    opt300x_interface_debug_print("                                        ([default interval: 800], [min interval: 100], [default bus: %s])\n", DAEMON_DEFAULT_BUS);
+    opt300x_interface_debug_print("      --shm[=<path>]                    Publish the samples to a shared memory ring.([default: %s])\n", OPT300XD_SHM_DEFAULT_PATH);
+    opt300x_interface_debug_print("      --socket=<path>                   Set the unix socket path.([default: %s])\n", OPT300XD_PROTOCOL_DEFAULT_SOCKET);
+    
+    return 0;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    uint8_t res;
+    
+    res = opt300xd(argc, argv);
+    if (res == 0)
+    {
+        /* run success */
+    }
+    else if (res == 1)
+    {
+        opt300x_interface_debug_print("opt300xd: run failed.\n");
+    }
+    else if (res == 5)
+    {
+        opt300x_interface_debug_print("opt300xd: param is invalid.\n");
+    }
+    else
+    {
+        opt300x_interface_debug_print("opt300xd: unknown status code.\n");
+    }
+    
+    /* output the deferred messages */
+    opt300x_interface_debug_flush();
+    
+    return (res == 0) ? 0 : 1;
+}
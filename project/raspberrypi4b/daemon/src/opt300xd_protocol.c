@@ -0,0 +1,343 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      opt300xd_protocol.c
+ * @brief     opt300xd protocol source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "opt300xd_protocol.h"
+#include "driver_opt300x.h"
+#include <string.h>
+
+/**
+ * @brief     put a little endian 16 bits value
+ * @param[in] *buf pointer to a buffer
+ * @param[in] v value
+ * @note      none
+ */
+static void a_put_u16(uint8_t *buf, uint16_t v)
+{
+    buf[0] = (uint8_t)(v >> 0);
+    buf[1] = (uint8_t)(v >> 8);
+}
+
+/**
+ * @brief     put a little endian 32 bits value
+ * @param[in] *buf pointer to a buffer
+ * @param[in] v value
+ * @note      none
+ */
+static void a_put_u32(uint8_t *buf, uint32_t v)
+{
+    a_put_u16(&buf[0], (uint16_t)(v >> 0));
+    a_put_u16(&buf[2], (uint16_t)(v >> 16));
+}
+
+/**
+ * @brief     get a little endian 16 bits value
+ * @param[in] *buf pointer to a buffer
+ * @return    value
+ * @note      none
+ */
+static uint16_t a_get_u16(const uint8_t *buf)
+{
+    return (uint16_t)(((uint16_t)buf[1] << 8) | buf[0]);
+}
+
+/**
+ * @brief     get a little endian 32 bits value
+ * @param[in] *buf pointer to a buffer
+ * @return    value
+ * @note      none
+ */
+static uint32_t a_get_u32(const uint8_t *buf)
+{
+    return ((uint32_t)a_get_u16(&buf[2]) << 16) | a_get_u16(&buf[0]);
+}
+
+/**
+ * @brief     put a frame header
+ * @param[in] *buf pointer to a frame buffer
+ * @param[in] type message type
+ * @param[in] payload payload length
+ * @return    frame length
+ * @note      none
+ */
+static uint16_t a_put_header(uint8_t *buf, uint8_t type, uint16_t payload)
+{
+    buf[0] = type;                                                 /* set the type */
+    buf[1] = OPT300XD_PROTOCOL_VERSION;                            /* set the version */
+    a_put_u16(&buf[2], payload);                                   /* set the payload length */
+    
+    return (uint16_t)(OPT300XD_PROTOCOL_HEADER_SIZE + payload);
+}
+
+/**
+ * @brief      parse a frame header
+ * @param[in]  *buf pointer to a frame buffer
+ * @param[in]  len length of the buffer
+ * @param[out] *type pointer to a message type buffer
+ * @param[out] *payload pointer to a payload length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 header is incomplete
+ *             - 4 version is invalid
+ * @note       the whole frame is OPT300XD_PROTOCOL_HEADER_SIZE + payload bytes
+ */
+uint8_t opt300xd_protocol_parse_header(const uint8_t *buf, uint16_t len, uint8_t *type, uint16_t *payload)
+{
+    if (len < OPT300XD_PROTOCOL_HEADER_SIZE)                       /* check the length */
+    {
+        return 1;                                                  /* return error */
+    }
+    if (buf[1] != OPT300XD_PROTOCOL_VERSION)                       /* check the version */
+    {
+        return 4;                                                  /* return error */
+    }
+    *type = buf[0];                                                /* get the type */
+    *payload = a_get_u16(&buf[2]);                                 /* get the payload length */
+    
+    return 0;                                                      /* success return 0 */
+}
+
+/**
+ * @brief     pack a subscribe or unsubscribe frame
+ * @param[in] type OPT300XD_MESSAGE_SUBSCRIBE or OPT300XD_MESSAGE_UNSUBSCRIBE
+ * @param[in] *subscribe pointer to a subscribe structure
+ * @param[in] *buf pointer to a frame buffer
+ * @return    frame length
+ * @note      unsubscribe uses the mask only
+ */
+uint16_t opt300xd_protocol_pack_subscribe(uint8_t type, const opt300xd_subscribe_t *subscribe, uint8_t *buf)
+{
+    uint8_t *p = &buf[OPT300XD_PROTOCOL_HEADER_SIZE];
+    
+    p[0] = subscribe->mask;                                                             /* set the mask */
+    p[1] = subscribe->batch;                                                            /* set the batch */
+    a_put_u16(&p[2], 0);                                                                /* reserved */
+    a_put_u32(&p[4], subscribe->interval_ms);                                           /* set the interval */
+    
+    return a_put_header(buf, type, OPT300XD_PROTOCOL_SUBSCRIBE_SIZE);                   /* set the header */
+}
+
+/**
+ * @brief      unpack a subscribe payload
+ * @param[in]  *buf pointer to a payload buffer
+ * @param[in]  len payload length
+ * @param[out] *subscribe pointer to a subscribe structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 payload is invalid
+ * @note       none
+ */
+uint8_t opt300xd_protocol_unpack_subscribe(const uint8_t *buf, uint16_t len, opt300xd_subscribe_t *subscribe)
+{
+    if (len != OPT300XD_PROTOCOL_SUBSCRIBE_SIZE)                   /* check the length */
+    {
+        return 1;                                                  /* return error */
+    }
+    subscribe->mask = buf[0];                                      /* get the mask */
+    subscribe->batch = buf[1];                                     /* get the batch */
+    subscribe->interval_ms = a_get_u32(&buf[4]);                   /* get the interval */
+    
+    return 0;                                                      /* success return 0 */
+}
+
+/**
+ * @brief     pack an ack frame
+ * @param[in] *ack pointer to an ack structure
+ * @param[in] *buf pointer to a frame buffer
+ * @return    frame length
+ * @note      none
+ */
+uint16_t opt300xd_protocol_pack_ack(const opt300xd_ack_t *ack, uint8_t *buf)
+{
+    uint8_t i;
+    uint8_t *p = &buf[OPT300XD_PROTOCOL_HEADER_SIZE];
+    
+    p[0] = ack->status;                                            /* set the status */
+    p[1] = ack->batch;                                             /* set the batch */
+    p[2] = ack->num;                                               /* set the sensor numbers */
+    p[3] = 0;                                                      /* reserved */
+    p += OPT300XD_PROTOCOL_ACK_SIZE;                               /* step the header */
+    for (i = 0; i < ack->num; i++)                                 /* pack all sensors */
+    {
+        p[0] = ack->sensor[i].index;                               /* set the index */
+        p[1] = ack->sensor[i].type;                                /* set the type */
+        p[2] = ack->sensor[i].addr;                                /* set the addr */
+        p[3] = ack->sensor[i].subscribed;                          /* set the subscribed flag */
+        a_put_u32(&p[4], ack->sensor[i].sample_ms);                /* set the sampling interval */
+        a_put_u32(&p[8], ack->sensor[i].interval_ms);              /* set the granted interval */
+        p += OPT300XD_PROTOCOL_ACK_SENSOR_SIZE;                    /* step the sensor */
+    }
+    
+    return a_put_header(buf, OPT300XD_MESSAGE_ACK, 
+                        (uint16_t)(OPT300XD_PROTOCOL_ACK_SIZE + ack->num * OPT300XD_PROTOCOL_ACK_SENSOR_SIZE));
+}
+
+/**
+ * @brief      unpack an ack payload
+ * @param[in]  *buf pointer to a payload buffer
+ * @param[in]  len payload length
+ * @param[out] *ack pointer to an ack structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 payload is invalid
+ * @note       none
+ */
+uint8_t opt300xd_protocol_unpack_ack(const uint8_t *buf, uint16_t len, opt300xd_ack_t *ack)
+{
+    uint8_t i;
+    
+    if (len < OPT300XD_PROTOCOL_ACK_SIZE)                                                          /* check the length */
+    {
+        return 1;                                                                                  /* return error */
+    }
+    ack->status = buf[0];                                                                          /* get the status */
+    ack->batch = buf[1];                                                                           /* get the batch */
+    ack->num = buf[2];                                                                             /* get the sensor numbers */
+    if ((ack->num > OPT300XD_PROTOCOL_MAX_SENSOR) || 
+        (len != OPT300XD_PROTOCOL_ACK_SIZE + ack->num * OPT300XD_PROTOCOL_ACK_SENSOR_SIZE))        /* check the sensor numbers */
+    {
+        return 1;                                                                                  /* return error */
+    }
+    buf += OPT300XD_PROTOCOL_ACK_SIZE;                                                             /* step the header */
+    for (i = 0; i < ack->num; i++)                                                                 /* unpack all sensors */
+    {
+        ack->sensor[i].index = buf[0];                                                             /* get the index */
+        ack->sensor[i].type = buf[1];                                                              /* get the type */
+        ack->sensor[i].addr = buf[2];                                                              /* get the addr */
+        ack->sensor[i].subscribed = buf[3];                                                        /* get the subscribed flag */
+        ack->sensor[i].sample_ms = a_get_u32(&buf[4]);                                             /* get the sampling interval */
+        ack->sensor[i].interval_ms = a_get_u32(&buf[8]);                                           /* get the granted interval */
+        buf += OPT300XD_PROTOCOL_ACK_SENSOR_SIZE;                                                  /* step the sensor */
+    }
+    
+    return 0;                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     pack a batch frame
+ * @param[in] *batch pointer to a batch structure
+ * @param[in] *buf pointer to a frame buffer
+ * @return    frame length
+ * @note      buf must hold OPT300XD_PROTOCOL_MAX_FRAME bytes
+ */
+uint16_t opt300xd_protocol_pack_batch(const opt300xd_batch_t *batch, uint8_t *buf)
+{
+    uint8_t i;
+    uint8_t *p = &buf[OPT300XD_PROTOCOL_HEADER_SIZE];
+    
+    a_put_u32(&p[0], (uint32_t)(batch->timestamp_us >> 0));       /* set the timestamp low */
+    a_put_u32(&p[4], (uint32_t)(batch->timestamp_us >> 32));       /* set the timestamp high */
+    a_put_u32(&p[8], batch->dropped);                              /* set the dropped samples */
+    p[12] = batch->num;                                            /* set the sample numbers */
+    memset(&p[13], 0, 3);                                          /* reserved */
+    p += OPT300XD_PROTOCOL_BATCH_SIZE;                             /* step the header */
+    for (i = 0; i < batch->num; i++)                               /* pack all samples */
+    {
+        p[0] = batch->sample[i].sensor;                            /* set the sensor */
+        p[1] = batch->sample[i].status;                            /* set the status */
+        a_put_u16(&p[2], batch->sample[i].raw);                    /* set the raw data */
+        a_put_u32(&p[4], batch->sample[i].offset_us);              /* set the offset */
+        p += OPT300XD_PROTOCOL_SAMPLE_SIZE;                        /* step the sample */
+    }
+    
+    return a_put_header(buf, OPT300XD_MESSAGE_BATCH, 
+                        (uint16_t)(OPT300XD_PROTOCOL_BATCH_SIZE + batch->num * OPT300XD_PROTOCOL_SAMPLE_SIZE));
+}
+
+/**
+ * @brief      unpack a batch payload
+ * @param[in]  *buf pointer to a payload buffer
+ * @param[in]  len payload length
+ * @param[out] *batch pointer to a batch structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 payload is invalid
+ * @note       none
+ */
+uint8_t opt300xd_protocol_unpack_batch(const uint8_t *buf, uint16_t len, opt300xd_batch_t *batch)
+{
+    uint8_t i;
+    
+    if (len < OPT300XD_PROTOCOL_BATCH_SIZE)                                                        /* check the length */
+    {
+        return 1;                                                                                  /* return error */
+    }
+    batch->timestamp_us = ((uint64_t)a_get_u32(&buf[4]) << 32) | a_get_u32(&buf[0]);               /* get the timestamp */
+    batch->dropped = a_get_u32(&buf[8]);                                                           /* get the dropped samples */
+    batch->num = buf[12];                                                                          /* get the sample numbers */
+    if ((batch->num > OPT300XD_PROTOCOL_MAX_BATCH) || 
+        (len != OPT300XD_PROTOCOL_BATCH_SIZE + batch->num * OPT300XD_PROTOCOL_SAMPLE_SIZE))        /* check the sample numbers */
+    {
+        return 1;                                                                                  /* return error */
+    }
+    buf += OPT300XD_PROTOCOL_BATCH_SIZE;                                                           /* step the header */
+    for (i = 0; i < batch->num; i++)                                                               /* unpack all samples */
+    {
+        batch->sample[i].sensor = buf[0];                                                          /* get the sensor */
+        batch->sample[i].status = buf[1];                                                          /* get the status */
+        batch->sample[i].raw = a_get_u16(&buf[2]);                                                 /* get the raw data */
+        batch->sample[i].offset_us = a_get_u32(&buf[4]);                                           /* get the offset */
+        buf += OPT300XD_PROTOCOL_SAMPLE_SIZE;                                                      /* step the sample */
+    }
+    
+    return 0;                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     convert a raw sample to lux or nW/cm2
+ * @param[in] type chip type, opt300x_t
+ * @param[in] raw raw data
+ * @return    converted data
+ * @note      OPT3002 is in nW/cm2 and the others are in lux
+ */
+float opt300xd_protocol_convert(uint8_t type, uint16_t raw)
+{
+    float weight;
+    
+    if (type == OPT3002)                                               /* opt3002 */
+    {
+        weight = 1.2f;                                                 /* nW/cm2 */
+    }
+    else if (type == OPT3005)                                          /* opt3005 */
+    {
+        weight = 0.02f;                                                /* lux */
+    }
+    else
+    {
+        weight = 0.01f;                                                /* lux */
+    }
+    
+    return weight * (float)(1UL << (raw >> 12)) * (float)(raw & 0x0FFF);
+}
@@ -0,0 +1,371 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      opt300xd_protocol_test.c
+ * @brief     opt300xd protocol test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "opt300xd_protocol_test.h"
+#include "driver_opt300x.h"
+#include <math.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/**
+ * @brief     write a whole buffer
+ * @param[in] fd socket
+ * @param[in] *buf pointer to a buffer
+ * @param[in] len buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_opt300xd_protocol_test_write(int fd, const uint8_t *buf, uint16_t len)
+{
+    ssize_t n;
+    
+    while (len != 0)
+    {
+        n = write(fd, buf, len);
+        if (n <= 0)
+        {
+            return 1;
+        }
+        buf += n;
+        len = (uint16_t)(len - n);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      read one whole frame
+ * @param[in]  fd socket
+ * @param[out] *buf pointer to a frame buffer with OPT300XD_PROTOCOL_MAX_FRAME bytes
+ * @param[out] *type pointer to a message type buffer
+ * @param[out] *payload pointer to a payload length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the stream is read byte by byte, so the header is parsed from a partial buffer first
+ */
+static uint8_t a_opt300xd_protocol_test_read(int fd, uint8_t *buf, uint8_t *type, uint16_t *payload)
+{
+    uint16_t len;
+    
+    len = 0;
+    while (1)
+    {
+        if (read(fd, &buf[len], 1) != 1)
+        {
+            return 1;
+        }
+        len++;
+        if (opt300xd_protocol_parse_header(buf, len, type, payload) == 0)
+        {
+            break;
+        }
+        if (len >= OPT300XD_PROTOCOL_HEADER_SIZE)
+        {
+            return 1;
+        }
+    }
+    if (*payload > OPT300XD_PROTOCOL_MAX_FRAME - OPT300XD_PROTOCOL_HEADER_SIZE)
+    {
+        return 1;
+    }
+    while (len < OPT300XD_PROTOCOL_HEADER_SIZE + *payload)
+    {
+        ssize_t n = read(fd, &buf[len], (size_t)(OPT300XD_PROTOCOL_HEADER_SIZE + *payload - len));
+        
+        if (n <= 0)
+        {
+            return 1;
+        }
+        len = (uint16_t)(len + n);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  protocol test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   none
+ */
+uint8_t opt300xd_protocol_test(void)
+{
+    uint8_t res;
+    uint8_t type;
+    uint16_t payload;
+    uint16_t len;
+    int fd[2];
+    static uint8_t buf[OPT300XD_PROTOCOL_MAX_FRAME];
+    opt300xd_subscribe_t subscribe;
+    opt300xd_subscribe_t subscribe_check;
+    opt300xd_ack_t ack;
+    opt300xd_ack_t ack_check;
+    static opt300xd_batch_t batch;
+    static opt300xd_batch_t batch_check;
+    
+    /* start protocol test */
+    opt300x_interface_debug_print("opt300x: start protocol test.\n");
+    
+    /* opt300xd_protocol_parse_header test */
+    opt300x_interface_debug_print("opt300x: opt300xd_protocol_parse_header test.\n");
+    subscribe.mask = 0x05;
+    subscribe.batch = 8;
+    subscribe.interval_ms = 1000;
+    len = opt300xd_protocol_pack_subscribe(OPT300XD_MESSAGE_SUBSCRIBE, &subscribe, buf);
+    opt300x_interface_debug_print("opt300x: check subscribe frame length %s.\n",
+                                  (len == OPT300XD_PROTOCOL_HEADER_SIZE + OPT300XD_PROTOCOL_SUBSCRIBE_SIZE) ? "ok" : "error");
+    if (len != OPT300XD_PROTOCOL_HEADER_SIZE + OPT300XD_PROTOCOL_SUBSCRIBE_SIZE)
+    {
+        return 1;
+    }
+    res = opt300xd_protocol_parse_header(buf, OPT300XD_PROTOCOL_HEADER_SIZE - 1, &type, &payload);
+    opt300x_interface_debug_print("opt300x: check incomplete header %s.\n", (res == 1) ? "ok" : "error");
+    if (res != 1)
+    {
+        return 1;
+    }
+    buf[1] = OPT300XD_PROTOCOL_VERSION + 1;
+    res = opt300xd_protocol_parse_header(buf, len, &type, &payload);
+    opt300x_interface_debug_print("opt300x: check invalid version %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    buf[1] = OPT300XD_PROTOCOL_VERSION;
+    res = opt300xd_protocol_parse_header(buf, len, &type, &payload);
+    res = ((res == 0) && (type == OPT300XD_MESSAGE_SUBSCRIBE) && (payload == OPT300XD_PROTOCOL_SUBSCRIBE_SIZE)) ? 0 : 1;
+    opt300x_interface_debug_print("opt300x: check header %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* opt300xd_protocol_unpack_subscribe test */
+    opt300x_interface_debug_print("opt300x: opt300xd_protocol_unpack_subscribe test.\n");
+    res = opt300xd_protocol_unpack_subscribe(&buf[OPT300XD_PROTOCOL_HEADER_SIZE], payload - 1, &subscribe_check);
+    opt300x_interface_debug_print("opt300x: check invalid length %s.\n", (res == 1) ? "ok" : "error");
+    if (res != 1)
+    {
+        return 1;
+    }
+    res = opt300xd_protocol_unpack_subscribe(&buf[OPT300XD_PROTOCOL_HEADER_SIZE], payload, &subscribe_check);
+    res = ((res == 0) && (subscribe_check.mask == 0x05) && (subscribe_check.batch == 8) &&
+           (subscribe_check.interval_ms == 1000)) ? 0 : 1;
+    opt300x_interface_debug_print("opt300x: check subscribe %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* opt300xd_protocol_unpack_ack test */
+    opt300x_interface_debug_print("opt300x: opt300xd_protocol_unpack_ack test.\n");
+    memset(&ack, 0, sizeof(opt300xd_ack_t));
+    ack.status = 1;
+    ack.batch = 8;
+    ack.num = 2;
+    ack.sensor[0].index = 0;
+    ack.sensor[0].type = OPT3001;
+    ack.sensor[0].addr = OPT300X_ADDRESS_GND;
+    ack.sensor[0].subscribed = 1;
+    ack.sensor[0].sample_ms = 100;
+    ack.sensor[0].interval_ms = 1000;
+    ack.sensor[1].index = 1;
+    ack.sensor[1].type = OPT3002;
+    ack.sensor[1].addr = OPT300X_ADDRESS_VCC;
+    ack.sensor[1].subscribed = 0;
+    ack.sensor[1].sample_ms = 800;
+    ack.sensor[1].interval_ms = 0;
+    len = opt300xd_protocol_pack_ack(&ack, buf);
+    payload = (uint16_t)(len - OPT300XD_PROTOCOL_HEADER_SIZE);
+    res = opt300xd_protocol_unpack_ack(&buf[OPT300XD_PROTOCOL_HEADER_SIZE], payload - 1, &ack_check);
+    opt300x_interface_debug_print("opt300x: check invalid length %s.\n", (res == 1) ? "ok" : "error");
+    if (res != 1)
+    {
+        return 1;
+    }
+    buf[OPT300XD_PROTOCOL_HEADER_SIZE + 2] = OPT300XD_PROTOCOL_MAX_SENSOR + 1;
+    res = opt300xd_protocol_unpack_ack(&buf[OPT300XD_PROTOCOL_HEADER_SIZE], payload, &ack_check);
+    opt300x_interface_debug_print("opt300x: check too many sensors %s.\n", (res == 1) ? "ok" : "error");
+    if (res != 1)
+    {
+        return 1;
+    }
+    buf[OPT300XD_PROTOCOL_HEADER_SIZE + 2] = 2;
+    res = opt300xd_protocol_unpack_ack(&buf[OPT300XD_PROTOCOL_HEADER_SIZE], payload, &ack_check);
+    res = ((res == 0) && (ack_check.status == 1) && (ack_check.batch == 8) && (ack_check.num == 2) &&
+           (memcmp(ack_check.sensor, ack.sensor, 2 * sizeof(opt300xd_sensor_t)) == 0)) ? 0 : 1;
+    opt300x_interface_debug_print("opt300x: check ack %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* opt300xd_protocol_unpack_batch test */
+    opt300x_interface_debug_print("opt300x: opt300xd_protocol_unpack_batch test.\n");
+    memset(&batch, 0, sizeof(opt300xd_batch_t));
+    batch.timestamp_us = 0x0123456789ABCDEFULL;
+    batch.dropped = 7;
+    batch.num = OPT300XD_PROTOCOL_MAX_BATCH;
+    for (len = 0; len < OPT300XD_PROTOCOL_MAX_BATCH; len++)
+    {
+        batch.sample[len].sensor = (uint8_t)(len % OPT300XD_PROTOCOL_MAX_SENSOR);
+        batch.sample[len].status = (uint8_t)(((len % 3) == 0) ? 0 : (((len % 3) == 1) ? 4 : 1));
+        batch.sample[len].raw = (uint16_t)((batch.sample[len].status == 4) ? 0xBFFF :
+                                           ((batch.sample[len].status == 1) ? 0 : (0x1000 + len)));
+        batch.sample[len].offset_us = (uint32_t)len * 100000U;
+    }
+    len = opt300xd_protocol_pack_batch(&batch, buf);
+    opt300x_interface_debug_print("opt300x: check full batch length %s.\n", (len == OPT300XD_PROTOCOL_MAX_FRAME) ? "ok" : "error");
+    if (len != OPT300XD_PROTOCOL_MAX_FRAME)
+    {
+        return 1;
+    }
+    payload = (uint16_t)(len - OPT300XD_PROTOCOL_HEADER_SIZE);
+    res = opt300xd_protocol_unpack_batch(&buf[OPT300XD_PROTOCOL_HEADER_SIZE], payload - OPT300XD_PROTOCOL_SAMPLE_SIZE, &batch_check);
+    opt300x_interface_debug_print("opt300x: check invalid length %s.\n", (res == 1) ? "ok" : "error");
+    if (res != 1)
+    {
+        return 1;
+    }
+    res = opt300xd_protocol_unpack_batch(&buf[OPT300XD_PROTOCOL_HEADER_SIZE], payload, &batch_check);
+    res = ((res == 0) && (batch_check.timestamp_us == batch.timestamp_us) && (batch_check.dropped == 7) &&
+           (batch_check.num == batch.num) &&
+           (memcmp(batch_check.sample, batch.sample, batch.num * sizeof(opt300xd_sample_t)) == 0)) ? 0 : 1;
+    opt300x_interface_debug_print("opt300x: check batch %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* opt300xd_protocol_convert test */
+    opt300x_interface_debug_print("opt300x: opt300xd_protocol_convert test.\n");
+    res = (fabsf(opt300xd_protocol_convert(OPT3001, 0xBFFF) - 83865.6f) < 0.1f) ? 0 : 1;
+    opt300x_interface_debug_print("opt300x: check opt3001 full scale %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* client and daemon exchange test */
+    opt300x_interface_debug_print("opt300x: client and daemon exchange test.\n");
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fd) != 0)
+    {
+        opt300x_interface_debug_print("opt300x: socketpair failed.\n");
+        
+        return 1;
+    }
+    res = 1;
+    
+    /* the client subscribes in two writes, split inside the header */
+    len = opt300xd_protocol_pack_subscribe(OPT300XD_MESSAGE_SUBSCRIBE, &subscribe, buf);
+    if ((a_opt300xd_protocol_test_write(fd[0], buf, 2) != 0) ||
+        (a_opt300xd_protocol_test_write(fd[0], &buf[2], (uint16_t)(len - 2)) != 0))
+    {
+        goto exit;
+    }
+    
+    /* the daemon reads the frame and grants it */
+    memset(buf, 0, sizeof(buf));
+    if ((a_opt300xd_protocol_test_read(fd[1], buf, &type, &payload) != 0) || (type != OPT300XD_MESSAGE_SUBSCRIBE) ||
+        (opt300xd_protocol_unpack_subscribe(&buf[OPT300XD_PROTOCOL_HEADER_SIZE], payload, &subscribe_check) != 0) ||
+        (subscribe_check.mask != subscribe.mask))
+    {
+        opt300x_interface_debug_print("opt300x: check daemon subscribe %s.\n", "error");
+        
+        goto exit;
+    }
+    opt300x_interface_debug_print("opt300x: check daemon subscribe %s.\n", "ok");
+    ack.status = 0;
+    ack.batch = subscribe_check.batch;
+    len = opt300xd_protocol_pack_ack(&ack, buf);
+    if (a_opt300xd_protocol_test_write(fd[1], buf, len) != 0)
+    {
+        goto exit;
+    }
+    
+    /* the daemon sends a batch with a good, an overflowed and a failed sample */
+    batch.num = 3;
+    len = opt300xd_protocol_pack_batch(&batch, buf);
+    if (a_opt300xd_protocol_test_write(fd[1], buf, len) != 0)
+    {
+        goto exit;
+    }
+    
+    /* the client reads the ack and the batch */
+    memset(buf, 0, sizeof(buf));
+    if ((a_opt300xd_protocol_test_read(fd[0], buf, &type, &payload) != 0) || (type != OPT300XD_MESSAGE_ACK) ||
+        (opt300xd_protocol_unpack_ack(&buf[OPT300XD_PROTOCOL_HEADER_SIZE], payload, &ack_check) != 0) ||
+        (ack_check.status != 0) || (ack_check.batch != 8) || (ack_check.sensor[0].interval_ms != 1000))
+    {
+        opt300x_interface_debug_print("opt300x: check client ack %s.\n", "error");
+        
+        goto exit;
+    }
+    opt300x_interface_debug_print("opt300x: check client ack %s.\n", "ok");
+    memset(buf, 0, sizeof(buf));
+    if ((a_opt300xd_protocol_test_read(fd[0], buf, &type, &payload) != 0) || (type != OPT300XD_MESSAGE_BATCH) ||
+        (opt300xd_protocol_unpack_batch(&buf[OPT300XD_PROTOCOL_HEADER_SIZE], payload, &batch_check) != 0) ||
+        (batch_check.num != 3) ||
+        (batch_check.sample[0].status != 0) || (batch_check.sample[0].raw != 0x1000) ||
+        (batch_check.sample[1].status != 4) || (batch_check.sample[1].raw != 0xBFFF) ||
+        (batch_check.sample[2].status != 1) || (batch_check.sample[2].raw != 0))
+    {
+        opt300x_interface_debug_print("opt300x: check client batch %s.\n", "error");
+        
+        goto exit;
+    }
+    opt300x_interface_debug_print("opt300x: check client batch %s.\n", "ok");
+    res = 0;
+    
+    exit:
+    (void)close(fd[0]);
+    (void)close(fd[1]);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* finish protocol test */
+    opt300x_interface_debug_print("opt300x: finish protocol test.\n");
+    
+    return 0;
+}
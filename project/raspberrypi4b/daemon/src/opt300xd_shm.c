@@ -0,0 +1,538 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      opt300xd_shm.c
+ * @brief     opt300xd shared memory source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "opt300xd_shm.h"
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief shared memory definition
+ */
+#define SHM_MAX_RETRY        1000        /**< max retries of one slot */
+
+/**
+ * @brief shared memory header structure definition
+ */
+typedef struct shm_header_s
+{
+    uint32_t magic;                /**< magic, written last */
+    uint32_t version;              /**< layout version */
+    uint32_t sensor_num;           /**< sensor numbers */
+    uint32_t depth;                /**< ring depth */
+    uint32_t slot_size;            /**< slot size */
+    uint32_t reserved[11];         /**< pad to 64 bytes */
+} shm_header_t;
+
+/**
+ * @brief shared memory sensor structure definition
+ */
+typedef struct shm_sensor_s
+{
+    uint64_t count;                /**< published samples */
+    uint32_t sample_ms;            /**< sampling interval */
+    uint8_t type;                  /**< chip type */
+    uint8_t addr;                  /**< address pin */
+    uint8_t reserved[50];          /**< pad to 64 bytes */
+} shm_sensor_t;
+
+/**
+ * @brief shared memory slot structure definition
+ */
+typedef struct shm_slot_s
+{
+    uint32_t seq;                  /**< sequence, odd while the writer updates the slot */
+    uint32_t data;                 /**< converted data bits */
+    uint64_t index;                /**< sample index */
+    uint64_t timestamp_us;         /**< sample timestamp */
+    uint16_t raw;                  /**< raw data */
+    uint8_t status;                /**< read status */
+    uint8_t reserved[5];           /**< pad to 32 bytes */
+} shm_slot_t;
+
+/**
+ * @brief     get the header
+ * @param[in] *shm pointer to a shared memory handle
+ * @return    pointer to the header
+ * @note      none
+ */
+static shm_header_t *a_shm_header(opt300xd_shm_t *shm)
+{
+    return (shm_header_t *)shm->base;
+}
+
+/**
+ * @brief     get a sensor block
+ * @param[in] *shm pointer to a shared memory handle
+ * @param[in] sensor sensor index
+ * @return    pointer to the sensor block
+ * @note      none
+ */
+static shm_sensor_t *a_shm_sensor(opt300xd_shm_t *shm, uint8_t sensor)
+{
+    return (shm_sensor_t *)(shm->base + sizeof(shm_header_t)) + sensor;
+}
+
+/**
+ * @brief     get a slot
+ * @param[in] *shm pointer to a shared memory handle
+ * @param[in] sensor sensor index
+ * @param[in] index sample index
+ * @return    pointer to the slot
+ * @note      none
+ */
+static shm_slot_t *a_shm_slot(opt300xd_shm_t *shm, uint8_t sensor, uint64_t index)
+{
+    shm_slot_t *slot = (shm_slot_t *)(shm->base + sizeof(shm_header_t) + OPT300XD_SHM_MAX_SENSOR * sizeof(shm_sensor_t));
+    
+    return &slot[(size_t)sensor * shm->depth + (size_t)(index & (shm->depth - 1))];
+}
+
+/**
+ * @brief     get the file size
+ * @param[in] num sensor numbers
+ * @param[in] depth ring depth
+ * @return    file size
+ * @note      none
+ */
+static size_t a_shm_size(uint32_t num, uint32_t depth)
+{
+    return sizeof(shm_header_t) + OPT300XD_SHM_MAX_SENSOR * sizeof(shm_sensor_t) + (size_t)num * depth * sizeof(shm_slot_t);
+}
+
+/**
+ * @brief      read one slot once
+ * @param[in]  *slot pointer to a slot
+ * @param[out] *sample pointer to a sample buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 the writer updated the slot meanwhile
+ * @note       none
+ */
+static uint8_t a_shm_read_slot(shm_slot_t *slot, opt300xd_shm_sample_t *sample)
+{
+    uint32_t seq;
+    uint32_t data;
+    
+    seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);                                /* sequence before */
+    if ((seq & 1) != 0)                                                                 /* writer is updating */
+    {
+        return 1;                                                                       /* return error */
+    }
+    data = __atomic_load_n(&slot->data, __ATOMIC_RELAXED);                              /* copy the data */
+    sample->index = __atomic_load_n(&slot->index, __ATOMIC_RELAXED);                    /* copy the index */
+    sample->timestamp_us = __atomic_load_n(&slot->timestamp_us, __ATOMIC_RELAXED);      /* copy the timestamp */
+    sample->raw = __atomic_load_n(&slot->raw, __ATOMIC_RELAXED);                        /* copy the raw data */
+    sample->status = __atomic_load_n(&slot->status, __ATOMIC_RELAXED);                  /* copy the status */
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);                                            /* order the copies before the check */
+    if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) != seq)                           /* sequence after */
+    {
+        return 1;                                                                       /* return error */
+    }
+    memcpy(&sample->data, &data, sizeof(float));                                        /* convert the data */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     create the shared memory as the writer
+ * @param[in] *shm pointer to a shared memory handle
+ * @param[in] *path pointer to a file path
+ * @param[in] *info pointer to a sensor info buffer
+ * @param[in] num sensor numbers
+ * @param[in] depth ring depth, a power of 2
+ * @return    status code
+ *            - 0 success
+ *            - 1 create failed
+ *            - 2 handle is NULL
+ *            - 4 param is invalid
+ * @note      the file is created or replaced, there must be only one writer
+ */
+uint8_t opt300xd_shm_create(opt300xd_shm_t *shm, const char *path, const opt300xd_shm_info_t *info, uint8_t num, uint32_t depth)
+{
+    uint8_t i;
+    void *base;
+    shm_header_t *header;
+    
+    if (shm == NULL)                                                                    /* check shm */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if ((num == 0) || (num > OPT300XD_SHM_MAX_SENSOR) ||
+        (depth == 0) || ((depth & (depth - 1)) != 0))                                   /* check the param */
+    {
+        return 4;                                                                       /* return error */
+    }
+    
+    (void)unlink(path);                                                                 /* old readers keep the old file */
+    shm->fd = open(path, O_RDWR | O_CREAT | O_EXCL, 0644);                              /* create the file */
+    if (shm->fd < 0)                                                                    /* check the result */
+    {
+        return 1;                                                                       /* return error */
+    }
+    shm->size = a_shm_size(num, depth);                                                 /* get the size */
+    if (ftruncate(shm->fd, (off_t)shm->size) != 0)                                      /* size the file */
+    {
+        (void)close(shm->fd);                                                           /* close the file */
+        
+        return 1;                                                                       /* return error */
+    }
+    base = mmap(NULL, shm->size, PROT_READ | PROT_WRITE, MAP_SHARED, shm->fd, 0);       /* map the file */
+    if (base == MAP_FAILED)                                                             /* check the result */
+    {
+        (void)close(shm->fd);                                                           /* close the file */
+        
+        return 1;                                                                       /* return error */
+    }
+    shm->base = (uint8_t *)base;                                                        /* save the base */
+    shm->writer = 1;                                                                    /* writer */
+    shm->depth = depth;                                                                 /* save the depth */
+    shm->sensor_num = num;                                                              /* save the sensor numbers */
+    shm->retry = 0;                                                                     /* init 0 */
+    for (i = 0; i < num; i++)                                                           /* set the sensors */
+    {
+        a_shm_sensor(shm, i)->type = info[i].type;                                      /* set the type */
+        a_shm_sensor(shm, i)->addr = info[i].addr;                                      /* set the addr */
+        a_shm_sensor(shm, i)->sample_ms = info[i].sample_ms;                            /* set the interval */
+    }
+    header = a_shm_header(shm);                                                         /* get the header */
+    header->version = OPT300XD_SHM_VERSION;                                             /* set the version */
+    header->sensor_num = num;                                                           /* set the sensor numbers */
+    header->depth = depth;                                                              /* set the depth */
+    header->slot_size = sizeof(shm_slot_t);                                             /* set the slot size */
+    __atomic_store_n(&header->magic, OPT300XD_SHM_MAGIC, __ATOMIC_RELEASE);             /* publish the layout */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     publish one sample
+ * @param[in] *shm pointer to a shared memory handle
+ * @param[in] sensor sensor index
+ * @param[in] *sample pointer to a sample, the index is assigned by the writer
+ * @return    status code
+ *            - 0 success
+ *            - 1 publish failed
+ *            - 2 handle is NULL
+ *            - 4 sensor is invalid
+ * @note      wait free, never blocks on the readers
+ */
+uint8_t opt300xd_shm_publish(opt300xd_shm_t *shm, uint8_t sensor, const opt300xd_shm_sample_t *sample)
+{
+    uint32_t seq;
+    uint32_t data;
+    uint64_t count;
+    shm_slot_t *slot;
+    shm_sensor_t *block;
+    
+    if (shm == NULL)                                                                    /* check shm */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (shm->writer == 0)                                                               /* check the writer */
+    {
+        return 1;                                                                       /* return error */
+    }
+    if (sensor >= shm->sensor_num)                                                      /* check the sensor */
+    {
+        return 4;                                                                       /* return error */
+    }
+    
+    block = a_shm_sensor(shm, sensor);                                                  /* get the sensor block */
+    count = __atomic_load_n(&block->count, __ATOMIC_RELAXED);                           /* only the writer changes it */
+    slot = a_shm_slot(shm, sensor, count);                                              /* get the slot */
+    memcpy(&data, &sample->data, sizeof(float));                                        /* convert the data */
+    seq = __atomic_load_n(&slot->seq, __ATOMIC_RELAXED);                                /* get the sequence */
+    __atomic_store_n(&slot->seq, seq + 1, __ATOMIC_RELAXED);                            /* mark the slot busy */
+    __atomic_thread_fence(__ATOMIC_RELEASE);                                            /* order the mark before the copies */
+    __atomic_store_n(&slot->data, data, __ATOMIC_RELAXED);                              /* copy the data */
+    __atomic_store_n(&slot->index, count, __ATOMIC_RELAXED);                            /* copy the index */
+    __atomic_store_n(&slot->timestamp_us, sample->timestamp_us, __ATOMIC_RELAXED);      /* copy the timestamp */
+    __atomic_store_n(&slot->raw, sample->raw, __ATOMIC_RELAXED);                        /* copy the raw data */
+    __atomic_store_n(&slot->status, sample->status, __ATOMIC_RELAXED);                  /* copy the status */
+    __atomic_store_n(&slot->seq, seq + 2, __ATOMIC_RELEASE);                            /* mark the slot stable */
+    __atomic_store_n(&block->count, count + 1, __ATOMIC_RELEASE);                       /* publish the sample */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     open the shared memory as a reader
+ * @param[in] *shm pointer to a shared memory handle
+ * @param[in] *path pointer to a file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 2 handle is NULL
+ *            - 4 layout is invalid
+ * @note      the mapping is read only
+ */
+uint8_t opt300xd_shm_open(opt300xd_shm_t *shm, const char *path)
+{
+    void *base;
+    struct stat st;
+    shm_header_t *header;
+    
+    if (shm == NULL)                                                                    /* check shm */
+    {
+        return 2;                                                                       /* return error */
+    }
+    
+    shm->fd = open(path, O_RDONLY);                                                     /* open the file */
+    if (shm->fd < 0)                                                                    /* check the result */
+    {
+        return 1;                                                                       /* return error */
+    }
+    if ((fstat(shm->fd, &st) != 0) || ((size_t)st.st_size < a_shm_size(0, 0)))         /* check the size */
+    {
+        (void)close(shm->fd);                                                           /* close the file */
+        
+        return 1;                                                                       /* return error */
+    }
+    shm->size = (size_t)st.st_size;                                                     /* save the size */
+    base = mmap(NULL, shm->size, PROT_READ, MAP_SHARED, shm->fd, 0);                    /* map the file */
+    if (base == MAP_FAILED)                                                             /* check the result */
+    {
+        (void)close(shm->fd);                                                           /* close the file */
+        
+        return 1;                                                                       /* return error */
+    }
+    shm->base = (uint8_t *)base;                                                        /* save the base */
+    header = a_shm_header(shm);                                                         /* get the header */
+    if ((__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != OPT300XD_SHM_MAGIC) ||
+        (header->version != OPT300XD_SHM_VERSION) ||
+        (header->slot_size != sizeof(shm_slot_t)) ||
+        (header->sensor_num == 0) || (header->sensor_num > OPT300XD_SHM_MAX_SENSOR) ||
+        (header->depth == 0) || ((header->depth & (header->depth - 1)) != 0) ||
+        (a_shm_size(header->sensor_num, header->depth) != shm->size))                   /* check the layout */
+    {
+        (void)munmap(base, shm->size);                                                  /* unmap the file */
+        (void)close(shm->fd);                                                           /* close the file */
+        
+        return 4;                                                                       /* return error */
+    }
+    shm->writer = 0;                                                                    /* reader */
+    shm->depth = header->depth;                                                         /* save the depth */
+    shm->sensor_num = (uint8_t)header->sensor_num;                                      /* save the sensor numbers */
+    shm->retry = 0;                                                                     /* init 0 */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     close the shared memory
+ * @param[in] *shm pointer to a shared memory handle
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ *            - 2 handle is NULL
+ * @note      the writer leaves the file for the readers
+ */
+uint8_t opt300xd_shm_close(opt300xd_shm_t *shm)
+{
+    uint8_t res = 0;
+    
+    if (shm == NULL)                                                                    /* check shm */
+    {
+        return 2;                                                                       /* return error */
+    }
+    
+    if (munmap(shm->base, shm->size) != 0)                                              /* unmap the file */
+    {
+        res = 1;                                                                        /* set error */
+    }
+    if (close(shm->fd) != 0)                                                            /* close the file */
+    {
+        res = 1;                                                                        /* set error */
+    }
+    shm->base = NULL;                                                                   /* clear the base */
+    shm->fd = -1;                                                                       /* clear the fd */
+    
+    return res;                                                                         /* return the result */
+}
+
+/**
+ * @brief      get the sensor info
+ * @param[in]  *shm pointer to a shared memory handle
+ * @param[in]  sensor sensor index
+ * @param[out] *info pointer to a sensor info buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 sensor is invalid
+ * @note       none
+ */
+uint8_t opt300xd_shm_get_info(opt300xd_shm_t *shm, uint8_t sensor, opt300xd_shm_info_t *info)
+{
+    if (shm == NULL)                                                                    /* check shm */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (sensor >= shm->sensor_num)                                                      /* check the sensor */
+    {
+        return 4;                                                                       /* return error */
+    }
+    
+    info->type = a_shm_sensor(shm, sensor)->type;                                       /* get the type */
+    info->addr = a_shm_sensor(shm, sensor)->addr;                                       /* get the addr */
+    info->sample_ms = a_shm_sensor(shm, sensor)->sample_ms;                             /* get the interval */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      read the latest sample
+ * @param[in]  *shm pointer to a shared memory handle
+ * @param[in]  sensor sensor index
+ * @param[out] *sample pointer to a sample buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 4 sensor is invalid
+ *             - 5 no sample is published
+ * @note       lock free, retries while the writer updates the slot
+ */
+uint8_t opt300xd_shm_read_latest(opt300xd_shm_t *shm, uint8_t sensor, opt300xd_shm_sample_t *sample)
+{
+    uint32_t i;
+    uint64_t count;
+    shm_sensor_t *block;
+    
+    if (shm == NULL)                                                                    /* check shm */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (sensor >= shm->sensor_num)                                                      /* check the sensor */
+    {
+        return 4;                                                                       /* return error */
+    }
+    
+    block = a_shm_sensor(shm, sensor);                                                  /* get the sensor block */
+    for (i = 0; i < SHM_MAX_RETRY; i++)                                                 /* retry on concurrent writes */
+    {
+        count = __atomic_load_n(&block->count, __ATOMIC_ACQUIRE);                       /* get the published samples */
+        if (count == 0)                                                                 /* check the count */
+        {
+            return 5;                                                                   /* return error */
+        }
+        if ((a_shm_read_slot(a_shm_slot(shm, sensor, count - 1), sample) == 0) &&
+            (sample->index >= count - 1))                                               /* a stable slot no older than the count */
+        {
+            return 0;                                                                   /* success return 0 */
+        }
+        shm->retry++;                                                                   /* count the retry */
+    }
+    
+    return 1;                                                                           /* return error */
+}
+
+/**
+ * @brief         read the samples published after a cursor
+ * @param[in]     *shm pointer to a shared memory handle
+ * @param[in]     sensor sensor index
+ * @param[in,out] *cursor pointer to the next sample index, updated after reading
+ * @param[out]    *sample pointer to a sample buffer
+ * @param[in,out] *len pointer to a sample buffer length, returns the read samples
+ * @param[out]    *lost pointer to a lost samples buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ *                - 4 sensor is invalid
+ * @note          samples overwritten before they are read are counted in lost
+ */
+uint8_t opt300xd_shm_read_recent(opt300xd_shm_t *shm, uint8_t sensor, uint64_t *cursor,
+                                 opt300xd_shm_sample_t *sample, uint32_t *len, uint64_t *lost)
+{
+    uint32_t n = 0;
+    uint32_t retry = 0;
+    uint64_t count;
+    shm_sensor_t *block;
+    
+    if (shm == NULL)                                                                    /* check shm */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (sensor >= shm->sensor_num)                                                      /* check the sensor */
+    {
+        return 4;                                                                       /* return error */
+    }
+    
+    *lost = 0;                                                                          /* init 0 */
+    block = a_shm_sensor(shm, sensor);                                                  /* get the sensor block */
+    count = __atomic_load_n(&block->count, __ATOMIC_ACQUIRE);                           /* get the published samples */
+    if (*cursor > count)                                                                /* the writer restarted */
+    {
+        *cursor = count;                                                                /* follow the writer */
+    }
+    if (count - *cursor > shm->depth)                                                   /* the oldest are overwritten */
+    {
+        *lost = count - shm->depth - *cursor;                                           /* count them */
+        *cursor = count - shm->depth;                                                   /* skip them */
+    }
+    while ((*cursor < count) && (n < *len))                                             /* read the samples */
+    {
+        if (a_shm_read_slot(a_shm_slot(shm, sensor, *cursor), &sample[n]) != 0)         /* the writer updates the slot */
+        {
+            shm->retry++;                                                               /* count the retry */
+            if ((++retry < SHM_MAX_RETRY) &&
+                (__atomic_load_n(&block->count, __ATOMIC_ACQUIRE) - *cursor < shm->depth))  /* not lapped by the writer */
+            {
+                continue;                                                               /* try again */
+            }
+        }
+        else if (sample[n].index == *cursor)                                            /* the wanted sample */
+        {
+            n++;                                                                        /* keep it */
+            (*cursor)++;                                                                /* step the cursor */
+            retry = 0;                                                                  /* reset the retries */
+            
+            continue;                                                                   /* next */
+        }
+        else
+        {
+            /* overwritten by a newer sample */
+        }
+        (*lost)++;                                                                      /* count the lost sample */
+        (*cursor)++;                                                                    /* step the cursor */
+        retry = 0;                                                                      /* reset the retries */
+    }
+    *len = n;                                                                           /* save the read samples */
+    
+    return 0;                                                                           /* success return 0 */
+}
@@ -0,0 +1,323 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      opt300xd_shm_bench.c
+ * @brief     opt300xd shared memory benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "opt300xd_shm.h"
+#include <getopt.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief bench definition
+ */
+#define BENCH_MAX_READER        16          /**< max reader threads */
+#define BENCH_BATCH             64          /**< recent mode buffer length */
+
+/**
+ * @brief bench reader structure definition
+ */
+typedef struct bench_reader_s
+{
+    pthread_t thread;            /**< thread */
+    uint8_t recent;              /**< recent mode flag */
+    uint64_t read;               /**< read samples */
+    uint64_t retry;              /**< retries */
+    uint64_t torn;               /**< inconsistent samples, must be 0 */
+    uint64_t lost;               /**< overwritten samples in recent mode */
+} bench_reader_t;
+
+/**
+ * @brief bench var definition
+ */
+static const char *gs_path = "/dev/shm/opt300xd_bench";        /**< file path */
+static volatile int gs_run;                                    /**< run flag */
+static uint32_t gs_rate;                                       /**< writer rate, 0 is full speed */
+static uint64_t gs_published;                                  /**< published samples */
+
+/**
+ * @brief  get the monotonic time
+ * @return time in ns
+ * @note   none
+ */
+static uint64_t a_bench_now_ns(void)
+{
+    struct timespec t;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &t);
+    
+    return (uint64_t)t.tv_sec * 1000000000ULL + (uint64_t)t.tv_nsec;
+}
+
+/**
+ * @brief     check a sample against the writer pattern
+ * @param[in] *s pointer to a sample
+ * @return    1 if the sample is consistent
+ * @note      none
+ */
+static int a_bench_valid(const opt300xd_shm_sample_t *s)
+{
+    return (s->timestamp_us == s->index * 7 + 1) && (s->raw == (uint16_t)s->index) &&
+           (s->data == (float)(s->index & 0xFFFF));
+}
+
+/**
+ * @brief     writer thread
+ * @param[in] *arg pointer to a shared memory handle
+ * @return    NULL
+ * @note      publishes a pattern the readers can verify
+ */
+static void *a_bench_writer(void *arg)
+{
+    opt300xd_shm_t *shm = (opt300xd_shm_t *)arg;
+    opt300xd_shm_sample_t s;
+    uint64_t n = 0;
+    uint64_t start = a_bench_now_ns();
+    
+    memset(&s, 0, sizeof(s));
+    while (__atomic_load_n(&gs_run, __ATOMIC_RELAXED) != 0)
+    {
+        if ((gs_rate != 0) && (n * 1000000000ULL > (a_bench_now_ns() - start) * gs_rate))
+        {
+            continue;
+        }
+        s.timestamp_us = n * 7 + 1;
+        s.raw = (uint16_t)n;
+        s.data = (float)(n & 0xFFFF);
+        (void)opt300xd_shm_publish(shm, 0, &s);
+        n++;
+    }
+    gs_published = n;
+    
+    return NULL;
+}
+
+/**
+ * @brief     reader thread
+ * @param[in] *arg pointer to a reader structure
+ * @return    NULL
+ * @note      every reader maps the file on its own like a separate process
+ */
+static void *a_bench_reader(void *arg)
+{
+    bench_reader_t *r = (bench_reader_t *)arg;
+    opt300xd_shm_t shm;
+    opt300xd_shm_sample_t s[BENCH_BATCH];
+    uint64_t cursor = 0;
+    uint64_t lost;
+    uint32_t len;
+    uint32_t i;
+    
+    if (opt300xd_shm_open(&shm, gs_path) != 0)
+    {
+        printf("opt300xd_shm_bench: open failed.\n");
+        
+        return NULL;
+    }
+    while (__atomic_load_n(&gs_run, __ATOMIC_RELAXED) != 0)
+    {
+        if (r->recent == 0)
+        {
+            if (opt300xd_shm_read_latest(&shm, 0, &s[0]) != 0)
+            {
+                continue;
+            }
+            r->read++;
+            r->torn += (a_bench_valid(&s[0]) != 0) ? 0 : 1;
+        }
+        else
+        {
+            len = BENCH_BATCH;
+            (void)opt300xd_shm_read_recent(&shm, 0, &cursor, s, &len, &lost);
+            r->read += len;
+            r->lost += lost;
+            for (i = 0; i < len; i++)
+            {
+                r->torn += (a_bench_valid(&s[i]) != 0) ? 0 : 1;
+            }
+        }
+    }
+    r->retry = shm.retry;
+    (void)opt300xd_shm_close(&shm);
+    
+    return NULL;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    uint32_t i;
+    uint32_t readers = 2;
+    uint32_t seconds = 3;
+    uint32_t depth = OPT300XD_SHM_DEFAULT_DEPTH;
+    uint8_t recent = 0;
+    uint64_t total = 0;
+    uint64_t start;
+    double elapsed;
+    pthread_t writer;
+    opt300xd_shm_t shm;
+    opt300xd_shm_info_t info = {0x01, 0x88, 100};
+    static bench_reader_t reader[BENCH_MAX_READER];
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"readers", required_argument, NULL, 1},
+        {"seconds", required_argument, NULL, 2},
+        {"rate", required_argument, NULL, 3},
+        {"depth", required_argument, NULL, 4},
+        {"mode", required_argument, NULL, 5},
+        {"path", required_argument, NULL, 6},
+        {NULL, 0, NULL, 0},
+    };
+    
+    /* parse */
+    do
+    {
+        c = getopt_long(argc, argv, "h", long_options, &longindex);
+        switch (c)
+        {
+            case 1 :
+            {
+                readers = (uint32_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            case 2 :
+            {
+                seconds = (uint32_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            case 3 :
+            {
+                gs_rate = (uint32_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            case 4 :
+            {
+                depth = (uint32_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            case 5 :
+            {
+                recent = (strcmp(optarg, "recent") == 0) ? 1 : 0;
+                
+                break;
+            }
+            case 6 :
+            {
+                gs_path = optarg;
+                
+                break;
+            }
+            case -1 :
+            {
+                break;
+            }
+            default :
+            {
+                printf("Usage:\n");
+                printf("  opt300xd_shm_bench [--readers=<num>] [--seconds=<num>] [--rate=<hz>] [--depth=<num>]");
+                printf(" [--mode=<latest | recent>] [--path=<path>]\n");
+                
+                return (c == 'h') ? 0 : 1;
+            }
+        }
+    } while (c != -1);
+    if ((readers == 0) || (readers > BENCH_MAX_READER))
+    {
+        printf("opt300xd_shm_bench: readers is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* create the file */
+    if (opt300xd_shm_create(&shm, gs_path, &info, 1, depth) != 0)
+    {
+        printf("opt300xd_shm_bench: create %s failed.\n", gs_path);
+        
+        return 1;
+    }
+    
+    /* run the writer and the readers */
+    gs_run = 1;
+    start = a_bench_now_ns();
+    (void)pthread_create(&writer, NULL, a_bench_writer, &shm);
+    for (i = 0; i < readers; i++)
+    {
+        reader[i].recent = recent;
+        (void)pthread_create(&reader[i].thread, NULL, a_bench_reader, &reader[i]);
+    }
+    (void)sleep(seconds);
+    __atomic_store_n(&gs_run, 0, __ATOMIC_RELAXED);
+    (void)pthread_join(writer, NULL);
+    for (i = 0; i < readers; i++)
+    {
+        (void)pthread_join(reader[i].thread, NULL);
+    }
+    elapsed = (double)(a_bench_now_ns() - start) / 1e9;
+    
+    /* output */
+    printf("opt300xd_shm_bench: %s mode, %u readers, depth %u, %.2fs.\n", (recent != 0) ? "recent" : "latest", 
+           (unsigned)readers, (unsigned)depth, elapsed);
+    printf("opt300xd_shm_bench: writer %.3f Msamples/s.\n", (double)gs_published / elapsed / 1e6);
+    for (i = 0; i < readers; i++)
+    {
+        total += reader[i].read;
+        printf("opt300xd_shm_bench: reader %u %.3f Mreads/s retry %llu torn %llu lost %llu.\n", (unsigned)i,
+               (double)reader[i].read / elapsed / 1e6, (unsigned long long)reader[i].retry,
+               (unsigned long long)reader[i].torn, (unsigned long long)reader[i].lost);
+    }
+    printf("opt300xd_shm_bench: total %.3f Mreads/s.\n", (double)total / elapsed / 1e6);
+    (void)opt300xd_shm_close(&shm);
+    (void)unlink(gs_path);
+    
+    return 0;
+}
@@ -0,0 +1,372 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      opt300xd_shm_test.c
+ * @brief     opt300xd shared memory test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "opt300xd_shm_test.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief test definition
+ */
+#define OPT300XD_SHM_TEST_DEPTH      8                                       /**< ring depth */
+#define OPT300XD_SHM_TEST_PATH       "/dev/shm/opt300xd_shm_test"            /**< test file path */
+
+/**
+ * @brief     run the shared memory test
+ * @param[in] *path pointer to a file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      none
+ */
+static uint8_t a_opt300xd_shm_test_run(const char *path)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t len;
+    uint64_t cursor;
+    uint64_t lost;
+    char bad[128];
+    FILE *fp;
+    opt300xd_shm_t writer;
+    opt300xd_shm_t reader;
+    opt300xd_shm_sample_t sample;
+    opt300xd_shm_sample_t recent[16];
+    opt300xd_shm_info_t info_check;
+    opt300xd_shm_info_t info[2] = {{0x01, 0x88, 100}, {0x02, 0x8A, 800}};
+    static uint8_t garbage[4096];
+    
+    /* start shared memory test */
+    opt300x_interface_debug_print("opt300x: start shared memory test.\n");
+    
+    /* opt300xd_shm_create test */
+    opt300x_interface_debug_print("opt300x: opt300xd_shm_create test.\n");
+    res = opt300xd_shm_create(NULL, path, info, 2, OPT300XD_SHM_TEST_DEPTH);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300xd_shm_create(&writer, path, info, 0, OPT300XD_SHM_TEST_DEPTH);
+    opt300x_interface_debug_print("opt300x: check no sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300xd_shm_create(&writer, path, info, OPT300XD_SHM_MAX_SENSOR + 1, OPT300XD_SHM_TEST_DEPTH);
+    opt300x_interface_debug_print("opt300x: check too many sensors %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300xd_shm_create(&writer, path, info, 2, 6);
+    opt300x_interface_debug_print("opt300x: check depth not a power of 2 %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300xd_shm_create(&writer, "/nonexistent/opt300xd_shm_test", info, 2, OPT300XD_SHM_TEST_DEPTH);
+    opt300x_interface_debug_print("opt300x: check missing directory %s.\n", (res == 1) ? "ok" : "error");
+    if (res != 1)
+    {
+        return 1;
+    }
+    res = opt300xd_shm_create(&writer, path, info, 2, OPT300XD_SHM_TEST_DEPTH);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: create %s failed.\n", path);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check create %s.\n", "ok");
+    
+    /* opt300xd_shm_publish test */
+    opt300x_interface_debug_print("opt300x: opt300xd_shm_publish test.\n");
+    memset(&sample, 0, sizeof(opt300xd_shm_sample_t));
+    res = opt300xd_shm_publish(NULL, 0, &sample);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300xd_shm_publish(&writer, 2, &sample);
+    opt300x_interface_debug_print("opt300x: check invalid sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300xd_shm_read_latest(&writer, 0, &sample);
+    opt300x_interface_debug_print("opt300x: check no sample %s.\n", (res == 5) ? "ok" : "error");
+    if (res != 5)
+    {
+        return 1;
+    }
+    for (i = 0; i < 3; i++)
+    {
+        sample.timestamp_us = 1000 + i;
+        sample.raw = (uint16_t)(0x1000 + i);
+        sample.data = 0.02f * (float)i;
+        sample.status = (uint8_t)i;
+        res = opt300xd_shm_publish(&writer, 0, &sample);
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: publish failed.\n");
+            
+            return 1;
+        }
+    }
+    memset(&sample, 0, sizeof(opt300xd_shm_sample_t));
+    res = opt300xd_shm_read_latest(&writer, 0, &sample);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: read latest failed.\n");
+        
+        return 1;
+    }
+    res = ((sample.index == 2) && (sample.timestamp_us == 1002) && (sample.raw == 0x1002) &&
+           (sample.data == 0.04f) && (sample.status == 2)) ? 0 : 1;
+    opt300x_interface_debug_print("opt300x: check latest sample %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    res = opt300xd_shm_read_latest(&writer, 1, &sample);
+    opt300x_interface_debug_print("opt300x: check the other sensor is empty %s.\n", (res == 5) ? "ok" : "error");
+    if (res != 5)
+    {
+        return 1;
+    }
+    
+    /* opt300xd_shm_get_info test */
+    opt300x_interface_debug_print("opt300x: opt300xd_shm_get_info test.\n");
+    res = opt300xd_shm_get_info(NULL, 0, &info_check);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300xd_shm_get_info(&writer, 2, &info_check);
+    opt300x_interface_debug_print("opt300x: check invalid sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300xd_shm_get_info(&writer, 1, &info_check);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get info failed.\n");
+        
+        return 1;
+    }
+    res = ((info_check.type == 0x02) && (info_check.addr == 0x8A) && (info_check.sample_ms == 800)) ? 0 : 1;
+    opt300x_interface_debug_print("opt300x: check info %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* opt300xd_shm_open test */
+    opt300x_interface_debug_print("opt300x: opt300xd_shm_open test.\n");
+    res = opt300xd_shm_open(NULL, path);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300xd_shm_open(&reader, "/nonexistent/opt300xd_shm_test");
+    opt300x_interface_debug_print("opt300x: check missing file %s.\n", (res == 1) ? "ok" : "error");
+    if (res != 1)
+    {
+        return 1;
+    }
+    (void)snprintf(bad, sizeof(bad), "%s.bad", path);
+    fp = fopen(bad, "wb");
+    if (fp == NULL)
+    {
+        opt300x_interface_debug_print("opt300x: create %s failed.\n", bad);
+        
+        return 1;
+    }
+    memset(garbage, 0x5A, sizeof(garbage));
+    (void)fwrite(garbage, 1, sizeof(garbage), fp);
+    (void)fclose(fp);
+    res = opt300xd_shm_open(&reader, bad);
+    (void)unlink(bad);
+    opt300x_interface_debug_print("opt300x: check invalid layout %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300xd_shm_open(&reader, path);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: open %s failed.\n", path);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check open %s.\n", "ok");
+    res = opt300xd_shm_publish(&reader, 0, &sample);
+    opt300x_interface_debug_print("opt300x: check reader can't publish %s.\n", (res == 1) ? "ok" : "error");
+    if (res != 1)
+    {
+        return 1;
+    }
+    res = opt300xd_shm_read_latest(&reader, 0, &sample);
+    opt300x_interface_debug_print("opt300x: check reader latest %s.\n", ((res == 0) && (sample.index == 2)) ? "ok" : "error");
+    if ((res != 0) || (sample.index != 2))
+    {
+        return 1;
+    }
+    res = opt300xd_shm_read_latest(&reader, 2, &sample);
+    opt300x_interface_debug_print("opt300x: check reader invalid sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    
+    /* opt300xd_shm_read_recent test */
+    opt300x_interface_debug_print("opt300x: opt300xd_shm_read_recent test.\n");
+    cursor = 0;
+    len = 16;
+    res = opt300xd_shm_read_recent(NULL, 0, &cursor, recent, &len, &lost);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300xd_shm_read_recent(&reader, 2, &cursor, recent, &len, &lost);
+    opt300x_interface_debug_print("opt300x: check invalid sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300xd_shm_read_recent(&reader, 0, &cursor, recent, &len, &lost);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: read recent failed.\n");
+        
+        return 1;
+    }
+    res = ((len == 3) && (lost == 0) && (cursor == 3) && (recent[0].index == 0) &&
+           (recent[2].index == 2) && (recent[1].raw == 0x1001)) ? 0 : 1;
+    opt300x_interface_debug_print("opt300x: check recent samples %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    for (i = 3; i < 23; i++)
+    {
+        sample.timestamp_us = 1000 + i;
+        sample.raw = (uint16_t)(0x1000 + i);
+        sample.data = 0.02f * (float)i;
+        sample.status = 0;
+        res = opt300xd_shm_publish(&writer, 0, &sample);
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: publish failed.\n");
+            
+            return 1;
+        }
+    }
+    len = 16;
+    res = opt300xd_shm_read_recent(&reader, 0, &cursor, recent, &len, &lost);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: read recent failed.\n");
+        
+        return 1;
+    }
+    res = ((len == OPT300XD_SHM_TEST_DEPTH) && (lost == 23 - OPT300XD_SHM_TEST_DEPTH - 3) && (cursor == 23) &&
+           (recent[0].index == 23 - OPT300XD_SHM_TEST_DEPTH) && (recent[OPT300XD_SHM_TEST_DEPTH - 1].raw == 0x1016)) ? 0 : 1;
+    opt300x_interface_debug_print("opt300x: check overwritten samples are lost %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    cursor = 100;
+    len = 16;
+    res = opt300xd_shm_read_recent(&reader, 0, &cursor, recent, &len, &lost);
+    res = ((res == 0) && (len == 0) && (lost == 0) && (cursor == 23)) ? 0 : 1;
+    opt300x_interface_debug_print("opt300x: check cursor follows a restarted writer %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* opt300xd_shm_close test */
+    opt300x_interface_debug_print("opt300x: opt300xd_shm_close test.\n");
+    res = opt300xd_shm_close(NULL);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300xd_shm_close(&reader);
+    opt300x_interface_debug_print("opt300x: check close reader %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    res = opt300xd_shm_close(&writer);
+    opt300x_interface_debug_print("opt300x: check close writer %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* finish shared memory test */
+    opt300x_interface_debug_print("opt300x: finish shared memory test.\n");
+    
+    return 0;
+}
+
+/**
+ * @brief  shared memory test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   none
+ */
+uint8_t opt300xd_shm_test(void)
+{
+    uint8_t res;
+    
+    res = a_opt300xd_shm_test_run(OPT300XD_SHM_TEST_PATH);
+    (void)unlink(OPT300XD_SHM_TEST_PATH);
+    
+    return res;
+}
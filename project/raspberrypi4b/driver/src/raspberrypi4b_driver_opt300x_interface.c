@@ -37,6 +37,10 @@
 #include "driver_opt300x_interface.h"
 #include "iic.h"
 #include <stdarg.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
 
 /**
  * @brief iic device name definition
@@ -47,17 +51,518 @@
  * @brief iic device handle definition
  */
 static int gs_fd;                           /**< iic handle */
+static uint32_t gs_iic_ref = 0;             /**< iic reference counter */
+
+/**
+ * @brief iic reference mutex definition
+ */
+static pthread_mutex_t gs_iic_mutex = PTHREAD_MUTEX_INITIALIZER;    /**< iic reference mutex */
+
+#if (OPT300X_INTERFACE_DEBUG_MODE == OPT300X_INTERFACE_DEBUG_MODE_DEFERRED)
+
+/**
+ * @brief deferred debug definition
+ */
+#define DEBUG_RING_SHIFT          8                               /**< log2 of the ring size */
+#define DEBUG_RING_SIZE           (1U << DEBUG_RING_SHIFT)        /**< ring size */
+#define DEBUG_RING_MASK           (DEBUG_RING_SIZE - 1)           /**< ring mask */
+#define DEBUG_MAX_ARGS            8                               /**< max args of one message */
+#define DEBUG_MAX_STRING          48                              /**< max copied string bytes of one message */
+
+/**
+ * @brief deferred debug arg type enumeration definition
+ */
+typedef enum
+{
+    DEBUG_ARG_SIGNED   = 0x00,        /**< signed integer */
+    DEBUG_ARG_UNSIGNED = 0x01,        /**< unsigned integer */
+    DEBUG_ARG_DOUBLE   = 0x02,        /**< floating point */
+    DEBUG_ARG_STRING   = 0x03,        /**< string copied into the record */
+    DEBUG_ARG_POINTER  = 0x04,        /**< pointer */
+} debug_arg_t;
+
+/**
+ * @brief deferred debug record structure definition
+ */
+typedef struct debug_record_s
+{
+    uint32_t turn;                           /**< slot turn, even is writable and odd is readable */
+    const char *fmt;                         /**< format id, the address of the format string */
+    uint8_t argc;                            /**< arg numbers */
+    uint8_t type[DEBUG_MAX_ARGS];            /**< arg types */
+    union
+    {
+        long long i;                         /**< signed integer */
+        unsigned long long u;                /**< unsigned integer */
+        double d;                            /**< floating point */
+        uint16_t offset;                     /**< string offset */
+        const void *p;                       /**< pointer */
+    } arg[DEBUG_MAX_ARGS];                   /**< args */
+    char str[DEBUG_MAX_STRING];              /**< copied strings */
+} debug_record_t;
+
+/**
+ * @brief deferred debug ring definition
+ */
+static debug_record_t gs_debug_ring[DEBUG_RING_SIZE];        /**< record ring */
+static uint32_t gs_debug_head;                               /**< write position */
+static uint32_t gs_debug_tail;                               /**< read position */
+static uint32_t gs_debug_dropped;                            /**< dropped messages */
+static pthread_mutex_t gs_debug_mutex = PTHREAD_MUTEX_INITIALIZER;        /**< flush mutex, one reader at a time */
+
+/**
+ * @brief         parse one conversion specification
+ * @param[in]     *fmt pointer to the char after '%'
+ * @param[out]    *spec pointer to a normalized specification buffer
+ * @param[in]     len length of the specification buffer
+ * @param[out]    *conv pointer to a conversion char buffer
+ * @param[out]    *length pointer to a length modifier buffer
+ * @return        pointer to the char after the specification
+ * @note          the length modifier is dropped from spec and resolved at format time,
+ *                length is 0, 'H' for hh, 'h', 'l', 'q' for ll, 'j', 'z', 't' or 'L'
+ */
+static const char *a_debug_parse_spec(const char *fmt, char *spec, size_t len, char *conv, char *length)
+{
+    size_t n = 0;
+    
+    spec[n++] = '%';
+    while ((*fmt != '\0') && (strchr("-+ #0123456789.", *fmt) != NULL))
+    {
+        if (n < len - 4)
+        {
+            spec[n++] = *fmt;
+        }
+        fmt++;
+    }
+    *length = 0;
+    while ((*fmt != '\0') && (strchr("hlLqjzt", *fmt) != NULL))
+    {
+        if ((*fmt == 'h') && (*length == 'h'))
+        {
+            *length = 'H';
+        }
+        else if (((*fmt == 'l') && (*length == 'l')) || (*fmt == 'q'))
+        {
+            *length = 'q';
+        }
+        else
+        {
+            *length = *fmt;
+        }
+        fmt++;
+    }
+    *conv = *fmt;
+    if (*fmt != '\0')
+    {
+        fmt++;
+    }
+    if ((*conv == 'd') || (*conv == 'i') || (*conv == 'u') || (*conv == 'o') || 
+        (*conv == 'x') || (*conv == 'X'))
+    {
+        spec[n++] = 'l';
+        spec[n++] = 'l';
+    }
+    spec[n++] = *conv;
+    spec[n] = '\0';
+    
+    return fmt;
+}
+
+/**
+ * @brief     format one record and print it
+ * @param[in] *r pointer to a record
+ * @note      none
+ */
+static void a_debug_format(const debug_record_t *r)
+{
+    char spec[32];
+    char conv;
+    char length;
+    char str[256];
+    size_t n = 0;
+    uint8_t i = 0;
+    const char *p = r->fmt;
+    int l;
+    
+    while ((*p != '\0') && (n < sizeof(str) - 1))
+    {
+        if (*p != '%')
+        {
+            str[n++] = *p++;
+            
+            continue;
+        }
+        p++;
+        if (*p == '%')
+        {
+            str[n++] = *p++;
+            
+            continue;
+        }
+        if (i >= r->argc)
+        {
+            str[n++] = '%';
+            
+            continue;
+        }
+        p = a_debug_parse_spec(p, spec, sizeof(spec), &conv, &length);
+        switch (r->type[i])
+        {
+            case DEBUG_ARG_SIGNED :
+            {
+                if (conv == 'c')
+                {
+                    l = snprintf(&str[n], sizeof(str) - n, spec, (int)r->arg[i].i);
+                }
+                else
+                {
+                    l = snprintf(&str[n], sizeof(str) - n, spec, r->arg[i].i);
+                }
+                
+                break;
+            }
+            case DEBUG_ARG_UNSIGNED :
+            {
+                l = snprintf(&str[n], sizeof(str) - n, spec, r->arg[i].u);
+                
+                break;
+            }
+            case DEBUG_ARG_DOUBLE :
+            {
+                l = snprintf(&str[n], sizeof(str) - n, spec, r->arg[i].d);
+                
+                break;
+            }
+            case DEBUG_ARG_STRING :
+            {
+                l = snprintf(&str[n], sizeof(str) - n, spec, &r->str[r->arg[i].offset]);
+                
+                break;
+            }
+            default :
+            {
+                l = snprintf(&str[n], sizeof(str) - n, spec, r->arg[i].p);
+                
+                break;
+            }
+        }
+        i++;
+        if (l > 0)
+        {
+            n += ((size_t)l < sizeof(str) - n) ? (size_t)l : (sizeof(str) - n - 1);
+        }
+    }
+    str[n] = '\0';
+    
+    (void)fputs(str, stdout);
+}
+
+/**
+ * @brief format and print all readable records
+ * @note  the caller holds gs_debug_mutex
+ */
+static void a_debug_drain(void)
+{
+    uint32_t turn;
+    uint32_t dropped;
+    debug_record_t *r;
+    
+    while (1)
+    {
+        r = &gs_debug_ring[gs_debug_tail & DEBUG_RING_MASK];
+        turn = ((gs_debug_tail >> DEBUG_RING_SHIFT) << 1) + 1;
+        if (__atomic_load_n(&r->turn, __ATOMIC_ACQUIRE) != turn)
+        {
+            break;
+        }
+        a_debug_format(r);
+        __atomic_store_n(&r->turn, turn + 1, __ATOMIC_RELEASE);
+        gs_debug_tail++;
+    }
+    dropped = __atomic_exchange_n(&gs_debug_dropped, 0, __ATOMIC_RELAXED);
+    if (dropped != 0)
+    {
+        (void)printf("opt300x: %u debug messages dropped.\n", dropped);
+    }
+    (void)fflush(stdout);
+}
+
+/**
+ * @brief     record one message into the ring
+ * @param[in] *fmt pointer to a format string
+ * @param[in] args arg list
+ * @note      never waits and never formats, a full ring drops and counts the message
+ */
+static void a_debug_record(const char *fmt, va_list args)
+{
+    uint32_t pos;
+    uint32_t turn;
+    uint16_t offset;
+    char spec[32];
+    char conv;
+    char length;
+    uint8_t stop;
+    const char *p;
+    debug_record_t *r;
+    
+    pos = __atomic_load_n(&gs_debug_head, __ATOMIC_RELAXED);
+    while (1)
+    {
+        r = &gs_debug_ring[pos & DEBUG_RING_MASK];
+        turn = __atomic_load_n(&r->turn, __ATOMIC_ACQUIRE);
+        if (turn == ((pos >> DEBUG_RING_SHIFT) << 1))
+        {
+            if (__atomic_compare_exchange_n(&gs_debug_head, &pos, pos + 1, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if ((int32_t)(turn - ((pos >> DEBUG_RING_SHIFT) << 1)) < 0)
+        {
+            (void)__atomic_fetch_add(&gs_debug_dropped, 1, __ATOMIC_RELAXED);
+            
+            return;
+        }
+        else
+        {
+            pos = __atomic_load_n(&gs_debug_head, __ATOMIC_RELAXED);
+        }
+    }
+    
+    r->fmt = fmt;
+    r->argc = 0;
+    offset = 0;
+    stop = 0;
+    p = fmt;
+    while ((*p != '\0') && (stop == 0))
+    {
+        if (*p++ != '%')
+        {
+            continue;
+        }
+        if (*p == '%')
+        {
+            p++;
+            
+            continue;
+        }
+        p = a_debug_parse_spec(p, spec, sizeof(spec), &conv, &length);
+        if ((r->argc >= DEBUG_MAX_ARGS) || (strchr(spec, '*') != NULL))
+        {
+            break;
+        }
+        switch (conv)
+        {
+            case 'd' :
+            case 'i' :
+            {
+                r->type[r->argc] = DEBUG_ARG_SIGNED;
+                if (length == 'H')
+                {
+                    r->arg[r->argc].i = (signed char)va_arg(args, int);
+                }
+                else if (length == 'h')
+                {
+                    r->arg[r->argc].i = (short)va_arg(args, int);
+                }
+                else if (length == 'l')
+                {
+                    r->arg[r->argc].i = va_arg(args, long);
+                }
+                else if (length == 'q')
+                {
+                    r->arg[r->argc].i = va_arg(args, long long);
+                }
+                else if (length == 'j')
+                {
+                    r->arg[r->argc].i = va_arg(args, intmax_t);
+                }
+                else if (length == 'z')
+                {
+                    r->arg[r->argc].i = (ptrdiff_t)va_arg(args, size_t);
+                }
+                else if (length == 't')
+                {
+                    r->arg[r->argc].i = va_arg(args, ptrdiff_t);
+                }
+                else if (length == 0)
+                {
+                    r->arg[r->argc].i = va_arg(args, int);
+                }
+                else
+                {
+                    stop = 1;
+                    
+                    break;
+                }
+                r->argc++;
+                
+                break;
+            }
+            case 'u' :
+            case 'o' :
+            case 'x' :
+            case 'X' :
+            {
+                r->type[r->argc] = DEBUG_ARG_UNSIGNED;
+                if (length == 'H')
+                {
+                    r->arg[r->argc].u = (unsigned char)va_arg(args, unsigned int);
+                }
+                else if (length == 'h')
+                {
+                    r->arg[r->argc].u = (unsigned short)va_arg(args, unsigned int);
+                }
+                else if (length == 'l')
+                {
+                    r->arg[r->argc].u = va_arg(args, unsigned long);
+                }
+                else if (length == 'q')
+                {
+                    r->arg[r->argc].u = va_arg(args, unsigned long long);
+                }
+                else if (length == 'j')
+                {
+                    r->arg[r->argc].u = va_arg(args, uintmax_t);
+                }
+                else if (length == 'z')
+                {
+                    r->arg[r->argc].u = va_arg(args, size_t);
+                }
+                else if (length == 't')
+                {
+                    r->arg[r->argc].u = (size_t)va_arg(args, ptrdiff_t);
+                }
+                else if (length == 0)
+                {
+                    r->arg[r->argc].u = va_arg(args, unsigned int);
+                }
+                else
+                {
+                    stop = 1;
+                    
+                    break;
+                }
+                r->argc++;
+                
+                break;
+            }
+            case 'c' :
+            {
+                if ((length != 0) && (length != 'l'))
+                {
+                    stop = 1;
+                    
+                    break;
+                }
+                r->type[r->argc] = DEBUG_ARG_SIGNED;
+                r->arg[r->argc].i = va_arg(args, int);
+                r->argc++;
+                
+                break;
+            }
+            case 'f' :
+            case 'F' :
+            case 'e' :
+            case 'E' :
+            case 'g' :
+            case 'G' :
+            case 'a' :
+            case 'A' :
+            {
+                if ((length != 0) && (length != 'l') && (length != 'L'))
+                {
+                    stop = 1;
+                    
+                    break;
+                }
+                r->type[r->argc] = DEBUG_ARG_DOUBLE;
+                r->arg[r->argc].d = (length == 'L') ? (double)va_arg(args, long double) : va_arg(args, double);
+                r->argc++;
+                
+                break;
+            }
+            case 's' :
+            {
+                const char *str;
+                size_t l;
+                
+                if (length != 0)
+                {
+                    stop = 1;
+                    
+                    break;
+                }
+                str = va_arg(args, const char *);
+                l = (str != NULL) ? strlen(str) : 0;
+                if (l > (size_t)(DEBUG_MAX_STRING - 1 - offset))
+                {
+                    l = DEBUG_MAX_STRING - 1 - offset;
+                }
+                if (l != 0)
+                {
+                    memcpy(&r->str[offset], str, l);
+                }
+                r->str[offset + l] = '\0';
+                r->type[r->argc] = DEBUG_ARG_STRING;
+                r->arg[r->argc].offset = offset;
+                r->argc++;
+                offset = (uint16_t)(offset + l + ((offset + l < DEBUG_MAX_STRING - 1) ? 1 : 0));
+                
+                break;
+            }
+            case 'p' :
+            {
+                if (length != 0)
+                {
+                    stop = 1;
+                    
+                    break;
+                }
+                r->type[r->argc] = DEBUG_ARG_POINTER;
+                r->arg[r->argc].p = va_arg(args, const void *);
+                r->argc++;
+                
+                break;
+            }
+            default :
+            {
+                stop = 1;
+                
+                break;
+            }
+        }
+    }
+    
+    __atomic_store_n(&r->turn, ((pos >> DEBUG_RING_SHIFT) << 1) + 1, __ATOMIC_RELEASE);
+}
+
+#endif
 
 /**
  * @brief  interface iic bus init
  * @return status code
  *         - 0 success
  *         - 1 iic init failed
- * @note   none
+ * @note   reference counted, so several handles can share the bus
  */
 uint8_t opt300x_interface_iic_init(void)
 {
-    return iic_init(IIC_DEVICE_NAME, &gs_fd);
+    uint8_t res;
+    
+    res = 0;
+    (void)pthread_mutex_lock(&gs_iic_mutex);
+    if (gs_iic_ref == 0)
+    {
+        res = iic_init(IIC_DEVICE_NAME, &gs_fd);
+    }
+    if (res == 0)
+    {
+        gs_iic_ref++;
+    }
+    (void)pthread_mutex_unlock(&gs_iic_mutex);
+    
+    return res;
 }
 
 /**
@@ -65,11 +570,29 @@ uint8_t opt300x_interface_iic_init(void)
  * @return status code
  *         - 0 success
  *         - 1 iic deinit failed
- * @note   none
+ * @note   the bus is closed by the last reference
  */
 uint8_t opt300x_interface_iic_deinit(void)
 {
-    return iic_deinit(gs_fd);
+    uint8_t res;
+    
+    res = 0;
+    (void)pthread_mutex_lock(&gs_iic_mutex);
+    if (gs_iic_ref == 0)
+    {
+        res = 1;
+    }
+    else if (gs_iic_ref == 1)
+    {
+        res = iic_deinit(gs_fd);
+    }
+    if (res == 0)
+    {
+        gs_iic_ref--;
+    }
+    (void)pthread_mutex_unlock(&gs_iic_mutex);
+    
+    return res;
 }
 
 /**
@@ -104,6 +627,36 @@ uint8_t opt300x_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uin
     return iic_write(gs_fd, addr, reg, buf, len);
 }
 
+/**
+ * @brief      interface iic bus read command
+ * @param[in]  addr iic device write address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t opt300x_interface_iic_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    return iic_read_cmd(gs_fd, addr, buf, len);
+}
+
+/**
+ * @brief     interface iic bus write command
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t opt300x_interface_iic_write_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    return iic_write_cmd(gs_fd, addr, buf, len);
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -132,6 +685,129 @@ void opt300x_interface_debug_print(const char *const fmt, ...)
     (void)printf((uint8_t *)str);
 }
 
+/**
+ * @brief     interface log driver debug data
+ * @param[in] fmt format data
+ * @note      the deferred mode only records the message, opt300x_interface_debug_flush formats it
+ */
+void opt300x_interface_debug_log(const char *const fmt, ...)
+{
+#if (OPT300X_INTERFACE_DEBUG_MODE == OPT300X_INTERFACE_DEBUG_MODE_IMMEDIATE)
+    char str[256];
+    va_list args;
+    
+    memset((char *)str, 0, sizeof(char) * 256); 
+    va_start(args, fmt);
+    vsnprintf((char *)str, 255, (char const *)fmt, args);
+    va_end(args);
+    
+    (void)printf((uint8_t *)str);
+#elif (OPT300X_INTERFACE_DEBUG_MODE == OPT300X_INTERFACE_DEBUG_MODE_DEFERRED)
+    va_list args;
+    
+    va_start(args, fmt);
+    a_debug_record(fmt, args);
+    va_end(args);
+#else
+    (void)fmt;
+#endif
+}
+
+/**
+ * @brief interface format and output all deferred messages
+ * @note  call it out of the sampling path when the deferred mode is used
+ */
+void opt300x_interface_debug_flush(void)
+{
+#if (OPT300X_INTERFACE_DEBUG_MODE == OPT300X_INTERFACE_DEBUG_MODE_DEFERRED)
+    (void)pthread_mutex_lock(&gs_debug_mutex);
+    a_debug_drain();
+    (void)pthread_mutex_unlock(&gs_debug_mutex);
+#endif
+}
+
+/**
+ * @brief      interface mutex init
+ * @param[out] **mutex pointer to a mutex context buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 mutex init failed
+ * @note       every handle gets its own pthread mutex
+ */
+uint8_t opt300x_interface_mutex_init(void **mutex)
+{
+    pthread_mutex_t *m;
+    
+    m = (pthread_mutex_t *)malloc(sizeof(pthread_mutex_t));
+    if (m == NULL)
+    {
+        return 1;
+    }
+    if (pthread_mutex_init(m, NULL) != 0)
+    {
+        free(m);
+        
+        return 1;
+    }
+    *mutex = m;
+    
+    return 0;
+}
+
+/**
+ * @brief     interface mutex deinit
+ * @param[in] *mutex pointer to a mutex context
+ * @note      none
+ */
+void opt300x_interface_mutex_deinit(void *mutex)
+{
+    if (mutex != NULL)
+    {
+        (void)pthread_mutex_destroy((pthread_mutex_t *)mutex);
+        free(mutex);
+    }
+}
+
+/**
+ * @brief     interface mutex lock
+ * @param[in] *mutex pointer to a mutex context
+ * @note      none
+ */
+void opt300x_interface_mutex_lock(void *mutex)
+{
+    if (mutex != NULL)
+    {
+        (void)pthread_mutex_lock((pthread_mutex_t *)mutex);
+    }
+}
+
+/**
+ * @brief     interface mutex unlock
+ * @param[in] *mutex pointer to a mutex context
+ * @note      none
+ */
+void opt300x_interface_mutex_unlock(void *mutex)
+{
+    if (mutex != NULL)
+    {
+        (void)pthread_mutex_unlock((pthread_mutex_t *)mutex);
+    }
+}
+
+/**
+ * @brief  interface timestamp us
+ * @return monotonic time in us
+ * @note   none
+ */
+uint64_t opt300x_interface_timestamp_us(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
 /**
  * @brief     interface receive callback
  * @param[in] type irq type
@@ -0,0 +1,345 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      opt300x_filter_bench.c
+ * @brief     opt300x filter bench source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_opt300x_filter.h"
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief bench definition
+ */
+#define BENCH_TRACE           1024        /**< trace ticks, replayed */
+#define BENCH_BOXCAR_TAPS     8           /**< boxcar taps */
+#define BENCH_MEDIAN_TAPS     5           /**< median taps */
+#define BENCH_FIR_TAPS        16          /**< fir taps */
+#define BENCH_DECIMATION      10          /**< fir and cic decimation */
+#define BENCH_CIC_ORDER       3           /**< cic order */
+
+/**
+ * @brief bench stage enumeration definition
+ */
+typedef enum
+{
+    BENCH_EMA = 0,
+    BENCH_BOXCAR,
+    BENCH_MEDIAN,
+    BENCH_FIR,
+    BENCH_CIC,
+    BENCH_STAGES,
+} bench_stage_t;
+
+/**
+ * @brief bench stage name
+ */
+static const char *const gs_name[BENCH_STAGES] =
+{
+    "ema", "boxcar 8", "median 5", "fir 16 /10", "cic 3 /10",
+};
+
+/**
+ * @brief  get the monotonic time
+ * @return time in ns
+ * @note   none
+ */
+static uint64_t a_bench_now_ns(void)
+{
+    struct timespec t;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &t);
+    
+    return (uint64_t)t.tv_sec * 1000000000ULL + (uint64_t)t.tv_nsec;
+}
+
+/**
+ * @brief     run one stage over a sensor bank
+ * @param[in] stage bench stage
+ * @param[in] sensor_num sensor numbers
+ * @param[in] samples samples to filter
+ * @param[in] *raw pointer to a raw trace, [tick][sensor]
+ * @param[in] *lux pointer to the converted trace, [tick][sensor]
+ * @param[out] *check pointer to a check sum buffer
+ * @return    ns per sample, negative on failure
+ * @note      none
+ */
+static double a_bench_stage(bench_stage_t stage, uint16_t sensor_num, uint64_t samples,
+                            const uint16_t *raw, const float *lux, double *check)
+{
+    uint8_t res = 0;
+    uint8_t ready = 0;
+    uint32_t len;
+    uint64_t tick;
+    uint64_t ticks;
+    uint64_t start;
+    uint64_t t;
+    float *buffer;
+    float *out;
+    uint64_t *state;
+    opt300x_t *type;
+    float coef[BENCH_FIR_TAPS];
+    opt300x_filter_ema_t ema;
+    opt300x_filter_boxcar_t boxcar;
+    opt300x_filter_median_t median;
+    opt300x_filter_fir_t fir;
+    opt300x_filter_cic_t cic;
+    
+    len = OPT300X_FILTER_MEDIAN_BUFFER(sensor_num, BENCH_MEDIAN_TAPS) + OPT300X_FILTER_FIR_BUFFER(sensor_num, BENCH_FIR_TAPS);
+    buffer = (float *)malloc(len * sizeof(float));
+    out = (float *)malloc(sensor_num * sizeof(float));
+    state = (uint64_t *)malloc(OPT300X_FILTER_CIC_BUFFER(sensor_num, BENCH_CIC_ORDER) * sizeof(uint64_t));
+    type = (opt300x_t *)malloc(sensor_num * sizeof(opt300x_t));
+    if ((buffer == NULL) || (out == NULL) || (state == NULL) || (type == NULL))
+    {
+        free(buffer);
+        free(out);
+        free(state);
+        free(type);
+        
+        return -1.0;
+    }
+    for (t = 0; t < sensor_num; t++)
+    {
+        type[t] = ((t & 1) != 0) ? OPT3002 : OPT3001;
+    }
+    for (t = 0; t < BENCH_FIR_TAPS; t++)
+    {
+        coef[t] = 1.0f / BENCH_FIR_TAPS;
+    }
+    switch (stage)
+    {
+        case BENCH_EMA :
+        {
+            res = opt300x_filter_ema_init(&ema, sensor_num, 0.1f, buffer, len);
+            
+            break;
+        }
+        case BENCH_BOXCAR :
+        {
+            res = opt300x_filter_boxcar_init(&boxcar, sensor_num, BENCH_BOXCAR_TAPS, buffer, len);
+            
+            break;
+        }
+        case BENCH_MEDIAN :
+        {
+            res = opt300x_filter_median_init(&median, sensor_num, BENCH_MEDIAN_TAPS, buffer, len);
+            
+            break;
+        }
+        case BENCH_FIR :
+        {
+            res = opt300x_filter_fir_init(&fir, sensor_num, coef, BENCH_FIR_TAPS, BENCH_DECIMATION, buffer, len);
+            
+            break;
+        }
+        default :
+        {
+            res = opt300x_filter_cic_init(&cic, type, sensor_num, BENCH_CIC_ORDER, BENCH_DECIMATION, state,
+                                          OPT300X_FILTER_CIC_BUFFER(sensor_num, BENCH_CIC_ORDER));
+            
+            break;
+        }
+    }
+    
+    ticks = samples / sensor_num;
+    start = a_bench_now_ns();
+    for (tick = 0; (tick < ticks) && (res == 0); tick++)
+    {
+        uint32_t offset = (uint32_t)(tick % BENCH_TRACE) * sensor_num;
+        
+        switch (stage)
+        {
+            case BENCH_EMA :
+            {
+                res = opt300x_filter_ema_run(&ema, lux + offset, out);
+                
+                break;
+            }
+            case BENCH_BOXCAR :
+            {
+                res = opt300x_filter_boxcar_run(&boxcar, lux + offset, out);
+                
+                break;
+            }
+            case BENCH_MEDIAN :
+            {
+                res = opt300x_filter_median_run(&median, lux + offset, out);
+                
+                break;
+            }
+            case BENCH_FIR :
+            {
+                res = opt300x_filter_fir_run(&fir, lux + offset, out, &ready);
+                
+                break;
+            }
+            default :
+            {
+                res = opt300x_filter_cic_run(&cic, raw + offset, out, &ready);
+                
+                break;
+            }
+        }
+    }
+    t = a_bench_now_ns() - start;
+    *check += out[sensor_num - 1];
+    free(buffer);
+    free(out);
+    free(state);
+    free(type);
+    
+    return (res == 0) ? ((double)t / (double)(ticks * sensor_num)) : -1.0;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    uint32_t i;
+    uint32_t j;
+    uint32_t sensors = 256;
+    uint64_t samples = 32000000ULL;
+    uint64_t seed = 88172645463325252ULL;
+    double check = 0.0;
+    uint16_t *raw;
+    float *lux;
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"sensors", required_argument, NULL, 1},
+        {"samples", required_argument, NULL, 2},
+        {NULL, 0, NULL, 0},
+    };
+    
+    /* parse */
+    do
+    {
+        c = getopt_long(argc, argv, "h", long_options, &longindex);
+        switch (c)
+        {
+            case 1 :
+            {
+                sensors = (uint32_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            case 2 :
+            {
+                samples = strtoull(optarg, NULL, 10);
+                
+                break;
+            }
+            case -1 :
+            {
+                break;
+            }
+            default :
+            {
+                printf("Usage:\n");
+                printf("  opt300x_filter_bench [--sensors=<num>] [--samples=<num>]\n");
+                
+                return (c == 'h') ? 0 : 1;
+            }
+        }
+    } while (c != -1);
+    if ((sensors == 0) || (sensors > 65535) || (samples < sensors))
+    {
+        printf("opt300x_filter_bench: sensors must be 1 to 65535 and samples at least sensors.\n");
+        
+        return 1;
+    }
+    
+    /* a noisy trace under mains flicker */
+    raw = (uint16_t *)malloc((size_t)BENCH_TRACE * sensors * sizeof(uint16_t));
+    lux = (float *)malloc((size_t)BENCH_TRACE * sensors * sizeof(float));
+    if ((raw == NULL) || (lux == NULL))
+    {
+        printf("opt300x_filter_bench: malloc failed.\n");
+        free(raw);
+        free(lux);
+        
+        return 1;
+    }
+    for (i = 0; i < BENCH_TRACE; i++)
+    {
+        for (j = 0; j < sensors; j++)
+        {
+            uint32_t idx = i * sensors + j;
+            
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            raw[idx] = (uint16_t)((((j % 6) + 2) << 12) | (2048 + (i % 10) * 64 + (seed & 0xFF)));
+            lux[idx] = 0.01f * (float)((uint32_t)(raw[idx] & 0x0FFF) << (raw[idx] >> 12));
+        }
+    }
+    
+    /* one sensor against a bank */
+    printf("opt300x_filter_bench: %-12s %14s %14s\n", "stage", "1 sensor", "bank");
+    for (i = 0; i < BENCH_STAGES; i++)
+    {
+        double one;
+        double bank;
+        
+        one = a_bench_stage((bench_stage_t)i, 1, samples / 8, raw, lux, &check);
+        bank = a_bench_stage((bench_stage_t)i, (uint16_t)sensors, samples, raw, lux, &check);
+        if ((one < 0.0) || (bank < 0.0))
+        {
+            printf("opt300x_filter_bench: %s failed.\n", gs_name[i]);
+            free(raw);
+            free(lux);
+            
+            return 1;
+        }
+        printf("opt300x_filter_bench: %-12s %9.2f ns/s %9.2f ns/s (%u sensors, %.1fx)\n",
+               gs_name[i], one, bank, sensors, one / bank);
+    }
+    printf("opt300x_filter_bench: check %.1f.\n", check);
+    free(raw);
+    free(lux);
+    
+    return 0;
+}
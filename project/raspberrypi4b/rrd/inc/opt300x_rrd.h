@@ -0,0 +1,234 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      opt300x_rrd.h
+ * @brief     opt300x round robin database header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef OPT300X_RRD_H
+#define OPT300X_RRD_H
+
+#include "driver_opt300x.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup opt300x_rrd opt300x round robin database function
+ * @brief    opt300x round robin database modules
+ * @{
+ */
+
+/**
+ * @brief round robin database format definition
+ * @note  the file has a fixed size and is memory mapped, all fields are little endian
+ *        file   := header(64) tier(32)*4 state(32)*4*8 data
+ *        header := magic "O3RR", version, sensor numbers, tier numbers, chip type and address pin
+ *                  of every sensor id
+ *        tier   := step in us, rows, data offset
+ *        state  := running period, sum, count, min and max of one tier and one sensor
+ *        data   := for every tier and every sensor, stamp[rows] avg[rows] min[rows] max[rows]
+ *        a row of period p lives at p % rows and its stamp is p + 1 truncated to 32 bits,
+ *        so a stale or never written row is detected on read and an update never fills gaps
+ */
+#define OPT300X_RRD_VERSION          1        /**< format version */
+#define OPT300X_RRD_MAX_SENSOR       8        /**< max sensor ids */
+#define OPT300X_RRD_MAX_TIER         4        /**< max tiers */
+
+/**
+ * @brief opt300x rrd consolidation function enumeration definition
+ */
+typedef enum
+{
+    OPT300X_RRD_CF_AVG = 0x00,        /**< average */
+    OPT300X_RRD_CF_MIN = 0x01,        /**< minimum */
+    OPT300X_RRD_CF_MAX = 0x02,        /**< maximum */
+} opt300x_rrd_cf_t;
+
+/**
+ * @brief opt300x rrd tier structure definition
+ */
+typedef struct opt300x_rrd_tier_s
+{
+    uint64_t step_us;        /**< row step, a multiple of the step of the finer tier */
+    uint32_t rows;           /**< rows, the retention is step_us * rows */
+} opt300x_rrd_tier_t;
+
+/**
+ * @brief opt300x rrd sensor structure definition
+ */
+typedef struct opt300x_rrd_sensor_s
+{
+    opt300x_t type;                      /**< chip type */
+    opt300x_address_t addr;              /**< address pin */
+} opt300x_rrd_sensor_t;
+
+/**
+ * @brief opt300x rrd structure definition
+ */
+typedef struct opt300x_rrd_s
+{
+    uint8_t *base;                                         /**< mapped file */
+    size_t size;                                           /**< mapped size */
+    int fd;                                                /**< file handle */
+    uint8_t writable;                                      /**< writable flag */
+    uint8_t sensor_num;                                    /**< sensor numbers */
+    uint8_t tier_num;                                      /**< tier numbers */
+    float weight[OPT300X_RRD_MAX_SENSOR];                  /**< lsb weight of every sensor id */
+    opt300x_rrd_tier_t tier[OPT300X_RRD_MAX_TIER];         /**< tiers */
+} opt300x_rrd_t;
+
+/**
+ * @brief opt300x rrd default tiers definition
+ * @note  10 Hz for an hour, 1 s for a day and 1 min for a year
+ */
+#define OPT300X_RRD_DEFAULT_TIER    {{100000ULL, 36000}, {1000000ULL, 86400}, {60000000ULL, 525600}}
+
+/**
+ * @brief     create or continue a round robin database
+ * @param[in] *rrd pointer to an rrd structure
+ * @param[in] *path pointer to a file path
+ * @param[in] *sensor pointer to a sensor table, the index is the sensor id
+ * @param[in] sensor_num sensor numbers
+ * @param[in] *tier pointer to a tier table, from the finest to the coarsest
+ * @param[in] tier_num tier numbers
+ * @return    status code
+ *            - 0 success
+ *            - 1 create failed
+ *            - 2 handle is NULL
+ *            - 4 param is invalid
+ *            - 5 the existing file has another layout
+ * @note      an existing file with the same sensors and tiers is continued
+ */
+uint8_t opt300x_rrd_create(opt300x_rrd_t *rrd, const char *path, const opt300x_rrd_sensor_t *sensor, uint8_t sensor_num,
+                           const opt300x_rrd_tier_t *tier, uint8_t tier_num);
+
+/**
+ * @brief     open a round robin database for reading
+ * @param[in] *rrd pointer to an rrd structure
+ * @param[in] *path pointer to a file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 2 handle is NULL
+ *            - 4 file is invalid
+ * @note      the file is mapped read only, a writer may update it meanwhile
+ */
+uint8_t opt300x_rrd_open(opt300x_rrd_t *rrd, const char *path);
+
+/**
+ * @brief     close a round robin database
+ * @param[in] *rrd pointer to an rrd structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t opt300x_rrd_close(opt300x_rrd_t *rrd);
+
+/**
+ * @brief     add one sample
+ * @param[in] *rrd pointer to an rrd structure
+ * @param[in] sensor sensor id
+ * @param[in] raw raw result word
+ * @param[in] timestamp_us sample timestamp
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 rrd is read only
+ *            - 4 sensor is invalid
+ *            - 5 timestamp is before the running period
+ * @note      every tier keeps a running period, a tier writes one row when its period ends,
+ *            so the work and the touched pages per sample don't depend on the retention
+ */
+uint8_t opt300x_rrd_update(opt300x_rrd_t *rrd, uint8_t sensor, uint16_t raw, uint64_t timestamp_us);
+
+/**
+ * @brief     read a sensor and add the sample
+ * @param[in] *rrd pointer to an rrd structure
+ * @param[in] sensor sensor id
+ * @param[in] *handle pointer to an opt300x handle structure in continuous mode
+ * @param[in] timestamp_us sample timestamp
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle is NULL
+ *            - 3 rrd is read only
+ *            - 4 sensor is invalid
+ *            - 5 timestamp is before the running period
+ * @note      the timestamp is passed in since the history needs the wall clock
+ */
+uint8_t opt300x_rrd_read_update(opt300x_rrd_t *rrd, uint8_t sensor, opt300x_handle_t *handle, uint64_t timestamp_us);
+
+/**
+ * @brief     write the mapped pages back to the file
+ * @param[in] *rrd pointer to an rrd structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 sync failed
+ *            - 2 handle is NULL
+ * @note      asynchronous, the kernel writes back the dirty pages only
+ */
+uint8_t opt300x_rrd_sync(opt300x_rrd_t *rrd);
+
+/**
+ * @brief      query a time range
+ * @param[in]  *rrd pointer to an rrd structure
+ * @param[in]  sensor sensor id
+ * @param[in]  cf consolidation function
+ * @param[in]  start_us range start
+ * @param[in]  end_us range end, excluded
+ * @param[out] *data pointer to a data buffer, NAN marks a row without samples
+ * @param[in]  size data buffer size
+ * @param[out] *num pointer to a row numbers buffer
+ * @param[out] *first_us pointer to a first row timestamp buffer
+ * @param[out] *step_us pointer to a row step buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 param is invalid
+ * @note       uses the finest tier whose retention covers the start, the rows end before the running period
+ */
+uint8_t opt300x_rrd_query(opt300x_rrd_t *rrd, uint8_t sensor, opt300x_rrd_cf_t cf, uint64_t start_us, uint64_t end_us,
+                          float *data, uint32_t size, uint32_t *num, uint64_t *first_us, uint64_t *step_us);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
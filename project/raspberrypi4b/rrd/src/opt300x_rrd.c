@@ -0,0 +1,679 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      opt300x_rrd.c
+ * @brief     opt300x round robin database source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "opt300x_rrd.h"
+#include <fcntl.h>
+#include <math.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief round robin database layout definition
+ */
+#define RRD_MAGIC              0x5252334FU        /**< "O3RR" */
+#define RRD_TIER_OFFSET        64                 /**< tier table offset */
+#define RRD_STATE_OFFSET       192                /**< state table offset */
+#define RRD_DATA_OFFSET        4096               /**< first tier data offset */
+#define RRD_ROW_SIZE           16                 /**< stamp, avg, min and max */
+
+/**
+ * @brief round robin database header structure definition
+ */
+typedef struct rrd_header_s
+{
+    uint32_t magic;                              /**< magic, written last */
+    uint16_t version;                            /**< format version */
+    uint8_t sensor_num;                          /**< sensor numbers */
+    uint8_t tier_num;                            /**< tier numbers */
+    uint8_t type[OPT300X_RRD_MAX_SENSOR];        /**< chip type of every sensor id */
+    uint8_t addr[OPT300X_RRD_MAX_SENSOR];        /**< address pin of every sensor id */
+    uint8_t reserved[40];                        /**< pad to 64 bytes */
+} rrd_header_t;
+
+/**
+ * @brief round robin database tier structure definition
+ */
+typedef struct rrd_tier_s
+{
+    uint64_t step_us;              /**< row step */
+    uint32_t rows;                 /**< rows */
+    uint32_t reserved;             /**< reserved */
+    uint64_t offset;               /**< data offset */
+    uint64_t reserved2;            /**< pad to 32 bytes */
+} rrd_tier_t;
+
+/**
+ * @brief round robin database state structure definition
+ */
+typedef struct rrd_state_s
+{
+    uint64_t period;               /**< running period */
+    double sum;                    /**< sum of the running period */
+    uint32_t count;                /**< samples of the running period */
+    float min;                     /**< min of the running period */
+    float max;                     /**< max of the running period */
+    uint32_t reserved;             /**< pad to 32 bytes */
+} rrd_state_t;
+
+/**
+ * @brief     get the state of a tier and a sensor
+ * @param[in] *rrd pointer to an rrd structure
+ * @param[in] tier tier index
+ * @param[in] sensor sensor id
+ * @return    pointer to the state
+ * @note      none
+ */
+static rrd_state_t *a_rrd_state(opt300x_rrd_t *rrd, uint8_t tier, uint8_t sensor)
+{
+    return (rrd_state_t *)(rrd->base + RRD_STATE_OFFSET) + tier * OPT300X_RRD_MAX_SENSOR + sensor;
+}
+
+/**
+ * @brief     get a column of a tier and a sensor
+ * @param[in] *rrd pointer to an rrd structure
+ * @param[in] tier tier index
+ * @param[in] sensor sensor id
+ * @param[in] column 0 stamp, 1 avg, 2 min, 3 max
+ * @return    pointer to the column
+ * @note      none
+ */
+static uint32_t *a_rrd_column(opt300x_rrd_t *rrd, uint8_t tier, uint8_t sensor, uint8_t column)
+{
+    const rrd_tier_t *t = (const rrd_tier_t *)(rrd->base + RRD_TIER_OFFSET) + tier;
+    
+    return (uint32_t *)(rrd->base + t->offset + (size_t)sensor * t->rows * RRD_ROW_SIZE) + (size_t)column * t->rows;
+}
+
+/**
+ * @brief     store one value of a row
+ * @param[in] *cell pointer to a row cell
+ * @param[in] value stored value
+ * @note      the cell is written atomically because a reader may copy it at the same time
+ */
+static void a_rrd_store(uint32_t *cell, float value)
+{
+    uint32_t bits;
+    
+    memcpy(&bits, &value, sizeof(float));                 /* get the bits */
+    __atomic_store_n(cell, bits, __ATOMIC_RELAXED);       /* store the bits */
+}
+
+/**
+ * @brief     get the file size
+ * @param[in] sensor_num sensor numbers
+ * @param[in] *tier pointer to a tier table
+ * @param[in] tier_num tier numbers
+ * @return    file size
+ * @note      none
+ */
+static uint64_t a_rrd_size(uint8_t sensor_num, const opt300x_rrd_tier_t *tier, uint8_t tier_num)
+{
+    uint8_t i;
+    uint64_t size = RRD_DATA_OFFSET;
+    
+    for (i = 0; i < tier_num; i++)
+    {
+        size += (uint64_t)tier[i].rows * RRD_ROW_SIZE * sensor_num;
+    }
+    
+    return size;
+}
+
+/**
+ * @brief     map a file and load the layout
+ * @param[in] *rrd pointer to an rrd structure
+ * @param[in] size file size
+ * @param[in] writable writable flag
+ * @return    status code
+ *            - 0 success
+ *            - 1 map failed
+ *            - 4 file is invalid
+ * @note      the file stays mapped on success only
+ */
+static uint8_t a_rrd_map(opt300x_rrd_t *rrd, uint64_t size, uint8_t writable)
+{
+    uint8_t i;
+    void *base;
+    const rrd_header_t *header;
+    const rrd_tier_t *tier;
+    
+    if (size < RRD_DATA_OFFSET)                                                                 /* check the size */
+    {
+        return 4;                                                                               /* return error */
+    }
+    base = mmap(NULL, (size_t)size, (writable != 0) ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                MAP_SHARED, rrd->fd, 0);                                                        /* map the file */
+    if (base == MAP_FAILED)                                                                     /* check the result */
+    {
+        return 1;                                                                               /* return error */
+    }
+    rrd->base = (uint8_t *)base;                                                                /* set the base */
+    rrd->size = (size_t)size;                                                                   /* set the size */
+    rrd->writable = writable;                                                                   /* set the flag */
+    header = (const rrd_header_t *)rrd->base;                                                   /* get the header */
+    tier = (const rrd_tier_t *)(rrd->base + RRD_TIER_OFFSET);                                   /* get the tiers */
+    if ((__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != RRD_MAGIC) ||
+        (header->version != OPT300X_RRD_VERSION) ||
+        (header->sensor_num == 0) || (header->sensor_num > OPT300X_RRD_MAX_SENSOR) ||
+        (header->tier_num == 0) || (header->tier_num > OPT300X_RRD_MAX_TIER))                   /* check the header */
+    {
+        (void)munmap(base, (size_t)size);                                                       /* unmap the file */
+        rrd->base = NULL;                                                                       /* clear the base */
+        
+        return 4;                                                                               /* return error */
+    }
+    rrd->sensor_num = header->sensor_num;                                                       /* set the sensor numbers */
+    rrd->tier_num = header->tier_num;                                                           /* set the tier numbers */
+    for (i = 0; i < rrd->tier_num; i++)                                                         /* load the tiers */
+    {
+        rrd->tier[i].step_us = tier[i].step_us;                                                 /* set the step */
+        rrd->tier[i].rows = tier[i].rows;                                                       /* set the rows */
+        if ((tier[i].step_us == 0) || (tier[i].rows == 0) ||
+            (tier[i].offset + (uint64_t)tier[i].rows * RRD_ROW_SIZE * rrd->sensor_num > size))  /* check the tier */
+        {
+            (void)munmap(base, (size_t)size);                                                   /* unmap the file */
+            rrd->base = NULL;                                                                   /* clear the base */
+            
+            return 4;                                                                           /* return error */
+        }
+    }
+    for (i = 0; i < OPT300X_RRD_MAX_SENSOR; i++)                                                /* set the lsb weight */
+    {
+        if (header->type[i] == (uint8_t)OPT3002)                                                /* opt3002 */
+        {
+            rrd->weight[i] = 1.2f;                                                              /* nW/cm2 */
+        }
+        else if (header->type[i] == (uint8_t)OPT3005)                                           /* opt3005 */
+        {
+            rrd->weight[i] = 0.02f;                                                             /* lux */
+        }
+        else                                                                                    /* the others */
+        {
+            rrd->weight[i] = 0.01f;                                                             /* lux */
+        }
+    }
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     create or continue a round robin database
+ * @param[in] *rrd pointer to an rrd structure
+ * @param[in] *path pointer to a file path
+ * @param[in] *sensor pointer to a sensor table, the index is the sensor id
+ * @param[in] sensor_num sensor numbers
+ * @param[in] *tier pointer to a tier table, from the finest to the coarsest
+ * @param[in] tier_num tier numbers
+ * @return    status code
+ *            - 0 success
+ *            - 1 create failed
+ *            - 2 handle is NULL
+ *            - 4 param is invalid
+ *            - 5 the existing file has another layout
+ * @note      an existing file with the same sensors and tiers is continued
+ */
+uint8_t opt300x_rrd_create(opt300x_rrd_t *rrd, const char *path, const opt300x_rrd_sensor_t *sensor, uint8_t sensor_num,
+                           const opt300x_rrd_tier_t *tier, uint8_t tier_num)
+{
+    uint8_t i;
+    uint8_t res;
+    uint64_t size;
+    uint64_t offset;
+    struct stat st;
+    rrd_header_t header;
+    
+    if (rrd == NULL)                                                                            /* check rrd */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if ((path == NULL) || (sensor == NULL) || (tier == NULL) ||
+        (sensor_num == 0) || (sensor_num > OPT300X_RRD_MAX_SENSOR) ||
+        (tier_num == 0) || (tier_num > OPT300X_RRD_MAX_TIER))                                   /* check the param */
+    {
+        return 4;                                                                               /* return error */
+    }
+    for (i = 0; i < tier_num; i++)                                                              /* check the tiers */
+    {
+        if ((tier[i].step_us == 0) || (tier[i].rows == 0) ||
+            ((i != 0) && (tier[i].step_us % tier[i - 1].step_us != 0)))                         /* steps must nest */
+        {
+            return 4;                                                                           /* return error */
+        }
+    }
+    
+    memset(&header, 0, sizeof(rrd_header_t));                                                   /* clear the header */
+    header.version = OPT300X_RRD_VERSION;                                                       /* set the version */
+    header.sensor_num = sensor_num;                                                             /* set the sensor numbers */
+    header.tier_num = tier_num;                                                                 /* set the tier numbers */
+    for (i = 0; i < sensor_num; i++)                                                            /* set the sensor table */
+    {
+        header.type[i] = (uint8_t)sensor[i].type;                                               /* set the type */
+        header.addr[i] = (uint8_t)sensor[i].addr;                                               /* set the address */
+    }
+    size = a_rrd_size(sensor_num, tier, tier_num);                                              /* file size */
+    rrd->base = NULL;                                                                           /* not mapped */
+    rrd->fd = open(path, O_RDWR | O_CREAT, 0644);                                               /* open the file */
+    if (rrd->fd < 0)                                                                            /* check the result */
+    {
+        return 1;                                                                               /* return error */
+    }
+    if (fstat(rrd->fd, &st) != 0)                                                               /* get the size */
+    {
+        (void)close(rrd->fd);                                                                   /* close the file */
+        
+        return 1;                                                                               /* return error */
+    }
+    if (st.st_size == 0)                                                                        /* new file */
+    {
+        rrd_tier_t *t;
+        
+        if (ftruncate(rrd->fd, (off_t)size) != 0)                                               /* sparse file of the full size */
+        {
+            (void)close(rrd->fd);                                                               /* close the file */
+            
+            return 1;                                                                           /* return error */
+        }
+        rrd->base = (uint8_t *)mmap(NULL, (size_t)size, PROT_READ | PROT_WRITE, MAP_SHARED, rrd->fd, 0);
+        if ((void *)rrd->base == MAP_FAILED)                                                    /* check the result */
+        {
+            rrd->base = NULL;                                                                   /* clear the base */
+            (void)close(rrd->fd);                                                               /* close the file */
+            
+            return 1;                                                                           /* return error */
+        }
+        memcpy(rrd->base, &header, sizeof(rrd_header_t));                                       /* write the header */
+        t = (rrd_tier_t *)(rrd->base + RRD_TIER_OFFSET);                                        /* get the tiers */
+        offset = RRD_DATA_OFFSET;                                                               /* first tier data */
+        for (i = 0; i < tier_num; i++)                                                          /* write the tiers */
+        {
+            t[i].step_us = tier[i].step_us;                                                     /* set the step */
+            t[i].rows = tier[i].rows;                                                           /* set the rows */
+            t[i].offset = offset;                                                               /* set the offset */
+            offset += (uint64_t)tier[i].rows * RRD_ROW_SIZE * sensor_num;                       /* next tier */
+        }
+        __atomic_store_n(&((rrd_header_t *)rrd->base)->magic, RRD_MAGIC, __ATOMIC_RELEASE);     /* publish the layout */
+        (void)munmap(rrd->base, (size_t)size);                                                  /* unmap, mapped again below */
+        rrd->base = NULL;                                                                       /* clear the base */
+    }
+    else if ((uint64_t)st.st_size != size)                                                      /* another layout */
+    {
+        (void)close(rrd->fd);                                                                   /* close the file */
+        
+        return 5;                                                                               /* return error */
+    }
+    
+    res = a_rrd_map(rrd, size, 1);                                                              /* map the file */
+    if (res != 0)                                                                               /* check the result */
+    {
+        (void)close(rrd->fd);                                                                   /* close the file */
+        
+        return (res == 4) ? 5 : 1;                                                              /* return error */
+    }
+    if ((rrd->sensor_num != sensor_num) || (rrd->tier_num != tier_num) ||
+        (memcmp(((const rrd_header_t *)rrd->base)->type, header.type, sizeof(header.type)) != 0) ||
+        (memcmp(((const rrd_header_t *)rrd->base)->addr, header.addr, sizeof(header.addr)) != 0)) /* check the sensors */
+    {
+        (void)opt300x_rrd_close(rrd);                                                           /* close the rrd */
+        
+        return 5;                                                                               /* return error */
+    }
+    for (i = 0; i < tier_num; i++)                                                              /* check the tiers */
+    {
+        if ((rrd->tier[i].step_us != tier[i].step_us) || (rrd->tier[i].rows != tier[i].rows))
+        {
+            (void)opt300x_rrd_close(rrd);                                                       /* close the rrd */
+            
+            return 5;                                                                           /* return error */
+        }
+    }
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     open a round robin database for reading
+ * @param[in] *rrd pointer to an rrd structure
+ * @param[in] *path pointer to a file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 2 handle is NULL
+ *            - 4 file is invalid
+ * @note      the file is mapped read only, a writer may update it meanwhile
+ */
+uint8_t opt300x_rrd_open(opt300x_rrd_t *rrd, const char *path)
+{
+    uint8_t res;
+    struct stat st;
+    
+    if (rrd == NULL)                                                           /* check rrd */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (path == NULL)                                                          /* check path */
+    {
+        return 4;                                                              /* return error */
+    }
+    
+    rrd->base = NULL;                                                          /* not mapped */
+    rrd->fd = open(path, O_RDONLY);                                            /* open the file */
+    if (rrd->fd < 0)                                                           /* check the result */
+    {
+        return 1;                                                              /* return error */
+    }
+    if (fstat(rrd->fd, &st) != 0)                                              /* get the size */
+    {
+        (void)close(rrd->fd);                                                  /* close the file */
+        
+        return 1;                                                              /* return error */
+    }
+    res = a_rrd_map(rrd, (uint64_t)st.st_size, 0);                             /* map the file */
+    if (res != 0)                                                              /* check the result */
+    {
+        (void)close(rrd->fd);                                                  /* close the file */
+        
+        return res;                                                            /* return error */
+    }
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     close a round robin database
+ * @param[in] *rrd pointer to an rrd structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t opt300x_rrd_close(opt300x_rrd_t *rrd)
+{
+    if (rrd == NULL)                                                           /* check rrd */
+    {
+        return 2;                                                              /* return error */
+    }
+    
+    if (rrd->base != NULL)                                                     /* mapped */
+    {
+        if (rrd->writable != 0)                                                /* writer */
+        {
+            (void)msync(rrd->base, rrd->size, MS_ASYNC);                       /* schedule the write back */
+        }
+        (void)munmap(rrd->base, rrd->size);                                    /* unmap the file */
+        rrd->base = NULL;                                                      /* clear the base */
+    }
+    if (rrd->fd >= 0)                                                          /* opened */
+    {
+        (void)close(rrd->fd);                                                  /* close the file */
+        rrd->fd = -1;                                                          /* closed */
+    }
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     add one sample
+ * @param[in] *rrd pointer to an rrd structure
+ * @param[in] sensor sensor id
+ * @param[in] raw raw result word
+ * @param[in] timestamp_us sample timestamp
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 rrd is read only
+ *            - 4 sensor is invalid
+ *            - 5 timestamp is before the running period
+ * @note      every tier keeps a running period, a tier writes one row when its period ends,
+ *            so the work and the touched pages per sample don't depend on the retention
+ */
+uint8_t opt300x_rrd_update(opt300x_rrd_t *rrd, uint8_t sensor, uint16_t raw, uint64_t timestamp_us)
+{
+    uint8_t i;
+    float value;
+    
+    if ((rrd == NULL) || (rrd->base == NULL))                                                   /* check rrd */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (rrd->writable == 0)                                                                     /* check the mode */
+    {
+        return 3;                                                                               /* return error */
+    }
+    if (sensor >= rrd->sensor_num)                                                              /* check the sensor */
+    {
+        return 4;                                                                               /* return error */
+    }
+    if (timestamp_us / rrd->tier[0].step_us < a_rrd_state(rrd, 0, sensor)->period)              /* check the time */
+    {
+        return 5;                                                                               /* return error */
+    }
+    
+    value = rrd->weight[sensor] * (float)((uint32_t)(raw & 0x0FFF) << (raw >> 12));             /* convert */
+    for (i = 0; i < rrd->tier_num; i++)                                                         /* every tier */
+    {
+        rrd_state_t *state = a_rrd_state(rrd, i, sensor);
+        uint64_t period = timestamp_us / rrd->tier[i].step_us;
+        
+        if (period != state->period)                                                            /* the running period ended */
+        {
+            if (state->count != 0)                                                              /* write the row */
+            {
+                uint32_t row = (uint32_t)(state->period % rrd->tier[i].rows);
+                float avg = (float)(state->sum / (double)state->count);
+                
+                __atomic_store_n(&a_rrd_column(rrd, i, sensor, 0)[row], 0, __ATOMIC_RELAXED);   /* invalidate the row first */
+                __atomic_thread_fence(__ATOMIC_RELEASE);                                        /* order it before the values */
+                a_rrd_store(&a_rrd_column(rrd, i, sensor, 1)[row], avg);                        /* set the avg */
+                a_rrd_store(&a_rrd_column(rrd, i, sensor, 2)[row], state->min);                 /* set the min */
+                a_rrd_store(&a_rrd_column(rrd, i, sensor, 3)[row], state->max);                 /* set the max */
+                __atomic_store_n(&a_rrd_column(rrd, i, sensor, 0)[row],
+                                 (uint32_t)(state->period + 1), __ATOMIC_RELEASE);              /* stamp the row last */
+            }
+            state->period = period;                                                             /* new period */
+            state->sum = 0.0;                                                                   /* clear the sum */
+            state->count = 0;                                                                   /* clear the count */
+        }
+        if ((state->count == 0) || (value < state->min))                                        /* new min */
+        {
+            state->min = value;                                                                 /* set the min */
+        }
+        if ((state->count == 0) || (value > state->max))                                        /* new max */
+        {
+            state->max = value;                                                                 /* set the max */
+        }
+        state->sum += value;                                                                    /* add the value */
+        state->count++;                                                                         /* add the sample */
+    }
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     read a sensor and add the sample
+ * @param[in] *rrd pointer to an rrd structure
+ * @param[in] sensor sensor id
+ * @param[in] *handle pointer to an opt300x handle structure in continuous mode
+ * @param[in] timestamp_us sample timestamp
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle is NULL
+ *            - 3 rrd is read only
+ *            - 4 sensor is invalid
+ *            - 5 timestamp is before the running period
+ * @note      the timestamp is passed in since the history needs the wall clock
+ */
+uint8_t opt300x_rrd_read_update(opt300x_rrd_t *rrd, uint8_t sensor, opt300x_handle_t *handle, uint64_t timestamp_us)
+{
+    uint8_t res;
+    uint16_t raw;
+    float data;
+    
+    if ((rrd == NULL) || (handle == NULL))                                     /* check rrd and handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    
+    if (handle->type == (uint8_t)OPT3002)                                      /* opt3002 */
+    {
+        res = opt3002_continuous_read(handle, &raw, &data);                    /* read nW/cm2 */
+    }
+    else                                                                       /* the others */
+    {
+        res = opt300x_continuous_read(handle, &raw, &data);                    /* read lux */
+    }
+    if (res != 0)                                                              /* check the result */
+    {
+        return 1;                                                              /* return error */
+    }
+    
+    return opt300x_rrd_update(rrd, sensor, raw, timestamp_us);                 /* add the sample */
+}
+
+/**
+ * @brief     write the mapped pages back to the file
+ * @param[in] *rrd pointer to an rrd structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 sync failed
+ *            - 2 handle is NULL
+ * @note      asynchronous, the kernel writes back the dirty pages only
+ */
+uint8_t opt300x_rrd_sync(opt300x_rrd_t *rrd)
+{
+    if ((rrd == NULL) || (rrd->base == NULL))                                  /* check rrd */
+    {
+        return 2;                                                              /* return error */
+    }
+    
+    if (msync(rrd->base, rrd->size, MS_ASYNC) != 0)                            /* schedule the write back */
+    {
+        return 1;                                                              /* return error */
+    }
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      query a time range
+ * @param[in]  *rrd pointer to an rrd structure
+ * @param[in]  sensor sensor id
+ * @param[in]  cf consolidation function
+ * @param[in]  start_us range start
+ * @param[in]  end_us range end, excluded
+ * @param[out] *data pointer to a data buffer, NAN marks a row without samples
+ * @param[in]  size data buffer size
+ * @param[out] *num pointer to a row numbers buffer
+ * @param[out] *first_us pointer to a first row timestamp buffer
+ * @param[out] *step_us pointer to a row step buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 param is invalid
+ * @note       uses the finest tier whose retention covers the start, the rows end before the running period
+ */
+uint8_t opt300x_rrd_query(opt300x_rrd_t *rrd, uint8_t sensor, opt300x_rrd_cf_t cf, uint64_t start_us, uint64_t end_us,
+                          float *data, uint32_t size, uint32_t *num, uint64_t *first_us, uint64_t *step_us)
+{
+    uint8_t t;
+    uint32_t n;
+    uint32_t rows;
+    uint64_t step;
+    uint64_t cur;
+    uint64_t oldest;
+    uint64_t p;
+    uint64_t end;
+    const uint32_t *stamp;
+    const uint32_t *column;
+    
+    if ((rrd == NULL) || (rrd->base == NULL) || (data == NULL) ||
+        (num == NULL) || (first_us == NULL) || (step_us == NULL))                               /* check the buffers */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if ((sensor >= rrd->sensor_num) || (cf > OPT300X_RRD_CF_MAX) || (end_us <= start_us))       /* check the param */
+    {
+        return 4;                                                                               /* return error */
+    }
+    
+    for (t = 0; t < rrd->tier_num - 1; t++)                                                     /* finest tier covering the start */
+    {
+        cur = __atomic_load_n(&a_rrd_state(rrd, t, sensor)->period, __ATOMIC_RELAXED);          /* running period */
+        oldest = (cur >= rrd->tier[t].rows) ? (cur - rrd->tier[t].rows) : 0;                    /* oldest kept period */
+        if (start_us / rrd->tier[t].step_us >= oldest)                                          /* covered */
+        {
+            break;                                                                              /* break */
+        }
+    }
+    step = rrd->tier[t].step_us;                                                                /* row step */
+    rows = rrd->tier[t].rows;                                                                   /* rows */
+    cur = __atomic_load_n(&a_rrd_state(rrd, t, sensor)->period, __ATOMIC_RELAXED);              /* running period */
+    oldest = (cur >= rows) ? (cur - rows) : 0;                                                  /* oldest kept period */
+    p = start_us / step;                                                                        /* first period */
+    p = (p < oldest) ? oldest : p;                                                              /* clip to the retention */
+    end = (end_us + step - 1) / step;                                                           /* last period excluded */
+    end = (end > cur) ? cur : end;                                                              /* clip to the closed rows */
+    stamp = a_rrd_column(rrd, t, sensor, 0);                                                    /* stamps */
+    column = a_rrd_column(rrd, t, sensor, (uint8_t)(cf + 1));                                   /* values */
+    *first_us = p * step;                                                                       /* first row timestamp */
+    *step_us = step;                                                                            /* row step */
+    for (n = 0; (p < end) && (n < size); p++, n++)                                              /* every row */
+    {
+        uint32_t row = (uint32_t)(p % rows);
+        uint32_t value;
+        
+        if (__atomic_load_n(&stamp[row], __ATOMIC_ACQUIRE) != (uint32_t)(p + 1))                /* stale or never written */
+        {
+            data[n] = NAN;                                                                      /* no samples */
+            
+            continue;                                                                           /* next row */
+        }
+        value = __atomic_load_n(&column[row], __ATOMIC_RELAXED);                                /* copy the value */
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);                                                /* order the copy before the check */
+        if (__atomic_load_n(&stamp[row], __ATOMIC_RELAXED) != (uint32_t)(p + 1))                /* overwritten meanwhile */
+        {
+            data[n] = NAN;                                                                      /* no samples */
+            
+            continue;                                                                           /* next row */
+        }
+        memcpy(&data[n], &value, sizeof(float));                                                /* set the value */
+    }
+    *num = n;                                                                                   /* set the numbers */
+    
+    return 0;                                                                                   /* success return 0 */
+}
@@ -0,0 +1,265 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      opt300x_rrd_bench.c
+ * @brief     opt300x round robin database bench source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "opt300x_rrd.h"
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief bench definition
+ */
+#define BENCH_SENSOR        2                 /**< sensor numbers */
+#define BENCH_STEP_US       100000ULL         /**< 10 Hz */
+#define BENCH_ROWS          525600            /**< query buffer length */
+#define BENCH_QUERY         200               /**< queries of every range */
+
+/**
+ * @brief  get the monotonic time
+ * @return time in ns
+ * @note   none
+ */
+static uint64_t a_bench_now_ns(void)
+{
+    struct timespec t;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &t);
+    
+    return (uint64_t)t.tv_sec * 1000000000ULL + (uint64_t)t.tv_nsec;
+}
+
+/**
+ * @brief     get the raw word of a sample
+ * @param[in] n sample number
+ * @return    raw word
+ * @note      a slow daylight like ramp
+ */
+static uint16_t a_bench_raw(uint64_t n)
+{
+    uint64_t t = n % 864000;
+    
+    return (uint16_t)(((t / 72000) << 12) | (0x0800 + (n & 0x00FF)));
+}
+
+/**
+ * @brief     time one query range
+ * @param[in] *rrd pointer to an rrd structure
+ * @param[in] *name pointer to a range name
+ * @param[in] now_us current time
+ * @param[in] range_us range length
+ * @param[in] *data pointer to a data buffer
+ * @return    1 if the query failed
+ * @note      none
+ */
+static int a_bench_query(opt300x_rrd_t *rrd, const char *name, uint64_t now_us, uint64_t range_us, float *data)
+{
+    uint32_t i;
+    uint32_t j;
+    uint32_t num = 0;
+    uint32_t empty = 0;
+    uint64_t first = 0;
+    uint64_t step = 0;
+    uint64_t start;
+    double sum = 0.0;
+    
+    range_us = (range_us > now_us) ? now_us : range_us;
+    start = a_bench_now_ns();
+    for (i = 0; i < BENCH_QUERY; i++)
+    {
+        if (opt300x_rrd_query(rrd, (uint8_t)(i % BENCH_SENSOR), OPT300X_RRD_CF_AVG, now_us - range_us, now_us,
+                              data, BENCH_ROWS, &num, &first, &step) != 0)
+        {
+            return 1;
+        }
+        sum += data[num / 2];
+    }
+    for (j = 0; j < num; j++)
+    {
+        if (isnan(data[j]) != 0)
+        {
+            empty++;
+        }
+    }
+    printf("opt300x_rrd_bench: %s %u rows of %llu ms, %u empty, %.3f us/query (check %.1f).\n",
+           name, num, (unsigned long long)(step / 1000), empty,
+           (double)(a_bench_now_ns() - start) / 1e3 / BENCH_QUERY, sum);
+    
+    return 0;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    int errors = 0;
+    uint32_t days = 3;
+    uint64_t n;
+    uint64_t samples;
+    uint64_t now;
+    uint64_t start;
+    const char *path = "/tmp/opt300x_rrd_bench.rrd";
+    float *data;
+    struct stat st;
+    opt300x_rrd_t rrd;
+    opt300x_rrd_tier_t tier[] = OPT300X_RRD_DEFAULT_TIER;
+    opt300x_rrd_sensor_t sensor[BENCH_SENSOR] =
+    {
+        {OPT3001, OPT300X_ADDRESS_GND},
+        {OPT3002, OPT300X_ADDRESS_VCC},
+    };
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"days", required_argument, NULL, 1},
+        {"path", required_argument, NULL, 2},
+        {NULL, 0, NULL, 0},
+    };
+    
+    /* parse */
+    do
+    {
+        c = getopt_long(argc, argv, "h", long_options, &longindex);
+        switch (c)
+        {
+            case 1 :
+            {
+                days = (uint32_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            case 2 :
+            {
+                path = optarg;
+                
+                break;
+            }
+            case -1 :
+            {
+                break;
+            }
+            default :
+            {
+                printf("Usage:\n");
+                printf("  opt300x_rrd_bench [--days=<num>] [--path=<path>]\n");
+                
+                return (c == 'h') ? 0 : 1;
+            }
+        }
+    } while (c != -1);
+    if (days == 0)
+    {
+        printf("opt300x_rrd_bench: days must not be 0.\n");
+        
+        return 1;
+    }
+    
+    /* update */
+    data = (float *)malloc(BENCH_ROWS * sizeof(float));
+    if (data == NULL)
+    {
+        printf("opt300x_rrd_bench: malloc failed.\n");
+        
+        return 1;
+    }
+    (void)unlink(path);
+    if (opt300x_rrd_create(&rrd, path, sensor, BENCH_SENSOR, tier, sizeof(tier) / sizeof(tier[0])) != 0)
+    {
+        printf("opt300x_rrd_bench: create %s failed.\n", path);
+        free(data);
+        
+        return 1;
+    }
+    samples = (uint64_t)days * 864000ULL;
+    start = a_bench_now_ns();
+    for (n = 0; n < samples; n++)
+    {
+        uint8_t s;
+        
+        for (s = 0; s < BENCH_SENSOR; s++)
+        {
+            if (opt300x_rrd_update(&rrd, s, a_bench_raw(n), n * BENCH_STEP_US + 1000) != 0)
+            {
+                errors++;
+            }
+        }
+    }
+    printf("opt300x_rrd_bench: %u days at 10 Hz, update %.3f Msamples/s, %d errors.\n",
+           days, (double)(samples * BENCH_SENSOR) / ((double)(a_bench_now_ns() - start) / 1e3), errors);
+    (void)opt300x_rrd_close(&rrd);
+    
+    /* size */
+    if (stat(path, &st) != 0)
+    {
+        printf("opt300x_rrd_bench: stat %s failed.\n", path);
+        free(data);
+        
+        return 1;
+    }
+    printf("opt300x_rrd_bench: file %.1f MB, %.1f MB allocated, fixed for any run time.\n",
+           (double)st.st_size / 1e6, (double)st.st_blocks * 512.0 / 1e6);
+    
+    /* query */
+    if (opt300x_rrd_open(&rrd, path) != 0)
+    {
+        printf("opt300x_rrd_bench: open %s failed.\n", path);
+        free(data);
+        
+        return 1;
+    }
+    now = samples * BENCH_STEP_US;
+    errors += a_bench_query(&rrd, "last hour", now, 3600ULL * 1000000ULL, data);
+    errors += a_bench_query(&rrd, "last day", now, 86400ULL * 1000000ULL, data);
+    errors += a_bench_query(&rrd, "last year", now, 365ULL * 86400ULL * 1000000ULL, data);
+    (void)opt300x_rrd_close(&rrd);
+    (void)unlink(path);
+    free(data);
+    
+    return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,549 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      opt300x_rrd_test.c
+ * @brief     opt300x round robin database test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "opt300x_rrd_test.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief test definition
+ */
+#define OPT300X_RRD_TEST_PERIOD     10                                      /**< written fine periods */
+#define OPT300X_RRD_TEST_PATH       "/tmp/opt300x_rrd_test.rrd"             /**< test file path */
+
+/**
+ * @brief     check a float
+ * @param[in] a checked value
+ * @param[in] b expected value
+ * @return    status code
+ *            - 0 equal
+ *            - 1 not equal
+ * @note      none
+ */
+static uint8_t a_opt300x_rrd_test_near(float a, float b)
+{
+    return (fabsf(a - b) <= fabsf(b) * 1e-5f) ? 0 : 1;
+}
+
+/**
+ * @brief     check the rows of a query
+ * @param[in] *rrd pointer to an rrd structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      the fine tier serves a recent start, the coarse tier an old start
+ */
+static uint8_t a_opt300x_rrd_test_query(opt300x_rrd_t *rrd)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t num;
+    uint64_t first;
+    uint64_t step;
+    float data[16];
+    
+    res = opt300x_rrd_query(rrd, 0, OPT300X_RRD_CF_AVG, 2000, 9000, data, 16, &num, &first, &step);
+    if ((res != 0) || (num != 7) || (first != 2000) || (step != 1000))
+    {
+        opt300x_interface_debug_print("opt300x: check fine tier error.\n");
+        
+        return 1;
+    }
+    for (i = 0; i < num; i++)
+    {
+        if (a_opt300x_rrd_test_near(data[i], (150.0f + 10.0f * (float)(i + 2)) * 0.01f) != 0)
+        {
+            opt300x_interface_debug_print("opt300x: check fine tier row %u error.\n", (unsigned int)i);
+            
+            return 1;
+        }
+    }
+    opt300x_interface_debug_print("opt300x: check fine tier %s.\n", "ok");
+    res = opt300x_rrd_query(rrd, 0, OPT300X_RRD_CF_MIN, 0, 20000, data, 16, &num, &first, &step);
+    opt300x_interface_debug_print("opt300x: check coarse tier %s.\n",
+                                  ((res == 0) && (num == 2) && (first == 0) && (step == 4000) &&
+                                   (a_opt300x_rrd_test_near(data[0], 1.0f) == 0) && (a_opt300x_rrd_test_near(data[1], 1.4f) == 0)) ? "ok" : "error");
+    if ((res != 0) || (num != 2) || (first != 0) || (step != 4000) ||
+        (a_opt300x_rrd_test_near(data[0], 1.0f) != 0) || (a_opt300x_rrd_test_near(data[1], 1.4f) != 0))
+    {
+        return 1;
+    }
+    res = opt300x_rrd_query(rrd, 0, OPT300X_RRD_CF_MAX, 2000, 9000, data, 1, &num, &first, &step);
+    opt300x_interface_debug_print("opt300x: check short buffer %s.\n",
+                                  ((res == 0) && (num == 1) && (a_opt300x_rrd_test_near(data[0], 2.2f) == 0)) ? "ok" : "error");
+    if ((res != 0) || (num != 1) || (a_opt300x_rrd_test_near(data[0], 2.2f) != 0))
+    {
+        return 1;
+    }
+    res = opt300x_rrd_query(rrd, 1, OPT300X_RRD_CF_AVG, 2000, 5000, data, 16, &num, &first, &step);
+    opt300x_interface_debug_print("opt300x: check empty rows %s.\n",
+                                  ((res == 0) && (num == 3) && (a_opt300x_rrd_test_near(data[0], 12.0f) == 0) &&
+                                   isnan(data[1]) && isnan(data[2])) ? "ok" : "error");
+    if ((res != 0) || (num != 3) || (a_opt300x_rrd_test_near(data[0], 12.0f) != 0) || !isnan(data[1]) || !isnan(data[2]))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     run the round robin database test
+ * @param[in] *path pointer to a file path
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      none
+ */
+static uint8_t a_opt300x_rrd_test_run(const char *path)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t num;
+    uint64_t first;
+    uint64_t step;
+    float data[16];
+    char bad[128];
+    FILE *fp;
+    opt300x_rrd_t rrd;
+    opt300x_handle_t handle;
+    static uint8_t garbage[4096];
+    opt300x_rrd_sensor_t sensor[2] = {{OPT3001, OPT300X_ADDRESS_GND}, {OPT3002, OPT300X_ADDRESS_VCC}};
+    opt300x_rrd_sensor_t other[2] = {{OPT3001, OPT300X_ADDRESS_GND}, {OPT3001, OPT300X_ADDRESS_VCC}};
+    opt300x_rrd_tier_t tier[2] = {{1000, 8}, {4000, 4}};
+    opt300x_rrd_tier_t tier_bad[2] = {{1000, 8}, {1500, 4}};
+    
+    /* start round robin database test */
+    opt300x_interface_debug_print("opt300x: start round robin database test.\n");
+    (void)unlink(path);
+    
+    /* opt300x_rrd_create test */
+    opt300x_interface_debug_print("opt300x: opt300x_rrd_create test.\n");
+    res = opt300x_rrd_create(NULL, path, sensor, 2, tier, 2);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_rrd_create(&rrd, NULL, sensor, 2, tier, 2);
+    opt300x_interface_debug_print("opt300x: check null path %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_rrd_create(&rrd, path, NULL, 2, tier, 2);
+    opt300x_interface_debug_print("opt300x: check null sensor table %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_rrd_create(&rrd, path, sensor, 2, NULL, 2);
+    opt300x_interface_debug_print("opt300x: check null tier table %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_rrd_create(&rrd, path, sensor, 0, tier, 2);
+    opt300x_interface_debug_print("opt300x: check no sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_rrd_create(&rrd, path, sensor, OPT300X_RRD_MAX_SENSOR + 1, tier, 2);
+    opt300x_interface_debug_print("opt300x: check too many sensors %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_rrd_create(&rrd, path, sensor, 2, tier, 0);
+    opt300x_interface_debug_print("opt300x: check no tier %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_rrd_create(&rrd, path, sensor, 2, tier, OPT300X_RRD_MAX_TIER + 1);
+    opt300x_interface_debug_print("opt300x: check too many tiers %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_rrd_create(&rrd, path, sensor, 2, tier_bad, 2);
+    opt300x_interface_debug_print("opt300x: check steps not nested %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    tier_bad[1].step_us = 4000;
+    tier_bad[1].rows = 0;
+    res = opt300x_rrd_create(&rrd, path, sensor, 2, tier_bad, 2);
+    opt300x_interface_debug_print("opt300x: check no rows %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    tier_bad[0].step_us = 0;
+    res = opt300x_rrd_create(&rrd, path, sensor, 2, tier_bad, 1);
+    opt300x_interface_debug_print("opt300x: check empty step %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_rrd_create(&rrd, "/nonexistent/opt300x_rrd_test.rrd", sensor, 2, tier, 2);
+    opt300x_interface_debug_print("opt300x: check missing directory %s.\n", (res == 1) ? "ok" : "error");
+    if (res != 1)
+    {
+        return 1;
+    }
+    res = opt300x_rrd_create(&rrd, path, sensor, 2, tier, 2);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: create %s failed.\n", path);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check create %s.\n", "ok");
+    
+    /* opt300x_rrd_update test */
+    opt300x_interface_debug_print("opt300x: opt300x_rrd_update test.\n");
+    res = opt300x_rrd_update(NULL, 0, 100, 100);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        (void)opt300x_rrd_close(&rrd);
+        
+        return 1;
+    }
+    res = opt300x_rrd_update(&rrd, 2, 100, 100);
+    opt300x_interface_debug_print("opt300x: check invalid sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        (void)opt300x_rrd_close(&rrd);
+        
+        return 1;
+    }
+    for (i = 0; i < OPT300X_RRD_TEST_PERIOD; i++)
+    {
+        if ((opt300x_rrd_update(&rrd, 0, (uint16_t)(100 + 10 * i), 1000 * (uint64_t)i + 100) != 0) ||
+            (opt300x_rrd_update(&rrd, 0, (uint16_t)(200 + 10 * i), 1000 * (uint64_t)i + 600) != 0))
+        {
+            opt300x_interface_debug_print("opt300x: update failed.\n");
+            (void)opt300x_rrd_close(&rrd);
+            
+            return 1;
+        }
+    }
+    if ((opt300x_rrd_update(&rrd, 1, 10, 2500) != 0) || (opt300x_rrd_update(&rrd, 1, 10, 5500) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: update failed.\n");
+        (void)opt300x_rrd_close(&rrd);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check update %s.\n", "ok");
+    res = opt300x_rrd_update(&rrd, 0, 100, 8500);
+    opt300x_interface_debug_print("opt300x: check late sample %s.\n", (res == 5) ? "ok" : "error");
+    if (res != 5)
+    {
+        (void)opt300x_rrd_close(&rrd);
+        
+        return 1;
+    }
+    
+    /* opt300x_rrd_read_update test */
+    opt300x_interface_debug_print("opt300x: opt300x_rrd_read_update test.\n");
+    memset(&handle, 0, sizeof(opt300x_handle_t));
+    res = opt300x_rrd_read_update(NULL, 0, &handle, 10000);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        (void)opt300x_rrd_close(&rrd);
+        
+        return 1;
+    }
+    res = opt300x_rrd_read_update(&rrd, 0, NULL, 10000);
+    opt300x_interface_debug_print("opt300x: check null chip handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        (void)opt300x_rrd_close(&rrd);
+        
+        return 1;
+    }
+    res = opt300x_rrd_read_update(&rrd, 0, &handle, 10000);
+    opt300x_interface_debug_print("opt300x: check not inited chip %s.\n", (res == 1) ? "ok" : "error");
+    if (res != 1)
+    {
+        (void)opt300x_rrd_close(&rrd);
+        
+        return 1;
+    }
+    
+    /* opt300x_rrd_query test */
+    opt300x_interface_debug_print("opt300x: opt300x_rrd_query test.\n");
+    res = opt300x_rrd_query(NULL, 0, OPT300X_RRD_CF_AVG, 0, 9000, data, 16, &num, &first, &step);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        (void)opt300x_rrd_close(&rrd);
+        
+        return 1;
+    }
+    res = opt300x_rrd_query(&rrd, 0, OPT300X_RRD_CF_AVG, 0, 9000, NULL, 16, &num, &first, &step);
+    opt300x_interface_debug_print("opt300x: check null data %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        (void)opt300x_rrd_close(&rrd);
+        
+        return 1;
+    }
+    res = opt300x_rrd_query(&rrd, 0, OPT300X_RRD_CF_AVG, 0, 9000, data, 16, NULL, &first, &step);
+    opt300x_interface_debug_print("opt300x: check null num %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        (void)opt300x_rrd_close(&rrd);
+        
+        return 1;
+    }
+    res = opt300x_rrd_query(&rrd, 0, OPT300X_RRD_CF_AVG, 0, 9000, data, 16, &num, NULL, &step);
+    opt300x_interface_debug_print("opt300x: check null first %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        (void)opt300x_rrd_close(&rrd);
+        
+        return 1;
+    }
+    res = opt300x_rrd_query(&rrd, 0, OPT300X_RRD_CF_AVG, 0, 9000, data, 16, &num, &first, NULL);
+    opt300x_interface_debug_print("opt300x: check null step %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        (void)opt300x_rrd_close(&rrd);
+        
+        return 1;
+    }
+    res = opt300x_rrd_query(&rrd, 2, OPT300X_RRD_CF_AVG, 0, 9000, data, 16, &num, &first, &step);
+    opt300x_interface_debug_print("opt300x: check invalid sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        (void)opt300x_rrd_close(&rrd);
+        
+        return 1;
+    }
+    res = opt300x_rrd_query(&rrd, 0, (opt300x_rrd_cf_t)(OPT300X_RRD_CF_MAX + 1), 0, 9000, data, 16, &num, &first, &step);
+    opt300x_interface_debug_print("opt300x: check invalid cf %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        (void)opt300x_rrd_close(&rrd);
+        
+        return 1;
+    }
+    res = opt300x_rrd_query(&rrd, 0, OPT300X_RRD_CF_AVG, 9000, 9000, data, 16, &num, &first, &step);
+    opt300x_interface_debug_print("opt300x: check empty range %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        (void)opt300x_rrd_close(&rrd);
+        
+        return 1;
+    }
+    if (a_opt300x_rrd_test_query(&rrd) != 0)
+    {
+        (void)opt300x_rrd_close(&rrd);
+        
+        return 1;
+    }
+    
+    /* opt300x_rrd_sync test */
+    opt300x_interface_debug_print("opt300x: opt300x_rrd_sync test.\n");
+    res = opt300x_rrd_sync(NULL);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        (void)opt300x_rrd_close(&rrd);
+        
+        return 1;
+    }
+    res = opt300x_rrd_sync(&rrd);
+    opt300x_interface_debug_print("opt300x: check sync %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        (void)opt300x_rrd_close(&rrd);
+        
+        return 1;
+    }
+    
+    /* opt300x_rrd_close test */
+    opt300x_interface_debug_print("opt300x: opt300x_rrd_close test.\n");
+    res = opt300x_rrd_close(NULL);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        (void)opt300x_rrd_close(&rrd);
+        
+        return 1;
+    }
+    res = opt300x_rrd_close(&rrd);
+    opt300x_interface_debug_print("opt300x: check close %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* continue test */
+    opt300x_interface_debug_print("opt300x: continue test.\n");
+    res = opt300x_rrd_create(&rrd, path, sensor, 2, tier, 1);
+    opt300x_interface_debug_print("opt300x: check another tier table %s.\n", (res == 5) ? "ok" : "error");
+    if (res != 5)
+    {
+        return 1;
+    }
+    res = opt300x_rrd_create(&rrd, path, other, 2, tier, 2);
+    opt300x_interface_debug_print("opt300x: check another sensor table %s.\n", (res == 5) ? "ok" : "error");
+    if (res != 5)
+    {
+        return 1;
+    }
+    res = opt300x_rrd_create(&rrd, path, sensor, 2, tier, 2);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: create %s failed.\n", path);
+        
+        return 1;
+    }
+    res = opt300x_rrd_update(&rrd, 0, 100, 8500);
+    opt300x_interface_debug_print("opt300x: check kept period %s.\n", (res == 5) ? "ok" : "error");
+    if (res != 5)
+    {
+        (void)opt300x_rrd_close(&rrd);
+        
+        return 1;
+    }
+    res = a_opt300x_rrd_test_query(&rrd);
+    (void)opt300x_rrd_close(&rrd);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* opt300x_rrd_open test */
+    opt300x_interface_debug_print("opt300x: opt300x_rrd_open test.\n");
+    res = opt300x_rrd_open(NULL, path);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_rrd_open(&rrd, NULL);
+    opt300x_interface_debug_print("opt300x: check null path %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_rrd_open(&rrd, "/nonexistent/opt300x_rrd_test.rrd");
+    opt300x_interface_debug_print("opt300x: check missing file %s.\n", (res == 1) ? "ok" : "error");
+    if (res != 1)
+    {
+        return 1;
+    }
+    (void)snprintf(bad, sizeof(bad), "%s.bad", path);
+    fp = fopen(bad, "wb");
+    if (fp == NULL)
+    {
+        opt300x_interface_debug_print("opt300x: create %s failed.\n", bad);
+        
+        return 1;
+    }
+    memset(garbage, 0x5A, sizeof(garbage));
+    (void)fwrite(garbage, 1, sizeof(garbage), fp);
+    (void)fclose(fp);
+    res = opt300x_rrd_open(&rrd, bad);
+    opt300x_interface_debug_print("opt300x: check invalid file %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        (void)unlink(bad);
+        
+        return 1;
+    }
+    res = opt300x_rrd_create(&rrd, bad, sensor, 2, tier, 2);
+    (void)unlink(bad);
+    opt300x_interface_debug_print("opt300x: check continue an invalid file %s.\n", (res == 5) ? "ok" : "error");
+    if (res != 5)
+    {
+        return 1;
+    }
+    res = opt300x_rrd_open(&rrd, path);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: open %s failed.\n", path);
+        
+        return 1;
+    }
+    res = opt300x_rrd_update(&rrd, 0, 100, 20000);
+    opt300x_interface_debug_print("opt300x: check read only %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        (void)opt300x_rrd_close(&rrd);
+        
+        return 1;
+    }
+    res = a_opt300x_rrd_test_query(&rrd);
+    (void)opt300x_rrd_close(&rrd);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* finish round robin database test */
+    opt300x_interface_debug_print("opt300x: finish round robin database test.\n");
+    
+    return 0;
+}
+
+/**
+ * @brief  round robin database test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   none
+ */
+uint8_t opt300x_rrd_test(void)
+{
+    uint8_t res;
+    
+    res = a_opt300x_rrd_test_run(OPT300X_RRD_TEST_PATH);
+    (void)unlink(OPT300X_RRD_TEST_PATH);
+    
+    return res;
+}
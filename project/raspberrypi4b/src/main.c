@@ -37,6 +37,19 @@
 #include "driver_opt300x_interrupt_test.h"
 #include "driver_opt300x_read_test.h"
 #include "driver_opt300x_register_test.h"
+#include "driver_opt300x_pubsub_test.h"
+#include "driver_opt300x_codec_test.h"
+#include "driver_opt300x_window_test.h"
+#include "driver_opt300x_filter_test.h"
+#include "driver_opt300x_dli_test.h"
+#include "driver_opt300x_resample_test.h"
+#include "driver_opt300x_calib_test.h"
+#include "driver_opt300x_fusion_test.h"
+#include "driver_opt300x_frame_test.h"
+#include "opt300xd_shm_test.h"
+#include "opt300x_binlog_test.h"
+#include "opt300x_rrd_test.h"
+#include "opt300xd_protocol_test.h"
 #include "driver_opt300x_interrupt.h"
 #include "driver_opt300x_shot.h"
 #include "driver_opt300x_basic.h"
@@ -341,6 +354,136 @@ uint8_t opt300x(uint8_t argc, char **argv)
         
         return 0;
     }
+    else if (strcmp("t_shm", type) == 0)
+    {
+        /* run shm test */
+        if (opt300xd_shm_test() != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_pubsub", type) == 0)
+    {
+        /* run pubsub test */
+        if (opt300x_pubsub_test(chip_type, addr, times) != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_binlog", type) == 0)
+    {
+        /* run binlog test */
+        if (opt300x_binlog_test() != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_codec", type) == 0)
+    {
+        /* run codec test */
+        if (opt300x_codec_test() != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_window", type) == 0)
+    {
+        /* run window test */
+        if (opt300x_window_test() != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_rrd", type) == 0)
+    {
+        /* run rrd test */
+        if (opt300x_rrd_test() != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_filter", type) == 0)
+    {
+        /* run filter test */
+        if (opt300x_filter_test() != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_dli", type) == 0)
+    {
+        /* run dli test */
+        if (opt300x_dli_test() != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_resample", type) == 0)
+    {
+        /* run resample test */
+        if (opt300x_resample_test() != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_calib", type) == 0)
+    {
+        /* run calib test */
+        if (opt300x_calib_test() != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_fusion", type) == 0)
+    {
+        /* run fusion test */
+        if (opt300x_fusion_test(chip_type, addr, times) != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_frame", type) == 0)
+    {
+        /* run frame test */
+        if (opt300x_frame_test(chip_type, addr, times) != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("t_protocol", type) == 0)
+    {
+        /* run protocol test */
+        if (opt300xd_protocol_test() != 0)
+        {
+            return 1;
+        }
+        
+        return 0;
+    }
     else if (strcmp("e_read", type) == 0)
     {
         uint8_t res;
@@ -555,6 +698,22 @@ uint8_t opt300x(uint8_t argc, char **argv)
         opt300x_interface_debug_print("  opt300x (-t int | --test=int) [--type=<OPT3001 | OPT3002 | OPT3004 | OPT3005 | OPT3006 | OPT3007>]");
         opt300x_interface_debug_print(" [--addr=<VCC | GND | SCL | SDA>] [--times=<num>]\n");
         opt300x_interface_debug_print("          [--low-threshold=<low>] [--high-threshold=<high>]\n");
+        opt300x_interface_debug_print("  opt300x (-t shm | --test=shm)\n");
+        opt300x_interface_debug_print("  opt300x (-t pubsub | --test=pubsub) [--type=<OPT3001 | OPT3002 | OPT3004 | OPT3005 | OPT3006 | OPT3007>]");
+        opt300x_interface_debug_print(" [--addr=<VCC | GND | SCL | SDA>] [--times=<num>]\n");
+        opt300x_interface_debug_print("  opt300x (-t binlog | --test=binlog)\n");
+        opt300x_interface_debug_print("  opt300x (-t codec | --test=codec)\n");
+        opt300x_interface_debug_print("  opt300x (-t window | --test=window)\n");
+        opt300x_interface_debug_print("  opt300x (-t rrd | --test=rrd)\n");
+        opt300x_interface_debug_print("  opt300x (-t filter | --test=filter)\n");
+        opt300x_interface_debug_print("  opt300x (-t dli | --test=dli)\n");
+        opt300x_interface_debug_print("  opt300x (-t resample | --test=resample)\n");
+        opt300x_interface_debug_print("  opt300x (-t calib | --test=calib)\n");
+        opt300x_interface_debug_print("  opt300x (-t fusion | --test=fusion) [--type=<OPT3001 | OPT3002 | OPT3004 | OPT3005 | OPT3006 | OPT3007>]");
+        opt300x_interface_debug_print(" [--addr=<VCC | GND | SCL | SDA>] [--times=<num>]\n");
+        opt300x_interface_debug_print("  opt300x (-t frame | --test=frame) [--type=<OPT3001 | OPT3002 | OPT3004 | OPT3005 | OPT3006 | OPT3007>]");
+        opt300x_interface_debug_print(" [--addr=<VCC | GND | SCL | SDA>] [--times=<num>]\n");
+        opt300x_interface_debug_print("  opt300x (-t protocol | --test=protocol)\n");
         opt300x_interface_debug_print("  opt300x (-e read | --example=read) [--type=<OPT3001 | OPT3002 | OPT3004 | OPT3005 | OPT3006 | OPT3007>]");
         opt300x_interface_debug_print(" [--addr=<VCC | GND | SCL | SDA>] [--times=<num>]\n");
         opt300x_interface_debug_print("  opt300x (-e shot | --example=shot) [--type=<OPT3001 | OPT3002 | OPT3004 | OPT3005 | OPT3006 | OPT3007>]");
@@ -572,7 +731,7 @@ uint8_t opt300x(uint8_t argc, char **argv)
         opt300x_interface_debug_print("  -i, --information                     Show the chip information.\n");
         opt300x_interface_debug_print("      --low-threshold=<low>             Set the interrupt low threshold.([default: 50.0])\n");
         opt300x_interface_debug_print("  -p, --port                            Display the pin connections of the current board.\n");
-        opt300x_interface_debug_print("  -t <reg | read | int>, --test=<reg | read | int>\n");
+        opt300x_interface_debug_print("  -t <reg | read | int | shm | pubsub | binlog | codec | window | rrd | filter | dli | resample | calib | fusion | frame | protocol>, --test=<reg | read | int | shm | pubsub | binlog | codec | window | rrd | filter | dli | resample | calib | fusion | frame | protocol>\n");
         opt300x_interface_debug_print("                                        Run the driver test.\n");
         opt300x_interface_debug_print("      --type=<OPT3001 | OPT3002 | OPT3004 | OPT3005 | OPT3006 | OPT3007>\n");
         opt300x_interface_debug_print("                                        Set the chip type.([default: OPT3001])\n");
@@ -642,6 +801,9 @@ int main(uint8_t argc, char **argv)
     {
         opt300x_interface_debug_print("opt300x: unknown status code.\n");
     }
+    
+    /* output the deferred messages */
+    opt300x_interface_debug_flush();
 
     return 0;
 }
@@ -40,16 +40,30 @@
 #include "uart.h"
 #include <stdarg.h>
 
+/**
+ * @brief iic reference definition
+ */
+static uint32_t gs_iic_ref = 0;        /**< iic reference counter */
+
 /**
  * @brief  interface iic bus init
  * @return status code
  *         - 0 success
  *         - 1 iic init failed
- * @note   none
+ * @note   reference counted, so several handles can share the bus
  */
 uint8_t opt300x_interface_iic_init(void)
 {
-    return iic_init();
+    if (gs_iic_ref == 0)
+    {
+        if (iic_init() != 0)
+        {
+            return 1;
+        }
+    }
+    gs_iic_ref++;
+    
+    return 0;
 }
 
 /**
@@ -57,11 +71,24 @@ uint8_t opt300x_interface_iic_init(void)
  * @return status code
  *         - 0 success
  *         - 1 iic deinit failed
- * @note   none
+ * @note   the bus is closed by the last reference
  */
 uint8_t opt300x_interface_iic_deinit(void)
 {
-    return iic_deinit();
+    if (gs_iic_ref == 0)
+    {
+        return 1;
+    }
+    if (gs_iic_ref == 1)
+    {
+        if (iic_deinit() != 0)
+        {
+            return 1;
+        }
+    }
+    gs_iic_ref--;
+    
+    return 0;
 }
 
 /**
@@ -96,6 +123,36 @@ uint8_t opt300x_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uin
     return iic_write(addr, reg, buf, len);
 }
 
+/**
+ * @brief      interface iic bus read command
+ * @param[in]  addr iic device write address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t opt300x_interface_iic_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    return iic_read_cmd(addr, buf, len);
+}
+
+/**
+ * @brief     interface iic bus write command
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t opt300x_interface_iic_write_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    return iic_write_cmd(addr, buf, len);
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -126,6 +183,94 @@ void opt300x_interface_debug_print(const char *const fmt, ...)
     (void)uart_write((uint8_t *)str, len);
 }
 
+/**
+ * @brief     interface log driver debug data
+ * @param[in] fmt format data
+ * @note      the deferred mode prints at once because the uart output is synchronous
+ */
+void opt300x_interface_debug_log(const char *const fmt, ...)
+{
+#if (OPT300X_INTERFACE_DEBUG_MODE != OPT300X_INTERFACE_DEBUG_MODE_OFF)
+    char str[256];
+    uint16_t len;
+    va_list args;
+    
+    memset((char *)str, 0, sizeof(char) * 256); 
+    va_start(args, fmt);
+    vsnprintf((char *)str, 255, (char const *)fmt, args);
+    va_end(args);
+    
+    len = strlen((char *)str);
+    (void)uart_write((uint8_t *)str, len);
+#else
+    (void)fmt;
+#endif
+}
+
+/**
+ * @brief interface format and output all deferred messages
+ * @note  the uart output is synchronous, so nothing is deferred on this board
+ */
+void opt300x_interface_debug_flush(void)
+{
+    
+}
+
+/**
+ * @brief      interface mutex init
+ * @param[out] **mutex pointer to a mutex context buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 mutex init failed
+ * @note       the board runs a single context, so no mutex is created
+ */
+uint8_t opt300x_interface_mutex_init(void **mutex)
+{
+    *mutex = NULL;
+    
+    return 0;
+}
+
+/**
+ * @brief     interface mutex deinit
+ * @param[in] *mutex pointer to a mutex context
+ * @note      the board runs a single context, so nothing needs to be released
+ */
+void opt300x_interface_mutex_deinit(void *mutex)
+{
+    
+}
+
+/**
+ * @brief     interface mutex lock
+ * @param[in] *mutex pointer to a mutex context
+ * @note      the board runs a single context, so nothing needs to be locked
+ */
+void opt300x_interface_mutex_lock(void *mutex)
+{
+    
+}
+
+/**
+ * @brief     interface mutex unlock
+ * @param[in] *mutex pointer to a mutex context
+ * @note      the board runs a single context, so nothing needs to be locked
+ */
+void opt300x_interface_mutex_unlock(void *mutex)
+{
+    
+}
+
+/**
+ * @brief  interface timestamp us
+ * @return monotonic time in us
+ * @note   the hal tick runs at 1 kHz, so the resolution is 1 ms
+ */
+uint64_t opt300x_interface_timestamp_us(void)
+{
+    return (uint64_t)HAL_GetTick() * 1000;
+}
+
 /**
  * @brief     interface receive callback
  * @param[in] type irq type
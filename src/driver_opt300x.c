@@ -59,6 +59,39 @@
 #define OPT300X_REG_MANUFACTURER_ID        0x7E        /**< manufacturer id register */
 #define OPT300X_REG_DEVICE_ID              0x7F        /**< device id register */
 
+/**
+ * @brief irq mode definition
+ */
+#define OPT300X_IRQ_MODE_NORMAL            0x00        /**< report the flags only */
+#define OPT300X_IRQ_MODE_DEADBAND          0x01        /**< re-centre the limit window */
+#define OPT300X_IRQ_MODE_EOC               0x02        /**< report every conversion */
+
+/**
+ * @brief end of conversion low limit definition
+ */
+#define OPT300X_EOC_LOW_LIMIT              0xC000      /**< le[3:2] = 11b */
+
+/**
+ * @brief smbus alert response address definition
+ */
+#define OPT300X_ALERT_RESPONSE_ADDRESS     0x18        /**< 0x0C << 1 */
+
+/**
+ * @brief general call definition
+ */
+#define OPT300X_GENERAL_CALL_ADDRESS       0x00        /**< general call address */
+#define OPT300X_GENERAL_CALL_RESET         0x06        /**< general call reset command */
+
+/**
+ * @brief configuration writable mask definition
+ */
+#define OPT300X_CONFIGURATION_MASK         0xFE1F      /**< flags are read only */
+
+/**
+ * @brief max lsb count definition
+ */
+#define OPT300X_LSB_MAX                    (0xFFFUL << 11)        /**< 4095 * 2^11 */
+
 /**
  * @brief      read bytes
  * @param[in]  *handle pointer to an opt300x handle structure
@@ -79,6 +112,16 @@ static uint8_t a_opt300x_iic_read(opt300x_handle_t *handle, uint8_t reg, uint16_
         return 1;                                                               /* return error */
     }
     *data = (uint16_t)(((uint16_t)buf[0] << 8) | buf[1]);                       /* set data */
+    if (reg == OPT300X_REG_LOW_LIMIT)                                           /* low limit */
+    {
+        handle->low_limit = *data;                                              /* cache low limit */
+        handle->limit_valid |= 1 << 0;                                          /* set valid */
+    }
+    else if (reg == OPT300X_REG_HIGH_LIMIT)                                     /* high limit */
+    {
+        handle->high_limit = *data;                                             /* cache high limit */
+        handle->limit_valid |= 1 << 1;                                          /* set valid */
+    }
    
     return 0;                                                                   /* success return 0 */
 }
@@ -103,1027 +146,2731 @@ static uint8_t a_opt300x_iic_write(opt300x_handle_t *handle, uint8_t reg, uint16
     {
         return 1;                                                                /* return error */
     }
+    if (reg == OPT300X_REG_LOW_LIMIT)                                            /* low limit */
+    {
+        handle->low_limit = data;                                                /* cache low limit */
+        handle->limit_valid |= 1 << 0;                                           /* set valid */
+    }
+    else if (reg == OPT300X_REG_HIGH_LIMIT)                                      /* high limit */
+    {
+        handle->high_limit = data;                                               /* cache high limit */
+        handle->limit_valid |= 1 << 1;                                           /* set valid */
+    }
+    else if (reg == OPT300X_REG_CONFIGURATION)                                   /* configuration */
+    {
+        handle->config = data & OPT300X_CONFIGURATION_MASK;                      /* cache configuration */
+        handle->config_valid = 1;                                                /* set valid */
+    }
     
     return 0;                                                                    /* success return 0 */
 }
 
 /**
- * @brief     set the chip type
+ * @brief     clear the runtime state of a handle
  * @param[in] *handle pointer to an opt300x handle structure
- * @param[in] type chip type
- * @return    status code
- *            - 0 success
- *            - 2 handle is NULL
- * @note      none
+ * @note      keeps the linked functions, the address and the type
  */
-uint8_t opt300x_set_type(opt300x_handle_t *handle, opt300x_t type)
+static void a_opt300x_clear_state(opt300x_handle_t *handle)
 {
-    if (handle == NULL)                  /* check handle */
+    handle->inited = 0;                                                            /* not inited */
+    handle->irq_mode = OPT300X_IRQ_MODE_NORMAL;                                    /* normal irq mode */
+    handle->limit_valid = 0;                                                       /* no limit cache */
+    handle->low_limit = 0;                                                         /* clear low limit cache */
+    handle->high_limit = 0;                                                        /* clear high limit cache */
+    handle->config_valid = 0;                                                      /* no configuration cache */
+    handle->config = 0;                                                            /* clear configuration cache */
+    handle->reset_count = 0;                                                       /* clear reset counter */
+    handle->wd_enable = 0;                                                         /* watchdog off */
+    handle->wd_health = 0;                                                         /* clear health */
+    handle->wd_last_raw = 0;                                                       /* clear last raw */
+    handle->wd_stale_limit = 0;                                                    /* clear stale limit */
+    handle->wd_stuck_limit = 0;                                                    /* clear stuck limit */
+    handle->wd_latency_limit = 0;                                                  /* clear latency limit */
+    handle->wd_stale = 0;                                                          /* clear stale counter */
+    handle->wd_stuck = 0;                                                          /* clear stuck counter */
+    handle->wd_latency_max = 0;                                                    /* clear max latency */
+    handle->deadband_policy = 0;                                                   /* clear deadband policy */
+    handle->deadband_width = 0;                                                    /* clear deadband width */
+    handle->deadband_rearm = 0;                                                    /* clear re-arm counter */
+    handle->eoc_low_limit = 0;                                                     /* clear saved low limit */
+    handle->eoc_sample = 0;                                                        /* clear eoc samples */
+    handle->eoc_spurious = 0;                                                      /* clear spurious edges */
+    handle->storm_enable = 0;                                                      /* storm control off */
+    handle->storm_rate = 0;                                                        /* clear rate */
+    handle->storm_calm = 0;                                                        /* clear calm */
+    handle->storm_quiet = 0;                                                       /* clear quiet polls */
+    handle->storm_window_irq = 0;                                                  /* clear window irq */
+    handle->storm_window_start = 0;                                                /* clear window start */
+    memset(&handle->storm_stat, 0, sizeof(opt300x_storm_statistics_t));            /* clear statistics */
+}
+
+/**
+ * @brief     lock the handle
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @note      nothing is done if no lock function is linked
+ */
+static void a_opt300x_lock(opt300x_handle_t *handle)
+{
+    if (handle->mutex_lock != NULL)           /* check mutex_lock */
     {
-        return 2;                        /* return error */
+        handle->mutex_lock(handle->mutex);    /* lock */
     }
-    
-    handle->type = (uint8_t)type;        /* set chip type */
-    
-    return 0;                            /* success return 0 */
 }
 
 /**
- * @brief      get the iic chip type
- * @param[in]  *handle pointer to an opt300x handle structure
- * @param[out] *type pointer to a chip type buffer
- * @return      status code
- *              - 0 success
- *              - 2 handle is NULL
- * @note        none
+ * @brief     unlock the handle
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @note      nothing is done if no unlock function is linked
  */
-uint8_t opt300x_get_type(opt300x_handle_t *handle, opt300x_t *type)
+static void a_opt300x_unlock(opt300x_handle_t *handle)
 {
-    if (handle == NULL)                     /* check handle */
+    if (handle->mutex_unlock != NULL)           /* check mutex_unlock */
     {
-        return 2;                           /* return error */
+        handle->mutex_unlock(handle->mutex);    /* unlock */
     }
-    
-    *type = (opt300x_t)handle->type;        /* get iic address */
-    
-    return 0;                               /* success return 0 */
 }
 
 /**
- * @brief     set the iic address pin
+ * @brief     get the lsb weight of the chip
  * @param[in] *handle pointer to an opt300x handle structure
- * @param[in] addr_pin chip iic address pin
- * @return    status code
- *            - 0 success
- *            - 2 handle is NULL
+ * @return    lsb weight in lux or nW/cm2
  * @note      none
  */
-uint8_t opt300x_set_addr_pin(opt300x_handle_t *handle, opt300x_address_t addr_pin)
+static float a_opt300x_lsb_weight(opt300x_handle_t *handle)
 {
-    if (handle == NULL)                          /* check handle */
+    if (handle->type == (uint8_t)OPT3002)             /* opt3002 */
     {
-        return 2;                                /* return error */
+        return 1.2f;                                  /* nW/cm2 */
+    }
+    else if (handle->type == (uint8_t)OPT3005)        /* opt3005 */
+    {
+        return 0.02f;                                 /* lux */
+    }
+    else                                              /* the others */
+    {
+        return 0.01f;                                 /* lux */
     }
-    
-    handle->iic_addr = (uint8_t)addr_pin;        /* set iic address */
-    
-    return 0;                                    /* success return 0 */
 }
 
 /**
- * @brief      get the iic address pin
- * @param[in]  *handle pointer to an opt300x handle structure
- * @param[out] *addr_pin pointer to a chip iic address pin buffer
- * @return      status code
- *              - 0 success
- *              - 2 handle is NULL
- * @note        none
+ * @brief     convert a register code to lsb counts
+ * @param[in] code register code
+ * @return    lsb counts
+ * @note      none
  */
-uint8_t opt300x_get_addr_pin(opt300x_handle_t *handle, opt300x_address_t *addr_pin)
+static uint32_t a_opt300x_code_to_lsb(uint16_t code)
 {
-    if (handle == NULL)                                     /* check handle */
-    {
-        return 2;                                           /* return error */
-    }
-    
-    *addr_pin = (opt300x_address_t)handle->iic_addr;        /* get iic address */
- 
-    return 0;                                               /* success return 0 */
+    return ((uint32_t)(code & 0xFFF)) << ((code >> 12) & 0xF);        /* mantissa * 2^exponent */
 }
 
 /**
- * @brief     initialize the chip
- * @param[in] *handle pointer to an opt300x handle structure
- * @return    status code
- *            - 0 success
- *            - 1 iic initialization failed
- *            - 2 handle is NULL
- *            - 3 linked functions is NULL
- *            - 4 id is invalid
+ * @brief     convert lsb counts to a register code
+ * @param[in] lsb lsb counts
+ * @param[in] round_up 1 rounds up, 0 rounds down
+ * @return    register code
  * @note      none
  */
-uint8_t opt300x_init(opt300x_handle_t *handle)
+static uint16_t a_opt300x_lsb_to_code(uint32_t lsb, uint8_t round_up)
 {
-    uint8_t res;
-    uint16_t id;
+    uint16_t exponent;
     
-    if (handle == NULL)                                                        /* check handle */
+    if (lsb > OPT300X_LSB_MAX)                                        /* check max */
     {
-        return 2;                                                              /* return error */
+        return 0xBFFF;                                                /* full scale */
     }
-    if (handle->debug_print == NULL)                                           /* check debug_print */
+    exponent = 0;                                                     /* init 0 */
+    while (lsb > 0xFFF)                                               /* fit the mantissa */
     {
-        return 3;                                                              /* return error */
+        lsb = (round_up != 0) ? ((lsb + 1) >> 1) : (lsb >> 1);        /* halve */
+        exponent++;                                                   /* exponent++ */
     }
-    if (handle->iic_init == NULL)                                              /* check iic_init */
+    if (exponent > 0xB)                                               /* check exponent */
     {
-        handle->debug_print("opt300x: iic_init is null.\n");                   /* iic_init is null */
-        
-        return 3;                                                              /* return error */
+        return 0xBFFF;                                                /* full scale */
     }
-    if (handle->iic_deinit == NULL)                                            /* check iic_deinit */
+    
+    return (uint16_t)((exponent << 12) | (uint16_t)lsb);              /* return the code */
+}
+
+/**
+ * @brief      get the deadband window around a reading
+ * @param[in]  *handle pointer to an opt300x handle structure
+ * @param[in]  raw reading register code
+ * @param[out] *low pointer to a low limit buffer
+ * @param[out] *high pointer to a high limit buffer
+ * @note       none
+ */
+static void a_opt300x_deadband_window(opt300x_handle_t *handle, uint16_t raw, uint16_t *low, uint16_t *high)
+{
+    uint32_t lsb;
+    uint64_t lo;
+    uint64_t hi;
+    
+    lsb = a_opt300x_code_to_lsb(raw);                                                    /* get the reading */
+    if (handle->deadband_policy == (uint8_t)OPT300X_DEADBAND_POLICY_ABSOLUTE)            /* absolute */
     {
-        handle->debug_print("opt300x: iic_deinit is null.\n");                 /* iic_deinit is null */
-        
-        return 3;                                                              /* return error */
+        hi = (uint64_t)lsb + handle->deadband_width;                                     /* reading + width */
+        lo = (lsb > handle->deadband_width) ? (lsb - handle->deadband_width) : 0;        /* reading - width */
     }
-    if (handle->iic_read == NULL)                                              /* check iic_read */
+    else if (handle->deadband_policy == (uint8_t)OPT300X_DEADBAND_POLICY_PERCENT)        /* percent */
     {
-        handle->debug_print("opt300x: iic_read is null.\n");                   /* iic_read is null */
-        
-        return 3;                                                              /* return error */
+        hi = ((uint64_t)lsb * handle->deadband_width) >> 16;                             /* delta */
+        lo = lsb - hi;                                                                   /* reading - delta */
+        hi = lsb + hi;                                                                   /* reading + delta */
     }
-    if (handle->iic_write == NULL)                                             /* check iic_write */
+    else                                                                                 /* log */
     {
-        handle->debug_print("opt300x: iic_write is null.\n");                  /* iic_write is null */
-        
-        return 3;                                                              /* return error */
+        hi = ((uint64_t)lsb * handle->deadband_width) >> 16;                             /* reading * factor */
+        lo = ((uint64_t)lsb << 16) / handle->deadband_width;                             /* reading / factor */
     }
-    if (handle->delay_ms == NULL)                                              /* check delay_ms */
+    if (hi <= lsb)                                                                       /* at least one lsb */
     {
-        handle->debug_print("opt300x: delay_ms is null.\n");                   /* delay_ms is null */
-        
-        return 3;                                                              /* return error */
+        hi = (uint64_t)lsb + 1;                                                          /* reading + 1 */
     }
-    if (handle->receive_callback == NULL)                                      /* check receive_callback */
+    if ((lo >= lsb) && (lsb > 0))                                                        /* at least one lsb */
     {
-        handle->debug_print("opt300x: receive_callback is null.\n");           /* receive_callback is null */
-        
-        return 3;                                                              /* return error */
+        lo = lsb - 1;                                                                    /* reading - 1 */
     }
+    *low = a_opt300x_lsb_to_code((uint32_t)lo, 0);                                       /* round down */
+    *high = a_opt300x_lsb_to_code((hi > OPT300X_LSB_MAX) ? 
+                                  (uint32_t)OPT300X_LSB_MAX : (uint32_t)hi, 1);          /* round up */
+}
+
+/**
+ * @brief     write the low and high limits in the glitch free order
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] low low limit register code
+ * @param[in] high high limit register code
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      widening writes go first and narrowing writes go last, unchanged limits are not written
+ */
+static uint8_t a_opt300x_write_limits(opt300x_handle_t *handle, uint16_t low, uint16_t high)
+{
+    uint16_t prev;
+    uint32_t old_low;
+    uint32_t old_high;
     
-    if (handle->iic_init() != 0)                                               /* iic init */
+    if ((handle->limit_valid & (1 << 0)) == 0)                                     /* no low limit cache */
     {
-        handle->debug_print("opt300x: iic init failed.\n");                    /* iic init failed */
-        
-        return 1;                                                              /* return error */
+        if (a_opt300x_iic_read(handle, OPT300X_REG_LOW_LIMIT, &prev) != 0)         /* read low limit */
+        {
+            return 1;                                                              /* return error */
+        }
     }
-    res = a_opt300x_iic_read(handle, OPT300X_REG_MANUFACTURER_ID, &id);        /* read id */
-    if (res != 0)                                                              /* check the result */
+    if ((handle->limit_valid & (1 << 1)) == 0)                                     /* no high limit cache */
     {
-        handle->debug_print("opt300x: read id failed.\n");                     /* read id failed */
-        (void)handle->iic_deinit();                                            /* iic deinit */
-        
-        return 4;                                                              /* return error */
+        if (a_opt300x_iic_read(handle, OPT300X_REG_HIGH_LIMIT, &prev) != 0)        /* read high limit */
+        {
+            return 1;                                                              /* return error */
+        }
     }
-    if (id != 0x5449)                                                          /* check id */
+    old_low = a_opt300x_code_to_lsb(handle->low_limit);                            /* old low */
+    old_high = a_opt300x_code_to_lsb(handle->high_limit);                          /* old high */
+    if (a_opt300x_code_to_lsb(low) < old_low)                                      /* low widens */
     {
-        handle->debug_print("opt300x: manufacturer id is invalid.\n");         /* manufacturer id is invalid */
-        (void)handle->iic_deinit();                                            /* iic deinit */
-        
-        return 4;                                                              /* return error */
+        if (a_opt300x_iic_write(handle, OPT300X_REG_LOW_LIMIT, low) != 0)          /* write low limit */
+        {
+            return 1;                                                              /* return error */
+        }
     }
-    res = a_opt300x_iic_read(handle, OPT300X_REG_DEVICE_ID, &id);              /* read id */
-    if (res != 0)                                                              /* check the result */
+    if (a_opt300x_code_to_lsb(high) > old_high)                                    /* high widens */
     {
-        handle->debug_print("opt300x: read id failed.\n");                     /* read id failed */
-        (void)handle->iic_deinit();                                            /* iic deinit */
-        
-        return 4;                                                              /* return error */
+        if (a_opt300x_iic_write(handle, OPT300X_REG_HIGH_LIMIT, high) != 0)        /* write high limit */
+        {
+            return 1;                                                              /* return error */
+        }
     }
-    if (id != 0x3001)                                                          /* check id */
+    if (handle->low_limit != low)                                                  /* low narrows */
     {
-        handle->debug_print("opt300x: device id is invalid.\n");               /* device id is invalid */
-        (void)handle->iic_deinit();                                            /* iic deinit */
-        
-        return 4;                                                              /* return error */
+        if (a_opt300x_iic_write(handle, OPT300X_REG_LOW_LIMIT, low) != 0)          /* write low limit */
+        {
+            return 1;                                                              /* return error */
+        }
     }
-    handle->inited = 1;                                                        /* flag finish initialization */
-
-    return 0;                                                                  /* success return 0 */
+    if (handle->high_limit != high)                                                /* high narrows */
+    {
+        if (a_opt300x_iic_write(handle, OPT300X_REG_HIGH_LIMIT, high) != 0)        /* write high limit */
+        {
+            return 1;                                                              /* return error */
+        }
+    }
+    
+    return 0;                                                                      /* success return 0 */
 }
 
 /**
- * @brief     close the chip
+ * @brief     re-centre the deadband window around a reading
  * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] raw reading register code
  * @return    status code
  *            - 0 success
- *            - 1 iic deinit failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 power down failed
+ *            - 1 write failed
  * @note      none
  */
-uint8_t opt300x_deinit(opt300x_handle_t *handle)
+static uint8_t a_opt300x_deadband_rearm(opt300x_handle_t *handle, uint16_t raw)
 {
-    uint8_t res;
-    uint16_t prev;
+    uint16_t low;
+    uint16_t high;
     
-    if (handle == NULL)                                                        /* check handle */
+    a_opt300x_deadband_window(handle, raw, &low, &high);        /* get the window */
+    if (a_opt300x_write_limits(handle, low, high) != 0)         /* write the window */
     {
-        return 2;                                                              /* return error */
+        return 1;                                               /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
-    {
-        return 3;                                                              /* return error */
-    }   
+    handle->deadband_rearm++;                                   /* re-arm++ */
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
-    if (res != 0)                                                              /* check the result */
+    return 0;                                                   /* success return 0 */
+}
+
+/**
+ * @brief     write the cached limits and configuration back to the chip
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the limits go first, so the restored conversions start with the right window
+ */
+static uint8_t a_opt300x_restore(opt300x_handle_t *handle)
+{
+    if ((handle->limit_valid & (1 << 0)) != 0)                                                /* low limit cached */
     {
-        handle->debug_print("opt300x: read configuration failed.\n");          /* read configuration failed */
-        
-        return 4;                                                              /* return error */
+        if (a_opt300x_iic_write(handle, OPT300X_REG_LOW_LIMIT, handle->low_limit) != 0)       /* write low limit */
+        {
+            return 1;                                                                         /* return error */
+        }
     }
-    prev &= ~(3 << 9);                                                         /* clear settings */
-    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);        /* write configuration */
-    if (res != 0)                                                              /* check the result */
+    if ((handle->limit_valid & (1 << 1)) != 0)                                                /* high limit cached */
     {
-        handle->debug_print("opt300x: write configuration failed.\n");         /* write configuration failed */
-        
-        return 4;                                                              /* return error */
+        if (a_opt300x_iic_write(handle, OPT300X_REG_HIGH_LIMIT, handle->high_limit) != 0)     /* write high limit */
+        {
+            return 1;                                                                         /* return error */
+        }
     }
-    if (handle->iic_deinit() != 0)                                             /* iic deinit */
+    if (handle->config_valid != 0)                                                            /* configuration cached */
     {
-        handle->debug_print("opt300x: iic deinit failed.\n");                  /* iic deinit failed */
-        
-        return 1;                                                              /* return error */
-    }   
-    handle->inited = 0;                                                        /* flag close */
+        if (a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, handle->config) != 0)      /* write configuration */
+        {
+            return 1;                                                                         /* return error */
+        }
+    }
     
-    return 0;                                                                  /* success return 0 */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     start the chip reading
+ * @brief     check if a configuration read back lost the applied settings
  * @param[in] *handle pointer to an opt300x handle structure
- * @return    status code
- *            - 0 success
- *            - 1 start continuous read failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @param[in] prev configuration read back
+ * @return    1 if lost, 0 if not
+ * @note      the mode bits are only checked in the continuous mode,
+ *            because a single shot conversion goes back to shutdown by itself
  */
-uint8_t opt300x_start_continuous_read(opt300x_handle_t *handle)
+static uint8_t a_opt300x_config_lost(opt300x_handle_t *handle, uint16_t prev)
 {
-    uint8_t res;
-    uint16_t prev;
+    uint16_t mask;
     
-    if (handle == NULL)                                                        /* check handle */
+    if (handle->config_valid == 0)                                      /* no cache */
     {
-        return 2;                                                              /* return error */
+        return 0;                                                       /* nothing to compare */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    mask = OPT300X_CONFIGURATION_MASK & (uint16_t)(~(3 << 9));          /* settings without the mode */
+    if ((handle->config & (2 << 9)) != 0)                               /* continuous mode */
     {
-        return 3;                                                              /* return error */
+        mask |= 2 << 9;                                                 /* it must keep running */
     }
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
-    if (res != 0)                                                              /* check the result */
-    {
-        handle->debug_print("opt300x: read configuration failed.\n");          /* read configuration failed */
-        
-        return 1;                                                              /* return error */
-    }
-    prev &= ~(3 << 9);                                                         /* clear settings */
-    prev |= 2 << 9;                                                            /* continuous conversions */
-    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);        /* write configuration */
+    return ((prev & mask) != (handle->config & mask)) ? 1 : 0;          /* compare */
+}
+
+/**
+ * @brief     confirm a lost configuration and restore the chip
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @return    status code
+ *            - 0 not reset
+ *            - 1 reset and restored
+ *            - 2 restore failed
+ * @note      call it with the lock held, the configuration is read again because a concurrent
+ *            writer may have changed it between the caller's read and the cache update
+ */
+static uint8_t a_opt300x_recover(opt300x_handle_t *handle)
+{
+    uint16_t prev;
+    
+    if (a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev) != 0)        /* read configuration */
+    {
+        return 2;                                                                 /* return error */
+    }
+    if (a_opt300x_config_lost(handle, prev) == 0)                                 /* false alarm */
+    {
+        return 0;                                                                 /* not reset */
+    }
+    if (a_opt300x_restore(handle) != 0)                                           /* restore */
+    {
+        return 2;                                                                 /* return error */
+    }
+    handle->reset_count++;                                                        /* reset++ */
+    
+    return 1;                                                                     /* reset and restored */
+}
+
+/**
+ * @brief     feed one sample to the watchdog
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] prev configuration read with the sample
+ * @param[in] raw raw result
+ * @param[in] latency read latency in us
+ * @return    1 if the health changed, 0 if not
+ * @note      O(1), the caller runs the health_callback out of the lock
+ */
+static uint8_t a_opt300x_watchdog(opt300x_handle_t *handle, uint16_t prev, uint16_t raw, uint32_t latency)
+{
+    uint8_t health;
+    
+    if (handle->wd_enable == 0)                                                                /* check enable */
+    {
+        return 0;                                                                              /* disabled */
+    }
+    if ((prev & (1 << 7)) != 0)                                                                /* new conversion */
+    {
+        handle->wd_stale = 0;                                                                  /* clear stale */
+        handle->wd_stuck = (raw == handle->wd_last_raw) ? (handle->wd_stuck + 1) : 0;          /* count identical codes */
+        handle->wd_last_raw = raw;                                                             /* save raw */
+    }
+    else
+    {
+        handle->wd_stale++;                                                                    /* stale++ */
+    }
+    if (latency > handle->wd_latency_max)                                                      /* check max */
+    {
+        handle->wd_latency_max = latency;                                                      /* save max */
+    }
+    if ((handle->wd_stale_limit != 0) && (handle->wd_stale >= handle->wd_stale_limit))         /* stale */
+    {
+        health = OPT300X_HEALTH_STALE;                                                         /* set stale */
+    }
+    else if ((handle->wd_stuck_limit != 0) && (handle->wd_stuck >= handle->wd_stuck_limit))    /* stuck */
+    {
+        health = OPT300X_HEALTH_STUCK;                                                         /* set stuck */
+    }
+    else if ((handle->wd_latency_limit != 0) && (latency > handle->wd_latency_limit))          /* slow */
+    {
+        health = OPT300X_HEALTH_SLOW;                                                          /* set slow */
+    }
+    else
+    {
+        health = OPT300X_HEALTH_OK;                                                            /* set ok */
+    }
+    if (health == handle->wd_health)                                                           /* no change */
+    {
+        return 0;                                                                              /* return 0 */
+    }
+    handle->wd_health = health;                                                                /* set health */
+    
+    return 1;                                                                                  /* changed */
+}
+
+/**
+ * @brief      handle one irq
+ * @param[in]  *handle pointer to an opt300x handle structure
+ * @param[in]  timestamp edge timestamp in us
+ * @param[out] *flag pointer to a handled configuration buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       none
+ */
+static uint8_t a_opt300x_irq_process(opt300x_handle_t *handle, uint64_t timestamp, uint16_t *flag)
+{
+    uint8_t res;
+    uint8_t report;
+    uint8_t need;
+    uint8_t changed;
+    uint16_t prev;
+    uint16_t raw;
+    uint32_t latency;
+    opt300x_event_t event;
+    
+    changed = 0;                                                                              /* init 0 */
+    report = 0;                                                                               /* init 0 */
+    raw = 0;                                                                                  /* init 0 */
+    a_opt300x_lock(handle);                                                                   /* lock */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);                       /* read configuration */
+    if (res != 0)                                                                             /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");                 /* read configuration failed */
+        a_opt300x_unlock(handle);                                                             /* unlock */
+        
+        return 1;                                                                             /* return error */
+    }
+    if (a_opt300x_config_lost(handle, prev) != 0)                                             /* check chip reset */
+    {
+        res = a_opt300x_recover(handle);                                                      /* recover */
+        if (res == 2)                                                                         /* check the result */
+        {
+            OPT300X_DEBUG_ERROR(handle, "opt300x: restore failed.\n");                        /* restore failed */
+            a_opt300x_unlock(handle);                                                         /* unlock */
+            
+            return 1;                                                                         /* return error */
+        }
+        if (res == 1)                                                                         /* the flags are stale */
+        {
+            a_opt300x_unlock(handle);                                                         /* unlock */
+            *flag = 0;                                                                        /* no flag */
+            
+            return 0;                                                                         /* success return 0 */
+        }
+    }
+    if (handle->irq_mode == OPT300X_IRQ_MODE_EOC)                                             /* eoc stream */
+    {
+        prev &= ~(1 << 5);                                                                    /* low flag has no meaning with the eoc pattern */
+        report = (uint8_t)((prev >> 7) & 0x01);                                               /* report only a new conversion */
+    }
+    else if (handle->irq_mode == OPT300X_IRQ_MODE_DEADBAND)                                   /* deadband */
+    {
+        report = ((prev & (3 << 5)) != 0) ? 1 : 0;                                            /* report a crossed window */
+    }
+    need = ((report != 0) || (handle->event_callback != NULL)) ? 1 : 0;                       /* check if the sample is needed */
+    if (need != 0)                                                                            /* read once for all users */
+    {
+        res = a_opt300x_iic_read(handle, OPT300X_REG_RESULT, &raw);                           /* read result */
+        if (res != 0)                                                                         /* check the result */
+        {
+            OPT300X_DEBUG_ERROR(handle, "opt300x: read result failed.\n");                    /* read result failed */
+            a_opt300x_unlock(handle);                                                         /* unlock */
+            
+            return 1;                                                                         /* return error */
+        }
+        latency = 0;                                                                          /* init 0 */
+        if ((handle->wd_enable != 0) && (timestamp != 0))                                     /* latency from the edge */
+        {
+            latency = (uint32_t)(handle->timestamp_us() - timestamp);                         /* get latency */
+        }
+        changed = a_opt300x_watchdog(handle, prev, raw, latency);                             /* feed the watchdog */
+    }
+    if (handle->irq_mode == OPT300X_IRQ_MODE_EOC)                                             /* eoc stream */
+    {
+        if (report != 0)                                                                      /* new sample */
+        {
+            handle->eoc_sample++;                                                             /* sample++ */
+        }
+        else
+        {
+            handle->eoc_spurious++;                                                           /* no new sample */
+        }
+    }
+    else if ((handle->irq_mode == OPT300X_IRQ_MODE_DEADBAND) && (report != 0))                /* deadband window crossed */
+    {
+        res = a_opt300x_deadband_rearm(handle, raw);                                          /* re-centre the window */
+        if (res != 0)                                                                         /* check the result */
+        {
+            OPT300X_DEBUG_ERROR(handle, "opt300x: write limit failed.\n");                    /* write limit failed */
+            a_opt300x_unlock(handle);                                                         /* unlock */
+            
+            return 1;                                                                         /* return error */
+        }
+    }
+    a_opt300x_unlock(handle);                                                                 /* unlock */
+    
+    if ((prev & (1 << 6)) != 0)                                                               /* check flag */
+    {
+        if (handle->receive_callback != NULL)                                                 /* if not null */
+        {
+            handle->receive_callback(OPT300X_INTERRUPT_HIGH_LIMIT);                           /* run the callback */
+        }
+    }
+    if ((prev & (1 << 5)) != 0)                                                               /* check flag */
+    {
+        if (handle->receive_callback != NULL)                                                 /* if not null */
+        {
+            handle->receive_callback(OPT300X_INTERRUPT_LOW_LIMIT);                            /* run the callback */
+        }
+    }
+    if ((report != 0) && (handle->sample_callback != NULL))                                   /* check the sample */
+    {
+        handle->sample_callback(raw, a_opt300x_lsb_weight(handle) * 
+                                (float)a_opt300x_code_to_lsb(raw));                           /* run the callback */
+    }
+    if ((changed != 0) && (handle->health_callback != NULL))                                  /* check health change */
+    {
+        handle->health_callback(handle->wd_health);                                           /* run the callback */
+    }
+    if (handle->event_callback != NULL)                                                       /* if not null */
+    {
+        event.timestamp_us = timestamp;                                                       /* set timestamp */
+        event.raw = raw;                                                                      /* set raw */
+        event.data = a_opt300x_lsb_weight(handle) * (float)a_opt300x_code_to_lsb(raw);        /* set data */
+        event.config = prev;                                                                  /* set configuration */
+        event.high_flag = (uint8_t)((prev >> 6) & 0x01);                                      /* set flag high */
+        event.low_flag = (uint8_t)((prev >> 5) & 0x01);                                       /* set flag low */
+        event.ready_flag = (uint8_t)((prev >> 7) & 0x01);                                     /* set conversion ready flag */
+        event.overflow_flag = (uint8_t)((prev >> 8) & 0x01);                                  /* set overflow flag */
+        handle->event_callback(&event);                                                       /* run the callback */
+    }
+    *flag = prev;                                                                             /* set the handled flags */
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     set the chip type
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] type chip type
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t opt300x_set_type(opt300x_handle_t *handle, opt300x_t type)
+{
+    if (handle == NULL)                  /* check handle */
+    {
+        return 2;                        /* return error */
+    }
+    
+    handle->type = (uint8_t)type;        /* set chip type */
+    
+    return 0;                            /* success return 0 */
+}
+
+/**
+ * @brief      get the iic chip type
+ * @param[in]  *handle pointer to an opt300x handle structure
+ * @param[out] *type pointer to a chip type buffer
+ * @return      status code
+ *              - 0 success
+ *              - 2 handle is NULL
+ * @note        none
+ */
+uint8_t opt300x_get_type(opt300x_handle_t *handle, opt300x_t *type)
+{
+    if (handle == NULL)                     /* check handle */
+    {
+        return 2;                           /* return error */
+    }
+    
+    *type = (opt300x_t)handle->type;        /* get iic address */
+    
+    return 0;                               /* success return 0 */
+}
+
+/**
+ * @brief     set the iic address pin
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] addr_pin chip iic address pin
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t opt300x_set_addr_pin(opt300x_handle_t *handle, opt300x_address_t addr_pin)
+{
+    if (handle == NULL)                          /* check handle */
+    {
+        return 2;                                /* return error */
+    }
+    
+    handle->iic_addr = (uint8_t)addr_pin;        /* set iic address */
+    
+    return 0;                                    /* success return 0 */
+}
+
+/**
+ * @brief      get the iic address pin
+ * @param[in]  *handle pointer to an opt300x handle structure
+ * @param[out] *addr_pin pointer to a chip iic address pin buffer
+ * @return      status code
+ *              - 0 success
+ *              - 2 handle is NULL
+ * @note        none
+ */
+uint8_t opt300x_get_addr_pin(opt300x_handle_t *handle, opt300x_address_t *addr_pin)
+{
+    if (handle == NULL)                                     /* check handle */
+    {
+        return 2;                                           /* return error */
+    }
+    
+    *addr_pin = (opt300x_address_t)handle->iic_addr;        /* get iic address */
+ 
+    return 0;                                               /* success return 0 */
+}
+
+/**
+ * @brief     initialize the chip
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 id is invalid
+ *            - 5 mutex init failed
+ * @note      none
+ */
+uint8_t opt300x_init(opt300x_handle_t *handle)
+{
+    uint8_t res;
+    uint16_t id;
+    
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->debug_print == NULL)                                           /* check debug_print */
+    {
+        return 3;                                                              /* return error */
+    }
+    if (handle->iic_init == NULL)                                              /* check iic_init */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: iic_init is null.\n");           /* iic_init is null */
+        
+        return 3;                                                              /* return error */
+    }
+    if (handle->iic_deinit == NULL)                                            /* check iic_deinit */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: iic_deinit is null.\n");         /* iic_deinit is null */
+        
+        return 3;                                                              /* return error */
+    }
+    if (handle->iic_read == NULL)                                              /* check iic_read */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: iic_read is null.\n");           /* iic_read is null */
+        
+        return 3;                                                              /* return error */
+    }
+    if (handle->iic_write == NULL)                                             /* check iic_write */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: iic_write is null.\n");          /* iic_write is null */
+        
+        return 3;                                                              /* return error */
+    }
+    if (handle->delay_ms == NULL)                                              /* check delay_ms */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: delay_ms is null.\n");           /* delay_ms is null */
+        
+        return 3;                                                              /* return error */
+    }
+    if (handle->receive_callback == NULL)                                      /* check receive_callback */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: receive_callback is null.\n");   /* receive_callback is null */
+        
+        return 3;                                                              /* return error */
+    }
+    
+    if (handle->iic_init() != 0)                                               /* iic init */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: iic init failed.\n");            /* iic init failed */
+        
+        return 1;                                                              /* return error */
+    }
+    res = a_opt300x_iic_read(handle, OPT300X_REG_MANUFACTURER_ID, &id);        /* read id */
     if (res != 0)                                                              /* check the result */
     {
-        handle->debug_print("opt300x: write configuration failed.\n");         /* write configuration failed */
-        
-        return 1;                                                              /* return error */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read id failed.\n");             /* read id failed */
+        (void)handle->iic_deinit();                                            /* iic deinit */
+        
+        return 4;                                                              /* return error */
+    }
+    if (id != 0x5449)                                                          /* check id */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: manufacturer id is invalid.\n"); /* manufacturer id is invalid */
+        (void)handle->iic_deinit();                                            /* iic deinit */
+        
+        return 4;                                                              /* return error */
+    }
+    res = a_opt300x_iic_read(handle, OPT300X_REG_DEVICE_ID, &id);              /* read id */
+    if (res != 0)                                                              /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read id failed.\n");             /* read id failed */
+        (void)handle->iic_deinit();                                            /* iic deinit */
+        
+        return 4;                                                              /* return error */
+    }
+    if (id != 0x3001)                                                          /* check id */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: device id is invalid.\n");       /* device id is invalid */
+        (void)handle->iic_deinit();                                            /* iic deinit */
+        
+        return 4;                                                              /* return error */
+    }
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &id);          /* read configuration */
+    if (res != 0)                                                              /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");  /* read configuration failed */
+        (void)handle->iic_deinit();                                            /* iic deinit */
+        
+        return 1;                                                              /* return error */
+    }
+    handle->config = id & OPT300X_CONFIGURATION_MASK;                          /* cache configuration */
+    handle->config_valid = 1;                                                  /* set valid */
+    handle->irq_mode = OPT300X_IRQ_MODE_NORMAL;                                /* normal irq mode */
+    handle->limit_valid = 0;                                                   /* no limit cache */
+    handle->mutex = NULL;                                                      /* no mutex context */
+    if (handle->mutex_init != NULL)                                            /* check mutex_init */
+    {
+        if (handle->mutex_init(&handle->mutex) != 0)                           /* mutex init */
+        {
+            OPT300X_DEBUG_ERROR(handle, "opt300x: mutex init failed.\n");      /* mutex init failed */
+            (void)handle->iic_deinit();                                        /* iic deinit */
+            
+            return 5;                                                          /* return error */
+        }
+    }
+    handle->inited = 1;                                                        /* flag finish initialization */
+
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      scan all four addresses of the bus
+ * @param[in]  *handle pointer to an opt300x template handle structure with the linked functions and the chip type
+ * @param[out] *scan pointer to an opt300x scan array with 4 entries
+ * @param[out] *ready pointer to an opt300x handle array with 4 entries, NULL means report only
+ * @param[out] *num pointer to a found device number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 iic initialization failed
+ *             - 2 handle is NULL
+ *             - 3 linked functions is NULL
+ * @note       an empty address costs one failed read, found devices get the template links and address
+ *             with a clean runtime state and their own mutex context, initialized and stored in ready[0, num), so each one needs
+ *             opt300x_deinit later, the chip type can't be detected because all the chips report the same device id
+ */
+uint8_t opt300x_scan(opt300x_handle_t *handle, opt300x_scan_t *scan, opt300x_handle_t *ready, uint8_t *num)
+{
+    uint8_t i;
+    uint8_t addr;
+    uint16_t prev;
+    void *mutex;
+    const opt300x_address_t pin[4] = {OPT300X_ADDRESS_GND, OPT300X_ADDRESS_VCC, 
+                                      OPT300X_ADDRESS_SDA, OPT300X_ADDRESS_SCL};
+    
+    if ((handle == NULL) || (scan == NULL) || (num == NULL))                              /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->debug_print == NULL)                                                      /* check debug_print */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if (handle->iic_init == NULL)                                                         /* check iic_init */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: iic_init is null.\n");                      /* iic_init is null */
+        
+        return 3;                                                                         /* return error */
+    }
+    if (handle->iic_deinit == NULL)                                                       /* check iic_deinit */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: iic_deinit is null.\n");                    /* iic_deinit is null */
+        
+        return 3;                                                                         /* return error */
+    }
+    if (handle->iic_read == NULL)                                                         /* check iic_read */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: iic_read is null.\n");                      /* iic_read is null */
+        
+        return 3;                                                                         /* return error */
+    }
+    if (handle->iic_write == NULL)                                                        /* check iic_write */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: iic_write is null.\n");                     /* iic_write is null */
+        
+        return 3;                                                                         /* return error */
+    }
+    if (handle->delay_ms == NULL)                                                         /* check delay_ms */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: delay_ms is null.\n");                      /* delay_ms is null */
+        
+        return 3;                                                                         /* return error */
+    }
+    if (handle->receive_callback == NULL)                                                 /* check receive_callback */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: receive_callback is null.\n");              /* receive_callback is null */
+        
+        return 3;                                                                         /* return error */
+    }
+    
+    if (handle->iic_init() != 0)                                                          /* iic init for the probe */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: iic init failed.\n");                       /* iic init failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    addr = handle->iic_addr;                                                              /* save the address */
+    *num = 0;                                                                             /* init 0 */
+    for (i = 0; i < 4; i++)                                                               /* probe all addresses */
+    {
+        scan[i].addr_pin = pin[i];                                                        /* set address pin */
+        scan[i].found = 0;                                                                /* init 0 */
+        scan[i].manufacturer_id = 0;                                                      /* init 0 */
+        scan[i].device_id = 0;                                                            /* init 0 */
+        handle->iic_addr = (uint8_t)pin[i];                                               /* set address */
+        if (a_opt300x_iic_read(handle, OPT300X_REG_MANUFACTURER_ID, 
+                               &scan[i].manufacturer_id) != 0)                            /* empty address */
+        {
+            continue;                                                                     /* next */
+        }
+        if (scan[i].manufacturer_id != 0x5449)                                            /* other chip */
+        {
+            continue;                                                                     /* next */
+        }
+        if (a_opt300x_iic_read(handle, OPT300X_REG_DEVICE_ID, &scan[i].device_id) != 0)   /* read device id */
+        {
+            continue;                                                                     /* next */
+        }
+        if (scan[i].device_id != 0x3001)                                                  /* other chip */
+        {
+            continue;                                                                     /* next */
+        }
+        if (ready != NULL)                                                                /* populate the handle */
+        {
+            if (a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev) != 0)        /* read configuration */
+            {
+                continue;                                                                 /* next */
+            }
+            if (handle->iic_init() != 0)                                                  /* one bus reference per handle */
+            {
+                continue;                                                                 /* next */
+            }
+            mutex = NULL;                                                                 /* no mutex context */
+            if ((handle->mutex_init != NULL) && (handle->mutex_init(&mutex) != 0))        /* one mutex per handle */
+            {
+                (void)handle->iic_deinit();                                               /* drop the bus reference */
+                
+                continue;                                                                 /* next */
+            }
+            memcpy(&ready[*num], handle, sizeof(opt300x_handle_t));                       /* copy the template */
+            a_opt300x_clear_state(&ready[*num]);                                          /* drop the template state */
+            ready[*num].mutex = mutex;                                                    /* own mutex context */
+            ready[*num].config = prev & OPT300X_CONFIGURATION_MASK;                       /* cache configuration */
+            ready[*num].config_valid = 1;                                                 /* set valid */
+            ready[*num].inited = 1;                                                       /* flag finish initialization */
+        }
+        scan[i].found = 1;                                                                /* found */
+        (*num)++;                                                                         /* num++ */
+    }
+    handle->iic_addr = addr;                                                              /* restore the address */
+    if (handle->iic_deinit() != 0)                                                        /* release the probe */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: iic deinit failed.\n");                     /* iic deinit failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     close the chip
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 power down failed
+ * @note      none
+ */
+uint8_t opt300x_deinit(opt300x_handle_t *handle)
+{
+    uint8_t res;
+    uint16_t prev;
+    
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }   
+    
+    a_opt300x_lock(handle);                                                    /* lock */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
+    if (res != 0)                                                              /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");  /* read configuration failed */
+        a_opt300x_unlock(handle);                                              /* unlock */
+        
+        return 4;                                                              /* return error */
+    }
+    prev &= ~(3 << 9);                                                         /* clear settings */
+    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);        /* write configuration */
+    if (res != 0)                                                              /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: write configuration failed.\n"); /* write configuration failed */
+        a_opt300x_unlock(handle);                                              /* unlock */
+        
+        return 4;                                                              /* return error */
+    }
+    if (handle->iic_deinit() != 0)                                             /* iic deinit */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: iic deinit failed.\n");          /* iic deinit failed */
+        a_opt300x_unlock(handle);                                              /* unlock */
+        
+        return 1;                                                              /* return error */
+    }   
+    handle->inited = 0;                                                        /* flag close */
+    a_opt300x_unlock(handle);                                                  /* unlock */
+    if (handle->mutex_deinit != NULL)                                          /* check mutex_deinit */
+    {
+        handle->mutex_deinit(handle->mutex);                                   /* mutex deinit */
+    }
+    handle->mutex = NULL;                                                      /* clear mutex context */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     start the chip reading
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start continuous read failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t opt300x_start_continuous_read(opt300x_handle_t *handle)
+{
+    uint8_t res;
+    uint16_t prev;
+    
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    
+    a_opt300x_lock(handle);                                                    /* lock */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
+    if (res != 0)                                                              /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");  /* read configuration failed */
+        a_opt300x_unlock(handle);                                              /* unlock */
+        
+        return 1;                                                              /* return error */
+    }
+    prev &= ~(3 << 9);                                                         /* clear settings */
+    prev |= 2 << 9;                                                            /* continuous conversions */
+    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);        /* write configuration */
+    if (res != 0)                                                              /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: write configuration failed.\n"); /* write configuration failed */
+        a_opt300x_unlock(handle);                                              /* unlock */
+        
+        return 1;                                                              /* return error */
+    }
+    a_opt300x_unlock(handle);                                                  /* unlock */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     stop the chip reading
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 stop continuous read failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t opt300x_stop_continuous_read(opt300x_handle_t *handle)
+{
+    uint8_t res;
+    uint16_t prev;
+    
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    
+    a_opt300x_lock(handle);                                                    /* lock */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
+    if (res != 0)                                                              /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");  /* read configuration failed */
+        a_opt300x_unlock(handle);                                              /* unlock */
+        
+        return 1;                                                              /* return error */
+    }
+    prev &= ~(3 << 9);                                                         /* clear settings */
+    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);        /* write configuration */
+    if (res != 0)                                                              /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: write configuration failed.\n"); /* write configuration failed */
+        a_opt300x_unlock(handle);                                              /* unlock */
+        
+        return 1;                                                              /* return error */
+    }
+    a_opt300x_unlock(handle);                                                  /* unlock */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      read data from the chip continuously
+ * @param[in]  *handle pointer to an opt300x handle structure
+ * @param[out] *raw pointer to a raw data buffer
+ * @param[out] *lux pointer to a converted lux buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 data is overflow
+ *             - 5 opt3002 can't use this function
+ * @note       the chip is read without the lock, the lock is only held to feed the watchdog
+ *             and to compare the cache and restore a reset chip, a restored chip is read again and counted by
+ *             opt300x_get_reset_count
+ */
+uint8_t opt300x_continuous_read(opt300x_handle_t *handle, uint16_t *raw, float *lux)
+{
+    uint8_t res;
+    uint8_t changed;
+    uint8_t health;
+    uint8_t exponent;
+    uint16_t fractional;
+    uint16_t prev;
+    uint32_t latency;
+    uint64_t start;
+    
+    if (handle == NULL)                                                                    /* check handle */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (handle->inited != 1)                                                               /* check handle initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    if (handle->type == (uint8_t)OPT3002)                                                  /* check type */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: opt3002 can't use this function.\n");        /* opt3002 can't use this function */
+        
+        return 5;                                                                          /* return error */
+    }
+    
+    start = 0;                                                                             /* init 0 */
+    if ((handle->wd_enable != 0) && (handle->timestamp_us != NULL))                        /* watchdog needs the latency */
+    {
+        start = handle->timestamp_us();                                                    /* get start time */
+    }
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);                    /* read configuration */
+    if (res != 0)                                                                          /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");              /* read configuration failed */
+        
+        return 1;                                                                          /* return error */
+    }
+    a_opt300x_lock(handle);                                                                /* lock */
+    res = 0;                                                                               /* not reset */
+    if (a_opt300x_config_lost(handle, prev) != 0)                                          /* check chip reset */
+    {
+        res = a_opt300x_recover(handle);                                                   /* recover */
+    }
+    a_opt300x_unlock(handle);                                                              /* unlock */
+    if (res == 2)                                                                          /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: restore failed.\n");                         /* restore failed */
+        
+        return 1;                                                                          /* return error */
+    }
+    if (res == 1)                                                                          /* check the result */
+    {
+        OPT300X_DEBUG_INFO(handle, "opt300x: chip reset and restored.\n");                 /* chip reset and restored */
+        res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);                /* read the restored configuration */
+        if (res != 0)                                                                      /* check the result */
+        {
+            OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");          /* read configuration failed */
+            
+            return 1;                                                                      /* return error */
+        }
+    }
+    if ((prev & (1 << 8)) != 0)                                                            /* check ovf bit */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: data is overflow.\n");                       /* data is overflow */
+        
+        return 4;                                                                          /* return error */
+    }
+    
+    res = a_opt300x_iic_read(handle, OPT300X_REG_RESULT, raw);                             /* read result */
+    if (res != 0)                                                                          /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read result failed.\n");                     /* read result failed */
+        
+        return 1;                                                                          /* return error */
+    }
+    latency = 0;                                                                           /* init 0 */
+    if (start != 0)                                                                        /* check start time */
+    {
+        latency = (uint32_t)(handle->timestamp_us() - start);                              /* get latency */
+    }
+    a_opt300x_lock(handle);                                                                /* lock */
+    changed = a_opt300x_watchdog(handle, prev, *raw, latency);                             /* feed the watchdog */
+    health = handle->wd_health;                                                            /* save health */
+    a_opt300x_unlock(handle);                                                              /* unlock */
+    if ((changed != 0) && (handle->health_callback != NULL))                               /* check health change */
+    {
+        handle->health_callback(health);                                                   /* run the callback */
+    }
+    exponent = ((*raw) >> 12) & 0xF;                                                       /* set exponent */
+    fractional = (*raw) & 0xFFF;                                                           /* set fractional */
+    if (handle->type == (uint8_t)OPT3005)                                                  /* opt3005 */
+    {
+        *lux = 0.02f * powf(2.0f, (float)exponent) * ((float)fractional);                  /* calculate lux */
+    }
+    else                                                                                   /* the others */
+    {
+        *lux = 0.01f * powf(2.0f, (float)exponent) * ((float)fractional);                  /* calculate lux */
+    }
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief      read data from the chip continuously
+ * @param[in]  *handle pointer to an opt300x handle structure
+ * @param[out] *raw pointer to a raw data buffer
+ * @param[out] *nw_cm2 pointer to a converted data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 data is overflow
+ *             - 5 only opt3002 can use this function
+ * @note       the chip is read without the lock, the lock is only held to feed the watchdog
+ *             and to compare the cache and restore a reset chip, a restored chip is read again and counted by
+ *             opt300x_get_reset_count
+ */
+uint8_t opt3002_continuous_read(opt300x_handle_t *handle, uint16_t *raw, float *nw_cm2)
+{
+    uint8_t res;
+    uint8_t changed;
+    uint8_t health;
+    uint8_t exponent;
+    uint16_t fractional;
+    uint16_t prev;
+    uint32_t latency;
+    uint64_t start;
+    
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    if (handle->type != (uint8_t)OPT3002)                                                     /* check type */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: only opt3002 can use this function.\n");        /* only opt3002 can use this function */
+        
+        return 5;                                                                             /* return error */
+    }
+    
+    start = 0;                                                                                /* init 0 */
+    if ((handle->wd_enable != 0) && (handle->timestamp_us != NULL))                           /* watchdog needs the latency */
+    {
+        start = handle->timestamp_us();                                                       /* get start time */
+    }
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);                       /* read configuration */
+    if (res != 0)                                                                             /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");                 /* read configuration failed */
+        
+        return 1;                                                                             /* return error */
+    }
+    a_opt300x_lock(handle);                                                                   /* lock */
+    res = 0;                                                                                  /* not reset */
+    if (a_opt300x_config_lost(handle, prev) != 0)                                             /* check chip reset */
+    {
+        res = a_opt300x_recover(handle);                                                      /* recover */
+    }
+    a_opt300x_unlock(handle);                                                                 /* unlock */
+    if (res == 2)                                                                             /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: restore failed.\n");                            /* restore failed */
+        
+        return 1;                                                                             /* return error */
+    }
+    if (res == 1)                                                                             /* check the result */
+    {
+        OPT300X_DEBUG_INFO(handle, "opt300x: chip reset and restored.\n");                    /* chip reset and restored */
+        res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);                   /* read the restored configuration */
+        if (res != 0)                                                                         /* check the result */
+        {
+            OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");             /* read configuration failed */
+            
+            return 1;                                                                         /* return error */
+        }
+    }
+    if ((prev & (1 << 8)) != 0)                                                               /* check ovf bit */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: data is overflow.\n");                          /* data is overflow */
+        
+        return 4;                                                                             /* return error */
+    }
+    
+    res = a_opt300x_iic_read(handle, OPT300X_REG_RESULT, raw);                                /* read result */
+    if (res != 0)                                                                             /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read result failed.\n");                        /* read result failed */
+        
+        return 1;                                                                             /* return error */
+    }
+    latency = 0;                                                                              /* init 0 */
+    if (start != 0)                                                                           /* check start time */
+    {
+        latency = (uint32_t)(handle->timestamp_us() - start);                                 /* get latency */
+    }
+    a_opt300x_lock(handle);                                                                   /* lock */
+    changed = a_opt300x_watchdog(handle, prev, *raw, latency);                                /* feed the watchdog */
+    health = handle->wd_health;                                                               /* save health */
+    a_opt300x_unlock(handle);                                                                 /* unlock */
+    if ((changed != 0) && (handle->health_callback != NULL))                                  /* check health change */
+    {
+        handle->health_callback(health);                                                      /* run the callback */
+    }
+    exponent = ((*raw) >> 12) & 0xF;                                                          /* set exponent */
+    fractional = (*raw) & 0xFFF;                                                              /* set fractional */
+    *nw_cm2 = 1.2f * powf(2.0f, (float)exponent) * ((float)fractional);                       /* calculate nw/cm2 */
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief      read data from the chip
+ * @param[in]  *handle pointer to an opt300x handle structure
+ * @param[out] *raw pointer to a raw data buffer
+ * @param[out] *lux pointer to a converted lux buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 data is overflow
+ *             - 5 read timeout
+ *             - 6 opt3002 can't use this function
+ * @note       none
+ */
+uint8_t opt300x_single_read(opt300x_handle_t *handle, uint16_t *raw, float *lux)
+{
+    uint8_t res;
+    uint8_t exponent;
+    uint16_t fractional;
+    uint16_t prev;
+    uint32_t timeout = 500;
+    
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if (handle->type == (uint8_t)OPT3002)                                                /* check type */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: opt3002 can't use this function.\n");      /* opt3002 can't use this function */
+        
+        return 6;                                                                        /* return error */
+    }
+    
+    a_opt300x_lock(handle);                                                              /* lock */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);                  /* read configuration */
+    if (res != 0)                                                                        /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");            /* read configuration failed */
+        a_opt300x_unlock(handle);                                                        /* unlock */
+        
+        return 1;                                                                        /* return error */
+    }
+    prev &= ~(3 << 9);                                                                   /* clear settings */
+    prev |= (1 << 9);                                                                    /* clear settings */
+    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);                  /* write configuration */
+    if (res != 0)                                                                        /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: write configuration failed.\n");           /* write configuration failed */
+        a_opt300x_unlock(handle);                                                        /* unlock */
+        
+        return 1;                                                                        /* return error */
+    }
+    a_opt300x_unlock(handle);                                                            /* unlock */
+    
+    while (timeout != 0)                                                                 /* 5s */
+    {
+        handle->delay_ms(10);                                                            /* delay 10ms without the lock */
+        timeout--;                                                                       /* timeout-- */
+        a_opt300x_lock(handle);                                                          /* lock */
+        res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);              /* read configuration */
+        a_opt300x_unlock(handle);                                                        /* unlock */
+        if (res != 0)                                                                    /* check the result */
+        {
+            OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");        /* read configuration failed */
+            
+            return 1;                                                                    /* return error */
+        }
+        if ((prev & (1 << 7)) != 0)                                                      /* check ready bit */
+        {
+            break;                                                                       /* break */
+        }
+        if ((prev & (1 << 8)) != 0)                                                      /* check ovf bit */
+        {
+            OPT300X_DEBUG_ERROR(handle, "opt300x: data is overflow.\n");                 /* data is overflow */
+            
+            return 4;                                                                    /* return error */
+        }
+    }
+    if (timeout == 0)                                                                    /* check timeout */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read timeout.\n");                         /* read timeout */
+        
+        return 5;                                                                        /* return error */
+    }
+    
+    a_opt300x_lock(handle);                                                              /* lock */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_RESULT, raw);                           /* read result */
+    a_opt300x_unlock(handle);                                                            /* unlock */
+    if (res != 0)                                                                        /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read result failed.\n");                   /* read result failed */
+        
+        return 1;                                                                        /* return error */
+    }
+    exponent = ((*raw) >> 12) & 0xF;                                                     /* set exponent */
+    fractional = (*raw) & 0xFFF;                                                         /* set fractional */
+    if (handle->type == (uint8_t)OPT3005)                                                /* opt3005 */
+    {
+        *lux = 0.02f * powf(2.0f, (float)exponent) * ((float)fractional);                /* calculate lux */
+    }
+    else                                                                                 /* the others */
+    {
+        *lux = 0.01f * powf(2.0f, (float)exponent) * ((float)fractional);                /* calculate lux */
+    }
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief      read data from the chip
+ * @param[in]  *handle pointer to an opt300x handle structure
+ * @param[out] *raw pointer to a raw data buffer
+ * @param[out] *nw_cm2 pointer to a converted data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 data is overflow
+ *             - 5 read timeout
+ *             - 6 only opt3002 can use this function
+ * @note       none
+ */
+uint8_t opt3002_single_read(opt300x_handle_t *handle, uint16_t *raw, float *nw_cm2)
+{
+    uint8_t res;
+    uint8_t exponent;
+    uint16_t fractional;
+    uint16_t prev;
+    uint32_t timeout = 500;
+    
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if (handle->type != (uint8_t)OPT3002)                                                 /* check type */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: only opt3002 can use this function.\n");    /* only opt3002 can use this function */
+        
+        return 6;                                                                         /* return error */
+    }
+    
+    a_opt300x_lock(handle);                                                               /* lock */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);                   /* read configuration */
+    if (res != 0)                                                                         /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");             /* read configuration failed */
+        a_opt300x_unlock(handle);                                                         /* unlock */
+        
+        return 1;                                                                         /* return error */
+    }
+    prev &= ~(3 << 9);                                                                    /* clear settings */
+    prev |= (1 << 9);                                                                     /* clear settings */
+    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);                   /* write configuration */
+    if (res != 0)                                                                         /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: write configuration failed.\n");            /* write configuration failed */
+        a_opt300x_unlock(handle);                                                         /* unlock */
+        
+        return 1;                                                                         /* return error */
+    }
+    a_opt300x_unlock(handle);                                                             /* unlock */
+    
+    while (timeout != 0)                                                                  /* 5s */
+    {
+        handle->delay_ms(10);                                                             /* delay 10ms without the lock */
+        timeout--;                                                                        /* timeout-- */
+        a_opt300x_lock(handle);                                                           /* lock */
+        res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);               /* read configuration */
+        a_opt300x_unlock(handle);                                                         /* unlock */
+        if (res != 0)                                                                     /* check the result */
+        {
+            OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");         /* read configuration failed */
+            
+            return 1;                                                                     /* return error */
+        }
+        if ((prev & (1 << 7)) != 0)                                                       /* check ready bit */
+        {
+            break;                                                                        /* break */
+        }
+        if ((prev & (1 << 8)) != 0)                                                       /* check ovf bit */
+        {
+            OPT300X_DEBUG_ERROR(handle, "opt300x: data is overflow.\n");                  /* data is overflow */
+            
+            return 4;                                                                     /* return error */
+        }
+    }
+    if (timeout == 0)                                                                     /* check timeout */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read timeout.\n");                          /* read timeout */
+        
+        return 5;                                                                         /* return error */
+    }
+    
+    a_opt300x_lock(handle);                                                               /* lock */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_RESULT, raw);                            /* read result */
+    a_opt300x_unlock(handle);                                                             /* unlock */
+    if (res != 0)                                                                         /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read result failed.\n");                    /* read result failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    exponent = ((*raw) >> 12) & 0xF;                                                      /* set exponent */
+    fractional = (*raw) & 0xFFF;                                                          /* set fractional */
+    *nw_cm2 = 1.2f * powf(2.0f, (float)exponent) * ((float)fractional);                   /* calculate nw/cm2 */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     set low limit
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] limit low limit
+ * @return    status code
+ *            - 0 success
+ *            - 1 set low limit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t opt300x_set_low_limit(opt300x_handle_t *handle, uint16_t limit)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+    
+    a_opt300x_lock(handle);                                                 /* lock */
+    res = a_opt300x_iic_write(handle, OPT300X_REG_LOW_LIMIT, limit);        /* write low limit */
+    a_opt300x_unlock(handle);                                               /* unlock */
+    if (res != 0)                                                           /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: write low limit failed.\n");  /* write low limit failed */
+        
+        return 1;                                                           /* return error */
+    }
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief      get low limit
+ * @param[in]  *handle pointer to an opt300x handle structure
+ * @param[out] *limit pointer to a low limit buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get low limit failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t opt300x_get_low_limit(opt300x_handle_t *handle, uint16_t *limit)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                    /* check handle */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (handle->inited != 1)                                               /* check handle initialization */
+    {
+        return 3;                                                          /* return error */
+    }
+    
+    a_opt300x_lock(handle);                                                /* lock */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_LOW_LIMIT, limit);        /* read low limit */
+    a_opt300x_unlock(handle);                                              /* unlock */
+    if (res != 0)                                                          /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read low limit failed.\n");  /* read low limit failed */
+        
+        return 1;                                                          /* return error */
+    }
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief     set high limit
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] limit high limit
+ * @return    status code
+ *            - 0 success
+ *            - 1 set high limit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t opt300x_set_high_limit(opt300x_handle_t *handle, uint16_t limit)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                      /* check handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                 /* check handle initialization */
+    {
+        return 3;                                                            /* return error */
+    }
+    
+    a_opt300x_lock(handle);                                                  /* lock */
+    res = a_opt300x_iic_write(handle, OPT300X_REG_HIGH_LIMIT, limit);        /* write high limit */
+    a_opt300x_unlock(handle);                                                /* unlock */
+    if (res != 0)                                                            /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: write high limit failed.\n");  /* write high limit failed */
+        
+        return 1;                                                            /* return error */
+    }
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief      get high limit
+ * @param[in]  *handle pointer to an opt300x handle structure
+ * @param[out] *limit pointer to a high limit buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get high limit failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t opt300x_get_high_limit(opt300x_handle_t *handle, uint16_t *limit)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                     /* check handle */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                /* check handle initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+    
+    a_opt300x_lock(handle);                                                 /* lock */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_HIGH_LIMIT, limit);        /* read high limit */
+    a_opt300x_unlock(handle);                                               /* unlock */
+    if (res != 0)                                                           /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read high limit failed.\n");  /* read high limit failed */
+        
+        return 1;                                                           /* return error */
+    }
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief     set the low and high limits together
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] low low limit register code
+ * @param[in] high high limit register code
+ * @return    status code
+ *            - 0 success
+ *            - 1 set limits failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 low is greater than high
+ *            - 5 eoc stream or deadband is running
+ * @note      the widening write goes first and the narrowing write goes last,
+ *            so the transitional window always contains the new window and never raises a spurious flag,
+ *            the eoc stream and the deadband own the limits while they run
+ */
+uint8_t opt300x_set_limits(opt300x_handle_t *handle, uint16_t low, uint16_t high)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if (a_opt300x_code_to_lsb(low) > a_opt300x_code_to_lsb(high))                         /* check the window */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: low is greater than high.\n");              /* low is greater than high */
+        
+        return 4;                                                                         /* return error */
+    }
+    
+    a_opt300x_lock(handle);                                                               /* lock */
+    if (handle->irq_mode != OPT300X_IRQ_MODE_NORMAL)                                      /* check irq mode */
+    {
+        a_opt300x_unlock(handle);                                                         /* unlock */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: eoc stream or deadband is running.\n");     /* eoc stream or deadband is running */
+        
+        return 5;                                                                         /* return error */
+    }
+    res = a_opt300x_write_limits(handle, low, high);                                      /* write limits */
+    a_opt300x_unlock(handle);                                                             /* unlock */
+    if (res != 0)                                                                         /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: write limits failed.\n");                   /* write limits failed */
+        
+        return 1;                                                                         /* return error */
+    }
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     set the low and high limits together in lux
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] low low limit in lux
+ * @param[in] high high limit in lux
+ * @return    status code
+ *            - 0 success
+ *            - 1 set limits failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 low is greater than high or a limit is invalid
+ *            - 5 opt3002 can't use this function
+ *            - 6 eoc stream or deadband is running
+ * @note      none
+ */
+uint8_t opt300x_set_limits_lux(opt300x_handle_t *handle, float low, float high)
+{
+    uint8_t res;
+    uint16_t low_reg;
+    uint16_t high_reg;
+    
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    if (handle->type == (uint8_t)OPT3002)                                                /* check type */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: opt3002 can't use this function.\n");      /* opt3002 can't use this function */
+        
+        return 5;                                                                        /* return error */
+    }
+    
+    if ((isnan(low) != 0) || (isnan(high) != 0) || (low < 0.0f) || (high < 0.0f))        /* check the limits */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: limit is invalid.\n");                     /* limit is invalid */
+        
+        return 4;                                                                        /* return error */
+    }
+    res = opt300x_limit_convert_to_register(handle, low, &low_reg);                      /* convert low */
+    if (res != 0)                                                                        /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: convert low limit failed.\n");             /* convert low limit failed */
+        
+        return 4;                                                                        /* return error */
+    }
+    res = opt300x_limit_convert_to_register(handle, high, &high_reg);                    /* convert high */
+    if (res != 0)                                                                        /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: convert high limit failed.\n");            /* convert high limit failed */
+        
+        return 4;                                                                        /* return error */
+    }
+    res = opt300x_set_limits(handle, low_reg, high_reg);                                 /* set limits */
+    if (res == 5)                                                                        /* eoc stream or deadband is running */
+    {
+        return 6;                                                                        /* return error */
+    }
+    
+    return res;                                                                          /* return the result */
+}
+
+/**
+ * @brief     set the low and high limits together in nW/cm2
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] low low limit in nW/cm2
+ * @param[in] high high limit in nW/cm2
+ * @return    status code
+ *            - 0 success
+ *            - 1 set limits failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 low is greater than high or a limit is invalid
+ *            - 5 only opt3002 can use this function
+ *            - 6 eoc stream or deadband is running
+ * @note      none
+ */
+uint8_t opt3002_set_limits_nw_cm2(opt300x_handle_t *handle, float low, float high)
+{
+    uint8_t res;
+    uint16_t low_reg;
+    uint16_t high_reg;
+    
+    if (handle == NULL)                                                                      /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                 /* check handle initialization */
+    {
+        return 3;                                                                            /* return error */
+    }
+    if (handle->type != (uint8_t)OPT3002)                                                    /* check type */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: only opt3002 can use this function.\n");       /* only opt3002 can use this function */
+        
+        return 5;                                                                            /* return error */
+    }
+    
+    if ((isnan(low) != 0) || (isnan(high) != 0) || (low < 0.0f) || (high < 0.0f))            /* check the limits */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: limit is invalid.\n");                         /* limit is invalid */
+        
+        return 4;                                                                            /* return error */
+    }
+    res = opt3002_limit_convert_to_register(handle, low, &low_reg);                          /* convert low */
+    if (res != 0)                                                                            /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: convert low limit failed.\n");                 /* convert low limit failed */
+        
+        return 4;                                                                            /* return error */
+    }
+    res = opt3002_limit_convert_to_register(handle, high, &high_reg);                        /* convert high */
+    if (res != 0)                                                                            /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: convert high limit failed.\n");                /* convert high limit failed */
+        
+        return 4;                                                                            /* return error */
+    }
+    res = opt300x_set_limits(handle, low_reg, high_reg);                                     /* set limits */
+    if (res == 5)                                                                            /* eoc stream or deadband is running */
+    {
+        return 6;                                                                            /* return error */
+    }
+    
+    return res;                                                                              /* return the result */
+}
+
+/**
+ * @brief      convert the limit threshold to the register raw data
+ * @param[in]  *handle pointer to an opt300x handle structure
+ * @param[in]  lux input lux
+ * @param[out] *reg pointer to a register raw buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 opt3002 can't use this function
+ * @note       none
+ */
+uint8_t opt300x_limit_convert_to_register(opt300x_handle_t *handle, float lux, uint16_t *reg)
+{
+    uint16_t remain;
+    int xp;
+    float f;
+    float fraction;
+    
+    if (handle == NULL)                                                                /* check handle */
+    {
+        return 2;                                                                      /* return error */
+    }
+    if (handle->inited != 1)                                                           /* check handle initialization */
+    {
+        return 3;                                                                      /* return error */
+    }
+    if (handle->type == (uint8_t)OPT3002)                                              /* check type */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: opt3002 can't use this function.\n");    /* opt3002 can't use this function */
+        
+        return 4;                                                                      /* return error */
+    }
+    
+    if (handle->type == (uint8_t)OPT3005)                                              /* opt3005 */
+    {
+        f = lux / 0.02f;                                                               /* convert */
+    }
+    else
+    {
+        f = lux / 0.01f;                                                               /* convert */
+    }
+    fraction = frexpf(f, &xp);                                                         /* run frexp */
+    while ((xp > 0xB) || (fraction < 4095.0f))                                         /* adjust params */
+    {
+        if (xp == 0)                                                                   /* reach the min */
+        {
+            break;                                                                     /* break */
+        }
+        if (fraction * 2.0f > 4095.0f)                                                 /* reach the max */
+        {
+            break;                                                                     /* break */
+        }
+        xp--;                                                                          /* xp-- */
+        fraction *= 2.0f;                                                              /* fraction * 2 */
+    }
+    remain = (uint16_t)fraction;                                                       /* get the integer part */
+    *reg = (((uint16_t)(xp & 0xF)) << 12) | (remain & 0xFFF);                          /* convert real data to register data */
+    
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief      convert the register raw data to the limit threshold
+ * @param[in]  *handle pointer to an opt300x handle structure
+ * @param[in]  reg register raw data
+ * @param[out] *lux pointer to a lux buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 opt3002 can't use this function
+ * @note       none
+ */
+uint8_t opt300x_limit_convert_to_data(opt300x_handle_t *handle, uint16_t reg, float *lux)
+{
+    uint8_t exponent;
+    uint16_t fractional;
+    
+    if (handle == NULL)                                                                /* check handle */
+    {
+        return 2;                                                                      /* return error */
+    }
+    if (handle->inited != 1)                                                           /* check handle initialization */
+    {
+        return 3;                                                                      /* return error */
+    }
+    if (handle->type == (uint8_t)OPT3002)                                              /* check type */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: opt3002 can't use this function.\n");    /* opt3002 can't use this function */
+        
+        return 4;                                                                      /* return error */
+    }
+    
+    exponent = (reg >> 12) & 0xF;                                                      /* set exponent */
+    fractional = reg & 0xFFF;                                                          /* set fractional */
+    if (handle->type == (uint8_t)OPT3005)                                              /* opt3005 */
+    {
+        *lux = 0.02f * powf(2.0f, (float)exponent) * ((float)fractional);              /* calculate lux */
+    }
+    else                                                                               /* the others */
+    {
+        *lux = 0.01f * powf(2.0f, (float)exponent) * ((float)fractional);              /* calculate lux */
     }
     
-    return 0;                                                                  /* success return 0 */
+    return 0;                                                                          /* success return 0 */
 }
 
 /**
- * @brief     stop the chip reading
- * @param[in] *handle pointer to an opt300x handle structure
- * @return    status code
- *            - 0 success
- *            - 1 stop continuous read failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      convert the limit threshold to the register raw data
+ * @param[in]  *handle pointer to an opt300x handle structure
+ * @param[in]  nw_cm2 input data
+ * @param[out] *reg pointer to a register raw buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 only opt3002 can use this function
+ * @note       none
  */
-uint8_t opt300x_stop_continuous_read(opt300x_handle_t *handle)
+uint8_t opt3002_limit_convert_to_register(opt300x_handle_t *handle, float nw_cm2, uint16_t *reg)
 {
-    uint8_t res;
-    uint16_t prev;
+    uint16_t remain;
+    int xp;
+    float f;
+    float fraction;
     
-    if (handle == NULL)                                                        /* check handle */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        return 2;                                                              /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                              /* return error */
+        return 3;                                                                             /* return error */
     }
-    
-    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
-    if (res != 0)                                                              /* check the result */
+    if (handle->type != (uint8_t)OPT3002)                                                     /* check type */
     {
-        handle->debug_print("opt300x: read configuration failed.\n");          /* read configuration failed */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: only opt3002 can use this function.\n");        /* only opt3002 can use this function */
         
-        return 1;                                                              /* return error */
+        return 4;                                                                             /* return error */
     }
-    prev &= ~(3 << 9);                                                         /* clear settings */
-    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);        /* write configuration */
-    if (res != 0)                                                              /* check the result */
+    
+    f = nw_cm2 / 1.2f;                                                                        /* convert */
+    fraction = frexpf(f, &xp);                                                                /* run frexp */
+    while ((xp > 0xB) || (fraction < 4095.0f))                                                /* adjust params */
     {
-        handle->debug_print("opt300x: write configuration failed.\n");         /* write configuration failed */
-        
-        return 1;                                                              /* return error */
+        if (xp == 0)                                                                          /* reach the min */
+        {
+            break;                                                                            /* break */
+        }
+        if (fraction * 2.0f > 4095.0f)                                                        /* reach the max */
+        {
+            break;                                                                            /* break */
+        }
+        xp--;                                                                                 /* xp-- */
+        fraction *= 2.0f;                                                                     /* fraction * 2 */
     }
+    remain = (uint16_t)fraction;                                                              /* get the integer part */
+    *reg = (((uint16_t)(xp & 0xF)) << 12) | (remain & 0xFFF);                                 /* convert real data to register data */
     
-    return 0;                                                                  /* success return 0 */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief      read data from the chip continuously
+ * @brief      convert the register raw data to the limit threshold
  * @param[in]  *handle pointer to an opt300x handle structure
- * @param[out] *raw pointer to a raw data buffer
- * @param[out] *lux pointer to a converted lux buffer
+ * @param[in]  reg register raw data
+ * @param[out] *nw_cm2 pointer to a converted data buffer
  * @return     status code
  *             - 0 success
- *             - 1 read failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 data is overflow
- *             - 5 opt3002 can't use this function
+ *             - 4 only opt3002 can use this function
  * @note       none
  */
-uint8_t opt300x_continuous_read(opt300x_handle_t *handle, uint16_t *raw, float *lux)
+uint8_t opt3002_limit_convert_to_data(opt300x_handle_t *handle, uint16_t reg, float *nw_cm2)
 {
-    uint8_t res;
     uint8_t exponent;
     uint16_t fractional;
-    uint16_t prev;
     
-    if (handle == NULL)                                                      /* check handle */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        return 2;                                                            /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                 /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                            /* return error */
+        return 3;                                                                             /* return error */
     }
-    if (handle->type == (uint8_t)OPT3002)                                    /* check type */
+    if (handle->type != (uint8_t)OPT3002)                                                     /* check type */
     {
-        handle->debug_print("opt300x: opt3002 can't use this function.\n");  /* opt3002 can't use this function */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: only opt3002 can use this function.\n");        /* only opt3002 can use this function */
         
-        return 5;                                                            /* return error */
+        return 4;                                                                             /* return error */
     }
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);      /* read configuration */
-    if (res != 0)                                                            /* check the result */
+    exponent = (reg >> 12) & 0xF;                                                             /* set exponent */
+    fractional = reg & 0xFFF;                                                                 /* set fractional */
+    *nw_cm2 = 1.2f * powf(2.0f, (float)exponent) * ((float)fractional);                       /* calculate lux */
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     set range
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] range set range
+ * @return    status code
+ *            - 0 success
+ *            - 1 set range failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 type is invalid
+ * @note      none
+ */
+uint8_t opt300x_set_range(opt300x_handle_t *handle, opt300x_range_t range)
+{
+    uint8_t res;
+    uint16_t prev;
+    
+    if (handle == NULL)                                                                /* check handle */
     {
-        handle->debug_print("opt300x: read configuration failed.\n");        /* read configuration failed */
-        
-        return 1;                                                            /* return error */
+        return 2;                                                                      /* return error */
+    }
+    if (handle->inited != 1)                                                           /* check handle initialization */
+    {
+        return 3;                                                                      /* return error */
     }
-    if ((prev & (1 << 8)) != 0)                                              /* check ovf bit */
+    if (handle->type == (uint8_t)OPT3002)                                              /* check type */
     {
-        handle->debug_print("opt300x: data is overflow.\n");                 /* data is overflow */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: opt3002 can't use this function.\n");    /* opt3002 can't use this function */
         
-        return 4;                                                            /* return error */
+        return 4;                                                                      /* return error */
     }
-    
-    res = a_opt300x_iic_read(handle, OPT300X_REG_RESULT, raw);               /* read result */
-    if (res != 0)                                                            /* check the result */
+    if (handle->type == (uint8_t)OPT3005)                                              /* check type */
     {
-        handle->debug_print("opt300x: read result failed.\n");               /* read result failed */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: opt3005 can't use this function.\n");    /* opt3005 can't use this function */
         
-        return 1;                                                            /* return error */
+        return 4;                                                                      /* return error */
     }
-    exponent = ((*raw) >> 12) & 0xF;                                         /* set exponent */
-    fractional = (*raw) & 0xFFF;                                             /* set fractional */
-    if (handle->type == (uint8_t)OPT3005)                                    /* opt3005 */
+    
+    a_opt300x_lock(handle);                                                            /* lock */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);                /* read configuration */
+    if (res != 0)                                                                      /* check the result */
     {
-        *lux = 0.02f * powf(2.0f, (float)exponent) * ((float)fractional);    /* calculate lux */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");          /* read configuration failed */
+        a_opt300x_unlock(handle);                                                      /* unlock */
+        
+        return 1;                                                                      /* return error */
     }
-    else                                                                     /* the others */
+    prev &= ~(0xF << 12);                                                              /* clear settings */
+    prev |= range << 12;                                                               /* set range */
+    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);                /* write configuration */
+    if (res != 0)                                                                      /* check the result */
     {
-        *lux = 0.01f * powf(2.0f, (float)exponent) * ((float)fractional);    /* calculate lux */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: write configuration failed.\n");         /* write configuration failed */
+        a_opt300x_unlock(handle);                                                      /* unlock */
+        
+        return 1;                                                                      /* return error */
     }
+    a_opt300x_unlock(handle);                                                          /* unlock */
     
-    return 0;                                                                /* success return 0 */
+    return 0;                                                                          /* success return 0 */
 }
 
 /**
- * @brief      read data from the chip continuously
+ * @brief      get range
  * @param[in]  *handle pointer to an opt300x handle structure
- * @param[out] *raw pointer to a raw data buffer
- * @param[out] *nw_cm2 pointer to a converted data buffer
+ * @param[out] *range pointer to a range buffer
  * @return     status code
  *             - 0 success
- *             - 1 read failed
+ *             - 1 get range failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 data is overflow
- *             - 5 only opt3002 can use this function
+ *             - 4 type is invalid
  * @note       none
  */
-uint8_t opt3002_continuous_read(opt300x_handle_t *handle, uint16_t *raw, float *nw_cm2)
+uint8_t opt300x_get_range(opt300x_handle_t *handle, opt300x_range_t *range)
 {
     uint8_t res;
-    uint8_t exponent;
-    uint16_t fractional;
     uint16_t prev;
     
-    if (handle == NULL)                                                               /* check handle */
+    if (handle == NULL)                                                                /* check handle */
+    {
+        return 2;                                                                      /* return error */
+    }
+    if (handle->inited != 1)                                                           /* check handle initialization */
     {
-        return 2;                                                                     /* return error */
+        return 3;                                                                      /* return error */
     }
-    if (handle->inited != 1)                                                          /* check handle initialization */
+    if (handle->type == (uint8_t)OPT3002)                                              /* check type */
     {
-        return 3;                                                                     /* return error */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: opt3002 can't use this function.\n");    /* opt3002 can't use this function */
+        
+        return 4;                                                                      /* return error */
     }
-    if (handle->type != (uint8_t)OPT3002)                                             /* check type */
+    if (handle->type == (uint8_t)OPT3005)                                              /* check type */
     {
-        handle->debug_print("opt300x: only opt3002 can use this function.\n");        /* only opt3002 can use this function */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: opt3005 can't use this function.\n");    /* opt3005 can't use this function */
         
-        return 5;                                                                     /* return error */
+        return 4;                                                                      /* return error */
     }
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);               /* read configuration */
-    if (res != 0)                                                                     /* check the result */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);                /* read configuration */
+    if (res != 0)                                                                      /* check the result */
     {
-        handle->debug_print("opt300x: read configuration failed.\n");                 /* read configuration failed */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");          /* read configuration failed */
         
-        return 1;                                                                     /* return error */
+        return 1;                                                                      /* return error */
+    }
+    *range = (opt300x_range_t)((prev >> 12) & 0xF);                                    /* set range */
+    
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     set range
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] range set range
+ * @return    status code
+ *            - 0 success
+ *            - 1 set range failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 only opt3002 can use this function
+ * @note      none
+ */
+uint8_t opt3002_set_range(opt300x_handle_t *handle, opt3002_range_t range)
+{
+    uint8_t res;
+    uint16_t prev;
+    
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
     }
-    if ((prev & (1 << 8)) != 0)                                                       /* check ovf bit */
+    if (handle->type != (uint8_t)OPT3002)                                                     /* check type */
     {
-        handle->debug_print("opt300x: data is overflow.\n");                          /* data is overflow */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: only opt3002 can use this function.\n");        /* only opt3002 can use this function */
         
-        return 4;                                                                     /* return error */
+        return 4;                                                                             /* return error */
     }
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_RESULT, raw);                        /* read result */
-    if (res != 0)                                                                     /* check the result */
+    a_opt300x_lock(handle);                                                                   /* lock */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);                       /* read configuration */
+    if (res != 0)                                                                             /* check the result */
     {
-        handle->debug_print("opt300x: read result failed.\n");                        /* read result failed */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");                 /* read configuration failed */
+        a_opt300x_unlock(handle);                                                             /* unlock */
         
-        return 1;                                                                     /* return error */
+        return 1;                                                                             /* return error */
     }
-    exponent = ((*raw) >> 12) & 0xF;                                                  /* set exponent */
-    fractional = (*raw) & 0xFFF;                                                      /* set fractional */
-    *nw_cm2 = 1.2f * powf(2.0f, (float)exponent) * ((float)fractional);               /* calculate nw/cm2 */
+    prev &= ~(0xF << 12);                                                                     /* clear settings */
+    prev |= range << 12;                                                                      /* set range */
+    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);                       /* write configuration */
+    if (res != 0)                                                                             /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: write configuration failed.\n");                /* write configuration failed */
+        a_opt300x_unlock(handle);                                                             /* unlock */
+        
+        return 1;                                                                             /* return error */
+    }
+    a_opt300x_unlock(handle);                                                                 /* unlock */
     
-    return 0;                                                                         /* success return 0 */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief      read data from the chip
+ * @brief      get range
  * @param[in]  *handle pointer to an opt300x handle structure
- * @param[out] *raw pointer to a raw data buffer
- * @param[out] *lux pointer to a converted lux buffer
+ * @param[out] *range pointer to a range buffer
  * @return     status code
  *             - 0 success
- *             - 1 read failed
+ *             - 1 get range failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 data is overflow
- *             - 5 read timeout
- *             - 6 opt3002 can't use this function
+ *             - 4 only opt3002 can use this function
  * @note       none
  */
-uint8_t opt300x_single_read(opt300x_handle_t *handle, uint16_t *raw, float *lux)
+uint8_t opt3002_get_range(opt300x_handle_t *handle, opt3002_range_t *range)
 {
     uint8_t res;
-    uint8_t exponent;
-    uint16_t fractional;
     uint16_t prev;
-    uint32_t timeout = 500;
     
-    if (handle == NULL)                                                          /* check handle */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        return 2;                                                                /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                     /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                                /* return error */
+        return 3;                                                                             /* return error */
     }
-    if (handle->type == (uint8_t)OPT3002)                                        /* check type */
+    if (handle->type != (uint8_t)OPT3002)                                                     /* check type */
     {
-        handle->debug_print("opt300x: opt3002 can't use this function.\n");      /* opt3002 can't use this function */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: only opt3002 can use this function.\n");        /* only opt3002 can use this function */
         
-        return 6;                                                                /* return error */
+        return 4;                                                                             /* return error */
     }
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);          /* read configuration */
-    if (res != 0)                                                                /* check the result */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);                       /* read configuration */
+    if (res != 0)                                                                             /* check the result */
     {
-        handle->debug_print("opt300x: read configuration failed.\n");            /* read configuration failed */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");                 /* read configuration failed */
         
-        return 1;                                                                /* return error */
+        return 1;                                                                             /* return error */
     }
-    prev &= ~(3 << 9);                                                           /* clear settings */
-    prev |= (1 << 9);                                                            /* clear settings */
-    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);          /* write configuration */
-    if (res != 0)                                                                /* check the result */
+    *range = (opt3002_range_t)((prev >> 12) & 0xF);                                           /* set range */
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     set range
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] range set range
+ * @return    status code
+ *            - 0 success
+ *            - 1 set range failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 only opt3005 can use this function
+ * @note      none
+ */
+uint8_t opt3005_set_range(opt300x_handle_t *handle, opt3005_range_t range)
+{
+    uint8_t res;
+    uint16_t prev;
+    
+    if (handle == NULL)                                                                       /* check handle */
     {
-        handle->debug_print("opt300x: write configuration failed.\n");           /* write configuration failed */
-        
-        return 1;                                                                /* return error */
+        return 2;                                                                             /* return error */
     }
-    
-    while (timeout != 0)                                                         /* 5s */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        handle->delay_ms(10);                                                    /* delay 10ms */
-        timeout--;                                                               /* timeout-- */
-        res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);      /* read configuration */
-        if (res != 0)                                                            /* check the result */
-        {
-            handle->debug_print("opt300x: read configuration failed.\n");        /* read configuration failed */
-            
-            return 1;                                                            /* return error */
-        }
-        if ((prev & (1 << 7)) != 0)                                              /* check ready bit */
-        {
-            break;                                                               /* break */
-        }
-        if ((prev & (1 << 8)) != 0)                                              /* check ovf bit */
-        {
-            handle->debug_print("opt300x: data is overflow.\n");                 /* data is overflow */
-            
-            return 4;                                                            /* return error */
-        }
+        return 3;                                                                             /* return error */
     }
-    if (timeout == 0)                                                            /* check timeout */
+    if (handle->type != (uint8_t)OPT3005)                                                     /* check type */
     {
-        handle->debug_print("opt300x: read timeout.\n");                         /* read timeout */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: only opt3005 can use this function.\n");        /* only opt3005 can use this function */
         
-        return 5;                                                                /* return error */
+        return 4;                                                                             /* return error */
     }
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_RESULT, raw);                   /* read result */
-    if (res != 0)                                                                /* check the result */
+    a_opt300x_lock(handle);                                                                   /* lock */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);                       /* read configuration */
+    if (res != 0)                                                                             /* check the result */
     {
-        handle->debug_print("opt300x: read result failed.\n");                   /* read result failed */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");                 /* read configuration failed */
+        a_opt300x_unlock(handle);                                                             /* unlock */
         
-        return 1;                                                                /* return error */
+        return 1;                                                                             /* return error */
     }
-    exponent = ((*raw) >> 12) & 0xF;                                             /* set exponent */
-    fractional = (*raw) & 0xFFF;                                                 /* set fractional */
-    if (handle->type == (uint8_t)OPT3005)                                        /* opt3005 */
+    prev &= ~(0xF << 12);                                                                     /* clear settings */
+    prev |= range << 12;                                                                      /* set range */
+    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);                       /* write configuration */
+    if (res != 0)                                                                             /* check the result */
     {
-        *lux = 0.02f * powf(2.0f, (float)exponent) * ((float)fractional);        /* calculate lux */
-    }
-    else                                                                         /* the others */
-    {
-        *lux = 0.01f * powf(2.0f, (float)exponent) * ((float)fractional);        /* calculate lux */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: write configuration failed.\n");                /* write configuration failed */
+        a_opt300x_unlock(handle);                                                             /* unlock */
+        
+        return 1;                                                                             /* return error */
     }
+    a_opt300x_unlock(handle);                                                                 /* unlock */
     
-    return 0;                                                                    /* success return 0 */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief      read data from the chip
+ * @brief      get range
  * @param[in]  *handle pointer to an opt300x handle structure
- * @param[out] *raw pointer to a raw data buffer
- * @param[out] *nw_cm2 pointer to a converted data buffer
+ * @param[out] *range pointer to a range buffer
  * @return     status code
  *             - 0 success
- *             - 1 read failed
+ *             - 1 get range failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 data is overflow
- *             - 5 read timeout
- *             - 6 only opt3002 can use this function
+ *             - 4 only opt3005 can use this function
  * @note       none
  */
-uint8_t opt3002_single_read(opt300x_handle_t *handle, uint16_t *raw, float *nw_cm2)
+uint8_t opt3005_get_range(opt300x_handle_t *handle, opt3005_range_t *range)
 {
     uint8_t res;
-    uint8_t exponent;
-    uint16_t fractional;
     uint16_t prev;
-    uint32_t timeout = 500;
-    
-    if (handle == NULL)                                                          /* check handle */
-    {
-        return 2;                                                                /* return error */
-    }
-    if (handle->inited != 1)                                                     /* check handle initialization */
-    {
-        return 3;                                                                /* return error */
-    }
-    if (handle->type != (uint8_t)OPT3002)                                        /* check type */
-    {
-        handle->debug_print("opt300x: only opt3002 can use this function.\n");   /* only opt3002 can use this function */
-        
-        return 6;                                                                /* return error */
-    }
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);          /* read configuration */
-    if (res != 0)                                                                /* check the result */
-    {
-        handle->debug_print("opt300x: read configuration failed.\n");            /* read configuration failed */
-        
-        return 1;                                                                /* return error */
-    }
-    prev &= ~(3 << 9);                                                           /* clear settings */
-    prev |= (1 << 9);                                                            /* clear settings */
-    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);          /* write configuration */
-    if (res != 0)                                                                /* check the result */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        handle->debug_print("opt300x: write configuration failed.\n");           /* write configuration failed */
-        
-        return 1;                                                                /* return error */
+        return 2;                                                                             /* return error */
     }
-    
-    while (timeout != 0)                                                         /* 5s */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        handle->delay_ms(10);                                                    /* delay 10ms */
-        timeout--;                                                               /* timeout-- */
-        res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);      /* read configuration */
-        if (res != 0)                                                            /* check the result */
-        {
-            handle->debug_print("opt300x: read configuration failed.\n");        /* read configuration failed */
-            
-            return 1;                                                            /* return error */
-        }
-        if ((prev & (1 << 7)) != 0)                                              /* check ready bit */
-        {
-            break;                                                               /* break */
-        }
-        if ((prev & (1 << 8)) != 0)                                              /* check ovf bit */
-        {
-            handle->debug_print("opt300x: data is overflow.\n");                 /* data is overflow */
-            
-            return 4;                                                            /* return error */
-        }
+        return 3;                                                                             /* return error */
     }
-    if (timeout == 0)                                                            /* check timeout */
+    if (handle->type != (uint8_t)OPT3005)                                                     /* check type */
     {
-        handle->debug_print("opt300x: read timeout.\n");                         /* read timeout */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: only opt3005 can use this function.\n");        /* only opt3005 can use this function */
         
-        return 5;                                                                /* return error */
+        return 4;                                                                             /* return error */
     }
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_RESULT, raw);                   /* read result */
-    if (res != 0)                                                                /* check the result */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);                       /* read configuration */
+    if (res != 0)                                                                             /* check the result */
     {
-        handle->debug_print("opt300x: read result failed.\n");                   /* read result failed */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");                 /* read configuration failed */
         
-        return 1;                                                                /* return error */
+        return 1;                                                                             /* return error */
     }
-    exponent = ((*raw) >> 12) & 0xF;                                             /* set exponent */
-    fractional = (*raw) & 0xFFF;                                                 /* set fractional */
-    *nw_cm2 = 1.2f * powf(2.0f, (float)exponent) * ((float)fractional);          /* calculate nw/cm2 */
+    *range = (opt3005_range_t)((prev >> 12) & 0xF);                                           /* set range */
     
-    return 0;                                                                    /* success return 0 */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     set low limit
+ * @brief     set conversion time
  * @param[in] *handle pointer to an opt300x handle structure
- * @param[in] limit low limit
+ * @param[in] t conversion time
  * @return    status code
  *            - 0 success
- *            - 1 set low limit failed
+ *            - 1 set conversion time failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t opt300x_set_low_limit(opt300x_handle_t *handle, uint16_t limit)
+uint8_t opt300x_set_conversion_time(opt300x_handle_t *handle, opt300x_conversion_time_t t)
 {
     uint8_t res;
+    uint16_t prev;
     
-    if (handle == NULL)                                                     /* check handle */
+    if (handle == NULL)                                                        /* check handle */
     {
-        return 2;                                                           /* return error */
+        return 2;                                                              /* return error */
     }
-    if (handle->inited != 1)                                                /* check handle initialization */
+    if (handle->inited != 1)                                                   /* check handle initialization */
     {
-        return 3;                                                           /* return error */
+        return 3;                                                              /* return error */
     }
     
-    res = a_opt300x_iic_write(handle, OPT300X_REG_LOW_LIMIT, limit);        /* write low limit */
-    if (res != 0)                                                           /* check the result */
+    a_opt300x_lock(handle);                                                    /* lock */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
+    if (res != 0)                                                              /* check the result */
     {
-        handle->debug_print("opt300x: write low limit failed.\n");          /* write low limit failed */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");  /* read configuration failed */
+        a_opt300x_unlock(handle);                                              /* unlock */
         
-        return 1;                                                           /* return error */
+        return 1;                                                              /* return error */
+    }
+    prev &= ~(1 << 11);                                                        /* clear settings */
+    prev |= t << 11;                                                           /* set time */
+    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);        /* write configuration */
+    if (res != 0)                                                              /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: write configuration failed.\n"); /* write configuration failed */
+        a_opt300x_unlock(handle);                                              /* unlock */
+        
+        return 1;                                                              /* return error */
     }
+    a_opt300x_unlock(handle);                                                  /* unlock */
     
-    return 0;                                                               /* success return 0 */
+    return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      get low limit
+ * @brief      get conversion time
  * @param[in]  *handle pointer to an opt300x handle structure
- * @param[out] *limit pointer to a low limit buffer
+ * @param[out] *t pointer to a conversion time buffer
  * @return     status code
  *             - 0 success
- *             - 1 get low limit failed
+ *             - 1 get conversion time failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t opt300x_get_low_limit(opt300x_handle_t *handle, uint16_t *limit)
+uint8_t opt300x_get_conversion_time(opt300x_handle_t *handle, opt300x_conversion_time_t *t)
 {
     uint8_t res;
+    uint16_t prev;
     
-    if (handle == NULL)                                                    /* check handle */
+    if (handle == NULL)                                                        /* check handle */
     {
-        return 2;                                                          /* return error */
+        return 2;                                                              /* return error */
     }
-    if (handle->inited != 1)                                               /* check handle initialization */
+    if (handle->inited != 1)                                                   /* check handle initialization */
     {
-        return 3;                                                          /* return error */
+        return 3;                                                              /* return error */
     }
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_LOW_LIMIT, limit);        /* read low limit */
-    if (res != 0)                                                          /* check the result */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
+    if (res != 0)                                                              /* check the result */
     {
-        handle->debug_print("opt300x: read low limit failed.\n");          /* read low limit failed */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");  /* read configuration failed */
         
-        return 1;                                                          /* return error */
+        return 1;                                                              /* return error */
     }
+    *t = (opt300x_conversion_time_t)((prev >> 11) & 0x01);                     /* set time */
     
-    return 0;                                                              /* success return 0 */
+    return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief     set high limit
+ * @brief     enable or disable interrupt latch
  * @param[in] *handle pointer to an opt300x handle structure
- * @param[in] limit high limit
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set high limit failed
+ *            - 1 set interrupt latch failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t opt300x_set_high_limit(opt300x_handle_t *handle, uint16_t limit)
+uint8_t opt300x_set_interrupt_latch(opt300x_handle_t *handle, opt300x_bool_t enable)
 {
     uint8_t res;
+    uint16_t prev;
     
-    if (handle == NULL)                                                      /* check handle */
+    if (handle == NULL)                                                        /* check handle */
     {
-        return 2;                                                            /* return error */
+        return 2;                                                              /* return error */
     }
-    if (handle->inited != 1)                                                 /* check handle initialization */
+    if (handle->inited != 1)                                                   /* check handle initialization */
     {
-        return 3;                                                            /* return error */
+        return 3;                                                              /* return error */
     }
     
-    res = a_opt300x_iic_write(handle, OPT300X_REG_HIGH_LIMIT, limit);        /* write high limit */
-    if (res != 0)                                                            /* check the result */
+    a_opt300x_lock(handle);                                                    /* lock */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
+    if (res != 0)                                                              /* check the result */
     {
-        handle->debug_print("opt300x: write high limit failed.\n");          /* write high limit failed */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");  /* read configuration failed */
+        a_opt300x_unlock(handle);                                              /* unlock */
         
-        return 1;                                                            /* return error */
+        return 1;                                                              /* return error */
+    }
+    prev &= ~(1 << 4);                                                         /* clear settings */
+    prev |= enable << 4;                                                       /* set bool */
+    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);        /* write configuration */
+    if (res != 0)                                                              /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: write configuration failed.\n"); /* write configuration failed */
+        a_opt300x_unlock(handle);                                              /* unlock */
+        
+        return 1;                                                              /* return error */
     }
+    a_opt300x_unlock(handle);                                                  /* unlock */
     
-    return 0;                                                                /* success return 0 */
+    return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      get high limit
+ * @brief      get interrupt latch status
  * @param[in]  *handle pointer to an opt300x handle structure
- * @param[out] *limit pointer to a high limit buffer
+ * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get high limit failed
+ *             - 1 get interrupt latch failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t opt300x_get_high_limit(opt300x_handle_t *handle, uint16_t *limit)
+uint8_t opt300x_get_interrupt_latch(opt300x_handle_t *handle, opt300x_bool_t *enable)
 {
     uint8_t res;
+    uint16_t prev;
     
-    if (handle == NULL)                                                     /* check handle */
+    if (handle == NULL)                                                        /* check handle */
     {
-        return 2;                                                           /* return error */
+        return 2;                                                              /* return error */
     }
-    if (handle->inited != 1)                                                /* check handle initialization */
+    if (handle->inited != 1)                                                   /* check handle initialization */
     {
-        return 3;                                                           /* return error */
+        return 3;                                                              /* return error */
     }
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_HIGH_LIMIT, limit);        /* read high limit */
-    if (res != 0)                                                           /* check the result */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
+    if (res != 0)                                                              /* check the result */
     {
-        handle->debug_print("opt300x: read high limit failed.\n");          /* read high limit failed */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");  /* read configuration failed */
         
-        return 1;                                                           /* return error */
+        return 1;                                                              /* return error */
     }
+    *enable = (opt300x_bool_t)((prev >> 4) & 0x01);                            /* set bool */
     
-    return 0;                                                               /* success return 0 */
+    return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      convert the limit threshold to the register raw data
- * @param[in]  *handle pointer to an opt300x handle structure
- * @param[in]  lux input lux
- * @param[out] *reg pointer to a register raw buffer
- * @return     status code
- *             - 0 success
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 opt3002 can't use this function
- * @note       none
+ * @brief     set interrupt pin polarity
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] polarity interrupt polarity
+ * @return    status code
+ *            - 0 success
+ *            - 1 set interrupt pin polarity failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
  */
-uint8_t opt300x_limit_convert_to_register(opt300x_handle_t *handle, float lux, uint16_t *reg)
+uint8_t opt300x_set_interrupt_pin_polarity(opt300x_handle_t *handle, opt300x_interrupt_polarity_t polarity)
 {
-    uint16_t remain;
-    int xp;
-    float f;
-    float fraction;
+    uint8_t res;
+    uint16_t prev;
     
-    if (handle == NULL)                                                      /* check handle */
-    {
-        return 2;                                                            /* return error */
-    }
-    if (handle->inited != 1)                                                 /* check handle initialization */
+    if (handle == NULL)                                                        /* check handle */
     {
-        return 3;                                                            /* return error */
+        return 2;                                                              /* return error */
     }
-    if (handle->type == (uint8_t)OPT3002)                                    /* check type */
+    if (handle->inited != 1)                                                   /* check handle initialization */
     {
-        handle->debug_print("opt300x: opt3002 can't use this function.\n");  /* opt3002 can't use this function */
-        
-        return 4;                                                            /* return error */
+        return 3;                                                              /* return error */
     }
     
-    if (handle->type == (uint8_t)OPT3005)                                    /* opt3005 */
-    {
-        f = lux / 0.02f;                                                     /* convert */
-    }
-    else
+    a_opt300x_lock(handle);                                                    /* lock */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
+    if (res != 0)                                                              /* check the result */
     {
-        f = lux / 0.01f;                                                     /* convert */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");  /* read configuration failed */
+        a_opt300x_unlock(handle);                                              /* unlock */
+        
+        return 1;                                                              /* return error */
     }
-    fraction = frexpf(f, &xp);                                               /* run frexp */
-    while ((xp > 0xB) || (fraction < 4095.0f))                               /* adjust params */
+    prev &= ~(1 << 3);                                                         /* clear settings */
+    prev |= polarity << 3;                                                     /* set polarity */
+    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);        /* write configuration */
+    if (res != 0)                                                              /* check the result */
     {
-        if (xp == 0)                                                         /* reach the min */
-        {
-            break;                                                           /* break */
-        }
-        if (fraction * 2.0f > 4095.0f)                                       /* reach the max */
-        {
-            break;                                                           /* break */
-        }
-        xp--;                                                                /* xp-- */
-        fraction *= 2.0f;                                                    /* fraction * 2 */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: write configuration failed.\n"); /* write configuration failed */
+        a_opt300x_unlock(handle);                                              /* unlock */
+        
+        return 1;                                                              /* return error */
     }
-    remain = (uint16_t)fraction;                                             /* get the integer part */
-    *reg = (((uint16_t)(xp & 0xF)) << 12) | (remain & 0xFFF);                /* convert real data to register data */
+    a_opt300x_unlock(handle);                                                  /* unlock */
     
-    return 0;                                                                /* success return 0 */
+    return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      convert the register raw data to the limit threshold
+ * @brief      get interrupt pin polarity
  * @param[in]  *handle pointer to an opt300x handle structure
- * @param[in]  reg register raw data
- * @param[out] *lux pointer to a lux buffer
+ * @param[out] *polarity pointer to an interrupt polarity buffer
  * @return     status code
  *             - 0 success
+ *             - 1 get interrupt pin latch failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 opt3002 can't use this function
  * @note       none
  */
-uint8_t opt300x_limit_convert_to_data(opt300x_handle_t *handle, uint16_t reg, float *lux)
+uint8_t opt300x_get_interrupt_pin_polarity(opt300x_handle_t *handle, opt300x_interrupt_polarity_t *polarity)
 {
-    uint8_t exponent;
-    uint16_t fractional;
+    uint8_t res;
+    uint16_t prev;
     
-    if (handle == NULL)                                                      /* check handle */
-    {
-        return 2;                                                            /* return error */
-    }
-    if (handle->inited != 1)                                                 /* check handle initialization */
+    if (handle == NULL)                                                        /* check handle */
     {
-        return 3;                                                            /* return error */
+        return 2;                                                              /* return error */
     }
-    if (handle->type == (uint8_t)OPT3002)                                    /* check type */
+    if (handle->inited != 1)                                                   /* check handle initialization */
     {
-        handle->debug_print("opt300x: opt3002 can't use this function.\n");  /* opt3002 can't use this function */
-        
-        return 4;                                                            /* return error */
+        return 3;                                                              /* return error */
     }
     
-    exponent = (reg >> 12) & 0xF;                                            /* set exponent */
-    fractional = reg & 0xFFF;                                                /* set fractional */
-    if (handle->type == (uint8_t)OPT3005)                                    /* opt3005 */
-    {
-        *lux = 0.02f * powf(2.0f, (float)exponent) * ((float)fractional);    /* calculate lux */
-    }
-    else                                                                     /* the others */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
+    if (res != 0)                                                              /* check the result */
     {
-        *lux = 0.01f * powf(2.0f, (float)exponent) * ((float)fractional);    /* calculate lux */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");  /* read configuration failed */
+        
+        return 1;                                                              /* return error */
     }
+    *polarity = (opt300x_interrupt_polarity_t)((prev >> 3) & 0x01);            /* set polarity */
     
-    return 0;                                                                /* success return 0 */
+    return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      convert the limit threshold to the register raw data
- * @param[in]  *handle pointer to an opt300x handle structure
- * @param[in]  nw_cm2 input data
- * @param[out] *reg pointer to a register raw buffer
- * @return     status code
- *             - 0 success
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 only opt3002 can use this function
- * @note       none
+ * @brief     enable or disable mask exponent
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set mask exponent failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
  */
-uint8_t opt3002_limit_convert_to_register(opt300x_handle_t *handle, float nw_cm2, uint16_t *reg)
+uint8_t opt300x_set_mask_exponent(opt300x_handle_t *handle, opt300x_bool_t enable)
 {
-    uint16_t remain;
-    int xp;
-    float f;
-    float fraction;
+    uint8_t res;
+    uint16_t prev;
     
-    if (handle == NULL)                                                               /* check handle */
+    if (handle == NULL)                                                        /* check handle */
     {
-        return 2;                                                                     /* return error */
+        return 2;                                                              /* return error */
     }
-    if (handle->inited != 1)                                                          /* check handle initialization */
+    if (handle->inited != 1)                                                   /* check handle initialization */
     {
-        return 3;                                                                     /* return error */
+        return 3;                                                              /* return error */
     }
-    if (handle->type != (uint8_t)OPT3002)                                             /* check type */
+    
+    a_opt300x_lock(handle);                                                    /* lock */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
+    if (res != 0)                                                              /* check the result */
     {
-        handle->debug_print("opt300x: only opt3002 can use this function.\n");        /* only opt3002 can use this function */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");  /* read configuration failed */
+        a_opt300x_unlock(handle);                                              /* unlock */
         
-        return 4;                                                                     /* return error */
+        return 1;                                                              /* return error */
     }
-    
-    f = nw_cm2 / 1.2f;                                                                /* convert */
-    fraction = frexpf(f, &xp);                                                        /* run frexp */
-    while ((xp > 0xB) || (fraction < 4095.0f))                                        /* adjust params */
+    prev &= ~(1 << 2);                                                         /* clear settings */
+    prev |= enable << 2;                                                       /* set bool */
+    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);        /* write configuration */
+    if (res != 0)                                                              /* check the result */
     {
-        if (xp == 0)                                                                  /* reach the min */
-        {
-            break;                                                                    /* break */
-        }
-        if (fraction * 2.0f > 4095.0f)                                                /* reach the max */
-        {
-            break;                                                                    /* break */
-        }
-        xp--;                                                                         /* xp-- */
-        fraction *= 2.0f;                                                             /* fraction * 2 */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: write configuration failed.\n"); /* write configuration failed */
+        a_opt300x_unlock(handle);                                              /* unlock */
+        
+        return 1;                                                              /* return error */
     }
-    remain = (uint16_t)fraction;                                                      /* get the integer part */
-    *reg = (((uint16_t)(xp & 0xF)) << 12) | (remain & 0xFFF);                         /* convert real data to register data */
+    a_opt300x_unlock(handle);                                                  /* unlock */
     
-    return 0;                                                                         /* success return 0 */
+    return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      convert the register raw data to the limit threshold
+ * @brief      get mask exponent status
  * @param[in]  *handle pointer to an opt300x handle structure
- * @param[in]  reg register raw data
- * @param[out] *nw_cm2 pointer to a converted data buffer
+ * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
+ *             - 1 get mask exponent failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 only opt3002 can use this function
  * @note       none
  */
-uint8_t opt3002_limit_convert_to_data(opt300x_handle_t *handle, uint16_t reg, float *nw_cm2)
+uint8_t opt300x_get_mask_exponent(opt300x_handle_t *handle, opt300x_bool_t *enable)
 {
-    uint8_t exponent;
-    uint16_t fractional;
+    uint8_t res;
+    uint16_t prev;
     
-    if (handle == NULL)                                                               /* check handle */
+    if (handle == NULL)                                                        /* check handle */
     {
-        return 2;                                                                     /* return error */
+        return 2;                                                              /* return error */
     }
-    if (handle->inited != 1)                                                          /* check handle initialization */
+    if (handle->inited != 1)                                                   /* check handle initialization */
     {
-        return 3;                                                                     /* return error */
+        return 3;                                                              /* return error */
     }
-    if (handle->type != (uint8_t)OPT3002)                                             /* check type */
+    
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
+    if (res != 0)                                                              /* check the result */
     {
-        handle->debug_print("opt300x: only opt3002 can use this function.\n");        /* only opt3002 can use this function */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");  /* read configuration failed */
         
-        return 4;                                                                     /* return error */
+        return 1;                                                              /* return error */
     }
+    *enable = (opt300x_bool_t)((prev >> 2) & 0x01);                            /* set bool */
     
-    exponent = (reg >> 12) & 0xF;                                                     /* set exponent */
-    fractional = reg & 0xFFF;                                                         /* set fractional */
-    *nw_cm2 = 1.2f * powf(2.0f, (float)exponent) * ((float)fractional);               /* calculate lux */
-    
-    return 0;                                                                         /* success return 0 */
+    return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief     set range
+ * @brief     set fault count
  * @param[in] *handle pointer to an opt300x handle structure
- * @param[in] range set range
+ * @param[in] count fault count
  * @return    status code
  *            - 0 success
- *            - 1 set range failed
+ *            - 1 set fault count failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 type is invalid
  * @note      none
  */
-uint8_t opt300x_set_range(opt300x_handle_t *handle, opt300x_range_t range)
+uint8_t opt300x_set_fault_count(opt300x_handle_t *handle, opt300x_fault_count_t count)
 {
     uint8_t res;
     uint16_t prev;
@@ -1136,52 +2883,43 @@ uint8_t opt300x_set_range(opt300x_handle_t *handle, opt300x_range_t range)
     {
         return 3;                                                              /* return error */
     }
-    if (handle->type == (uint8_t)OPT3002)                                      /* check type */
-    {
-        handle->debug_print("opt300x: opt3002 can't use this function.\n");    /* opt3002 can't use this function */
-        
-        return 4;                                                              /* return error */
-    }
-    if (handle->type == (uint8_t)OPT3005)                                      /* check type */
-    {
-        handle->debug_print("opt300x: opt3005 can't use this function.\n");    /* opt3005 can't use this function */
-        
-        return 4;                                                              /* return error */
-    }
     
+    a_opt300x_lock(handle);                                                    /* lock */
     res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
     if (res != 0)                                                              /* check the result */
     {
-        handle->debug_print("opt300x: read configuration failed.\n");          /* read configuration failed */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");  /* read configuration failed */
+        a_opt300x_unlock(handle);                                              /* unlock */
         
         return 1;                                                              /* return error */
     }
-    prev &= ~(0xF << 12);                                                      /* clear settings */
-    prev |= range << 12;                                                       /* set range */
+    prev &= ~(3 << 0);                                                         /* clear settings */
+    prev |= count << 0;                                                        /* set count */
     res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);        /* write configuration */
     if (res != 0)                                                              /* check the result */
     {
-        handle->debug_print("opt300x: write configuration failed.\n");         /* write configuration failed */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: write configuration failed.\n"); /* write configuration failed */
+        a_opt300x_unlock(handle);                                              /* unlock */
         
         return 1;                                                              /* return error */
     }
+    a_opt300x_unlock(handle);                                                  /* unlock */
     
     return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      get range
+ * @brief      get fault count
  * @param[in]  *handle pointer to an opt300x handle structure
- * @param[out] *range pointer to a range buffer
+ * @param[out] *count pointer to a fault count buffer
  * @return     status code
  *             - 0 success
- *             - 1 get range failed
+ *             - 1 get fault count failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 type is invalid
  * @note       none
  */
-uint8_t opt300x_get_range(opt300x_handle_t *handle, opt300x_range_t *range)
+uint8_t opt300x_get_fault_count(opt300x_handle_t *handle, opt300x_fault_count_t *count)
 {
     uint8_t res;
     uint16_t prev;
@@ -1194,681 +2932,871 @@ uint8_t opt300x_get_range(opt300x_handle_t *handle, opt300x_range_t *range)
     {
         return 3;                                                              /* return error */
     }
-    if (handle->type == (uint8_t)OPT3002)                                      /* check type */
-    {
-        handle->debug_print("opt300x: opt3002 can't use this function.\n");    /* opt3002 can't use this function */
-        
-        return 4;                                                              /* return error */
-    }
-    if (handle->type == (uint8_t)OPT3005)                                      /* check type */
-    {
-        handle->debug_print("opt300x: opt3005 can't use this function.\n");    /* opt3005 can't use this function */
-        
-        return 4;                                                              /* return error */
-    }
     
     res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
     if (res != 0)                                                              /* check the result */
     {
-        handle->debug_print("opt300x: read configuration failed.\n");          /* read configuration failed */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");  /* read configuration failed */
         
         return 1;                                                              /* return error */
     }
-    *range = (opt300x_range_t)((prev >> 12) & 0xF);                            /* set range */
+    *count = (opt300x_fault_count_t)((prev >> 0) & 0x03);                      /* set count */
     
     return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief     set range
+ * @brief     irq handler
  * @param[in] *handle pointer to an opt300x handle structure
- * @param[in] range set range
  * @return    status code
  *            - 0 success
- *            - 1 set range failed
+ *            - 1 run failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 only opt3002 can use this function
- * @note      none
+ * @note      the configuration register is read once, the result register is read once more only if
+ *            a mode or the event_callback needs the sample
  */
-uint8_t opt3002_set_range(opt300x_handle_t *handle, opt3002_range_t range)
+uint8_t opt300x_irq_handler(opt300x_handle_t *handle)
 {
-    uint8_t res;
     uint16_t prev;
+    uint64_t timestamp;
     
-    if (handle == NULL)                                                               /* check handle */
-    {
-        return 2;                                                                     /* return error */
-    }
-    if (handle->inited != 1)                                                          /* check handle initialization */
+    if (handle == NULL)                                                                         /* check handle */
     {
-        return 3;                                                                     /* return error */
+        return 2;                                                                               /* return error */
     }
-    if (handle->type != (uint8_t)OPT3002)                                             /* check type */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        handle->debug_print("opt300x: only opt3002 can use this function.\n");        /* only opt3002 can use this function */
-        
-        return 4;                                                                     /* return error */
+        return 3;                                                                               /* return error */
     }
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);               /* read configuration */
-    if (res != 0)                                                                     /* check the result */
+    timestamp = (handle->timestamp_us != NULL) ? handle->timestamp_us() : 0;                    /* stamp the edge first */
+    if (handle->storm_enable != 0)                                                              /* storm control */
     {
-        handle->debug_print("opt300x: read configuration failed.\n");                 /* read configuration failed */
-        
-        return 1;                                                                     /* return error */
+        a_opt300x_lock(handle);                                                                 /* lock */
+        handle->storm_stat.irq_count++;                                                         /* irq++ */
+        if (handle->storm_stat.masked != 0)                                                     /* polling mode */
+        {
+            handle->storm_stat.irq_masked++;                                                    /* masked++ */
+            a_opt300x_unlock(handle);                                                           /* unlock */
+            
+            return 0;                                                                           /* leave it to the poll */
+        }
+        if ((timestamp - handle->storm_window_start) >= 1000000)                                /* new 1s window */
+        {
+            handle->storm_window_start = timestamp;                                             /* set window start */
+            handle->storm_window_irq = 0;                                                       /* clear window irq */
+        }
+        handle->storm_window_irq++;                                                             /* window irq++ */
+        if (handle->storm_window_irq > handle->storm_rate)                                      /* check rate */
+        {
+            handle->storm_stat.masked = 1;                                                      /* switch to polling */
+            handle->storm_stat.enter_count++;                                                   /* enter++ */
+            handle->storm_quiet = 0;                                                            /* clear quiet polls */
+            a_opt300x_unlock(handle);                                                           /* unlock */
+            
+            return 0;                                                                           /* leave it to the poll */
+        }
+        a_opt300x_unlock(handle);                                                               /* unlock */
     }
-    prev &= ~(0xF << 12);                                                             /* clear settings */
-    prev |= range << 12;                                                              /* set range */
-    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);               /* write configuration */
-    if (res != 0)                                                                     /* check the result */
+    
+    if (a_opt300x_irq_process(handle, timestamp, &prev) != 0)                                   /* handle the irq */
     {
-        handle->debug_print("opt300x: write configuration failed.\n");                /* write configuration failed */
-        
-        return 1;                                                                     /* return error */
+        return 1;                                                                               /* return error */
     }
     
-    return 0;                                                                         /* success return 0 */
+    return 0;                                                                                   /* success return 0 */
 }
 
 /**
- * @brief      get range
- * @param[in]  *handle pointer to an opt300x handle structure
- * @param[out] *range pointer to a range buffer
- * @return     status code
- *             - 0 success
- *             - 1 get range failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 only opt3002 can use this function
- * @note       none
+ * @brief     start the deadband mode
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] policy window width policy
+ * @param[in] width window width in lux or nW/cm2, in percent or in stops
+ * @return    status code
+ *            - 0 success
+ *            - 1 start deadband failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 width is invalid
+ *            - 5 chip is not in the continuous mode
+ * @note      call it after opt300x_start_continuous_read, the interrupt is switched to the latched window mode,
+ *            every irq re-centres the window around the new reading and reports it by the sample_callback
+ *            percent width range is (0, 100), log width range is (0, 8]
  */
-uint8_t opt3002_get_range(opt300x_handle_t *handle, opt3002_range_t *range)
+uint8_t opt300x_start_deadband(opt300x_handle_t *handle, opt300x_deadband_policy_t policy, float width)
 {
     uint8_t res;
     uint16_t prev;
+    uint16_t raw;
+    uint32_t deadband_width;
+    float f;
     
-    if (handle == NULL)                                                               /* check handle */
+    if (handle == NULL)                                                                   /* check handle */
     {
-        return 2;                                                                     /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                          /* check handle initialization */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        return 3;                                                                     /* return error */
+        return 3;                                                                         /* return error */
     }
-    if (handle->type != (uint8_t)OPT3002)                                             /* check type */
+    if ((isnan(width) != 0) || (width <= 0.0f))                                           /* check width */
     {
-        handle->debug_print("opt300x: only opt3002 can use this function.\n");        /* only opt3002 can use this function */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: width is invalid.\n");                      /* width is invalid */
         
-        return 4;                                                                     /* return error */
+        return 4;                                                                         /* return error */
+    }
+    if (policy == OPT300X_DEADBAND_POLICY_ABSOLUTE)                                       /* absolute */
+    {
+        f = width / a_opt300x_lsb_weight(handle) + 0.5f;                                  /* lsb counts */
+        if (f > (float)OPT300X_LSB_MAX)                                                   /* check width */
+        {
+            OPT300X_DEBUG_ERROR(handle, "opt300x: width is invalid.\n");                  /* width is invalid */
+            
+            return 4;                                                                     /* return error */
+        }
+        deadband_width = (f < 1.0f) ? 1 : (uint32_t)f;                                    /* at least one lsb */
+    }
+    else if (policy == OPT300X_DEADBAND_POLICY_PERCENT)                                   /* percent */
+    {
+        if (width >= 100.0f)                                                              /* check width */
+        {
+            OPT300X_DEBUG_ERROR(handle, "opt300x: width is invalid.\n");                  /* width is invalid */
+            
+            return 4;                                                                     /* return error */
+        }
+        deadband_width = (uint32_t)(width / 100.0f * 65536.0f);                           /* 16.16 fraction */
+    }
+    else                                                                                  /* log */
+    {
+        if (width > 8.0f)                                                                 /* check width */
+        {
+            OPT300X_DEBUG_ERROR(handle, "opt300x: width is invalid.\n");                  /* width is invalid */
+            
+            return 4;                                                                     /* return error */
+        }
+        deadband_width = (uint32_t)(powf(2.0f, width) * 65536.0f);                        /* 16.16 factor */
     }
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);               /* read configuration */
-    if (res != 0)                                                                     /* check the result */
+    a_opt300x_lock(handle);                                                               /* lock */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);                   /* read configuration */
+    if (res != 0)                                                                         /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");             /* read configuration failed */
+        a_opt300x_unlock(handle);                                                         /* unlock */
+        
+        return 1;                                                                         /* return error */
+    }
+    if ((prev & (2 << 9)) == 0)                                                           /* check the continuous mode */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: chip is not in the continuous mode.\n");    /* not continuous */
+        a_opt300x_unlock(handle);                                                         /* unlock */
+        
+        return 5;                                                                         /* return error */
+    }
+    handle->deadband_policy = (uint8_t)policy;                                            /* set policy */
+    handle->deadband_width = deadband_width;                                              /* set width */
+    prev |= 1 << 4;                                                                       /* latched window mode */
+    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);                   /* write configuration */
+    if (res != 0)                                                                         /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: write configuration failed.\n");            /* write configuration failed */
+        a_opt300x_unlock(handle);                                                         /* unlock */
+        
+        return 1;                                                                         /* return error */
+    }
+    res = a_opt300x_iic_read(handle, OPT300X_REG_RESULT, &raw);                           /* read result */
+    if (res != 0)                                                                         /* check the result */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read result failed.\n");                    /* read result failed */
+        a_opt300x_unlock(handle);                                                         /* unlock */
+        
+        return 1;                                                                         /* return error */
+    }
+    res = a_opt300x_deadband_rearm(handle, raw);                                          /* centre the window */
+    if (res != 0)                                                                         /* check the result */
     {
-        handle->debug_print("opt300x: read configuration failed.\n");                 /* read configuration failed */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: write limit failed.\n");                    /* write limit failed */
+        a_opt300x_unlock(handle);                                                         /* unlock */
         
-        return 1;                                                                     /* return error */
+        return 1;                                                                         /* return error */
     }
-    *range = (opt3002_range_t)((prev >> 12) & 0xF);                                   /* set range */
+    handle->deadband_rearm = 0;                                                           /* the first window is not a re-arm */
+    handle->irq_mode = OPT300X_IRQ_MODE_DEADBAND;                                         /* deadband irq mode */
+    a_opt300x_unlock(handle);                                                             /* unlock */
     
-    return 0;                                                                         /* success return 0 */
+    return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief     set range
+ * @brief     stop the deadband mode
  * @param[in] *handle pointer to an opt300x handle structure
- * @param[in] range set range
  * @return    status code
  *            - 0 success
- *            - 1 set range failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 only opt3005 can use this function
- * @note      none
+ * @note      the last programmed window is kept in the chip
  */
-uint8_t opt3005_set_range(opt300x_handle_t *handle, opt3005_range_t range)
+uint8_t opt300x_stop_deadband(opt300x_handle_t *handle)
 {
-    uint8_t res;
-    uint16_t prev;
-    
-    if (handle == NULL)                                                               /* check handle */
-    {
-        return 2;                                                                     /* return error */
-    }
-    if (handle->inited != 1)                                                          /* check handle initialization */
+    if (handle == NULL)                                     /* check handle */
     {
-        return 3;                                                                     /* return error */
+        return 2;                                           /* return error */
     }
-    if (handle->type != (uint8_t)OPT3005)                                             /* check type */
+    if (handle->inited != 1)                                /* check handle initialization */
     {
-        handle->debug_print("opt300x: only opt3005 can use this function.\n");        /* only opt3005 can use this function */
-        
-        return 4;                                                                     /* return error */
+        return 3;                                           /* return error */
     }
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);               /* read configuration */
-    if (res != 0)                                                                     /* check the result */
-    {
-        handle->debug_print("opt300x: read configuration failed.\n");                 /* read configuration failed */
-        
-        return 1;                                                                     /* return error */
-    }
-    prev &= ~(0xF << 12);                                                             /* clear settings */
-    prev |= range << 12;                                                              /* set range */
-    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);               /* write configuration */
-    if (res != 0)                                                                     /* check the result */
-    {
-        handle->debug_print("opt300x: write configuration failed.\n");                /* write configuration failed */
-        
-        return 1;                                                                     /* return error */
-    }
+    a_opt300x_lock(handle);                                 /* lock */
+    handle->irq_mode = OPT300X_IRQ_MODE_NORMAL;             /* normal irq mode */
+    a_opt300x_unlock(handle);                               /* unlock */
     
-    return 0;                                                                         /* success return 0 */
+    return 0;                                               /* success return 0 */
 }
 
 /**
- * @brief      get range
+ * @brief      get the deadband re-arm counter
  * @param[in]  *handle pointer to an opt300x handle structure
- * @param[out] *range pointer to a range buffer
+ * @param[out] *count pointer to a counter buffer
  * @return     status code
  *             - 0 success
- *             - 1 get range failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 only opt3005 can use this function
- * @note       none
+ * @note       the counter is cleared by opt300x_start_deadband
  */
-uint8_t opt3005_get_range(opt300x_handle_t *handle, opt3005_range_t *range)
+uint8_t opt300x_get_deadband_rearm_count(opt300x_handle_t *handle, uint32_t *count)
 {
-    uint8_t res;
-    uint16_t prev;
-    
-    if (handle == NULL)                                                               /* check handle */
-    {
-        return 2;                                                                     /* return error */
-    }
-    if (handle->inited != 1)                                                          /* check handle initialization */
+    if (handle == NULL)                          /* check handle */
     {
-        return 3;                                                                     /* return error */
+        return 2;                                /* return error */
     }
-    if (handle->type != (uint8_t)OPT3005)                                             /* check type */
+    if (handle->inited != 1)                     /* check handle initialization */
     {
-        handle->debug_print("opt300x: only opt3005 can use this function.\n");        /* only opt3005 can use this function */
-        
-        return 4;                                                                     /* return error */
+        return 3;                                /* return error */
     }
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);               /* read configuration */
-    if (res != 0)                                                                     /* check the result */
-    {
-        handle->debug_print("opt300x: read configuration failed.\n");                 /* read configuration failed */
-        
-        return 1;                                                                     /* return error */
-    }
-    *range = (opt3005_range_t)((prev >> 12) & 0xF);                                   /* set range */
+    *count = handle->deadband_rearm;             /* get counter */
     
-    return 0;                                                                         /* success return 0 */
+    return 0;                                    /* success return 0 */
 }
 
 /**
- * @brief     set conversion time
+ * @brief     start the end of conversion stream mode
  * @param[in] *handle pointer to an opt300x handle structure
- * @param[in] t conversion time
  * @return    status code
  *            - 0 success
- *            - 1 set conversion time failed
+ *            - 1 start eoc stream failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the low limit is set to the end of conversion pattern and the chip runs continuously in the latched mode,
+ *            every irq with the conversion ready flag reports one sample by the sample_callback
  */
-uint8_t opt300x_set_conversion_time(opt300x_handle_t *handle, opt300x_conversion_time_t t)
+uint8_t opt300x_start_eoc_stream(opt300x_handle_t *handle)
 {
     uint8_t res;
     uint16_t prev;
     
-    if (handle == NULL)                                                        /* check handle */
+    if (handle == NULL)                                                                         /* check handle */
     {
-        return 2;                                                              /* return error */
+        return 2;                                                                               /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        return 3;                                                              /* return error */
+        return 3;                                                                               /* return error */
     }
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
-    if (res != 0)                                                              /* check the result */
+    a_opt300x_lock(handle);                                                                     /* lock */
+    if (handle->irq_mode != OPT300X_IRQ_MODE_EOC)                                               /* not streaming yet */
     {
-        handle->debug_print("opt300x: read configuration failed.\n");          /* read configuration failed */
-        
-        return 1;                                                              /* return error */
+        res = a_opt300x_iic_read(handle, OPT300X_REG_LOW_LIMIT, &handle->eoc_low_limit);        /* save low limit */
+        if (res != 0)                                                                           /* check the result */
+        {
+            OPT300X_DEBUG_ERROR(handle, "opt300x: read low limit failed.\n");                   /* read low limit failed */
+            a_opt300x_unlock(handle);                                                           /* unlock */
+            
+            return 1;                                                                           /* return error */
+        }
     }
-    prev &= ~(1 << 11);                                                        /* clear settings */
-    prev |= t << 11;                                                           /* set time */
-    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);        /* write configuration */
-    if (res != 0)                                                              /* check the result */
+    res = a_opt300x_iic_write(handle, OPT300X_REG_LOW_LIMIT, OPT300X_EOC_LOW_LIMIT);            /* write eoc pattern */
+    if (res != 0)                                                                               /* check the result */
     {
-        handle->debug_print("opt300x: write configuration failed.\n");         /* write configuration failed */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: write low limit failed.\n");                      /* write low limit failed */
+        a_opt300x_unlock(handle);                                                               /* unlock */
         
-        return 1;                                                              /* return error */
-    }
-    
-    return 0;                                                                  /* success return 0 */
-}
-
-/**
- * @brief      get conversion time
- * @param[in]  *handle pointer to an opt300x handle structure
- * @param[out] *t pointer to a conversion time buffer
- * @return     status code
- *             - 0 success
- *             - 1 get conversion time failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
- */
-uint8_t opt300x_get_conversion_time(opt300x_handle_t *handle, opt300x_conversion_time_t *t)
-{
-    uint8_t res;
-    uint16_t prev;
-    
-    if (handle == NULL)                                                        /* check handle */
-    {
-        return 2;                                                              /* return error */
+        return 1;                                                                               /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);                         /* read configuration */
+    if (res != 0)                                                                               /* check the result */
     {
-        return 3;                                                              /* return error */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");                   /* read configuration failed */
+        a_opt300x_unlock(handle);                                                               /* unlock */
+        
+        return 1;                                                                               /* return error */
     }
-    
-    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
-    if (res != 0)                                                              /* check the result */
+    prev &= ~(3 << 9);                                                                          /* clear settings */
+    prev |= (2 << 9) | (1 << 4);                                                                /* continuous conversions and latch */
+    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);                         /* write configuration */
+    if (res != 0)                                                                               /* check the result */
     {
-        handle->debug_print("opt300x: read configuration failed.\n");          /* read configuration failed */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: write configuration failed.\n");                  /* write configuration failed */
+        a_opt300x_unlock(handle);                                                               /* unlock */
         
-        return 1;                                                              /* return error */
+        return 1;                                                                               /* return error */
     }
-    *t = (opt300x_conversion_time_t)((prev >> 11) & 0x01);                     /* set time */
+    handle->eoc_sample = 0;                                                                     /* clear counter */
+    handle->eoc_spurious = 0;                                                                   /* clear counter */
+    handle->irq_mode = OPT300X_IRQ_MODE_EOC;                                                    /* eoc irq mode */
+    a_opt300x_unlock(handle);                                                                   /* unlock */
     
-    return 0;                                                                  /* success return 0 */
+    return 0;                                                                                   /* success return 0 */
 }
 
 /**
- * @brief     enable or disable interrupt latch
+ * @brief     stop the end of conversion stream mode
  * @param[in] *handle pointer to an opt300x handle structure
- * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set interrupt latch failed
+ *            - 1 stop eoc stream failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the low limit saved by opt300x_start_eoc_stream is restored, the conversion keeps running
  */
-uint8_t opt300x_set_interrupt_latch(opt300x_handle_t *handle, opt300x_bool_t enable)
+uint8_t opt300x_stop_eoc_stream(opt300x_handle_t *handle)
 {
     uint8_t res;
-    uint16_t prev;
     
-    if (handle == NULL)                                                        /* check handle */
+    if (handle == NULL)                                                                         /* check handle */
     {
-        return 2;                                                              /* return error */
+        return 2;                                                                               /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        return 3;                                                              /* return error */
+        return 3;                                                                               /* return error */
     }
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
-    if (res != 0)                                                              /* check the result */
-    {
-        handle->debug_print("opt300x: read configuration failed.\n");          /* read configuration failed */
-        
-        return 1;                                                              /* return error */
-    }
-    prev &= ~(1 << 4);                                                         /* clear settings */
-    prev |= enable << 4;                                                       /* set bool */
-    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);        /* write configuration */
-    if (res != 0)                                                              /* check the result */
+    a_opt300x_lock(handle);                                                                     /* lock */
+    if (handle->irq_mode == OPT300X_IRQ_MODE_EOC)                                               /* streaming */
     {
-        handle->debug_print("opt300x: write configuration failed.\n");         /* write configuration failed */
-        
-        return 1;                                                              /* return error */
+        res = a_opt300x_iic_write(handle, OPT300X_REG_LOW_LIMIT, handle->eoc_low_limit);        /* restore low limit */
+        if (res != 0)                                                                           /* check the result */
+        {
+            OPT300X_DEBUG_ERROR(handle, "opt300x: write low limit failed.\n");                  /* write low limit failed */
+            a_opt300x_unlock(handle);                                                           /* unlock */
+            
+            return 1;                                                                           /* return error */
+        }
+        handle->irq_mode = OPT300X_IRQ_MODE_NORMAL;                                             /* normal irq mode */
     }
+    a_opt300x_unlock(handle);                                                                   /* unlock */
     
-    return 0;                                                                  /* success return 0 */
+    return 0;                                                                                   /* success return 0 */
 }
 
 /**
- * @brief      get interrupt latch status
+ * @brief      get the end of conversion stream counters
  * @param[in]  *handle pointer to an opt300x handle structure
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *sample pointer to a delivered sample counter buffer
+ * @param[out] *spurious pointer to a spurious edge counter buffer
  * @return     status code
  *             - 0 success
- *             - 1 get interrupt latch failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note       the counters are cleared by opt300x_start_eoc_stream
  */
-uint8_t opt300x_get_interrupt_latch(opt300x_handle_t *handle, opt300x_bool_t *enable)
+uint8_t opt300x_get_eoc_stream_count(opt300x_handle_t *handle, uint32_t *sample, uint32_t *spurious)
 {
-    uint8_t res;
-    uint16_t prev;
-    
-    if (handle == NULL)                                                        /* check handle */
+    if (handle == NULL)                           /* check handle */
     {
-        return 2;                                                              /* return error */
+        return 2;                                 /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    if (handle->inited != 1)                      /* check handle initialization */
     {
-        return 3;                                                              /* return error */
+        return 3;                                 /* return error */
     }
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
-    if (res != 0)                                                              /* check the result */
-    {
-        handle->debug_print("opt300x: read configuration failed.\n");          /* read configuration failed */
-        
-        return 1;                                                              /* return error */
-    }
-    *enable = (opt300x_bool_t)((prev >> 4) & 0x01);                            /* set bool */
+    *sample = handle->eoc_sample;                 /* get counter */
+    *spurious = handle->eoc_spurious;             /* get counter */
     
-    return 0;                                                                  /* success return 0 */
+    return 0;                                     /* success return 0 */
 }
 
 /**
- * @brief     set interrupt pin polarity
+ * @brief     start the interrupt storm control
  * @param[in] *handle pointer to an opt300x handle structure
- * @param[in] polarity interrupt polarity
+ * @param[in] rate max irq rate in Hz
+ * @param[in] calm quiet polls before the interrupt mode is restored
  * @return    status code
  *            - 0 success
- *            - 1 set interrupt pin polarity failed
+ *            - 1 start storm control failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 timestamp_us is NULL
+ *            - 5 rate or calm is invalid
+ *            - 6 interrupt latch is disabled
+ * @note      above the rate the irq handler returns without any bus access, the latched interrupt stays asserted
+ *            and the application must call opt300x_storm_poll periodically until the activity calms,
+ *            so the latched mode must be set before by opt300x_set_interrupt_latch
  */
-uint8_t opt300x_set_interrupt_pin_polarity(opt300x_handle_t *handle, opt300x_interrupt_polarity_t polarity)
+uint8_t opt300x_start_storm_control(opt300x_handle_t *handle, uint32_t rate, uint32_t calm)
 {
     uint8_t res;
     uint16_t prev;
     
-    if (handle == NULL)                                                        /* check handle */
+    if (handle == NULL)                                                            /* check handle */
     {
-        return 2;                                                              /* return error */
+        return 2;                                                                  /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    if (handle->inited != 1)                                                       /* check handle initialization */
     {
-        return 3;                                                              /* return error */
+        return 3;                                                                  /* return error */
+    }
+    if (handle->timestamp_us == NULL)                                              /* check timestamp_us */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: timestamp_us is null.\n");           /* timestamp_us is null */
+        
+        return 4;                                                                  /* return error */
+    }
+    if ((rate == 0) || (calm == 0))                                                /* check rate and calm */
+    {
+        OPT300X_DEBUG_ERROR(handle, "opt300x: rate or calm is invalid.\n");        /* rate or calm is invalid */
+        
+        return 5;                                                                  /* return error */
     }
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
-    if (res != 0)                                                              /* check the result */
+    a_opt300x_lock(handle);                                                        /* lock */
+    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);            /* read configuration */
+    if (res != 0)                                                                  /* check the result */
     {
-        handle->debug_print("opt300x: read configuration failed.\n");          /* read configuration failed */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read configuration failed.\n");      /* read configuration failed */
+        a_opt300x_unlock(handle);                                                  /* unlock */
         
-        return 1;                                                              /* return error */
+        return 1;                                                                  /* return error */
     }
-    prev &= ~(1 << 3);                                                         /* clear settings */
-    prev |= polarity << 3;                                                     /* set polarity */
-    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);        /* write configuration */
-    if (res != 0)                                                              /* check the result */
+    if ((prev & (1 << 4)) == 0)                                                    /* check the latched mode */
     {
-        handle->debug_print("opt300x: write configuration failed.\n");         /* write configuration failed */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: interrupt latch is disabled.\n");    /* interrupt latch is disabled */
+        a_opt300x_unlock(handle);                                                  /* unlock */
         
-        return 1;                                                              /* return error */
+        return 6;                                                                  /* return error */
     }
+    memset(&handle->storm_stat, 0, sizeof(opt300x_storm_statistics_t));            /* clear statistics */
+    handle->storm_rate = rate;                                                     /* set rate */
+    handle->storm_calm = calm;                                                     /* set calm */
+    handle->storm_quiet = 0;                                                       /* clear quiet polls */
+    handle->storm_window_irq = 0;                                                  /* clear window irq */
+    handle->storm_window_start = handle->timestamp_us();                           /* set window start */
+    handle->storm_enable = 1;                                                      /* enable */
+    a_opt300x_unlock(handle);                                                      /* unlock */
     
-    return 0;                                                                  /* success return 0 */
+    return 0;                                                                      /* success return 0 */
 }
 
 /**
- * @brief      get interrupt pin polarity
- * @param[in]  *handle pointer to an opt300x handle structure
- * @param[out] *polarity pointer to an interrupt polarity buffer
- * @return     status code
- *             - 0 success
- *             - 1 get interrupt pin latch failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     stop the interrupt storm control
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the interrupt mode is restored at once
  */
-uint8_t opt300x_get_interrupt_pin_polarity(opt300x_handle_t *handle, opt300x_interrupt_polarity_t *polarity)
+uint8_t opt300x_stop_storm_control(opt300x_handle_t *handle)
 {
-    uint8_t res;
-    uint16_t prev;
-    
-    if (handle == NULL)                                                        /* check handle */
+    if (handle == NULL)                                /* check handle */
     {
-        return 2;                                                              /* return error */
+        return 2;                                      /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    if (handle->inited != 1)                           /* check handle initialization */
     {
-        return 3;                                                              /* return error */
+        return 3;                                      /* return error */
     }
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
-    if (res != 0)                                                              /* check the result */
-    {
-        handle->debug_print("opt300x: read configuration failed.\n");          /* read configuration failed */
-        
-        return 1;                                                              /* return error */
-    }
-    *polarity = (opt300x_interrupt_polarity_t)((prev >> 3) & 0x01);            /* set polarity */
+    a_opt300x_lock(handle);                            /* lock */
+    handle->storm_enable = 0;                          /* disable */
+    handle->storm_stat.masked = 0;                     /* interrupt mode */
+    a_opt300x_unlock(handle);                          /* unlock */
     
-    return 0;                                                                  /* success return 0 */
+    return 0;                                          /* success return 0 */
 }
 
 /**
- * @brief     enable or disable mask exponent
+ * @brief     run one timed poll of the interrupt storm control
  * @param[in] *handle pointer to an opt300x handle structure
- * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set mask exponent failed
+ *            - 1 run failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      nothing is done in the interrupt mode, in the polling mode it runs the irq handling once
+ *            and counts quiet polls without any flag
  */
-uint8_t opt300x_set_mask_exponent(opt300x_handle_t *handle, opt300x_bool_t enable)
+uint8_t opt300x_storm_poll(opt300x_handle_t *handle)
 {
-    uint8_t res;
+    uint8_t masked;
     uint16_t prev;
+    uint64_t timestamp;
     
-    if (handle == NULL)                                                        /* check handle */
+    if (handle == NULL)                                                          /* check handle */
     {
-        return 2;                                                              /* return error */
+        return 2;                                                                /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    if (handle->inited != 1)                                                     /* check handle initialization */
     {
-        return 3;                                                              /* return error */
+        return 3;                                                                /* return error */
     }
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
-    if (res != 0)                                                              /* check the result */
+    a_opt300x_lock(handle);                                                      /* lock */
+    masked = (handle->storm_enable != 0) ? handle->storm_stat.masked : 0;        /* get the mode */
+    a_opt300x_unlock(handle);                                                    /* unlock */
+    if (masked == 0)                                                             /* interrupt mode */
     {
-        handle->debug_print("opt300x: read configuration failed.\n");          /* read configuration failed */
-        
-        return 1;                                                              /* return error */
+        return 0;                                                                /* nothing to do */
     }
-    prev &= ~(1 << 2);                                                         /* clear settings */
-    prev |= enable << 2;                                                       /* set bool */
-    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);        /* write configuration */
-    if (res != 0)                                                              /* check the result */
+    
+    timestamp = handle->timestamp_us();                                          /* get timestamp */
+    if (a_opt300x_irq_process(handle, timestamp, &prev) != 0)                    /* handle the latched irq */
     {
-        handle->debug_print("opt300x: write configuration failed.\n");         /* write configuration failed */
-        
-        return 1;                                                              /* return error */
+        return 1;                                                                /* return error */
+    }
+    a_opt300x_lock(handle);                                                      /* lock */
+    handle->storm_stat.poll_count++;                                             /* poll++ */
+    if ((prev & (3 << 5)) != 0)                                                  /* still active */
+    {
+        handle->storm_quiet = 0;                                                 /* clear quiet polls */
+    }
+    else
+    {
+        handle->storm_quiet++;                                                   /* quiet++ */
+    }
+    if (handle->storm_quiet >= handle->storm_calm)                               /* calm */
+    {
+        handle->storm_stat.masked = 0;                                           /* back to interrupt mode */
+        handle->storm_stat.exit_count++;                                         /* exit++ */
+        handle->storm_window_start = timestamp;                                  /* set window start */
+        handle->storm_window_irq = 0;                                            /* clear window irq */
     }
+    a_opt300x_unlock(handle);                                                    /* unlock */
     
-    return 0;                                                                  /* success return 0 */
+    return 0;                                                                    /* success return 0 */
 }
 
 /**
- * @brief      get mask exponent status
+ * @brief      get the interrupt storm statistics
  * @param[in]  *handle pointer to an opt300x handle structure
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *stat pointer to a statistics structure
  * @return     status code
  *             - 0 success
- *             - 1 get mask exponent failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note       the statistics are cleared by opt300x_start_storm_control
  */
-uint8_t opt300x_get_mask_exponent(opt300x_handle_t *handle, opt300x_bool_t *enable)
+uint8_t opt300x_get_storm_statistics(opt300x_handle_t *handle, opt300x_storm_statistics_t *stat)
 {
-    uint8_t res;
-    uint16_t prev;
-    
-    if (handle == NULL)                                                        /* check handle */
+    if (handle == NULL)                                                           /* check handle */
     {
-        return 2;                                                              /* return error */
+        return 2;                                                                 /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    if (handle->inited != 1)                                                      /* check handle initialization */
     {
-        return 3;                                                              /* return error */
+        return 3;                                                                 /* return error */
     }
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
-    if (res != 0)                                                              /* check the result */
-    {
-        handle->debug_print("opt300x: read configuration failed.\n");          /* read configuration failed */
-        
-        return 1;                                                              /* return error */
-    }
-    *enable = (opt300x_bool_t)((prev >> 2) & 0x01);                            /* set bool */
+    a_opt300x_lock(handle);                                                       /* lock */
+    memcpy(stat, &handle->storm_stat, sizeof(opt300x_storm_statistics_t));        /* copy statistics */
+    a_opt300x_unlock(handle);                                                     /* unlock */
     
-    return 0;                                                                  /* success return 0 */
+    return 0;                                                                     /* success return 0 */
 }
 
 /**
- * @brief     set fault count
- * @param[in] *handle pointer to an opt300x handle structure
- * @param[in] count fault count
+ * @brief     shared interrupt line irq handler
+ * @param[in] **handle pointer to an opt300x handle array on the same bus and interrupt line
+ * @param[in] num handle number
  * @return    status code
  *            - 0 success
- *            - 1 set fault count failed
+ *            - 1 run failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 no device responds
+ *            - 5 responder is unknown
+ * @note      the smbus alert response address is read once per asserted device, the lowest address wins
+ *            the arbitration and releases the line, then only the responder's irq handling runs,
+ *            the first handle must link iic_read_cmd, all handles must use the latched mode
  */
-uint8_t opt300x_set_fault_count(opt300x_handle_t *handle, opt300x_fault_count_t count)
+uint8_t opt300x_alert_irq_handler(opt300x_handle_t **handle, uint8_t num)
 {
+    uint8_t i;
+    uint8_t j;
     uint8_t res;
+    uint8_t addr;
     uint16_t prev;
+    uint64_t timestamp;
     
-    if (handle == NULL)                                                        /* check handle */
+    if ((handle == NULL) || (num == 0))                                                           /* check handle */
     {
-        return 2;                                                              /* return error */
+        return 2;                                                                                 /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    for (i = 0; i < num; i++)                                                                     /* check all handles */
     {
-        return 3;                                                              /* return error */
+        if (handle[i] == NULL)                                                                    /* check handle */
+        {
+            return 2;                                                                             /* return error */
+        }
+        if (handle[i]->inited != 1)                                                               /* check handle initialization */
+        {
+            return 3;                                                                             /* return error */
+        }
     }
-    
-    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
-    if (res != 0)                                                              /* check the result */
+    if (handle[0]->iic_read_cmd == NULL)                                                          /* check iic_read_cmd */
     {
-        handle->debug_print("opt300x: read configuration failed.\n");          /* read configuration failed */
+        OPT300X_DEBUG_ERROR(handle[0], "opt300x: iic_read_cmd is null.\n");                       /* iic_read_cmd is null */
         
-        return 1;                                                              /* return error */
+        return 1;                                                                                 /* return error */
     }
-    prev &= ~(3 << 0);                                                         /* clear settings */
-    prev |= count << 0;                                                        /* set count */
-    res = a_opt300x_iic_write(handle, OPT300X_REG_CONFIGURATION, prev);        /* write configuration */
-    if (res != 0)                                                              /* check the result */
+    
+    timestamp = (handle[0]->timestamp_us != NULL) ? handle[0]->timestamp_us() : 0;                /* stamp the edge first */
+    for (i = 0; i < num; i++)                                                                     /* one responder per loop */
+    {
+        a_opt300x_lock(handle[0]);                                                                /* lock */
+        res = handle[0]->iic_read_cmd(OPT300X_ALERT_RESPONSE_ADDRESS, &addr, 1);                  /* read alert response */
+        a_opt300x_unlock(handle[0]);                                                              /* unlock */
+        if (res != 0)                                                                             /* no more responder */
+        {
+            break;                                                                                /* break */
+        }
+        for (j = 0; j < num; j++)                                                                 /* find the responder */
+        {
+            if (handle[j]->iic_addr == (addr & 0xFE))                                             /* check address */
+            {
+                break;                                                                            /* break */
+            }
+        }
+        if (j == num)                                                                             /* not found */
+        {
+            OPT300X_DEBUG_ERROR(handle[0], "opt300x: responder 0x%02X is unknown.\n", addr);      /* responder is unknown */
+            
+            return 5;                                                                             /* return error */
+        }
+        if (a_opt300x_irq_process(handle[j], timestamp, &prev) != 0)                              /* handle the irq */
+        {
+            return 1;                                                                             /* return error */
+        }
+    }
+    if (i == 0)                                                                                   /* check responder */
     {
-        handle->debug_print("opt300x: write configuration failed.\n");         /* write configuration failed */
+        OPT300X_DEBUG_ERROR(handle[0], "opt300x: no device responds.\n");                         /* no device responds */
         
-        return 1;                                                              /* return error */
+        return 4;                                                                                 /* return error */
     }
     
-    return 0;                                                                  /* success return 0 */
+    return 0;                                                                                     /* success return 0 */
 }
 
 /**
- * @brief      get fault count
- * @param[in]  *handle pointer to an opt300x handle structure
- * @param[out] *count pointer to a fault count buffer
+ * @brief      reset all devices on the bus and restore every handle
+ * @param[in]  **handle pointer to an opt300x handle array on the same bus
+ * @param[in]  num handle number
+ * @param[out] *us pointer to a recovery time buffer in us
  * @return     status code
  *             - 0 success
- *             - 1 get fault count failed
+ *             - 1 general call reset failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ *             - 4 restore failed
+ * @note       the general call reset is broadcast once by the first handle, which must link iic_write_cmd,
+ *             then the cached limits and configuration of each handle are written back in one pass,
+ *             the recovery time is 0 if timestamp_us is not linked
  */
-uint8_t opt300x_get_fault_count(opt300x_handle_t *handle, opt300x_fault_count_t *count)
+uint8_t opt300x_general_call_reset(opt300x_handle_t **handle, uint8_t num, uint32_t *us)
 {
+    uint8_t i;
     uint8_t res;
-    uint16_t prev;
+    uint8_t failed;
+    uint8_t cmd;
+    uint64_t start;
     
-    if (handle == NULL)                                                        /* check handle */
+    if ((handle == NULL) || (num == 0))                                                                  /* check handle */
     {
-        return 2;                                                              /* return error */
+        return 2;                                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    for (i = 0; i < num; i++)                                                                            /* check all handles */
     {
-        return 3;                                                              /* return error */
+        if (handle[i] == NULL)                                                                           /* check handle */
+        {
+            return 2;                                                                                    /* return error */
+        }
+        if (handle[i]->inited != 1)                                                                      /* check handle initialization */
+        {
+            return 3;                                                                                    /* return error */
+        }
+    }
+    if (handle[0]->iic_write_cmd == NULL)                                                                /* check iic_write_cmd */
+    {
+        OPT300X_DEBUG_ERROR(handle[0], "opt300x: iic_write_cmd is null.\n");                             /* iic_write_cmd is null */
+        
+        return 1;                                                                                        /* return error */
     }
     
-    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
-    if (res != 0)                                                              /* check the result */
+    start = (handle[0]->timestamp_us != NULL) ? handle[0]->timestamp_us() : 0;                           /* get start time */
+    cmd = OPT300X_GENERAL_CALL_RESET;                                                                    /* set reset command */
+    a_opt300x_lock(handle[0]);                                                                           /* lock */
+    res = handle[0]->iic_write_cmd(OPT300X_GENERAL_CALL_ADDRESS, &cmd, 1);                               /* broadcast reset */
+    a_opt300x_unlock(handle[0]);                                                                         /* unlock */
+    if (res != 0)                                                                                        /* check the result */
     {
-        handle->debug_print("opt300x: read configuration failed.\n");          /* read configuration failed */
+        OPT300X_DEBUG_ERROR(handle[0], "opt300x: general call reset failed.\n");                         /* general call reset failed */
         
-        return 1;                                                              /* return error */
+        return 1;                                                                                        /* return error */
+    }
+    handle[0]->delay_ms(1);                                                                              /* wait for the reset */
+    failed = 0;                                                                                          /* init 0 */
+    for (i = 0; i < num; i++)                                                                            /* restore all handles */
+    {
+        a_opt300x_lock(handle[i]);                                                                       /* lock */
+        res = a_opt300x_restore(handle[i]);                                                              /* restore */
+        a_opt300x_unlock(handle[i]);                                                                     /* unlock */
+        if (res != 0)                                                                                    /* check the result */
+        {
+            OPT300X_DEBUG_ERROR(handle[i], "opt300x: restore 0x%02X failed.\n", handle[i]->iic_addr);    /* restore failed */
+            failed = 1;                                                                                  /* keep going */
+        }
+    }
+    *us = (handle[0]->timestamp_us != NULL) ? (uint32_t)(handle[0]->timestamp_us() - start) : 0;         /* get recovery time */
+    if (failed != 0)                                                                                     /* check failed */
+    {
+        return 4;                                                                                        /* return error */
     }
-    *count = (opt300x_fault_count_t)((prev >> 0) & 0x03);                      /* set count */
     
-    return 0;                                                                  /* success return 0 */
+    return 0;                                                                                            /* success return 0 */
 }
 
 /**
- * @brief     irq handler
+ * @brief      get the detected chip reset counter
+ * @param[in]  *handle pointer to an opt300x handle structure
+ * @param[out] *count pointer to a counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       a reset is detected when a configuration read by continuous_read or the irq handling
+ *             doesn't match the last applied one, then the limits and the configuration are restored
+ */
+uint8_t opt300x_get_reset_count(opt300x_handle_t *handle, uint32_t *count)
+{
+    if (handle == NULL)                          /* check handle */
+    {
+        return 2;                                /* return error */
+    }
+    if (handle->inited != 1)                     /* check handle initialization */
+    {
+        return 3;                                /* return error */
+    }
+    
+    *count = handle->reset_count;                /* get counter */
+    
+    return 0;                                    /* success return 0 */
+}
+
+/**
+ * @brief     start the stuck sensor and stale data watchdog
  * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] stale max reads without the conversion ready flag, 0 means disable
+ * @param[in] stuck max new conversions with an identical raw code, 0 means disable
+ * @param[in] latency max read latency in us, 0 means disable
  * @return    status code
  *            - 0 success
- *            - 1 run failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 timestamp_us is NULL
+ * @note      it runs on the reads done by continuous_read and the irq handling with no extra bus access,
+ *            the latency check needs the timestamp_us
  */
-uint8_t opt300x_irq_handler(opt300x_handle_t *handle)
+uint8_t opt300x_start_watchdog(opt300x_handle_t *handle, uint32_t stale, uint32_t stuck, uint32_t latency)
 {
-    uint8_t res;
-    uint16_t prev;
-    
-    if (handle == NULL)                                                        /* check handle */
+    if (handle == NULL)                                                          /* check handle */
     {
-        return 2;                                                              /* return error */
+        return 2;                                                                /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    if (handle->inited != 1)                                                     /* check handle initialization */
     {
-        return 3;                                                              /* return error */
+        return 3;                                                                /* return error */
     }
-    
-    res = a_opt300x_iic_read(handle, OPT300X_REG_CONFIGURATION, &prev);        /* read configuration */
-    if (res != 0)                                                              /* check the result */
+    if ((latency != 0) && (handle->timestamp_us == NULL))                        /* check timestamp_us */
     {
-        handle->debug_print("opt300x: read configuration failed.\n");          /* read configuration failed */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: timestamp_us is null.\n");         /* timestamp_us is null */
         
-        return 1;                                                              /* return error */
+        return 4;                                                                /* return error */
+    }
+    
+    a_opt300x_lock(handle);                                                      /* lock */
+    handle->wd_stale_limit = stale;                                              /* set stale limit */
+    handle->wd_stuck_limit = stuck;                                              /* set stuck limit */
+    handle->wd_latency_limit = latency;                                          /* set latency limit */
+    handle->wd_stale = 0;                                                        /* clear stale */
+    handle->wd_stuck = 0;                                                        /* clear stuck */
+    handle->wd_latency_max = 0;                                                  /* clear latency */
+    handle->wd_last_raw = 0xFFFF;                                                /* no last code */
+    handle->wd_health = OPT300X_HEALTH_OK;                                       /* healthy */
+    handle->wd_enable = 1;                                                       /* enable */
+    a_opt300x_unlock(handle);                                                    /* unlock */
+    
+    return 0;                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     stop the watchdog
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t opt300x_stop_watchdog(opt300x_handle_t *handle)
+{
+    if (handle == NULL)                                /* check handle */
+    {
+        return 2;                                      /* return error */
+    }
+    if (handle->inited != 1)                           /* check handle initialization */
+    {
+        return 3;                                      /* return error */
     }
     
-    if ((prev & (1 << 6)) != 0)                                                /* check flag */
+    a_opt300x_lock(handle);                            /* lock */
+    handle->wd_enable = 0;                             /* disable */
+    a_opt300x_unlock(handle);                          /* unlock */
+    
+    return 0;                                          /* success return 0 */
+}
+
+/**
+ * @brief      get the watchdog health
+ * @param[in]  *handle pointer to an opt300x handle structure
+ * @param[out] *health pointer to a health buffer
+ * @param[out] *latency_max pointer to a max read latency buffer in us
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t opt300x_get_health(opt300x_handle_t *handle, opt300x_health_t *health, uint32_t *latency_max)
+{
+    if (handle == NULL)                                                 /* check handle */
     {
-        if (handle->receive_callback != NULL)                                  /* if not null */
-        {
-            handle->receive_callback(OPT300X_INTERRUPT_HIGH_LIMIT);            /* run the callback */
-        }
+        return 2;                                                       /* return error */
     }
-    if ((prev & (1 << 5)) != 0)                                                /* check flag */
+    if (handle->inited != 1)                                            /* check handle initialization */
     {
-        if (handle->receive_callback != NULL)                                  /* if not null */
-        {
-            handle->receive_callback(OPT300X_INTERRUPT_LOW_LIMIT);             /* run the callback */
-        }
+        return 3;                                                       /* return error */
     }
     
-    return 0;                                                                  /* success return 0 */
+    *health = (opt300x_health_t)(handle->wd_health);                    /* get health */
+    *latency_max = handle->wd_latency_max;                              /* get max latency */
+    
+    return 0;                                                           /* success return 0 */
 }
 
 /**
@@ -1885,23 +3813,28 @@ uint8_t opt300x_irq_handler(opt300x_handle_t *handle)
  */
 uint8_t opt300x_set_reg(opt300x_handle_t *handle, uint8_t reg, uint16_t data)
 {
-    if (handle == NULL)                                         /* check handle */
+    uint8_t res;
+    
+    if (handle == NULL)                                                 /* check handle */
     {
-        return 2;                                               /* return error */
+        return 2;                                                       /* return error */
     }
-    if (handle->inited != 1)                                    /* check handle initialization */
+    if (handle->inited != 1)                                            /* check handle initialization */
     {
-        return 3;                                               /* return error */
+        return 3;                                                       /* return error */
     }
     
-    if (a_opt300x_iic_write(handle, reg, data) != 0)            /* write data */
+    a_opt300x_lock(handle);                                             /* lock */
+    res = a_opt300x_iic_write(handle, reg, data);                       /* write data */
+    a_opt300x_unlock(handle);                                           /* unlock */
+    if (res != 0)                                                       /* check the result */
     {
-        handle->debug_print("opt300x: write failed.\n");        /* write failed */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: write failed.\n");        /* write failed */
         
-        return 1;                                               /* return error */
+        return 1;                                                       /* return error */
     }
     
-    return 0;                                                   /* success return 0 */
+    return 0;                                                           /* success return 0 */
 }
 
 /**
@@ -1918,23 +3851,28 @@ uint8_t opt300x_set_reg(opt300x_handle_t *handle, uint8_t reg, uint16_t data)
  */
 uint8_t opt300x_get_reg(opt300x_handle_t *handle, uint8_t reg, uint16_t *data)
 {
-    if (handle == NULL)                                        /* check handle */
+    uint8_t res;
+    
+    if (handle == NULL)                                                /* check handle */
     {
-        return 2;                                              /* return error */
+        return 2;                                                      /* return error */
     }
-    if (handle->inited != 1)                                   /* check handle initialization */
+    if (handle->inited != 1)                                           /* check handle initialization */
     {
-        return 3;                                              /* return error */
+        return 3;                                                      /* return error */
     }
     
-    if (a_opt300x_iic_read(handle, reg, data) != 0)            /* read data */
+    a_opt300x_lock(handle);                                            /* lock */
+    res = a_opt300x_iic_read(handle, reg, data);                       /* read data */
+    a_opt300x_unlock(handle);                                          /* unlock */
+    if (res != 0)                                                      /* check the result */
     {
-        handle->debug_print("opt300x: read failed.\n");        /* read failed */
+        OPT300X_DEBUG_ERROR(handle, "opt300x: read failed.\n");        /* read failed */
         
-        return 1;                                              /* return error */
+        return 1;                                                      /* return error */
     }
     
-    return 0;                                                  /* success return 0 */
+    return 0;                                                          /* success return 0 */
 }
 
 /**
@@ -56,6 +56,43 @@ extern "C"{
  * @{
  */
 
+/**
+ * @brief opt300x debug level definition
+ */
+#define OPT300X_DEBUG_LEVEL_OFF          0        /**< compile out every message */
+#define OPT300X_DEBUG_LEVEL_ERROR        1        /**< failed calls */
+#define OPT300X_DEBUG_LEVEL_INFO         2        /**< failed calls and run-time events */
+
+/**
+ * @brief opt300x debug level
+ * @note  the messages above this level are compiled out at their call sites
+ */
+#ifndef OPT300X_DEBUG_LEVEL
+    #define OPT300X_DEBUG_LEVEL OPT300X_DEBUG_LEVEL_INFO        /**< info level */
+#endif
+
+/**
+ * @brief     print a failed call message
+ * @param[in] HANDLE pointer to an opt300x handle structure
+ * @note      compiled out below OPT300X_DEBUG_LEVEL_ERROR
+ */
+#if (OPT300X_DEBUG_LEVEL >= OPT300X_DEBUG_LEVEL_ERROR)
+    #define OPT300X_DEBUG_ERROR(HANDLE, ...)        (HANDLE)->debug_print(__VA_ARGS__)
+#else
+    #define OPT300X_DEBUG_ERROR(HANDLE, ...)        (void)(HANDLE)
+#endif
+
+/**
+ * @brief     print a run-time event message
+ * @param[in] HANDLE pointer to an opt300x handle structure
+ * @note      compiled out below OPT300X_DEBUG_LEVEL_INFO
+ */
+#if (OPT300X_DEBUG_LEVEL >= OPT300X_DEBUG_LEVEL_INFO)
+    #define OPT300X_DEBUG_INFO(HANDLE, ...)         (HANDLE)->debug_print(__VA_ARGS__)
+#else
+    #define OPT300X_DEBUG_INFO(HANDLE, ...)         (void)(HANDLE)
+#endif
+
 /**
  * @brief opt300x type enumeration definition
  */
@@ -187,6 +224,66 @@ typedef enum
     OPT300X_INTERRUPT_LOW_LIMIT  = 0x01,        /**< low limit */
 } opt300x_interrupt_t;
 
+/**
+ * @brief opt300x deadband policy enumeration definition
+ */
+typedef enum
+{
+    OPT300X_DEADBAND_POLICY_ABSOLUTE = 0x00,        /**< window is reading -/+ width in lux or nW/cm2 */
+    OPT300X_DEADBAND_POLICY_PERCENT  = 0x01,        /**< window is reading -/+ width percent of the reading */
+    OPT300X_DEADBAND_POLICY_LOG      = 0x02,        /**< window is reading divided and multiplied by 2^width, width in stops */
+} opt300x_deadband_policy_t;
+
+/**
+ * @brief opt300x health enumeration definition
+ */
+typedef enum
+{
+    OPT300X_HEALTH_OK    = 0x00,        /**< sensor is healthy */
+    OPT300X_HEALTH_STALE = 0x01,        /**< no new conversion for too many reads */
+    OPT300X_HEALTH_STUCK = 0x02,        /**< identical raw codes for too many conversions */
+    OPT300X_HEALTH_SLOW  = 0x03,        /**< read latency is too long */
+} opt300x_health_t;
+
+/**
+ * @brief opt300x event structure definition
+ */
+typedef struct opt300x_event_s
+{
+    uint64_t timestamp_us;        /**< edge timestamp in us */
+    uint16_t raw;                 /**< raw result */
+    float data;                   /**< converted lux or nW/cm2 */
+    uint16_t config;              /**< configuration register */
+    uint8_t high_flag;            /**< flag high */
+    uint8_t low_flag;             /**< flag low */
+    uint8_t ready_flag;           /**< conversion ready flag */
+    uint8_t overflow_flag;        /**< overflow flag */
+} opt300x_event_t;
+
+/**
+ * @brief opt300x scan structure definition
+ */
+typedef struct opt300x_scan_s
+{
+    opt300x_address_t addr_pin;        /**< probed address pin */
+    uint8_t found;                     /**< 1 if an opt300x answers */
+    uint16_t manufacturer_id;          /**< manufacturer id */
+    uint16_t device_id;                /**< device id */
+} opt300x_scan_t;
+
+/**
+ * @brief opt300x storm statistics structure definition
+ */
+typedef struct opt300x_storm_statistics_s
+{
+    uint32_t irq_count;          /**< irq handler calls */
+    uint32_t irq_masked;         /**< irq handler calls skipped while masked */
+    uint32_t poll_count;         /**< polls run while masked */
+    uint32_t enter_count;        /**< switches to the polling mode */
+    uint32_t exit_count;         /**< switches back to the interrupt mode */
+    uint8_t masked;              /**< 1 while in the polling mode */
+} opt300x_storm_statistics_t;
+
 /**
  * @brief opt300x handle structure definition
  */
@@ -197,11 +294,51 @@ typedef struct opt300x_handle_s
     uint8_t (*iic_deinit)(void);                                                        /**< point to an iic_deinit function address */
     uint8_t (*iic_read)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);         /**< point to an iic_read function address */
     uint8_t (*iic_write)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);        /**< point to an iic_write function address */
+    uint8_t (*iic_read_cmd)(uint8_t addr, uint8_t *buf, uint16_t len);                  /**< point to an iic_read_cmd function address */
+    uint8_t (*iic_write_cmd)(uint8_t addr, uint8_t *buf, uint16_t len);                 /**< point to an iic_write_cmd function address */
     void (*receive_callback)(uint8_t type);                                             /**< point to a receive_callback function address */
+    void (*sample_callback)(uint16_t raw, float data);                                  /**< point to a sample_callback function address */
+    void (*event_callback)(opt300x_event_t *event);                                     /**< point to an event_callback function address */
+    void (*health_callback)(uint8_t health);                                            /**< point to a health_callback function address */
     void (*delay_ms)(uint32_t ms);                                                      /**< point to a delay_ms function address */
     void (*debug_print)(const char *const fmt, ...);                                    /**< point to a debug_print function address */
+    uint8_t (*mutex_init)(void **mutex);                                                /**< point to a mutex_init function address */
+    void (*mutex_deinit)(void *mutex);                                                  /**< point to a mutex_deinit function address */
+    void (*mutex_lock)(void *mutex);                                                    /**< point to a mutex_lock function address */
+    void (*mutex_unlock)(void *mutex);                                                  /**< point to a mutex_unlock function address */
+    void *mutex;                                                                        /**< per handle mutex context */
+    uint64_t (*timestamp_us)(void);                                                     /**< point to a timestamp_us function address */
     uint8_t type;                                                                       /**< chip type */
     uint8_t inited;                                                                     /**< inited flag */
+    uint8_t irq_mode;                                                                   /**< irq mode */
+    uint8_t limit_valid;                                                                /**< limit cache valid flag */
+    uint16_t low_limit;                                                                 /**< low limit cache */
+    uint16_t high_limit;                                                                /**< high limit cache */
+    uint8_t config_valid;                                                               /**< configuration cache valid flag */
+    uint16_t config;                                                                    /**< last applied configuration */
+    uint32_t reset_count;                                                               /**< detected chip reset counter */
+    uint8_t wd_enable;                                                                  /**< watchdog enable */
+    uint8_t wd_health;                                                                  /**< current health */
+    uint16_t wd_last_raw;                                                               /**< last new raw code */
+    uint32_t wd_stale_limit;                                                            /**< max reads without a new conversion */
+    uint32_t wd_stuck_limit;                                                            /**< max identical new conversions */
+    uint32_t wd_latency_limit;                                                          /**< max read latency in us */
+    uint32_t wd_stale;                                                                  /**< current reads without a new conversion */
+    uint32_t wd_stuck;                                                                  /**< current identical new conversions */
+    uint32_t wd_latency_max;                                                            /**< max seen read latency in us */
+    uint8_t deadband_policy;                                                            /**< deadband window policy */
+    uint32_t deadband_width;                                                            /**< deadband window width in internal units */
+    uint32_t deadband_rearm;                                                            /**< deadband re-arm counter */
+    uint16_t eoc_low_limit;                                                             /**< low limit saved by the eoc stream */
+    uint32_t eoc_sample;                                                                /**< eoc stream sample counter */
+    uint32_t eoc_spurious;                                                              /**< eoc stream edges without a new sample */
+    uint8_t storm_enable;                                                               /**< storm control enable */
+    uint32_t storm_rate;                                                                /**< max irq rate in Hz */
+    uint32_t storm_calm;                                                                /**< quiet polls before unmasking */
+    uint32_t storm_quiet;                                                               /**< current quiet polls */
+    uint32_t storm_window_irq;                                                          /**< irq in the current window */
+    uint64_t storm_window_start;                                                        /**< current window start in us */
+    opt300x_storm_statistics_t storm_stat;                                              /**< storm statistics */
 } opt300x_handle_t;
 
 /**
@@ -271,6 +408,22 @@ typedef struct opt300x_info_s
  */
 #define DRIVER_OPT300X_LINK_IIC_WRITE(HANDLE, FUC)          (HANDLE)->iic_write = FUC
 
+/**
+ * @brief     link iic_read_cmd function
+ * @param[in] HANDLE pointer to an opt300x handle structure
+ * @param[in] FUC pointer to an iic_read_cmd function address
+ * @note      optional, only used by the bus level functions
+ */
+#define DRIVER_OPT300X_LINK_IIC_READ_COMMAND(HANDLE, FUC)   (HANDLE)->iic_read_cmd = FUC
+
+/**
+ * @brief     link iic_write_cmd function
+ * @param[in] HANDLE pointer to an opt300x handle structure
+ * @param[in] FUC pointer to an iic_write_cmd function address
+ * @note      optional, only used by the bus level functions
+ */
+#define DRIVER_OPT300X_LINK_IIC_WRITE_COMMAND(HANDLE, FUC)  (HANDLE)->iic_write_cmd = FUC
+
 /**
  * @brief     link delay_ms function
  * @param[in] HANDLE pointer to an opt300x handle structure
@@ -287,6 +440,46 @@ typedef struct opt300x_info_s
  */
 #define DRIVER_OPT300X_LINK_DEBUG_PRINT(HANDLE, FUC)        (HANDLE)->debug_print = FUC
 
+/**
+ * @brief     link mutex_init function
+ * @param[in] HANDLE pointer to an opt300x handle structure
+ * @param[in] FUC pointer to a mutex_init function address
+ * @note      optional, creates the mutex context of one handle in opt300x_init and opt300x_scan
+ */
+#define DRIVER_OPT300X_LINK_MUTEX_INIT(HANDLE, FUC)         (HANDLE)->mutex_init = FUC
+
+/**
+ * @brief     link mutex_deinit function
+ * @param[in] HANDLE pointer to an opt300x handle structure
+ * @param[in] FUC pointer to a mutex_deinit function address
+ * @note      optional, releases the mutex context in opt300x_deinit
+ */
+#define DRIVER_OPT300X_LINK_MUTEX_DEINIT(HANDLE, FUC)       (HANDLE)->mutex_deinit = FUC
+
+/**
+ * @brief     link mutex_lock function
+ * @param[in] HANDLE pointer to an opt300x handle structure
+ * @param[in] FUC pointer to a mutex_lock function address
+ * @note      optional, used around every read-modify-write of the chip with the handle's mutex context
+ */
+#define DRIVER_OPT300X_LINK_MUTEX_LOCK(HANDLE, FUC)         (HANDLE)->mutex_lock = FUC
+
+/**
+ * @brief     link mutex_unlock function
+ * @param[in] HANDLE pointer to an opt300x handle structure
+ * @param[in] FUC pointer to a mutex_unlock function address
+ * @note      optional, used around every read-modify-write of the chip with the handle's mutex context
+ */
+#define DRIVER_OPT300X_LINK_MUTEX_UNLOCK(HANDLE, FUC)       (HANDLE)->mutex_unlock = FUC
+
+/**
+ * @brief     link timestamp_us function
+ * @param[in] HANDLE pointer to an opt300x handle structure
+ * @param[in] FUC pointer to a timestamp_us function address
+ * @note      optional, a monotonic clock in us, events are stamped with 0 if it is not linked
+ */
+#define DRIVER_OPT300X_LINK_TIMESTAMP_US(HANDLE, FUC)       (HANDLE)->timestamp_us = FUC
+
 /**
  * @brief     link receive_callback function
  * @param[in] HANDLE pointer to an opt300x handle structure
@@ -295,6 +488,30 @@ typedef struct opt300x_info_s
  */
 #define DRIVER_OPT300X_LINK_RECEIVE_CALLBACK(HANDLE, FUC)   (HANDLE)->receive_callback = FUC
 
+/**
+ * @brief     link sample_callback function
+ * @param[in] HANDLE pointer to an opt300x handle structure
+ * @param[in] FUC pointer to a sample_callback function address
+ * @note      optional, gets the raw code and the converted lux or nW/cm2 of every reported sample
+ */
+#define DRIVER_OPT300X_LINK_SAMPLE_CALLBACK(HANDLE, FUC)    (HANDLE)->sample_callback = FUC
+
+/**
+ * @brief     link event_callback function
+ * @param[in] HANDLE pointer to an opt300x handle structure
+ * @param[in] FUC pointer to an event_callback function address
+ * @note      optional, gets the triggering sample, all flags and the edge timestamp of every irq
+ */
+#define DRIVER_OPT300X_LINK_EVENT_CALLBACK(HANDLE, FUC)     (HANDLE)->event_callback = FUC
+
+/**
+ * @brief     link health_callback function
+ * @param[in] HANDLE pointer to an opt300x handle structure
+ * @param[in] FUC pointer to a health_callback function address
+ * @note      optional, gets the new health of every watchdog state change
+ */
+#define DRIVER_OPT300X_LINK_HEALTH_CALLBACK(HANDLE, FUC)    (HANDLE)->health_callback = FUC
+
 /**
  * @}
  */
@@ -368,7 +585,8 @@ uint8_t opt300x_get_addr_pin(opt300x_handle_t *handle, opt300x_address_t *addr_p
  *            - 1 run failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the configuration register is read once, the result register is read once more only if
+ *            a mode or the event_callback needs the sample
  */
 uint8_t opt300x_irq_handler(opt300x_handle_t *handle);
 
@@ -381,10 +599,28 @@ uint8_t opt300x_irq_handler(opt300x_handle_t *handle);
  *            - 2 handle is NULL
  *            - 3 linked functions is NULL
  *            - 4 id is invalid
+ *            - 5 mutex init failed
  * @note      none
  */
 uint8_t opt300x_init(opt300x_handle_t *handle);
 
+/**
+ * @brief      scan all four addresses of the bus
+ * @param[in]  *handle pointer to an opt300x template handle structure with the linked functions and the chip type
+ * @param[out] *scan pointer to an opt300x scan array with 4 entries
+ * @param[out] *ready pointer to an opt300x handle array with 4 entries, NULL means report only
+ * @param[out] *num pointer to a found device number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 iic initialization failed
+ *             - 2 handle is NULL
+ *             - 3 linked functions is NULL
+ * @note       an empty address costs one failed read, found devices get the template links and address
+ *             with a clean runtime state and their own mutex context, initialized and stored in ready[0, num), so each one needs
+ *             opt300x_deinit later, the chip type can't be detected because all the chips report the same device id
+ */
+uint8_t opt300x_scan(opt300x_handle_t *handle, opt300x_scan_t *scan, opt300x_handle_t *ready, uint8_t *num);
+
 /**
  * @brief     close the chip
  * @param[in] *handle pointer to an opt300x handle structure
@@ -434,7 +670,9 @@ uint8_t opt300x_stop_continuous_read(opt300x_handle_t *handle);
  *             - 3 handle is not initialized
  *             - 4 data is overflow
  *             - 5 opt3002 can't use this function
- * @note       none
+ * @note       the chip is read without the lock, the lock is only held to feed the watchdog
+ *             and to compare the cache and restore a reset chip, a restored chip is read again and counted by
+ *             opt300x_get_reset_count
  */
 uint8_t opt300x_continuous_read(opt300x_handle_t *handle, uint16_t *raw, float *lux);
 
@@ -450,7 +688,9 @@ uint8_t opt300x_continuous_read(opt300x_handle_t *handle, uint16_t *raw, float *
  *             - 3 handle is not initialized
  *             - 4 data is overflow
  *             - 5 only opt3002 can use this function
- * @note       none
+ * @note       the chip is read without the lock, the lock is only held to feed the watchdog
+ *             and to compare the cache and restore a reset chip, a restored chip is read again and counted by
+ *             opt300x_get_reset_count
  */
 uint8_t opt3002_continuous_read(opt300x_handle_t *handle, uint16_t *raw, float *nw_cm2);
 
@@ -540,6 +780,58 @@ uint8_t opt300x_set_high_limit(opt300x_handle_t *handle, uint16_t limit);
  */
 uint8_t opt300x_get_high_limit(opt300x_handle_t *handle, uint16_t *limit);
 
+/**
+ * @brief     set the low and high limits together
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] low low limit register code
+ * @param[in] high high limit register code
+ * @return    status code
+ *            - 0 success
+ *            - 1 set limits failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 low is greater than high
+ *            - 5 eoc stream or deadband is running
+ * @note      the widening write goes first and the narrowing write goes last,
+ *            so the transitional window always contains the new window and never raises a spurious flag,
+ *            the eoc stream and the deadband own the limits while they run
+ */
+uint8_t opt300x_set_limits(opt300x_handle_t *handle, uint16_t low, uint16_t high);
+
+/**
+ * @brief     set the low and high limits together in lux
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] low low limit in lux
+ * @param[in] high high limit in lux
+ * @return    status code
+ *            - 0 success
+ *            - 1 set limits failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 low is greater than high or a limit is invalid
+ *            - 5 opt3002 can't use this function
+ *            - 6 eoc stream or deadband is running
+ * @note      none
+ */
+uint8_t opt300x_set_limits_lux(opt300x_handle_t *handle, float low, float high);
+
+/**
+ * @brief     set the low and high limits together in nW/cm2
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] low low limit in nW/cm2
+ * @param[in] high high limit in nW/cm2
+ * @return    status code
+ *            - 0 success
+ *            - 1 set limits failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 low is greater than high or a limit is invalid
+ *            - 5 only opt3002 can use this function
+ *            - 6 eoc stream or deadband is running
+ * @note      none
+ */
+uint8_t opt3002_set_limits_nw_cm2(opt300x_handle_t *handle, float low, float high);
+
 /**
  * @brief      convert the limit threshold to the register raw data
  * @param[in]  *handle pointer to an opt300x handle structure
@@ -810,6 +1102,238 @@ uint8_t opt300x_set_fault_count(opt300x_handle_t *handle, opt300x_fault_count_t
  */
 uint8_t opt300x_get_fault_count(opt300x_handle_t *handle, opt300x_fault_count_t *count);
 
+/**
+ * @}
+ */
+
+/**
+ * @defgroup opt300x_advance_driver opt300x advance driver function
+ * @brief    opt300x advance driver modules
+ * @ingroup  opt300x_driver
+ * @{
+ */
+
+/**
+ * @brief     start the deadband mode
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] policy window width policy
+ * @param[in] width window width in lux or nW/cm2, in percent or in stops
+ * @return    status code
+ *            - 0 success
+ *            - 1 start deadband failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 width is invalid
+ *            - 5 chip is not in the continuous mode
+ * @note      call it after opt300x_start_continuous_read, the interrupt is switched to the latched window mode,
+ *            every irq re-centres the window around the new reading and reports it by the sample_callback
+ *            percent width range is (0, 100), log width range is (0, 8]
+ */
+uint8_t opt300x_start_deadband(opt300x_handle_t *handle, opt300x_deadband_policy_t policy, float width);
+
+/**
+ * @brief     stop the deadband mode
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the last programmed window is kept in the chip
+ */
+uint8_t opt300x_stop_deadband(opt300x_handle_t *handle);
+
+/**
+ * @brief      get the deadband re-arm counter
+ * @param[in]  *handle pointer to an opt300x handle structure
+ * @param[out] *count pointer to a counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the counter is cleared by opt300x_start_deadband
+ */
+uint8_t opt300x_get_deadband_rearm_count(opt300x_handle_t *handle, uint32_t *count);
+
+/**
+ * @brief     start the end of conversion stream mode
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start eoc stream failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the low limit is set to the end of conversion pattern and the chip runs continuously in the latched mode,
+ *            every irq with the conversion ready flag reports one sample by the sample_callback
+ */
+uint8_t opt300x_start_eoc_stream(opt300x_handle_t *handle);
+
+/**
+ * @brief     stop the end of conversion stream mode
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 stop eoc stream failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the low limit saved by opt300x_start_eoc_stream is restored, the conversion keeps running
+ */
+uint8_t opt300x_stop_eoc_stream(opt300x_handle_t *handle);
+
+/**
+ * @brief      get the end of conversion stream counters
+ * @param[in]  *handle pointer to an opt300x handle structure
+ * @param[out] *sample pointer to a delivered sample counter buffer
+ * @param[out] *spurious pointer to a spurious edge counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the counters are cleared by opt300x_start_eoc_stream
+ */
+uint8_t opt300x_get_eoc_stream_count(opt300x_handle_t *handle, uint32_t *sample, uint32_t *spurious);
+
+/**
+ * @brief     start the interrupt storm control
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] rate max irq rate in Hz
+ * @param[in] calm quiet polls before the interrupt mode is restored
+ * @return    status code
+ *            - 0 success
+ *            - 1 start storm control failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 timestamp_us is NULL
+ *            - 5 rate or calm is invalid
+ *            - 6 interrupt latch is disabled
+ * @note      above the rate the irq handler returns without any bus access, the latched interrupt stays asserted
+ *            and the application must call opt300x_storm_poll periodically until the activity calms,
+ *            so the latched mode must be set before by opt300x_set_interrupt_latch
+ */
+uint8_t opt300x_start_storm_control(opt300x_handle_t *handle, uint32_t rate, uint32_t calm);
+
+/**
+ * @brief     stop the interrupt storm control
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the interrupt mode is restored at once
+ */
+uint8_t opt300x_stop_storm_control(opt300x_handle_t *handle);
+
+/**
+ * @brief     run one timed poll of the interrupt storm control
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      nothing is done in the interrupt mode, in the polling mode it runs the irq handling once
+ *            and counts quiet polls without any flag
+ */
+uint8_t opt300x_storm_poll(opt300x_handle_t *handle);
+
+/**
+ * @brief      get the interrupt storm statistics
+ * @param[in]  *handle pointer to an opt300x handle structure
+ * @param[out] *stat pointer to a statistics structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the statistics are cleared by opt300x_start_storm_control
+ */
+uint8_t opt300x_get_storm_statistics(opt300x_handle_t *handle, opt300x_storm_statistics_t *stat);
+
+/**
+ * @brief     shared interrupt line irq handler
+ * @param[in] **handle pointer to an opt300x handle array on the same bus and interrupt line
+ * @param[in] num handle number
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 no device responds
+ *            - 5 responder is unknown
+ * @note      the smbus alert response address is read once per asserted device, the lowest address wins
+ *            the arbitration and releases the line, then only the responder's irq handling runs,
+ *            the first handle must link iic_read_cmd, all handles must use the latched mode
+ */
+uint8_t opt300x_alert_irq_handler(opt300x_handle_t **handle, uint8_t num);
+
+/**
+ * @brief      reset all devices on the bus and restore every handle
+ * @param[in]  **handle pointer to an opt300x handle array on the same bus
+ * @param[in]  num handle number
+ * @param[out] *us pointer to a recovery time buffer in us
+ * @return     status code
+ *             - 0 success
+ *             - 1 general call reset failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 restore failed
+ * @note       the general call reset is broadcast once by the first handle, which must link iic_write_cmd,
+ *             then the cached limits and configuration of each handle are written back in one pass,
+ *             the recovery time is 0 if timestamp_us is not linked
+ */
+uint8_t opt300x_general_call_reset(opt300x_handle_t **handle, uint8_t num, uint32_t *us);
+
+/**
+ * @brief      get the detected chip reset counter
+ * @param[in]  *handle pointer to an opt300x handle structure
+ * @param[out] *count pointer to a counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       a reset is detected when a configuration read by continuous_read or the irq handling
+ *             doesn't match the last applied one, then the limits and the configuration are restored
+ */
+uint8_t opt300x_get_reset_count(opt300x_handle_t *handle, uint32_t *count);
+
+/**
+ * @brief     start the stuck sensor and stale data watchdog
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @param[in] stale max reads without the conversion ready flag, 0 means disable
+ * @param[in] stuck max new conversions with an identical raw code, 0 means disable
+ * @param[in] latency max read latency in us, 0 means disable
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 timestamp_us is NULL
+ * @note      it runs on the reads done by continuous_read and the irq handling with no extra bus access,
+ *            the latency check needs the timestamp_us
+ */
+uint8_t opt300x_start_watchdog(opt300x_handle_t *handle, uint32_t stale, uint32_t stuck, uint32_t latency);
+
+/**
+ * @brief     stop the watchdog
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t opt300x_stop_watchdog(opt300x_handle_t *handle);
+
+/**
+ * @brief      get the watchdog health
+ * @param[in]  *handle pointer to an opt300x handle structure
+ * @param[out] *health pointer to a health buffer
+ * @param[out] *latency_max pointer to a max read latency buffer in us
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t opt300x_get_health(opt300x_handle_t *handle, opt300x_health_t *health, uint32_t *latency_max);
+
 /**
  * @}
  */
@@ -0,0 +1,639 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_calib.c
+ * @brief     driver opt300x calib source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_opt300x_calib.h"
+#include <math.h>
+
+/**
+ * @brief calib blob definition
+ */
+#define OPT300X_CALIB_MAGIC         0x4143334FU        /**< "O3CA" */
+#define OPT300X_CALIB_VERSION       1                  /**< blob version */
+
+/**
+ * @brief      get the curve segment of an input
+ * @param[in]  *calib pointer to a calib structure
+ * @param[in]  x curve input
+ * @param[out] *k pointer to a slope buffer
+ * @param[out] *c pointer to an intercept buffer
+ * @note       the first and the last segment are extended, no curve is the identity
+ */
+static void a_opt300x_calib_segment(opt300x_calib_t *calib, float x, float *k, float *c)
+{
+    uint8_t i;
+    
+    if (calib->point_num == 0)                                                             /* no curve */
+    {
+        *k = 1.0f;                                                                         /* identity */
+        *c = 0.0f;                                                                         /* identity */
+        
+        return;                                                                            /* return */
+    }
+    for (i = 1; i < calib->point_num - 1; i++)                                             /* find the segment */
+    {
+        if (x < calib->point_in[i])                                                        /* below the point */
+        {
+            break;                                                                         /* break */
+        }
+    }
+    *k = (calib->point_out[i] - calib->point_out[i - 1]) /
+         (calib->point_in[i] - calib->point_in[i - 1]);                                    /* segment slope */
+    *c = calib->point_out[i - 1] - *k * calib->point_in[i - 1];                            /* segment intercept */
+}
+
+/**
+ * @brief     build the segment table
+ * @param[in] *calib pointer to a calib structure
+ * @note      the inner curve points split the mantissa range 0 to 4095 of every exponent into segments,
+ *            a segment starts at the first mantissa at or after its point so every mantissa stays exact
+ */
+static void a_opt300x_calib_build(opt300x_calib_t *calib)
+{
+    uint8_t e;
+    uint8_t i;
+    uint8_t j;
+    uint8_t n;
+    uint16_t t;
+    uint16_t lo;
+    uint16_t hi;
+    uint16_t knee[OPT300X_CALIB_MAX_POINT];
+    float weight;
+    float a;
+    float m;
+    float k;
+    float c;
+    
+    if (calib->type == (uint8_t)OPT3002)                                                   /* opt3002 */
+    {
+        weight = 1.2f;                                                                     /* nW/cm2 */
+    }
+    else if (calib->type == (uint8_t)OPT3005)                                              /* opt3005 */
+    {
+        weight = 0.02f;                                                                    /* lux */
+    }
+    else                                                                                   /* the others */
+    {
+        weight = 0.01f;                                                                    /* lux */
+    }
+    for (e = 0; e < 16; e++)                                                               /* every exponent */
+    {
+        for (i = 0; i < OPT300X_CALIB_MAX_POINT - 1; i++)                                  /* every segment */
+        {
+            calib->scale[e][i] = NAN;                                                      /* no data */
+            calib->bias[e][i] = NAN;                                                       /* no data */
+            calib->knee[e][i] = 0xFFFF;                                                    /* last segment */
+        }
+    }
+    for (e = 0; e < 12; e++)                                                               /* every valid exponent */
+    {
+        a = weight * (float)(1U << e) * calib->gain;                                       /* linear scale */
+        n = 0;                                                                             /* no knees */
+        for (i = 1; (a != 0.0f) && (i + 1 < calib->point_num); i++)                        /* every inner point */
+        {
+            m = ceilf((calib->point_in[i] - calib->offset) / a);                           /* first mantissa at the point */
+            if ((m <= 0.0f) || (m > 4095.0f))                                              /* outside the exponent */
+            {
+                continue;                                                                  /* next point */
+            }
+            t = (uint16_t)m;                                                               /* knee */
+            for (j = 0; j < n; j++)                                                        /* every knee */
+            {
+                if (knee[j] == t)                                                          /* same knee */
+                {
+                    break;                                                                 /* break */
+                }
+            }
+            if (j != n)                                                                    /* already a knee */
+            {
+                continue;                                                                  /* next point */
+            }
+            for (j = n; (j > 0) && (knee[j - 1] > t); j--)                                 /* keep ascending */
+            {
+                knee[j] = knee[j - 1];                                                     /* shift */
+            }
+            knee[j] = t;                                                                   /* insert */
+            n++;                                                                           /* add the knee */
+        }
+        for (j = 0; j <= n; j++)                                                           /* every segment */
+        {
+            lo = (j == 0) ? 0 : knee[j - 1];                                               /* first mantissa */
+            hi = (j == n) ? 4096 : knee[j];                                                /* end mantissa */
+            a_opt300x_calib_segment(calib, a * ((float)(lo + hi - 1) * 0.5f) + calib->offset, &k, &c);      /* segment at the middle */
+            calib->scale[e][j] = k * a;                                                    /* set the scale */
+            calib->bias[e][j] = k * calib->offset + c;                                     /* set the offset */
+            calib->knee[e][j] = (j == n) ? 0xFFFF : knee[j];                               /* set the knee */
+        }
+    }
+}
+
+/**
+ * @brief     check a curve
+ * @param[in] *in pointer to the curve inputs
+ * @param[in] *out pointer to the curve outputs
+ * @param[in] num points
+ * @return    status code
+ *            - 0 valid
+ *            - 1 invalid
+ * @note      none
+ */
+static uint8_t a_opt300x_calib_check_curve(const float *in, const float *out, uint8_t num)
+{
+    uint8_t i;
+    
+    if (num == 0)                                                                          /* no curve */
+    {
+        return 0;                                                                          /* valid */
+    }
+    if ((num < 2) || (num > OPT300X_CALIB_MAX_POINT))                                      /* check the points */
+    {
+        return 1;                                                                          /* invalid */
+    }
+    for (i = 0; i < num; i++)                                                              /* every point */
+    {
+        if ((isfinite(in[i]) == 0) || (isfinite(out[i]) == 0) ||
+            ((i != 0) && (in[i] <= in[i - 1])))                                            /* finite and ascending */
+        {
+            return 1;                                                                      /* invalid */
+        }
+    }
+    
+    return 0;                                                                              /* valid */
+}
+
+/**
+ * @brief     update a crc32
+ * @param[in] crc crc so far
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    crc32
+ * @note      reflected 0xEDB88320, bitwise to keep the rom small
+ */
+static uint32_t a_opt300x_calib_crc32(uint32_t crc, const uint8_t *buf, uint32_t len)
+{
+    uint32_t i;
+    uint8_t j;
+    
+    crc = ~crc;                                                        /* invert */
+    for (i = 0; i < len; i++)                                          /* every byte */
+    {
+        crc ^= buf[i];                                                 /* add the byte */
+        for (j = 0; j < 8; j++)                                        /* every bit */
+        {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1)));       /* shift */
+        }
+    }
+    
+    return ~crc;                                                       /* invert */
+}
+
+/**
+ * @brief     put a little endian word
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] value word
+ * @note      none
+ */
+static void a_opt300x_calib_put(uint8_t *buf, uint32_t value)
+{
+    buf[0] = (uint8_t)(value >> 0);         /* set byte 0 */
+    buf[1] = (uint8_t)(value >> 8);         /* set byte 1 */
+    buf[2] = (uint8_t)(value >> 16);        /* set byte 2 */
+    buf[3] = (uint8_t)(value >> 24);        /* set byte 3 */
+}
+
+/**
+ * @brief     get a little endian word
+ * @param[in] *buf pointer to a data buffer
+ * @return    word
+ * @note      none
+ */
+static uint32_t a_opt300x_calib_get(const uint8_t *buf)
+{
+    return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) |
+           ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);        /* get the word */
+}
+
+/**
+ * @brief     put a little endian float
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] value float
+ * @note      ieee 754 single on every target
+ */
+static void a_opt300x_calib_put_float(uint8_t *buf, float value)
+{
+    union
+    {
+        float f;
+        uint32_t u;
+    } v;
+    
+    v.f = value;                               /* set the float */
+    a_opt300x_calib_put(buf, v.u);             /* put the bits */
+}
+
+/**
+ * @brief     get a little endian float
+ * @param[in] *buf pointer to a data buffer
+ * @return    float
+ * @note      ieee 754 single on every target
+ */
+static float a_opt300x_calib_get_float(const uint8_t *buf)
+{
+    union
+    {
+        float f;
+        uint32_t u;
+    } v;
+    
+    v.u = a_opt300x_calib_get(buf);            /* get the bits */
+    
+    return v.f;                                /* return the float */
+}
+
+/**
+ * @brief     init a calibration
+ * @param[in] *calib pointer to a calib structure
+ * @param[in] type chip type
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 type is invalid
+ * @note      starts as the plain conversion, gain 1, offset 0 and no curve
+ */
+uint8_t opt300x_calib_init(opt300x_calib_t *calib, opt300x_t type)
+{
+    if (calib == NULL)                                                     /* check calib */
+    {
+        return 2;                                                          /* return error */
+    }
+    if ((type != OPT3001) && (type != OPT3002) && (type != OPT3004) &&
+        (type != OPT3005) && (type != OPT3006))                            /* check the type */
+    {
+        return 4;                                                          /* return error */
+    }
+    
+    calib->type = (uint8_t)type;                                           /* set the type */
+    calib->gain = 1.0f;                                                    /* set the gain */
+    calib->offset = 0.0f;                                                  /* set the offset */
+    calib->point_num = 0;                                                  /* no curve */
+    a_opt300x_calib_build(calib);                                          /* build the table */
+    calib->inited = 1;                                                     /* flag inited */
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief     set the gain and the offset
+ * @param[in] *calib pointer to a calib structure
+ * @param[in] gain gain
+ * @param[in] offset offset in lux or nW/cm2
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 param is invalid
+ * @note      rebuilds the segment table
+ */
+uint8_t opt300x_calib_set_linear(opt300x_calib_t *calib, float gain, float offset)
+{
+    if (calib == NULL)                                                     /* check calib */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (calib->inited != 1)                                                /* check calib initialization */
+    {
+        return 3;                                                          /* return error */
+    }
+    if ((isfinite(gain) == 0) || (isfinite(offset) == 0))                  /* check the param */
+    {
+        return 4;                                                          /* return error */
+    }
+    
+    calib->gain = gain;                                                    /* set the gain */
+    calib->offset = offset;                                                /* set the offset */
+    a_opt300x_calib_build(calib);                                          /* build the table */
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief     set the piecewise linear curve
+ * @param[in] *calib pointer to a calib structure
+ * @param[in] *in pointer to the curve inputs, ascending
+ * @param[in] *out pointer to the curve outputs
+ * @param[in] num points, 0 removes the curve, 2 to OPT300X_CALIB_MAX_POINT
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 param is invalid
+ * @note      the curve is extended linearly outside its points, rebuilds the segment table
+ */
+uint8_t opt300x_calib_set_curve(opt300x_calib_t *calib, const float *in, const float *out, uint8_t num)
+{
+    uint8_t i;
+    
+    if (calib == NULL)                                                     /* check calib */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (calib->inited != 1)                                                /* check calib initialization */
+    {
+        return 3;                                                          /* return error */
+    }
+    if ((num != 0) && ((in == NULL) || (out == NULL)))                     /* check the buffers */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (a_opt300x_calib_check_curve(in, out, num) != 0)                    /* check the curve */
+    {
+        return 4;                                                          /* return error */
+    }
+    
+    for (i = 0; i < num; i++)                                              /* every point */
+    {
+        calib->point_in[i] = in[i];                                        /* set the input */
+        calib->point_out[i] = out[i];                                      /* set the output */
+    }
+    calib->point_num = num;                                                /* set the points */
+    a_opt300x_calib_build(calib);                                          /* build the table */
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief      calibrate one raw result word
+ * @param[in]  *calib pointer to a calib structure
+ * @param[in]  raw raw result word
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ * @note       exponents above 11 give NAN
+ */
+uint8_t opt300x_calib_apply(opt300x_calib_t *calib, uint16_t raw, float *data)
+{
+    uint8_t e;
+    uint8_t s;
+    uint16_t m;
+    
+    if ((calib == NULL) || (data == NULL))                                                 /* check calib and data */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (calib->inited != 1)                                                                /* check calib initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    
+    e = (uint8_t)(raw >> 12);                                                              /* exponent */
+    m = (uint16_t)(raw & 0x0FFF);                                                          /* mantissa */
+    s = 0;                                                                                 /* first segment */
+    while (m >= calib->knee[e][s])                                                         /* find the segment */
+    {
+        s++;                                                                               /* next segment */
+    }
+    *data = (float)m * calib->scale[e][s] + calib->bias[e][s];                             /* calibrate */
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief      calibrate an array of raw result words
+ * @param[in]  *calib pointer to a calib structure
+ * @param[in]  *raw pointer to the raw result words
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len array length
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ * @note       one knee search, one multiply and one add per word
+ */
+uint8_t opt300x_calib_apply_batch(opt300x_calib_t *calib, const uint16_t *raw, float *data, uint32_t len)
+{
+    uint32_t i;
+    uint8_t e;
+    uint8_t s;
+    uint16_t m;
+    
+    if ((calib == NULL) || (raw == NULL) || (data == NULL))                                /* check calib and the buffers */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (calib->inited != 1)                                                                /* check calib initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    
+    for (i = 0; i < len; i++)                                                              /* every word */
+    {
+        e = (uint8_t)(raw[i] >> 12);                                                       /* exponent */
+        m = (uint16_t)(raw[i] & 0x0FFF);                                                   /* mantissa */
+        s = 0;                                                                             /* first segment */
+        while (m >= calib->knee[e][s])                                                     /* find the segment */
+        {
+            s++;                                                                           /* next segment */
+        }
+        data[i] = (float)m * calib->scale[e][s] + calib->bias[e][s];                       /* calibrate */
+    }
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief      read a sensor and calibrate the result
+ * @param[in]  *calib pointer to a calib structure
+ * @param[in]  *handle pointer to an opt300x handle structure in continuous mode
+ * @param[out] *raw pointer to a raw data buffer
+ * @param[out] *data pointer to a calibrated data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ *             - 4 chip type of the handle doesn't match
+ * @note       none
+ */
+uint8_t opt300x_calib_read(opt300x_calib_t *calib, opt300x_handle_t *handle, uint16_t *raw, float *data)
+{
+    uint8_t res;
+    float value;
+    
+    if ((calib == NULL) || (handle == NULL) || (raw == NULL) || (data == NULL))            /* check calib, handle and the buffers */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if ((calib->inited != 1) || (handle->inited != 1))                                     /* check initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    if (handle->type != calib->type)                                                       /* check the type */
+    {
+        return 4;                                                                          /* return error */
+    }
+    
+    if (handle->type == (uint8_t)OPT3002)                                                  /* opt3002 */
+    {
+        res = opt3002_continuous_read(handle, raw, &value);                                /* read nW/cm2 */
+    }
+    else                                                                                   /* the others */
+    {
+        res = opt300x_continuous_read(handle, raw, &value);                                /* read lux */
+    }
+    if (res != 0)                                                                          /* check the result */
+    {
+        return 1;                                                                          /* return error */
+    }
+    
+    return opt300x_calib_apply(calib, *raw, data);                                         /* calibrate */
+}
+
+/**
+ * @brief      save a calibration to a blob
+ * @param[in]  *calib pointer to a calib structure
+ * @param[out] *buf pointer to a blob buffer
+ * @param[in]  size buffer size
+ * @param[out] *len pointer to a blob length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ *             - 4 buffer is too small
+ * @note       OPT300X_CALIB_BLOB_SIZE(point_num) bytes, little endian with a crc32, the table is not stored
+ */
+uint8_t opt300x_calib_save(opt300x_calib_t *calib, uint8_t *buf, uint32_t size, uint32_t *len)
+{
+    uint8_t i;
+    uint8_t *p;
+    
+    if ((calib == NULL) || (buf == NULL) || (len == NULL))                                 /* check calib and the buffers */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (calib->inited != 1)                                                                /* check calib initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    if (size < OPT300X_CALIB_BLOB_SIZE(calib->point_num))                                  /* check the size */
+    {
+        return 4;                                                                          /* return error */
+    }
+    
+    a_opt300x_calib_put(buf, OPT300X_CALIB_MAGIC);                                         /* set the magic */
+    buf[4] = OPT300X_CALIB_VERSION;                                                        /* set the version */
+    buf[5] = calib->type;                                                                  /* set the type */
+    buf[6] = calib->point_num;                                                             /* set the points */
+    buf[7] = 0;                                                                            /* reserved */
+    a_opt300x_calib_put_float(buf + 8, calib->gain);                                       /* set the gain */
+    a_opt300x_calib_put_float(buf + 12, calib->offset);                                    /* set the offset */
+    p = buf + 16;                                                                          /* first point */
+    for (i = 0; i < calib->point_num; i++)                                                 /* every point */
+    {
+        a_opt300x_calib_put_float(p, calib->point_in[i]);                                  /* set the input */
+        a_opt300x_calib_put_float(p + 4, calib->point_out[i]);                             /* set the output */
+        p += 8;                                                                            /* next point */
+    }
+    a_opt300x_calib_put(p, a_opt300x_calib_crc32(0, buf, (uint32_t)(p - buf)));            /* set the crc */
+    *len = OPT300X_CALIB_BLOB_SIZE(calib->point_num);                                      /* set the length */
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     load a calibration from a blob
+ * @param[in] *calib pointer to a calib structure
+ * @param[in] *buf pointer to a blob
+ * @param[in] len blob length
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 blob is invalid
+ * @note      rebuilds the segment table
+ */
+uint8_t opt300x_calib_load(opt300x_calib_t *calib, const uint8_t *buf, uint32_t len)
+{
+    uint8_t i;
+    uint8_t num;
+    float gain;
+    float offset;
+    float in[OPT300X_CALIB_MAX_POINT];
+    float out[OPT300X_CALIB_MAX_POINT];
+    
+    if ((calib == NULL) || (buf == NULL))                                                  /* check calib and the buffer */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if ((len < OPT300X_CALIB_BLOB_SIZE(0)) ||
+        (a_opt300x_calib_get(buf) != OPT300X_CALIB_MAGIC) ||
+        (buf[4] != OPT300X_CALIB_VERSION) ||
+        (buf[6] > OPT300X_CALIB_MAX_POINT) ||
+        (len != OPT300X_CALIB_BLOB_SIZE(buf[6])) ||
+        (a_opt300x_calib_get(buf + len - 4) != a_opt300x_calib_crc32(0, buf, len - 4)))    /* check the blob */
+    {
+        return 4;                                                                          /* return error */
+    }
+    
+    num = buf[6];                                                                          /* get the points */
+    gain = a_opt300x_calib_get_float(buf + 8);                                             /* get the gain */
+    offset = a_opt300x_calib_get_float(buf + 12);                                          /* get the offset */
+    for (i = 0; i < num; i++)                                                              /* every point */
+    {
+        in[i] = a_opt300x_calib_get_float(buf + 16 + 8 * i);                               /* get the input */
+        out[i] = a_opt300x_calib_get_float(buf + 20 + 8 * i);                              /* get the output */
+    }
+    if (((buf[5] != (uint8_t)OPT3001) && (buf[5] != (uint8_t)OPT3002) && (buf[5] != (uint8_t)OPT3004) &&
+         (buf[5] != (uint8_t)OPT3005) && (buf[5] != (uint8_t)OPT3006)) ||
+        (isfinite(gain) == 0) || (isfinite(offset) == 0) ||
+        (a_opt300x_calib_check_curve(in, out, num) != 0))                                  /* check the values */
+    {
+        return 4;                                                                          /* return error */
+    }
+    
+    calib->type = buf[5];                                                                  /* set the type */
+    calib->gain = gain;                                                                    /* set the gain */
+    calib->offset = offset;                                                                /* set the offset */
+    for (i = 0; i < num; i++)                                                              /* every point */
+    {
+        calib->point_in[i] = in[i];                                                        /* set the input */
+        calib->point_out[i] = out[i];                                                      /* set the output */
+    }
+    calib->point_num = num;                                                                /* set the points */
+    a_opt300x_calib_build(calib);                                                          /* build the table */
+    calib->inited = 1;                                                                     /* flag inited */
+    
+    return 0;                                                                              /* success return 0 */
+}
@@ -0,0 +1,204 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_calib.h
+ * @brief     driver opt300x calib header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_OPT300X_CALIB_H
+#define DRIVER_OPT300X_CALIB_H
+
+#include "driver_opt300x.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup opt300x_calib_driver opt300x calib driver function
+ * @brief    opt300x calib driver modules
+ * @ingroup  opt300x_driver
+ * @{
+ */
+
+/**
+ * @brief calib max curve points
+ */
+#ifndef OPT300X_CALIB_MAX_POINT
+    #define OPT300X_CALIB_MAX_POINT 8        /**< 8 points */
+#endif
+
+/**
+ * @brief calib blob size of n curve points
+ */
+#define OPT300X_CALIB_BLOB_SIZE(n) (20 + 8 * (uint32_t)(n))
+
+/**
+ * @brief opt300x calib structure definition
+ * @note  the calibrated data is curve(gain * data + offset), folded into one scale and one offset
+ *        per curve segment of every exponent so a sample costs a knee search, one multiply and one add
+ */
+typedef struct opt300x_calib_s
+{
+    uint8_t inited;                                        /**< inited flag */
+    uint8_t type;                                          /**< chip type */
+    uint8_t point_num;                                     /**< curve points, 0 is no curve */
+    float gain;                                            /**< gain */
+    float offset;                                          /**< offset */
+    float point_in[OPT300X_CALIB_MAX_POINT];               /**< curve inputs, ascending */
+    float point_out[OPT300X_CALIB_MAX_POINT];              /**< curve outputs */
+    float scale[16][OPT300X_CALIB_MAX_POINT - 1];          /**< mantissa scale of every segment of every exponent */
+    float bias[16][OPT300X_CALIB_MAX_POINT - 1];           /**< offset of every segment of every exponent */
+    uint16_t knee[16][OPT300X_CALIB_MAX_POINT - 1];        /**< first mantissa of the next segment, 0xFFFF for the last */
+} opt300x_calib_t;
+
+/**
+ * @brief     init a calibration
+ * @param[in] *calib pointer to a calib structure
+ * @param[in] type chip type
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 type is invalid
+ * @note      starts as the plain conversion, gain 1, offset 0 and no curve
+ */
+uint8_t opt300x_calib_init(opt300x_calib_t *calib, opt300x_t type);
+
+/**
+ * @brief     set the gain and the offset
+ * @param[in] *calib pointer to a calib structure
+ * @param[in] gain gain
+ * @param[in] offset offset in lux or nW/cm2
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 param is invalid
+ * @note      rebuilds the segment table
+ */
+uint8_t opt300x_calib_set_linear(opt300x_calib_t *calib, float gain, float offset);
+
+/**
+ * @brief     set the piecewise linear curve
+ * @param[in] *calib pointer to a calib structure
+ * @param[in] *in pointer to the curve inputs, ascending
+ * @param[in] *out pointer to the curve outputs
+ * @param[in] num points, 0 removes the curve, 2 to OPT300X_CALIB_MAX_POINT
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 param is invalid
+ * @note      the curve is extended linearly outside its points, rebuilds the segment table
+ */
+uint8_t opt300x_calib_set_curve(opt300x_calib_t *calib, const float *in, const float *out, uint8_t num);
+
+/**
+ * @brief      calibrate one raw result word
+ * @param[in]  *calib pointer to a calib structure
+ * @param[in]  raw raw result word
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ * @note       exponents above 11 give NAN
+ */
+uint8_t opt300x_calib_apply(opt300x_calib_t *calib, uint16_t raw, float *data);
+
+/**
+ * @brief      calibrate an array of raw result words
+ * @param[in]  *calib pointer to a calib structure
+ * @param[in]  *raw pointer to the raw result words
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  len array length
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ * @note       one knee search, one multiply and one add per word
+ */
+uint8_t opt300x_calib_apply_batch(opt300x_calib_t *calib, const uint16_t *raw, float *data, uint32_t len);
+
+/**
+ * @brief      read a sensor and calibrate the result
+ * @param[in]  *calib pointer to a calib structure
+ * @param[in]  *handle pointer to an opt300x handle structure in continuous mode
+ * @param[out] *raw pointer to a raw data buffer
+ * @param[out] *data pointer to a calibrated data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ *             - 4 chip type of the handle doesn't match
+ * @note       none
+ */
+uint8_t opt300x_calib_read(opt300x_calib_t *calib, opt300x_handle_t *handle, uint16_t *raw, float *data);
+
+/**
+ * @brief      save a calibration to a blob
+ * @param[in]  *calib pointer to a calib structure
+ * @param[out] *buf pointer to a blob buffer
+ * @param[in]  size buffer size
+ * @param[out] *len pointer to a blob length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ *             - 4 buffer is too small
+ * @note       OPT300X_CALIB_BLOB_SIZE(point_num) bytes, little endian with a crc32, the table is not stored
+ */
+uint8_t opt300x_calib_save(opt300x_calib_t *calib, uint8_t *buf, uint32_t size, uint32_t *len);
+
+/**
+ * @brief     load a calibration from a blob
+ * @param[in] *calib pointer to a calib structure
+ * @param[in] *buf pointer to a blob
+ * @param[in] len blob length
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 blob is invalid
+ * @note      rebuilds the segment table
+ */
+uint8_t opt300x_calib_load(opt300x_calib_t *calib, const uint8_t *buf, uint32_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
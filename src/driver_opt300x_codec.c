@@ -0,0 +1,519 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_codec.c
+ * @brief     driver opt300x codec source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_opt300x_codec.h"
+
+/**
+ * @brief codec definition
+ */
+#define CODEC_MAX_SAMPLE        65535        /**< max samples of one block */
+#define CODEC_MAX_VARINT        3            /**< max varint bytes */
+
+/**
+ * @brief     predict a mantissa after an exponent change
+ * @param[in] mantissa last mantissa
+ * @param[in] last last exponent
+ * @param[in] exponent new exponent
+ * @return    predicted mantissa
+ * @note      keeps the same light level in the new range
+ */
+static inline uint32_t a_opt300x_codec_predict(uint32_t mantissa, uint32_t last, uint32_t exponent)
+{
+    if (exponent >= last)                                             /* higher range */
+    {
+        return mantissa >> (exponent - last);                         /* scale down */
+    }
+    else                                                              /* lower range */
+    {
+        mantissa <<= (last - exponent);                               /* scale up */
+        
+        return (mantissa > 0x0FFF) ? 0x0FFF : mantissa;               /* clip */
+    }
+}
+
+/**
+ * @brief     zigzag encode a delta
+ * @param[in] delta mantissa delta
+ * @return    zigzag code
+ * @note      none
+ */
+static inline uint32_t a_opt300x_codec_zigzag(int32_t delta)
+{
+    return (delta < 0) ? ((uint32_t)(-delta) * 2U - 1U) : ((uint32_t)delta * 2U);
+}
+
+/**
+ * @brief     get the varint length of a value
+ * @param[in] value value
+ * @return    varint bytes
+ * @note      none
+ */
+static inline uint32_t a_opt300x_codec_varint_len(uint32_t value)
+{
+    return (value < 0x80U) ? 1U : ((value < 0x4000U) ? 2U : 3U);
+}
+
+/**
+ * @brief         write a varint
+ * @param[out]    *out pointer to an output buffer
+ * @param[in]     size output buffer size
+ * @param[in,out] *pos pointer to an output position
+ * @param[in]     value value
+ * @return        status code
+ *                - 0 success
+ *                - 1 output buffer is too small
+ * @note          value < 2^21
+ */
+static uint8_t a_opt300x_codec_varint_write(uint8_t *out, uint32_t size, uint32_t *pos, uint32_t value)
+{
+    if (*pos + a_opt300x_codec_varint_len(value) > size)              /* check the size */
+    {
+        return 1;                                                     /* return error */
+    }
+    while (value >= 0x80U)                                            /* 7 bits per byte */
+    {
+        out[(*pos)++] = (uint8_t)(value | 0x80U);                     /* more bytes follow */
+        value >>= 7;                                                  /* next bits */
+    }
+    out[(*pos)++] = (uint8_t)value;                                   /* last byte */
+    
+    return 0;                                                         /* success return 0 */
+}
+
+/**
+ * @brief         read a varint
+ * @param[in]     *in pointer to an encoded buffer
+ * @param[in]     len encoded length
+ * @param[in,out] *pos pointer to an input position
+ * @param[out]    *value pointer to a value buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 stream is corrupt
+ * @note          none
+ */
+static inline uint8_t a_opt300x_codec_varint_read(const uint8_t *in, uint32_t len, uint32_t *pos, uint32_t *value)
+{
+    uint32_t i;
+    uint32_t v = 0;
+    
+    for (i = 0; (i < CODEC_MAX_VARINT) && (*pos < len); i++)          /* at most 3 bytes */
+    {
+        uint8_t b = in[(*pos)++];
+        
+        v |= (uint32_t)(b & 0x7FU) << (7 * i);                        /* add 7 bits */
+        if ((b & 0x80U) == 0)                                         /* last byte */
+        {
+            *value = v;                                               /* set the value */
+            
+            return 0;                                                 /* success return 0 */
+        }
+    }
+    
+    return 1;                                                         /* return error */
+}
+
+/**
+ * @brief      encode one block
+ * @param[in]  mode codec mode
+ * @param[in]  *raw pointer to a raw word buffer
+ * @param[in]  num raw word numbers
+ * @param[out] *out pointer to an output buffer
+ * @param[in]  size output buffer size
+ * @param[out] *len pointer to an encoded length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 num is invalid
+ *             - 5 output buffer is too small
+ * @note       an output buffer of OPT300X_CODEC_BOUND(num) never is too small
+ */
+uint8_t opt300x_codec_encode_block(opt300x_codec_mode_t mode, const uint16_t *raw, uint32_t num,
+                                   uint8_t *out, uint32_t size, uint32_t *len)
+{
+    uint32_t i;
+    uint32_t pos;
+    uint32_t exponent;
+    uint32_t mantissa;
+    
+    if ((raw == NULL) || (out == NULL) || (len == NULL))                                    /* check the buffers */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if ((num == 0) || (num > CODEC_MAX_SAMPLE))                                             /* check num */
+    {
+        return 4;                                                                           /* return error */
+    }
+    
+    pos = 0;                                                                                /* start */
+    if (a_opt300x_codec_varint_write(out, size, &pos, num) != 0)                            /* write the samples */
+    {
+        return 5;                                                                           /* return error */
+    }
+    exponent = 0;                                                                           /* reset the prediction */
+    mantissa = 0;                                                                           /* reset the prediction */
+    i = 0;                                                                                  /* first sample */
+    while (i < num)                                                                         /* one run per exponent change */
+    {
+        uint32_t j;
+        uint32_t run;
+        uint32_t e = (uint32_t)(raw[i] >> 12);
+        uint32_t pred = a_opt300x_codec_predict(mantissa, exponent, e);
+        uint32_t varint = 0;
+        uint32_t max = 0;
+        uint32_t width = 0;
+        uint32_t packed;
+        uint32_t m;
+        
+        for (j = i; (j < num) && ((uint32_t)(raw[j] >> 12) == e); j++)                      /* measure the run */
+        {
+            uint32_t zz;
+            
+            m = (uint32_t)(raw[j] & 0x0FFF);                                                /* get the mantissa */
+            zz = a_opt300x_codec_zigzag((int32_t)m - (int32_t)pred);                        /* get the delta */
+            if (j != i)                                                                     /* the first delta is never packed */
+            {
+                varint += a_opt300x_codec_varint_len(zz);                                   /* varint size */
+                max |= zz;                                                                  /* widest delta */
+            }
+            pred = m;                                                                       /* next prediction */
+        }
+        run = j - i;                                                                        /* run length */
+        while ((max >> width) != 0)                                                         /* bit width */
+        {
+            width++;                                                                        /* one more bit */
+        }
+        packed = ((mode == OPT300X_CODEC_MODE_AUTO) && (run > 1) &&
+                  (1U + ((run - 1U) * width + 7U) / 8U < varint)) ? 1U : 0U;                /* choose the smaller */
+        if (a_opt300x_codec_varint_write(out, size, &pos,
+                                         ((run - 1U) << 5) | (packed << 4) | e) != 0)       /* write the run header */
+        {
+            return 5;                                                                       /* return error */
+        }
+        
+        m = (uint32_t)(raw[i] & 0x0FFF);                                                    /* get the first mantissa */
+        if (a_opt300x_codec_varint_write(out, size, &pos,
+            a_opt300x_codec_zigzag((int32_t)m - (int32_t)a_opt300x_codec_predict(mantissa, exponent, e))) != 0)
+        {
+            return 5;                                                                       /* return error */
+        }
+        pred = m;                                                                           /* next prediction */
+        if (packed != 0)                                                                    /* bit-packed deltas */
+        {
+            uint32_t acc = 0;
+            uint32_t bits = 0;
+            
+            if (pos + 1U + ((run - 1U) * width + 7U) / 8U > size)                           /* check the size */
+            {
+                return 5;                                                                   /* return error */
+            }
+            out[pos++] = (uint8_t)width;                                                    /* write the width */
+            for (j = i + 1; j < i + run; j++)                                               /* pack lsb first */
+            {
+                m = (uint32_t)(raw[j] & 0x0FFF);                                            /* get the mantissa */
+                acc |= a_opt300x_codec_zigzag((int32_t)m - (int32_t)pred) << bits;          /* add the delta */
+                bits += width;                                                              /* add the bits */
+                while (bits >= 8)                                                           /* flush whole bytes */
+                {
+                    out[pos++] = (uint8_t)acc;                                              /* write a byte */
+                    acc >>= 8;                                                              /* next bits */
+                    bits -= 8;                                                              /* less bits */
+                }
+                pred = m;                                                                   /* next prediction */
+            }
+            if (bits != 0)                                                                  /* last bits */
+            {
+                out[pos++] = (uint8_t)acc;                                                  /* write the byte */
+            }
+        }
+        else                                                                                /* varint deltas */
+        {
+            for (j = i + 1; j < i + run; j++)                                               /* every other sample */
+            {
+                m = (uint32_t)(raw[j] & 0x0FFF);                                            /* get the mantissa */
+                if (a_opt300x_codec_varint_write(out, size, &pos,
+                    a_opt300x_codec_zigzag((int32_t)m - (int32_t)pred)) != 0)               /* write the delta */
+                {
+                    return 5;                                                               /* return error */
+                }
+                pred = m;                                                                   /* next prediction */
+            }
+        }
+        exponent = e;                                                                       /* last exponent */
+        mantissa = pred;                                                                    /* last mantissa */
+        i += run;                                                                           /* next run */
+    }
+    *len = pos;                                                                             /* set the length */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     init the encoder
+ * @param[in] *encoder pointer to an encoder structure
+ * @param[in] mode codec mode
+ * @param[in] block samples per block
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 block is invalid
+ * @note      1 <= block <= OPT300X_CODEC_MAX_BLOCK
+ */
+uint8_t opt300x_codec_encoder_init(opt300x_codec_encoder_t *encoder, opt300x_codec_mode_t mode, uint16_t block)
+{
+    if (encoder == NULL)                                                       /* check encoder */
+    {
+        return 2;                                                              /* return error */
+    }
+    if ((block == 0) || (block > OPT300X_CODEC_MAX_BLOCK))                     /* check block */
+    {
+        return 4;                                                              /* return error */
+    }
+    
+    encoder->mode = (uint8_t)mode;                                             /* set the mode */
+    encoder->block = block;                                                    /* set the block */
+    encoder->num = 0;                                                          /* empty */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      push one raw word into the encoder
+ * @param[in]  *encoder pointer to an encoder structure
+ * @param[in]  raw raw result word
+ * @param[out] *out pointer to an output buffer
+ * @param[in]  size output buffer size
+ * @param[out] *len pointer to an encoded length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 5 output buffer is too small
+ * @note       *len is 0 until a block is full, then the block is written to out
+ */
+uint8_t opt300x_codec_encode(opt300x_codec_encoder_t *encoder, uint16_t raw, uint8_t *out, uint32_t size, uint32_t *len)
+{
+    if ((encoder == NULL) || (len == NULL))                                    /* check encoder and len */
+    {
+        return 2;                                                              /* return error */
+    }
+    
+    *len = 0;                                                                  /* nothing written */
+    if (encoder->num >= encoder->block)                                        /* a full block is left from a failed write */
+    {
+        if (opt300x_codec_encoder_flush(encoder, out, size, len) != 0)         /* write it */
+        {
+            return 5;                                                          /* return error */
+        }
+    }
+    encoder->raw[encoder->num++] = raw;                                        /* buffer the word */
+    if ((*len == 0) && (encoder->num >= encoder->block))                       /* block is full */
+    {
+        return opt300x_codec_encoder_flush(encoder, out, size, len);           /* write the block */
+    }
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      encode the buffered raw words as a short block
+ * @param[in]  *encoder pointer to an encoder structure
+ * @param[out] *out pointer to an output buffer
+ * @param[in]  size output buffer size
+ * @param[out] *len pointer to an encoded length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 5 output buffer is too small
+ * @note       *len is 0 when nothing is buffered
+ */
+uint8_t opt300x_codec_encoder_flush(opt300x_codec_encoder_t *encoder, uint8_t *out, uint32_t size, uint32_t *len)
+{
+    uint8_t res;
+    
+    if ((encoder == NULL) || (len == NULL))                                                 /* check encoder and len */
+    {
+        return 2;                                                                           /* return error */
+    }
+    
+    *len = 0;                                                                               /* nothing written */
+    if (encoder->num == 0)                                                                  /* nothing buffered */
+    {
+        return 0;                                                                           /* success return 0 */
+    }
+    res = opt300x_codec_encode_block((opt300x_codec_mode_t)encoder->mode, encoder->raw,
+                                     encoder->num, out, size, len);                         /* encode the block */
+    if (res != 0)                                                                           /* check the result */
+    {
+        *len = 0;                                                                           /* nothing written */
+        
+        return res;                                                                         /* keep the samples */
+    }
+    encoder->num = 0;                                                                       /* empty */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief      decode a stream of blocks
+ * @param[in]  *in pointer to an encoded buffer
+ * @param[in]  len encoded length
+ * @param[out] *raw pointer to a raw word buffer
+ * @param[in]  size raw word buffer size
+ * @param[out] *num pointer to a decoded numbers buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 stream is corrupt
+ *             - 5 raw word buffer is too small
+ * @note       none
+ */
+uint8_t opt300x_codec_decode(const uint8_t *in, uint32_t len, uint16_t *raw, uint32_t size, uint32_t *num)
+{
+    uint32_t pos;
+    uint32_t out;
+    
+    if ((in == NULL) || (raw == NULL) || (num == NULL))                                     /* check the buffers */
+    {
+        return 2;                                                                           /* return error */
+    }
+    
+    pos = 0;                                                                                /* start */
+    out = 0;                                                                                /* no samples */
+    *num = 0;                                                                               /* no samples */
+    while (pos < len)                                                                       /* every block */
+    {
+        uint32_t count;
+        uint32_t end;
+        uint32_t exponent = 0;
+        uint32_t mantissa = 0;
+        
+        if ((a_opt300x_codec_varint_read(in, len, &pos, &count) != 0) || (count == 0))      /* read the samples */
+        {
+            return 4;                                                                       /* return error */
+        }
+        if (count > size - out)                                                             /* check the size */
+        {
+            return 5;                                                                       /* return error */
+        }
+        end = out + count;                                                                  /* block end */
+        while (out < end)                                                                   /* every run */
+        {
+            uint32_t header;
+            uint32_t run;
+            uint32_t e;
+            uint32_t m;
+            uint32_t j;
+            uint32_t zz;
+            
+            if (a_opt300x_codec_varint_read(in, len, &pos, &header) != 0)                   /* read the run header */
+            {
+                return 4;                                                                   /* return error */
+            }
+            run = (header >> 5) + 1U;                                                       /* run length */
+            e = header & 0x0FU;                                                             /* exponent */
+            if (run > end - out)                                                            /* check the run */
+            {
+                return 4;                                                                   /* return error */
+            }
+            m = a_opt300x_codec_predict(mantissa, exponent, e);                             /* first prediction */
+            if (a_opt300x_codec_varint_read(in, len, &pos, &zz) != 0)                       /* read the first delta */
+            {
+                return 4;                                                                   /* return error */
+            }
+            m = (uint32_t)((int32_t)m + (((zz & 1U) != 0) ? -(int32_t)((zz + 1U) >> 1) :
+                                                             (int32_t)(zz >> 1)));          /* add the delta */
+            raw[out++] = (uint16_t)((e << 12) | (m & 0x0FFFU));                             /* set the word */
+            run--;                                                                          /* other deltas */
+            if ((header & 0x10U) != 0)                                                      /* bit-packed deltas */
+            {
+                uint32_t width;
+                uint32_t mask;
+                uint32_t bits = 0;
+                uint64_t acc = 0;
+                
+                if (pos >= len)                                                             /* check the width */
+                {
+                    return 4;                                                               /* return error */
+                }
+                width = in[pos++];                                                          /* read the width */
+                if ((width > 13) || ((run * width + 7U) / 8U > len - pos))                  /* check the bits */
+                {
+                    return 4;                                                               /* return error */
+                }
+                mask = (1U << width) - 1U;                                                  /* delta mask */
+                for (j = 0; j < run; j++)                                                   /* unpack lsb first */
+                {
+                    if (bits < width)                                                       /* refill */
+                    {
+                        while ((bits <= 56) && (pos < len))                                 /* fill whole bytes */
+                        {
+                            acc |= (uint64_t)in[pos++] << bits;                             /* add a byte */
+                            bits += 8;                                                      /* more bits */
+                        }
+                    }
+                    zz = (uint32_t)acc & mask;                                              /* get the delta */
+                    acc >>= width;                                                          /* next delta */
+                    bits -= width;                                                          /* less bits */
+                    m = (uint32_t)((int32_t)m + (((zz & 1U) != 0) ? -(int32_t)((zz + 1U) >> 1) :
+                                                                     (int32_t)(zz >> 1)));  /* add the delta */
+                    raw[out++] = (uint16_t)((e << 12) | (m & 0x0FFFU));                     /* set the word */
+                }
+                pos -= bits / 8;                                                            /* return the unused bytes */
+            }
+            else                                                                            /* varint deltas */
+            {
+                for (j = 0; j < run; j++)                                                   /* every other sample */
+                {
+                    if ((pos < len) && (in[pos] < 0x80U))                                   /* one byte fast path */
+                    {
+                        zz = in[pos++];                                                     /* read the delta */
+                    }
+                    else if (a_opt300x_codec_varint_read(in, len, &pos, &zz) != 0)          /* read the delta */
+                    {
+                        return 4;                                                           /* return error */
+                    }
+                    m = (uint32_t)((int32_t)m + (((zz & 1U) != 0) ? -(int32_t)((zz + 1U) >> 1) :
+                                                                     (int32_t)(zz >> 1)));  /* add the delta */
+                    raw[out++] = (uint16_t)((e << 12) | (m & 0x0FFFU));                     /* set the word */
+                }
+            }
+            exponent = e;                                                                   /* last exponent */
+            mantissa = m & 0x0FFFU;                                                         /* last mantissa */
+        }
+    }
+    *num = out;                                                                             /* set the numbers */
+    
+    return 0;                                                                               /* success return 0 */
+}
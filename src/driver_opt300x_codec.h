@@ -0,0 +1,182 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_codec.h
+ * @brief     driver opt300x codec header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_OPT300X_CODEC_H
+#define DRIVER_OPT300X_CODEC_H
+
+#include "driver_opt300x.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup opt300x_codec_driver opt300x codec driver function
+ * @brief    opt300x codec driver modules
+ * @ingroup  opt300x_driver
+ * @{
+ */
+
+/**
+ * @brief codec max samples of one block
+ * @note  the encoder buffers one block, override it at compile time to fit the target
+ */
+#ifndef OPT300X_CODEC_MAX_BLOCK
+    #define OPT300X_CODEC_MAX_BLOCK 128        /**< 128 samples */
+#endif
+
+/**
+ * @brief codec worst case encoded bytes of a block
+ */
+#define OPT300X_CODEC_BOUND(n) (3 + 3 * (uint32_t)(n))
+
+/**
+ * @brief codec stream format
+ * @note  a stream is a sequence of independent blocks of raw result words of one sensor
+ *        block  := varint(samples) run*
+ *        run    := varint((samples - 1) << 5 | packed << 4 | exponent) varint(zigzag(delta)) deltas
+ *        deltas := varint(zigzag(delta))* when packed is 0
+ *                  width(1 byte) bits(width * (samples - 1), lsb first) when packed is 1
+ *        a delta is the mantissa minus the prediction, the prediction is the last mantissa
+ *        shifted by the exponent change, 0 at the start of a block, the first delta of a run
+ *        carries the jump of a block start or a range change and is never packed
+ */
+
+/**
+ * @brief opt300x codec mode enumeration definition
+ */
+typedef enum
+{
+    OPT300X_CODEC_MODE_VARINT = 0x00,        /**< varint deltas only, the cheapest encoder */
+    OPT300X_CODEC_MODE_AUTO   = 0x01,        /**< varint or bit-packed deltas, the smaller per run */
+} opt300x_codec_mode_t;
+
+/**
+ * @brief opt300x codec encoder structure definition
+ */
+typedef struct opt300x_codec_encoder_s
+{
+    uint8_t mode;                                   /**< codec mode */
+    uint16_t block;                                 /**< samples per block */
+    uint16_t num;                                   /**< buffered samples */
+    uint16_t raw[OPT300X_CODEC_MAX_BLOCK];          /**< buffered raw words */
+} opt300x_codec_encoder_t;
+
+/**
+ * @brief      encode one block
+ * @param[in]  mode codec mode
+ * @param[in]  *raw pointer to a raw word buffer
+ * @param[in]  num raw word numbers
+ * @param[out] *out pointer to an output buffer
+ * @param[in]  size output buffer size
+ * @param[out] *len pointer to an encoded length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 num is invalid
+ *             - 5 output buffer is too small
+ * @note       an output buffer of OPT300X_CODEC_BOUND(num) never is too small
+ */
+uint8_t opt300x_codec_encode_block(opt300x_codec_mode_t mode, const uint16_t *raw, uint32_t num,
+                                   uint8_t *out, uint32_t size, uint32_t *len);
+
+/**
+ * @brief     init the encoder
+ * @param[in] *encoder pointer to an encoder structure
+ * @param[in] mode codec mode
+ * @param[in] block samples per block
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 block is invalid
+ * @note      1 <= block <= OPT300X_CODEC_MAX_BLOCK
+ */
+uint8_t opt300x_codec_encoder_init(opt300x_codec_encoder_t *encoder, opt300x_codec_mode_t mode, uint16_t block);
+
+/**
+ * @brief      push one raw word into the encoder
+ * @param[in]  *encoder pointer to an encoder structure
+ * @param[in]  raw raw result word
+ * @param[out] *out pointer to an output buffer
+ * @param[in]  size output buffer size
+ * @param[out] *len pointer to an encoded length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 5 output buffer is too small
+ * @note       *len is 0 until a block is full, then the block is written to out
+ */
+uint8_t opt300x_codec_encode(opt300x_codec_encoder_t *encoder, uint16_t raw, uint8_t *out, uint32_t size, uint32_t *len);
+
+/**
+ * @brief      encode the buffered raw words as a short block
+ * @param[in]  *encoder pointer to an encoder structure
+ * @param[out] *out pointer to an output buffer
+ * @param[in]  size output buffer size
+ * @param[out] *len pointer to an encoded length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 5 output buffer is too small
+ * @note       *len is 0 when nothing is buffered
+ */
+uint8_t opt300x_codec_encoder_flush(opt300x_codec_encoder_t *encoder, uint8_t *out, uint32_t size, uint32_t *len);
+
+/**
+ * @brief      decode a stream of blocks
+ * @param[in]  *in pointer to an encoded buffer
+ * @param[in]  len encoded length
+ * @param[out] *raw pointer to a raw word buffer
+ * @param[in]  size raw word buffer size
+ * @param[out] *num pointer to a decoded numbers buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 4 stream is corrupt
+ *             - 5 raw word buffer is too small
+ * @note       none
+ */
+uint8_t opt300x_codec_decode(const uint8_t *in, uint32_t len, uint16_t *raw, uint32_t size, uint32_t *num);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,597 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_dli.c
+ * @brief     driver opt300x dli source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_opt300x_dli.h"
+
+/**
+ * @brief dli checkpoint definition
+ */
+#define OPT300X_DLI_MAGIC           0x4C44334FU                        /**< "O3DL" */
+#define OPT300X_DLI_VERSION         1                                  /**< checkpoint version */
+#define OPT300X_DLI_FULL_SCALE      ((uint32_t)0x0FFF << 11)           /**< full scale lsb counts */
+#define OPT300X_DLI_FULL_SCALE_RAW  0xBFFF                             /**< exponent 11, mantissa 4095 */
+
+/**
+ * @brief     get the local day of a timestamp
+ * @param[in] *dli pointer to a dli structure
+ * @param[in] timestamp_us utc timestamp
+ * @return    local day number
+ * @note      none
+ */
+static uint32_t a_opt300x_dli_day(opt300x_dli_t *dli, uint64_t timestamp_us)
+{
+    return (uint32_t)((uint64_t)((int64_t)timestamp_us + dli->offset_us) / OPT300X_DLI_DAY_US);
+}
+
+/**
+ * @brief     integrate one interval
+ * @param[in] *dli pointer to a dli structure
+ * @param[in] sensor sensor id
+ * @param[in] t0 interval start
+ * @param[in] c0 lsb counts at the start
+ * @param[in] t1 interval end
+ * @param[in] c1 lsb counts at the end
+ * @param[in] overflow full scale flag
+ * @note      trapezoid, twice the area is kept so the sum stays an exact integer
+ */
+static void a_opt300x_dli_add(opt300x_dli_t *dli, uint8_t sensor, uint64_t t0, uint32_t c0,
+                              uint64_t t1, uint32_t c1, uint8_t overflow)
+{
+    dli->area[sensor] += ((uint64_t)c0 + c1) * (t1 - t0);                 /* add the area */
+    dli->covered_us[sensor] += t1 - t0;                                   /* add the time */
+    if (overflow != 0)                                                    /* full scale */
+    {
+        dli->overflow_us[sensor] += t1 - t0;                              /* add the overflow time */
+    }
+}
+
+/**
+ * @brief     fill a result from the running day
+ * @param[in] *dli pointer to a dli structure
+ * @param[in] sensor sensor id
+ * @param[out] *result pointer to a result buffer
+ * @note      none
+ */
+static void a_opt300x_dli_result(opt300x_dli_t *dli, uint8_t sensor, opt300x_dli_result_t *result)
+{
+    double exposure;
+    
+    exposure = (double)dli->area[sensor] * 0.5e-6 * dli->weight[sensor];          /* unit*s */
+    result->day = dli->day[sensor];                                               /* set the day */
+    result->samples = dli->samples[sensor];                                       /* set the samples */
+    result->covered_us = dli->covered_us[sensor];                                 /* set the covered time */
+    result->overflow_us = dli->overflow_us[sensor];                               /* set the overflow time */
+    result->exposure = (float)exposure;                                           /* set the exposure */
+    result->dli = (float)(exposure * dli->factor[sensor] * 1e-6);                 /* umol to mol */
+}
+
+/**
+ * @brief     close the running day of a sensor
+ * @param[in] *dli pointer to a dli structure
+ * @param[in] sensor sensor id
+ * @note      none
+ */
+static void a_opt300x_dli_close(opt300x_dli_t *dli, uint8_t sensor)
+{
+    a_opt300x_dli_result(dli, sensor, &dli->result[sensor]);          /* save the result */
+    dli->area[sensor] = 0;                                            /* clear the area */
+    dli->covered_us[sensor] = 0;                                      /* clear the time */
+    dli->overflow_us[sensor] = 0;                                     /* clear the overflow time */
+    dli->samples[sensor] = 0;                                         /* clear the samples */
+    dli->closed[sensor] = 1;                                          /* flag closed */
+    if (dli->close != NULL)                                           /* check the callback */
+    {
+        dli->close(dli, sensor);                                      /* run the callback */
+    }
+}
+
+/**
+ * @brief     update a crc32
+ * @param[in] crc crc so far
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    crc32
+ * @note      reflected 0xEDB88320, bitwise to keep the rom small
+ */
+static uint32_t a_opt300x_dli_crc32(uint32_t crc, const uint8_t *buf, uint32_t len)
+{
+    uint32_t i;
+    uint8_t j;
+    
+    crc = ~crc;                                                        /* invert */
+    for (i = 0; i < len; i++)                                          /* every byte */
+    {
+        crc ^= buf[i];                                                 /* add the byte */
+        for (j = 0; j < 8; j++)                                        /* every bit */
+        {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1)));       /* shift */
+        }
+    }
+    
+    return ~crc;                                                       /* invert */
+}
+
+/**
+ * @brief     put a little endian word
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] value word
+ * @param[in] bytes word bytes
+ * @note      none
+ */
+static void a_opt300x_dli_put(uint8_t *buf, uint64_t value, uint8_t bytes)
+{
+    uint8_t i;
+    
+    for (i = 0; i < bytes; i++)                      /* every byte */
+    {
+        buf[i] = (uint8_t)(value >> (8 * i));        /* set the byte */
+    }
+}
+
+/**
+ * @brief     get a little endian word
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] bytes word bytes
+ * @return    word
+ * @note      none
+ */
+static uint64_t a_opt300x_dli_get(const uint8_t *buf, uint8_t bytes)
+{
+    uint8_t i;
+    uint64_t value = 0;
+    
+    for (i = 0; i < bytes; i++)                      /* every byte */
+    {
+        value |= (uint64_t)buf[i] << (8 * i);        /* get the byte */
+    }
+    
+    return value;                                    /* return the word */
+}
+
+/**
+ * @brief     init a dli accumulator
+ * @param[in] *dli pointer to a dli structure
+ * @param[in] *type pointer to a chip type table, the index is the sensor id
+ * @param[in] sensor_num sensor numbers
+ * @param[in] max_gap_us longest interval between two samples that is integrated, below one day
+ * @param[in] offset_us local time minus utc, days start at local midnight
+ * @param[in] *close pointer to a close function, can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 param is invalid
+ * @note      the factor defaults to sunlight, OPT300X_DLI_LUX_FACTOR or OPT300X_DLI_IRRADIANCE_FACTOR
+ */
+uint8_t opt300x_dli_init(opt300x_dli_t *dli, const opt300x_t *type, uint8_t sensor_num,
+                         uint64_t max_gap_us, int64_t offset_us, void (*close)(opt300x_dli_t *dli, uint8_t sensor))
+{
+    uint8_t s;
+    
+    if (dli == NULL)                                                                       /* check dli */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if ((type == NULL) || (sensor_num == 0) || (sensor_num > OPT300X_DLI_MAX_SENSOR) ||
+        (max_gap_us == 0) || (max_gap_us >= OPT300X_DLI_DAY_US) ||
+        (offset_us <= -(int64_t)OPT300X_DLI_DAY_US) || (offset_us >= (int64_t)OPT300X_DLI_DAY_US))  /* check the param */
+    {
+        return 4;                                                                          /* return error */
+    }
+    
+    dli->sensor_num = sensor_num;                                                          /* set the sensor numbers */
+    dli->max_gap_us = max_gap_us;                                                          /* set the max gap */
+    dli->offset_us = offset_us;                                                            /* set the offset */
+    dli->close = close;                                                                    /* set the callback */
+    for (s = 0; s < sensor_num; s++)                                                       /* every sensor */
+    {
+        if (type[s] == OPT3002)                                                            /* opt3002 */
+        {
+            dli->weight[s] = 1.2f;                                                         /* nW/cm2 */
+            dli->factor[s] = OPT300X_DLI_IRRADIANCE_FACTOR;                                /* sunlight */
+        }
+        else if (type[s] == OPT3005)                                                       /* opt3005 */
+        {
+            dli->weight[s] = 0.02f;                                                        /* lux */
+            dli->factor[s] = OPT300X_DLI_LUX_FACTOR;                                       /* sunlight */
+        }
+        else                                                                               /* the others */
+        {
+            dli->weight[s] = 0.01f;                                                        /* lux */
+            dli->factor[s] = OPT300X_DLI_LUX_FACTOR;                                       /* sunlight */
+        }
+        dli->started[s] = 0;                                                               /* no samples */
+        dli->closed[s] = 0;                                                                /* no days */
+        dli->area[s] = 0;                                                                  /* clear the area */
+        dli->covered_us[s] = 0;                                                            /* clear the time */
+        dli->overflow_us[s] = 0;                                                           /* clear the overflow time */
+        dli->samples[s] = 0;                                                               /* clear the samples */
+    }
+    dli->inited = 1;                                                                       /* flag inited */
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     set the photon flux factor of a sensor
+ * @param[in] *dli pointer to a dli structure
+ * @param[in] sensor sensor id
+ * @param[in] factor umol/m2/s per lux or per nW/cm2 of the light source
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 sensor or factor is invalid
+ * @note      none
+ */
+uint8_t opt300x_dli_set_factor(opt300x_dli_t *dli, uint8_t sensor, float factor)
+{
+    if (dli == NULL)                                                           /* check dli */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (dli->inited != 1)                                                      /* check dli initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    if ((sensor >= dli->sensor_num) || !(factor > 0.0f))                       /* check the param */
+    {
+        return 4;                                                              /* return error */
+    }
+    
+    dli->factor[sensor] = factor;                                              /* set the factor */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     add one sample
+ * @param[in] *dli pointer to a dli structure
+ * @param[in] sensor sensor id
+ * @param[in] raw raw result word
+ * @param[in] timestamp_us utc timestamp
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 sensor or raw is invalid
+ *            - 5 timestamp is before the last sample
+ * @note      the interval to the last sample is integrated as a trapezoid and split at midnight,
+ *            an interval longer than max_gap_us is a gap, full scale samples count as overflow time
+ */
+uint8_t opt300x_dli_push(opt300x_dli_t *dli, uint8_t sensor, uint16_t raw, uint64_t timestamp_us)
+{
+    uint8_t overflow;
+    uint8_t integrate;
+    uint32_t day;
+    uint32_t c0;
+    uint32_t c1;
+    uint64_t t0;
+    
+    if (dli == NULL)                                                                       /* check dli */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (dli->inited != 1)                                                                  /* check dli initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    if ((sensor >= dli->sensor_num) || ((raw >> 12) > 11))                                 /* check the sensor and exponent */
+    {
+        return 4;                                                                          /* return error */
+    }
+    
+    c1 = (uint32_t)(raw & 0x0FFF) << (raw >> 12);                                          /* lsb counts */
+    day = a_opt300x_dli_day(dli, timestamp_us);                                            /* local day */
+    if (dli->started[sensor] == 0)                                                         /* first sample */
+    {
+        dli->day[sensor] = day;                                                            /* start the day */
+        dli->started[sensor] = 1;                                                          /* flag started */
+    }
+    else
+    {
+        if (timestamp_us < dli->last_us[sensor])                                           /* late sample */
+        {
+            return 5;                                                                      /* return error */
+        }
+        t0 = dli->last_us[sensor];                                                         /* interval start */
+        c0 = dli->last_counts[sensor];                                                     /* start counts */
+        integrate = ((timestamp_us - t0) <= dli->max_gap_us) ? 1 : 0;                      /* gap check */
+        overflow = ((c0 >= OPT300X_DLI_FULL_SCALE) || (c1 >= OPT300X_DLI_FULL_SCALE)) ? 1 : 0;
+        while (dli->day[sensor] < day)                                                     /* midnight passed */
+        {
+            if (integrate != 0)                                                            /* split the interval */
+            {
+                uint64_t b = (uint64_t)((int64_t)(dli->day[sensor] + 1) * (int64_t)OPT300X_DLI_DAY_US
+                                        - dli->offset_us);
+                uint32_t cb = (uint32_t)((int64_t)c0 + ((int64_t)c1 - (int64_t)c0) * (int64_t)(b - t0)
+                                         / (int64_t)(timestamp_us - t0));
+                
+                a_opt300x_dli_add(dli, sensor, t0, c0, b, cb, overflow);                   /* until midnight */
+                t0 = b;                                                                    /* new start */
+                c0 = cb;                                                                   /* interpolated counts */
+            }
+            a_opt300x_dli_close(dli, sensor);                                              /* close the day */
+            dli->day[sensor] = (integrate != 0) ? (dli->day[sensor] + 1) : day;            /* skip the empty days */
+        }
+        if (integrate != 0)                                                                /* no gap */
+        {
+            a_opt300x_dli_add(dli, sensor, t0, c0, timestamp_us, c1, overflow);            /* add the interval */
+        }
+    }
+    dli->last_us[sensor] = timestamp_us;                                                   /* save the timestamp */
+    dli->last_counts[sensor] = c1;                                                         /* save the counts */
+    dli->samples[sensor]++;                                                                /* add the sample */
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     read a sensor and add the sample
+ * @param[in] *dli pointer to a dli structure
+ * @param[in] sensor sensor id
+ * @param[in] *handle pointer to an opt300x handle structure in continuous mode
+ * @param[in] timestamp_us utc timestamp
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 sensor or raw is invalid
+ *            - 5 timestamp is before the last sample
+ * @note      the timestamp is passed in since the days need the wall clock,
+ *            an overflowed read is pushed as full scale so it counts as overflow time
+ */
+uint8_t opt300x_dli_read_push(opt300x_dli_t *dli, uint8_t sensor, opt300x_handle_t *handle, uint64_t timestamp_us)
+{
+    uint8_t res;
+    uint16_t raw;
+    float data;
+    
+    if ((dli == NULL) || (handle == NULL))                                     /* check dli and handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if ((dli->inited != 1) || (handle->inited != 1))                           /* check initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    
+    if (handle->type == (uint8_t)OPT3002)                                      /* opt3002 */
+    {
+        res = opt3002_continuous_read(handle, &raw, &data);                    /* read nW/cm2 */
+    }
+    else                                                                       /* the others */
+    {
+        res = opt300x_continuous_read(handle, &raw, &data);                    /* read lux */
+    }
+    if (res == 4)                                                              /* overflow */
+    {
+        raw = OPT300X_DLI_FULL_SCALE_RAW;                                      /* count it as full scale */
+    }
+    else if (res != 0)                                                         /* check the result */
+    {
+        return 1;                                                              /* return error */
+    }
+    
+    return opt300x_dli_push(dli, sensor, raw, timestamp_us);                   /* add the sample */
+}
+
+/**
+ * @brief      get the last closed day of a sensor
+ * @param[in]  *dli pointer to a dli structure
+ * @param[in]  sensor sensor id
+ * @param[out] *result pointer to a result buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ *             - 4 sensor is invalid
+ *             - 5 no day is closed
+ * @note       none
+ */
+uint8_t opt300x_dli_get_result(opt300x_dli_t *dli, uint8_t sensor, opt300x_dli_result_t *result)
+{
+    if ((dli == NULL) || (result == NULL))                                     /* check dli and result */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (dli->inited != 1)                                                      /* check dli initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    if (sensor >= dli->sensor_num)                                             /* check the sensor */
+    {
+        return 4;                                                              /* return error */
+    }
+    if (dli->closed[sensor] == 0)                                              /* check the day */
+    {
+        return 5;                                                              /* return error */
+    }
+    
+    *result = dli->result[sensor];                                             /* copy the result */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get the running day of a sensor
+ * @param[in]  *dli pointer to a dli structure
+ * @param[in]  sensor sensor id
+ * @param[out] *result pointer to a result buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ *             - 4 sensor is invalid
+ *             - 5 no sample yet
+ * @note       integrated up to the last sample
+ */
+uint8_t opt300x_dli_get_running(opt300x_dli_t *dli, uint8_t sensor, opt300x_dli_result_t *result)
+{
+    if ((dli == NULL) || (result == NULL))                                     /* check dli and result */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (dli->inited != 1)                                                      /* check dli initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    if (sensor >= dli->sensor_num)                                             /* check the sensor */
+    {
+        return 4;                                                              /* return error */
+    }
+    if (dli->started[sensor] == 0)                                             /* check the samples */
+    {
+        return 5;                                                              /* return error */
+    }
+    
+    a_opt300x_dli_result(dli, sensor, result);                                 /* fill the result */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      save the running state
+ * @param[in]  *dli pointer to a dli structure
+ * @param[out] *buf pointer to a checkpoint buffer
+ * @param[in]  size buffer size
+ * @param[out] *len pointer to a checkpoint length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ *             - 4 buffer is too small
+ * @note       OPT300X_DLI_CHECKPOINT_SIZE(sensor_num) bytes, little endian with a crc32, portable between targets
+ */
+uint8_t opt300x_dli_checkpoint(opt300x_dli_t *dli, uint8_t *buf, uint32_t size, uint32_t *len)
+{
+    uint8_t s;
+    uint8_t *p;
+    
+    if ((dli == NULL) || (buf == NULL) || (len == NULL))                                   /* check dli and the buffers */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (dli->inited != 1)                                                                  /* check dli initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    if (size < OPT300X_DLI_CHECKPOINT_SIZE(dli->sensor_num))                               /* check the size */
+    {
+        return 4;                                                                          /* return error */
+    }
+    
+    a_opt300x_dli_put(buf, OPT300X_DLI_MAGIC, 4);                                          /* set the magic */
+    buf[4] = OPT300X_DLI_VERSION;                                                          /* set the version */
+    buf[5] = dli->sensor_num;                                                              /* set the sensor numbers */
+    buf[6] = 0;                                                                            /* reserved */
+    buf[7] = 0;                                                                            /* reserved */
+    p = buf + 8;                                                                           /* first sensor */
+    for (s = 0; s < dli->sensor_num; s++)                                                  /* every sensor */
+    {
+        p[0] = dli->started[s];                                                            /* set the flag */
+        p[1] = 0;                                                                          /* reserved */
+        p[2] = 0;                                                                          /* reserved */
+        p[3] = 0;                                                                          /* reserved */
+        a_opt300x_dli_put(p + 4, dli->day[s], 4);                                          /* set the day */
+        a_opt300x_dli_put(p + 8, dli->last_us[s], 8);                                      /* set the last timestamp */
+        a_opt300x_dli_put(p + 16, dli->last_counts[s], 4);                                 /* set the last counts */
+        a_opt300x_dli_put(p + 20, dli->samples[s], 4);                                     /* set the samples */
+        a_opt300x_dli_put(p + 24, dli->area[s], 8);                                        /* set the area */
+        a_opt300x_dli_put(p + 32, dli->covered_us[s], 8);                                  /* set the covered time */
+        a_opt300x_dli_put(p + 40, dli->overflow_us[s], 8);                                 /* set the overflow time */
+        p += 48;                                                                           /* next sensor */
+    }
+    a_opt300x_dli_put(p, a_opt300x_dli_crc32(0, buf, (uint32_t)(p - buf)), 4);             /* set the crc */
+    *len = OPT300X_DLI_CHECKPOINT_SIZE(dli->sensor_num);                                   /* set the length */
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     restore the running state
+ * @param[in] *dli pointer to an inited dli structure
+ * @param[in] *buf pointer to a checkpoint
+ * @param[in] len checkpoint length
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 checkpoint is invalid
+ *            - 5 checkpoint has other sensor numbers
+ * @note      the interval from the checkpointed last sample to the next sample follows the gap rule
+ */
+uint8_t opt300x_dli_restore(opt300x_dli_t *dli, const uint8_t *buf, uint32_t len)
+{
+    uint8_t s;
+    const uint8_t *p;
+    
+    if ((dli == NULL) || (buf == NULL))                                                    /* check dli and the buffer */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (dli->inited != 1)                                                                  /* check dli initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    if ((len < OPT300X_DLI_CHECKPOINT_SIZE(1)) ||
+        (a_opt300x_dli_get(buf, 4) != OPT300X_DLI_MAGIC) || (buf[4] != OPT300X_DLI_VERSION) ||
+        (len != OPT300X_DLI_CHECKPOINT_SIZE(buf[5])) ||
+        (a_opt300x_dli_get(buf + len - 4, 4) != a_opt300x_dli_crc32(0, buf, len - 4)))     /* check the checkpoint */
+    {
+        return 4;                                                                          /* return error */
+    }
+    if (buf[5] != dli->sensor_num)                                                         /* check the sensor numbers */
+    {
+        return 5;                                                                          /* return error */
+    }
+    
+    p = buf + 8;                                                                           /* first sensor */
+    for (s = 0; s < dli->sensor_num; s++)                                                  /* every sensor */
+    {
+        dli->started[s] = (p[0] != 0) ? 1 : 0;                                             /* get the flag */
+        dli->day[s] = (uint32_t)a_opt300x_dli_get(p + 4, 4);                               /* get the day */
+        dli->last_us[s] = a_opt300x_dli_get(p + 8, 8);                                     /* get the last timestamp */
+        dli->last_counts[s] = (uint32_t)a_opt300x_dli_get(p + 16, 4);                      /* get the last counts */
+        dli->samples[s] = (uint32_t)a_opt300x_dli_get(p + 20, 4);                          /* get the samples */
+        dli->area[s] = a_opt300x_dli_get(p + 24, 8);                                       /* get the area */
+        dli->covered_us[s] = a_opt300x_dli_get(p + 32, 8);                                 /* get the covered time */
+        dli->overflow_us[s] = a_opt300x_dli_get(p + 40, 8);                                /* get the overflow time */
+        p += 48;                                                                           /* next sensor */
+    }
+    
+    return 0;                                                                              /* success return 0 */
+}
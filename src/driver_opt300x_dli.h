@@ -0,0 +1,241 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_dli.h
+ * @brief     driver opt300x dli header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_OPT300X_DLI_H
+#define DRIVER_OPT300X_DLI_H
+
+#include "driver_opt300x.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup opt300x_dli_driver opt300x dli driver function
+ * @brief    opt300x dli driver modules
+ * @ingroup  opt300x_driver
+ * @{
+ */
+
+/**
+ * @brief dli max sensor numbers
+ * @note  all memory is static, override it at compile time to fit the target
+ */
+#ifndef OPT300X_DLI_MAX_SENSOR
+    #define OPT300X_DLI_MAX_SENSOR 8        /**< 8 sensors */
+#endif
+
+/**
+ * @brief dli definition
+ */
+#define OPT300X_DLI_DAY_US                  86400000000ULL                      /**< one day */
+#define OPT300X_DLI_LUX_FACTOR              0.0185f                             /**< umol/m2/s per lux in sunlight */
+#define OPT300X_DLI_IRRADIANCE_FACTOR       0.0206f                             /**< umol/m2/s per nW/cm2 in sunlight */
+#define OPT300X_DLI_CHECKPOINT_SIZE(n)      (12 + 48 * (uint32_t)(n))           /**< checkpoint bytes of n sensors */
+
+/**
+ * @brief opt300x dli result structure definition
+ */
+typedef struct opt300x_dli_result_s
+{
+    uint32_t day;                /**< local day number since the epoch */
+    uint32_t samples;            /**< samples of the day */
+    uint64_t covered_us;         /**< integrated time, the rest of the day is a gap */
+    uint64_t overflow_us;        /**< integrated time at full scale, a lower bound */
+    float exposure;              /**< lux*s or nW/cm2*s */
+    float dli;                   /**< mol/m2 */
+} opt300x_dli_result_t;
+
+/**
+ * @brief opt300x dli structure definition
+ * @note  constant memory per sensor, the samples are integrated as lsb counts in exact integers
+ */
+typedef struct opt300x_dli_s
+{
+    uint8_t inited;                                                    /**< inited flag */
+    uint8_t sensor_num;                                                /**< sensor numbers */
+    uint64_t max_gap_us;                                               /**< longest interval integrated */
+    int64_t offset_us;                                                 /**< local time offset */
+    float weight[OPT300X_DLI_MAX_SENSOR];                              /**< lsb weight */
+    float factor[OPT300X_DLI_MAX_SENSOR];                              /**< umol/m2/s per unit */
+    uint8_t started[OPT300X_DLI_MAX_SENSOR];                           /**< first sample flag */
+    uint32_t day[OPT300X_DLI_MAX_SENSOR];                              /**< running day */
+    uint64_t last_us[OPT300X_DLI_MAX_SENSOR];                          /**< last sample timestamp */
+    uint32_t last_counts[OPT300X_DLI_MAX_SENSOR];                      /**< last sample lsb counts */
+    uint32_t samples[OPT300X_DLI_MAX_SENSOR];                          /**< running day samples */
+    uint64_t area[OPT300X_DLI_MAX_SENSOR];                             /**< running day twice the lsb counts x us */
+    uint64_t covered_us[OPT300X_DLI_MAX_SENSOR];                       /**< running day integrated time */
+    uint64_t overflow_us[OPT300X_DLI_MAX_SENSOR];                      /**< running day time at full scale */
+    uint8_t closed[OPT300X_DLI_MAX_SENSOR];                            /**< closed day flag */
+    opt300x_dli_result_t result[OPT300X_DLI_MAX_SENSOR];               /**< last closed day */
+    void (*close)(struct opt300x_dli_s *dli, uint8_t sensor);          /**< point to a close function address */
+} opt300x_dli_t;
+
+/**
+ * @brief     init a dli accumulator
+ * @param[in] *dli pointer to a dli structure
+ * @param[in] *type pointer to a chip type table, the index is the sensor id
+ * @param[in] sensor_num sensor numbers
+ * @param[in] max_gap_us longest interval between two samples that is integrated, below one day
+ * @param[in] offset_us local time minus utc, days start at local midnight
+ * @param[in] *close pointer to a close function, can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 param is invalid
+ * @note      the factor defaults to sunlight, OPT300X_DLI_LUX_FACTOR or OPT300X_DLI_IRRADIANCE_FACTOR
+ */
+uint8_t opt300x_dli_init(opt300x_dli_t *dli, const opt300x_t *type, uint8_t sensor_num,
+                         uint64_t max_gap_us, int64_t offset_us, void (*close)(opt300x_dli_t *dli, uint8_t sensor));
+
+/**
+ * @brief     set the photon flux factor of a sensor
+ * @param[in] *dli pointer to a dli structure
+ * @param[in] sensor sensor id
+ * @param[in] factor umol/m2/s per lux or per nW/cm2 of the light source
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 sensor or factor is invalid
+ * @note      none
+ */
+uint8_t opt300x_dli_set_factor(opt300x_dli_t *dli, uint8_t sensor, float factor);
+
+/**
+ * @brief     add one sample
+ * @param[in] *dli pointer to a dli structure
+ * @param[in] sensor sensor id
+ * @param[in] raw raw result word
+ * @param[in] timestamp_us utc timestamp
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 sensor or raw is invalid
+ *            - 5 timestamp is before the last sample
+ * @note      the interval to the last sample is integrated as a trapezoid and split at midnight,
+ *            an interval longer than max_gap_us is a gap, full scale samples count as overflow time
+ */
+uint8_t opt300x_dli_push(opt300x_dli_t *dli, uint8_t sensor, uint16_t raw, uint64_t timestamp_us);
+
+/**
+ * @brief     read a sensor and add the sample
+ * @param[in] *dli pointer to a dli structure
+ * @param[in] sensor sensor id
+ * @param[in] *handle pointer to an opt300x handle structure in continuous mode
+ * @param[in] timestamp_us utc timestamp
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 sensor or raw is invalid
+ *            - 5 timestamp is before the last sample
+ * @note      the timestamp is passed in since the days need the wall clock,
+ *            an overflowed read is pushed as full scale so it counts as overflow time
+ */
+uint8_t opt300x_dli_read_push(opt300x_dli_t *dli, uint8_t sensor, opt300x_handle_t *handle, uint64_t timestamp_us);
+
+/**
+ * @brief      get the last closed day of a sensor
+ * @param[in]  *dli pointer to a dli structure
+ * @param[in]  sensor sensor id
+ * @param[out] *result pointer to a result buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ *             - 4 sensor is invalid
+ *             - 5 no day is closed
+ * @note       none
+ */
+uint8_t opt300x_dli_get_result(opt300x_dli_t *dli, uint8_t sensor, opt300x_dli_result_t *result);
+
+/**
+ * @brief      get the running day of a sensor
+ * @param[in]  *dli pointer to a dli structure
+ * @param[in]  sensor sensor id
+ * @param[out] *result pointer to a result buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ *             - 4 sensor is invalid
+ *             - 5 no sample yet
+ * @note       integrated up to the last sample
+ */
+uint8_t opt300x_dli_get_running(opt300x_dli_t *dli, uint8_t sensor, opt300x_dli_result_t *result);
+
+/**
+ * @brief      save the running state
+ * @param[in]  *dli pointer to a dli structure
+ * @param[out] *buf pointer to a checkpoint buffer
+ * @param[in]  size buffer size
+ * @param[out] *len pointer to a checkpoint length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ *             - 4 buffer is too small
+ * @note       OPT300X_DLI_CHECKPOINT_SIZE(sensor_num) bytes, little endian with a crc32, portable between targets
+ */
+uint8_t opt300x_dli_checkpoint(opt300x_dli_t *dli, uint8_t *buf, uint32_t size, uint32_t *len);
+
+/**
+ * @brief     restore the running state
+ * @param[in] *dli pointer to an inited dli structure
+ * @param[in] *buf pointer to a checkpoint
+ * @param[in] len checkpoint length
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 checkpoint is invalid
+ *            - 5 checkpoint has other sensor numbers
+ * @note      the interval from the checkpointed last sample to the next sample follows the gap rule
+ */
+uint8_t opt300x_dli_restore(opt300x_dli_t *dli, const uint8_t *buf, uint32_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
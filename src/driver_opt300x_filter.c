@@ -0,0 +1,631 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_filter.c
+ * @brief     driver opt300x filter source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_opt300x_filter.h"
+
+/**
+ * @brief     get the lsb weight of a chip
+ * @param[in] type chip type
+ * @return    lux or nW/cm2 of one lsb count
+ * @note      none
+ */
+static float a_opt300x_filter_weight(opt300x_t type)
+{
+    if (type == OPT3002)              /* opt3002 */
+    {
+        return 1.2f;                  /* nW/cm2 */
+    }
+    else if (type == OPT3005)         /* opt3005 */
+    {
+        return 0.02f;                 /* lux */
+    }
+    else                              /* the others */
+    {
+        return 0.01f;                 /* lux */
+    }
+}
+
+/**
+ * @brief     compare and exchange two tap rows
+ * @param[in] *a pointer to the row keeping the min
+ * @param[in] *b pointer to the row keeping the max
+ * @param[in] sensor_num sensor numbers
+ * @note      branchless, compiles to vector min and max
+ */
+static void a_opt300x_filter_exchange(float *a, float *b, uint16_t sensor_num)
+{
+    uint32_t s;
+    
+    for (s = 0; s < sensor_num; s++)                  /* every sensor */
+    {
+        float x = a[s];
+        float y = b[s];
+        float lo = (x < y) ? x : y;
+        float hi = (x < y) ? y : x;
+        
+        a[s] = lo;                                    /* min */
+        b[s] = hi;                                    /* max */
+    }
+}
+
+/**
+ * @brief     init an exponential moving average
+ * @param[in] *ema pointer to an ema structure
+ * @param[in] sensor_num sensor numbers
+ * @param[in] alpha smoothing factor in (0, 1]
+ * @param[in] *buffer pointer to a state buffer
+ * @param[in] len buffer length in floats
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 param is invalid or the buffer is too small
+ * @note      the buffer needs OPT300X_FILTER_EMA_BUFFER(sensor_num) floats
+ */
+uint8_t opt300x_filter_ema_init(opt300x_filter_ema_t *ema, uint16_t sensor_num, float alpha, float *buffer, uint32_t len)
+{
+    if (ema == NULL)                                                                   /* check ema */
+    {
+        return 2;                                                                      /* return error */
+    }
+    if ((sensor_num == 0) || !(alpha > 0.0f) || (alpha > 1.0f) || (buffer == NULL) ||
+        (len < OPT300X_FILTER_EMA_BUFFER(sensor_num)))                                 /* check the param */
+    {
+        return 4;                                                                      /* return error */
+    }
+    
+    ema->sensor_num = sensor_num;                                                      /* set the sensor numbers */
+    ema->alpha = alpha;                                                                /* set the factor */
+    ema->state = buffer;                                                               /* set the state */
+    ema->started = 0;                                                                  /* no samples */
+    ema->inited = 1;                                                                   /* flag inited */
+    
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief      filter one sample of every sensor
+ * @param[in]  *ema pointer to an ema structure
+ * @param[in]  *in pointer to the samples, [sensor]
+ * @param[out] *out pointer to the outputs, [sensor], can be in
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ * @note       the first call starts every sensor at its sample
+ */
+uint8_t opt300x_filter_ema_run(opt300x_filter_ema_t *ema, const float *in, float *out)
+{
+    uint32_t s;
+    float alpha;
+    float *state;
+    
+    if ((ema == NULL) || (in == NULL) || (out == NULL))              /* check ema and the buffers */
+    {
+        return 2;                                                    /* return error */
+    }
+    if (ema->inited != 1)                                            /* check ema initialization */
+    {
+        return 3;                                                    /* return error */
+    }
+    
+    state = ema->state;                                              /* get the state */
+    alpha = ema->alpha;                                              /* get the factor */
+    if (ema->started == 0)                                           /* first sample */
+    {
+        for (s = 0; s < ema->sensor_num; s++)                        /* every sensor */
+        {
+            state[s] = in[s];                                        /* start at the sample */
+        }
+        ema->started = 1;                                            /* flag started */
+    }
+    for (s = 0; s < ema->sensor_num; s++)                            /* every sensor */
+    {
+        state[s] += alpha * (in[s] - state[s]);                      /* smooth */
+        out[s] = state[s];                                           /* set the output */
+    }
+    
+    return 0;                                                        /* success return 0 */
+}
+
+/**
+ * @brief     init a boxcar moving average
+ * @param[in] *boxcar pointer to a boxcar structure
+ * @param[in] sensor_num sensor numbers
+ * @param[in] taps averaged samples
+ * @param[in] *buffer pointer to a state buffer
+ * @param[in] len buffer length in floats
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 param is invalid or the buffer is too small
+ * @note      the buffer needs OPT300X_FILTER_BOXCAR_BUFFER(sensor_num, taps) floats
+ */
+uint8_t opt300x_filter_boxcar_init(opt300x_filter_boxcar_t *boxcar, uint16_t sensor_num, uint16_t taps,
+                                   float *buffer, uint32_t len)
+{
+    if (boxcar == NULL)                                                                /* check boxcar */
+    {
+        return 2;                                                                      /* return error */
+    }
+    if ((sensor_num == 0) || (taps == 0) || (buffer == NULL) ||
+        (len < OPT300X_FILTER_BOXCAR_BUFFER(sensor_num, taps)))                        /* check the param */
+    {
+        return 4;                                                                      /* return error */
+    }
+    
+    boxcar->sensor_num = sensor_num;                                                   /* set the sensor numbers */
+    boxcar->taps = taps;                                                               /* set the taps */
+    boxcar->history = buffer;                                                          /* set the history */
+    boxcar->sum = buffer + (uint32_t)sensor_num * taps;                                /* set the sums */
+    boxcar->head = 0;                                                                  /* first tap */
+    boxcar->started = 0;                                                               /* no samples */
+    boxcar->inited = 1;                                                                /* flag inited */
+    
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief      filter one sample of every sensor
+ * @param[in]  *boxcar pointer to a boxcar structure
+ * @param[in]  *in pointer to the samples, [sensor]
+ * @param[out] *out pointer to the outputs, [sensor], can be in
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ * @note       O(1) per sensor with a running sum, the sum is rebuilt once per lap so float errors don't add up
+ */
+uint8_t opt300x_filter_boxcar_run(opt300x_filter_boxcar_t *boxcar, const float *in, float *out)
+{
+    uint32_t s;
+    uint32_t t;
+    uint32_t n;
+    float inv;
+    float *row;
+    float *sum;
+    
+    if ((boxcar == NULL) || (in == NULL) || (out == NULL))                           /* check boxcar and the buffers */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (boxcar->inited != 1)                                                         /* check boxcar initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    
+    n = boxcar->sensor_num;                                                          /* sensor numbers */
+    sum = boxcar->sum;                                                               /* get the sums */
+    if (boxcar->started == 0)                                                        /* first sample */
+    {
+        for (t = 0; t < boxcar->taps; t++)                                           /* fill the history */
+        {
+            row = boxcar->history + t * n;                                           /* tap row */
+            for (s = 0; s < n; s++)                                                  /* every sensor */
+            {
+                row[s] = in[s];                                                      /* set the sample */
+            }
+        }
+        for (s = 0; s < n; s++)                                                      /* every sensor */
+        {
+            sum[s] = in[s] * (float)boxcar->taps;                                    /* set the sum */
+        }
+        boxcar->started = 1;                                                         /* flag started */
+    }
+    inv = 1.0f / (float)boxcar->taps;                                                /* average factor */
+    row = boxcar->history + (uint32_t)boxcar->head * n;                              /* oldest tap */
+    for (s = 0; s < n; s++)                                                          /* every sensor */
+    {
+        float x = in[s];
+        
+        sum[s] += x - row[s];                                                        /* replace the oldest */
+        row[s] = x;                                                                  /* save the sample */
+        out[s] = sum[s] * inv;                                                       /* set the output */
+    }
+    boxcar->head++;                                                                  /* next tap */
+    if (boxcar->head == boxcar->taps)                                                /* one lap */
+    {
+        boxcar->head = 0;                                                            /* first tap */
+        for (s = 0; s < n; s++)                                                      /* every sensor */
+        {
+            sum[s] = 0.0f;                                                           /* clear the sum */
+        }
+        for (t = 0; t < boxcar->taps; t++)                                           /* rebuild the sums */
+        {
+            row = boxcar->history + t * n;                                           /* tap row */
+            for (s = 0; s < n; s++)                                                  /* every sensor */
+            {
+                sum[s] += row[s];                                                    /* add the sample */
+            }
+        }
+    }
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     init a median of n
+ * @param[in] *median pointer to a median structure
+ * @param[in] sensor_num sensor numbers
+ * @param[in] taps odd taps, 3 to OPT300X_FILTER_MEDIAN_MAX_TAPS
+ * @param[in] *buffer pointer to a state buffer
+ * @param[in] len buffer length in floats
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 param is invalid or the buffer is too small
+ * @note      the buffer needs OPT300X_FILTER_MEDIAN_BUFFER(sensor_num, taps) floats
+ */
+uint8_t opt300x_filter_median_init(opt300x_filter_median_t *median, uint16_t sensor_num, uint16_t taps,
+                                   float *buffer, uint32_t len)
+{
+    if (median == NULL)                                                                /* check median */
+    {
+        return 2;                                                                      /* return error */
+    }
+    if ((sensor_num == 0) || (taps < 3) || (taps > OPT300X_FILTER_MEDIAN_MAX_TAPS) ||
+        ((taps & 1) == 0) || (buffer == NULL) ||
+        (len < OPT300X_FILTER_MEDIAN_BUFFER(sensor_num, taps)))                        /* check the param */
+    {
+        return 4;                                                                      /* return error */
+    }
+    
+    median->sensor_num = sensor_num;                                                   /* set the sensor numbers */
+    median->taps = taps;                                                               /* set the taps */
+    median->history = buffer;                                                          /* set the history */
+    median->work = buffer + (uint32_t)sensor_num * taps;                               /* set the sort rows */
+    median->head = 0;                                                                  /* first tap */
+    median->started = 0;                                                               /* no samples */
+    median->inited = 1;                                                                /* flag inited */
+    
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief      filter one sample of every sensor
+ * @param[in]  *median pointer to a median structure
+ * @param[in]  *in pointer to the samples, [sensor]
+ * @param[out] *out pointer to the outputs, [sensor], can be in
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ * @note       a branchless sorting network of min and max runs over whole tap rows
+ */
+uint8_t opt300x_filter_median_run(opt300x_filter_median_t *median, const float *in, float *out)
+{
+    uint32_t s;
+    uint32_t t;
+    uint32_t i;
+    uint32_t n;
+    float *row;
+    
+    if ((median == NULL) || (in == NULL) || (out == NULL))                           /* check median and the buffers */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (median->inited != 1)                                                         /* check median initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    
+    n = median->sensor_num;                                                          /* sensor numbers */
+    if (median->started == 0)                                                        /* first sample */
+    {
+        for (t = 0; t < median->taps; t++)                                           /* fill the history */
+        {
+            row = median->history + t * n;                                           /* tap row */
+            for (s = 0; s < n; s++)                                                  /* every sensor */
+            {
+                row[s] = in[s];                                                      /* set the sample */
+            }
+        }
+        median->started = 1;                                                         /* flag started */
+    }
+    row = median->history + (uint32_t)median->head * n;                              /* oldest tap */
+    for (s = 0; s < n; s++)                                                          /* every sensor */
+    {
+        row[s] = in[s];                                                              /* replace the oldest */
+    }
+    median->head = (uint16_t)((median->head + 1 == median->taps) ? 0 : (median->head + 1));
+    for (s = 0; s < (uint32_t)median->taps * n; s++)                                 /* copy the history */
+    {
+        median->work[s] = median->history[s];                                        /* tap order doesn't matter */
+    }
+    for (t = 0; t < median->taps; t++)                                               /* odd even transposition passes */
+    {
+        for (i = t & 1; i + 1 < median->taps; i += 2)                                /* every pair */
+        {
+            a_opt300x_filter_exchange(median->work + i * n, median->work + (i + 1) * n,
+                                      median->sensor_num);                           /* order the rows */
+        }
+    }
+    row = median->work + (uint32_t)(median->taps / 2) * n;                           /* middle row */
+    for (s = 0; s < n; s++)                                                          /* every sensor */
+    {
+        out[s] = row[s];                                                             /* set the output */
+    }
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     init a decimating fir
+ * @param[in] *fir pointer to a fir structure
+ * @param[in] sensor_num sensor numbers
+ * @param[in] *coef pointer to the coefficients, kept by reference
+ * @param[in] taps coefficient numbers
+ * @param[in] decimation one output every decimation samples
+ * @param[in] *buffer pointer to a state buffer
+ * @param[in] len buffer length in floats
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 param is invalid or the buffer is too small
+ * @note      the buffer needs OPT300X_FILTER_FIR_BUFFER(sensor_num, taps) floats
+ */
+uint8_t opt300x_filter_fir_init(opt300x_filter_fir_t *fir, uint16_t sensor_num, const float *coef, uint16_t taps,
+                                uint16_t decimation, float *buffer, uint32_t len)
+{
+    if (fir == NULL)                                                                   /* check fir */
+    {
+        return 2;                                                                      /* return error */
+    }
+    if ((sensor_num == 0) || (coef == NULL) || (taps == 0) || (decimation == 0) ||
+        (buffer == NULL) || (len < OPT300X_FILTER_FIR_BUFFER(sensor_num, taps)))       /* check the param */
+    {
+        return 4;                                                                      /* return error */
+    }
+    
+    fir->sensor_num = sensor_num;                                                      /* set the sensor numbers */
+    fir->coef = coef;                                                                  /* set the coefficients */
+    fir->taps = taps;                                                                  /* set the taps */
+    fir->decimation = decimation;                                                      /* set the decimation */
+    fir->history = buffer;                                                             /* set the history */
+    fir->head = 0;                                                                     /* first tap */
+    fir->phase = 0;                                                                    /* no samples */
+    fir->started = 0;                                                                  /* no samples */
+    fir->inited = 1;                                                                   /* flag inited */
+    
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief      filter one sample of every sensor
+ * @param[in]  *fir pointer to a fir structure
+ * @param[in]  *in pointer to the samples, [sensor]
+ * @param[out] *out pointer to the outputs, [sensor], can be in
+ * @param[out] *ready pointer to a ready buffer, 1 when out holds an output
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ * @note       the taps are only summed for the kept outputs
+ */
+uint8_t opt300x_filter_fir_run(opt300x_filter_fir_t *fir, const float *in, float *out, uint8_t *ready)
+{
+    uint32_t s;
+    uint32_t k;
+    uint32_t n;
+    uint32_t tap;
+    float *row;
+    
+    if ((fir == NULL) || (in == NULL) || (out == NULL) || (ready == NULL))           /* check fir and the buffers */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (fir->inited != 1)                                                            /* check fir initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    
+    n = fir->sensor_num;                                                             /* sensor numbers */
+    if (fir->started == 0)                                                           /* first sample */
+    {
+        for (k = 0; k < fir->taps; k++)                                              /* fill the history */
+        {
+            row = fir->history + k * n;                                              /* tap row */
+            for (s = 0; s < n; s++)                                                  /* every sensor */
+            {
+                row[s] = in[s];                                                      /* set the sample */
+            }
+        }
+        fir->started = 1;                                                            /* flag started */
+    }
+    fir->head = (uint16_t)((fir->head + 1 == fir->taps) ? 0 : (fir->head + 1));      /* next tap */
+    row = fir->history + (uint32_t)fir->head * n;                                    /* newest tap */
+    for (s = 0; s < n; s++)                                                          /* every sensor */
+    {
+        row[s] = in[s];                                                              /* save the sample */
+    }
+    fir->phase++;                                                                    /* one more sample */
+    if (fir->phase < fir->decimation)                                                /* dropped output */
+    {
+        *ready = 0;                                                                  /* no output */
+        
+        return 0;                                                                    /* success return 0 */
+    }
+    fir->phase = 0;                                                                  /* restart */
+    for (s = 0; s < n; s++)                                                          /* every sensor */
+    {
+        out[s] = 0.0f;                                                               /* clear the output */
+    }
+    tap = fir->head;                                                                 /* newest tap */
+    for (k = 0; k < fir->taps; k++)                                                  /* every coefficient */
+    {
+        float c = fir->coef[k];
+        
+        row = fir->history + tap * n;                                                /* tap row */
+        for (s = 0; s < n; s++)                                                      /* every sensor */
+        {
+            out[s] += c * row[s];                                                    /* multiply and add */
+        }
+        tap = (tap == 0) ? (uint32_t)(fir->taps - 1) : (tap - 1);                    /* older tap */
+    }
+    *ready = 1;                                                                      /* output ready */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     init a decimating cic
+ * @param[in] *cic pointer to a cic structure
+ * @param[in] *type pointer to a chip type table, [sensor], kept by reference
+ * @param[in] sensor_num sensor numbers
+ * @param[in] order stages, 1 to OPT300X_FILTER_CIC_MAX_ORDER
+ * @param[in] decimation one output every decimation samples
+ * @param[in] *buffer pointer to a state buffer
+ * @param[in] len buffer length in uint64_t
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 param is invalid or the buffer is too small
+ * @note      the buffer needs OPT300X_FILTER_CIC_BUFFER(sensor_num, order) uint64_t
+ */
+uint8_t opt300x_filter_cic_init(opt300x_filter_cic_t *cic, const opt300x_t *type, uint16_t sensor_num,
+                                uint8_t order, uint16_t decimation, uint64_t *buffer, uint32_t len)
+{
+    uint8_t i;
+    uint32_t s;
+    uint64_t gain;
+    
+    if (cic == NULL)                                                                   /* check cic */
+    {
+        return 2;                                                                      /* return error */
+    }
+    if ((type == NULL) || (sensor_num == 0) || (order == 0) || (order > OPT300X_FILTER_CIC_MAX_ORDER) ||
+        (decimation == 0) || (buffer == NULL) ||
+        (len < OPT300X_FILTER_CIC_BUFFER(sensor_num, order)))                          /* check the param */
+    {
+        return 4;                                                                      /* return error */
+    }
+    gain = 1;                                                                          /* dc gain */
+    for (i = 0; i < order; i++)                                                        /* decimation ^ order */
+    {
+        gain *= decimation;                                                            /* one stage */
+        if (gain > (1ULL << 41))                                                       /* 23 bits counts must fit 64 bits */
+        {
+            return 4;                                                                  /* return error */
+        }
+    }
+    
+    cic->type = type;                                                                  /* set the type table */
+    cic->sensor_num = sensor_num;                                                      /* set the sensor numbers */
+    cic->order = order;                                                                /* set the order */
+    cic->decimation = decimation;                                                      /* set the decimation */
+    cic->gain = 1.0f / (float)gain;                                                    /* set the gain */
+    cic->integrator = buffer;                                                          /* set the integrators */
+    cic->comb = buffer + (uint32_t)sensor_num * order;                                 /* set the comb delays */
+    for (s = 0; s < OPT300X_FILTER_CIC_BUFFER(sensor_num, order); s++)                 /* clear the state */
+    {
+        buffer[s] = 0;                                                                 /* clear */
+    }
+    cic->phase = 0;                                                                    /* no samples */
+    cic->inited = 1;                                                                   /* flag inited */
+    
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief      filter one raw result word of every sensor
+ * @param[in]  *cic pointer to a cic structure
+ * @param[in]  *raw pointer to the raw result words, [sensor]
+ * @param[out] *out pointer to the outputs in lux or nW/cm2, [sensor]
+ * @param[out] *ready pointer to a ready buffer, 1 when out holds an output
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ * @note       integer lsb counts with wrapping adds, so the output is exact without multiplies,
+ *             the first order outputs carry the start transient
+ */
+uint8_t opt300x_filter_cic_run(opt300x_filter_cic_t *cic, const uint16_t *raw, float *out, uint8_t *ready)
+{
+    uint32_t s;
+    uint32_t n;
+    uint8_t k;
+    uint64_t *stage;
+    
+    if ((cic == NULL) || (raw == NULL) || (out == NULL) || (ready == NULL))          /* check cic and the buffers */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (cic->inited != 1)                                                            /* check cic initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    
+    n = cic->sensor_num;                                                             /* sensor numbers */
+    stage = cic->integrator;                                                         /* first integrator */
+    for (s = 0; s < n; s++)                                                          /* every sensor */
+    {
+        stage[s] += (uint64_t)((uint32_t)(raw[s] & 0x0FFF) << (raw[s] >> 12));       /* integrate the lsb counts */
+    }
+    for (k = 1; k < cic->order; k++)                                                 /* the other integrators */
+    {
+        uint64_t *prev = stage;
+        
+        stage = cic->integrator + (uint32_t)k * n;                                   /* this stage */
+        for (s = 0; s < n; s++)                                                      /* every sensor */
+        {
+            stage[s] += prev[s];                                                     /* integrate the stage before */
+        }
+    }
+    cic->phase++;                                                                    /* one more sample */
+    if (cic->phase < cic->decimation)                                                /* dropped output */
+    {
+        *ready = 0;                                                                  /* no output */
+        
+        return 0;                                                                    /* success return 0 */
+    }
+    cic->phase = 0;                                                                  /* restart */
+    for (s = 0; s < n; s++)                                                          /* every sensor */
+    {
+        uint64_t x = cic->integrator[(uint32_t)(cic->order - 1) * n + s];
+        
+        for (k = 0; k < cic->order; k++)                                             /* every comb */
+        {
+            uint64_t *delay = &cic->comb[(uint32_t)k * n + s];
+            uint64_t y = x - *delay;
+            
+            *delay = x;                                                              /* save the input */
+            x = y;                                                                   /* next stage */
+        }
+        out[s] = (float)x * cic->gain * a_opt300x_filter_weight(cic->type[s]);       /* scale to lux or nW/cm2 */
+    }
+    *ready = 1;                                                                      /* output ready */
+    
+    return 0;                                                                        /* success return 0 */
+}
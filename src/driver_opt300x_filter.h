@@ -0,0 +1,307 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_filter.h
+ * @brief     driver opt300x filter header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_OPT300X_FILTER_H
+#define DRIVER_OPT300X_FILTER_H
+
+#include "driver_opt300x.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup opt300x_filter_driver opt300x filter driver function
+ * @brief    opt300x filter driver modules
+ * @ingroup  opt300x_driver
+ * @{
+ */
+
+/**
+ * @brief filter max median taps
+ */
+#ifndef OPT300X_FILTER_MEDIAN_MAX_TAPS
+    #define OPT300X_FILTER_MEDIAN_MAX_TAPS 9        /**< 9 taps */
+#endif
+
+/**
+ * @brief filter max cic order
+ */
+#define OPT300X_FILTER_CIC_MAX_ORDER 4        /**< 4 stages */
+
+/**
+ * @brief filter buffer length definition
+ * @note  every stage filters a bank of sensors in one call, the state lives in a caller buffer
+ *        laid out [tap][sensor] so every inner loop runs over the sensors of one tap
+ */
+#define OPT300X_FILTER_EMA_BUFFER(sensor_num)            ((uint32_t)(sensor_num))                              /**< floats */
+#define OPT300X_FILTER_BOXCAR_BUFFER(sensor_num, taps)   ((uint32_t)(sensor_num) * ((uint32_t)(taps) + 1))     /**< floats */
+#define OPT300X_FILTER_MEDIAN_BUFFER(sensor_num, taps)   ((uint32_t)(sensor_num) * (uint32_t)(taps) * 2)       /**< floats */
+#define OPT300X_FILTER_FIR_BUFFER(sensor_num, taps)      ((uint32_t)(sensor_num) * (uint32_t)(taps))           /**< floats */
+#define OPT300X_FILTER_CIC_BUFFER(sensor_num, order)     ((uint32_t)(sensor_num) * (uint32_t)(order) * 2)      /**< uint64_t */
+
+/**
+ * @brief opt300x filter ema structure definition
+ */
+typedef struct opt300x_filter_ema_s
+{
+    uint8_t inited;             /**< inited flag */
+    uint8_t started;            /**< first sample flag */
+    uint16_t sensor_num;        /**< sensor numbers */
+    float alpha;                /**< smoothing factor */
+    float *state;               /**< point to the state, [sensor] */
+} opt300x_filter_ema_t;
+
+/**
+ * @brief opt300x filter boxcar structure definition
+ */
+typedef struct opt300x_filter_boxcar_s
+{
+    uint8_t inited;             /**< inited flag */
+    uint8_t started;            /**< first sample flag */
+    uint16_t sensor_num;        /**< sensor numbers */
+    uint16_t taps;              /**< taps */
+    uint16_t head;              /**< oldest tap */
+    float *history;             /**< point to the history, [tap][sensor] */
+    float *sum;                 /**< point to the sums, [sensor] */
+} opt300x_filter_boxcar_t;
+
+/**
+ * @brief opt300x filter median structure definition
+ */
+typedef struct opt300x_filter_median_s
+{
+    uint8_t inited;             /**< inited flag */
+    uint8_t started;            /**< first sample flag */
+    uint16_t sensor_num;        /**< sensor numbers */
+    uint16_t taps;              /**< taps */
+    uint16_t head;              /**< oldest tap */
+    float *history;             /**< point to the history, [tap][sensor] */
+    float *work;                /**< point to the sort rows, [tap][sensor] */
+} opt300x_filter_median_t;
+
+/**
+ * @brief opt300x filter fir structure definition
+ */
+typedef struct opt300x_filter_fir_s
+{
+    uint8_t inited;             /**< inited flag */
+    uint8_t started;            /**< first sample flag */
+    uint16_t sensor_num;        /**< sensor numbers */
+    uint16_t taps;              /**< taps */
+    uint16_t head;              /**< newest tap */
+    uint16_t decimation;        /**< decimation */
+    uint16_t phase;             /**< samples since the last output */
+    const float *coef;          /**< point to the coefficients, coef[0] weights the newest sample */
+    float *history;             /**< point to the history, [tap][sensor] */
+} opt300x_filter_fir_t;
+
+/**
+ * @brief opt300x filter cic structure definition
+ */
+typedef struct opt300x_filter_cic_s
+{
+    uint8_t inited;             /**< inited flag */
+    uint8_t order;              /**< integrator and comb stages */
+    uint16_t sensor_num;        /**< sensor numbers */
+    uint16_t decimation;        /**< decimation */
+    uint16_t phase;             /**< samples since the last output */
+    float gain;                 /**< 1 / decimation ^ order */
+    const opt300x_t *type;      /**< point to a chip type table, [sensor] */
+    uint64_t *integrator;       /**< point to the integrators, [stage][sensor] */
+    uint64_t *comb;             /**< point to the comb delays, [stage][sensor] */
+} opt300x_filter_cic_t;
+
+/**
+ * @brief     init an exponential moving average
+ * @param[in] *ema pointer to an ema structure
+ * @param[in] sensor_num sensor numbers
+ * @param[in] alpha smoothing factor in (0, 1]
+ * @param[in] *buffer pointer to a state buffer
+ * @param[in] len buffer length in floats
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 param is invalid or the buffer is too small
+ * @note      the buffer needs OPT300X_FILTER_EMA_BUFFER(sensor_num) floats
+ */
+uint8_t opt300x_filter_ema_init(opt300x_filter_ema_t *ema, uint16_t sensor_num, float alpha, float *buffer, uint32_t len);
+
+/**
+ * @brief      filter one sample of every sensor
+ * @param[in]  *ema pointer to an ema structure
+ * @param[in]  *in pointer to the samples, [sensor]
+ * @param[out] *out pointer to the outputs, [sensor], can be in
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ * @note       the first call starts every sensor at its sample
+ */
+uint8_t opt300x_filter_ema_run(opt300x_filter_ema_t *ema, const float *in, float *out);
+
+/**
+ * @brief     init a boxcar moving average
+ * @param[in] *boxcar pointer to a boxcar structure
+ * @param[in] sensor_num sensor numbers
+ * @param[in] taps averaged samples
+ * @param[in] *buffer pointer to a state buffer
+ * @param[in] len buffer length in floats
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 param is invalid or the buffer is too small
+ * @note      the buffer needs OPT300X_FILTER_BOXCAR_BUFFER(sensor_num, taps) floats
+ */
+uint8_t opt300x_filter_boxcar_init(opt300x_filter_boxcar_t *boxcar, uint16_t sensor_num, uint16_t taps,
+                                   float *buffer, uint32_t len);
+
+/**
+ * @brief      filter one sample of every sensor
+ * @param[in]  *boxcar pointer to a boxcar structure
+ * @param[in]  *in pointer to the samples, [sensor]
+ * @param[out] *out pointer to the outputs, [sensor], can be in
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ * @note       O(1) per sensor with a running sum, the sum is rebuilt once per lap so float errors don't add up
+ */
+uint8_t opt300x_filter_boxcar_run(opt300x_filter_boxcar_t *boxcar, const float *in, float *out);
+
+/**
+ * @brief     init a median of n
+ * @param[in] *median pointer to a median structure
+ * @param[in] sensor_num sensor numbers
+ * @param[in] taps odd taps, 3 to OPT300X_FILTER_MEDIAN_MAX_TAPS
+ * @param[in] *buffer pointer to a state buffer
+ * @param[in] len buffer length in floats
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 param is invalid or the buffer is too small
+ * @note      the buffer needs OPT300X_FILTER_MEDIAN_BUFFER(sensor_num, taps) floats
+ */
+uint8_t opt300x_filter_median_init(opt300x_filter_median_t *median, uint16_t sensor_num, uint16_t taps,
+                                   float *buffer, uint32_t len);
+
+/**
+ * @brief      filter one sample of every sensor
+ * @param[in]  *median pointer to a median structure
+ * @param[in]  *in pointer to the samples, [sensor]
+ * @param[out] *out pointer to the outputs, [sensor], can be in
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ * @note       a branchless sorting network of min and max runs over whole tap rows
+ */
+uint8_t opt300x_filter_median_run(opt300x_filter_median_t *median, const float *in, float *out);
+
+/**
+ * @brief     init a decimating fir
+ * @param[in] *fir pointer to a fir structure
+ * @param[in] sensor_num sensor numbers
+ * @param[in] *coef pointer to the coefficients, kept by reference
+ * @param[in] taps coefficient numbers
+ * @param[in] decimation one output every decimation samples
+ * @param[in] *buffer pointer to a state buffer
+ * @param[in] len buffer length in floats
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 param is invalid or the buffer is too small
+ * @note      the buffer needs OPT300X_FILTER_FIR_BUFFER(sensor_num, taps) floats
+ */
+uint8_t opt300x_filter_fir_init(opt300x_filter_fir_t *fir, uint16_t sensor_num, const float *coef, uint16_t taps,
+                                uint16_t decimation, float *buffer, uint32_t len);
+
+/**
+ * @brief      filter one sample of every sensor
+ * @param[in]  *fir pointer to a fir structure
+ * @param[in]  *in pointer to the samples, [sensor]
+ * @param[out] *out pointer to the outputs, [sensor], can be in
+ * @param[out] *ready pointer to a ready buffer, 1 when out holds an output
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ * @note       the taps are only summed for the kept outputs
+ */
+uint8_t opt300x_filter_fir_run(opt300x_filter_fir_t *fir, const float *in, float *out, uint8_t *ready);
+
+/**
+ * @brief     init a decimating cic
+ * @param[in] *cic pointer to a cic structure
+ * @param[in] *type pointer to a chip type table, [sensor], kept by reference
+ * @param[in] sensor_num sensor numbers
+ * @param[in] order stages, 1 to OPT300X_FILTER_CIC_MAX_ORDER
+ * @param[in] decimation one output every decimation samples
+ * @param[in] *buffer pointer to a state buffer
+ * @param[in] len buffer length in uint64_t
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 param is invalid or the buffer is too small
+ * @note      the buffer needs OPT300X_FILTER_CIC_BUFFER(sensor_num, order) uint64_t
+ */
+uint8_t opt300x_filter_cic_init(opt300x_filter_cic_t *cic, const opt300x_t *type, uint16_t sensor_num,
+                                uint8_t order, uint16_t decimation, uint64_t *buffer, uint32_t len);
+
+/**
+ * @brief      filter one raw result word of every sensor
+ * @param[in]  *cic pointer to a cic structure
+ * @param[in]  *raw pointer to the raw result words, [sensor]
+ * @param[out] *out pointer to the outputs in lux or nW/cm2, [sensor]
+ * @param[out] *ready pointer to a ready buffer, 1 when out holds an output
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ * @note       integer lsb counts with wrapping adds, so the output is exact without multiplies,
+ *             the first order outputs carry the start transient
+ */
+uint8_t opt300x_filter_cic_run(opt300x_filter_cic_t *cic, const uint16_t *raw, float *out, uint8_t *ready);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,247 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_frame.c
+ * @brief     driver opt300x frame source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_opt300x_frame.h"
+#include <math.h>
+
+/**
+ * @brief frame register definition
+ */
+#define OPT300X_FRAME_REG_RESULT        0x00                    /**< result register */
+#define OPT300X_FRAME_FULL_SCALE        0xBFFF                  /**< exponent 11, mantissa 4095 */
+#define OPT300X_FRAME_SAMPLE            (OPT300X_FRAME_FLAG_VALID | OPT300X_FRAME_FLAG_OVERFLOW)        /**< flags with a sample */
+
+/**
+ * @brief exponent scale table, reserved exponents give NAN
+ */
+static const float gs_exp2[16] =
+{
+    1.0f, 2.0f, 4.0f, 8.0f, 16.0f, 32.0f, 64.0f, 128.0f,
+    256.0f, 512.0f, 1024.0f, 2048.0f, NAN, NAN, NAN, NAN,
+};
+
+/**
+ * @brief sample mask table, a multiply instead of a branch keeps the conversion vectorized
+ */
+static const float gs_keep[2] = {NAN, 1.0f};
+
+/**
+ * @brief     init a frame group
+ * @param[in] *group pointer to a frame group structure
+ * @param[in] **handle pointer to a handle table, the index is the sensor id
+ * @param[in] sensor_num sensor numbers
+ * @param[in] mode read mode
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 param is invalid
+ * @note      the handles must be inited in continuous mode, chip types can be mixed
+ */
+uint8_t opt300x_frame_group_init(opt300x_frame_group_t *group, opt300x_handle_t **handle, uint8_t sensor_num,
+                                 opt300x_frame_read_t mode)
+{
+    uint8_t s;
+    
+    if ((group == NULL) || (handle == NULL))                                               /* check group and the handles */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if ((sensor_num == 0) || (sensor_num > OPT300X_FRAME_MAX_SENSOR) ||
+        ((mode != OPT300X_FRAME_READ_CHECKED) && (mode != OPT300X_FRAME_READ_FAST)))       /* check the param */
+    {
+        return 4;                                                                          /* return error */
+    }
+    for (s = 0; s < sensor_num; s++)                                                       /* every sensor */
+    {
+        if (handle[s] == NULL)                                                             /* check the handle */
+        {
+            return 2;                                                                      /* return error */
+        }
+        if (handle[s]->inited != 1)                                                        /* check the initialization */
+        {
+            return 3;                                                                      /* return error */
+        }
+    }
+    
+    for (s = 0; s < sensor_num; s++)                                                       /* every sensor */
+    {
+        group->handle[s] = handle[s];                                                      /* set the handle */
+        if (handle[s]->type == (uint8_t)OPT3002)                                           /* opt3002 */
+        {
+            group->weight[s] = 1.2f;                                                       /* nW/cm2 */
+        }
+        else if (handle[s]->type == (uint8_t)OPT3005)                                      /* opt3005 */
+        {
+            group->weight[s] = 0.02f;                                                      /* lux */
+        }
+        else                                                                               /* the others */
+        {
+            group->weight[s] = 0.01f;                                                      /* lux */
+        }
+    }
+    group->sensor_num = sensor_num;                                                        /* set the sensor numbers */
+    group->mode = (uint8_t)mode;                                                           /* set the mode */
+    group->inited = 1;                                                                     /* flag inited */
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief      read every sensor of the group once into a frame
+ * @param[in]  *group pointer to a frame group structure
+ * @param[out] *frame pointer to a frame buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no sensor gave a sample
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ * @note       the transfers run back to back and the conversion runs afterwards in one pass over the frame
+ */
+uint8_t opt300x_frame_read(opt300x_frame_group_t *group, opt300x_frame_t *frame)
+{
+    uint8_t s;
+    uint8_t res;
+    uint8_t valid;
+    uint32_t reset;
+    uint32_t count;
+    float data;
+    opt300x_handle_t *handle;
+    
+    if ((group == NULL) || (frame == NULL))                                                /* check group and frame */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (group->inited != 1)                                                                /* check group initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    
+    valid = 0;                                                                             /* no samples */
+    frame->sensor_num = group->sensor_num;                                                 /* set the sensor numbers */
+    for (s = 0; s < group->sensor_num; s++)                                                /* every sensor */
+    {
+        handle = group->handle[s];                                                         /* get the handle */
+        frame->timestamp[s] = (handle->timestamp_us != NULL) ? handle->timestamp_us() : 0; /* set the read time */
+        reset = 0;                                                                         /* init 0 */
+        (void)opt300x_get_reset_count(handle, &reset);                                     /* get the reset counter */
+        if (group->mode == (uint8_t)OPT300X_FRAME_READ_FAST)                               /* result only */
+        {
+            res = opt300x_get_reg(handle, OPT300X_FRAME_REG_RESULT, &frame->raw[s]);       /* read the result */
+        }
+        else if (handle->type == (uint8_t)OPT3002)                                         /* opt3002 */
+        {
+            res = opt3002_continuous_read(handle, &frame->raw[s], &data);                  /* read nW/cm2 */
+        }
+        else                                                                               /* the others */
+        {
+            res = opt300x_continuous_read(handle, &frame->raw[s], &data);                  /* read lux */
+        }
+        count = reset;                                                                     /* init the counter */
+        (void)opt300x_get_reset_count(handle, &count);                                     /* get the reset counter */
+        if ((res == 0) && (count != reset))                                                /* chip reset */
+        {
+            frame->raw[s] = 0;                                                             /* the sample may predate the restore */
+            frame->flags[s] = OPT300X_FRAME_FLAG_RESET;                                    /* reset */
+        }
+        else if (res == 0)                                                                 /* new sample */
+        {
+            frame->flags[s] = OPT300X_FRAME_FLAG_VALID;                                    /* valid */
+            valid = 1;                                                                     /* flag a sample */
+        }
+        else if (res == 4)                                                                 /* overflow */
+        {
+            frame->raw[s] = OPT300X_FRAME_FULL_SCALE;                                      /* full scale */
+            frame->flags[s] = OPT300X_FRAME_FLAG_OVERFLOW;                                 /* overflow */
+        }
+        else                                                                               /* failed */
+        {
+            frame->raw[s] = 0;                                                             /* no sample */
+            frame->flags[s] = OPT300X_FRAME_FLAG_FAILED;                                   /* failed */
+        }
+    }
+    (void)opt300x_frame_convert(group, frame);                                             /* convert all */
+    
+    return (valid != 0) ? 0 : 1;                                                           /* return the result */
+}
+
+/**
+ * @brief         convert the raw data of a frame
+ * @param[in]     *group pointer to a frame group structure
+ * @param[in,out] *frame pointer to a frame with raw data and flags
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ *                - 3 handle is not inited
+ *                - 4 frame doesn't match the group
+ * @note          no branch per sensor so it vectorizes, sensors without VALID or OVERFLOW get NAN
+ */
+uint8_t opt300x_frame_convert(opt300x_frame_group_t *group, opt300x_frame_t *frame)
+{
+    uint8_t s;
+    uint8_t num;
+    float value;
+    const uint16_t *raw;
+    const uint8_t *flags;
+    const float *weight;
+    float *lux;
+    
+    if ((group == NULL) || (frame == NULL))                                                /* check group and frame */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (group->inited != 1)                                                                /* check group initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    if (frame->sensor_num != group->sensor_num)                                            /* check the frame */
+    {
+        return 4;                                                                          /* return error */
+    }
+    
+    num = group->sensor_num;                                                               /* sensor numbers */
+    raw = frame->raw;                                                                      /* raw data */
+    flags = frame->flags;                                                                  /* flags */
+    weight = group->weight;                                                                /* lsb weights */
+    lux = frame->lux;                                                                      /* converted data */
+    for (s = 0; s < num; s++)                                                              /* every sensor */
+    {
+        value = (float)(raw[s] & 0x0FFF) * weight[s] * gs_exp2[raw[s] >> 12];              /* convert */
+        lux[s] = value * gs_keep[(flags[s] & OPT300X_FRAME_SAMPLE) != 0];                  /* keep samples only */
+    }
+    
+    return 0;                                                                              /* success return 0 */
+}
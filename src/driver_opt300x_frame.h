@@ -0,0 +1,157 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_frame.h
+ * @brief     driver opt300x frame header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_OPT300X_FRAME_H
+#define DRIVER_OPT300X_FRAME_H
+
+#include "driver_opt300x.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup opt300x_frame_driver opt300x frame driver function
+ * @brief    opt300x frame driver modules
+ * @ingroup  opt300x_driver
+ * @{
+ */
+
+/**
+ * @brief frame max sensor numbers
+ * @note  all memory is static, override it at compile time to fit the target
+ */
+#ifndef OPT300X_FRAME_MAX_SENSOR
+    #define OPT300X_FRAME_MAX_SENSOR 8        /**< 8 sensors */
+#endif
+
+/**
+ * @brief opt300x frame read mode enumeration definition
+ */
+typedef enum
+{
+    OPT300X_FRAME_READ_CHECKED = 0x00,        /**< configuration and result of every sensor, detects overflow and chip reset */
+    OPT300X_FRAME_READ_FAST    = 0x01,        /**< result only, one transfer per sensor */
+} opt300x_frame_read_t;
+
+/**
+ * @brief opt300x frame flag enumeration definition
+ */
+typedef enum
+{
+    OPT300X_FRAME_FLAG_NONE     = 0x00,        /**< no sample */
+    OPT300X_FRAME_FLAG_VALID    = 0x01,        /**< new sample */
+    OPT300X_FRAME_FLAG_OVERFLOW = 0x02,        /**< over the full scale, raw is the full scale */
+    OPT300X_FRAME_FLAG_RESET    = 0x04,        /**< chip reset and restored, no sample */
+    OPT300X_FRAME_FLAG_FAILED   = 0x08,        /**< read failed, no sample */
+} opt300x_frame_flag_t;
+
+/**
+ * @brief opt300x frame structure definition
+ * @note  parallel arrays, the index is the sensor id
+ */
+typedef struct opt300x_frame_s
+{
+    uint8_t sensor_num;                                   /**< sensor numbers */
+    uint16_t raw[OPT300X_FRAME_MAX_SENSOR];               /**< raw data */
+    float lux[OPT300X_FRAME_MAX_SENSOR];                  /**< lux or nW/cm2, NAN without a sample */
+    uint8_t flags[OPT300X_FRAME_MAX_SENSOR];              /**< sample flags */
+    uint64_t timestamp[OPT300X_FRAME_MAX_SENSOR];         /**< read time in us, 0 without timestamp_us */
+} opt300x_frame_t;
+
+/**
+ * @brief opt300x frame group structure definition
+ */
+typedef struct opt300x_frame_group_s
+{
+    uint8_t inited;                                               /**< inited flag */
+    uint8_t sensor_num;                                           /**< sensor numbers */
+    uint8_t mode;                                                 /**< read mode */
+    opt300x_handle_t *handle[OPT300X_FRAME_MAX_SENSOR];           /**< sensor handles */
+    float weight[OPT300X_FRAME_MAX_SENSOR];                       /**< lsb weights */
+} opt300x_frame_group_t;
+
+/**
+ * @brief     init a frame group
+ * @param[in] *group pointer to a frame group structure
+ * @param[in] **handle pointer to a handle table, the index is the sensor id
+ * @param[in] sensor_num sensor numbers
+ * @param[in] mode read mode
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 param is invalid
+ * @note      the handles must be inited in continuous mode, chip types can be mixed
+ */
+uint8_t opt300x_frame_group_init(opt300x_frame_group_t *group, opt300x_handle_t **handle, uint8_t sensor_num,
+                                 opt300x_frame_read_t mode);
+
+/**
+ * @brief      read every sensor of the group once into a frame
+ * @param[in]  *group pointer to a frame group structure
+ * @param[out] *frame pointer to a frame buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no sensor gave a sample
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ * @note       the transfers run back to back and the conversion runs afterwards in one pass over the frame
+ */
+uint8_t opt300x_frame_read(opt300x_frame_group_t *group, opt300x_frame_t *frame);
+
+/**
+ * @brief         convert the raw data of a frame
+ * @param[in]     *group pointer to a frame group structure
+ * @param[in,out] *frame pointer to a frame with raw data and flags
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ *                - 3 handle is not inited
+ *                - 4 frame doesn't match the group
+ * @note          no branch per sensor so it vectorizes, sensors without VALID or OVERFLOW get NAN
+ */
+uint8_t opt300x_frame_convert(opt300x_frame_group_t *group, opt300x_frame_t *frame);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,541 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_fusion.c
+ * @brief     driver opt300x fusion source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_opt300x_fusion.h"
+#include <math.h>
+
+/**
+ * @brief         compare and exchange two values
+ * @param[in,out] *a pointer to the lower value
+ * @param[in,out] *b pointer to the upper value
+ * @note          min and max, no branch
+ */
+static inline void a_opt300x_fusion_exchange(float *a, float *b)
+{
+    float x;
+    float y;
+    
+    x = *a;                          /* get the first value */
+    y = *b;                          /* get the second value */
+    *a = (x < y) ? x : y;            /* min */
+    *b = (x > y) ? x : y;            /* max */
+}
+
+/**
+ * @brief         sort 4 values
+ * @param[in,out] *v pointer to 4 values, unused entries are INFINITY
+ * @note          optimal 4 inputs sorting network of 5 exchanges, the padding sorts to the end
+ */
+static void a_opt300x_fusion_sort(float *v)
+{
+    a_opt300x_fusion_exchange(&v[0], &v[1]);        /* layer 1 */
+    a_opt300x_fusion_exchange(&v[2], &v[3]);        /* layer 1 */
+    a_opt300x_fusion_exchange(&v[0], &v[2]);        /* layer 2 */
+    a_opt300x_fusion_exchange(&v[1], &v[3]);        /* layer 2 */
+    a_opt300x_fusion_exchange(&v[1], &v[2]);        /* layer 3 */
+}
+
+/**
+ * @brief     get the median of up to 4 values
+ * @param[in] *v pointer to 4 values, unused entries are INFINITY
+ * @param[in] num used entries, 1 to 4
+ * @return    median
+ * @note      v is sorted in place
+ */
+static float a_opt300x_fusion_median(float *v, uint8_t num)
+{
+    a_opt300x_fusion_sort(v);                                /* sort the values */
+    
+    return (v[(num - 1) / 2] + v[num / 2]) * 0.5f;           /* return the middle */
+}
+
+/**
+ * @brief     encode a value as a raw result word
+ * @param[in] data lux or nW/cm2
+ * @param[in] weight lsb weight
+ * @return    raw result word
+ * @note      smallest exponent that holds the value, like the auto full scale range
+ */
+static uint16_t a_opt300x_fusion_encode(float data, float weight)
+{
+    uint8_t e;
+    float counts;
+    
+    counts = data / weight;                                          /* lsb counts */
+    if (counts < 0.0f)                                               /* check the sign */
+    {
+        counts = 0.0f;                                               /* clamp */
+    }
+    e = 0;                                                           /* start at exponent 0 */
+    while ((counts > 4095.0f) && (e < 11))                           /* find the exponent */
+    {
+        counts *= 0.5f;                                              /* half */
+        e++;                                                         /* next exponent */
+    }
+    if (counts > 4094.5f)                                            /* check the range */
+    {
+        counts = 4094.5f;                                            /* clamp */
+    }
+    
+    return (uint16_t)(((uint16_t)e << 12) | (uint16_t)(counts + 0.5f));        /* return the raw word */
+}
+
+/**
+ * @brief     init a fusion group
+ * @param[in] *fusion pointer to a fusion structure
+ * @param[in] **handle pointer to a handle table, the index is the sensor id
+ * @param[in] sensor_num sensor numbers, 2 to OPT300X_FUSION_MAX_SENSOR
+ * @param[in] mode fusion mode
+ * @param[in] reject_ratio outlier distance relative to the median, e.g. 0.2
+ * @param[in] reject_floor smallest outlier distance in lux or nW/cm2, keeps dark readings
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 param is invalid
+ * @note      all handles must be inited in continuous mode with one chip type,
+ *            a sensor is an outlier when it is farther than max(reject_ratio * median, reject_floor) from the median
+ */
+uint8_t opt300x_fusion_init(opt300x_fusion_t *fusion, opt300x_handle_t **handle, uint8_t sensor_num,
+                            opt300x_fusion_mode_t mode, float reject_ratio, float reject_floor)
+{
+    uint8_t s;
+    
+    if ((fusion == NULL) || (handle == NULL))                                              /* check fusion and the handles */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if ((sensor_num < 2) || (sensor_num > OPT300X_FUSION_MAX_SENSOR) ||
+        ((mode != OPT300X_FUSION_MODE_MEDIAN) && (mode != OPT300X_FUSION_MODE_TRIMMED_MEAN)) ||
+        (!(reject_ratio >= 0.0f)) || (!(reject_floor >= 0.0f)))                            /* check the param */
+    {
+        return 4;                                                                          /* return error */
+    }
+    for (s = 0; s < sensor_num; s++)                                                       /* every sensor */
+    {
+        if (handle[s] == NULL)                                                             /* check the handle */
+        {
+            return 2;                                                                      /* return error */
+        }
+        if (handle[s]->inited != 1)                                                        /* check the initialization */
+        {
+            return 3;                                                                      /* return error */
+        }
+        if (handle[s]->type != handle[0]->type)                                            /* check the type */
+        {
+            return 4;                                                                      /* return error */
+        }
+    }
+    
+    fusion->type = handle[0]->type;                                                        /* set the type */
+    if (fusion->type == (uint8_t)OPT3002)                                                  /* opt3002 */
+    {
+        fusion->weight = 1.2f;                                                             /* nW/cm2 */
+    }
+    else if (fusion->type == (uint8_t)OPT3005)                                             /* opt3005 */
+    {
+        fusion->weight = 0.02f;                                                            /* lux */
+    }
+    else                                                                                   /* the others */
+    {
+        fusion->weight = 0.01f;                                                            /* lux */
+    }
+    fusion->sensor_num = sensor_num;                                                       /* set the sensor numbers */
+    fusion->mode = (uint8_t)mode;                                                          /* set the mode */
+    fusion->reject_ratio = reject_ratio;                                                   /* set the ratio */
+    fusion->reject_floor = reject_floor;                                                   /* set the floor */
+    for (s = 0; s < OPT300X_FUSION_MAX_SENSOR; s++)                                        /* every slot */
+    {
+        fusion->handle[s] = (s < sensor_num) ? handle[s] : NULL;                           /* set the handle */
+        fusion->health[s] = 1.0f;                                                          /* healthy */
+    }
+    fusion->pubsub = NULL;                                                                 /* no logical sensor */
+    fusion->result.timestamp_us = 0;                                                       /* clear the result */
+    fusion->result.data = 0.0f;                                                            /* clear the result */
+    fusion->result.raw = 0;                                                                /* clear the result */
+    fusion->result.used = 0;                                                               /* clear the result */
+    fusion->result.rejected = 0;                                                           /* clear the result */
+    fusion->result.failed = 0;                                                             /* clear the result */
+    fusion->inited = 1;                                                                    /* flag inited */
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     publish the results as a logical sensor
+ * @param[in] *fusion pointer to a fusion structure
+ * @param[in] *pubsub pointer to an inited pubsub structure, NULL stops publishing
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ * @note      the subscribers of the pubsub get the fused samples instead of the samples of its handle
+ */
+uint8_t opt300x_fusion_set_pubsub(opt300x_fusion_t *fusion, opt300x_pubsub_t *pubsub)
+{
+    if (fusion == NULL)                                                  /* check fusion */
+    {
+        return 2;                                                        /* return error */
+    }
+    if ((fusion->inited != 1) || ((pubsub != NULL) && (pubsub->inited != 1)))      /* check initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    
+    fusion->pubsub = pubsub;                                             /* set the pubsub */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      fuse samples read elsewhere
+ * @param[in]  *fusion pointer to a fusion structure
+ * @param[in]  *raw pointer to the raw data of every sensor
+ * @param[in]  valid mask of the sensors with a sample
+ * @param[in]  timestamp_us timestamp of the samples
+ * @param[out] *result pointer to a result buffer, can be NULL
+ * @return     status code
+ *             - 0 success
+ *             - 1 no valid sample
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ * @note       a sensor outside valid counts as failed
+ */
+uint8_t opt300x_fusion_fuse(opt300x_fusion_t *fusion, const uint16_t *raw, uint8_t valid,
+                            uint64_t timestamp_us, opt300x_fusion_result_t *result)
+{
+    uint8_t s;
+    uint8_t a;
+    uint8_t b;
+    uint8_t num;
+    uint8_t ok;
+    uint8_t rejected;
+    uint8_t used;
+    float ref;
+    float limit;
+    float sum;
+    float sum_w;
+    float x[OPT300X_FUSION_MAX_SENSOR];
+    float v[OPT300X_FUSION_MAX_SENSOR];
+    opt300x_fusion_result_t *r;
+    
+    if ((fusion == NULL) || (raw == NULL))                                                 /* check fusion and raw */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (fusion->inited != 1)                                                               /* check fusion initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    
+    r = &fusion->result;                                                                   /* last result */
+    num = 0;                                                                               /* no samples */
+    ok = 0;                                                                                /* no samples */
+    for (s = 0; s < OPT300X_FUSION_MAX_SENSOR; s++)                                        /* every slot */
+    {
+        v[s] = INFINITY;                                                                   /* padding */
+    }
+    for (s = 0; s < fusion->sensor_num; s++)                                               /* every sensor */
+    {
+        x[s] = 0.0f;                                                                       /* no sample */
+        if ((((valid >> s) & 1) != 0) && ((raw[s] >> 12) < 12))                            /* valid word */
+        {
+            x[s] = fusion->weight * (float)(1U << (raw[s] >> 12)) * (float)(raw[s] & 0x0FFF);      /* convert */
+            v[num] = x[s];                                                                 /* gather */
+            num++;                                                                         /* count */
+            ok |= (uint8_t)(1 << s);                                                       /* flag the sample */
+        }
+    }
+    r->failed = (uint8_t)(((1 << fusion->sensor_num) - 1) & ~ok);                          /* set the failed sensors */
+    if (num == 0)                                                                          /* no samples */
+    {
+        for (s = 0; s < fusion->sensor_num; s++)                                           /* every sensor */
+        {
+            fusion->health[s] -= OPT300X_FUSION_HEALTH_RATE * fusion->health[s];           /* lose health */
+        }
+        r->used = 0;                                                                       /* no result */
+        r->rejected = 0;                                                                   /* no result */
+        
+        return 1;                                                                          /* return error */
+    }
+    
+    ref = a_opt300x_fusion_median(v, num);                                                 /* median of all samples */
+    limit = fusion->reject_ratio * ref;                                                    /* relative limit */
+    if (limit < fusion->reject_floor)                                                      /* check the floor */
+    {
+        limit = fusion->reject_floor;                                                      /* floor */
+    }
+    rejected = 0;                                                                          /* no outliers */
+    if (num == 2)                                                                          /* two samples */
+    {
+        a = 0xFF;                                                                          /* first sensor */
+        b = 0;                                                                             /* second sensor */
+        for (s = 0; s < fusion->sensor_num; s++)                                           /* every sensor */
+        {
+            if (((ok >> s) & 1) != 0)                                                      /* sample */
+            {
+                a = (a == 0xFF) ? s : a;                                                   /* keep the first */
+                b = s;                                                                     /* keep the last */
+            }
+        }
+        if (fabsf(x[a] - x[b]) > limit)                                                    /* disagree */
+        {
+            if (fusion->health[a] < fusion->health[b])                                     /* a is weaker */
+            {
+                rejected = (uint8_t)(1 << a);                                              /* reject a */
+            }
+            else if (fusion->health[b] < fusion->health[a])                                /* b is weaker */
+            {
+                rejected = (uint8_t)(1 << b);                                              /* reject b */
+            }
+        }
+    }
+    if (num > 2)                                                                           /* a median */
+    {
+        for (s = 0; s < fusion->sensor_num; s++)                                           /* every sensor */
+        {
+            if ((((ok >> s) & 1) != 0) && (fabsf(x[s] - ref) > limit))                     /* outlier */
+            {
+                rejected |= (uint8_t)(1 << s);                                             /* reject */
+            }
+        }
+        if (rejected == ok)                                                                /* no majority */
+        {
+            rejected = 0;                                                                  /* keep all */
+        }
+    }
+    used = (uint8_t)(ok & ~rejected);                                                      /* accepted sensors */
+    
+    if (fusion->mode == (uint8_t)OPT300X_FUSION_MODE_MEDIAN)                               /* median */
+    {
+        a = 0;                                                                             /* healthy sensors */
+        for (s = 0; s < fusion->sensor_num; s++)                                           /* every sensor */
+        {
+            if ((((used >> s) & 1) != 0) && (fusion->health[s] >= OPT300X_FUSION_MIN_HEALTH))      /* healthy */
+            {
+                a |= (uint8_t)(1 << s);                                                    /* flag */
+            }
+        }
+        if (a != 0)                                                                        /* check the healthy sensors */
+        {
+            used = a;                                                                      /* use the healthy sensors */
+        }
+        num = 0;                                                                           /* no samples */
+        for (s = 0; s < OPT300X_FUSION_MAX_SENSOR; s++)                                    /* every slot */
+        {
+            v[s] = INFINITY;                                                               /* padding */
+        }
+        for (s = 0; s < fusion->sensor_num; s++)                                           /* every sensor */
+        {
+            if (((used >> s) & 1) != 0)                                                    /* used */
+            {
+                v[num] = x[s];                                                             /* gather */
+                num++;                                                                     /* count */
+            }
+        }
+        r->data = a_opt300x_fusion_median(v, num);                                         /* set the median */
+    }
+    else                                                                                   /* trimmed mean */
+    {
+        num = 0;                                                                           /* no samples */
+        for (s = 0; s < OPT300X_FUSION_MAX_SENSOR; s++)                                    /* every slot */
+        {
+            v[s] = INFINITY;                                                               /* padding */
+        }
+        for (s = 0; s < fusion->sensor_num; s++)                                           /* every sensor */
+        {
+            if (((used >> s) & 1) != 0)                                                    /* used */
+            {
+                v[num] = x[s];                                                             /* gather */
+                num++;                                                                     /* count */
+            }
+        }
+        if (num >= 3)                                                                      /* enough samples to trim */
+        {
+            a_opt300x_fusion_sort(v);                                                      /* sort the samples */
+            a = 0xFF;                                                                      /* no minimum sensor */
+            b = 0xFF;                                                                      /* no maximum sensor */
+            for (s = 0; s < fusion->sensor_num; s++)                                       /* every sensor */
+            {
+                if ((((used >> s) & 1) != 0) && (a == 0xFF) && (x[s] == v[0]))             /* the minimum */
+                {
+                    a = s;                                                                 /* keep the sensor */
+                }
+                else if ((((used >> s) & 1) != 0) && (b == 0xFF) && (x[s] == v[num - 1]))  /* the maximum */
+                {
+                    b = s;                                                                 /* keep the sensor */
+                }
+            }
+            used &= (uint8_t)~((1 << a) | (1 << b));                                       /* drop the extremes */
+            v[0] = INFINITY;                                                               /* drop the minimum */
+            v[num - 1] = INFINITY;                                                         /* drop the maximum */
+            a_opt300x_fusion_sort(v);                                                      /* move the middle to the front */
+            num -= 2;                                                                      /* middle samples */
+        }
+        sum = 0.0f;                                                                        /* clear the sum */
+        sum_w = 0.0f;                                                                      /* clear the weights */
+        for (s = 0; s < fusion->sensor_num; s++)                                           /* every sensor */
+        {
+            if (((used >> s) & 1) != 0)                                                    /* used */
+            {
+                sum += fusion->health[s] * x[s];                                           /* add the weighted sample */
+                sum_w += fusion->health[s];                                                /* add the weight */
+            }
+        }
+        if (sum_w > 0.0f)                                                                  /* check the weights */
+        {
+            r->data = sum / sum_w;                                                         /* set the weighted mean */
+        }
+        else                                                                               /* no health left */
+        {
+            sum = 0.0f;                                                                    /* clear the sum */
+            for (s = 0; s < num; s++)                                                      /* every used sample */
+            {
+                sum += v[s];                                                               /* add the sample */
+            }
+            r->data = sum / (float)num;                                                    /* set the plain mean */
+        }
+    }
+    
+    for (s = 0; s < fusion->sensor_num; s++)                                               /* every sensor */
+    {
+        if ((((ok & ~rejected) >> s) & 1) != 0)                                            /* accepted */
+        {
+            fusion->health[s] += OPT300X_FUSION_HEALTH_RATE * (1.0f - fusion->health[s]);  /* gain health */
+        }
+        else                                                                               /* failed or rejected */
+        {
+            fusion->health[s] -= OPT300X_FUSION_HEALTH_RATE * fusion->health[s];           /* lose health */
+        }
+    }
+    r->timestamp_us = timestamp_us;                                                        /* set the timestamp */
+    r->raw = a_opt300x_fusion_encode(r->data, fusion->weight);                             /* set the raw word */
+    r->used = used;                                                                        /* set the used sensors */
+    r->rejected = rejected;                                                                /* set the outliers */
+    if (result != NULL)                                                                    /* check the result */
+    {
+        *result = *r;                                                                      /* copy the result */
+    }
+    if (fusion->pubsub != NULL)                                                            /* logical sensor */
+    {
+        (void)opt300x_pubsub_publish(fusion->pubsub, r->raw, r->data);                     /* publish */
+    }
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief      read every sensor of the group once and fuse the samples
+ * @param[in]  *fusion pointer to a fusion structure
+ * @param[out] *result pointer to a result buffer, can be NULL
+ * @return     status code
+ *             - 0 success
+ *             - 1 every sensor failed to read
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ * @note       the sensors are read back to back, call it once per conversion time
+ */
+uint8_t opt300x_fusion_run(opt300x_fusion_t *fusion, opt300x_fusion_result_t *result)
+{
+    uint8_t s;
+    uint8_t res;
+    uint8_t valid;
+    uint16_t raw[OPT300X_FUSION_MAX_SENSOR];
+    uint64_t timestamp_us;
+    float data;
+    
+    if (fusion == NULL)                                                                    /* check fusion */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (fusion->inited != 1)                                                               /* check fusion initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    
+    timestamp_us = (fusion->handle[0]->timestamp_us != NULL) ? fusion->handle[0]->timestamp_us() : 0;     /* round time */
+    valid = 0;                                                                             /* no samples */
+    for (s = 0; s < fusion->sensor_num; s++)                                               /* every sensor */
+    {
+        raw[s] = 0;                                                                        /* no sample */
+        if (fusion->type == (uint8_t)OPT3002)                                              /* opt3002 */
+        {
+            res = opt3002_continuous_read(fusion->handle[s], &raw[s], &data);              /* read nW/cm2 */
+        }
+        else                                                                               /* the others */
+        {
+            res = opt300x_continuous_read(fusion->handle[s], &raw[s], &data);              /* read lux */
+        }
+        if (res == 0)                                                                      /* check the result */
+        {
+            valid |= (uint8_t)(1 << s);                                                    /* flag the sample */
+        }
+    }
+    
+    return opt300x_fusion_fuse(fusion, raw, valid, timestamp_us, result);                  /* fuse */
+}
+
+/**
+ * @brief      get the health of a sensor
+ * @param[in]  *fusion pointer to a fusion structure
+ * @param[in]  sensor sensor id
+ * @param[out] *health pointer to a health buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ *             - 4 sensor is invalid
+ * @note       rises towards 1 while the sensor is accepted and falls towards 0 while it fails or is rejected
+ */
+uint8_t opt300x_fusion_get_health(opt300x_fusion_t *fusion, uint8_t sensor, float *health)
+{
+    if ((fusion == NULL) || (health == NULL))                /* check fusion and health */
+    {
+        return 2;                                            /* return error */
+    }
+    if (fusion->inited != 1)                                 /* check fusion initialization */
+    {
+        return 3;                                            /* return error */
+    }
+    if (sensor >= fusion->sensor_num)                        /* check the sensor */
+    {
+        return 4;                                            /* return error */
+    }
+    
+    *health = fusion->health[sensor];                        /* get the health */
+    
+    return 0;                                                /* success return 0 */
+}
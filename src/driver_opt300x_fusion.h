@@ -0,0 +1,196 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_fusion.h
+ * @brief     driver opt300x fusion header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_OPT300X_FUSION_H
+#define DRIVER_OPT300X_FUSION_H
+
+#include "driver_opt300x_pubsub.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup opt300x_fusion_driver opt300x fusion driver function
+ * @brief    opt300x fusion driver modules
+ * @ingroup  opt300x_driver
+ * @{
+ */
+
+/**
+ * @brief fusion max sensor numbers
+ * @note  one sensor per address pin option, fixed by the 4 inputs sorting network
+ */
+#define OPT300X_FUSION_MAX_SENSOR 4
+
+/**
+ * @brief fusion health update rate
+ */
+#ifndef OPT300X_FUSION_HEALTH_RATE
+    #define OPT300X_FUSION_HEALTH_RATE 0.125f        /**< 1/8 per round */
+#endif
+
+/**
+ * @brief fusion lowest health of a median input
+ */
+#ifndef OPT300X_FUSION_MIN_HEALTH
+    #define OPT300X_FUSION_MIN_HEALTH 0.25f        /**< 0.25 */
+#endif
+
+/**
+ * @brief opt300x fusion mode enumeration definition
+ */
+typedef enum
+{
+    OPT300X_FUSION_MODE_MEDIAN       = 0x00,        /**< median of the accepted sensors with enough health */
+    OPT300X_FUSION_MODE_TRIMMED_MEAN = 0x01,        /**< health weighted mean of the accepted sensors without the minimum and the maximum from 3 sensors */
+} opt300x_fusion_mode_t;
+
+/**
+ * @brief opt300x fusion result structure definition
+ */
+typedef struct opt300x_fusion_result_s
+{
+    uint64_t timestamp_us;        /**< timestamp of the round, 0 without timestamp_us */
+    float data;                   /**< fused lux or nW/cm2 */
+    uint16_t raw;                 /**< fused data as a raw result word */
+    uint8_t used;                 /**< mask of the sensors in the result */
+    uint8_t rejected;             /**< mask of the sensors rejected as outliers */
+    uint8_t failed;               /**< mask of the sensors that failed to read */
+} opt300x_fusion_result_t;
+
+/**
+ * @brief opt300x fusion structure definition
+ */
+typedef struct opt300x_fusion_s
+{
+    uint8_t inited;                                              /**< inited flag */
+    uint8_t type;                                                /**< chip type */
+    uint8_t sensor_num;                                          /**< sensor numbers */
+    uint8_t mode;                                                /**< fusion mode */
+    float weight;                                                /**< lsb weight */
+    float reject_ratio;                                          /**< outlier distance relative to the median */
+    float reject_floor;                                          /**< smallest outlier distance */
+    float health[OPT300X_FUSION_MAX_SENSOR];                     /**< health of every sensor, 0 to 1 */
+    opt300x_handle_t *handle[OPT300X_FUSION_MAX_SENSOR];         /**< sensor handles */
+    opt300x_pubsub_t *pubsub;                                    /**< logical sensor, can be NULL */
+    opt300x_fusion_result_t result;                              /**< last result */
+} opt300x_fusion_t;
+
+/**
+ * @brief     init a fusion group
+ * @param[in] *fusion pointer to a fusion structure
+ * @param[in] **handle pointer to a handle table, the index is the sensor id
+ * @param[in] sensor_num sensor numbers, 2 to OPT300X_FUSION_MAX_SENSOR
+ * @param[in] mode fusion mode
+ * @param[in] reject_ratio outlier distance relative to the median, e.g. 0.2
+ * @param[in] reject_floor smallest outlier distance in lux or nW/cm2, keeps dark readings
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 param is invalid
+ * @note      all handles must be inited in continuous mode with one chip type,
+ *            a sensor is an outlier when it is farther than max(reject_ratio * median, reject_floor) from the median
+ */
+uint8_t opt300x_fusion_init(opt300x_fusion_t *fusion, opt300x_handle_t **handle, uint8_t sensor_num,
+                            opt300x_fusion_mode_t mode, float reject_ratio, float reject_floor);
+
+/**
+ * @brief     publish the results as a logical sensor
+ * @param[in] *fusion pointer to a fusion structure
+ * @param[in] *pubsub pointer to an inited pubsub structure, NULL stops publishing
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ * @note      the subscribers of the pubsub get the fused samples instead of the samples of its handle
+ */
+uint8_t opt300x_fusion_set_pubsub(opt300x_fusion_t *fusion, opt300x_pubsub_t *pubsub);
+
+/**
+ * @brief      read every sensor of the group once and fuse the samples
+ * @param[in]  *fusion pointer to a fusion structure
+ * @param[out] *result pointer to a result buffer, can be NULL
+ * @return     status code
+ *             - 0 success
+ *             - 1 every sensor failed to read
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ * @note       the sensors are read back to back, call it once per conversion time
+ */
+uint8_t opt300x_fusion_run(opt300x_fusion_t *fusion, opt300x_fusion_result_t *result);
+
+/**
+ * @brief      fuse samples read elsewhere
+ * @param[in]  *fusion pointer to a fusion structure
+ * @param[in]  *raw pointer to the raw data of every sensor
+ * @param[in]  valid mask of the sensors with a sample
+ * @param[in]  timestamp_us timestamp of the samples
+ * @param[out] *result pointer to a result buffer, can be NULL
+ * @return     status code
+ *             - 0 success
+ *             - 1 no valid sample
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ * @note       a sensor outside valid counts as failed
+ */
+uint8_t opt300x_fusion_fuse(opt300x_fusion_t *fusion, const uint16_t *raw, uint8_t valid,
+                            uint64_t timestamp_us, opt300x_fusion_result_t *result);
+
+/**
+ * @brief      get the health of a sensor
+ * @param[in]  *fusion pointer to a fusion structure
+ * @param[in]  sensor sensor id
+ * @param[out] *health pointer to a health buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ *             - 4 sensor is invalid
+ * @note       rises towards 1 while the sensor is accepted and falls towards 0 while it fails or is rejected
+ */
+uint8_t opt300x_fusion_get_health(opt300x_fusion_t *fusion, uint8_t sensor, float *health);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
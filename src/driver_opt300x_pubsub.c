@@ -0,0 +1,420 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_pubsub.c
+ * @brief     driver opt300x pubsub source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_opt300x_pubsub.h"
+
+/**
+ * @brief     lock the pubsub
+ * @param[in] *pubsub pointer to a pubsub structure
+ * @note      nothing is done if no lock function is linked
+ */
+static void a_opt300x_pubsub_lock(opt300x_pubsub_t *pubsub)
+{
+    if (pubsub->handle->mutex_lock != NULL)                   /* check mutex_lock */
+    {
+        pubsub->handle->mutex_lock(pubsub->handle->mutex);    /* lock */
+    }
+}
+
+/**
+ * @brief     unlock the pubsub
+ * @param[in] *pubsub pointer to a pubsub structure
+ * @note      nothing is done if no unlock function is linked
+ */
+static void a_opt300x_pubsub_unlock(opt300x_pubsub_t *pubsub)
+{
+    if (pubsub->handle->mutex_unlock != NULL)                   /* check mutex_unlock */
+    {
+        pubsub->handle->mutex_unlock(pubsub->handle->mutex);    /* unlock */
+    }
+}
+
+/**
+ * @brief     fan one sample out to the subscribers
+ * @param[in] *pubsub pointer to a pubsub structure
+ * @param[in] raw raw data
+ * @param[in] data lux or nW/cm2
+ * @param[in] timestamp sample timestamp
+ * @note      the notify functions run after the lock is released
+ */
+static void a_opt300x_pubsub_fan_out(opt300x_pubsub_t *pubsub, uint16_t raw, float data, uint64_t timestamp)
+{
+    uint8_t i;
+    uint8_t k;
+    uint8_t n;
+    float sum;
+    opt300x_subscriber_t *s;
+    opt300x_pubsub_sample_t *q;
+    void (*notify[OPT300X_PUBSUB_MAX_SUBSCRIBER])(uint8_t id);
+    
+    a_opt300x_pubsub_lock(pubsub);                                                                 /* lock */
+    pubsub->history[pubsub->history_pos] = data;                                                   /* save the history */
+    pubsub->history_pos = (uint8_t)((pubsub->history_pos + 1) % OPT300X_PUBSUB_MAX_WINDOW);        /* step the history */
+    if (pubsub->history_num < OPT300X_PUBSUB_MAX_WINDOW)                                           /* check the history */
+    {
+        pubsub->history_num++;                                                                     /* count the history */
+    }
+    pubsub->published++;                                                                           /* count the sample */
+    for (i = 0; i < OPT300X_PUBSUB_MAX_SUBSCRIBER; i++)                                            /* all subscribers */
+    {
+        s = &pubsub->subscriber[i];                                                                /* get the subscriber */
+        notify[i] = NULL;                                                                          /* init null */
+        if (s->used == 0)                                                                          /* check the used flag */
+        {
+            continue;                                                                              /* next */
+        }
+        if (++s->phase < s->decimation)                                                            /* decimate */
+        {
+            continue;                                                                              /* next */
+        }
+        s->phase = 0;                                                                              /* reset the phase */
+        n = (s->window < pubsub->history_num) ? s->window : pubsub->history_num;                   /* get the window */
+        sum = 0.0f;                                                                                /* init 0 */
+        for (k = 0; k < n; k++)                                                                    /* average the newest samples */
+        {
+            sum += pubsub->history[(pubsub->history_pos + OPT300X_PUBSUB_MAX_WINDOW - 1 - k) % 
+                                   OPT300X_PUBSUB_MAX_WINDOW];                                     /* add one sample */
+        }
+        if (s->num == s->depth)                                                                    /* queue is full */
+        {
+            s->num--;                                                                              /* drop the oldest */
+            s->overrun++;                                                                          /* count it */
+        }
+        q = &s->queue[s->head];                                                                    /* get the slot */
+        q->timestamp_us = timestamp;                                                               /* set the timestamp */
+        q->data = sum / (float)n;                                                                  /* set the average */
+        q->raw = raw;                                                                              /* set the raw data */
+        q->count = n;                                                                              /* set the averaged samples */
+        s->head = (uint8_t)((s->head + 1) % s->depth);                                             /* step the head */
+        s->num++;                                                                                  /* count the queued */
+        notify[i] = s->notify;                                                                     /* notify later */
+    }
+    a_opt300x_pubsub_unlock(pubsub);                                                               /* unlock */
+    
+    for (i = 0; i < OPT300X_PUBSUB_MAX_SUBSCRIBER; i++)                                            /* all subscribers */
+    {
+        if (notify[i] != NULL)                                                                     /* check the notify */
+        {
+            notify[i](i);                                                                          /* run the notify */
+        }
+    }
+}
+
+/**
+ * @brief     init the pubsub
+ * @param[in] *pubsub pointer to a pubsub structure
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ * @note      the handle must be inited and in continuous mode before polling
+ */
+uint8_t opt300x_pubsub_init(opt300x_pubsub_t *pubsub, opt300x_handle_t *handle)
+{
+    if ((pubsub == NULL) || (handle == NULL))                  /* check handle */
+    {
+        return 2;                                              /* return error */
+    }
+    if (handle->inited != 1)                                   /* check handle initialization */
+    {
+        return 3;                                              /* return error */
+    }
+    
+    memset(pubsub, 0, sizeof(opt300x_pubsub_t));               /* clear the pubsub */
+    pubsub->handle = handle;                                   /* save the handle */
+    pubsub->inited = 1;                                        /* flag inited */
+    
+    return 0;                                                  /* success return 0 */
+}
+
+/**
+ * @brief      add a subscriber
+ * @param[in]  *pubsub pointer to a pubsub structure
+ * @param[in]  decimation delivers every decimation-th sample, 1 delivers all
+ * @param[in]  window averaging window, 1 disables averaging
+ * @param[in]  depth queue depth
+ * @param[in]  *notify pointer to a notify function, can be NULL
+ * @param[out] *id pointer to a subscriber id buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no free subscriber
+ *             - 2 handle is NULL
+ *             - 3 pubsub is not inited
+ *             - 4 param is invalid
+ * @note       notify runs in the acquisition context after the sample is queued
+ */
+uint8_t opt300x_pubsub_subscribe(opt300x_pubsub_t *pubsub, uint16_t decimation, uint8_t window, uint8_t depth,
+                                 void (*notify)(uint8_t id), uint8_t *id)
+{
+    uint8_t i;
+    opt300x_subscriber_t *s;
+    
+    if (pubsub == NULL)                                                                    /* check handle */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if (pubsub->inited != 1)                                                               /* check pubsub initialization */
+    {
+        return 3;                                                                          /* return error */
+    }
+    if ((decimation == 0) || (window == 0) || (window > OPT300X_PUBSUB_MAX_WINDOW) || 
+        (depth == 0) || (depth > OPT300X_PUBSUB_MAX_DEPTH) || (id == NULL))                /* check the param */
+    {
+        OPT300X_DEBUG_ERROR(pubsub->handle, "opt300x: subscriber param is invalid.\n");    /* subscriber param is invalid */
+        
+        return 4;                                                                          /* return error */
+    }
+    
+    a_opt300x_pubsub_lock(pubsub);                                                         /* lock */
+    for (i = 0; i < OPT300X_PUBSUB_MAX_SUBSCRIBER; i++)                                    /* find a free subscriber */
+    {
+        if (pubsub->subscriber[i].used == 0)                                               /* check the used flag */
+        {
+            break;                                                                         /* found */
+        }
+    }
+    if (i == OPT300X_PUBSUB_MAX_SUBSCRIBER)                                                /* check the result */
+    {
+        a_opt300x_pubsub_unlock(pubsub);                                                   /* unlock */
+        OPT300X_DEBUG_ERROR(pubsub->handle, "opt300x: no free subscriber.\n");             /* no free subscriber */
+        
+        return 1;                                                                          /* return error */
+    }
+    s = &pubsub->subscriber[i];                                                            /* get the subscriber */
+    memset(s, 0, sizeof(opt300x_subscriber_t));                                            /* clear the subscriber */
+    s->decimation = decimation;                                                            /* set the decimation */
+    s->window = window;                                                                    /* set the window */
+    s->depth = depth;                                                                      /* set the depth */
+    s->notify = notify;                                                                    /* set the notify */
+    s->phase = (uint16_t)(decimation - 1);                                                 /* deliver the next sample */
+    s->used = 1;                                                                           /* flag used */
+    a_opt300x_pubsub_unlock(pubsub);                                                       /* unlock */
+    *id = i;                                                                               /* save the id */
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     remove a subscriber
+ * @param[in] *pubsub pointer to a pubsub structure
+ * @param[in] id subscriber id
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 pubsub is not inited
+ *            - 4 id is invalid
+ * @note      none
+ */
+uint8_t opt300x_pubsub_unsubscribe(opt300x_pubsub_t *pubsub, uint8_t id)
+{
+    if (pubsub == NULL)                                            /* check handle */
+    {
+        return 2;                                                  /* return error */
+    }
+    if (pubsub->inited != 1)                                       /* check pubsub initialization */
+    {
+        return 3;                                                  /* return error */
+    }
+    if (id >= OPT300X_PUBSUB_MAX_SUBSCRIBER)                       /* check the id */
+    {
+        return 4;                                                  /* return error */
+    }
+    
+    a_opt300x_pubsub_lock(pubsub);                                 /* lock */
+    pubsub->subscriber[id].used = 0;                               /* flag unused */
+    pubsub->subscriber[id].notify = NULL;                          /* clear the notify */
+    a_opt300x_pubsub_unlock(pubsub);                               /* unlock */
+    
+    return 0;                                                      /* success return 0 */
+}
+
+/**
+ * @brief     read the sensor once and fan the sample out
+ * @param[in] *pubsub pointer to a pubsub structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle is NULL
+ *            - 3 pubsub is not inited
+ * @note      the one acquisition loop of the sensor calls it at the conversion rate
+ */
+uint8_t opt300x_pubsub_poll(opt300x_pubsub_t *pubsub)
+{
+    uint8_t res;
+    uint16_t raw;
+    float data;
+    opt300x_handle_t *handle;
+    
+    if (pubsub == NULL)                                                                           /* check handle */
+    {
+        return 2;                                                                                 /* return error */
+    }
+    if (pubsub->inited != 1)                                                                      /* check pubsub initialization */
+    {
+        return 3;                                                                                 /* return error */
+    }
+    
+    handle = pubsub->handle;                                                                      /* get the handle */
+    if (handle->type == (uint8_t)OPT3002)                                                         /* opt3002 */
+    {
+        res = opt3002_continuous_read(handle, &raw, &data);                                       /* read nW/cm2 */
+    }
+    else
+    {
+        res = opt300x_continuous_read(handle, &raw, &data);                                       /* read lux */
+    }
+    if (res != 0)                                                                                 /* check the result */
+    {
+        a_opt300x_pubsub_lock(pubsub);                                                            /* lock */
+        pubsub->error++;                                                                          /* count the error */
+        a_opt300x_pubsub_unlock(pubsub);                                                          /* unlock */
+        
+        return 1;                                                                                 /* return error */
+    }
+    a_opt300x_pubsub_fan_out(pubsub, raw, data, 
+                             (handle->timestamp_us != NULL) ? handle->timestamp_us() : 0);        /* fan out */
+    
+    return 0;                                                                                     /* success return 0 */
+}
+
+/**
+ * @brief     fan a sample out without reading the sensor
+ * @param[in] *pubsub pointer to a pubsub structure
+ * @param[in] raw raw data
+ * @param[in] data lux or nW/cm2
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 pubsub is not inited
+ * @note      for samples read elsewhere, e.g. in the sample_callback
+ */
+uint8_t opt300x_pubsub_publish(opt300x_pubsub_t *pubsub, uint16_t raw, float data)
+{
+    if (pubsub == NULL)             /* check handle */
+    {
+        return 2;                   /* return error */
+    }
+    if (pubsub->inited != 1)        /* check pubsub initialization */
+    {
+        return 3;                   /* return error */
+    }
+    
+    a_opt300x_pubsub_fan_out(pubsub, raw, data, 
+                             (pubsub->handle->timestamp_us != NULL) ? pubsub->handle->timestamp_us() : 0);
+    
+    return 0;                       /* success return 0 */
+}
+
+/**
+ * @brief      read the oldest queued sample of a subscriber
+ * @param[in]  *pubsub pointer to a pubsub structure
+ * @param[in]  id subscriber id
+ * @param[out] *sample pointer to a sample buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 pubsub is not inited
+ *             - 4 id is invalid
+ *             - 5 queue is empty
+ * @note       none
+ */
+uint8_t opt300x_pubsub_read(opt300x_pubsub_t *pubsub, uint8_t id, opt300x_pubsub_sample_t *sample)
+{
+    opt300x_subscriber_t *s;
+    
+    if (pubsub == NULL)                                                          /* check handle */
+    {
+        return 2;                                                                /* return error */
+    }
+    if (pubsub->inited != 1)                                                     /* check pubsub initialization */
+    {
+        return 3;                                                                /* return error */
+    }
+    if ((id >= OPT300X_PUBSUB_MAX_SUBSCRIBER) || 
+        (pubsub->subscriber[id].used == 0))                                      /* check the id */
+    {
+        return 4;                                                                /* return error */
+    }
+    
+    s = &pubsub->subscriber[id];                                                 /* get the subscriber */
+    a_opt300x_pubsub_lock(pubsub);                                               /* lock */
+    if (s->num == 0)                                                             /* check the queue */
+    {
+        a_opt300x_pubsub_unlock(pubsub);                                         /* unlock */
+        
+        return 5;                                                                /* return error */
+    }
+    *sample = s->queue[(s->head + s->depth - s->num) % s->depth];                /* copy the oldest */
+    s->num--;                                                                    /* pop it */
+    a_opt300x_pubsub_unlock(pubsub);                                             /* unlock */
+    
+    return 0;                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      get the overrun counter of a subscriber
+ * @param[in]  *pubsub pointer to a pubsub structure
+ * @param[in]  id subscriber id
+ * @param[out] *overrun pointer to an overrun buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 pubsub is not inited
+ *             - 4 id is invalid
+ * @note       a full queue drops its oldest sample and counts it
+ */
+uint8_t opt300x_pubsub_get_overrun(opt300x_pubsub_t *pubsub, uint8_t id, uint32_t *overrun)
+{
+    if (pubsub == NULL)                                            /* check handle */
+    {
+        return 2;                                                  /* return error */
+    }
+    if (pubsub->inited != 1)                                       /* check pubsub initialization */
+    {
+        return 3;                                                  /* return error */
+    }
+    if (id >= OPT300X_PUBSUB_MAX_SUBSCRIBER)                       /* check the id */
+    {
+        return 4;                                                  /* return error */
+    }
+    
+    a_opt300x_pubsub_lock(pubsub);                                 /* lock */
+    *overrun = pubsub->subscriber[id].overrun;                     /* get the overrun */
+    a_opt300x_pubsub_unlock(pubsub);                               /* unlock */
+    
+    return 0;                                                      /* success return 0 */
+}
@@ -0,0 +1,224 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_pubsub.h
+ * @brief     driver opt300x pubsub header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_OPT300X_PUBSUB_H
+#define DRIVER_OPT300X_PUBSUB_H
+
+#include "driver_opt300x.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup opt300x_pubsub_driver opt300x pubsub driver function
+ * @brief    opt300x pubsub driver modules
+ * @ingroup  opt300x_driver
+ * @{
+ */
+
+/**
+ * @brief pubsub max subscriber numbers
+ * @note  all memory is static, override these at compile time to fit the target
+ */
+#ifndef OPT300X_PUBSUB_MAX_SUBSCRIBER
+    #define OPT300X_PUBSUB_MAX_SUBSCRIBER 4        /**< 4 subscribers */
+#endif
+
+/**
+ * @brief pubsub max queue depth of one subscriber
+ */
+#ifndef OPT300X_PUBSUB_MAX_DEPTH
+    #define OPT300X_PUBSUB_MAX_DEPTH 8        /**< 8 samples */
+#endif
+
+/**
+ * @brief pubsub max averaging window
+ */
+#ifndef OPT300X_PUBSUB_MAX_WINDOW
+    #define OPT300X_PUBSUB_MAX_WINDOW 16        /**< 16 samples */
+#endif
+
+/**
+ * @brief opt300x pubsub sample structure definition
+ */
+typedef struct opt300x_pubsub_sample_s
+{
+    uint64_t timestamp_us;        /**< timestamp of the newest sample, 0 without timestamp_us */
+    float data;                   /**< averaged lux or nW/cm2 */
+    uint16_t raw;                 /**< newest raw data */
+    uint8_t count;                /**< averaged samples */
+} opt300x_pubsub_sample_t;
+
+/**
+ * @brief opt300x subscriber structure definition
+ */
+typedef struct opt300x_subscriber_s
+{
+    uint8_t used;                                                   /**< used flag */
+    uint8_t window;                                                 /**< averaging window */
+    uint8_t depth;                                                  /**< queue depth */
+    uint8_t head;                                                   /**< queue write position */
+    uint8_t num;                                                    /**< queued samples */
+    uint16_t decimation;                                            /**< delivers every decimation-th sample */
+    uint16_t phase;                                                 /**< decimation phase */
+    uint32_t overrun;                                               /**< samples dropped by a full queue */
+    void (*notify)(uint8_t id);                                     /**< point to a notify function address */
+    opt300x_pubsub_sample_t queue[OPT300X_PUBSUB_MAX_DEPTH];        /**< sample queue */
+} opt300x_subscriber_t;
+
+/**
+ * @brief opt300x pubsub structure definition
+ */
+typedef struct opt300x_pubsub_s
+{
+    opt300x_handle_t *handle;                                              /**< driver handle */
+    uint8_t inited;                                                        /**< inited flag */
+    uint8_t history_pos;                                                   /**< history write position */
+    uint8_t history_num;                                                   /**< history samples */
+    float history[OPT300X_PUBSUB_MAX_WINDOW];                              /**< shared history of the averaging windows */
+    uint32_t published;                                                    /**< published samples */
+    uint32_t error;                                                        /**< failed reads */
+    opt300x_subscriber_t subscriber[OPT300X_PUBSUB_MAX_SUBSCRIBER];        /**< subscribers */
+} opt300x_pubsub_t;
+
+/**
+ * @brief     init the pubsub
+ * @param[in] *pubsub pointer to a pubsub structure
+ * @param[in] *handle pointer to an opt300x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ * @note      the handle must be inited and in continuous mode before polling
+ */
+uint8_t opt300x_pubsub_init(opt300x_pubsub_t *pubsub, opt300x_handle_t *handle);
+
+/**
+ * @brief      add a subscriber
+ * @param[in]  *pubsub pointer to a pubsub structure
+ * @param[in]  decimation delivers every decimation-th sample, 1 delivers all
+ * @param[in]  window averaging window, 1 disables averaging
+ * @param[in]  depth queue depth
+ * @param[in]  *notify pointer to a notify function, can be NULL
+ * @param[out] *id pointer to a subscriber id buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no free subscriber
+ *             - 2 handle is NULL
+ *             - 3 pubsub is not inited
+ *             - 4 param is invalid
+ * @note       notify runs in the acquisition context after the sample is queued
+ */
+uint8_t opt300x_pubsub_subscribe(opt300x_pubsub_t *pubsub, uint16_t decimation, uint8_t window, uint8_t depth,
+                                 void (*notify)(uint8_t id), uint8_t *id);
+
+/**
+ * @brief     remove a subscriber
+ * @param[in] *pubsub pointer to a pubsub structure
+ * @param[in] id subscriber id
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 pubsub is not inited
+ *            - 4 id is invalid
+ * @note      none
+ */
+uint8_t opt300x_pubsub_unsubscribe(opt300x_pubsub_t *pubsub, uint8_t id);
+
+/**
+ * @brief     read the sensor once and fan the sample out
+ * @param[in] *pubsub pointer to a pubsub structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle is NULL
+ *            - 3 pubsub is not inited
+ * @note      the one acquisition loop of the sensor calls it at the conversion rate
+ */
+uint8_t opt300x_pubsub_poll(opt300x_pubsub_t *pubsub);
+
+/**
+ * @brief     fan a sample out without reading the sensor
+ * @param[in] *pubsub pointer to a pubsub structure
+ * @param[in] raw raw data
+ * @param[in] data lux or nW/cm2
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 pubsub is not inited
+ * @note      for samples read elsewhere, e.g. in the sample_callback
+ */
+uint8_t opt300x_pubsub_publish(opt300x_pubsub_t *pubsub, uint16_t raw, float data);
+
+/**
+ * @brief      read the oldest queued sample of a subscriber
+ * @param[in]  *pubsub pointer to a pubsub structure
+ * @param[in]  id subscriber id
+ * @param[out] *sample pointer to a sample buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 pubsub is not inited
+ *             - 4 id is invalid
+ *             - 5 queue is empty
+ * @note       none
+ */
+uint8_t opt300x_pubsub_read(opt300x_pubsub_t *pubsub, uint8_t id, opt300x_pubsub_sample_t *sample);
+
+/**
+ * @brief      get the overrun counter of a subscriber
+ * @param[in]  *pubsub pointer to a pubsub structure
+ * @param[in]  id subscriber id
+ * @param[out] *overrun pointer to an overrun buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 pubsub is not inited
+ *             - 4 id is invalid
+ * @note       a full queue drops its oldest sample and counts it
+ */
+uint8_t opt300x_pubsub_get_overrun(opt300x_pubsub_t *pubsub, uint8_t id, uint32_t *overrun);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,367 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_resample.c
+ * @brief     driver opt300x resample source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_opt300x_resample.h"
+#include <math.h>
+
+/**
+ * @brief     start the grid clock
+ * @param[in] *resample pointer to a resample structure
+ * @param[in] timestamp_us first timestamp
+ * @note      the first grid point is the first multiple of the period at or after the timestamp
+ */
+static void a_opt300x_resample_start(opt300x_resample_t *resample, uint64_t timestamp_us)
+{
+    uint8_t s;
+    
+    resample->next = (timestamp_us + resample->period_us - 1) / resample->period_us;        /* first grid point */
+    for (s = 0; s < resample->sensor_num; s++)                                              /* every sensor */
+    {
+        resample->fill[s] = resample->next;                                                 /* nothing filled */
+    }
+    resample->now_us = timestamp_us;                                                        /* set the time */
+    resample->started = 1;                                                                  /* flag started */
+}
+
+/**
+ * @brief     emit the next frame
+ * @param[in] *resample pointer to a resample structure
+ * @note      the sensors that didn't fill the frame hold their last sample
+ */
+static void a_opt300x_resample_emit(opt300x_resample_t *resample)
+{
+    uint8_t s;
+    uint8_t slot;
+    uint64_t g;
+    opt300x_resample_frame_t *frame = &resample->frame;
+    
+    slot = (uint8_t)(resample->next % OPT300X_RESAMPLE_MAX_DEPTH);                                  /* ring slot */
+    g = resample->next * resample->period_us;                                                       /* grid timestamp */
+    frame->timestamp_us = g;                                                                        /* set the timestamp */
+    frame->sensor_num = resample->sensor_num;                                                       /* set the sensor numbers */
+    for (s = 0; s < resample->sensor_num; s++)                                                      /* every sensor */
+    {
+        if (resample->fill[s] > resample->next)                                                     /* filled */
+        {
+            frame->data[s] = resample->value[slot][s];                                              /* copy the data */
+            frame->flags[s] = resample->flags[slot][s];                                             /* copy the flags */
+        }
+        else if ((resample->sampled[s] != 0) && (g - resample->last_us[s] <= resample->max_gap_us)) /* recent sample */
+        {
+            frame->data[s] = resample->last[s];                                                     /* hold it */
+            frame->flags[s] = OPT300X_RESAMPLE_FLAG_HELD;                                           /* flag held */
+            resample->fill[s] = resample->next + 1;                                                 /* skip the point */
+        }
+        else                                                                                        /* no sample */
+        {
+            frame->data[s] = NAN;                                                                   /* no data */
+            frame->flags[s] = OPT300X_RESAMPLE_FLAG_NONE;                                           /* no flags */
+            resample->fill[s] = resample->next + 1;                                                 /* skip the point */
+        }
+    }
+    resample->next++;                                                                               /* next grid point */
+    resample->frames++;                                                                             /* count the frame */
+    if (resample->emit != NULL)                                                                     /* check the callback */
+    {
+        resample->emit(resample, frame);                                                            /* run the callback */
+    }
+}
+
+/**
+ * @brief     emit the ready frames
+ * @param[in] *resample pointer to a resample structure
+ * @note      a frame is ready once every sensor filled it or once the latency passed
+ */
+static void a_opt300x_resample_flush(opt300x_resample_t *resample)
+{
+    uint8_t s;
+    
+    while (1)
+    {
+        for (s = 0; s < resample->sensor_num; s++)                                                      /* every sensor */
+        {
+            if (resample->fill[s] <= resample->next)                                                    /* not filled */
+            {
+                break;                                                                                  /* break */
+            }
+        }
+        if ((s != resample->sensor_num) &&
+            (resample->next * resample->period_us + resample->latency_us > resample->now_us))           /* wait */
+        {
+            break;                                                                                      /* break */
+        }
+        a_opt300x_resample_emit(resample);                                                              /* emit */
+    }
+}
+
+/**
+ * @brief     init a resampler
+ * @param[in] *resample pointer to a resample structure
+ * @param[in] *type pointer to a chip type table, the index is the sensor id
+ * @param[in] sensor_num sensor numbers
+ * @param[in] mode resample mode
+ * @param[in] period_us grid period, the grid points are multiples of it
+ * @param[in] latency_us longest wait for late sensors after a grid point, below OPT300X_RESAMPLE_MAX_DEPTH periods
+ * @param[in] max_gap_us oldest sample used for a grid point, longer gaps give OPT300X_RESAMPLE_FLAG_NONE
+ * @param[in] *emit pointer to an emit function, can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 param is invalid
+ * @note      emit runs once per grid point in order
+ */
+uint8_t opt300x_resample_init(opt300x_resample_t *resample, const opt300x_t *type, uint8_t sensor_num,
+                              opt300x_resample_mode_t mode, uint64_t period_us, uint64_t latency_us, uint64_t max_gap_us,
+                              void (*emit)(opt300x_resample_t *resample, const opt300x_resample_frame_t *frame))
+{
+    uint8_t s;
+    
+    if (resample == NULL)                                                                  /* check resample */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if ((type == NULL) || (sensor_num == 0) || (sensor_num > OPT300X_RESAMPLE_MAX_SENSOR) ||
+        (mode > OPT300X_RESAMPLE_MODE_LINEAR) || (period_us == 0) ||
+        (latency_us / period_us >= OPT300X_RESAMPLE_MAX_DEPTH))                            /* check the param */
+    {
+        return 4;                                                                          /* return error */
+    }
+    
+    resample->sensor_num = sensor_num;                                                     /* set the sensor numbers */
+    resample->mode = (uint8_t)mode;                                                        /* set the mode */
+    resample->period_us = period_us;                                                       /* set the period */
+    resample->latency_us = latency_us;                                                     /* set the latency */
+    resample->max_gap_us = max_gap_us;                                                     /* set the max gap */
+    resample->emit = emit;                                                                 /* set the callback */
+    for (s = 0; s < sensor_num; s++)                                                       /* every sensor */
+    {
+        if (type[s] == OPT3002)                                                            /* opt3002 */
+        {
+            resample->weight[s] = 1.2f;                                                    /* nW/cm2 */
+        }
+        else if (type[s] == OPT3005)                                                       /* opt3005 */
+        {
+            resample->weight[s] = 0.02f;                                                   /* lux */
+        }
+        else                                                                               /* the others */
+        {
+            resample->weight[s] = 0.01f;                                                   /* lux */
+        }
+        resample->sampled[s] = 0;                                                          /* no samples */
+    }
+    resample->frames = 0;                                                                  /* no frames */
+    resample->started = 0;                                                                 /* clock is stopped */
+    resample->inited = 1;                                                                  /* flag inited */
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     advance the grid clock
+ * @param[in] *resample pointer to a resample structure
+ * @param[in] timestamp_us current timestamp
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ * @note      emits the frames whose latency passed, call it from a timer when a sensor may stop
+ */
+uint8_t opt300x_resample_advance(opt300x_resample_t *resample, uint64_t timestamp_us)
+{
+    if (resample == NULL)                                                      /* check resample */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (resample->inited != 1)                                                 /* check resample initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    
+    if (resample->started == 0)                                                /* first timestamp */
+    {
+        a_opt300x_resample_start(resample, timestamp_us);                      /* start the clock */
+    }
+    if (timestamp_us > resample->now_us)                                       /* newer */
+    {
+        resample->now_us = timestamp_us;                                       /* set the time */
+    }
+    a_opt300x_resample_flush(resample);                                        /* emit the ready frames */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     add one sample
+ * @param[in] *resample pointer to a resample structure
+ * @param[in] sensor sensor id
+ * @param[in] raw raw result word
+ * @param[in] timestamp_us sample timestamp
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 sensor is invalid
+ *            - 5 timestamp is before the last sample of the sensor
+ * @note      the grid points up to the timestamp are filled for this sensor, then the ready frames are emitted
+ */
+uint8_t opt300x_resample_push(opt300x_resample_t *resample, uint8_t sensor, uint16_t raw, uint64_t timestamp_us)
+{
+    float v;
+    
+    if (resample == NULL)                                                                          /* check resample */
+    {
+        return 2;                                                                                  /* return error */
+    }
+    if (resample->inited != 1)                                                                     /* check resample initialization */
+    {
+        return 3;                                                                                  /* return error */
+    }
+    if (sensor >= resample->sensor_num)                                                            /* check the sensor */
+    {
+        return 4;                                                                                  /* return error */
+    }
+    if ((resample->sampled[sensor] != 0) && (timestamp_us < resample->last_us[sensor]))            /* late sample */
+    {
+        return 5;                                                                                  /* return error */
+    }
+    
+    if (resample->started == 0)                                                                    /* first timestamp */
+    {
+        a_opt300x_resample_start(resample, timestamp_us);                                          /* start the clock */
+    }
+    if (timestamp_us > resample->now_us)                                                           /* newer */
+    {
+        resample->now_us = timestamp_us;                                                           /* set the time */
+    }
+    v = resample->weight[sensor] * (float)((uint32_t)(raw & 0x0FFF) << (raw >> 12));               /* convert */
+    while (resample->fill[sensor] * resample->period_us <= timestamp_us)                           /* every grid point passed */
+    {
+        uint8_t slot;
+        uint64_t g;
+        uint64_t last_us = resample->last_us[sensor];
+        
+        if (resample->fill[sensor] >= resample->next + OPT300X_RESAMPLE_MAX_DEPTH)                 /* ring is full */
+        {
+            a_opt300x_resample_emit(resample);                                                     /* emit the oldest */
+        }
+        slot = (uint8_t)(resample->fill[sensor] % OPT300X_RESAMPLE_MAX_DEPTH);                     /* ring slot */
+        g = resample->fill[sensor] * resample->period_us;                                          /* grid timestamp */
+        if (g == timestamp_us)                                                                     /* on the grid */
+        {
+            resample->value[slot][sensor] = v;                                                     /* the sample */
+            resample->flags[slot][sensor] = OPT300X_RESAMPLE_FLAG_VALID;                           /* flag valid */
+        }
+        else if ((resample->sampled[sensor] != 0) && (timestamp_us - last_us <= resample->max_gap_us)) /* between two samples */
+        {
+            if (resample->mode == OPT300X_RESAMPLE_MODE_LINEAR)                                    /* linear */
+            {
+                resample->value[slot][sensor] = resample->last[sensor] + (v - resample->last[sensor]) *
+                                                (float)(g - last_us) / (float)(timestamp_us - last_us);
+            }
+            else                                                                                   /* hold */
+            {
+                resample->value[slot][sensor] = resample->last[sensor];                            /* the sample before */
+            }
+            resample->flags[slot][sensor] = OPT300X_RESAMPLE_FLAG_VALID;                           /* flag valid */
+        }
+        else if ((resample->sampled[sensor] != 0) && (g - last_us <= resample->max_gap_us))        /* in a gap, recent sample */
+        {
+            resample->value[slot][sensor] = resample->last[sensor];                                /* hold it */
+            resample->flags[slot][sensor] = OPT300X_RESAMPLE_FLAG_HELD;                            /* flag held */
+        }
+        else                                                                                       /* no sample */
+        {
+            resample->value[slot][sensor] = NAN;                                                   /* no data */
+            resample->flags[slot][sensor] = OPT300X_RESAMPLE_FLAG_NONE;                            /* no flags */
+        }
+        resample->fill[sensor]++;                                                                  /* next grid point */
+    }
+    resample->last_us[sensor] = timestamp_us;                                                      /* save the timestamp */
+    resample->last[sensor] = v;                                                                    /* save the sample */
+    resample->sampled[sensor] = 1;                                                                 /* flag sampled */
+    a_opt300x_resample_flush(resample);                                                            /* emit the ready frames */
+    
+    return 0;                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     read a sensor and add the sample
+ * @param[in] *resample pointer to a resample structure
+ * @param[in] sensor sensor id
+ * @param[in] *handle pointer to an opt300x handle structure in continuous mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 sensor is invalid or timestamp_us is NULL
+ *            - 5 timestamp is before the last sample of the sensor
+ * @note      the timestamp comes from the timestamp_us hook of the handle, all handles need the same clock
+ */
+uint8_t opt300x_resample_read_push(opt300x_resample_t *resample, uint8_t sensor, opt300x_handle_t *handle)
+{
+    uint8_t res;
+    uint16_t raw;
+    float data;
+    
+    if ((resample == NULL) || (handle == NULL))                                /* check resample and handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if ((resample->inited != 1) || (handle->inited != 1))                      /* check initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    if ((sensor >= resample->sensor_num) || (handle->timestamp_us == NULL))    /* check the sensor and timestamp_us */
+    {
+        return 4;                                                              /* return error */
+    }
+    
+    if (handle->type == (uint8_t)OPT3002)                                      /* opt3002 */
+    {
+        res = opt3002_continuous_read(handle, &raw, &data);                    /* read nW/cm2 */
+    }
+    else                                                                       /* the others */
+    {
+        res = opt300x_continuous_read(handle, &raw, &data);                    /* read lux */
+    }
+    if (res != 0)                                                              /* check the result */
+    {
+        return 1;                                                              /* return error */
+    }
+    
+    return opt300x_resample_push(resample, sensor, raw, handle->timestamp_us()); /* add the sample */
+}
@@ -0,0 +1,198 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_resample.h
+ * @brief     driver opt300x resample header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_OPT300X_RESAMPLE_H
+#define DRIVER_OPT300X_RESAMPLE_H
+
+#include "driver_opt300x.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup opt300x_resample_driver opt300x resample driver function
+ * @brief    opt300x resample driver modules
+ * @ingroup  opt300x_driver
+ * @{
+ */
+
+/**
+ * @brief resample max sensor numbers
+ * @note  all memory is static, override these at compile time to fit the target
+ */
+#ifndef OPT300X_RESAMPLE_MAX_SENSOR
+    #define OPT300X_RESAMPLE_MAX_SENSOR 8        /**< 8 sensors */
+#endif
+
+/**
+ * @brief resample max pending frames
+ */
+#ifndef OPT300X_RESAMPLE_MAX_DEPTH
+    #define OPT300X_RESAMPLE_MAX_DEPTH 16        /**< 16 frames */
+#endif
+
+/**
+ * @brief opt300x resample mode enumeration definition
+ */
+typedef enum
+{
+    OPT300X_RESAMPLE_MODE_HOLD   = 0x00,        /**< zero order hold, the last sample at or before the grid point */
+    OPT300X_RESAMPLE_MODE_LINEAR = 0x01,        /**< linear between the samples around the grid point */
+} opt300x_resample_mode_t;
+
+/**
+ * @brief opt300x resample flag enumeration definition
+ */
+typedef enum
+{
+    OPT300X_RESAMPLE_FLAG_NONE  = 0x00,        /**< no sample within the max gap, data is NAN */
+    OPT300X_RESAMPLE_FLAG_VALID = 0x01,        /**< resampled from the samples around the grid point */
+    OPT300X_RESAMPLE_FLAG_HELD  = 0x02,        /**< no later sample within the latency, the last sample is held */
+} opt300x_resample_flag_t;
+
+/**
+ * @brief opt300x resample frame structure definition
+ */
+typedef struct opt300x_resample_frame_s
+{
+    uint64_t timestamp_us;                              /**< grid timestamp */
+    uint8_t sensor_num;                                 /**< sensor numbers */
+    float data[OPT300X_RESAMPLE_MAX_SENSOR];            /**< lux or nW/cm2 of every sensor */
+    uint8_t flags[OPT300X_RESAMPLE_MAX_SENSOR];         /**< opt300x_resample_flag_t of every sensor */
+} opt300x_resample_frame_t;
+
+/**
+ * @brief opt300x resample structure definition
+ * @note  every sensor fills the grid points up to its last sample into a ring of pending frames,
+ *        a frame is emitted once every sensor filled it or once the latency passed
+ */
+typedef struct opt300x_resample_s
+{
+    uint8_t inited;                                                                              /**< inited flag */
+    uint8_t sensor_num;                                                                          /**< sensor numbers */
+    uint8_t mode;                                                                                /**< resample mode */
+    uint8_t started;                                                                             /**< grid clock started flag */
+    uint64_t period_us;                                                                          /**< grid period */
+    uint64_t latency_us;                                                                         /**< longest wait after a grid point */
+    uint64_t max_gap_us;                                                                         /**< oldest sample used */
+    uint64_t now_us;                                                                             /**< latest timestamp seen */
+    uint64_t next;                                                                               /**< next grid point to emit */
+    uint32_t frames;                                                                             /**< emitted frames */
+    float weight[OPT300X_RESAMPLE_MAX_SENSOR];                                                   /**< lsb weight */
+    uint8_t sampled[OPT300X_RESAMPLE_MAX_SENSOR];                                                /**< first sample flag */
+    uint64_t fill[OPT300X_RESAMPLE_MAX_SENSOR];                                                  /**< next grid point to fill */
+    uint64_t last_us[OPT300X_RESAMPLE_MAX_SENSOR];                                               /**< last sample timestamp */
+    float last[OPT300X_RESAMPLE_MAX_SENSOR];                                                     /**< last sample */
+    float value[OPT300X_RESAMPLE_MAX_DEPTH][OPT300X_RESAMPLE_MAX_SENSOR];                        /**< pending frames */
+    uint8_t flags[OPT300X_RESAMPLE_MAX_DEPTH][OPT300X_RESAMPLE_MAX_SENSOR];                      /**< pending frame flags */
+    opt300x_resample_frame_t frame;                                                              /**< last emitted frame */
+    void (*emit)(struct opt300x_resample_s *resample, const opt300x_resample_frame_t *frame);    /**< point to an emit function address */
+} opt300x_resample_t;
+
+/**
+ * @brief     init a resampler
+ * @param[in] *resample pointer to a resample structure
+ * @param[in] *type pointer to a chip type table, the index is the sensor id
+ * @param[in] sensor_num sensor numbers
+ * @param[in] mode resample mode
+ * @param[in] period_us grid period, the grid points are multiples of it
+ * @param[in] latency_us longest wait for late sensors after a grid point, below OPT300X_RESAMPLE_MAX_DEPTH periods
+ * @param[in] max_gap_us oldest sample used for a grid point, longer gaps give OPT300X_RESAMPLE_FLAG_NONE
+ * @param[in] *emit pointer to an emit function, can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 param is invalid
+ * @note      emit runs once per grid point in order
+ */
+uint8_t opt300x_resample_init(opt300x_resample_t *resample, const opt300x_t *type, uint8_t sensor_num,
+                              opt300x_resample_mode_t mode, uint64_t period_us, uint64_t latency_us, uint64_t max_gap_us,
+                              void (*emit)(opt300x_resample_t *resample, const opt300x_resample_frame_t *frame));
+
+/**
+ * @brief     advance the grid clock
+ * @param[in] *resample pointer to a resample structure
+ * @param[in] timestamp_us current timestamp
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ * @note      emits the frames whose latency passed, call it from a timer when a sensor may stop
+ */
+uint8_t opt300x_resample_advance(opt300x_resample_t *resample, uint64_t timestamp_us);
+
+/**
+ * @brief     add one sample
+ * @param[in] *resample pointer to a resample structure
+ * @param[in] sensor sensor id
+ * @param[in] raw raw result word
+ * @param[in] timestamp_us sample timestamp
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 sensor is invalid
+ *            - 5 timestamp is before the last sample of the sensor
+ * @note      the grid points up to the timestamp are filled for this sensor, then the ready frames are emitted
+ */
+uint8_t opt300x_resample_push(opt300x_resample_t *resample, uint8_t sensor, uint16_t raw, uint64_t timestamp_us);
+
+/**
+ * @brief     read a sensor and add the sample
+ * @param[in] *resample pointer to a resample structure
+ * @param[in] sensor sensor id
+ * @param[in] *handle pointer to an opt300x handle structure in continuous mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 sensor is invalid or timestamp_us is NULL
+ *            - 5 timestamp is before the last sample of the sensor
+ * @note      the timestamp comes from the timestamp_us hook of the handle, all handles need the same clock
+ */
+uint8_t opt300x_resample_read_push(opt300x_resample_t *resample, uint8_t sensor, opt300x_handle_t *handle);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
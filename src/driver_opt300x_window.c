@@ -0,0 +1,358 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_window.c
+ * @brief     driver opt300x window source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_opt300x_window.h"
+
+/**
+ * @brief     clear one pane of all sensors
+ * @param[in] *window pointer to a window structure
+ * @param[in] slot pane slot
+ * @note      none
+ */
+static void a_opt300x_window_clear(opt300x_window_t *window, uint8_t slot)
+{
+    uint8_t s;
+    
+    for (s = 0; s < window->sensor_num; s++)                   /* every sensor */
+    {
+        window->min[slot][s] = 0xFFFFFFFFU;                    /* no min */
+        window->max[slot][s] = 0;                              /* no max */
+        window->count[slot][s] = 0;                            /* no samples */
+        window->sum[slot][s] = 0;                              /* no sum */
+    }
+}
+
+/**
+ * @brief     close the current pane and report the window ending with it
+ * @param[in] *window pointer to a window structure
+ * @note      O(panes) per sensor, the conversion to lux or nW/cm2 happens here only
+ */
+static void a_opt300x_window_close(opt300x_window_t *window)
+{
+    uint8_t p;
+    uint8_t s;
+    
+    for (s = 0; s < window->sensor_num; s++)                                               /* every sensor */
+    {
+        uint32_t min = 0xFFFFFFFFU;
+        uint32_t max = 0;
+        uint32_t count = 0;
+        uint64_t sum = 0;
+        
+        for (p = 0; p < window->panes; p++)                                                /* merge the panes */
+        {
+            min = (window->min[p][s] < min) ? window->min[p][s] : min;                     /* min */
+            max = (window->max[p][s] > max) ? window->max[p][s] : max;                     /* max */
+            count += window->count[p][s];                                                  /* count */
+            sum += window->sum[p][s];                                                      /* sum */
+        }
+        window->result_count[s] = count;                                                   /* set the count */
+        if (count != 0)                                                                    /* has samples */
+        {
+            window->result_min[s] = window->weight[s] * (float)min;                        /* convert the min */
+            window->result_max[s] = window->weight[s] * (float)max;                        /* convert the max */
+            window->result_mean[s] = window->weight[s] * ((float)sum / (float)count);      /* convert the mean */
+        }
+        else                                                                               /* empty */
+        {
+            window->result_min[s] = 0.0f;                                                  /* no min */
+            window->result_max[s] = 0.0f;                                                  /* no max */
+            window->result_mean[s] = 0.0f;                                                 /* no mean */
+        }
+    }
+    window->result_end_us = (window->pane + 1) * window->pane_us;                          /* window end */
+    window->result_start_us = (window->pane + 1 >= window->panes) ?
+                              (window->pane + 1 - window->panes) * window->pane_us : 0;    /* window start */
+    window->closed++;                                                                      /* add the window */
+    if (window->close != NULL)                                                             /* not null */
+    {
+        window->close(window);                                                             /* run the callback */
+    }
+    
+    window->head = (uint8_t)((window->head + 1) % window->panes);                          /* next slot */
+    a_opt300x_window_clear(window, window->head);                                          /* drop the oldest pane */
+    window->pane++;                                                                        /* next pane */
+}
+
+/**
+ * @brief     init a window
+ * @param[in] *window pointer to a window structure
+ * @param[in] *type pointer to a chip type table, the index is the sensor id
+ * @param[in] sensor_num sensor numbers
+ * @param[in] pane_us pane length in us
+ * @param[in] panes panes of one window, 1 is a tumbling window
+ * @param[in] *close pointer to a close function, can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 param is invalid
+ * @note      panes start at multiples of pane_us, close runs once per closed pane with the results of all sensors
+ */
+uint8_t opt300x_window_init(opt300x_window_t *window, const opt300x_t *type, uint8_t sensor_num,
+                            uint64_t pane_us, uint8_t panes, void (*close)(opt300x_window_t *window))
+{
+    uint8_t s;
+    
+    if (window == NULL)                                                                    /* check window */
+    {
+        return 2;                                                                          /* return error */
+    }
+    if ((type == NULL) || (sensor_num == 0) || (sensor_num > OPT300X_WINDOW_MAX_SENSOR) ||
+        (pane_us == 0) || (panes == 0) || (panes > OPT300X_WINDOW_MAX_PANE))               /* check the param */
+    {
+        return 4;                                                                          /* return error */
+    }
+    
+    window->sensor_num = sensor_num;                                                       /* set the sensor numbers */
+    window->panes = panes;                                                                 /* set the panes */
+    window->pane_us = pane_us;                                                             /* set the pane length */
+    window->close = close;                                                                 /* set the callback */
+    for (s = 0; s < sensor_num; s++)                                                       /* set the lsb weight */
+    {
+        if (type[s] == OPT3002)                                                            /* opt3002 */
+        {
+            window->weight[s] = 1.2f;                                                      /* nW/cm2 */
+        }
+        else if (type[s] == OPT3005)                                                       /* opt3005 */
+        {
+            window->weight[s] = 0.02f;                                                     /* lux */
+        }
+        else                                                                               /* the others */
+        {
+            window->weight[s] = 0.01f;                                                     /* lux */
+        }
+    }
+    for (s = 0; s < panes; s++)                                                            /* clear all panes */
+    {
+        a_opt300x_window_clear(window, s);                                                 /* clear the pane */
+    }
+    window->head = 0;                                                                      /* first slot */
+    window->pane = 0;                                                                      /* no pane */
+    window->started = 0;                                                                   /* clock is stopped */
+    window->closed = 0;                                                                    /* no windows */
+    window->inited = 1;                                                                    /* flag inited */
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     advance the pane clock
+ * @param[in] *window pointer to a window structure
+ * @param[in] timestamp_us current timestamp
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ * @note      closes the panes that ended before the timestamp, call it from a timer to close
+ *            windows without samples, the empty windows after a gap longer than the window are skipped
+ */
+uint8_t opt300x_window_advance(opt300x_window_t *window, uint64_t timestamp_us)
+{
+    uint8_t i;
+    uint64_t pane;
+    
+    if (window == NULL)                                                        /* check window */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (window->inited != 1)                                                   /* check window initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    
+    pane = timestamp_us / window->pane_us;                                     /* pane of the timestamp */
+    if (window->started == 0)                                                  /* first timestamp */
+    {
+        window->pane = pane;                                                   /* start the clock */
+        window->started = 1;                                                   /* flag started */
+        
+        return 0;                                                              /* success return 0 */
+    }
+    for (i = 0; (i < window->panes) && (window->pane < pane); i++)             /* every window holding a sample */
+    {
+        a_opt300x_window_close(window);                                        /* close the pane */
+    }
+    if (window->pane < pane)                                                   /* the rest is empty */
+    {
+        window->pane = pane;                                                   /* skip the empty windows */
+    }
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     add one sample
+ * @param[in] *window pointer to a window structure
+ * @param[in] sensor sensor id
+ * @param[in] raw raw result word
+ * @param[in] timestamp_us sample timestamp
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 sensor is invalid
+ *            - 5 timestamp is before the current pane
+ * @note      O(1), the raw word is kept as lsb counts and converted at window close
+ */
+uint8_t opt300x_window_push(opt300x_window_t *window, uint8_t sensor, uint16_t raw, uint64_t timestamp_us)
+{
+    uint8_t slot;
+    uint32_t counts;
+    
+    if (window == NULL)                                                        /* check window */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (window->inited != 1)                                                   /* check window initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    if (sensor >= window->sensor_num)                                          /* check the sensor */
+    {
+        return 4;                                                              /* return error */
+    }
+    
+    (void)opt300x_window_advance(window, timestamp_us);                        /* close the ended panes */
+    if (timestamp_us / window->pane_us < window->pane)                         /* late sample */
+    {
+        return 5;                                                              /* return error */
+    }
+    slot = window->head;                                                       /* current slot */
+    counts = (uint32_t)(raw & 0x0FFF) << (raw >> 12);                          /* lsb counts */
+    if (counts < window->min[slot][sensor])                                    /* new min */
+    {
+        window->min[slot][sensor] = counts;                                    /* set the min */
+    }
+    if (counts > window->max[slot][sensor])                                    /* new max */
+    {
+        window->max[slot][sensor] = counts;                                    /* set the max */
+    }
+    window->count[slot][sensor]++;                                             /* add the sample */
+    window->sum[slot][sensor] += counts;                                       /* add the counts */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     read a sensor and add the sample
+ * @param[in] *window pointer to a window structure
+ * @param[in] sensor sensor id
+ * @param[in] *handle pointer to an opt300x handle structure in continuous mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 sensor is invalid or timestamp_us is NULL
+ *            - 5 timestamp is before the current pane
+ * @note      the timestamp comes from the timestamp_us hook of the handle
+ */
+uint8_t opt300x_window_read_push(opt300x_window_t *window, uint8_t sensor, opt300x_handle_t *handle)
+{
+    uint8_t res;
+    uint16_t raw;
+    float data;
+    
+    if ((window == NULL) || (handle == NULL))                                  /* check window and handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if ((window->inited != 1) || (handle->inited != 1))                        /* check initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    if ((sensor >= window->sensor_num) || (handle->timestamp_us == NULL))      /* check the sensor and timestamp_us */
+    {
+        return 4;                                                              /* return error */
+    }
+    
+    if (handle->type == (uint8_t)OPT3002)                                      /* opt3002 */
+    {
+        res = opt3002_continuous_read(handle, &raw, &data);                    /* read nW/cm2 */
+    }
+    else                                                                       /* the others */
+    {
+        res = opt300x_continuous_read(handle, &raw, &data);                    /* read lux */
+    }
+    if (res != 0)                                                              /* check the result */
+    {
+        return 1;                                                              /* return error */
+    }
+    
+    return opt300x_window_push(window, sensor, raw, handle->timestamp_us());   /* add the sample */
+}
+
+/**
+ * @brief      get the last closed window of a sensor
+ * @param[in]  *window pointer to a window structure
+ * @param[in]  sensor sensor id
+ * @param[out] *result pointer to a result buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ *             - 4 sensor is invalid
+ *             - 5 no window is closed
+ * @note       count is 0 and min, max and mean are 0 when the window has no samples
+ */
+uint8_t opt300x_window_get_result(opt300x_window_t *window, uint8_t sensor, opt300x_window_result_t *result)
+{
+    if ((window == NULL) || (result == NULL))                                  /* check window and result */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (window->inited != 1)                                                   /* check window initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    if (sensor >= window->sensor_num)                                          /* check the sensor */
+    {
+        return 4;                                                              /* return error */
+    }
+    if (window->closed == 0)                                                   /* no window */
+    {
+        return 5;                                                              /* return error */
+    }
+    
+    result->start_us = window->result_start_us;                                /* set the start */
+    result->end_us = window->result_end_us;                                    /* set the end */
+    result->count = window->result_count[sensor];                              /* set the count */
+    result->min = window->result_min[sensor];                                  /* set the min */
+    result->max = window->result_max[sensor];                                  /* set the max */
+    result->mean = window->result_mean[sensor];                                /* set the mean */
+    
+    return 0;                                                                  /* success return 0 */
+}
@@ -0,0 +1,195 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_window.h
+ * @brief     driver opt300x window header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_OPT300X_WINDOW_H
+#define DRIVER_OPT300X_WINDOW_H
+
+#include "driver_opt300x.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup opt300x_window_driver opt300x window driver function
+ * @brief    opt300x window driver modules
+ * @ingroup  opt300x_driver
+ * @{
+ */
+
+/**
+ * @brief window max sensor numbers
+ * @note  all memory is static, override these at compile time to fit the target
+ */
+#ifndef OPT300X_WINDOW_MAX_SENSOR
+    #define OPT300X_WINDOW_MAX_SENSOR 8        /**< 8 sensors */
+#endif
+
+/**
+ * @brief window max panes of one window
+ */
+#ifndef OPT300X_WINDOW_MAX_PANE
+    #define OPT300X_WINDOW_MAX_PANE 16        /**< 16 panes */
+#endif
+
+/**
+ * @brief opt300x window result structure definition
+ */
+typedef struct opt300x_window_result_s
+{
+    uint64_t start_us;        /**< window start */
+    uint64_t end_us;          /**< window end */
+    uint32_t count;           /**< samples in the window */
+    float min;                /**< min lux or nW/cm2 */
+    float max;                /**< max lux or nW/cm2 */
+    float mean;               /**< mean lux or nW/cm2 */
+} opt300x_window_result_t;
+
+/**
+ * @brief opt300x window structure definition
+ * @note  a window is the last panes panes of pane_us each, one pane is a tumbling window,
+ *        several panes slide by one pane, the panes keep lsb counts in a [pane][sensor] layout
+ */
+typedef struct opt300x_window_s
+{
+    uint8_t inited;                                                              /**< inited flag */
+    uint8_t sensor_num;                                                          /**< sensor numbers */
+    uint8_t panes;                                                               /**< panes of one window */
+    uint8_t head;                                                                /**< current pane slot */
+    uint8_t started;                                                             /**< pane clock started flag */
+    uint64_t pane_us;                                                            /**< pane length */
+    uint64_t pane;                                                               /**< current pane number */
+    float weight[OPT300X_WINDOW_MAX_SENSOR];                                     /**< lsb weight */
+    uint32_t min[OPT300X_WINDOW_MAX_PANE][OPT300X_WINDOW_MAX_SENSOR];            /**< pane min lsb counts */
+    uint32_t max[OPT300X_WINDOW_MAX_PANE][OPT300X_WINDOW_MAX_SENSOR];            /**< pane max lsb counts */
+    uint32_t count[OPT300X_WINDOW_MAX_PANE][OPT300X_WINDOW_MAX_SENSOR];          /**< pane samples */
+    uint64_t sum[OPT300X_WINDOW_MAX_PANE][OPT300X_WINDOW_MAX_SENSOR];            /**< pane sum of lsb counts */
+    uint64_t result_start_us;                                                    /**< closed window start */
+    uint64_t result_end_us;                                                      /**< closed window end */
+    uint32_t result_count[OPT300X_WINDOW_MAX_SENSOR];                            /**< closed window samples */
+    float result_min[OPT300X_WINDOW_MAX_SENSOR];                                 /**< closed window min */
+    float result_max[OPT300X_WINDOW_MAX_SENSOR];                                 /**< closed window max */
+    float result_mean[OPT300X_WINDOW_MAX_SENSOR];                                /**< closed window mean */
+    uint32_t closed;                                                             /**< closed windows */
+    void (*close)(struct opt300x_window_s *window);                              /**< point to a close function address */
+} opt300x_window_t;
+
+/**
+ * @brief     init a window
+ * @param[in] *window pointer to a window structure
+ * @param[in] *type pointer to a chip type table, the index is the sensor id
+ * @param[in] sensor_num sensor numbers
+ * @param[in] pane_us pane length in us
+ * @param[in] panes panes of one window, 1 is a tumbling window
+ * @param[in] *close pointer to a close function, can be NULL
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 param is invalid
+ * @note      panes start at multiples of pane_us, close runs once per closed pane with the results of all sensors
+ */
+uint8_t opt300x_window_init(opt300x_window_t *window, const opt300x_t *type, uint8_t sensor_num,
+                            uint64_t pane_us, uint8_t panes, void (*close)(opt300x_window_t *window));
+
+/**
+ * @brief     advance the pane clock
+ * @param[in] *window pointer to a window structure
+ * @param[in] timestamp_us current timestamp
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ * @note      closes the panes that ended before the timestamp, call it from a timer to close
+ *            windows without samples, the empty windows after a gap longer than the window are skipped
+ */
+uint8_t opt300x_window_advance(opt300x_window_t *window, uint64_t timestamp_us);
+
+/**
+ * @brief     add one sample
+ * @param[in] *window pointer to a window structure
+ * @param[in] sensor sensor id
+ * @param[in] raw raw result word
+ * @param[in] timestamp_us sample timestamp
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 sensor is invalid
+ *            - 5 timestamp is before the current pane
+ * @note      O(1), the raw word is kept as lsb counts and converted at window close
+ */
+uint8_t opt300x_window_push(opt300x_window_t *window, uint8_t sensor, uint16_t raw, uint64_t timestamp_us);
+
+/**
+ * @brief     read a sensor and add the sample
+ * @param[in] *window pointer to a window structure
+ * @param[in] sensor sensor id
+ * @param[in] *handle pointer to an opt300x handle structure in continuous mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not inited
+ *            - 4 sensor is invalid or timestamp_us is NULL
+ *            - 5 timestamp is before the current pane
+ * @note      the timestamp comes from the timestamp_us hook of the handle
+ */
+uint8_t opt300x_window_read_push(opt300x_window_t *window, uint8_t sensor, opt300x_handle_t *handle);
+
+/**
+ * @brief      get the last closed window of a sensor
+ * @param[in]  *window pointer to a window structure
+ * @param[in]  sensor sensor id
+ * @param[out] *result pointer to a result buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not inited
+ *             - 4 sensor is invalid
+ *             - 5 no window is closed
+ * @note       count is 0 and min, max and mean are 0 when the window has no samples
+ */
+uint8_t opt300x_window_get_result(opt300x_window_t *window, uint8_t sensor, opt300x_window_result_t *result);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,457 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_calib_test.c
+ * @brief     driver opt300x calib test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_opt300x_calib_test.h"
+
+static opt300x_handle_t gs_handle;                                               /**< opt300x handle never inited */
+static opt300x_calib_t gs_calib;                                                 /**< calib */
+static opt300x_calib_t gs_calib_load;                                            /**< loaded calib */
+static opt300x_calib_t gs_calib_idle;                                            /**< calib never inited */
+static uint8_t gs_blob[OPT300X_CALIB_BLOB_SIZE(OPT300X_CALIB_MAX_POINT)];        /**< blob */
+
+/**
+ * @brief     check a float
+ * @param[in] a checked value
+ * @param[in] b expected value
+ * @return    status code
+ *            - 0 equal
+ *            - 1 not equal
+ * @note      none
+ */
+static uint8_t a_opt300x_calib_test_near(float a, float b)
+{
+    float diff = (a > b) ? (a - b) : (b - a);
+    float limit = ((b > 0.0f) ? b : -b) * 1e-4f + 1e-6f;
+    
+    return (diff <= limit) ? 0 : 1;
+}
+
+/**
+ * @brief     check a calibrated raw word
+ * @param[in] *calib pointer to a calib structure
+ * @param[in] raw raw result word
+ * @param[in] expect expected data
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_opt300x_calib_test_apply(opt300x_calib_t *calib, uint16_t raw, float expect)
+{
+    float data;
+    
+    if (opt300x_calib_apply(calib, raw, &data) != 0)
+    {
+        return 1;
+    }
+    
+    return a_opt300x_calib_test_near(data, expect);
+}
+
+/**
+ * @brief  calib test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   none
+ */
+uint8_t opt300x_calib_test(void)
+{
+    uint8_t res;
+    uint16_t raw;
+    uint32_t len;
+    float data;
+    float nan;
+    opt300x_info_t info;
+    float batch[3];
+    const uint16_t batch_raw[3] = {0x0064, 0x1064, 0xC000};
+    const float curve_in[3] = {0.0f, 100.0f, 200.0f};
+    const float curve_out[3] = {0.0f, 50.0f, 100.0f};
+    const float curve_bad[3] = {0.0f, 100.0f, 100.0f};
+    const float knee_in[3] = {0.0f, 21.0f, 201.0f};
+    const float knee_out[3] = {0.0f, 42.0f, 222.0f};
+    
+    /* get chip information */
+    res = opt300x_info(&info);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get info failed.\n");
+        
+        return 1;
+    }
+    else
+    {
+        /* print chip information */
+        opt300x_interface_debug_print("opt300x: chip is %s.\n", info.chip_name);
+        opt300x_interface_debug_print("opt300x: manufacturer is %s.\n", info.manufacturer_name);
+        opt300x_interface_debug_print("opt300x: interface is %s.\n", info.interface);
+        opt300x_interface_debug_print("opt300x: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        opt300x_interface_debug_print("opt300x: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        opt300x_interface_debug_print("opt300x: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        opt300x_interface_debug_print("opt300x: max current is %0.2fmA.\n", info.max_current_ma);
+        opt300x_interface_debug_print("opt300x: max temperature is %0.1fC.\n", info.temperature_max);
+        opt300x_interface_debug_print("opt300x: min temperature is %0.1fC.\n", info.temperature_min);
+    }
+    
+    /* start calib test */
+    opt300x_interface_debug_print("opt300x: start calib test.\n");
+    
+    /* opt300x_calib_init test */
+    opt300x_interface_debug_print("opt300x: opt300x_calib_init test.\n");
+    res = opt300x_calib_init(NULL, OPT3001);
+    opt300x_interface_debug_print("opt300x: check null calib %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_calib_init(&gs_calib, OPT3007);
+    opt300x_interface_debug_print("opt300x: check invalid type %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_calib_init(&gs_calib, OPT3002);
+    if ((res != 0) || (a_opt300x_calib_test_apply(&gs_calib, 0x1064, 240.0f) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: check opt3002 error.\n");
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check opt3002 ok.\n");
+    res = opt300x_calib_init(&gs_calib, OPT3001);
+    if ((res != 0) || (a_opt300x_calib_test_apply(&gs_calib, 0x1064, 2.0f) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: check init error.\n");
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check init ok.\n");
+    
+    /* opt300x_calib_apply test */
+    opt300x_interface_debug_print("opt300x: opt300x_calib_apply test.\n");
+    res = opt300x_calib_apply(NULL, 0x1064, &data);
+    opt300x_interface_debug_print("opt300x: check null calib %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_calib_apply(&gs_calib, 0x1064, NULL);
+    opt300x_interface_debug_print("opt300x: check null data %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_calib_apply(&gs_calib_idle, 0x1064, &data);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    res = opt300x_calib_apply(&gs_calib, 0xC000, &nan);
+    opt300x_interface_debug_print("opt300x: check reserved exponent %s.\n", ((res == 0) && (nan != nan)) ? "ok" : "error");
+    if ((res != 0) || (nan == nan))
+    {
+        return 1;
+    }
+    
+    /* opt300x_calib_set_linear test */
+    opt300x_interface_debug_print("opt300x: opt300x_calib_set_linear test.\n");
+    res = opt300x_calib_set_linear(NULL, 2.0f, 1.0f);
+    opt300x_interface_debug_print("opt300x: check null calib %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_calib_set_linear(&gs_calib_idle, 2.0f, 1.0f);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    res = opt300x_calib_set_linear(&gs_calib, nan, 1.0f);
+    opt300x_interface_debug_print("opt300x: check nan gain %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_calib_set_linear(&gs_calib, 2.0f, nan);
+    opt300x_interface_debug_print("opt300x: check nan offset %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_calib_set_linear(&gs_calib, 2.0f, 1.0f);
+    if ((res != 0) || (a_opt300x_calib_test_apply(&gs_calib, 0x1064, 5.0f) != 0) ||
+        (a_opt300x_calib_test_apply(&gs_calib, 0x0064, 3.0f) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: check gain and offset error.\n");
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check gain and offset ok.\n");
+    
+    /* opt300x_calib_set_curve test */
+    opt300x_interface_debug_print("opt300x: opt300x_calib_set_curve test.\n");
+    res = opt300x_calib_set_curve(NULL, curve_in, curve_out, 3);
+    opt300x_interface_debug_print("opt300x: check null calib %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_calib_set_curve(&gs_calib_idle, curve_in, curve_out, 3);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    res = opt300x_calib_set_curve(&gs_calib, NULL, curve_out, 3);
+    opt300x_interface_debug_print("opt300x: check null input %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_calib_set_curve(&gs_calib, curve_in, NULL, 3);
+    opt300x_interface_debug_print("opt300x: check null output %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_calib_set_curve(&gs_calib, curve_in, curve_out, 1);
+    opt300x_interface_debug_print("opt300x: check one point %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_calib_set_curve(&gs_calib, curve_in, curve_out, OPT300X_CALIB_MAX_POINT + 1);
+    opt300x_interface_debug_print("opt300x: check too many points %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_calib_set_curve(&gs_calib, curve_bad, curve_out, 3);
+    opt300x_interface_debug_print("opt300x: check not ascending %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_calib_set_curve(&gs_calib, curve_in, curve_out, 3);
+    if ((res != 0) || (a_opt300x_calib_test_apply(&gs_calib, 0x1064, 2.5f) != 0) ||
+        (a_opt300x_calib_test_apply(&gs_calib, 0x0064, 1.5f) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: check curve error.\n");
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check curve ok.\n");
+    res = opt300x_calib_set_curve(&gs_calib, knee_in, knee_out, 3);
+    if ((res != 0) || (a_opt300x_calib_test_apply(&gs_calib, 0x0064, 6.0f) != 0) ||
+        (a_opt300x_calib_test_apply(&gs_calib, 0x03E8, 42.0f) != 0) ||
+        (a_opt300x_calib_test_apply(&gs_calib, 0x07D0, 62.0f) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: check knee inside an exponent error.\n");
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check knee inside an exponent ok.\n");
+    res = opt300x_calib_set_curve(&gs_calib, curve_in, curve_out, 3);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set curve failed.\n");
+        
+        return 1;
+    }
+    
+    /* opt300x_calib_apply_batch test */
+    opt300x_interface_debug_print("opt300x: opt300x_calib_apply_batch test.\n");
+    res = opt300x_calib_apply_batch(NULL, batch_raw, batch, 3);
+    opt300x_interface_debug_print("opt300x: check null calib %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_calib_apply_batch(&gs_calib, NULL, batch, 3);
+    opt300x_interface_debug_print("opt300x: check null raw %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_calib_apply_batch(&gs_calib, batch_raw, NULL, 3);
+    opt300x_interface_debug_print("opt300x: check null data %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_calib_apply_batch(&gs_calib_idle, batch_raw, batch, 3);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    res = opt300x_calib_apply_batch(&gs_calib, batch_raw, batch, 3);
+    if ((res != 0) || (a_opt300x_calib_test_near(batch[0], 1.5f) != 0) ||
+        (a_opt300x_calib_test_near(batch[1], 2.5f) != 0) || (batch[2] == batch[2]))
+    {
+        opt300x_interface_debug_print("opt300x: check batch error.\n");
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check batch ok.\n");
+    
+    /* opt300x_calib_read test */
+    opt300x_interface_debug_print("opt300x: opt300x_calib_read test.\n");
+    res = opt300x_calib_read(NULL, &gs_handle, &raw, &data);
+    opt300x_interface_debug_print("opt300x: check null calib %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_calib_read(&gs_calib, NULL, &raw, &data);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_calib_read(&gs_calib, &gs_handle, NULL, &data);
+    opt300x_interface_debug_print("opt300x: check null raw %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_calib_read(&gs_calib, &gs_handle, &raw, NULL);
+    opt300x_interface_debug_print("opt300x: check null data %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_calib_read(&gs_calib, &gs_handle, &raw, &data);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    
+    /* opt300x_calib_save test */
+    opt300x_interface_debug_print("opt300x: opt300x_calib_save test.\n");
+    res = opt300x_calib_save(NULL, gs_blob, sizeof(gs_blob), &len);
+    opt300x_interface_debug_print("opt300x: check null calib %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_calib_save(&gs_calib, NULL, sizeof(gs_blob), &len);
+    opt300x_interface_debug_print("opt300x: check null buffer %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_calib_save(&gs_calib, gs_blob, sizeof(gs_blob), NULL);
+    opt300x_interface_debug_print("opt300x: check null length %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_calib_save(&gs_calib_idle, gs_blob, sizeof(gs_blob), &len);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    res = opt300x_calib_save(&gs_calib, gs_blob, OPT300X_CALIB_BLOB_SIZE(3) - 1, &len);
+    opt300x_interface_debug_print("opt300x: check short buffer %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_calib_save(&gs_calib, gs_blob, sizeof(gs_blob), &len);
+    opt300x_interface_debug_print("opt300x: check save %s.\n", ((res == 0) && (len == OPT300X_CALIB_BLOB_SIZE(3))) ? "ok" : "error");
+    if ((res != 0) || (len != OPT300X_CALIB_BLOB_SIZE(3)))
+    {
+        return 1;
+    }
+    
+    /* opt300x_calib_load test */
+    opt300x_interface_debug_print("opt300x: opt300x_calib_load test.\n");
+    res = opt300x_calib_load(NULL, gs_blob, len);
+    opt300x_interface_debug_print("opt300x: check null calib %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_calib_load(&gs_calib_load, NULL, len);
+    opt300x_interface_debug_print("opt300x: check null buffer %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_calib_load(&gs_calib_load, gs_blob, len - 1);
+    opt300x_interface_debug_print("opt300x: check short blob %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    gs_blob[8] ^= 0x01;
+    res = opt300x_calib_load(&gs_calib_load, gs_blob, len);
+    gs_blob[8] ^= 0x01;
+    opt300x_interface_debug_print("opt300x: check broken blob %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_calib_load(&gs_calib_load, gs_blob, len);
+    if ((res != 0) || (a_opt300x_calib_test_apply(&gs_calib_load, 0x1064, 2.5f) != 0) ||
+        (a_opt300x_calib_test_apply(&gs_calib_load, 0x0064, 1.5f) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: check load error.\n");
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check load ok.\n");
+    
+    /* remove the curve */
+    res = opt300x_calib_set_curve(&gs_calib, NULL, NULL, 0);
+    if ((res != 0) || (a_opt300x_calib_test_apply(&gs_calib, 0x1064, 5.0f) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: check no curve error.\n");
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check no curve ok.\n");
+    
+    /* finish calib test */
+    opt300x_interface_debug_print("opt300x: finish calib test.\n");
+    
+    return 0;
+}
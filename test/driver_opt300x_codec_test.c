@@ -0,0 +1,411 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_codec_test.c
+ * @brief     driver opt300x codec test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_opt300x_codec_test.h"
+
+/**
+ * @brief codec test definition
+ */
+#define OPT300X_CODEC_TEST_NUM        300        /**< test samples */
+#define OPT300X_CODEC_TEST_BLOCK      64         /**< samples per block */
+
+static uint16_t gs_raw[OPT300X_CODEC_TEST_NUM];                                           /**< source raw words */
+static uint16_t gs_check[OPT300X_CODEC_TEST_NUM];                                         /**< decoded raw words */
+static uint8_t gs_stream[OPT300X_CODEC_BOUND(OPT300X_CODEC_TEST_NUM) * 3];                /**< encoded stream */
+static opt300x_codec_encoder_t gs_encoder;                                                /**< encoder */
+
+/**
+ * @brief  make the test raw words
+ * @note   a slow noisy ramp with range changes and a constant tail
+ */
+static void a_opt300x_codec_test_make(void)
+{
+    uint32_t i;
+    uint32_t seed = 1;
+    
+    for (i = 0; i < OPT300X_CODEC_TEST_NUM; i++)
+    {
+        uint32_t exponent = (i / 60) % 4;
+        uint32_t mantissa;
+        
+        seed = seed * 1103515245U + 12345U;
+        mantissa = 1500 + (i % 60) * 20 + ((seed >> 16) % 9);
+        if (i >= OPT300X_CODEC_TEST_NUM - 40)
+        {
+            exponent = 2;
+            mantissa = 3000;
+        }
+        gs_raw[i] = (uint16_t)((exponent << 12) | (mantissa & 0x0FFF));
+    }
+}
+
+/**
+ * @brief     encode the test raw words with the encoder and decode them
+ * @param[in] mode codec mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      none
+ */
+static uint8_t a_opt300x_codec_test_stream(opt300x_codec_mode_t mode)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t len;
+    uint32_t total;
+    uint32_t num;
+    
+    res = opt300x_codec_encoder_init(&gs_encoder, mode, OPT300X_CODEC_TEST_BLOCK);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: encoder init failed.\n");
+        
+        return 1;
+    }
+    total = 0;
+    for (i = 0; i < OPT300X_CODEC_TEST_NUM; i++)
+    {
+        res = opt300x_codec_encode(&gs_encoder, gs_raw[i], gs_stream + total, sizeof(gs_stream) - total, &len);
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: encode failed.\n");
+            
+            return 1;
+        }
+        total += len;
+    }
+    res = opt300x_codec_encoder_flush(&gs_encoder, gs_stream + total, sizeof(gs_stream) - total, &len);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: flush failed.\n");
+        
+        return 1;
+    }
+    total += len;
+    opt300x_interface_debug_print("opt300x: %d samples are encoded to %d bytes.\n", OPT300X_CODEC_TEST_NUM, (int)total);
+    opt300x_interface_debug_print("opt300x: check size %s.\n", (total < OPT300X_CODEC_TEST_NUM * 2) ? "ok" : "error");
+    if (total >= OPT300X_CODEC_TEST_NUM * 2)
+    {
+        return 1;
+    }
+    res = opt300x_codec_decode(gs_stream, total, gs_check, OPT300X_CODEC_TEST_NUM, &num);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: decode failed.\n");
+        
+        return 1;
+    }
+    for (i = 0; i < OPT300X_CODEC_TEST_NUM; i++)
+    {
+        if (gs_check[i] != gs_raw[i])
+        {
+            break;
+        }
+    }
+    opt300x_interface_debug_print("opt300x: check round trip %s.\n",
+                                  ((num == OPT300X_CODEC_TEST_NUM) && (i == OPT300X_CODEC_TEST_NUM)) ? "ok" : "error");
+    if ((num != OPT300X_CODEC_TEST_NUM) || (i != OPT300X_CODEC_TEST_NUM))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  codec test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   none
+ */
+uint8_t opt300x_codec_test(void)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t len;
+    uint32_t num;
+    opt300x_info_t info;
+    
+    /* get chip information */
+    res = opt300x_info(&info);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get info failed.\n");
+        
+        return 1;
+    }
+    else
+    {
+        /* print chip information */
+        opt300x_interface_debug_print("opt300x: chip is %s.\n", info.chip_name);
+        opt300x_interface_debug_print("opt300x: manufacturer is %s.\n", info.manufacturer_name);
+        opt300x_interface_debug_print("opt300x: interface is %s.\n", info.interface);
+        opt300x_interface_debug_print("opt300x: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        opt300x_interface_debug_print("opt300x: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        opt300x_interface_debug_print("opt300x: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        opt300x_interface_debug_print("opt300x: max current is %0.2fmA.\n", info.max_current_ma);
+        opt300x_interface_debug_print("opt300x: max temperature is %0.1fC.\n", info.temperature_max);
+        opt300x_interface_debug_print("opt300x: min temperature is %0.1fC.\n", info.temperature_min);
+    }
+    
+    /* start codec test */
+    opt300x_interface_debug_print("opt300x: start codec test.\n");
+    a_opt300x_codec_test_make();
+    
+    /* opt300x_codec_encode_block test */
+    opt300x_interface_debug_print("opt300x: opt300x_codec_encode_block test.\n");
+    res = opt300x_codec_encode_block(OPT300X_CODEC_MODE_AUTO, NULL, 1, gs_stream, sizeof(gs_stream), &len);
+    opt300x_interface_debug_print("opt300x: check null raw %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_codec_encode_block(OPT300X_CODEC_MODE_AUTO, gs_raw, 1, NULL, sizeof(gs_stream), &len);
+    opt300x_interface_debug_print("opt300x: check null out %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_codec_encode_block(OPT300X_CODEC_MODE_AUTO, gs_raw, 1, gs_stream, sizeof(gs_stream), NULL);
+    opt300x_interface_debug_print("opt300x: check null len %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_codec_encode_block(OPT300X_CODEC_MODE_AUTO, gs_raw, 0, gs_stream, sizeof(gs_stream), &len);
+    opt300x_interface_debug_print("opt300x: check no sample %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_codec_encode_block(OPT300X_CODEC_MODE_AUTO, gs_raw, OPT300X_CODEC_TEST_NUM, gs_stream, 8, &len);
+    opt300x_interface_debug_print("opt300x: check small output %s.\n", (res == 5) ? "ok" : "error");
+    if (res != 5)
+    {
+        return 1;
+    }
+    res = opt300x_codec_encode_block(OPT300X_CODEC_MODE_VARINT, gs_raw, OPT300X_CODEC_TEST_NUM, gs_stream,
+                                     OPT300X_CODEC_BOUND(OPT300X_CODEC_TEST_NUM), &len);
+    opt300x_interface_debug_print("opt300x: check varint bound %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    res = opt300x_codec_encode_block(OPT300X_CODEC_MODE_AUTO, gs_raw, OPT300X_CODEC_TEST_NUM, gs_stream,
+                                     OPT300X_CODEC_BOUND(OPT300X_CODEC_TEST_NUM), &len);
+    opt300x_interface_debug_print("opt300x: check auto bound %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* opt300x_codec_decode test */
+    opt300x_interface_debug_print("opt300x: opt300x_codec_decode test.\n");
+    res = opt300x_codec_decode(NULL, len, gs_check, OPT300X_CODEC_TEST_NUM, &num);
+    opt300x_interface_debug_print("opt300x: check null in %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_codec_decode(gs_stream, len, NULL, OPT300X_CODEC_TEST_NUM, &num);
+    opt300x_interface_debug_print("opt300x: check null raw %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_codec_decode(gs_stream, len, gs_check, OPT300X_CODEC_TEST_NUM, NULL);
+    opt300x_interface_debug_print("opt300x: check null num %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_codec_decode(gs_stream, len - 1, gs_check, OPT300X_CODEC_TEST_NUM, &num);
+    opt300x_interface_debug_print("opt300x: check truncated stream %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_codec_decode(gs_stream, len, gs_check, OPT300X_CODEC_TEST_NUM - 1, &num);
+    opt300x_interface_debug_print("opt300x: check small raw buffer %s.\n", (res == 5) ? "ok" : "error");
+    if (res != 5)
+    {
+        return 1;
+    }
+    res = opt300x_codec_decode(gs_stream, len, gs_check, OPT300X_CODEC_TEST_NUM, &num);
+    for (i = 0; i < OPT300X_CODEC_TEST_NUM; i++)
+    {
+        if (gs_check[i] != gs_raw[i])
+        {
+            break;
+        }
+    }
+    opt300x_interface_debug_print("opt300x: check block round trip %s.\n",
+                                  ((res == 0) && (num == OPT300X_CODEC_TEST_NUM) && (i == OPT300X_CODEC_TEST_NUM)) ? "ok" : "error");
+    if ((res != 0) || (num != OPT300X_CODEC_TEST_NUM) || (i != OPT300X_CODEC_TEST_NUM))
+    {
+        return 1;
+    }
+    res = opt300x_codec_decode(gs_stream, 0, gs_check, OPT300X_CODEC_TEST_NUM, &num);
+    opt300x_interface_debug_print("opt300x: check empty stream %s.\n", ((res == 0) && (num == 0)) ? "ok" : "error");
+    if ((res != 0) || (num != 0))
+    {
+        return 1;
+    }
+    
+    /* opt300x_codec_encoder_init test */
+    opt300x_interface_debug_print("opt300x: opt300x_codec_encoder_init test.\n");
+    res = opt300x_codec_encoder_init(NULL, OPT300X_CODEC_MODE_AUTO, OPT300X_CODEC_TEST_BLOCK);
+    opt300x_interface_debug_print("opt300x: check null encoder %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_codec_encoder_init(&gs_encoder, OPT300X_CODEC_MODE_AUTO, 0);
+    opt300x_interface_debug_print("opt300x: check empty block %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_codec_encoder_init(&gs_encoder, OPT300X_CODEC_MODE_AUTO, OPT300X_CODEC_MAX_BLOCK + 1);
+    opt300x_interface_debug_print("opt300x: check too large block %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    
+    /* opt300x_codec_encode test */
+    opt300x_interface_debug_print("opt300x: opt300x_codec_encode test.\n");
+    res = opt300x_codec_encoder_init(&gs_encoder, OPT300X_CODEC_MODE_AUTO, 4);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: encoder init failed.\n");
+        
+        return 1;
+    }
+    res = opt300x_codec_encode(NULL, gs_raw[0], gs_stream, sizeof(gs_stream), &len);
+    opt300x_interface_debug_print("opt300x: check null encoder %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_codec_encode(&gs_encoder, gs_raw[0], gs_stream, sizeof(gs_stream), NULL);
+    opt300x_interface_debug_print("opt300x: check null len %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    for (i = 0; i < 3; i++)
+    {
+        res = opt300x_codec_encode(&gs_encoder, gs_raw[i], gs_stream, sizeof(gs_stream), &len);
+        if ((res != 0) || (len != 0))
+        {
+            break;
+        }
+    }
+    opt300x_interface_debug_print("opt300x: check buffered %s.\n", (i == 3) ? "ok" : "error");
+    if (i != 3)
+    {
+        return 1;
+    }
+    res = opt300x_codec_encode(&gs_encoder, gs_raw[3], gs_stream, 1, &len);
+    opt300x_interface_debug_print("opt300x: check small output %s.\n", ((res == 5) && (len == 0)) ? "ok" : "error");
+    if ((res != 5) || (len != 0))
+    {
+        return 1;
+    }
+    res = opt300x_codec_encode(&gs_encoder, gs_raw[4], gs_stream, sizeof(gs_stream), &len);
+    opt300x_interface_debug_print("opt300x: check retried block %s.\n", ((res == 0) && (len != 0)) ? "ok" : "error");
+    if ((res != 0) || (len == 0))
+    {
+        return 1;
+    }
+    
+    /* opt300x_codec_encoder_flush test */
+    opt300x_interface_debug_print("opt300x: opt300x_codec_encoder_flush test.\n");
+    res = opt300x_codec_encoder_flush(NULL, gs_stream + len, sizeof(gs_stream) - len, &num);
+    opt300x_interface_debug_print("opt300x: check null encoder %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_codec_encoder_flush(&gs_encoder, gs_stream + len, sizeof(gs_stream) - len, NULL);
+    opt300x_interface_debug_print("opt300x: check null len %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_codec_encoder_flush(&gs_encoder, gs_stream + len, sizeof(gs_stream) - len, &num);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: flush failed.\n");
+        
+        return 1;
+    }
+    len += num;
+    res = opt300x_codec_encoder_flush(&gs_encoder, gs_stream + len, sizeof(gs_stream) - len, &num);
+    opt300x_interface_debug_print("opt300x: check empty flush %s.\n", ((res == 0) && (num == 0)) ? "ok" : "error");
+    if ((res != 0) || (num != 0))
+    {
+        return 1;
+    }
+    res = opt300x_codec_decode(gs_stream, len, gs_check, OPT300X_CODEC_TEST_NUM, &num);
+    opt300x_interface_debug_print("opt300x: check short block %s.\n",
+                                  ((res == 0) && (num == 5) && (gs_check[4] == gs_raw[4])) ? "ok" : "error");
+    if ((res != 0) || (num != 5) || (gs_check[4] != gs_raw[4]))
+    {
+        return 1;
+    }
+    
+    /* varint stream test */
+    opt300x_interface_debug_print("opt300x: varint stream test.\n");
+    if (a_opt300x_codec_test_stream(OPT300X_CODEC_MODE_VARINT) != 0)
+    {
+        return 1;
+    }
+    
+    /* auto stream test */
+    opt300x_interface_debug_print("opt300x: auto stream test.\n");
+    if (a_opt300x_codec_test_stream(OPT300X_CODEC_MODE_AUTO) != 0)
+    {
+        return 1;
+    }
+    
+    /* finish codec test */
+    opt300x_interface_debug_print("opt300x: finish codec test.\n");
+    
+    return 0;
+}
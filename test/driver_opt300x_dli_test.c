@@ -0,0 +1,562 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_dli_test.c
+ * @brief     driver opt300x dli test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_opt300x_dli_test.h"
+
+/**
+ * @brief dli test definition
+ */
+#define OPT300X_DLI_TEST_MIDNIGHT        86400000000ULL        /**< end of the first day */
+#define OPT300X_DLI_TEST_GAP             600000000ULL          /**< 10 minutes max gap */
+
+static opt300x_handle_t gs_handle;                                         /**< opt300x handle never inited */
+static opt300x_dli_t gs_dli;                                               /**< dli */
+static opt300x_dli_t gs_dli_restore;                                       /**< restored dli */
+static opt300x_dli_t gs_dli_other;                                         /**< dli of other sensor numbers */
+static opt300x_dli_t gs_dli_idle;                                          /**< dli never inited */
+static uint8_t gs_checkpoint[OPT300X_DLI_CHECKPOINT_SIZE(2)];              /**< checkpoint */
+static volatile uint32_t gs_close;                                         /**< close counter */
+
+/**
+ * @brief     close function
+ * @param[in] *dli pointer to a dli structure
+ * @param[in] sensor sensor id
+ * @note      none
+ */
+static void a_opt300x_dli_test_close(opt300x_dli_t *dli, uint8_t sensor)
+{
+    (void)dli;
+    (void)sensor;
+    gs_close++;
+}
+
+/**
+ * @brief     check a float
+ * @param[in] a checked value
+ * @param[in] b expected value
+ * @return    status code
+ *            - 0 equal
+ *            - 1 not equal
+ * @note      none
+ */
+static uint8_t a_opt300x_dli_test_near(float a, float b)
+{
+    float diff = (a > b) ? (a - b) : (b - a);
+    float limit = ((b > 0.0f) ? b : -b) * 1e-4f + 1e-6f;
+    
+    return (diff <= limit) ? 0 : 1;
+}
+
+/**
+ * @brief     check a result
+ * @param[in] *result pointer to a result
+ * @param[in] day expected day
+ * @param[in] samples expected samples
+ * @param[in] covered_us expected covered time
+ * @param[in] overflow_us expected overflow time
+ * @param[in] exposure expected exposure
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_opt300x_dli_test_result(const opt300x_dli_result_t *result, uint32_t day, uint32_t samples,
+                                         uint64_t covered_us, uint64_t overflow_us, float exposure)
+{
+    if ((result->day != day) || (result->samples != samples) || (result->covered_us != covered_us) ||
+        (result->overflow_us != overflow_us) || (a_opt300x_dli_test_near(result->exposure, exposure) != 0))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  dli test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   none
+ */
+uint8_t opt300x_dli_test(void)
+{
+    uint8_t res;
+    uint32_t len;
+    opt300x_info_t info;
+    opt300x_dli_result_t result;
+    opt300x_dli_result_t check;
+    opt300x_t type[2] = {OPT3001, OPT3002};
+    
+    /* get chip information */
+    res = opt300x_info(&info);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get info failed.\n");
+        
+        return 1;
+    }
+    else
+    {
+        /* print chip information */
+        opt300x_interface_debug_print("opt300x: chip is %s.\n", info.chip_name);
+        opt300x_interface_debug_print("opt300x: manufacturer is %s.\n", info.manufacturer_name);
+        opt300x_interface_debug_print("opt300x: interface is %s.\n", info.interface);
+        opt300x_interface_debug_print("opt300x: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        opt300x_interface_debug_print("opt300x: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        opt300x_interface_debug_print("opt300x: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        opt300x_interface_debug_print("opt300x: max current is %0.2fmA.\n", info.max_current_ma);
+        opt300x_interface_debug_print("opt300x: max temperature is %0.1fC.\n", info.temperature_max);
+        opt300x_interface_debug_print("opt300x: min temperature is %0.1fC.\n", info.temperature_min);
+    }
+    
+    /* start dli test */
+    opt300x_interface_debug_print("opt300x: start dli test.\n");
+    
+    /* opt300x_dli_init test */
+    opt300x_interface_debug_print("opt300x: opt300x_dli_init test.\n");
+    res = opt300x_dli_init(NULL, type, 2, OPT300X_DLI_TEST_GAP, 0, a_opt300x_dli_test_close);
+    opt300x_interface_debug_print("opt300x: check null dli %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_dli_init(&gs_dli, NULL, 2, OPT300X_DLI_TEST_GAP, 0, a_opt300x_dli_test_close);
+    opt300x_interface_debug_print("opt300x: check null type %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_dli_init(&gs_dli, type, 0, OPT300X_DLI_TEST_GAP, 0, a_opt300x_dli_test_close);
+    opt300x_interface_debug_print("opt300x: check no sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_dli_init(&gs_dli, type, OPT300X_DLI_MAX_SENSOR + 1, OPT300X_DLI_TEST_GAP, 0, a_opt300x_dli_test_close);
+    opt300x_interface_debug_print("opt300x: check too many sensors %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_dli_init(&gs_dli, type, 2, 0, 0, a_opt300x_dli_test_close);
+    opt300x_interface_debug_print("opt300x: check no gap %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_dli_init(&gs_dli, type, 2, OPT300X_DLI_DAY_US, 0, a_opt300x_dli_test_close);
+    opt300x_interface_debug_print("opt300x: check one day gap %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_dli_init(&gs_dli, type, 2, OPT300X_DLI_TEST_GAP, (int64_t)OPT300X_DLI_DAY_US, a_opt300x_dli_test_close);
+    opt300x_interface_debug_print("opt300x: check large offset %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_dli_init(&gs_dli, type, 2, OPT300X_DLI_TEST_GAP, -(int64_t)OPT300X_DLI_DAY_US, a_opt300x_dli_test_close);
+    opt300x_interface_debug_print("opt300x: check small offset %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    gs_close = 0;
+    res = opt300x_dli_init(&gs_dli, type, 2, OPT300X_DLI_TEST_GAP, 0, a_opt300x_dli_test_close);
+    opt300x_interface_debug_print("opt300x: check init %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* opt300x_dli_set_factor test */
+    opt300x_interface_debug_print("opt300x: opt300x_dli_set_factor test.\n");
+    res = opt300x_dli_set_factor(NULL, 0, OPT300X_DLI_LUX_FACTOR);
+    opt300x_interface_debug_print("opt300x: check null dli %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_dli_set_factor(&gs_dli_idle, 0, OPT300X_DLI_LUX_FACTOR);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    res = opt300x_dli_set_factor(&gs_dli, 2, OPT300X_DLI_LUX_FACTOR);
+    opt300x_interface_debug_print("opt300x: check invalid sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_dli_set_factor(&gs_dli, 0, 0.0f);
+    opt300x_interface_debug_print("opt300x: check zero factor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_dli_set_factor(&gs_dli, 0, 0.02f);
+    opt300x_interface_debug_print("opt300x: check set factor %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* opt300x_dli_get_running test */
+    opt300x_interface_debug_print("opt300x: opt300x_dli_get_running test.\n");
+    res = opt300x_dli_get_running(NULL, 0, &result);
+    opt300x_interface_debug_print("opt300x: check null dli %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_dli_get_running(&gs_dli, 0, NULL);
+    opt300x_interface_debug_print("opt300x: check null result %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_dli_get_running(&gs_dli_idle, 0, &result);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    res = opt300x_dli_get_running(&gs_dli, 2, &result);
+    opt300x_interface_debug_print("opt300x: check invalid sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_dli_get_running(&gs_dli, 0, &result);
+    opt300x_interface_debug_print("opt300x: check no sample %s.\n", (res == 5) ? "ok" : "error");
+    if (res != 5)
+    {
+        return 1;
+    }
+    
+    /* opt300x_dli_get_result test */
+    opt300x_interface_debug_print("opt300x: opt300x_dli_get_result test.\n");
+    res = opt300x_dli_get_result(NULL, 0, &result);
+    opt300x_interface_debug_print("opt300x: check null dli %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_dli_get_result(&gs_dli, 0, NULL);
+    opt300x_interface_debug_print("opt300x: check null result %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_dli_get_result(&gs_dli_idle, 0, &result);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    res = opt300x_dli_get_result(&gs_dli, 2, &result);
+    opt300x_interface_debug_print("opt300x: check invalid sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_dli_get_result(&gs_dli, 0, &result);
+    opt300x_interface_debug_print("opt300x: check no closed day %s.\n", (res == 5) ? "ok" : "error");
+    if (res != 5)
+    {
+        return 1;
+    }
+    
+    /* opt300x_dli_push test */
+    opt300x_interface_debug_print("opt300x: opt300x_dli_push test.\n");
+    res = opt300x_dli_push(NULL, 0, 0x0064, 0);
+    opt300x_interface_debug_print("opt300x: check null dli %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_dli_push(&gs_dli_idle, 0, 0x0064, 0);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    res = opt300x_dli_push(&gs_dli, 2, 0x0064, 0);
+    opt300x_interface_debug_print("opt300x: check invalid sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_dli_push(&gs_dli, 0, 0xC064, 0);
+    opt300x_interface_debug_print("opt300x: check invalid exponent %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    
+    /* 1 lux from 2 minutes before to 2 minutes after midnight */
+    res = opt300x_dli_push(&gs_dli, 0, 0x0064, OPT300X_DLI_TEST_MIDNIGHT - 120000000ULL);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: check push error.\n");
+        
+        return 1;
+    }
+    res = opt300x_dli_push(&gs_dli, 0, 0x0064, OPT300X_DLI_TEST_MIDNIGHT + 120000000ULL);
+    opt300x_interface_debug_print("opt300x: check push %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    res = opt300x_dli_get_result(&gs_dli, 0, &result);
+    if ((res != 0) || (gs_close != 1) ||
+        (a_opt300x_dli_test_result(&result, 0, 1, 120000000ULL, 0, 120.0f) != 0) ||
+        (a_opt300x_dli_test_near(result.dli * 1000000.0f, 120.0f * 0.02f) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: check closed day error.\n");
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check closed day ok.\n");
+    res = opt300x_dli_get_running(&gs_dli, 0, &result);
+    if ((res != 0) || (a_opt300x_dli_test_result(&result, 1, 1, 120000000ULL, 0, 120.0f) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: check running day error.\n");
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check running day ok.\n");
+    res = opt300x_dli_push(&gs_dli, 0, 0x0064, OPT300X_DLI_TEST_MIDNIGHT);
+    opt300x_interface_debug_print("opt300x: check late sample %s.\n", (res == 5) ? "ok" : "error");
+    if (res != 5)
+    {
+        return 1;
+    }
+    
+    /* full scale for one minute */
+    res = opt300x_dli_push(&gs_dli, 1, 0xBFFF, OPT300X_DLI_TEST_MIDNIGHT);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: check push error.\n");
+        
+        return 1;
+    }
+    res = opt300x_dli_push(&gs_dli, 1, 0xBFFF, OPT300X_DLI_TEST_MIDNIGHT + 60000000ULL);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: check push error.\n");
+        
+        return 1;
+    }
+    res = opt300x_dli_get_running(&gs_dli, 1, &result);
+    if ((res != 0) ||
+        (a_opt300x_dli_test_result(&result, 1, 2, 60000000ULL, 60000000ULL, 4095.0f * 2048.0f * 1.2f * 60.0f) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: check overflow error.\n");
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check overflow ok.\n");
+    
+    /* opt300x_dli_read_push test */
+    opt300x_interface_debug_print("opt300x: opt300x_dli_read_push test.\n");
+    res = opt300x_dli_read_push(NULL, 0, &gs_handle, 0);
+    opt300x_interface_debug_print("opt300x: check null dli %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_dli_read_push(&gs_dli, 0, NULL, 0);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_dli_read_push(&gs_dli, 0, &gs_handle, 0);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    
+    /* opt300x_dli_checkpoint test */
+    opt300x_interface_debug_print("opt300x: opt300x_dli_checkpoint test.\n");
+    res = opt300x_dli_checkpoint(NULL, gs_checkpoint, sizeof(gs_checkpoint), &len);
+    opt300x_interface_debug_print("opt300x: check null dli %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_dli_checkpoint(&gs_dli, NULL, sizeof(gs_checkpoint), &len);
+    opt300x_interface_debug_print("opt300x: check null buffer %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_dli_checkpoint(&gs_dli, gs_checkpoint, sizeof(gs_checkpoint), NULL);
+    opt300x_interface_debug_print("opt300x: check null length %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_dli_checkpoint(&gs_dli_idle, gs_checkpoint, sizeof(gs_checkpoint), &len);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    res = opt300x_dli_checkpoint(&gs_dli, gs_checkpoint, sizeof(gs_checkpoint) - 1, &len);
+    opt300x_interface_debug_print("opt300x: check short buffer %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_dli_checkpoint(&gs_dli, gs_checkpoint, sizeof(gs_checkpoint), &len);
+    opt300x_interface_debug_print("opt300x: check checkpoint %s.\n", ((res == 0) && (len == sizeof(gs_checkpoint))) ? "ok" : "error");
+    if ((res != 0) || (len != sizeof(gs_checkpoint)))
+    {
+        return 1;
+    }
+    
+    /* opt300x_dli_restore test */
+    opt300x_interface_debug_print("opt300x: opt300x_dli_restore test.\n");
+    res = opt300x_dli_init(&gs_dli_restore, type, 2, OPT300X_DLI_TEST_GAP, 0, NULL);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: init failed.\n");
+        
+        return 1;
+    }
+    res = opt300x_dli_init(&gs_dli_other, type, 1, OPT300X_DLI_TEST_GAP, 0, NULL);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: init failed.\n");
+        
+        return 1;
+    }
+    res = opt300x_dli_restore(NULL, gs_checkpoint, len);
+    opt300x_interface_debug_print("opt300x: check null dli %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_dli_restore(&gs_dli_restore, NULL, len);
+    opt300x_interface_debug_print("opt300x: check null buffer %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_dli_restore(&gs_dli_idle, gs_checkpoint, len);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    res = opt300x_dli_restore(&gs_dli_restore, gs_checkpoint, len - 1);
+    opt300x_interface_debug_print("opt300x: check short checkpoint %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    gs_checkpoint[20] ^= 0x01;
+    res = opt300x_dli_restore(&gs_dli_restore, gs_checkpoint, len);
+    gs_checkpoint[20] ^= 0x01;
+    opt300x_interface_debug_print("opt300x: check broken checkpoint %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_dli_restore(&gs_dli_other, gs_checkpoint, len);
+    opt300x_interface_debug_print("opt300x: check other sensor numbers %s.\n", (res == 5) ? "ok" : "error");
+    if (res != 5)
+    {
+        return 1;
+    }
+    res = opt300x_dli_restore(&gs_dli_restore, gs_checkpoint, len);
+    opt300x_interface_debug_print("opt300x: check restore %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    res = opt300x_dli_get_running(&gs_dli, 1, &check);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get running failed.\n");
+        
+        return 1;
+    }
+    res = opt300x_dli_get_running(&gs_dli_restore, 1, &result);
+    if ((res != 0) || (a_opt300x_dli_test_result(&result, check.day, check.samples, check.covered_us,
+                                                 check.overflow_us, check.exposure) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: check restored day error.\n");
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check restored day ok.\n");
+    
+    /* a gap over two midnights */
+    res = opt300x_dli_push(&gs_dli, 0, 0x0064, 3 * OPT300X_DLI_TEST_MIDNIGHT + 60000000ULL);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: check push error.\n");
+        
+        return 1;
+    }
+    res = opt300x_dli_get_result(&gs_dli, 0, &result);
+    if ((res != 0) || (gs_close != 2) || (a_opt300x_dli_test_result(&result, 1, 1, 120000000ULL, 0, 120.0f) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: check gap error.\n");
+        
+        return 1;
+    }
+    res = opt300x_dli_get_running(&gs_dli, 0, &result);
+    if ((res != 0) || (a_opt300x_dli_test_result(&result, 3, 1, 0, 0, 0.0f) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: check gap error.\n");
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check gap ok.\n");
+    
+    /* finish dli test */
+    opt300x_interface_debug_print("opt300x: finish dli test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,652 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_filter_test.c
+ * @brief     driver opt300x filter test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_opt300x_filter_test.h"
+
+/**
+ * @brief filter test definition
+ */
+#define OPT300X_FILTER_TEST_SENSOR        2        /**< test sensors */
+#define OPT300X_FILTER_TEST_TAPS          3        /**< test taps */
+
+static opt300x_filter_ema_t gs_ema;                                                                                  /**< ema */
+static opt300x_filter_ema_t gs_ema_idle;                                                                             /**< ema never inited */
+static opt300x_filter_boxcar_t gs_boxcar;                                                                            /**< boxcar */
+static opt300x_filter_boxcar_t gs_boxcar_idle;                                                                       /**< boxcar never inited */
+static opt300x_filter_median_t gs_median;                                                                            /**< median */
+static opt300x_filter_median_t gs_median_idle;                                                                       /**< median never inited */
+static opt300x_filter_fir_t gs_fir;                                                                                  /**< fir */
+static opt300x_filter_fir_t gs_fir_idle;                                                                             /**< fir never inited */
+static opt300x_filter_cic_t gs_cic;                                                                                  /**< cic */
+static opt300x_filter_cic_t gs_cic_idle;                                                                             /**< cic never inited */
+static float gs_buffer[OPT300X_FILTER_MEDIAN_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_MEDIAN_MAX_TAPS)];    /**< float state */
+static uint64_t gs_cic_buffer[OPT300X_FILTER_CIC_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_CIC_MAX_ORDER)];  /**< cic state */
+
+/**
+ * @brief     check a float
+ * @param[in] a checked value
+ * @param[in] b expected value
+ * @return    status code
+ *            - 0 equal
+ *            - 1 not equal
+ * @note      none
+ */
+static uint8_t a_opt300x_filter_test_near(float a, float b)
+{
+    float diff = (a > b) ? (a - b) : (b - a);
+    float limit = ((b > 0.0f) ? b : -b) * 1e-4f + 1e-6f;
+    
+    return (diff <= limit) ? 0 : 1;
+}
+
+/**
+ * @brief     check the outputs of both sensors
+ * @param[in] *out pointer to the outputs
+ * @param[in] expect expected output of the first sensor
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      the second sensor is fed the negated samples
+ */
+static uint8_t a_opt300x_filter_test_check(const float *out, float expect)
+{
+    if ((a_opt300x_filter_test_near(out[0], expect) != 0) ||
+        (a_opt300x_filter_test_near(out[1], -expect) != 0))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  filter test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   none
+ */
+uint8_t opt300x_filter_test(void)
+{
+    uint8_t res;
+    uint8_t ready;
+    uint32_t i;
+    opt300x_info_t info;
+    float in[OPT300X_FILTER_TEST_SENSOR];
+    float out[OPT300X_FILTER_TEST_SENSOR];
+    uint16_t raw[OPT300X_FILTER_TEST_SENSOR] = {0x1064, 0x1064};
+    const opt300x_t type[OPT300X_FILTER_TEST_SENSOR] = {OPT3001, OPT3002};
+    const float coef[OPT300X_FILTER_TEST_TAPS] = {0.5f, 0.25f, 0.25f};
+    const float ema_in[3] = {10.0f, 20.0f, 20.0f};
+    const float ema_out[3] = {10.0f, 15.0f, 17.5f};
+    const float boxcar_in[4] = {3.0f, 6.0f, 9.0f, 12.0f};
+    const float boxcar_out[4] = {3.0f, 4.0f, 6.0f, 9.0f};
+    const float median_in[5] = {5.0f, 100.0f, 7.0f, 6.0f, 1.0f};
+    const float median_out[5] = {5.0f, 5.0f, 7.0f, 7.0f, 6.0f};
+    
+    /* get chip information */
+    res = opt300x_info(&info);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get info failed.\n");
+        
+        return 1;
+    }
+    else
+    {
+        /* print chip information */
+        opt300x_interface_debug_print("opt300x: chip is %s.\n", info.chip_name);
+        opt300x_interface_debug_print("opt300x: manufacturer is %s.\n", info.manufacturer_name);
+        opt300x_interface_debug_print("opt300x: interface is %s.\n", info.interface);
+        opt300x_interface_debug_print("opt300x: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        opt300x_interface_debug_print("opt300x: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        opt300x_interface_debug_print("opt300x: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        opt300x_interface_debug_print("opt300x: max current is %0.2fmA.\n", info.max_current_ma);
+        opt300x_interface_debug_print("opt300x: max temperature is %0.1fC.\n", info.temperature_max);
+        opt300x_interface_debug_print("opt300x: min temperature is %0.1fC.\n", info.temperature_min);
+    }
+    
+    /* start filter test */
+    opt300x_interface_debug_print("opt300x: start filter test.\n");
+    
+    /* opt300x_filter_ema_init test */
+    opt300x_interface_debug_print("opt300x: opt300x_filter_ema_init test.\n");
+    res = opt300x_filter_ema_init(NULL, OPT300X_FILTER_TEST_SENSOR, 0.5f, gs_buffer, OPT300X_FILTER_EMA_BUFFER(OPT300X_FILTER_TEST_SENSOR));
+    opt300x_interface_debug_print("opt300x: check null ema %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_filter_ema_init(&gs_ema, 0, 0.5f, gs_buffer, OPT300X_FILTER_EMA_BUFFER(OPT300X_FILTER_TEST_SENSOR));
+    opt300x_interface_debug_print("opt300x: check no sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_ema_init(&gs_ema, OPT300X_FILTER_TEST_SENSOR, 0.0f, gs_buffer, OPT300X_FILTER_EMA_BUFFER(OPT300X_FILTER_TEST_SENSOR));
+    opt300x_interface_debug_print("opt300x: check zero alpha %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_ema_init(&gs_ema, OPT300X_FILTER_TEST_SENSOR, 1.5f, gs_buffer, OPT300X_FILTER_EMA_BUFFER(OPT300X_FILTER_TEST_SENSOR));
+    opt300x_interface_debug_print("opt300x: check large alpha %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_ema_init(&gs_ema, OPT300X_FILTER_TEST_SENSOR, 0.5f, NULL, OPT300X_FILTER_EMA_BUFFER(OPT300X_FILTER_TEST_SENSOR));
+    opt300x_interface_debug_print("opt300x: check null buffer %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_ema_init(&gs_ema, OPT300X_FILTER_TEST_SENSOR, 0.5f, gs_buffer, OPT300X_FILTER_EMA_BUFFER(OPT300X_FILTER_TEST_SENSOR) - 1);
+    opt300x_interface_debug_print("opt300x: check short buffer %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_ema_init(&gs_ema, OPT300X_FILTER_TEST_SENSOR, 0.5f, gs_buffer, OPT300X_FILTER_EMA_BUFFER(OPT300X_FILTER_TEST_SENSOR));
+    opt300x_interface_debug_print("opt300x: check init %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* opt300x_filter_ema_run test */
+    opt300x_interface_debug_print("opt300x: opt300x_filter_ema_run test.\n");
+    res = opt300x_filter_ema_run(NULL, in, out);
+    opt300x_interface_debug_print("opt300x: check null ema %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_filter_ema_run(&gs_ema, NULL, out);
+    opt300x_interface_debug_print("opt300x: check null input %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_filter_ema_run(&gs_ema, in, NULL);
+    opt300x_interface_debug_print("opt300x: check null output %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_filter_ema_run(&gs_ema_idle, in, out);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    for (i = 0; i < 3; i++)
+    {
+        in[0] = ema_in[i];
+        in[1] = -ema_in[i];
+        res = opt300x_filter_ema_run(&gs_ema, in, in);
+        if ((res != 0) || (a_opt300x_filter_test_check(in, ema_out[i]) != 0))
+        {
+            opt300x_interface_debug_print("opt300x: check smoothing error.\n");
+            
+            return 1;
+        }
+    }
+    opt300x_interface_debug_print("opt300x: check smoothing ok.\n");
+    
+    /* opt300x_filter_boxcar_init test */
+    opt300x_interface_debug_print("opt300x: opt300x_filter_boxcar_init test.\n");
+    res = opt300x_filter_boxcar_init(NULL, OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS, gs_buffer,
+                                     OPT300X_FILTER_BOXCAR_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS));
+    opt300x_interface_debug_print("opt300x: check null boxcar %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_filter_boxcar_init(&gs_boxcar, 0, OPT300X_FILTER_TEST_TAPS, gs_buffer,
+                                     OPT300X_FILTER_BOXCAR_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS));
+    opt300x_interface_debug_print("opt300x: check no sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_boxcar_init(&gs_boxcar, OPT300X_FILTER_TEST_SENSOR, 0, gs_buffer,
+                                     OPT300X_FILTER_BOXCAR_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS));
+    opt300x_interface_debug_print("opt300x: check no tap %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_boxcar_init(&gs_boxcar, OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS, NULL,
+                                     OPT300X_FILTER_BOXCAR_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS));
+    opt300x_interface_debug_print("opt300x: check null buffer %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_boxcar_init(&gs_boxcar, OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS, gs_buffer,
+                                     OPT300X_FILTER_BOXCAR_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS) - 1);
+    opt300x_interface_debug_print("opt300x: check short buffer %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_boxcar_init(&gs_boxcar, OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS, gs_buffer,
+                                     OPT300X_FILTER_BOXCAR_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS));
+    opt300x_interface_debug_print("opt300x: check init %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* opt300x_filter_boxcar_run test */
+    opt300x_interface_debug_print("opt300x: opt300x_filter_boxcar_run test.\n");
+    res = opt300x_filter_boxcar_run(NULL, in, out);
+    opt300x_interface_debug_print("opt300x: check null boxcar %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_filter_boxcar_run(&gs_boxcar, NULL, out);
+    opt300x_interface_debug_print("opt300x: check null input %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_filter_boxcar_run(&gs_boxcar, in, NULL);
+    opt300x_interface_debug_print("opt300x: check null output %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_filter_boxcar_run(&gs_boxcar_idle, in, out);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    for (i = 0; i < 4; i++)
+    {
+        in[0] = boxcar_in[i];
+        in[1] = -boxcar_in[i];
+        res = opt300x_filter_boxcar_run(&gs_boxcar, in, out);
+        if ((res != 0) || (a_opt300x_filter_test_check(out, boxcar_out[i]) != 0))
+        {
+            opt300x_interface_debug_print("opt300x: check average error.\n");
+            
+            return 1;
+        }
+    }
+    opt300x_interface_debug_print("opt300x: check average ok.\n");
+    
+    /* opt300x_filter_median_init test */
+    opt300x_interface_debug_print("opt300x: opt300x_filter_median_init test.\n");
+    res = opt300x_filter_median_init(NULL, OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS, gs_buffer,
+                                     OPT300X_FILTER_MEDIAN_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS));
+    opt300x_interface_debug_print("opt300x: check null median %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_filter_median_init(&gs_median, 0, OPT300X_FILTER_TEST_TAPS, gs_buffer,
+                                     OPT300X_FILTER_MEDIAN_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS));
+    opt300x_interface_debug_print("opt300x: check no sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_median_init(&gs_median, OPT300X_FILTER_TEST_SENSOR, 1, gs_buffer,
+                                     OPT300X_FILTER_MEDIAN_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS));
+    opt300x_interface_debug_print("opt300x: check too few taps %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_median_init(&gs_median, OPT300X_FILTER_TEST_SENSOR, 4, gs_buffer,
+                                     OPT300X_FILTER_MEDIAN_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_MEDIAN_MAX_TAPS));
+    opt300x_interface_debug_print("opt300x: check even taps %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_median_init(&gs_median, OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_MEDIAN_MAX_TAPS + 2, gs_buffer,
+                                     OPT300X_FILTER_MEDIAN_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_MEDIAN_MAX_TAPS));
+    opt300x_interface_debug_print("opt300x: check too many taps %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_median_init(&gs_median, OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS, NULL,
+                                     OPT300X_FILTER_MEDIAN_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS));
+    opt300x_interface_debug_print("opt300x: check null buffer %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_median_init(&gs_median, OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS, gs_buffer,
+                                     OPT300X_FILTER_MEDIAN_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS) - 1);
+    opt300x_interface_debug_print("opt300x: check short buffer %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_median_init(&gs_median, OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS, gs_buffer,
+                                     OPT300X_FILTER_MEDIAN_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS));
+    opt300x_interface_debug_print("opt300x: check init %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* opt300x_filter_median_run test */
+    opt300x_interface_debug_print("opt300x: opt300x_filter_median_run test.\n");
+    res = opt300x_filter_median_run(NULL, in, out);
+    opt300x_interface_debug_print("opt300x: check null median %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_filter_median_run(&gs_median, NULL, out);
+    opt300x_interface_debug_print("opt300x: check null input %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_filter_median_run(&gs_median, in, NULL);
+    opt300x_interface_debug_print("opt300x: check null output %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_filter_median_run(&gs_median_idle, in, out);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    for (i = 0; i < 5; i++)
+    {
+        in[0] = median_in[i];
+        in[1] = -median_in[i];
+        res = opt300x_filter_median_run(&gs_median, in, out);
+        if ((res != 0) || (a_opt300x_filter_test_check(out, median_out[i]) != 0))
+        {
+            opt300x_interface_debug_print("opt300x: check median error.\n");
+            
+            return 1;
+        }
+    }
+    opt300x_interface_debug_print("opt300x: check median ok.\n");
+    
+    /* opt300x_filter_fir_init test */
+    opt300x_interface_debug_print("opt300x: opt300x_filter_fir_init test.\n");
+    res = opt300x_filter_fir_init(NULL, OPT300X_FILTER_TEST_SENSOR, coef, OPT300X_FILTER_TEST_TAPS, 2, gs_buffer,
+                                  OPT300X_FILTER_FIR_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS));
+    opt300x_interface_debug_print("opt300x: check null fir %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_filter_fir_init(&gs_fir, 0, coef, OPT300X_FILTER_TEST_TAPS, 2, gs_buffer,
+                                  OPT300X_FILTER_FIR_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS));
+    opt300x_interface_debug_print("opt300x: check no sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_fir_init(&gs_fir, OPT300X_FILTER_TEST_SENSOR, NULL, OPT300X_FILTER_TEST_TAPS, 2, gs_buffer,
+                                  OPT300X_FILTER_FIR_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS));
+    opt300x_interface_debug_print("opt300x: check null coefficients %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_fir_init(&gs_fir, OPT300X_FILTER_TEST_SENSOR, coef, 0, 2, gs_buffer,
+                                  OPT300X_FILTER_FIR_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS));
+    opt300x_interface_debug_print("opt300x: check no tap %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_fir_init(&gs_fir, OPT300X_FILTER_TEST_SENSOR, coef, OPT300X_FILTER_TEST_TAPS, 0, gs_buffer,
+                                  OPT300X_FILTER_FIR_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS));
+    opt300x_interface_debug_print("opt300x: check no decimation %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_fir_init(&gs_fir, OPT300X_FILTER_TEST_SENSOR, coef, OPT300X_FILTER_TEST_TAPS, 2, NULL,
+                                  OPT300X_FILTER_FIR_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS));
+    opt300x_interface_debug_print("opt300x: check null buffer %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_fir_init(&gs_fir, OPT300X_FILTER_TEST_SENSOR, coef, OPT300X_FILTER_TEST_TAPS, 2, gs_buffer,
+                                  OPT300X_FILTER_FIR_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS) - 1);
+    opt300x_interface_debug_print("opt300x: check short buffer %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_fir_init(&gs_fir, OPT300X_FILTER_TEST_SENSOR, coef, OPT300X_FILTER_TEST_TAPS, 2, gs_buffer,
+                                  OPT300X_FILTER_FIR_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_TEST_TAPS));
+    opt300x_interface_debug_print("opt300x: check init %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* opt300x_filter_fir_run test */
+    opt300x_interface_debug_print("opt300x: opt300x_filter_fir_run test.\n");
+    res = opt300x_filter_fir_run(NULL, in, out, &ready);
+    opt300x_interface_debug_print("opt300x: check null fir %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_filter_fir_run(&gs_fir, NULL, out, &ready);
+    opt300x_interface_debug_print("opt300x: check null input %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_filter_fir_run(&gs_fir, in, NULL, &ready);
+    opt300x_interface_debug_print("opt300x: check null output %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_filter_fir_run(&gs_fir, in, out, NULL);
+    opt300x_interface_debug_print("opt300x: check null ready %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_filter_fir_run(&gs_fir_idle, in, out, &ready);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    for (i = 1; i <= 4; i++)
+    {
+        in[0] = (float)i;
+        in[1] = -(float)i;
+        res = opt300x_filter_fir_run(&gs_fir, in, out, &ready);
+        if ((res != 0) || (ready != ((i % 2 == 0) ? 1 : 0)))
+        {
+            opt300x_interface_debug_print("opt300x: check decimation error.\n");
+            
+            return 1;
+        }
+    }
+    opt300x_interface_debug_print("opt300x: check decimation ok.\n");
+    res = a_opt300x_filter_test_check(out, 3.25f);
+    opt300x_interface_debug_print("opt300x: check taps %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* opt300x_filter_cic_init test */
+    opt300x_interface_debug_print("opt300x: opt300x_filter_cic_init test.\n");
+    res = opt300x_filter_cic_init(NULL, type, OPT300X_FILTER_TEST_SENSOR, 2, 4, gs_cic_buffer,
+                                  OPT300X_FILTER_CIC_BUFFER(OPT300X_FILTER_TEST_SENSOR, 2));
+    opt300x_interface_debug_print("opt300x: check null cic %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_filter_cic_init(&gs_cic, NULL, OPT300X_FILTER_TEST_SENSOR, 2, 4, gs_cic_buffer,
+                                  OPT300X_FILTER_CIC_BUFFER(OPT300X_FILTER_TEST_SENSOR, 2));
+    opt300x_interface_debug_print("opt300x: check null type %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_cic_init(&gs_cic, type, 0, 2, 4, gs_cic_buffer,
+                                  OPT300X_FILTER_CIC_BUFFER(OPT300X_FILTER_TEST_SENSOR, 2));
+    opt300x_interface_debug_print("opt300x: check no sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_cic_init(&gs_cic, type, OPT300X_FILTER_TEST_SENSOR, 0, 4, gs_cic_buffer,
+                                  OPT300X_FILTER_CIC_BUFFER(OPT300X_FILTER_TEST_SENSOR, 2));
+    opt300x_interface_debug_print("opt300x: check no stage %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_cic_init(&gs_cic, type, OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_CIC_MAX_ORDER + 1, 4, gs_cic_buffer,
+                                  OPT300X_FILTER_CIC_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_CIC_MAX_ORDER));
+    opt300x_interface_debug_print("opt300x: check too many stages %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_cic_init(&gs_cic, type, OPT300X_FILTER_TEST_SENSOR, 2, 0, gs_cic_buffer,
+                                  OPT300X_FILTER_CIC_BUFFER(OPT300X_FILTER_TEST_SENSOR, 2));
+    opt300x_interface_debug_print("opt300x: check no decimation %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_cic_init(&gs_cic, type, OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_CIC_MAX_ORDER, 65535, gs_cic_buffer,
+                                  OPT300X_FILTER_CIC_BUFFER(OPT300X_FILTER_TEST_SENSOR, OPT300X_FILTER_CIC_MAX_ORDER));
+    opt300x_interface_debug_print("opt300x: check gain overflow %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_cic_init(&gs_cic, type, OPT300X_FILTER_TEST_SENSOR, 2, 4, NULL,
+                                  OPT300X_FILTER_CIC_BUFFER(OPT300X_FILTER_TEST_SENSOR, 2));
+    opt300x_interface_debug_print("opt300x: check null buffer %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_cic_init(&gs_cic, type, OPT300X_FILTER_TEST_SENSOR, 2, 4, gs_cic_buffer,
+                                  OPT300X_FILTER_CIC_BUFFER(OPT300X_FILTER_TEST_SENSOR, 2) - 1);
+    opt300x_interface_debug_print("opt300x: check short buffer %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_filter_cic_init(&gs_cic, type, OPT300X_FILTER_TEST_SENSOR, 2, 4, gs_cic_buffer,
+                                  OPT300X_FILTER_CIC_BUFFER(OPT300X_FILTER_TEST_SENSOR, 2));
+    opt300x_interface_debug_print("opt300x: check init %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* opt300x_filter_cic_run test */
+    opt300x_interface_debug_print("opt300x: opt300x_filter_cic_run test.\n");
+    res = opt300x_filter_cic_run(NULL, raw, out, &ready);
+    opt300x_interface_debug_print("opt300x: check null cic %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_filter_cic_run(&gs_cic, NULL, out, &ready);
+    opt300x_interface_debug_print("opt300x: check null raw %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_filter_cic_run(&gs_cic, raw, NULL, &ready);
+    opt300x_interface_debug_print("opt300x: check null output %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_filter_cic_run(&gs_cic, raw, out, NULL);
+    opt300x_interface_debug_print("opt300x: check null ready %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_filter_cic_run(&gs_cic_idle, raw, out, &ready);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    for (i = 1; i <= 8; i++)
+    {
+        res = opt300x_filter_cic_run(&gs_cic, raw, out, &ready);
+        if ((res != 0) || (ready != ((i % 4 == 0) ? 1 : 0)))
+        {
+            opt300x_interface_debug_print("opt300x: check decimation error.\n");
+            
+            return 1;
+        }
+    }
+    opt300x_interface_debug_print("opt300x: check decimation ok.\n");
+    res = ((a_opt300x_filter_test_near(out[0], 2.0f) == 0) && (a_opt300x_filter_test_near(out[1], 240.0f) == 0)) ? 0 : 1;
+    opt300x_interface_debug_print("opt300x: check scale %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* finish filter test */
+    opt300x_interface_debug_print("opt300x: finish filter test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,529 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_fusion_test.c
+ * @brief     driver opt300x fusion test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_opt300x_fusion_test.h"
+
+/**
+ * @brief fusion test definition
+ */
+#define OPT300X_FUSION_TEST_SENSOR        3        /**< logical sensors on the chip */
+
+static opt300x_handle_t gs_handle[OPT300X_FUSION_TEST_SENSOR];        /**< opt300x handles of one chip */
+static opt300x_fusion_t gs_fusion;                                    /**< median fusion */
+static opt300x_fusion_t gs_fusion_mean;                               /**< trimmed mean fusion */
+static opt300x_fusion_t gs_fusion_idle;                               /**< fusion never inited */
+static opt300x_pubsub_t gs_pubsub_idle;                               /**< pubsub never inited */
+
+/**
+ * @brief     check a float
+ * @param[in] a checked value
+ * @param[in] b expected value
+ * @return    status code
+ *            - 0 equal
+ *            - 1 not equal
+ * @note      none
+ */
+static uint8_t a_opt300x_fusion_test_near(float a, float b)
+{
+    float diff = (a > b) ? (a - b) : (b - a);
+    float limit = ((b > 0.0f) ? b : -b) * 1e-4f + 1e-6f;
+    
+    return (diff <= limit) ? 0 : 1;
+}
+
+/**
+ * @brief  deinit every handle
+ * @note   none
+ */
+static void a_opt300x_fusion_test_deinit(void)
+{
+    uint8_t s;
+    
+    for (s = 0; s < OPT300X_FUSION_TEST_SENSOR; s++)
+    {
+        (void)opt300x_deinit(&gs_handle[s]);
+    }
+}
+
+/**
+ * @brief     fusion test
+ * @param[in] type chip type
+ * @param[in] addr_pin iic device address
+ * @param[in] times test times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      every logical sensor of the group reads the same chip
+ */
+uint8_t opt300x_fusion_test(opt300x_t type, opt300x_address_t addr_pin, uint32_t times)
+{
+    uint8_t res;
+    uint8_t s;
+    uint32_t j;
+    float health;
+    opt300x_info_t info;
+    opt300x_fusion_result_t result;
+    opt300x_handle_t *handle[OPT300X_FUSION_MAX_SENSOR + 1];
+    uint16_t raw[OPT300X_FUSION_TEST_SENSOR];
+    
+    /* link interface function */
+    for (s = 0; s < OPT300X_FUSION_TEST_SENSOR; s++)
+    {
+        DRIVER_OPT300X_LINK_INIT(&gs_handle[s], opt300x_handle_t);
+        DRIVER_OPT300X_LINK_IIC_INIT(&gs_handle[s], opt300x_interface_iic_init);
+        DRIVER_OPT300X_LINK_IIC_DEINIT(&gs_handle[s], opt300x_interface_iic_deinit);
+        DRIVER_OPT300X_LINK_IIC_READ(&gs_handle[s], opt300x_interface_iic_read);
+        DRIVER_OPT300X_LINK_IIC_WRITE(&gs_handle[s], opt300x_interface_iic_write);
+        DRIVER_OPT300X_LINK_IIC_READ_COMMAND(&gs_handle[s], opt300x_interface_iic_read_cmd);
+        DRIVER_OPT300X_LINK_IIC_WRITE_COMMAND(&gs_handle[s], opt300x_interface_iic_write_cmd);
+        DRIVER_OPT300X_LINK_DELAY_MS(&gs_handle[s], opt300x_interface_delay_ms);
+        DRIVER_OPT300X_LINK_DEBUG_PRINT(&gs_handle[s], opt300x_interface_debug_log);
+        DRIVER_OPT300X_LINK_MUTEX_INIT(&gs_handle[s], opt300x_interface_mutex_init);
+        DRIVER_OPT300X_LINK_MUTEX_DEINIT(&gs_handle[s], opt300x_interface_mutex_deinit);
+        DRIVER_OPT300X_LINK_MUTEX_LOCK(&gs_handle[s], opt300x_interface_mutex_lock);
+        DRIVER_OPT300X_LINK_MUTEX_UNLOCK(&gs_handle[s], opt300x_interface_mutex_unlock);
+        DRIVER_OPT300X_LINK_TIMESTAMP_US(&gs_handle[s], opt300x_interface_timestamp_us);
+        DRIVER_OPT300X_LINK_RECEIVE_CALLBACK(&gs_handle[s], opt300x_interface_receive_callback);
+        handle[s] = &gs_handle[s];
+    }
+    handle[OPT300X_FUSION_TEST_SENSOR] = NULL;
+    
+    /* get chip information */
+    res = opt300x_info(&info);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get info failed.\n");
+        
+        return 1;
+    }
+    else
+    {
+        /* print chip information */
+        opt300x_interface_debug_print("opt300x: chip is %s.\n", info.chip_name);
+        opt300x_interface_debug_print("opt300x: manufacturer is %s.\n", info.manufacturer_name);
+        opt300x_interface_debug_print("opt300x: interface is %s.\n", info.interface);
+        opt300x_interface_debug_print("opt300x: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        opt300x_interface_debug_print("opt300x: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        opt300x_interface_debug_print("opt300x: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        opt300x_interface_debug_print("opt300x: max current is %0.2fmA.\n", info.max_current_ma);
+        opt300x_interface_debug_print("opt300x: max temperature is %0.1fC.\n", info.temperature_max);
+        opt300x_interface_debug_print("opt300x: min temperature is %0.1fC.\n", info.temperature_min);
+    }
+    
+    /* start fusion test */
+    opt300x_interface_debug_print("opt300x: start fusion test.\n");
+    
+    /* set chip type and iic address */
+    for (s = 0; s < OPT300X_FUSION_TEST_SENSOR; s++)
+    {
+        res = opt300x_set_type(&gs_handle[s], type);
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: set type failed.\n");
+            
+            return 1;
+        }
+        res = opt300x_set_addr_pin(&gs_handle[s], addr_pin);
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: set addr pin failed.\n");
+            
+            return 1;
+        }
+    }
+    
+    /* opt300x_fusion_init test */
+    opt300x_interface_debug_print("opt300x: opt300x_fusion_init test.\n");
+    res = opt300x_fusion_init(NULL, handle, OPT300X_FUSION_TEST_SENSOR, OPT300X_FUSION_MODE_MEDIAN, 0.2f, 1.0f);
+    opt300x_interface_debug_print("opt300x: check null fusion %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_fusion_init(&gs_fusion, NULL, OPT300X_FUSION_TEST_SENSOR, OPT300X_FUSION_MODE_MEDIAN, 0.2f, 1.0f);
+    opt300x_interface_debug_print("opt300x: check null handle table %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_fusion_init(&gs_fusion, handle, 1, OPT300X_FUSION_MODE_MEDIAN, 0.2f, 1.0f);
+    opt300x_interface_debug_print("opt300x: check one sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_fusion_init(&gs_fusion, handle, OPT300X_FUSION_MAX_SENSOR + 1, OPT300X_FUSION_MODE_MEDIAN, 0.2f, 1.0f);
+    opt300x_interface_debug_print("opt300x: check too many sensors %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_fusion_init(&gs_fusion, handle, OPT300X_FUSION_TEST_SENSOR,
+                              (opt300x_fusion_mode_t)(OPT300X_FUSION_MODE_TRIMMED_MEAN + 1), 0.2f, 1.0f);
+    opt300x_interface_debug_print("opt300x: check invalid mode %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_fusion_init(&gs_fusion, handle, OPT300X_FUSION_TEST_SENSOR, OPT300X_FUSION_MODE_MEDIAN, -0.2f, 1.0f);
+    opt300x_interface_debug_print("opt300x: check negative ratio %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_fusion_init(&gs_fusion, handle, OPT300X_FUSION_TEST_SENSOR, OPT300X_FUSION_MODE_MEDIAN, 0.2f, -1.0f);
+    opt300x_interface_debug_print("opt300x: check negative floor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_fusion_init(&gs_fusion, handle, OPT300X_FUSION_TEST_SENSOR, OPT300X_FUSION_MODE_MEDIAN, 0.2f, 1.0f);
+    opt300x_interface_debug_print("opt300x: check handle not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    
+    /* opt300x init */
+    for (s = 0; s < OPT300X_FUSION_TEST_SENSOR; s++)
+    {
+        res = opt300x_init(&gs_handle[s]);
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: init failed.\n");
+            while (s != 0)
+            {
+                s--;
+                (void)opt300x_deinit(&gs_handle[s]);
+            }
+            
+            return 1;
+        }
+    }
+    
+    /* every handle caches the configuration, so every handle applies the same settings */
+    for (s = 0; s < OPT300X_FUSION_TEST_SENSOR; s++)
+    {
+        /* set auto range */
+        if (type == OPT3002)
+        {
+            res = opt3002_set_range(&gs_handle[s], OPT3002_RANGE_AUTO);
+        }
+        else if (type == OPT3005)
+        {
+            res = opt3005_set_range(&gs_handle[s], OPT3005_RANGE_AUTO);
+        }
+        else
+        {
+            res = opt300x_set_range(&gs_handle[s], OPT300X_RANGE_AUTO);
+        }
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: set range failed.\n");
+            a_opt300x_fusion_test_deinit();
+            
+            return 1;
+        }
+        
+        /* set conversion time 100ms */
+        res = opt300x_set_conversion_time(&gs_handle[s], OPT300X_CONVERSION_TIME_100_MS);
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: set conversion time failed.\n");
+            a_opt300x_fusion_test_deinit();
+            
+            return 1;
+        }
+        
+        /* start continuous read */
+        res = opt300x_start_continuous_read(&gs_handle[s]);
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: start continuous read failed.\n");
+            a_opt300x_fusion_test_deinit();
+            
+            return 1;
+        }
+    }
+    
+    /* fusion init */
+    res = opt300x_fusion_init(&gs_fusion, handle, OPT300X_FUSION_TEST_SENSOR + 1, OPT300X_FUSION_MODE_MEDIAN, 0.2f, 1.0f);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    res = opt300x_fusion_init(&gs_fusion, handle, OPT300X_FUSION_TEST_SENSOR, OPT300X_FUSION_MODE_MEDIAN, 0.2f, 1.0f);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: fusion init failed.\n");
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check init %s.\n", "ok");
+    
+    /* opt300x_fusion_set_pubsub test */
+    opt300x_interface_debug_print("opt300x: opt300x_fusion_set_pubsub test.\n");
+    res = opt300x_fusion_set_pubsub(NULL, NULL);
+    opt300x_interface_debug_print("opt300x: check null fusion %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    res = opt300x_fusion_set_pubsub(&gs_fusion_idle, NULL);
+    opt300x_interface_debug_print("opt300x: check fusion not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    res = opt300x_fusion_set_pubsub(&gs_fusion, &gs_pubsub_idle);
+    opt300x_interface_debug_print("opt300x: check pubsub not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    res = opt300x_fusion_set_pubsub(&gs_fusion, NULL);
+    opt300x_interface_debug_print("opt300x: check stop publishing %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    
+    /* opt300x_fusion_fuse test */
+    opt300x_interface_debug_print("opt300x: opt300x_fusion_fuse test.\n");
+    raw[0] = 0x1064;
+    raw[1] = 0x1064;
+    raw[2] = 0x3064;
+    res = opt300x_fusion_fuse(NULL, raw, 0x07, 1000, &result);
+    opt300x_interface_debug_print("opt300x: check null fusion %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    res = opt300x_fusion_fuse(&gs_fusion, NULL, 0x07, 1000, &result);
+    opt300x_interface_debug_print("opt300x: check null raw %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    res = opt300x_fusion_fuse(&gs_fusion_idle, raw, 0x07, 1000, &result);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    res = opt300x_fusion_fuse(&gs_fusion, raw, 0x07, 1000, &result);
+    if ((res != 0) || (result.timestamp_us != 1000) || (result.used != 0x03) || (result.rejected != 0x04) ||
+        (result.failed != 0x00) || (a_opt300x_fusion_test_near(result.data, 2.0f) != 0) || (result.raw != 0x00C8))
+    {
+        opt300x_interface_debug_print("opt300x: check outlier error.\n");
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check outlier ok.\n");
+    raw[1] = 0x106E;
+    res = opt300x_fusion_fuse(&gs_fusion, raw, 0x03, 2000, &result);
+    if ((res != 0) || (result.used != 0x03) || (result.rejected != 0x00) || (result.failed != 0x04) ||
+        (a_opt300x_fusion_test_near(result.data, 2.1f) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: check failed sensor error.\n");
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check failed sensor ok.\n");
+    res = opt300x_fusion_fuse(&gs_fusion, raw, 0x00, 3000, &result);
+    opt300x_interface_debug_print("opt300x: check no sample %s.\n", (res == 1) ? "ok" : "error");
+    if (res != 1)
+    {
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    
+    /* opt300x_fusion_get_health test */
+    opt300x_interface_debug_print("opt300x: opt300x_fusion_get_health test.\n");
+    res = opt300x_fusion_get_health(NULL, 0, &health);
+    opt300x_interface_debug_print("opt300x: check null fusion %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    res = opt300x_fusion_get_health(&gs_fusion, 0, NULL);
+    opt300x_interface_debug_print("opt300x: check null health %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    res = opt300x_fusion_get_health(&gs_fusion_idle, 0, &health);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    res = opt300x_fusion_get_health(&gs_fusion, OPT300X_FUSION_TEST_SENSOR, &health);
+    opt300x_interface_debug_print("opt300x: check invalid sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    res = opt300x_fusion_get_health(&gs_fusion, 2, &health);
+    if ((res != 0) || (a_opt300x_fusion_test_near(health, 0.875f * 0.875f * 0.875f) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: check lost health error.\n");
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check lost health ok.\n");
+    
+    /* trimmed mean */
+    res = opt300x_fusion_init(&gs_fusion_mean, handle, 2, OPT300X_FUSION_MODE_TRIMMED_MEAN, 0.2f, 0.0f);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: fusion init failed.\n");
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    raw[0] = 0x1064;
+    raw[1] = 0x1096;
+    res = opt300x_fusion_fuse(&gs_fusion_mean, raw, 0x03, 1000, &result);
+    if ((res != 0) || (result.used != 0x03) || (result.rejected != 0x00) ||
+        (a_opt300x_fusion_test_near(result.data, 2.5f) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: check trimmed mean error.\n");
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    res = opt300x_fusion_init(&gs_fusion_mean, handle, OPT300X_FUSION_TEST_SENSOR, OPT300X_FUSION_MODE_TRIMMED_MEAN, 0.2f, 0.0f);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: fusion init failed.\n");
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    raw[0] = 0x1082;
+    raw[1] = 0x1064;
+    raw[2] = 0x106E;
+    res = opt300x_fusion_fuse(&gs_fusion_mean, raw, 0x07, 1000, &result);
+    if ((res != 0) || (result.used != 0x04) || (result.rejected != 0x00) ||
+        (a_opt300x_fusion_test_near(result.data, 2.2f) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: check trimmed extremes error.\n");
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check trimmed mean ok.\n");
+    
+    /* opt300x_fusion_run test */
+    opt300x_interface_debug_print("opt300x: opt300x_fusion_run test.\n");
+    res = opt300x_fusion_run(NULL, &result);
+    opt300x_interface_debug_print("opt300x: check null fusion %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    res = opt300x_fusion_run(&gs_fusion_idle, &result);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    res = opt300x_fusion_init(&gs_fusion, handle, OPT300X_FUSION_TEST_SENSOR, OPT300X_FUSION_MODE_MEDIAN, 0.2f, 1.0f);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: fusion init failed.\n");
+        a_opt300x_fusion_test_deinit();
+        
+        return 1;
+    }
+    for (j = 0; j < times; j++)
+    {
+        /* delay 200ms */
+        opt300x_interface_delay_ms(200);
+        
+        res = opt300x_fusion_run(&gs_fusion, &result);
+        if ((res != 0) || (result.used == 0))
+        {
+            opt300x_interface_debug_print("opt300x: run failed.\n");
+            a_opt300x_fusion_test_deinit();
+            
+            return 1;
+        }
+        opt300x_interface_debug_print("opt300x: %d/%d raw 0x%04X data %0.2f used 0x%02X.\n", (uint32_t)(j + 1), (uint32_t)times,
+                                      result.raw, result.data, result.used);
+    }
+    
+    /* finish fusion test */
+    opt300x_interface_debug_print("opt300x: finish fusion test.\n");
+    a_opt300x_fusion_test_deinit();
+    
+    return 0;
+}
@@ -114,8 +114,15 @@ uint8_t opt300x_interrupt_test(opt300x_t type, opt300x_address_t addr_pin,
     DRIVER_OPT300X_LINK_IIC_DEINIT(&gs_handle, opt300x_interface_iic_deinit);
     DRIVER_OPT300X_LINK_IIC_READ(&gs_handle, opt300x_interface_iic_read);
     DRIVER_OPT300X_LINK_IIC_WRITE(&gs_handle, opt300x_interface_iic_write);
+    DRIVER_OPT300X_LINK_IIC_READ_COMMAND(&gs_handle, opt300x_interface_iic_read_cmd);
+    DRIVER_OPT300X_LINK_IIC_WRITE_COMMAND(&gs_handle, opt300x_interface_iic_write_cmd);
     DRIVER_OPT300X_LINK_DELAY_MS(&gs_handle, opt300x_interface_delay_ms);
-    DRIVER_OPT300X_LINK_DEBUG_PRINT(&gs_handle, opt300x_interface_debug_print);
+    DRIVER_OPT300X_LINK_DEBUG_PRINT(&gs_handle, opt300x_interface_debug_log);
+    DRIVER_OPT300X_LINK_MUTEX_INIT(&gs_handle, opt300x_interface_mutex_init);
+    DRIVER_OPT300X_LINK_MUTEX_DEINIT(&gs_handle, opt300x_interface_mutex_deinit);
+    DRIVER_OPT300X_LINK_MUTEX_LOCK(&gs_handle, opt300x_interface_mutex_lock);
+    DRIVER_OPT300X_LINK_MUTEX_UNLOCK(&gs_handle, opt300x_interface_mutex_unlock);
+    DRIVER_OPT300X_LINK_TIMESTAMP_US(&gs_handle, opt300x_interface_timestamp_us);
     DRIVER_OPT300X_LINK_RECEIVE_CALLBACK(&gs_handle, a_receive_callback);
 
     /* get chip information */
@@ -0,0 +1,533 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_pubsub_test.c
+ * @brief     driver opt300x pubsub test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_opt300x_pubsub_test.h"
+
+static opt300x_handle_t gs_handle;                                      /**< opt300x handle */
+static opt300x_pubsub_t gs_pubsub;                                      /**< pubsub */
+static opt300x_pubsub_t gs_pubsub_idle;                                 /**< pubsub never inited */
+static volatile uint32_t gs_notify[OPT300X_PUBSUB_MAX_SUBSCRIBER];      /**< notify counters */
+
+/**
+ * @brief     notify function
+ * @param[in] id subscriber id
+ * @note      none
+ */
+static void a_opt300x_pubsub_test_notify(uint8_t id)
+{
+    gs_notify[id]++;
+}
+
+/**
+ * @brief     pubsub test
+ * @param[in] type chip type
+ * @param[in] addr_pin iic device address
+ * @param[in] times test times
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      none
+ */
+uint8_t opt300x_pubsub_test(opt300x_t type, opt300x_address_t addr_pin, uint32_t times)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t id[OPT300X_PUBSUB_MAX_SUBSCRIBER];
+    uint8_t id_check;
+    uint32_t j;
+    uint32_t overrun;
+    opt300x_info_t info;
+    opt300x_pubsub_sample_t sample;
+    
+    /* link interface function */
+    DRIVER_OPT300X_LINK_INIT(&gs_handle, opt300x_handle_t);
+    DRIVER_OPT300X_LINK_IIC_INIT(&gs_handle, opt300x_interface_iic_init);
+    DRIVER_OPT300X_LINK_IIC_DEINIT(&gs_handle, opt300x_interface_iic_deinit);
+    DRIVER_OPT300X_LINK_IIC_READ(&gs_handle, opt300x_interface_iic_read);
+    DRIVER_OPT300X_LINK_IIC_WRITE(&gs_handle, opt300x_interface_iic_write);
+    DRIVER_OPT300X_LINK_IIC_READ_COMMAND(&gs_handle, opt300x_interface_iic_read_cmd);
+    DRIVER_OPT300X_LINK_IIC_WRITE_COMMAND(&gs_handle, opt300x_interface_iic_write_cmd);
+    DRIVER_OPT300X_LINK_DELAY_MS(&gs_handle, opt300x_interface_delay_ms);
+    DRIVER_OPT300X_LINK_DEBUG_PRINT(&gs_handle, opt300x_interface_debug_log);
+    DRIVER_OPT300X_LINK_MUTEX_INIT(&gs_handle, opt300x_interface_mutex_init);
+    DRIVER_OPT300X_LINK_MUTEX_DEINIT(&gs_handle, opt300x_interface_mutex_deinit);
+    DRIVER_OPT300X_LINK_MUTEX_LOCK(&gs_handle, opt300x_interface_mutex_lock);
+    DRIVER_OPT300X_LINK_MUTEX_UNLOCK(&gs_handle, opt300x_interface_mutex_unlock);
+    DRIVER_OPT300X_LINK_TIMESTAMP_US(&gs_handle, opt300x_interface_timestamp_us);
+    DRIVER_OPT300X_LINK_RECEIVE_CALLBACK(&gs_handle, opt300x_interface_receive_callback);
+    
+    /* get chip information */
+    res = opt300x_info(&info);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get info failed.\n");
+        
+        return 1;
+    }
+    else
+    {
+        /* print chip information */
+        opt300x_interface_debug_print("opt300x: chip is %s.\n", info.chip_name);
+        opt300x_interface_debug_print("opt300x: manufacturer is %s.\n", info.manufacturer_name);
+        opt300x_interface_debug_print("opt300x: interface is %s.\n", info.interface);
+        opt300x_interface_debug_print("opt300x: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        opt300x_interface_debug_print("opt300x: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        opt300x_interface_debug_print("opt300x: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        opt300x_interface_debug_print("opt300x: max current is %0.2fmA.\n", info.max_current_ma);
+        opt300x_interface_debug_print("opt300x: max temperature is %0.1fC.\n", info.temperature_max);
+        opt300x_interface_debug_print("opt300x: min temperature is %0.1fC.\n", info.temperature_min);
+    }
+    
+    /* start pubsub test */
+    opt300x_interface_debug_print("opt300x: start pubsub test.\n");
+    
+    /* set chip type */
+    res = opt300x_set_type(&gs_handle, type);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set type failed.\n");
+        
+        return 1;
+    }
+    
+    /* set iic address */
+    res = opt300x_set_addr_pin(&gs_handle, addr_pin);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set addr pin failed.\n");
+        
+        return 1;
+    }
+    
+    /* opt300x_pubsub_init test */
+    opt300x_interface_debug_print("opt300x: opt300x_pubsub_init test.\n");
+    res = opt300x_pubsub_init(NULL, &gs_handle);
+    opt300x_interface_debug_print("opt300x: check null pubsub %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_pubsub_init(&gs_pubsub, NULL);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_pubsub_init(&gs_pubsub, &gs_handle);
+    opt300x_interface_debug_print("opt300x: check handle not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    
+    /* opt300x init */
+    res = opt300x_init(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* set auto range */
+    if (type == OPT3002)
+    {
+        res = opt3002_set_range(&gs_handle, OPT3002_RANGE_AUTO);
+    }
+    else if (type == OPT3005)
+    {
+        res = opt3005_set_range(&gs_handle, OPT3005_RANGE_AUTO);
+    }
+    else
+    {
+        res = opt300x_set_range(&gs_handle, OPT300X_RANGE_AUTO);
+    }
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set range failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set conversion time 100ms */
+    res = opt300x_set_conversion_time(&gs_handle, OPT300X_CONVERSION_TIME_100_MS);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set conversion time failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* start continuous read */
+    res = opt300x_start_continuous_read(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: start continuous read failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* pubsub init */
+    res = opt300x_pubsub_init(&gs_pubsub, &gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: pubsub init failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check init %s.\n", "ok");
+    
+    /* opt300x_pubsub_subscribe test */
+    opt300x_interface_debug_print("opt300x: opt300x_pubsub_subscribe test.\n");
+    res = opt300x_pubsub_subscribe(NULL, 1, 1, 1, NULL, &id_check);
+    opt300x_interface_debug_print("opt300x: check null pubsub %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_pubsub_subscribe(&gs_pubsub_idle, 1, 1, 1, NULL, &id_check);
+    opt300x_interface_debug_print("opt300x: check pubsub not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_pubsub_subscribe(&gs_pubsub, 0, 1, 1, NULL, &id_check);
+    opt300x_interface_debug_print("opt300x: check decimation 0 %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_pubsub_subscribe(&gs_pubsub, 1, 0, 1, NULL, &id_check);
+    opt300x_interface_debug_print("opt300x: check window 0 %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_pubsub_subscribe(&gs_pubsub, 1, OPT300X_PUBSUB_MAX_WINDOW + 1, 1, NULL, &id_check);
+    opt300x_interface_debug_print("opt300x: check window over the max %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_pubsub_subscribe(&gs_pubsub, 1, 1, 0, NULL, &id_check);
+    opt300x_interface_debug_print("opt300x: check depth 0 %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_pubsub_subscribe(&gs_pubsub, 1, 1, OPT300X_PUBSUB_MAX_DEPTH + 1, NULL, &id_check);
+    opt300x_interface_debug_print("opt300x: check depth over the max %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_pubsub_subscribe(&gs_pubsub, 1, 1, 1, NULL, NULL);
+    opt300x_interface_debug_print("opt300x: check null id %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_pubsub_subscribe(&gs_pubsub, 1, 1, 4, a_opt300x_pubsub_test_notify, &id[0]);
+    if (res == 0)
+    {
+        res = opt300x_pubsub_subscribe(&gs_pubsub, 2, 4, OPT300X_PUBSUB_MAX_DEPTH, a_opt300x_pubsub_test_notify, &id[1]);
+    }
+    for (i = 2; (i < OPT300X_PUBSUB_MAX_SUBSCRIBER) && (res == 0); i++)
+    {
+        res = opt300x_pubsub_subscribe(&gs_pubsub, 1, 1, 1, NULL, &id[i]);
+    }
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: subscribe failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check subscribe %s.\n", "ok");
+    res = opt300x_pubsub_subscribe(&gs_pubsub, 1, 1, 1, NULL, &id_check);
+    opt300x_interface_debug_print("opt300x: check no free subscriber %s.\n", (res == 1) ? "ok" : "error");
+    if (res != 1)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* opt300x_pubsub_unsubscribe test */
+    opt300x_interface_debug_print("opt300x: opt300x_pubsub_unsubscribe test.\n");
+    res = opt300x_pubsub_unsubscribe(NULL, id[2]);
+    opt300x_interface_debug_print("opt300x: check null pubsub %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_pubsub_unsubscribe(&gs_pubsub_idle, id[2]);
+    opt300x_interface_debug_print("opt300x: check pubsub not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_pubsub_unsubscribe(&gs_pubsub, OPT300X_PUBSUB_MAX_SUBSCRIBER);
+    opt300x_interface_debug_print("opt300x: check invalid id %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    for (i = 2; i < OPT300X_PUBSUB_MAX_SUBSCRIBER; i++)
+    {
+        res = opt300x_pubsub_unsubscribe(&gs_pubsub, id[i]);
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: unsubscribe failed.\n");
+            (void)opt300x_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    opt300x_interface_debug_print("opt300x: check unsubscribe %s.\n", "ok");
+    
+    /* opt300x_pubsub_publish test */
+    opt300x_interface_debug_print("opt300x: opt300x_pubsub_publish test.\n");
+    res = opt300x_pubsub_publish(NULL, 0, 0.0f);
+    opt300x_interface_debug_print("opt300x: check null pubsub %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_pubsub_publish(&gs_pubsub_idle, 0, 0.0f);
+    opt300x_interface_debug_print("opt300x: check pubsub not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    for (i = 0; i < OPT300X_PUBSUB_MAX_SUBSCRIBER; i++)
+    {
+        gs_notify[i] = 0;
+    }
+    for (i = 1; i <= 6; i++)
+    {
+        res = opt300x_pubsub_publish(&gs_pubsub, i, (float)i);
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: publish failed.\n");
+            (void)opt300x_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    res = ((gs_notify[id[0]] == 6) && (gs_notify[id[1]] == 3)) ? 0 : 1;
+    opt300x_interface_debug_print("opt300x: check notify %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* opt300x_pubsub_read test */
+    opt300x_interface_debug_print("opt300x: opt300x_pubsub_read test.\n");
+    res = opt300x_pubsub_read(NULL, id[0], &sample);
+    opt300x_interface_debug_print("opt300x: check null pubsub %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_pubsub_read(&gs_pubsub_idle, id[0], &sample);
+    opt300x_interface_debug_print("opt300x: check pubsub not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_pubsub_read(&gs_pubsub, id[2], &sample);
+    opt300x_interface_debug_print("opt300x: check removed id %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    for (i = 3; i <= 6; i++)
+    {
+        res = opt300x_pubsub_read(&gs_pubsub, id[0], &sample);
+        if ((res != 0) || (sample.raw != i) || (sample.data != (float)i) || (sample.count != 1))
+        {
+            opt300x_interface_debug_print("opt300x: check the newest samples of a full queue %s.\n", "error");
+            (void)opt300x_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    opt300x_interface_debug_print("opt300x: check the newest samples of a full queue %s.\n", "ok");
+    res = opt300x_pubsub_read(&gs_pubsub, id[0], &sample);
+    opt300x_interface_debug_print("opt300x: check empty queue %s.\n", (res == 5) ? "ok" : "error");
+    if (res != 5)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    for (i = 1; i <= 3; i++)
+    {
+        res = opt300x_pubsub_read(&gs_pubsub, id[1], &sample);
+        if ((res != 0) || (sample.raw != 2 * i - 1) || (sample.count != ((i == 1) ? 1 : ((i == 2) ? 3 : 4))) ||
+            (sample.data != ((i == 1) ? 1.0f : ((i == 2) ? 2.0f : 3.5f))))
+        {
+            opt300x_interface_debug_print("opt300x: check decimation and average %s.\n", "error");
+            (void)opt300x_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    opt300x_interface_debug_print("opt300x: check decimation and average %s.\n", "ok");
+    
+    /* opt300x_pubsub_get_overrun test */
+    opt300x_interface_debug_print("opt300x: opt300x_pubsub_get_overrun test.\n");
+    res = opt300x_pubsub_get_overrun(NULL, id[0], &overrun);
+    opt300x_interface_debug_print("opt300x: check null pubsub %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_pubsub_get_overrun(&gs_pubsub_idle, id[0], &overrun);
+    opt300x_interface_debug_print("opt300x: check pubsub not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_pubsub_get_overrun(&gs_pubsub, OPT300X_PUBSUB_MAX_SUBSCRIBER, &overrun);
+    opt300x_interface_debug_print("opt300x: check invalid id %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_pubsub_get_overrun(&gs_pubsub, id[0], &overrun);
+    opt300x_interface_debug_print("opt300x: check overrun %s.\n", ((res == 0) && (overrun == 2)) ? "ok" : "error");
+    if ((res != 0) || (overrun != 2))
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* opt300x_pubsub_poll test */
+    opt300x_interface_debug_print("opt300x: opt300x_pubsub_poll test.\n");
+    res = opt300x_pubsub_poll(NULL);
+    opt300x_interface_debug_print("opt300x: check null pubsub %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_pubsub_poll(&gs_pubsub_idle);
+    opt300x_interface_debug_print("opt300x: check pubsub not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    for (j = 0; j < times; j++)
+    {
+        /* delay 200ms */
+        opt300x_interface_delay_ms(200);
+        
+        res = opt300x_pubsub_poll(&gs_pubsub);
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: poll failed.\n");
+            (void)opt300x_deinit(&gs_handle);
+            
+            return 1;
+        }
+        res = opt300x_pubsub_read(&gs_pubsub, id[0], &sample);
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: read failed.\n");
+            (void)opt300x_deinit(&gs_handle);
+            
+            return 1;
+        }
+        opt300x_interface_debug_print("opt300x: %d/%d raw 0x%04X data %0.2f.\n", (uint32_t)(j + 1), (uint32_t)times,
+                                      sample.raw, sample.data);
+    }
+    
+    /* finish pubsub test */
+    opt300x_interface_debug_print("opt300x: finish pubsub test.\n");
+    (void)opt300x_deinit(&gs_handle);
+    
+    return 0;
+}
@@ -36,8 +36,37 @@
 
 #include "driver_opt300x_register_test.h"
 #include <stdlib.h>
+#include <math.h>
 
-static opt300x_handle_t gs_handle;        /**< opt300x handle */
+static opt300x_handle_t gs_handle;                  /**< opt300x handle */
+static opt300x_handle_t gs_handle_idle;             /**< opt300x handle never inited */
+static opt300x_handle_t gs_ready[4];                /**< scanned handles */
+static volatile uint32_t gs_event_count;            /**< event counter */
+static opt300x_event_t gs_event;                    /**< last event */
+static volatile uint32_t gs_health_count;           /**< health change counter */
+static volatile uint8_t gs_health;                  /**< last health */
+
+/**
+ * @brief     event callback
+ * @param[in] *event pointer to an event structure
+ * @note      none
+ */
+static void a_opt300x_register_test_event(opt300x_event_t *event)
+{
+    gs_event = *event;
+    gs_event_count++;
+}
+
+/**
+ * @brief     health callback
+ * @param[in] health new health
+ * @note      none
+ */
+static void a_opt300x_register_test_health(uint8_t health)
+{
+    gs_health = health;
+    gs_health_count++;
+}
 
 /**
  * @brief     register test
@@ -51,9 +80,16 @@ static opt300x_handle_t gs_handle;        /**< opt300x handle */
 uint8_t opt300x_register_test(opt300x_t type, opt300x_address_t addr)
 {
     uint8_t res;
+    uint8_t i;
+    uint8_t cmd;
     uint16_t reg;
     uint16_t limit;
     uint16_t limit_check;
+    uint32_t count_check;
+    uint32_t spurious_check;
+    uint32_t reset_check;
+    uint32_t latency_max;
+    uint32_t us;
     float nw_cm2;
     float nw_cm2_check;
     float lux;
@@ -68,6 +104,11 @@ uint8_t opt300x_register_test(opt300x_t type, opt300x_address_t addr)
     opt300x_conversion_time_t t;
     opt300x_interrupt_polarity_t polarity;
     opt300x_fault_count_t count;
+    opt300x_storm_statistics_t stat;
+    opt300x_handle_t *list[2];
+    opt300x_scan_t scan[4];
+    opt300x_health_t health;
+    uint8_t num;
     
     /* link interface function */
     DRIVER_OPT300X_LINK_INIT(&gs_handle, opt300x_handle_t);
@@ -75,8 +116,15 @@ uint8_t opt300x_register_test(opt300x_t type, opt300x_address_t addr)
     DRIVER_OPT300X_LINK_IIC_DEINIT(&gs_handle, opt300x_interface_iic_deinit);
     DRIVER_OPT300X_LINK_IIC_READ(&gs_handle, opt300x_interface_iic_read);
     DRIVER_OPT300X_LINK_IIC_WRITE(&gs_handle, opt300x_interface_iic_write);
+    DRIVER_OPT300X_LINK_IIC_READ_COMMAND(&gs_handle, opt300x_interface_iic_read_cmd);
+    DRIVER_OPT300X_LINK_IIC_WRITE_COMMAND(&gs_handle, opt300x_interface_iic_write_cmd);
     DRIVER_OPT300X_LINK_DELAY_MS(&gs_handle, opt300x_interface_delay_ms);
-    DRIVER_OPT300X_LINK_DEBUG_PRINT(&gs_handle, opt300x_interface_debug_print);
+    DRIVER_OPT300X_LINK_DEBUG_PRINT(&gs_handle, opt300x_interface_debug_log);
+    DRIVER_OPT300X_LINK_MUTEX_INIT(&gs_handle, opt300x_interface_mutex_init);
+    DRIVER_OPT300X_LINK_MUTEX_DEINIT(&gs_handle, opt300x_interface_mutex_deinit);
+    DRIVER_OPT300X_LINK_MUTEX_LOCK(&gs_handle, opt300x_interface_mutex_lock);
+    DRIVER_OPT300X_LINK_MUTEX_UNLOCK(&gs_handle, opt300x_interface_mutex_unlock);
+    DRIVER_OPT300X_LINK_TIMESTAMP_US(&gs_handle, opt300x_interface_timestamp_us);
     DRIVER_OPT300X_LINK_RECEIVE_CALLBACK(&gs_handle, opt300x_interface_receive_callback);
     
     /* get chip information */
@@ -1467,6 +1515,1179 @@ uint8_t opt300x_register_test(opt300x_t type, opt300x_address_t addr)
         opt300x_interface_debug_print("opt300x: check lux %0.2f.\n", lux_check);
     }
     
+    /* opt300x_start_deadband/opt300x_stop_deadband test */
+    opt300x_interface_debug_print("opt300x: opt300x_start_deadband/opt300x_stop_deadband test.\n");
+    
+    /* set the fast conversion */
+    res = opt300x_set_conversion_time(&gs_handle, OPT300X_CONVERSION_TIME_100_MS);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set conversion time failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set fault count one */
+    res = opt300x_set_fault_count(&gs_handle, OPT300X_FAULT_COUNT_ONE);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set fault count failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* start in the shutdown mode */
+    res = opt300x_stop_continuous_read(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: stop continuous read failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_start_deadband(&gs_handle, OPT300X_DEADBAND_POLICY_PERCENT, 10.0f);
+    opt300x_interface_debug_print("opt300x: check shutdown mode %s.\n", res == 5 ? "ok" : "error");
+    res = opt300x_start_continuous_read(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: start continuous read failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* invalid widths */
+    res = opt300x_start_deadband(&gs_handle, OPT300X_DEADBAND_POLICY_ABSOLUTE, NAN);
+    opt300x_interface_debug_print("opt300x: check nan width %s.\n", res == 4 ? "ok" : "error");
+    res = opt300x_start_deadband(&gs_handle, OPT300X_DEADBAND_POLICY_ABSOLUTE, 0.0f);
+    opt300x_interface_debug_print("opt300x: check zero width %s.\n", res == 4 ? "ok" : "error");
+    res = opt300x_start_deadband(&gs_handle, OPT300X_DEADBAND_POLICY_PERCENT, 100.0f);
+    opt300x_interface_debug_print("opt300x: check percent width %s.\n", res == 4 ? "ok" : "error");
+    res = opt300x_start_deadband(&gs_handle, OPT300X_DEADBAND_POLICY_LOG, 9.0f);
+    opt300x_interface_debug_print("opt300x: check log width %s.\n", res == 4 ? "ok" : "error");
+    
+    /* start deadband */
+    res = opt300x_start_deadband(&gs_handle, OPT300X_DEADBAND_POLICY_LOG, 1.0f);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: start deadband failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: start deadband with one stop.\n");
+    res = opt300x_get_interrupt_latch(&gs_handle, &enable);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get interrupt latch failed.\n");
+        (void)opt300x_stop_deadband(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check latch %s.\n", enable == OPT300X_BOOL_TRUE ? "ok" : "error");
+    res = opt300x_get_low_limit(&gs_handle, &limit);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get low limit failed.\n");
+        (void)opt300x_stop_deadband(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_get_high_limit(&gs_handle, &limit_check);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get high limit failed.\n");
+        (void)opt300x_stop_deadband(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check window %s.\n",
+                                  ((uint32_t)(limit & 0x0FFF) << (limit >> 12)) < ((uint32_t)(limit_check & 0x0FFF) << (limit_check >> 12)) ? "ok" : "error");
+    res = opt300x_get_deadband_rearm_count(&gs_handle, &count_check);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get deadband rearm count failed.\n");
+        (void)opt300x_stop_deadband(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check rearm count %s.\n", count_check == 0 ? "ok" : "error");
+    
+    /* force a crossing */
+    res = opt300x_set_high_limit(&gs_handle, 0x0000);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set high limit failed.\n");
+        (void)opt300x_stop_deadband(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_delay_ms(250);
+    res = opt300x_irq_handler(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: irq handler failed.\n");
+        (void)opt300x_stop_deadband(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_get_deadband_rearm_count(&gs_handle, &count_check);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get deadband rearm count failed.\n");
+        (void)opt300x_stop_deadband(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check rearm count %s.\n", count_check == 1 ? "ok" : "error");
+    res = opt300x_get_high_limit(&gs_handle, &limit_check);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get high limit failed.\n");
+        (void)opt300x_stop_deadband(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check re-centred window %s.\n", limit_check != 0x0000 ? "ok" : "error");
+    
+    /* stop deadband */
+    res = opt300x_stop_deadband(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: stop deadband failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: stop deadband.\n");
+    res = opt300x_stop_continuous_read(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: stop continuous read failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* opt300x_start_eoc_stream/opt300x_stop_eoc_stream test */
+    opt300x_interface_debug_print("opt300x: opt300x_start_eoc_stream/opt300x_stop_eoc_stream test.\n");
+    
+    /* set a known low limit */
+    res = opt300x_set_low_limit(&gs_handle, 0x1234);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set low limit failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* start eoc stream */
+    res = opt300x_start_eoc_stream(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: start eoc stream failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: start eoc stream.\n");
+    res = opt300x_get_low_limit(&gs_handle, &limit);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get low limit failed.\n");
+        (void)opt300x_stop_eoc_stream(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check eoc pattern %s.\n", (limit & 0xC000) == 0xC000 ? "ok" : "error");
+    res = opt300x_get_interrupt_latch(&gs_handle, &enable);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get interrupt latch failed.\n");
+        (void)opt300x_stop_eoc_stream(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check latch %s.\n", enable == OPT300X_BOOL_TRUE ? "ok" : "error");
+    
+    /* start again keeps the saved limit */
+    res = opt300x_start_eoc_stream(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: start eoc stream failed.\n");
+        (void)opt300x_stop_eoc_stream(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* one conversion */
+    opt300x_interface_delay_ms(250);
+    res = opt300x_irq_handler(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: irq handler failed.\n");
+        (void)opt300x_stop_eoc_stream(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_get_eoc_stream_count(&gs_handle, &count_check, &spurious_check);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get eoc stream count failed.\n");
+        (void)opt300x_stop_eoc_stream(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check eoc count %s.\n", (count_check == 1) && (spurious_check == 0) ? "ok" : "error");
+    
+    /* stop eoc stream */
+    res = opt300x_stop_eoc_stream(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: stop eoc stream failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: stop eoc stream.\n");
+    res = opt300x_get_low_limit(&gs_handle, &limit);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get low limit failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check restored low limit %s.\n", limit == 0x1234 ? "ok" : "error");
+    res = opt300x_stop_continuous_read(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: stop continuous read failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* event_callback test */
+    opt300x_interface_debug_print("opt300x: event_callback test.\n");
+    
+    /* link the event callback */
+    DRIVER_OPT300X_LINK_EVENT_CALLBACK(&gs_handle, a_opt300x_register_test_event);
+    gs_event_count = 0;
+    res = opt300x_start_continuous_read(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: start continuous read failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* force a high flag */
+    res = opt300x_set_high_limit(&gs_handle, 0x0000);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set high limit failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_delay_ms(250);
+    res = opt300x_irq_handler(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: irq handler failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check event count %s.\n", gs_event_count == 1 ? "ok" : "error");
+    opt300x_interface_debug_print("opt300x: check event timestamp %s.\n", gs_event.timestamp_us != 0 ? "ok" : "error");
+    opt300x_interface_debug_print("opt300x: check event high flag %s.\n",
+                                  (gs_event.high_flag == 1) && (((gs_event.config >> 6) & 0x01) == 1) ? "ok" : "error");
+    opt300x_interface_debug_print("opt300x: check event data %s.\n",
+                                  (gs_event.raw != 0) && (gs_event.data > 0.0f) ? "ok" : "error");
+    
+    /* restore the high limit */
+    DRIVER_OPT300X_LINK_EVENT_CALLBACK(&gs_handle, NULL);
+    res = opt300x_set_high_limit(&gs_handle, 0xBFFF);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set high limit failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_stop_continuous_read(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: stop continuous read failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* opt300x_start_storm_control/opt300x_stop_storm_control test */
+    opt300x_interface_debug_print("opt300x: opt300x_start_storm_control/opt300x_stop_storm_control test.\n");
+    
+    /* disable the interrupt latch */
+    res = opt300x_set_interrupt_latch(&gs_handle, OPT300X_BOOL_FALSE);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set interrupt latch failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_start_storm_control(&gs_handle, 1, 2);
+    opt300x_interface_debug_print("opt300x: check latch disabled %s.\n", res == 6 ? "ok" : "error");
+    res = opt300x_set_interrupt_latch(&gs_handle, OPT300X_BOOL_TRUE);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set interrupt latch failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_start_storm_control(&gs_handle, 0, 2);
+    opt300x_interface_debug_print("opt300x: check invalid rate %s.\n", res == 5 ? "ok" : "error");
+    
+    /* start storm control at one irq per second */
+    res = opt300x_set_low_limit(&gs_handle, 0x0000);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set low limit failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_start_continuous_read(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: start continuous read failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_start_storm_control(&gs_handle, 1, 2);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: start storm control failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: start storm control.\n");
+    
+    /* a storm of three irqs */
+    res = opt300x_set_high_limit(&gs_handle, 0x0000);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set high limit failed.\n");
+        (void)opt300x_stop_storm_control(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_delay_ms(250);
+    for (i = 0; i < 3; i++)
+    {
+        res = opt300x_irq_handler(&gs_handle);
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: irq handler failed.\n");
+            (void)opt300x_stop_storm_control(&gs_handle);
+            (void)opt300x_stop_continuous_read(&gs_handle);
+            (void)opt300x_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    res = opt300x_storm_poll(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: storm poll failed.\n");
+        (void)opt300x_stop_storm_control(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_get_storm_statistics(&gs_handle, &stat);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get storm statistics failed.\n");
+        (void)opt300x_stop_storm_control(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check storm masked %s.\n",
+                                  (stat.masked == 1) && (stat.irq_count == 3) && (stat.irq_masked == 1) &&
+                                  (stat.enter_count == 1) && (stat.poll_count == 1) ? "ok" : "error");
+    
+    /* calm down */
+    res = opt300x_set_high_limit(&gs_handle, 0xBFFF);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set high limit failed.\n");
+        (void)opt300x_stop_storm_control(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_delay_ms(250);
+    for (i = 0; i < 3; i++)
+    {
+        res = opt300x_storm_poll(&gs_handle);
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: storm poll failed.\n");
+            (void)opt300x_stop_storm_control(&gs_handle);
+            (void)opt300x_stop_continuous_read(&gs_handle);
+            (void)opt300x_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    res = opt300x_get_storm_statistics(&gs_handle, &stat);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get storm statistics failed.\n");
+        (void)opt300x_stop_storm_control(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check storm calm %s.\n", (stat.masked == 0) && (stat.exit_count == 1) ? "ok" : "error");
+    
+    /* stop storm control */
+    res = opt300x_stop_storm_control(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: stop storm control failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: stop storm control.\n");
+    res = opt300x_stop_continuous_read(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: stop continuous read failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* opt300x_set_limits test */
+    opt300x_interface_debug_print("opt300x: opt300x_set_limits test.\n");
+    
+    /* low above high */
+    res = opt300x_set_limits(&gs_handle, 0x1800, 0x0100);
+    opt300x_interface_debug_print("opt300x: check window order %s.\n", res == 4 ? "ok" : "error");
+    
+    /* the same level in two encodings */
+    res = opt300x_set_limits(&gs_handle, 0x1100, 0x0200);
+    opt300x_interface_debug_print("opt300x: check equal levels %s.\n", res == 0 ? "ok" : "error");
+    
+    /* set limits */
+    res = opt300x_set_limits(&gs_handle, 0x1100, 0x5FFF);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set limits failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: set limits 0x1100 0x5FFF.\n");
+    res = opt300x_get_low_limit(&gs_handle, &limit);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get low limit failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_get_high_limit(&gs_handle, &limit_check);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get high limit failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check limits %s.\n", (limit == 0x1100) && (limit_check == 0x5FFF) ? "ok" : "error");
+    
+    if (type == OPT3002)
+    {
+        /* opt3002_set_limits_nw_cm2 test */
+        opt300x_interface_debug_print("opt300x: opt3002_set_limits_nw_cm2 test.\n");
+        
+        res = opt3002_set_limits_nw_cm2(&gs_handle, NAN, 1000.0f);
+        opt300x_interface_debug_print("opt300x: check nan limit %s.\n", res == 4 ? "ok" : "error");
+        res = opt3002_set_limits_nw_cm2(&gs_handle, -1.0f, 1000.0f);
+        opt300x_interface_debug_print("opt300x: check negative limit %s.\n", res == 4 ? "ok" : "error");
+        res = opt3002_set_limits_nw_cm2(&gs_handle, 1000.0f, 10.0f);
+        opt300x_interface_debug_print("opt300x: check window order %s.\n", res == 4 ? "ok" : "error");
+        res = opt300x_set_limits_lux(&gs_handle, 10.0f, 1000.0f);
+        opt300x_interface_debug_print("opt300x: check chip type %s.\n", res == 5 ? "ok" : "error");
+        res = opt3002_set_limits_nw_cm2(&gs_handle, 100.0f, 10000.0f);
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: set limits nw cm2 failed.\n");
+            (void)opt300x_deinit(&gs_handle);
+            
+            return 1;
+        }
+        opt300x_interface_debug_print("opt300x: set limits 100.00nW/cm2 10000.00nW/cm2.\n");
+        res = opt300x_get_low_limit(&gs_handle, &limit);
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: get low limit failed.\n");
+            (void)opt300x_deinit(&gs_handle);
+            
+            return 1;
+        }
+        res = opt3002_limit_convert_to_data(&gs_handle, limit, &nw_cm2_check);
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: limit convert to data failed.\n");
+            (void)opt300x_deinit(&gs_handle);
+            
+            return 1;
+        }
+        opt300x_interface_debug_print("opt300x: check low limit %s.\n", fabsf(nw_cm2_check - 100.0f) < 5.0f ? "ok" : "error");
+    }
+    else
+    {
+        /* opt300x_set_limits_lux test */
+        opt300x_interface_debug_print("opt300x: opt300x_set_limits_lux test.\n");
+        
+        res = opt300x_set_limits_lux(&gs_handle, NAN, 1000.0f);
+        opt300x_interface_debug_print("opt300x: check nan limit %s.\n", res == 4 ? "ok" : "error");
+        res = opt300x_set_limits_lux(&gs_handle, -1.0f, 1000.0f);
+        opt300x_interface_debug_print("opt300x: check negative limit %s.\n", res == 4 ? "ok" : "error");
+        res = opt300x_set_limits_lux(&gs_handle, 1000.0f, 10.0f);
+        opt300x_interface_debug_print("opt300x: check window order %s.\n", res == 4 ? "ok" : "error");
+        res = opt3002_set_limits_nw_cm2(&gs_handle, 10.0f, 1000.0f);
+        opt300x_interface_debug_print("opt300x: check chip type %s.\n", res == 5 ? "ok" : "error");
+        res = opt300x_set_limits_lux(&gs_handle, 10.0f, 1000.0f);
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: set limits lux failed.\n");
+            (void)opt300x_deinit(&gs_handle);
+            
+            return 1;
+        }
+        opt300x_interface_debug_print("opt300x: set limits 10.00lux 1000.00lux.\n");
+        res = opt300x_get_low_limit(&gs_handle, &limit);
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: get low limit failed.\n");
+            (void)opt300x_deinit(&gs_handle);
+            
+            return 1;
+        }
+        res = opt300x_limit_convert_to_data(&gs_handle, limit, &lux_check);
+        if (res != 0)
+        {
+            opt300x_interface_debug_print("opt300x: limit convert to data failed.\n");
+            (void)opt300x_deinit(&gs_handle);
+            
+            return 1;
+        }
+        opt300x_interface_debug_print("opt300x: check low limit %s.\n", fabsf(lux_check - 10.0f) < 0.5f ? "ok" : "error");
+    }
+    
+    /* the eoc stream owns the limits */
+    res = opt300x_start_eoc_stream(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: start eoc stream failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_set_limits(&gs_handle, 0x1100, 0x5FFF);
+    opt300x_interface_debug_print("opt300x: check limits in eoc stream %s.\n", res == 5 ? "ok" : "error");
+    if (type == OPT3002)
+    {
+        res = opt3002_set_limits_nw_cm2(&gs_handle, 100.0f, 10000.0f);
+    }
+    else
+    {
+        res = opt300x_set_limits_lux(&gs_handle, 10.0f, 1000.0f);
+    }
+    opt300x_interface_debug_print("opt300x: check converted limits in eoc stream %s.\n", res == 6 ? "ok" : "error");
+    res = opt300x_stop_eoc_stream(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: stop eoc stream failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_stop_continuous_read(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: stop continuous read failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* opt300x_alert_irq_handler test */
+    opt300x_interface_debug_print("opt300x: opt300x_alert_irq_handler test.\n");
+    
+    /* invalid handles */
+    list[0] = NULL;
+    res = opt300x_alert_irq_handler(list, 1);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", res == 2 ? "ok" : "error");
+    list[0] = &gs_handle;
+    res = opt300x_alert_irq_handler(list, 0);
+    opt300x_interface_debug_print("opt300x: check zero handle %s.\n", res == 2 ? "ok" : "error");
+    list[1] = &gs_handle_idle;
+    res = opt300x_alert_irq_handler(list, 2);
+    opt300x_interface_debug_print("opt300x: check idle handle %s.\n", res == 3 ? "ok" : "error");
+    
+    /* no iic_read_cmd */
+    DRIVER_OPT300X_LINK_IIC_READ_COMMAND(&gs_handle, NULL);
+    res = opt300x_alert_irq_handler(list, 1);
+    opt300x_interface_debug_print("opt300x: check null iic_read_cmd %s.\n", res == 1 ? "ok" : "error");
+    DRIVER_OPT300X_LINK_IIC_READ_COMMAND(&gs_handle, opt300x_interface_iic_read_cmd);
+    
+    /* no device asserts the line in the shutdown mode with the widest window */
+    res = opt300x_set_limits(&gs_handle, 0x0000, 0xBFFF);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set limits failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_delay_ms(250);
+    res = opt300x_get_interrupt_latch(&gs_handle, &enable);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get interrupt latch failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_alert_irq_handler(list, 1);
+    opt300x_interface_debug_print("opt300x: check no responder %s.\n", res == 4 ? "ok" : "error");
+    
+    /* force an alert */
+    DRIVER_OPT300X_LINK_EVENT_CALLBACK(&gs_handle, a_opt300x_register_test_event);
+    gs_event_count = 0;
+    res = opt300x_start_continuous_read(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: start continuous read failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_set_high_limit(&gs_handle, 0x0000);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set high limit failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_delay_ms(250);
+    res = opt300x_alert_irq_handler(list, 1);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: alert irq handler failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check responder %s.\n",
+                                  (gs_event_count == 1) && (gs_event.high_flag == 1) ? "ok" : "error");
+    DRIVER_OPT300X_LINK_EVENT_CALLBACK(&gs_handle, NULL);
+    res = opt300x_set_high_limit(&gs_handle, 0xBFFF);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set high limit failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_stop_continuous_read(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: stop continuous read failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* opt300x_general_call_reset test */
+    opt300x_interface_debug_print("opt300x: opt300x_general_call_reset test.\n");
+    
+    /* invalid handles */
+    list[0] = NULL;
+    res = opt300x_general_call_reset(list, 1, &us);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", res == 2 ? "ok" : "error");
+    list[0] = &gs_handle;
+    res = opt300x_general_call_reset(list, 0, &us);
+    opt300x_interface_debug_print("opt300x: check zero handle %s.\n", res == 2 ? "ok" : "error");
+    list[1] = &gs_handle_idle;
+    res = opt300x_general_call_reset(list, 2, &us);
+    opt300x_interface_debug_print("opt300x: check idle handle %s.\n", res == 3 ? "ok" : "error");
+    
+    /* no iic_write_cmd */
+    DRIVER_OPT300X_LINK_IIC_WRITE_COMMAND(&gs_handle, NULL);
+    res = opt300x_general_call_reset(list, 1, &us);
+    opt300x_interface_debug_print("opt300x: check null iic_write_cmd %s.\n", res == 1 ? "ok" : "error");
+    DRIVER_OPT300X_LINK_IIC_WRITE_COMMAND(&gs_handle, opt300x_interface_iic_write_cmd);
+    
+    /* set a configuration away from the reset defaults */
+    res = opt300x_set_limits(&gs_handle, 0x1100, 0x5FFF);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set limits failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_set_fault_count(&gs_handle, OPT300X_FAULT_COUNT_TWO);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set fault count failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* reset and restore */
+    res = opt300x_general_call_reset(list, 1, &us);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: general call reset failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: general call reset in %dus.\n", (int)us);
+    res = opt300x_get_low_limit(&gs_handle, &limit);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get low limit failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_get_high_limit(&gs_handle, &limit_check);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get high limit failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check restored limits %s.\n", (limit == 0x1100) && (limit_check == 0x5FFF) ? "ok" : "error");
+    res = opt300x_get_fault_count(&gs_handle, &count);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get fault count failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check restored fault count %s.\n", count == OPT300X_FAULT_COUNT_TWO ? "ok" : "error");
+    res = opt300x_get_conversion_time(&gs_handle, &t);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get conversion time failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check restored conversion time %s.\n", t == OPT300X_CONVERSION_TIME_100_MS ? "ok" : "error");
+    
+    /* set fault count one */
+    res = opt300x_set_fault_count(&gs_handle, OPT300X_FAULT_COUNT_ONE);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set fault count failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* opt300x_scan test */
+    opt300x_interface_debug_print("opt300x: opt300x_scan test.\n");
+    
+    /* invalid handles */
+    res = opt300x_scan(NULL, scan, gs_ready, &num);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", res == 2 ? "ok" : "error");
+    res = opt300x_scan(&gs_handle_idle, scan, gs_ready, &num);
+    opt300x_interface_debug_print("opt300x: check unlinked handle %s.\n", res == 3 ? "ok" : "error");
+    
+    /* scan the bus */
+    res = opt300x_scan(&gs_handle, scan, gs_ready, &num);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: scan failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: scan found %d device(s).\n", num);
+    for (i = 0; i < 4; i++)
+    {
+        if (scan[i].addr_pin == addr)
+        {
+            break;
+        }
+    }
+    opt300x_interface_debug_print("opt300x: check scanned address %s.\n",
+                                  (i < 4) && (scan[i].found == 1) && (scan[i].manufacturer_id == 0x5449) ? "ok" : "error");
+    for (i = 0; i < num; i++)
+    {
+        if (gs_ready[i].iic_addr == (uint8_t)addr)
+        {
+            res = opt300x_get_deadband_rearm_count(&gs_ready[i], &count_check);
+            opt300x_interface_debug_print("opt300x: check ready handle %s.\n", (res == 0) && (count_check == 0) ? "ok" : "error");
+        }
+        (void)opt300x_deinit(&gs_ready[i]);
+    }
+    
+    /* opt300x_get_reset_count test */
+    opt300x_interface_debug_print("opt300x: opt300x_get_reset_count test.\n");
+    
+    /* start continuous read */
+    res = opt300x_start_continuous_read(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: start continuous read failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_delay_ms(250);
+    res = opt300x_get_reset_count(&gs_handle, &count_check);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get reset count failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* reset the chip behind the driver */
+    cmd = 0x06;
+    res = opt300x_interface_iic_write_cmd(0x00, &cmd, 1);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: general call reset failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_delay_ms(1);
+    opt300x_interface_debug_print("opt300x: reset the chip.\n");
+    if (type == OPT3002)
+    {
+        res = opt3002_continuous_read(&gs_handle, &limit, &nw_cm2);
+    }
+    else
+    {
+        res = opt300x_continuous_read(&gs_handle, &limit, &lux);
+    }
+    if ((res != 0) && (res != 4))
+    {
+        opt300x_interface_debug_print("opt300x: continuous read failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_get_reset_count(&gs_handle, &reset_check);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get reset count failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check reset count %s.\n", reset_check == count_check + 1 ? "ok" : "error");
+    res = opt300x_get_low_limit(&gs_handle, &limit);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get low limit failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_get_high_limit(&gs_handle, &limit_check);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get high limit failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check restored limits %s.\n", (limit == 0x1100) && (limit_check == 0x5FFF) ? "ok" : "error");
+    
+    /* a running chip is not reset again */
+    if (type == OPT3002)
+    {
+        res = opt3002_continuous_read(&gs_handle, &limit, &nw_cm2);
+    }
+    else
+    {
+        res = opt300x_continuous_read(&gs_handle, &limit, &lux);
+    }
+    if ((res != 0) && (res != 4))
+    {
+        opt300x_interface_debug_print("opt300x: continuous read failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_get_reset_count(&gs_handle, &reset_check);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get reset count failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check restored mode %s.\n", reset_check == count_check + 1 ? "ok" : "error");
+    res = opt300x_stop_continuous_read(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: stop continuous read failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* opt300x_start_watchdog/opt300x_stop_watchdog test */
+    opt300x_interface_debug_print("opt300x: opt300x_start_watchdog/opt300x_stop_watchdog test.\n");
+    
+    /* the latency check needs the timestamp */
+    DRIVER_OPT300X_LINK_TIMESTAMP_US(&gs_handle, NULL);
+    res = opt300x_start_watchdog(&gs_handle, 0, 0, 1000);
+    opt300x_interface_debug_print("opt300x: check null timestamp_us %s.\n", res == 4 ? "ok" : "error");
+    DRIVER_OPT300X_LINK_TIMESTAMP_US(&gs_handle, opt300x_interface_timestamp_us);
+    
+    /* a slow conversion leaves back to back reads stale */
+    DRIVER_OPT300X_LINK_HEALTH_CALLBACK(&gs_handle, a_opt300x_register_test_health);
+    gs_health_count = 0;
+    res = opt300x_set_conversion_time(&gs_handle, OPT300X_CONVERSION_TIME_800_MS);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: set conversion time failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_start_continuous_read(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: start continuous read failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_delay_ms(1000);
+    res = opt300x_start_watchdog(&gs_handle, 2, 0, 0);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: start watchdog failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: start watchdog with 2 stale reads.\n");
+    for (i = 0; i < 3; i++)
+    {
+        if (type == OPT3002)
+        {
+            res = opt3002_continuous_read(&gs_handle, &limit, &nw_cm2);
+        }
+        else
+        {
+            res = opt300x_continuous_read(&gs_handle, &limit, &lux);
+        }
+        if ((res != 0) && (res != 4))
+        {
+            opt300x_interface_debug_print("opt300x: continuous read failed.\n");
+            (void)opt300x_stop_watchdog(&gs_handle);
+            (void)opt300x_stop_continuous_read(&gs_handle);
+            (void)opt300x_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    res = opt300x_get_health(&gs_handle, &health, &latency_max);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get health failed.\n");
+        (void)opt300x_stop_watchdog(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check stale %s.\n",
+                                  (health == OPT300X_HEALTH_STALE) && (gs_health_count == 1) && (gs_health == OPT300X_HEALTH_STALE) ? "ok" : "error");
+    
+    /* a new conversion is healthy again */
+    opt300x_interface_delay_ms(1000);
+    if (type == OPT3002)
+    {
+        res = opt3002_continuous_read(&gs_handle, &limit, &nw_cm2);
+    }
+    else
+    {
+        res = opt300x_continuous_read(&gs_handle, &limit, &lux);
+    }
+    if ((res != 0) && (res != 4))
+    {
+        opt300x_interface_debug_print("opt300x: continuous read failed.\n");
+        (void)opt300x_stop_watchdog(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_get_health(&gs_handle, &health, &latency_max);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get health failed.\n");
+        (void)opt300x_stop_watchdog(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check recovered %s.\n",
+                                  (health == OPT300X_HEALTH_OK) && (gs_health_count == 2) && (gs_health == OPT300X_HEALTH_OK) ? "ok" : "error");
+    
+    /* any bus read is slower than 1us */
+    res = opt300x_start_watchdog(&gs_handle, 0, 0, 1);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: start watchdog failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: start watchdog with 1us latency.\n");
+    if (type == OPT3002)
+    {
+        res = opt3002_continuous_read(&gs_handle, &limit, &nw_cm2);
+    }
+    else
+    {
+        res = opt300x_continuous_read(&gs_handle, &limit, &lux);
+    }
+    if ((res != 0) && (res != 4))
+    {
+        opt300x_interface_debug_print("opt300x: continuous read failed.\n");
+        (void)opt300x_stop_watchdog(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = opt300x_get_health(&gs_handle, &health, &latency_max);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get health failed.\n");
+        (void)opt300x_stop_watchdog(&gs_handle);
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: max latency is %dus.\n", (int)latency_max);
+    opt300x_interface_debug_print("opt300x: check slow %s.\n", (health == OPT300X_HEALTH_SLOW) && (latency_max > 1) ? "ok" : "error");
+    
+    /* stop watchdog */
+    DRIVER_OPT300X_LINK_HEALTH_CALLBACK(&gs_handle, NULL);
+    res = opt300x_stop_watchdog(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: stop watchdog failed.\n");
+        (void)opt300x_stop_continuous_read(&gs_handle);
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: stop watchdog.\n");
+    res = opt300x_stop_continuous_read(&gs_handle);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: stop continuous read failed.\n");
+        (void)opt300x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
     /* finish register test */
     opt300x_interface_debug_print("opt300x: finish register test.\n");
     (void)opt300x_deinit(&gs_handle);
@@ -0,0 +1,341 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_resample_test.c
+ * @brief     driver opt300x resample test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_opt300x_resample_test.h"
+
+/**
+ * @brief resample test definition
+ */
+#define OPT300X_RESAMPLE_TEST_MAX_FRAME        32        /**< kept frames */
+
+static opt300x_handle_t gs_handle;                                                      /**< opt300x handle never inited */
+static opt300x_resample_t gs_resample;                                                  /**< linear resampler */
+static opt300x_resample_t gs_resample_hold;                                             /**< hold resampler */
+static opt300x_resample_t gs_resample_idle;                                             /**< resampler never inited */
+static opt300x_resample_frame_t gs_frame[OPT300X_RESAMPLE_TEST_MAX_FRAME];              /**< emitted frames */
+static volatile uint32_t gs_frame_num;                                                  /**< emitted frame numbers */
+
+/**
+ * @brief     emit function
+ * @param[in] *resample pointer to a resample structure
+ * @param[in] *frame pointer to an emitted frame
+ * @note      none
+ */
+static void a_opt300x_resample_test_emit(opt300x_resample_t *resample, const opt300x_resample_frame_t *frame)
+{
+    (void)resample;
+    if (gs_frame_num < OPT300X_RESAMPLE_TEST_MAX_FRAME)
+    {
+        gs_frame[gs_frame_num] = *frame;
+    }
+    gs_frame_num++;
+}
+
+/**
+ * @brief     check a float
+ * @param[in] a checked value
+ * @param[in] b expected value
+ * @return    status code
+ *            - 0 equal
+ *            - 1 not equal
+ * @note      none
+ */
+static uint8_t a_opt300x_resample_test_near(float a, float b)
+{
+    float diff = (a > b) ? (a - b) : (b - a);
+    float limit = ((b > 0.0f) ? b : -b) * 1e-4f + 1e-6f;
+    
+    return (diff <= limit) ? 0 : 1;
+}
+
+/**
+ * @brief     check one sensor of an emitted frame
+ * @param[in] index frame index
+ * @param[in] timestamp_us expected grid timestamp
+ * @param[in] sensor sensor id
+ * @param[in] data expected data, ignored without data
+ * @param[in] flags expected flags
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      a frame without data must hold NAN
+ */
+static uint8_t a_opt300x_resample_test_frame(uint32_t index, uint64_t timestamp_us, uint8_t sensor,
+                                             float data, opt300x_resample_flag_t flags)
+{
+    const opt300x_resample_frame_t *frame = &gs_frame[index];
+    
+    if ((index >= gs_frame_num) || (frame->timestamp_us != timestamp_us) || (frame->flags[sensor] != (uint8_t)flags))
+    {
+        return 1;
+    }
+    if (flags == OPT300X_RESAMPLE_FLAG_NONE)
+    {
+        return (frame->data[sensor] != frame->data[sensor]) ? 0 : 1;
+    }
+    
+    return a_opt300x_resample_test_near(frame->data[sensor], data);
+}
+
+/**
+ * @brief  resample test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   none
+ */
+uint8_t opt300x_resample_test(void)
+{
+    uint8_t res;
+    opt300x_info_t info;
+    opt300x_t type[2] = {OPT3001, OPT3001};
+    
+    /* get chip information */
+    res = opt300x_info(&info);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get info failed.\n");
+        
+        return 1;
+    }
+    else
+    {
+        /* print chip information */
+        opt300x_interface_debug_print("opt300x: chip is %s.\n", info.chip_name);
+        opt300x_interface_debug_print("opt300x: manufacturer is %s.\n", info.manufacturer_name);
+        opt300x_interface_debug_print("opt300x: interface is %s.\n", info.interface);
+        opt300x_interface_debug_print("opt300x: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        opt300x_interface_debug_print("opt300x: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        opt300x_interface_debug_print("opt300x: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        opt300x_interface_debug_print("opt300x: max current is %0.2fmA.\n", info.max_current_ma);
+        opt300x_interface_debug_print("opt300x: max temperature is %0.1fC.\n", info.temperature_max);
+        opt300x_interface_debug_print("opt300x: min temperature is %0.1fC.\n", info.temperature_min);
+    }
+    
+    /* start resample test */
+    opt300x_interface_debug_print("opt300x: start resample test.\n");
+    
+    /* opt300x_resample_init test */
+    opt300x_interface_debug_print("opt300x: opt300x_resample_init test.\n");
+    res = opt300x_resample_init(NULL, type, 2, OPT300X_RESAMPLE_MODE_LINEAR, 1000, 2500, 5000, a_opt300x_resample_test_emit);
+    opt300x_interface_debug_print("opt300x: check null resample %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_resample_init(&gs_resample, NULL, 2, OPT300X_RESAMPLE_MODE_LINEAR, 1000, 2500, 5000, a_opt300x_resample_test_emit);
+    opt300x_interface_debug_print("opt300x: check null type %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_resample_init(&gs_resample, type, 0, OPT300X_RESAMPLE_MODE_LINEAR, 1000, 2500, 5000, a_opt300x_resample_test_emit);
+    opt300x_interface_debug_print("opt300x: check no sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_resample_init(&gs_resample, type, OPT300X_RESAMPLE_MAX_SENSOR + 1, OPT300X_RESAMPLE_MODE_LINEAR,
+                                1000, 2500, 5000, a_opt300x_resample_test_emit);
+    opt300x_interface_debug_print("opt300x: check too many sensors %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_resample_init(&gs_resample, type, 2, (opt300x_resample_mode_t)(OPT300X_RESAMPLE_MODE_LINEAR + 1),
+                                1000, 2500, 5000, a_opt300x_resample_test_emit);
+    opt300x_interface_debug_print("opt300x: check invalid mode %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_resample_init(&gs_resample, type, 2, OPT300X_RESAMPLE_MODE_LINEAR, 0, 2500, 5000, a_opt300x_resample_test_emit);
+    opt300x_interface_debug_print("opt300x: check no period %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_resample_init(&gs_resample, type, 2, OPT300X_RESAMPLE_MODE_LINEAR, 1000, 1000 * OPT300X_RESAMPLE_MAX_DEPTH,
+                                5000, a_opt300x_resample_test_emit);
+    opt300x_interface_debug_print("opt300x: check long latency %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    gs_frame_num = 0;
+    res = opt300x_resample_init(&gs_resample, type, 2, OPT300X_RESAMPLE_MODE_LINEAR, 1000, 2500, 5000, a_opt300x_resample_test_emit);
+    opt300x_interface_debug_print("opt300x: check init %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* opt300x_resample_push test */
+    opt300x_interface_debug_print("opt300x: opt300x_resample_push test.\n");
+    res = opt300x_resample_push(NULL, 0, 100, 500);
+    opt300x_interface_debug_print("opt300x: check null resample %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_resample_push(&gs_resample_idle, 0, 100, 500);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    res = opt300x_resample_push(&gs_resample, 2, 100, 500);
+    opt300x_interface_debug_print("opt300x: check invalid sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    
+    /* sensor 0 samples between the grid points, sensor 1 on them */
+    res = opt300x_resample_push(&gs_resample, 0, 100, 500);
+    res |= opt300x_resample_push(&gs_resample, 1, 300, 1000);
+    opt300x_interface_debug_print("opt300x: check wait %s.\n", ((res == 0) && (gs_frame_num == 0)) ? "ok" : "error");
+    if ((res != 0) || (gs_frame_num != 0))
+    {
+        return 1;
+    }
+    res = opt300x_resample_push(&gs_resample, 0, 200, 1500);
+    if ((res != 0) || (gs_frame_num != 1) ||
+        (a_opt300x_resample_test_frame(0, 1000, 0, 1.5f, OPT300X_RESAMPLE_FLAG_VALID) != 0) ||
+        (a_opt300x_resample_test_frame(0, 1000, 1, 3.0f, OPT300X_RESAMPLE_FLAG_VALID) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: check linear error.\n");
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check linear ok.\n");
+    res = opt300x_resample_push(&gs_resample, 0, 100, 1000);
+    opt300x_interface_debug_print("opt300x: check late sample %s.\n", (res == 5) ? "ok" : "error");
+    if (res != 5)
+    {
+        return 1;
+    }
+    res = opt300x_resample_push(&gs_resample, 1, 300, 2000);
+    opt300x_interface_debug_print("opt300x: check wait for the late sensor %s.\n",
+                                  ((res == 0) && (gs_frame_num == 1)) ? "ok" : "error");
+    if ((res != 0) || (gs_frame_num != 1))
+    {
+        return 1;
+    }
+    
+    /* opt300x_resample_advance test */
+    opt300x_interface_debug_print("opt300x: opt300x_resample_advance test.\n");
+    res = opt300x_resample_advance(NULL, 4600);
+    opt300x_interface_debug_print("opt300x: check null resample %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_resample_advance(&gs_resample_idle, 4600);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    res = opt300x_resample_advance(&gs_resample, 4600);
+    if ((res != 0) || (gs_frame_num != 2) ||
+        (a_opt300x_resample_test_frame(1, 2000, 0, 2.0f, OPT300X_RESAMPLE_FLAG_HELD) != 0) ||
+        (a_opt300x_resample_test_frame(1, 2000, 1, 3.0f, OPT300X_RESAMPLE_FLAG_VALID) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: check latency error.\n");
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check latency ok.\n");
+    res = opt300x_resample_advance(&gs_resample, 20000);
+    if ((res != 0) || (gs_frame_num != 17) || (gs_resample.frames != 17) ||
+        (a_opt300x_resample_test_frame(2, 3000, 1, 3.0f, OPT300X_RESAMPLE_FLAG_HELD) != 0) ||
+        (a_opt300x_resample_test_frame(5, 6000, 0, 2.0f, OPT300X_RESAMPLE_FLAG_HELD) != 0) ||
+        (a_opt300x_resample_test_frame(6, 7000, 0, 0.0f, OPT300X_RESAMPLE_FLAG_NONE) != 0) ||
+        (a_opt300x_resample_test_frame(16, 17000, 1, 0.0f, OPT300X_RESAMPLE_FLAG_NONE) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: check max gap error.\n");
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check max gap ok.\n");
+    
+    /* zero order hold */
+    gs_frame_num = 0;
+    res = opt300x_resample_init(&gs_resample_hold, type, 1, OPT300X_RESAMPLE_MODE_HOLD, 1000, 0, 5000, a_opt300x_resample_test_emit);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: init failed.\n");
+        
+        return 1;
+    }
+    res = opt300x_resample_push(&gs_resample_hold, 0, 100, 500);
+    res |= opt300x_resample_push(&gs_resample_hold, 0, 200, 1500);
+    if ((res != 0) || (gs_frame_num != 1) ||
+        (a_opt300x_resample_test_frame(0, 1000, 0, 1.0f, OPT300X_RESAMPLE_FLAG_VALID) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: check hold error.\n");
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check hold ok.\n");
+    
+    /* opt300x_resample_read_push test */
+    opt300x_interface_debug_print("opt300x: opt300x_resample_read_push test.\n");
+    res = opt300x_resample_read_push(NULL, 0, &gs_handle);
+    opt300x_interface_debug_print("opt300x: check null resample %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_resample_read_push(&gs_resample, 0, NULL);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_resample_read_push(&gs_resample, 0, &gs_handle);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    
+    /* finish resample test */
+    opt300x_interface_debug_print("opt300x: finish resample test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,392 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_opt300x_window_test.c
+ * @brief     driver opt300x window test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_opt300x_window_test.h"
+
+static opt300x_handle_t gs_handle;                   /**< opt300x handle never inited */
+static opt300x_window_t gs_window;                   /**< window */
+static opt300x_window_t gs_window_idle;              /**< window never inited */
+static volatile uint32_t gs_close;                   /**< close counter */
+
+/**
+ * @brief     close function
+ * @param[in] *window pointer to a window structure
+ * @note      none
+ */
+static void a_opt300x_window_test_close(opt300x_window_t *window)
+{
+    (void)window;
+    gs_close++;
+}
+
+/**
+ * @brief     check a float
+ * @param[in] a checked value
+ * @param[in] b expected value
+ * @return    status code
+ *            - 0 equal
+ *            - 1 not equal
+ * @note      none
+ */
+static uint8_t a_opt300x_window_test_near(float a, float b)
+{
+    float diff = (a > b) ? (a - b) : (b - a);
+    float limit = ((b > 0.0f) ? b : -b) * 1e-4f + 1e-6f;
+    
+    return (diff <= limit) ? 0 : 1;
+}
+
+/**
+ * @brief     check the last closed window of a sensor
+ * @param[in] sensor sensor id
+ * @param[in] count expected samples
+ * @param[in] min expected min
+ * @param[in] max expected max
+ * @param[in] mean expected mean
+ * @param[in] start_us expected window start
+ * @param[in] end_us expected window end
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_opt300x_window_test_result(uint8_t sensor, uint32_t count, float min, float max, float mean,
+                                            uint64_t start_us, uint64_t end_us)
+{
+    opt300x_window_result_t result;
+    
+    if (opt300x_window_get_result(&gs_window, sensor, &result) != 0)
+    {
+        return 1;
+    }
+    if ((result.count != count) || (result.start_us != start_us) || (result.end_us != end_us) ||
+        (a_opt300x_window_test_near(result.min, min) != 0) ||
+        (a_opt300x_window_test_near(result.max, max) != 0) ||
+        (a_opt300x_window_test_near(result.mean, mean) != 0))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  window test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   none
+ */
+uint8_t opt300x_window_test(void)
+{
+    uint8_t res;
+    opt300x_info_t info;
+    opt300x_window_result_t result;
+    opt300x_t type[2] = {OPT3001, OPT3002};
+    
+    /* get chip information */
+    res = opt300x_info(&info);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: get info failed.\n");
+        
+        return 1;
+    }
+    else
+    {
+        /* print chip information */
+        opt300x_interface_debug_print("opt300x: chip is %s.\n", info.chip_name);
+        opt300x_interface_debug_print("opt300x: manufacturer is %s.\n", info.manufacturer_name);
+        opt300x_interface_debug_print("opt300x: interface is %s.\n", info.interface);
+        opt300x_interface_debug_print("opt300x: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        opt300x_interface_debug_print("opt300x: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        opt300x_interface_debug_print("opt300x: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        opt300x_interface_debug_print("opt300x: max current is %0.2fmA.\n", info.max_current_ma);
+        opt300x_interface_debug_print("opt300x: max temperature is %0.1fC.\n", info.temperature_max);
+        opt300x_interface_debug_print("opt300x: min temperature is %0.1fC.\n", info.temperature_min);
+    }
+    
+    /* start window test */
+    opt300x_interface_debug_print("opt300x: start window test.\n");
+    
+    /* opt300x_window_init test */
+    opt300x_interface_debug_print("opt300x: opt300x_window_init test.\n");
+    res = opt300x_window_init(NULL, type, 2, 1000, 3, a_opt300x_window_test_close);
+    opt300x_interface_debug_print("opt300x: check null window %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_window_init(&gs_window, NULL, 2, 1000, 3, a_opt300x_window_test_close);
+    opt300x_interface_debug_print("opt300x: check null type %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_window_init(&gs_window, type, 0, 1000, 3, a_opt300x_window_test_close);
+    opt300x_interface_debug_print("opt300x: check no sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_window_init(&gs_window, type, OPT300X_WINDOW_MAX_SENSOR + 1, 1000, 3, a_opt300x_window_test_close);
+    opt300x_interface_debug_print("opt300x: check too many sensors %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_window_init(&gs_window, type, 2, 0, 3, a_opt300x_window_test_close);
+    opt300x_interface_debug_print("opt300x: check empty pane %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_window_init(&gs_window, type, 2, 1000, 0, a_opt300x_window_test_close);
+    opt300x_interface_debug_print("opt300x: check no pane %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = opt300x_window_init(&gs_window, type, 2, 1000, OPT300X_WINDOW_MAX_PANE + 1, a_opt300x_window_test_close);
+    opt300x_interface_debug_print("opt300x: check too many panes %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    gs_close = 0;
+    res = opt300x_window_init(&gs_window, type, 2, 1000, 3, a_opt300x_window_test_close);
+    opt300x_interface_debug_print("opt300x: check init %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* opt300x_window_push test */
+    opt300x_interface_debug_print("opt300x: opt300x_window_push test.\n");
+    res = opt300x_window_push(NULL, 0, 100, 100);
+    opt300x_interface_debug_print("opt300x: check null window %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_window_push(&gs_window_idle, 0, 100, 100);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    res = opt300x_window_push(&gs_window, 2, 100, 100);
+    opt300x_interface_debug_print("opt300x: check invalid sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    if ((opt300x_window_push(&gs_window, 0, 100, 100) != 0) ||
+        (opt300x_window_push(&gs_window, 0, (1 << 12) | 100, 200) != 0) ||
+        (opt300x_window_push(&gs_window, 1, 10, 300) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: push failed.\n");
+        
+        return 1;
+    }
+    opt300x_interface_debug_print("opt300x: check open pane %s.\n", (gs_close == 0) ? "ok" : "error");
+    if (gs_close != 0)
+    {
+        return 1;
+    }
+    res = opt300x_window_push(&gs_window, 0, 300, 1500);
+    opt300x_interface_debug_print("opt300x: check closed pane %s.\n", ((res == 0) && (gs_close == 1)) ? "ok" : "error");
+    if ((res != 0) || (gs_close != 1))
+    {
+        return 1;
+    }
+    res = opt300x_window_push(&gs_window, 0, 100, 500);
+    opt300x_interface_debug_print("opt300x: check late sample %s.\n", (res == 5) ? "ok" : "error");
+    if (res != 5)
+    {
+        return 1;
+    }
+    
+    /* opt300x_window_get_result test */
+    opt300x_interface_debug_print("opt300x: opt300x_window_get_result test.\n");
+    res = opt300x_window_get_result(NULL, 0, &result);
+    opt300x_interface_debug_print("opt300x: check null window %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_window_get_result(&gs_window, 0, NULL);
+    opt300x_interface_debug_print("opt300x: check null result %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_window_get_result(&gs_window_idle, 0, &result);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    res = opt300x_window_get_result(&gs_window, 2, &result);
+    opt300x_interface_debug_print("opt300x: check invalid sensor %s.\n", (res == 4) ? "ok" : "error");
+    if (res != 4)
+    {
+        return 1;
+    }
+    res = a_opt300x_window_test_result(0, 2, 1.0f, 2.0f, 1.5f, 0, 1000);
+    opt300x_interface_debug_print("opt300x: check lux result %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    res = a_opt300x_window_test_result(1, 1, 12.0f, 12.0f, 12.0f, 0, 1000);
+    opt300x_interface_debug_print("opt300x: check nw/cm2 result %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* opt300x_window_advance test */
+    opt300x_interface_debug_print("opt300x: opt300x_window_advance test.\n");
+    res = opt300x_window_advance(NULL, 2100);
+    opt300x_interface_debug_print("opt300x: check null window %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_window_advance(&gs_window_idle, 2100);
+    opt300x_interface_debug_print("opt300x: check not inited %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    res = opt300x_window_advance(&gs_window, 2100);
+    if ((res != 0) || (gs_close != 2))
+    {
+        opt300x_interface_debug_print("opt300x: advance failed.\n");
+        
+        return 1;
+    }
+    res = a_opt300x_window_test_result(0, 3, 1.0f, 3.0f, 2.0f, 0, 2000);
+    opt300x_interface_debug_print("opt300x: check sliding window %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    res = opt300x_window_advance(&gs_window, 10000);
+    if ((res != 0) || (gs_close != 5))
+    {
+        opt300x_interface_debug_print("opt300x: advance failed.\n");
+        
+        return 1;
+    }
+    res = a_opt300x_window_test_result(0, 0, 0.0f, 0.0f, 0.0f, 2000, 5000);
+    opt300x_interface_debug_print("opt300x: check empty window %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    if ((opt300x_window_push(&gs_window, 1, (2 << 12) | 50, 10500) != 0) ||
+        (opt300x_window_advance(&gs_window, 11000) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: push failed.\n");
+        
+        return 1;
+    }
+    res = a_opt300x_window_test_result(1, 1, 240.0f, 240.0f, 240.0f, 8000, 11000);
+    opt300x_interface_debug_print("opt300x: check skipped gap %s.\n", ((res == 0) && (gs_close == 6)) ? "ok" : "error");
+    if ((res != 0) || (gs_close != 6))
+    {
+        return 1;
+    }
+    
+    /* tumbling window test */
+    opt300x_interface_debug_print("opt300x: tumbling window test.\n");
+    res = opt300x_window_init(&gs_window, type, 1, 500, 1, NULL);
+    if (res != 0)
+    {
+        opt300x_interface_debug_print("opt300x: init failed.\n");
+        
+        return 1;
+    }
+    res = opt300x_window_get_result(&gs_window, 0, &result);
+    opt300x_interface_debug_print("opt300x: check no window %s.\n", (res == 5) ? "ok" : "error");
+    if (res != 5)
+    {
+        return 1;
+    }
+    if ((opt300x_window_push(&gs_window, 0, 400, 0) != 0) ||
+        (opt300x_window_push(&gs_window, 0, 200, 100) != 0) ||
+        (opt300x_window_push(&gs_window, 0, 900, 600) != 0) ||
+        (opt300x_window_advance(&gs_window, 1000) != 0))
+    {
+        opt300x_interface_debug_print("opt300x: push failed.\n");
+        
+        return 1;
+    }
+    res = a_opt300x_window_test_result(0, 1, 9.0f, 9.0f, 9.0f, 500, 1000);
+    opt300x_interface_debug_print("opt300x: check tumbling window %s.\n", (res == 0) ? "ok" : "error");
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* opt300x_window_read_push test */
+    opt300x_interface_debug_print("opt300x: opt300x_window_read_push test.\n");
+    res = opt300x_window_read_push(NULL, 0, &gs_handle);
+    opt300x_interface_debug_print("opt300x: check null window %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_window_read_push(&gs_window, 0, NULL);
+    opt300x_interface_debug_print("opt300x: check null handle %s.\n", (res == 2) ? "ok" : "error");
+    if (res != 2)
+    {
+        return 1;
+    }
+    res = opt300x_window_read_push(&gs_window, 0, &gs_handle);
+    opt300x_interface_debug_print("opt300x: check not inited handle %s.\n", (res == 3) ? "ok" : "error");
+    if (res != 3)
+    {
+        return 1;
+    }
+    
+    /* finish window test */
+    opt300x_interface_debug_print("opt300x: finish window test.\n");
+    
+    return 0;
+}